@@ -51,6 +51,108 @@
 #include  "tftp-s_cfg.h"
 
 
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                 TFTP SERVER TRAFFIC CLASS TABLE
+*
+* Note(s) : (1) A request belongs to the first class it matches, & to the default class if it matches none
+*               (see 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION DATA TYPE').
+*
+*           (2) NO class is configured, so that all the requests share the sessions & bandwidth of the
+*               server.  E.g. the following table reserves a session to recovery images, so that a device
+*               can always be recovered, & caps the bandwidth of log uploads to half of the global rate
+*               (see 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION DATA TYPE  Note #5') :
+*
+*                   const  TFTPs_CLASS_CFG  TFTPs_ClassTbl[] = {
+*                       {"recovery/", TFTPs_CLASS_FAMILY_ANY, {0u}, 0u, 1u,  0u},
+*                       {"logs/",     TFTPs_CLASS_FAMILY_ANY, {0u}, 0u, 0u, 50u}
+*                   };
+*
+*               To use it, set the traffic class table of the configuration object to TFTPs_ClassTbl, &
+*               the number of traffic classes to sizeof(TFTPs_ClassTbl) / sizeof(TFTPs_CLASS_CFG).
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                               TFTP SERVER FILE NAME REWRITE RULE TABLE
+*
+* Note(s) : (1) A requested file name is rewritten by the rule of the longest matching pattern & subnet
+*               (see 'tftp-s_type.h  FILE NAME REWRITE RULE DATA TYPE').
+*
+*           (2) NO rule is configured, so that files are served as requested.  E.g. the following table
+*               serves the boot image of the 10.1.0.0/16 subnet from the directory of its device model, &
+*               the configuration files of all the clients from a common directory :
+*
+*                   const  TFTPs_REWRITE_RULE  TFTPs_RewriteTbl[] = {
+*                       {"boot.img",       TFTPs_CLASS_FAMILY_IPv4, {10u, 1u}, 16u, "models/a/boot.img"},
+*                       {"pxelinux.cfg*",  TFTPs_CLASS_FAMILY_ANY,  {0u},       0u, "cfg/common"}
+*                   };
+*
+*               To use it, set the rewrite rule table of the configuration object to TFTPs_RewriteTbl, &
+*               the number of rewrite rules to sizeof(TFTPs_RewriteTbl) / sizeof(TFTPs_REWRITE_RULE).
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                TFTP SERVER ADDRESS FILTER RULE TABLE
+*
+* Note(s) : (1) A client gets the permissions of the rule of the longest subnet holding it, or the default
+*               permissions of the configuration (see 'tftp-s_type.h  ADDRESS FILTER RULE DATA TYPE').
+*
+*           (2) NO rule is configured, so that all the clients get the default permissions.  E.g. the
+*               following table lets the 10.0.0.0/8 subnet read files, only lets its 10.0.1.0/24
+*               management subnet write files, & denies the 10.9.0.0/16 subnet :
+*
+*                   const  TFTPs_ACL_RULE  TFTPs_ACL_Tbl[] = {
+*                       {TFTPs_CLASS_FAMILY_IPv4, {10u},          8u, TFTPs_ACL_PERM_RD},
+*                       {TFTPs_CLASS_FAMILY_IPv4, {10u, 0u, 1u}, 24u, TFTPs_ACL_PERM_RD_WR},
+*                       {TFTPs_CLASS_FAMILY_IPv4, {10u, 9u},     16u, TFTPs_ACL_PERM_NONE}
+*                   };
+*
+*               To use it, set the address filter rule table of the configuration object to
+*               TFTPs_ACL_Tbl, & the number of address filter rules to sizeof(TFTPs_ACL_Tbl) /
+*               sizeof(TFTPs_ACL_RULE).
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                    TFTP SERVER LISTENER TABLE
+*
+* Note(s) : (1) Each listener serves the requests received on its address & port with its own policy (see
+*               'tftp-s_type.h  LISTENER CONFIGURATION DATA TYPE').
+*
+*           (2) NO listener is configured, so that the server listens on the IP families & port of the
+*               configuration object, on any local address.  E.g. the following table caps the bandwidth &
+*               sessions of a management interface, so that it can NOT starve a factory line interface,
+*               whose transfers are uncapped & use large windows :
+*
+*                   const  TFTPs_LISTEN_CFG  TFTPs_ListenTbl[] = {
+*                       {TFTPs_SOCK_SEL_IPv4, {10u,  0u,   1u,  1u}, 69u, 4u, 125000u, 16384u,  1u},
+*                       {TFTPs_SOCK_SEL_IPv4, {192u, 168u, 10u, 1u}, 69u, 0u,      0u,     0u, 64u}
+*                   };
+*
+*               The local addresses of a table MUST be configured on the interfaces of the target, or the
+*               server fails to initialize (see 'tftp-s.c  TFTPs_SockInit()  Note #2').  To use it, set the
+*               listener table of the configuration object to TFTPs_ListenTbl, & the number of listeners
+*               to sizeof(TFTPs_ListenTbl) / sizeof(TFTPs_LISTEN_CFG).
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -70,6 +172,7 @@ const  TFTPs_CFG  TFTPs_Cfg = {
         TFTPs_SOCK_SEL_IPv4,
                                                                 /* TFTPs_SOCK_SEL_IPv4       Accept Only IPv4.          */
                                                                 /* TFTPs_SOCK_SEL_IPv6       Accept Only IPv6.          */
+                                                                /* TFTPs_SOCK_SEL_IPv4_IPv6  Accept IPv4 & IPv6.        */
 
                                                                 /* TFTP server IP port.  Default is 69.                 */
         69,
@@ -82,8 +185,240 @@ const  TFTPs_CFG  TFTPs_Cfg = {
                                                                 /* Maximum inactivity time (ms) on RX.                  */
         5000,
 
-                                                                /* Maximum inactivity time (ms) on TX.                  */
+                                                                /* Time (ms) to wait for an answer before re-TX.        */
+        1000,
+
+                                                                /* Maximum number of retransmissions of a packet.       */
+        5,
+
+                                                                /* Time (ms) to dally after the final ACK of a WRQ.     */
+        5000,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                     SESSION CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Maximum number of concurrent transfers.              */
+        4,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                     BUFFER CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Number of   512-octet block buffers.                 */
+        4,
+
+                                                                /* Number of  1428-octet block buffers.                 */
+        2,
+
+                                                                /* Number of  8192-octet block buffers.                 */
+        0,
+
+                                                                /* Number of 65464-octet block buffers.                 */
+        0,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                     EGRESS SHAPING CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Global rate (octets/s), 0 for unlimited.             */
+        0,
+
+                                                                /* Global burst size (octets).                          */
+        16384,
+
+                                                                /* Per-host rate (octets/s), 0 for unlimited.           */
+        0,
+
+                                                                /* Per-host burst size (octets).                        */
+        4096,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                 TRANSMIT SCHEDULER CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Transmit queue policy : FIFO, or SRTF (opt-in).      */
+        TFTPs_SCHED_POLICY_FIFO,
+
+                                                                /* SRTF aging rate (octets/ms of wait), 0 for none.     */
+                                                                /* Unused with the FIFO policy.                         */
+        65536,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                  TRAFFIC CLASS CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Traffic class table, DEF_NULL for none.              */
+        DEF_NULL,
+
+                                                                /* Number of traffic classes in table.                  */
+        0,
+
+                                                                /* Number of new requests held, 0 for none.             */
+        4,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                 WINDOWED TRANSFER CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Max window size (blocks), 1 to disable windows.      */
+        8,
+
+                                                                /* Pace the blocks of a window over the RTT.            */
+        DEF_DISABLED,
+
+                                                                /* Min gap (ms) between paced DATA packets.             */
+        1,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                   COMPRESSED FILE CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Nbr of LZ4 files read concurrently.                  */
+        1,
+
+                                                                /* Max LZ4 frame blk size (octets) : 64, 256 KB, ...    */
+        65536,
+
+                                                                /* Max nbr of blks of an LZ4 file.                      */
+        64,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                   TRANSFER COMPLETION CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Digest of transferred data :                         */
+        TFTPs_DIGEST_ALG_CRC32,                                 /*   TFTPs_DIGEST_ALG_NONE/CRC32/SHA256.                */
+
+                                                                /* Digest of read requests' data.                       */
+        DEF_DISABLED,
+
+                                                                /* Xfer completion hook, DEF_NULL if none.              */
+        DEF_NULL,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                  FILE NAME REWRITE CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Rewrite rule table, DEF_NULL for none.               */
+        DEF_NULL,
+
+                                                                /* Number of rewrite rules in table.                    */
+        0,
+
+                                                                /* Max nbr of rules of a table set at run-time.         */
+        16,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                    ADDRESS FILTER CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Addr filter rule table, DEF_NULL for none.           */
+        DEF_NULL,
+
+                                                                /* Number of addr filter rules in table.                */
+        0,
+
+                                                                /* Perm of clients matching no rule.                    */
+        TFTPs_ACL_PERM_RD_WR,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                  FILE METADATA INDEX CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Number of entries of the file index.                 */
+        64,
+
+                                                                /* Lifetime of a file index entry (ms).                 */
         5000,
+
+                                                                /* Directory indexed at init, DEF_NULL for none.        */
+        DEF_NULL,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                   FILE HANDLE CACHE CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Time an unused shared file handle stays open (ms).   */
+        2000,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                      FILE STREAM CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Size of a stream chunk (octets).                     */
+        4096,
+
+                                                                /* Number of stream chunks, 0 to disable streams.       */
+        16,
+
+                                                                /* Max number of chunks of a stream window.             */
+        4,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                      LISTENER CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Listener table, DEF_NULL for a single listener.      */
+        DEF_NULL,
+
+                                                                /* Number of listeners in table.                        */
+        0,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                    PACKET CAPTURE CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Nbr of packets kept in ring, 0 to disable capture.   */
+        256,
+
+                                                                /* Nbr of octets kept of each packet.                   */
+        64,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                  NETWORK SIMULATION CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Max nbr of clients of a simulation run.              */
+        8,
+
+                                                                /* Nbr of pkts in flight on the simulated links.        */
+        256,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                 BATCHED TRANSMISSION CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Max nbr of pkts per batch, 0 to disable batches.     */
+        32,
+
+                                                                /* Batch tx fnct of host, DEF_NULL to tx pkts in turn.  */
+        DEF_NULL,
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                   BATCHED RECEPTION CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                                /* Max nbr of pkts rx'd per wakeup, 1 for a single pkt. */
+        16,
 };
 
 
@@ -112,7 +447,12 @@ const  TFTPs_CFG  TFTPs_Cfg = {
 *              priority. So some experimentation could be required to identify the better task priority
 *              configuration.
 *
-*          (2) TODO note on the TFTP Server stack's task size.
+*          (2) The stack used by the functions of the TFTP server is printed by 'make footprint' (see
+*              'tftp-s_cfg.h  TFTPs MINIMAL FOOTPRINT PROFILES  Note #2').  The task's stack MUST also
+*              hold the deepest calls into uC/TCP-IP, uC/FS & the trace function (see 'tftp-s_cfg.h
+*              TRACING'), whose usage depends on the target & the configuration of these stacks.  The
+*              default size leaves room for them, but should be checked on the target, e.g. with the
+*              stack usage statistics of the kernel.
 *
 *          (3) When the Stack pointer is defined as null pointer (DEF_NULL), the task's stack should be
 *              automatically allowed on the heap of uC/LIB.
@@ -125,7 +465,7 @@ const  TFTPs_CFG  TFTPs_Cfg = {
 #endif
 
 #ifndef  TFTPs_OS_CFG_TASK_STK_SIZE
-#define  TFTPs_OS_CFG_TASK_STK_SIZE             512
+#define  TFTPs_OS_CFG_TASK_STK_SIZE            2048
 #endif
 
 const  TFTPs_TASK_CFG  TFTPs_TaskCfg = {
@@ -56,6 +56,291 @@
 #define  TFTPs_TRACE_HIST_SIZE                            16    /* Trace history size.  Minimum value is 16.            */
 
 
+/*
+*********************************************************************************************************
+*                                      TFTPs TIMER CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_TMR_TICK_MS to the resolution, in milliseconds, of the timer wheel used
+*               for the per-session retransmission, idle & dally timers.  The longest timeout the wheel can
+*               hold is 2^24 ticks.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_TMR_TICK_MS                            10    /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPs COMPRESSED FILE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_FS_LZ4_EN to enable/disable serving files stored as LZ4 frames :
+*
+*               (a) When ENABLED,  a read request for a file that does NOT exist is served from the file of
+*                   the same name with the '.lz4' extension, decompressed on the fly.
+*
+*               (b) When DISABLED, files are always served as stored.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_FS_LZ4_EN                      DEF_DISABLED  /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPs FILE PROVIDER CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_FS_PROVIDER_EN to enable/disable the files served by the application
+*               through file providers (see TFTPs_FS_ProviderAdd()).
+*
+*           (2) Configure TFTPs_CFG_FS_PROVIDER_NBR_MAX with the maximum number of file providers.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_FS_PROVIDER_EN                 DEF_ENABLED   /* See Note #1.                                         */
+#define  TFTPs_CFG_FS_PROVIDER_NBR_MAX                     4u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs DIGEST CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_DIGEST_EN to enable/disable the digest of transferred data (CRC-32 &
+*               SHA-256), computed while the data is transferred.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_DIGEST_EN                      DEF_ENABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                TFTPs FILE METADATA INDEX CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_FS_META_EN to enable/disable the index of the size of the files read &
+*               of the files known to be missing (see 'tftp-s_meta.c').
+*
+*           (2) Configure TFTPs_CFG_FS_META_NAME_LEN_MAX with the maximum length of an indexed file name.
+*               Each index entry holds a name of that length.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_FS_META_EN                     DEF_ENABLED   /* See Note #1.                                         */
+
+#define  TFTPs_CFG_FS_META_NAME_LEN_MAX                   63u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPs FILE HANDLE CACHE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_FS_HANDLE_EN to enable/disable the sharing of the handles of the files
+*               read by several sessions (see 'tftp-s_fs.c  Note #6').
+*
+*           (2) Configure TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX with the maximum length of the name of a file
+*               whose handle is shared.  Files with a longer name are opened once per session.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_FS_HANDLE_EN                   DEF_ENABLED   /* See Note #1.                                         */
+
+#define  TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX                 63u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPs FILE STREAM CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_FS_STREAM_EN to enable/disable the streams shared by the sessions reading
+*               the same file, through a window of chunks read once from storage (see 'tftp-s_fs.c
+*               Note #7').  Streams require TFTPs_CFG_FS_HANDLE_EN.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_FS_STREAM_EN                   DEF_DISABLED  /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs WRITE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_WR_EN to enable/disable write requests :
+*
+*               (a) When ENABLED,  clients MAY write files to the server.
+*
+*               (b) When DISABLED, the write path of the server is NOT built & write requests are answered
+*                   with an access violation error (see 'tftp-s.c  Note #12').  Windowed writes require
+*                   TFTPs_CFG_WR_EN.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_WR_EN                          DEF_ENABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPs WINDOWED WRITE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_WR_WIN_EN to enable/disable the window size option (see RFC #7440) for
+*               write requests.  When disabled, write requests are acknowledged block by block.
+*
+*           (2) Configure TFTPs_CFG_WR_REORDER_NBR_MAX with the maximum number of blocks of a write request
+*               held while received out of order (see 'tftp-s.c  Note #10').
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_WR_WIN_EN                      DEF_ENABLED   /* See Note #1.                                         */
+
+#define  TFTPs_CFG_WR_REORDER_NBR_MAX                      4u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPs FILE NAME REWRITE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_REWRITE_EN to enable/disable the rewriting of requested file names by
+*               client subnet & file name pattern (see 'tftp-s_rewrite.c').
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_REWRITE_EN                     DEF_ENABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPs ADDRESS FILTER CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_ACL_EN to enable/disable the filtering of received packets by client
+*               subnet (see 'tftp-s_acl.c').
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_ACL_EN                         DEF_ENABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPs PACKET CAPTURE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_CAPTURE_EN to enable/disable the capture of the packets received & sent
+*               by the server in a memory ring, exported as a pcap file (see 'tftp-s_capture.c').
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_CAPTURE_EN                     DEF_DISABLED  /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPs NETWORK SIMULATION CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_SIM_EN to build the server for the network simulation (see
+*               'tftp-s_sim.c') : the sockets, the time & the files of the server are then simulated, &
+*               the server runs in the task calling TFTPs_SimRun() instead of its own task.
+*
+*               (a) The simulation is meant for host builds, to test the server reproducibly (see
+*                   'Tests/Host/tftp-s_sim_test.c').  It MUST be disabled for target builds.
+*
+*               (b) The simulation requires TFTPs_CFG_FS_PROVIDER_EN to be enabled.
+*
+*               (c) The simulation module is part of the host tests, in 'Tests/Host', which MUST be on the
+*                   include path (see 'tftp-s_sim.c  Note #8').
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_SIM_EN                        DEF_DISABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPs PERFORMANCE PROBE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_PERF_EN to enable/disable the measure of the cycles spent in the
+*               per-packet code of the server (see 'tftp-s_perf.c').
+*
+*               (a) The probes require the CPU timestamp timer (CPU_CFG_TS_TMR_EN).
+*
+*               (b) The probes add a timer read & a statistics update to each operation measured, & SHOULD
+*                   be disabled for production builds.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_PERF_EN                       DEF_DISABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                TFTPs BATCHED TRANSMISSION CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_TX_BATCH_EN to enable/disable the batched transmission of the packets
+*               sent together, e.g. the blocks of a window (see 'tftp-s_batch.c').
+*
+*               (a) Batches are meant for host builds, whose socket layer can send a batch of packets in a
+*                   single call (see 'tftp-s_type.h  BATCHED TRANSMISSION DATA TYPE').  On target builds,
+*                   a batch is sent one packet at a time & only costs the copy of its packets.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_TX_BATCH_EN                   DEF_DISABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPs SINGLE PACKET BUFFER CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPs_CFG_BUF_SINGLE_EN to enable/disable the single packet buffer of the server
+*               (see 'tftp-s.c  Note #13') :
+*
+*               (a) When ENABLED,  the packets of the session are built in the receive buffer, as are the
+*                   error packets, & are built again for retransmission.  The server then serves a single
+*                   session ('SessNbrMax' of 1) & holds NO request ('ReqQ_Size' of 0).  The buffer classes
+*                   only set the largest block size granted.  Windowed writes require the single packet
+*                   buffer to be disabled.
+*
+*               (b) When DISABLED, each session sends from a packet buffer of its own (see 'tftp-s_buf.c').
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CFG_BUF_SINGLE_EN                 DEF_DISABLED   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPs MINIMAL FOOTPRINT PROFILES
+*
+* Note(s) : (1) The footprint of the server is set by the configuration above.  The following profiles
+*               reduce it for small targets :
+*
+*               (a) Read-only      : TFTPs_CFG_WR_EN         DEF_DISABLED & TFTPs_CFG_WR_WIN_EN
+*                                    DEF_DISABLED.
+*               (b) No trace       : TFTPs_TRACE_LEVEL       TRACE_LEVEL_OFF (see 'TRACING').
+*               (c) Single buffer  : TFTPs_CFG_BUF_SINGLE_EN DEF_ENABLED, TFTPs_CFG_WR_WIN_EN DEF_DISABLED,
+*                                    'SessNbrMax' of 1, 'ReqQ_Size' of 0 & NO traffic class.
+*               (d) Combined       : (a), (b) & (c).
+*               (e) Minimal        : (d) & every other TFTPs_CFG_*_EN DEF_DISABLED, 'DigestAlg' of
+*                                    TFTPs_DIGEST_ALG_NONE.
+*
+*           (2) The footprint of each profile, in octets, is printed from a build of the server's sources
+*               with this header edited as the profile states (see 'Tests/Host/footprint.sh') :
+*
+*                   make -C Tests/Host footprint
+*
+*               (a) The figures are measured on the host (GCC, -Os) & do NOT include uC/TCP-IP, uC/FS,
+*                   uC/LIB & the trace function.  The figures of a 32-bit target are lower, mostly for
+*                   pointers.
+*
+*               (b) The heap is NOT a figure of a profile : it is allocated by TFTPs_Init(), as set by the
+*                   run-time configuration of 'tftp-s_cfg.c'.  It is mostly the packet buffers, & the LZ4,
+*                   file stream & capture buffers of these modules when enabled.
+*
+*               (c) The static memory is mostly the timer wheel (see 'tftp-s_tmr.c') & the trace tables.
+*
+*               (d) The task stack is the deepest call chain of the server's functions, & does NOT include
+*                   the calls to uC/TCP-IP, uC/FS & the trace function (see 'tftp-s_cfg.c  TFTP SERVER TASK
+*                   CONFIGURATION OBJECT  Note #2').
+*********************************************************************************************************
+*/
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -25,9 +25,78 @@
 * Note(s)  : (1) This is an full implementation of the server side of the TFTP protocol, as
 *                described in RFC #1350.
 *
-*            (2) This server is a 'single-user' one, meaning that while a transaction is in progress,
-*                other transactions are held off by returning an error condition indicating that
-*                the server is busy.
+*            (2) This server serves up to 'SessNbrMax' transactions concurrently, from its server sockets
+*                (see Note #11).  Each received packet is dispatched to the session of its sender's TID through a hash
+*                table (see 'tftp-s_sess.c').  New requests received while all sessions are in use are
+*                held off by returning an error condition indicating that the server is busy.
+*
+*            (3) Retransmission, idle session & dally timeouts are handled by the timer wheel module (see
+*                'tftp-s_tmr.c'); the server task sleeps on its socket until the next timer expiry.
+*
+*            (4) Session packets are sent through a transmit queue, in front of the egress shaper (see
+*                'tftp-s_shape.c').  A packet the shaper does NOT allow yet stays queued until enough
+*                tokens are available.  Error packets are small, end their transfer & bypass the queue.
+*                The queue is ordered by the configured scheduler policy (see 'tftp-s_type.h  TRANSMIT
+*                SCHEDULER POLICY DATA TYPE').
+*
+*            (5) Each request belongs to a traffic class (see 'tftp-s_class.c').  Requests of a class are
+*                refused while the free sessions are reserved to other classes.  New requests received
+*                while packets of the sessions in progress are pending in the socket are held in the
+*                request queue, & served by class once the socket is drained, so that the sessions in
+*                progress are NOT slowed down by bursts of new requests.
+*
+*            (6) Read requests MAY negotiate a window of DATA blocks (see RFC #7440), sent from the session's
+*                single buffer by reading each block from the file in turn.  Lost blocks are recovered by
+*                going back to the first block NOT acknowledged.  With pacing, the blocks of a window are
+*                spread over the session's round-trip time by its pacing timer, so that slow clients &
+*                the network interface are NOT overrun by back-to-back packets.
+*
+*            (7) The number of blocks sent per round-trip time adapts to losses (additive increase,
+*                multiplicative decrease) : it starts at TFTPs_WIN_EFF_INIT blocks, grows by one block for
+*                each window fully acknowledged, & is halved when a window times out or is partially
+*                acknowledged.  It never exceeds the window size granted in the OACK.  A client only
+*                acknowledges a full window, or a partial one once its own timer expires (see RFC #7440,
+*                Section 4 'Traffic Flow and Error Handling'); the server thus always sends the full
+*                window, but spreads it over more than one round-trip time while the effective window is
+*                smaller (see TFTPs_WinPaceGapGet()).
+*
+*            (8) The data of write requests, & of read requests when 'DigestRdEn' is enabled, is digested
+*                as it is written to or read from the file (see 'tftp-s_digest.c').  Data read again after a
+*                go-back is NOT digested twice.  Once the last block is acknowledged, a completion record
+*                holding the digest is passed to the 'XferDoneHook' of the configuration, so that the file
+*                does NOT need to be read again to be verified.
+*
+*            (9) Received packets are filtered by client subnet before being dispatched (see 'tftp-s_acl.c').
+*                A rejected packet costs one trie lookup : it is dropped without any session or file being
+*                looked up, & without any answer, so that denied clients can NOT make the server send
+*                packets.  Rejected packets are counted in the server statistics (see TFTPs_StatGet()).
+*
+*           (10) When TFTPs_CFG_WR_WIN_EN is enabled, write requests MAY also negotiate a window (see RFC
+*                #7440).  The server then acknowledges only the last block of each window, the last block
+*                of the file, or the last block received in order when a gap is detected, i.e. when the
+*                block ending the window is received while blocks before it are missing, or when a block
+*                received out of order can NOT be held.  Blocks received out of order within the window
+*                are held, up to TFTPs_CFG_WR_REORDER_NBR_MAX per session, in packet buffers of the
+*                session's block size, until the blocks before them are received : only contiguous data
+*                is written to the file.  When NO block is received in time, the last block received in
+*                order is acknowledged, so that the client sends the window again from the next block.
+*
+*           (11) The server opens one socket per IP family of each listener (see 'tftp-s_listen.c'), e.g.
+*                two sockets for a single listener of TFTPs_SOCK_SEL_IPv4_IPv6, & waits on all of them at
+*                once (see TFTPs_Rx()).  The packets of all the sockets are dispatched to the same sessions,
+*                & share the same buffers, caches & classes.  The packets of a session are all sent from
+*                the socket its request was received on, & are bound by the policy of its listener.
+*
+*           (12) When TFTPs_CFG_WR_EN is disabled, the server is read-only : the write path (write states,
+*                data write & acknowledgement, dally timer) is NOT built, & write requests are answered
+*                with an access violation error.
+*
+*           (13) When TFTPs_CFG_BUF_SINGLE_EN is enabled, the receive buffer is the only packet buffer of
+*                the server (see 'tftp-s_buf.c  Note #3') : the session builds its packets there, & so do
+*                error packets.  Every packet received thus overwrites the last packet of the session,
+*                which is built again rather than sent again from its buffer when retransmitted (see
+*                TFTPs_TxRegen()).  A packet deferred by the shaper is dropped when a packet is received,
+*                counted in the server statistics (see TFTPs_StatGet()), & recovered like a lost packet.
 *********************************************************************************************************
 */
 
@@ -42,6 +111,19 @@
 #define    MICRIUM_SOURCE
 #define    TFTPs_MODULE
 #include  "tftp-s.h"
+#include  "tftp-s_tmr.h"
+#include  "tftp-s_sess.h"
+#include  "tftp-s_class.h"
+#include  "tftp-s_fs.h"
+#include  "tftp-s_rewrite.h"
+#include  "tftp-s_acl.h"
+#include  "tftp-s_listen.h"
+#include  "tftp-s_capture.h"
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+#include  "tftp-s_sim.h"
+#endif
+#include  "tftp-s_perf.h"
+#include  "tftp-s_batch.h"
 #include  <Source/net_cfg_net.h>
 
 #ifdef  NET_IPv4_MODULE_EN
@@ -91,6 +173,7 @@
 #define  TFTP_PKT_OFFSET_ERR_CODE                          2
 #define  TFTP_PKT_OFFSET_ERR_MSG                           4
 #define  TFTP_PKT_OFFSET_DATA                              4
+#define  TFTP_PKT_OFFSET_OPT                               2
 
 #define  TFTP_PKT_SIZE_OPCODE                              2
 #define  TFTP_PKT_SIZE_BLK_NBR                             2
@@ -104,6 +187,7 @@
 #define  TFTP_OPCODE_DATA                                  3    /* Data                                                 */
 #define  TFTP_OPCODE_ACK                                   4    /* Acknowledge                                          */
 #define  TFTP_OPCODE_ERR                                   5    /* Error                                                */
+#define  TFTP_OPCODE_OACK                                  6    /* Option Acknowledge (see RFC #2347)                   */
 
 
 /*
@@ -121,18 +205,23 @@
 #define  TFTPs_ERR_CODE_BAD_PORT_NBR                       5    /* Unknown port number.                                 */
 #define  TFTPs_ERR_CODE_FILE_EXISTS                        6    /* File already exists.                                 */
 #define  TFTPs_ERR_CODE_NO_SUCH_USER                       7    /* No such user.                                        */
+#define  TFTPs_ERR_CODE_OPT_NEG                            8    /* Option negotiation failed (see RFC #2347).           */
+
+                                                                /* ---- TFTP Server options (see RFC #2347) ----------- */
+#define  TFTPs_OPT_NAME_BLK_SIZE                 "blksize"      /* Block size (see RFC #2348).                          */
+#define  TFTPs_OPT_NAME_WIN_SIZE              "windowsize"      /* Window size (see RFC #7440).                         */
+#define  TFTPs_OPT_NAME_TSIZE                      "tsize"      /* Transfer size (see RFC #2349).                       */
+#define  TFTPs_OPT_VAL_LEN_MAX                             5    /* Max nbr of dig of an opt val.                        */
+#define  TFTPs_OPT_TSIZE_LEN_MAX                          10    /* Max nbr of dig of a transfer size.                   */
 
                                                                 /* ---- TFTP Server modes ----------------------------- */
 #define  TFTPs_MODE_OCTET                                  1
 #define  TFTPs_MODE_NETASCII                               2
 
-                                                                /* ---- TFTP Server states ---------------------------- */
-#define  TFTPs_STATE_IDLE                                  0
-#define  TFTPs_STATE_DATA_RD                               1
-#define  TFTPs_STATE_DATA_WR                               2
-
-#define  TFTPs_BLOCK_SIZE                                512
-#define  TFTPs_BUF_SIZE                         (TFTPs_BLOCK_SIZE + TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR)
+#define  TFTPs_ERR_MSG_LEN_MAX                            64
+#define  TFTPs_REQ_LEN_MAX                               512    /* Max len of a held req (see Note #5).                 */
+#define  TFTPs_WIN_EFF_INIT                                2    /* Initial effective window size (see Note #7).         */
+#define  TFTPs_ERR_BUF_SIZE                     (TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_ERR_CODE + TFTPs_ERR_MSG_LEN_MAX + 1)
 
 
 /*
@@ -152,6 +241,60 @@
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                                    REQUESTED OPTIONS DATA TYPE
+*
+* Note(s) : (1) An option value of zero indicates that the option was NOT requested by the client.
+*
+*           (2) A transfer size of zero is requested by read requests, so the option is flagged.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_opt {
+    CPU_INT32U   BlkSize;                                       /* Requested block size  (see Note #1).                 */
+    CPU_INT32U   WinSize;                                       /* Requested window size (see Note #1).                 */
+    CPU_BOOLEAN  TSizeReq;                                      /* Transfer size requested (see Note #2).               */
+    CPU_INT32U   TSize;                                         /* Transfer size.                                       */
+} TFTPs_OPT;
+
+
+/*
+*********************************************************************************************************
+*                                       HELD REQUEST DATA TYPE
+*
+* Note(s) : (1) Requests held in the request queue (see 'tftp-s.c  Note #5') are served by class, then in
+*               the order they were received.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_req {
+    CPU_BOOLEAN     Used;                                       /* Slot holds a req.                                    */
+    TFTPs_SESS_KEY  Key;                                        /* Client TID.                                          */
+    NET_SOCK_ADDR   SockAddr;                                   /* Client sock addr.                                    */
+    CPU_INT16U      SockIx;                                     /* Server sock the req was rx'd on.                     */
+    CPU_INT32U      Seq;                                        /* Rx seq nbr (see Note #1).                            */
+    CPU_INT08U      ClassIx;                                    /* Traffic class  (see Note #1).                        */
+    CPU_INT16U      Len;                                        /* Len of req pkt.                                      */
+    CPU_INT08U      Buf[TFTPs_REQ_LEN_MAX + 1];                 /* Req pkt, NUL-terminated.                             */
+} TFTPs_REQ;
+
+
+/*
+*********************************************************************************************************
+*                                       SERVER SOCKET DATA TYPE
+*
+* Note(s) : (1) One server socket is opened per IP family of each listener (see 'tftp-s.c  Note #11').
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sock {
+    NET_SOCK_ID       ID;                                       /* Sock ID.                                             */
+    NET_SOCK_FAMILY   Family;                                   /* IP family of sock.                                   */
+    CPU_INT08U        ListenIx;                                 /* Listener of sock (see Note #1).                      */
+} TFTPs_SOCK;
+
+
 #if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
 typedef  struct {
     CPU_INT16U  Id;                                             /* Event ID.                                            */
@@ -174,28 +317,27 @@ typedef  struct {
 
 TFTPs_CFG         *TFTPs_CfgPtr;
 
-CPU_INT16U         TFTPs_RxBlkNbr;                              /* Current block number received.                       */
-CPU_INT08U         TFTPs_RxMsgBuf[TFTPs_BUF_SIZE];              /* Incoming packet buffer.                              */
+CPU_INT08U        *TFTPs_RxMsgBuf;                              /* Incoming packet buffer.                              */
+CPU_INT32U         TFTPs_RxMsgBufSize;
 CPU_INT32U         TFTPs_RxMsgCtr;                              /* Number of messages received.                         */
 CPU_INT32S         TFTPs_RxMsgLen;
 
-CPU_INT16U         TFTPs_TxBlkNbr;                              /* Current block number being sent.                     */
-CPU_INT08U         TFTPs_TxMsgBuf[TFTPs_BUF_SIZE];              /* Outgoing packet buffer.                              */
 CPU_INT16U         TFTPs_TxMsgCtr;
-CPU_SIZE_T         TFTPs_TxMsgLen;
+#if (TFTPs_CFG_BUF_SINGLE_EN != DEF_ENABLED)
+CPU_INT08U         TFTPs_TxErrBuf[TFTPs_ERR_BUF_SIZE];          /* Outgoing error packet buffer.                        */
+#endif
 
-NET_SOCK_ADDR      TFTPs_SockAddr;
+NET_SOCK_ADDR      TFTPs_SockAddr;                              /* Remote addr of last pkt rx'd.                        */
 NET_SOCK_ADDR_LEN  TFTPs_SockAddrLen;
-NET_SOCK_ID        TFTPs_SockID;
-
-CPU_INT08U         TFTPs_State;                                 /* Current state of TFTPs state machine.                */
+TFTPs_SOCK        *TFTPs_SockTbl;                               /* Server socks (see Note #11).                         */
+CPU_INT16U         TFTPs_SockNbr;                               /* Nbr of server socks.                                 */
 
 CPU_INT16U         TFTPs_OpCode;
 
-void              *TFTPs_FileHandle;                            /* File handle of currently opened file.                */
-
 CPU_BOOLEAN        TFTPs_ServerEn;
 
+TFTPs_SESS        *TFTPs_SessCurPtr;                            /* Session of last pkt rx'd or tmr expired.             */
+
 
 #if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
 CPU_CHAR           TFTPs_DispTbl[TFTPs_TRACE_HIST_SIZE + 2][TFTPs_TRACE_STR_SIZE];
@@ -207,6 +349,22 @@ static  TFTPs_TRACE_STRUCT  TFTPs_TraceTbl[TFTPs_TRACE_HIST_SIZE];
 static  CPU_INT16U          TFTPs_TraceIx;
 #endif
 
+static  TFTPs_SESS         *TFTPs_TxQ_HeadPtr;                  /* Head of tx Q (see Note #4).                          */
+static  TFTPs_SESS         *TFTPs_TxQ_TailPtr;                  /* Tail of tx Q.                                        */
+static  TFTPs_TMR           TFTPs_TxSchedTmr;                   /* Wakes the tx sched when tokens are available.        */
+
+static  TFTPs_REQ          *TFTPs_ReqQ_Tbl;                     /* Held reqs (see Note #5).                             */
+static  CPU_INT16U          TFTPs_ReqQ_NbrUsed;                 /* Nbr of held reqs.                                    */
+static  CPU_INT32U          TFTPs_ReqQ_SeqNext;                 /* Seq nbr of next held req.                            */
+
+static  TFTPs_STAT          TFTPs_Stat;                         /* Server stats (see Note #9).                          */
+
+static  CPU_INT16U          TFTPs_SockRxIx;                     /* Sock rd first (see 'TFTPs_Rx()  Note #2').           */
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+static  TFTPs_OPT           TFTPs_OAckOpt;                      /* Opt of the session's req (see Note #13).             */
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -216,48 +374,158 @@ static  CPU_INT16U          TFTPs_TraceIx;
 *********************************************************************************************************
 */
 
+#if (TFTPs_CFG_SIM_EN != DEF_ENABLED)
 static  void                TFTPs_TaskInit      (TFTPs_TASK_CFG  *p_task_cfg,
                                                  TFTPs_ERR       *p_err);
+#endif
 
 static  void                TFTPs_Task          (void            *p_data);
 
-static  TFTPs_ERR           TFTPs_ServerSockInit(NET_SOCK_FAMILY  family);
+#if (TFTPs_CFG_ACL_EN == DEF_ENABLED)
+static  CPU_BOOLEAN         TFTPs_RxFilter      (NET_SOCK_ADDR   *p_addr);
+#endif
+
+static  NET_SOCK_RTN_CODE   TFTPs_Rx            (CPU_INT32U       timeout_ms,
+                                                 CPU_INT16S       rx_flags,
+                                                 NET_SOCK_ADDR   *p_addr,
+                                                 CPU_INT16U      *p_sock_ix);
+
+static  void                TFTPs_SockInit      (TFTPs_ERR       *p_err);
+
+static  void                TFTPs_SockClose     (void);
+
+static  TFTPs_ERR           TFTPs_ServerSockInit(       NET_SOCK_FAMILY    family,
+                                                 const  TFTPs_LISTEN_CFG  *p_listen_cfg,
+                                                        NET_SOCK_ID       *p_sock_id);
+
+
+static  TFTPs_ERR           TFTPs_StateIdle     (TFTPs_SESS      *p_sess);
+
+static  TFTPs_ERR           TFTPs_StateDataRd   (TFTPs_SESS      *p_sess);
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  TFTPs_ERR           TFTPs_StateDataWr   (TFTPs_SESS      *p_sess);
 
+static  TFTPs_ERR           TFTPs_StateDally    (TFTPs_SESS      *p_sess);
+#endif
+
+
+static  void                TFTPs_GetRxBlkNbr   (TFTPs_SESS      *p_sess);
+
+static  void                TFTPs_Terminate     (TFTPs_SESS      *p_sess);
+
+static  void                TFTPs_XferDone      (TFTPs_SESS      *p_sess,
+                                                 CPU_BOOLEAN      wr);
+
+
+                                                                /* -------------------- TMR FNCTS --------------------- */
+static  void                TFTPs_TxRetxStart   (TFTPs_SESS      *p_sess);
+
+static  void                TFTPs_TmrRetxHandler(void            *p_arg);
 
-static  TFTPs_ERR           TFTPs_StateIdle     (void);
+static  void                TFTPs_TmrIdleHandler(void            *p_arg);
 
-static  TFTPs_ERR           TFTPs_StateDataRd   (void);
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  void                TFTPs_TmrDallyHandler(void            *p_arg);
+#endif
 
-static  TFTPs_ERR           TFTPs_StateDataWr   (void);
+static  void                TFTPs_TmrTxSchedHandler(void          *p_arg);
 
+static  void                TFTPs_TmrPaceHandler(void            *p_arg);
 
-static  void                TFTPs_GetRxBlkNbr   (void);
 
-static  void                TFTPs_Terminate     (void);
+static  TFTPs_ERR           TFTPs_ReqStart      (TFTPs_SESS      *p_sess,
+                                                 CPU_BOOLEAN      rw);
 
+static  void                TFTPs_OptParse      (TFTPs_OPT       *p_opt);
 
-static  TFTPs_ERR           TFTPs_FileOpen      (CPU_BOOLEAN      rw);
+static  TFTPs_ERR           TFTPs_FileOpen      (TFTPs_SESS      *p_sess,
+                                                 CPU_BOOLEAN      rw);
 
-static  void               *TFTPs_FileOpenMode  (CPU_CHAR        *p_filename,
+static  TFTPs_FS_FILE      *TFTPs_FileOpenMode  (CPU_CHAR        *p_filename,
                                                  CPU_BOOLEAN      rw);
 
 
-static  TFTPs_ERR           TFTPs_DataRd        (void);
+static  TFTPs_ERR           TFTPs_DataRd        (TFTPs_SESS      *p_sess);
+
+static  TFTPs_ERR           TFTPs_WinTx         (TFTPs_SESS      *p_sess);
+
+static  TFTPs_ERR           TFTPs_WinRewind     (TFTPs_SESS      *p_sess);
+
+static  CPU_INT32U          TFTPs_WinPaceGapGet (TFTPs_SESS      *p_sess);
+
+static  void                TFTPs_WinEffDec     (TFTPs_SESS      *p_sess);
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  TFTPs_ERR           TFTPs_DataWr        (TFTPs_SESS      *p_sess);
 
-static  TFTPs_ERR           TFTPs_DataWr        (void);
+static  CPU_BOOLEAN         TFTPs_DataWrBlk     (TFTPs_SESS      *p_sess,
+                                                 CPU_INT08U      *p_data,
+                                                 CPU_INT32S       data_len);
 
-static  void                TFTPs_DataWrAck     (CPU_INT32U       blk_nbr);
+static  void                TFTPs_DataWrAck     (TFTPs_SESS      *p_sess,
+                                                 CPU_INT32U       blk_nbr);
+#endif
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+static  CPU_BOOLEAN         TFTPs_DataWrHold    (TFTPs_SESS      *p_sess,
+                                                 CPU_INT16U       blk_nbr,
+                                                 CPU_INT08U      *p_data,
+                                                 CPU_INT32S       data_len);
+
+static  CPU_BOOLEAN         TFTPs_DataWrHeldWr  (TFTPs_SESS      *p_sess,
+                                                 CPU_BOOLEAN     *p_last_blk);
+
+static  void                TFTPs_DataWrHeldFree(TFTPs_SESS      *p_sess);
+#endif
 
 
                                                                 /* --------------------- TX FNCTS --------------------- */
-static  void                TFTPs_TxErr         (CPU_INT16U       err_code,
+static  void                TFTPs_TxErr         (CPU_INT16U       sock_ix,
+                                                 NET_SOCK_ADDR   *p_addr,
+                                                 CPU_INT16U       err_code,
                                                  CPU_CHAR        *p_err_msg);
 
-static  NET_SOCK_RTN_CODE   TFTPs_Tx            (CPU_INT16U       opcode,
+static  NET_SOCK_RTN_CODE   TFTPs_Tx            (CPU_INT16U       sock_ix,
+                                                 NET_SOCK_ADDR   *p_addr,
+                                                 CPU_INT16U       opcode,
                                                  CPU_INT16U       blk_nbr,
                                                  CPU_INT08U      *p_buf,
                                                  CPU_INT16U       len);
 
+static  void                TFTPs_TxOAck        (TFTPs_SESS      *p_sess,
+                                                 TFTPs_OPT       *p_opt);
+
+static  void                TFTPs_TxSess        (TFTPs_SESS      *p_sess);
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+static  TFTPs_ERR           TFTPs_TxRegen       (TFTPs_SESS      *p_sess);
+#endif
+
+static  void                TFTPs_TxSched       (void);
+
+static  void                TFTPs_TxQ_Insert    (TFTPs_SESS      *p_sess);
+
+static  void                TFTPs_TxQ_Remove    (TFTPs_SESS      *p_sess);
+
+static  CPU_BOOLEAN         TFTPs_ReqQ_Push     (TFTPs_SESS_KEY  *p_key,
+                                                 NET_SOCK_ADDR   *p_addr,
+                                                 CPU_INT16U       sock_ix);
+
+static  CPU_BOOLEAN         TFTPs_ReqQ_Pop      (NET_SOCK_ADDR   *p_addr,
+                                                 CPU_INT16U      *p_sock_ix);
+
+static  void                TFTPs_ReqQ_Clr      (void);
+
+static  void                TFTPs_TxHdrSet      (CPU_INT08U      *p_buf,
+                                                 CPU_INT16U       opcode,
+                                                 CPU_INT16U       blk_nbr);
+
+static  NET_SOCK_RTN_CODE   TFTPs_TxPkt         (CPU_INT16U       sock_ix,
+                                                 NET_SOCK_ADDR   *p_addr,
+                                                 CPU_INT08U      *p_buf,
+                                                 CPU_INT16U       len);
+
 
                                                                 /* ------------------- TRACE FNCTS -------------------- */
 #if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
@@ -272,10 +540,11 @@ static  void                TFTPs_Trace         (CPU_INT16U       id,
 *********************************************************************************************************
 *                                            TFTPs_Init()
 *
-* Description : (1) Initialize & startup the TFTP server :
+* Description : Initialize & startup the TFTP server :
 *
 *                   (a) Initialize TFTP server global variables & counters
-*                   (b) Initialize TFTP server global OS objects
+*                   (b) Allocate   TFTP server sessions & buffers (see Note #1)
+*                   (c) Initialize TFTP server global OS objects
 *
 *
 * Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
@@ -286,6 +555,48 @@ static  void                TFTPs_Trace         (CPU_INT16U       id,
 *
 *                               TFTPs_ERR_NONE
 *                               TFTPs_ERR_CFG_INVALID_SOCK_FAMILY
+*                               TFTPs_ERR_CFG_INVALID_SESS_NBR
+*                               TFTPs_ERR_CFG_INVALID_SCHED
+*                               TFTPs_ERR_CFG_INVALID_WIN
+*                               TFTPs_ERR_CFG_INVALID_DIGEST
+*                               TFTPs_ERR_CFG_INVALID_BUF_SINGLE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+*                               ------------ RETURNED BY TFTPs_SessInit() ------------
+*                               See TFTPs_SessInit() for additional return error codes.
+*
+*                               ------------- RETURNED BY TFTPs_FS_Init() ------------
+*                               See TFTPs_FS_Init() for additional return error codes.
+*
+*                               ------------ RETURNED BY TFTPs_BufInit() -------------
+*                               See TFTPs_BufInit() for additional return error codes.
+*
+*                               ----------- RETURNED BY TFTPs_ClassInit() ------------
+*                               See TFTPs_ClassInit() for additional return error codes.
+*
+*                               ---------- RETURNED BY TFTPs_RewriteInit() -----------
+*                               See TFTPs_RewriteInit() for additional return error codes.
+*
+*                               ---------- RETURNED BY TFTPs_ListenInit() ------------
+*                               See TFTPs_ListenInit() for additional return error codes.
+*
+*                               --------- RETURNED BY TFTPs_CaptureInit() ------------
+*                               See TFTPs_CaptureInit() for additional return error codes.
+*
+*                               --------- RETURNED BY TFTPs_TxBatchInit() ------------
+*                               See TFTPs_TxBatchInit() for additional return error codes.
+*
+*                               ----------- RETURNED BY TFTPs_SimInit() -------------
+*                               See TFTPs_SimInit() for additional return error codes.
+*
+*                               ------------ RETURNED BY TFTPs_ACL_Init() ------------
+*                               See TFTPs_ACL_Init() for additional return error codes.
+*
+*                               ----------- RETURNED BY TFTPs_ShapeInit() ------------
+*                               See TFTPs_ShapeInit() for additional return error codes.
+*
+*                               ------------ RETURNED BY TFTPs_SockInit() ------------
+*                               See TFTPs_SockInit() for additional return error codes.
 *
 *                               ------------ RETURNED BY TFTPs_TaskInit() ------------
 *                               See TFTPs_TaskInit() for additional return error codes.
@@ -298,7 +609,20 @@ static  void                TFTPs_Trace         (CPU_INT16U       id,
 *               This function is a TFTP server application interface (API) function & MAY be called by
 *               application function(s).
 *
-* Note(s)     : None.
+* Note(s)     : (1) Every object used by the server (sessions, packet buffers, receive buffer, request queue)
+*                   is allocated here, so that the server's RAM usage is fixed once initialized.
+*
+*               (2) Each received packet is NUL-terminated in the receive buffer, so that the strings of a
+*                   request can be parsed safely.
+*
+*               (3) When the network is simulated, NO task is created : the server runs in the task calling
+*                   TFTPs_SimRun() (see 'tftp-s_sim.c  Note #2').
+*
+*               (4) The single packet buffer is lent to one session at a time, & can NOT hold a request
+*                   for later (see 'tftp-s.c  Note #13').
+*
+*               (5) The sockets of the listeners are opened last, so that they are only left open once the
+*                   server is initialized, & are closed if the server task can NOT be created.
 *********************************************************************************************************
 */
 
@@ -307,6 +631,7 @@ CPU_BOOLEAN  TFTPs_Init (const TFTPs_CFG             *p_cfg,
                                TFTPs_ERR             *p_err)
 {
     CPU_BOOLEAN  result;
+    LIB_ERR      err_lib;
 
 
 #if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABELD)
@@ -328,67 +653,207 @@ CPU_BOOLEAN  TFTPs_Init (const TFTPs_CFG             *p_cfg,
 #endif
 
                                                                 /* -------------- INIT TFTPs GLOBAL VARS -------------- */
-    TFTPs_RxBlkNbr   = 0;
     TFTPs_RxMsgCtr   = 0;
-    TFTPs_TxBlkNbr   = 0;
     TFTPs_TxMsgCtr   = 0;
+    Mem_Clr(&TFTPs_Stat, sizeof(TFTPs_Stat));
 
-    TFTPs_FileHandle = (void *)0;
-    TFTPs_State      = TFTPs_STATE_IDLE;
+    TFTPs_SessCurPtr = DEF_NULL;
     TFTPs_ServerEn   = DEF_ENABLED;
 
-    switch (p_cfg->SockSel) {
-        case TFTPs_SOCK_SEL_IPv4:
-#ifndef   NET_IPv4_MODULE_EN
-             result = DEF_FAIL;
-            *p_err  = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
-             goto exit;
-#else
-             break;
-#endif  /* NET_IPv4_MODULE_EN */
+    if (p_cfg->SessNbrMax < 1u) {
+        result = DEF_FAIL;
+       *p_err  = TFTPs_ERR_CFG_INVALID_SESS_NBR;
+        goto exit;
+    }
 
+    if ((p_cfg->SchedPolicy != TFTPs_SCHED_POLICY_FIFO) &&
+        (p_cfg->SchedPolicy != TFTPs_SCHED_POLICY_SRTF)) {
+        result = DEF_FAIL;
+       *p_err  = TFTPs_ERR_CFG_INVALID_SCHED;
+        goto exit;
+    }
 
-        case TFTPs_SOCK_SEL_IPv6:
-#ifndef   NET_IPv6_MODULE_EN
-             result = DEF_FAIL;
-            *p_err  = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
-             goto exit;
+    if (p_cfg->WinSizeMax < 1u) {
+        result = DEF_FAIL;
+       *p_err  = TFTPs_ERR_CFG_INVALID_WIN;
+        goto exit;
+    }
+
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+    if ((p_cfg->DigestAlg != TFTPs_DIGEST_ALG_NONE)  &&
+        (p_cfg->DigestAlg != TFTPs_DIGEST_ALG_CRC32) &&
+        (p_cfg->DigestAlg != TFTPs_DIGEST_ALG_SHA256)) {
 #else
-             break;
-#endif  /* NET_IPv6_MODULE_EN */
+    if (p_cfg->DigestAlg != TFTPs_DIGEST_ALG_NONE) {
+#endif
+        result = DEF_FAIL;
+       *p_err  = TFTPs_ERR_CFG_INVALID_DIGEST;
+        goto exit;
+    }
 
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    if ((p_cfg->SessNbrMax != 1u) ||                            /* See Note #4.                                         */
+        (p_cfg->ReqQ_Size  != 0u)) {
+        result = DEF_FAIL;
+       *p_err  = TFTPs_ERR_CFG_INVALID_BUF_SINGLE;
+        goto exit;
+    }
+#endif
 
-        case TFTPs_SOCK_SEL_IPv4_IPv6:
-#ifndef   NET_IPv4_MODULE_EN
-             result = DEF_FAIL;
-            *p_err  = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
-             goto exit;
-#endif  /* NET_IPv4_MODULE_EN */
+    TFTPs_CfgPtr = (TFTPs_CFG *)p_cfg;
 
-#ifndef   NET_IPv6_MODULE_EN
-             result = DEF_FAIL;
-            *p_err  = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
-             goto exit;
-#else
-             break;
-#endif  /* NET_IPv6_MODULE_EN */
+                                                                /* ---------------- ALLOC TFTPs SESSIONS -------------- */
+    TFTPs_SessInit(p_cfg->SessNbrMax,
+                   p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
 
+                                                                /* --------------- ALLOC FILES & DECODERS ------------- */
+    TFTPs_FS_Init(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
 
-        default:
-             result = DEF_FAIL;
-            *p_err = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
-             goto  exit;
+                                                                /* ------------------ ALLOC PKT BUFS ------------------ */
+    TFTPs_BufInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
+                                                                /* Rx buf fits largest blk, plus a NUL (see Note #2).   */
+    TFTPs_RxMsgBufSize = TFTPs_BufBlkSizeMaxGet() + TFTPs_BUF_HDR_SIZE + 1u;
+    TFTPs_RxMsgBuf     = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Rx Buf",
+                                                                DEF_NULL,
+                                                                TFTPs_RxMsgBufSize,
+                                                               &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+        result = DEF_FAIL;
+       *p_err  = TFTPs_ERR_MEM_ALLOC;
+        goto exit;
     }
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    TFTPs_BufSingleSet(TFTPs_RxMsgBuf);                         /* Rx buf is the only pkt buf (see Note #4).            */
+#endif
 
-    TFTPs_CfgPtr = (TFTPs_CFG *)p_cfg;
+                                                                /* --------------- INIT TRAFFIC CLASSES --------------- */
+    TFTPs_ClassInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
+
+#if (TFTPs_CFG_REWRITE_EN == DEF_ENABLED)
+                                                                /* ------------- COMPILE FILE REWRITE RULES ----------- */
+    TFTPs_RewriteInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
+#endif
+
+                                                                /* ----------------- INIT LISTENERS ------------------- */
+    TFTPs_ListenInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+                                                                /* Alloc a sock per IP family of each listener.         */
+    TFTPs_SockNbr = 0u;
+    TFTPs_SockTbl = (TFTPs_SOCK *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Sock Tbl",
+                                                          DEF_NULL,
+                                               (CPU_SIZE_T)TFTPs_ListenNbrGet() * 2u * sizeof(TFTPs_SOCK),
+                                                         &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+        result = DEF_FAIL;
+       *p_err  = TFTPs_ERR_MEM_ALLOC;
+        goto exit;
+    }
+
+#if (TFTPs_CFG_CAPTURE_EN == DEF_ENABLED)
+                                                                /* ---------------- INIT PKT CAPTURE ------------------ */
+    TFTPs_CaptureInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
+
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+                                                                /* ---------------- INIT TX BATCHES ------------------- */
+    TFTPs_TxBatchInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
+
+#if (TFTPs_CFG_PERF_EN == DEF_ENABLED)
+    TFTPs_PerfInit();                                           /* Init perf probes.                                    */
+#endif
+
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+                                                                /* ------------------ INIT SIMULATION ----------------- */
+    TFTPs_SimInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
+
+#if (TFTPs_CFG_ACL_EN == DEF_ENABLED)
+                                                                /* ---------------- BUILD ADDR FILTER ----------------- */
+    TFTPs_ACL_Init(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
+#endif
+
+    TFTPs_ReqQ_Tbl     = DEF_NULL;
+    TFTPs_ReqQ_NbrUsed = 0u;
+    TFTPs_ReqQ_SeqNext = 0u;
+    if (p_cfg->ReqQ_Size > 0u) {
+        TFTPs_ReqQ_Tbl = (TFTPs_REQ *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Req Q",
+                                                             DEF_NULL,
+                                                   (CPU_SIZE_T)p_cfg->ReqQ_Size * sizeof(TFTPs_REQ),
+                                                            &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+            result = DEF_FAIL;
+           *p_err  = TFTPs_ERR_MEM_ALLOC;
+            goto exit;
+        }
+        TFTPs_ReqQ_Clr();
+    }
+
+                                                                /* ---------------- INIT EGRESS SHAPER ---------------- */
+    TFTPs_ShapeInit(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
+
+                                                                /* ----------------- OPEN SERVER SOCKS ---------------- */
+    TFTPs_SockInit(p_err);                                      /* See Note #5.                                         */
+    if (*p_err != TFTPs_ERR_NONE) {
+         result = DEF_FAIL;
+         goto exit;
+    }
 
+#if (TFTPs_CFG_SIM_EN != DEF_ENABLED)
                                                                 /* ------------- PERFORM TFTPs TASK INIT -------------- */
     TFTPs_TaskInit((TFTPs_TASK_CFG *)p_task_cfg,
                                      p_err);
     if (*p_err != TFTPs_ERR_NONE) {
+         TFTPs_SockClose();
          result = DEF_FAIL;
          goto exit;
     }
+#else
+    (void)p_task_cfg;                                           /* See Note #3.                                         */
+#endif
 
     result = DEF_OK;
    *p_err  = TFTPs_ERR_NONE;
@@ -421,7 +886,6 @@ exit:
 void  TFTPs_En (void)
 {
     TFTPs_ServerEn = DEF_ENABLED;
-    TFTPs_State    = TFTPs_STATE_IDLE;
 }
 
 
@@ -440,84 +904,301 @@ void  TFTPs_En (void)
 *               This function is a TFTP server application interface (API) function & MAY be called by
 *               application function(s).
 *
-* Note(s)     : none.
+* Note(s)     : (1) The sessions in progress, if any, are terminated by the TFTP server task the next time it
+*                   wakes up, since the sessions' timers MUST only be handled from the server task.
 *********************************************************************************************************
 */
 
 void  TFTPs_Dis (void)
 {
-    TFTPs_ServerEn = DEF_DISABLED;
-    TFTPs_Terminate();
+    TFTPs_ServerEn = DEF_DISABLED;                              /* See Note #1.                                         */
 }
 
 
 /*
 *********************************************************************************************************
-*                                            TFTPs_Disp()
+*                                         TFTPs_SessStatGet()
 *
-* Description : Output information about the TFTP server module for displaying on an ASCII display.
+* Description : Get the statistics of the sessions in progress.
 *
-* Argument(s) : none.
+* Argument(s) : p_stat_tbl      Pointer to table that will receive the statistics of one session per entry.
 *
-* Return(s)   : none.
+*               stat_nbr_max    Number of entries of the table.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   TFTPs_ERR_NONE
+*                                   TFTPs_ERR_NULL_PTR
+*
+* Return(s)   : Number of entries filled.
 *
 * Caller(s)   : Application.
 *
 *               This function is a TFTP server application interface (API) function & MAY be called by
 *               application function(s).
 *
-* Note(s)     : none.
+* Note(s)     : (1) The sessions are read with interrupts disabled, so that the TFTP server task can NOT
+*                   change them while they are copied.  The time spent so is bounded by 'stat_nbr_max'.
 *********************************************************************************************************
 */
 
-#if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
-void  TFTPs_Disp (void)
+CPU_INT16U  TFTPs_SessStatGet (TFTPs_SESS_STAT  *p_stat_tbl,
+                               CPU_INT16U        stat_nbr_max,
+                               TFTPs_ERR        *p_err)
 {
-#ifdef  NET_IPv4_MODULE_EN
-    NET_SOCK_ADDR_IPv4  *p_addrv4;
-#endif
-#ifdef  NET_IPv6_MODULE_EN
-    NET_SOCK_ADDR_IPv6  *p_addrv6;
-#endif
-    CPU_CHAR             str[TFTPs_TRACE_STR_SIZE];
-    CPU_INT16U           i;
-    NET_ERR              err;
+    TFTPs_SESS       *p_sess;
+    TFTPs_SESS_STAT  *p_stat;
+    CPU_INT16U        nbr;
+    CPU_SR_ALLOC();
 
 
-                                              /*           1111111111222222222233333333334444444444555555555566666666667777777777 */
-                                              /* 01234567890123456789012345678901234567890123456789012345678901234567890123456789 */
-    Str_Copy(&TFTPs_DispTbl[ 0][0], (CPU_CHAR *)"------------------------------------ TFTPs ------------------------------------");
-    Str_Copy(&TFTPs_DispTbl[ 1][0], (CPU_CHAR *)"State      : xxxxxxxxxx                                                        ");
-    Str_Copy(&TFTPs_DispTbl[ 2][0], (CPU_CHAR *)"OpCode     : xxxxxx                                                            ");
-    Str_Copy(&TFTPs_DispTbl[ 3][0], (CPU_CHAR *)"                                                                               ");
-    Str_Copy(&TFTPs_DispTbl[ 4][0], (CPU_CHAR *)"Rx Msg Ctr : xxxxx                                                             ");
-    Str_Copy(&TFTPs_DispTbl[ 5][0], (CPU_CHAR *)"Rx Block # : xxxxx                                                             ");
-    Str_Copy(&TFTPs_DispTbl[ 6][0], (CPU_CHAR *)"Rx Msg Len : xxxxx                                                             ");
-    Str_Copy(&TFTPs_DispTbl[ 7][0], (CPU_CHAR *)"Rx Msg     : xx xx xx xx xx xx xx xx xx xx xx                                  ");
-    Str_Copy(&TFTPs_DispTbl[ 8][0], (CPU_CHAR *)"                                                                               ");
-    Str_Copy(&TFTPs_DispTbl[ 9][0], (CPU_CHAR *)"Tx Msg Ctr : xxxxx                                                             ");
-    Str_Copy(&TFTPs_DispTbl[10][0], (CPU_CHAR *)"Tx Block # : xxxxx                                                             ");
-    Str_Copy(&TFTPs_DispTbl[11][0], (CPU_CHAR *)"Tx Msg Len : xxxxx                                                             ");
-    Str_Copy(&TFTPs_DispTbl[12][0], (CPU_CHAR *)"Tx Msg     : xx xx xx xx xx xx xx xx xx xx xx                                  ");
-    Str_Copy(&TFTPs_DispTbl[13][0], (CPU_CHAR *)"                                                                               ");
-    Str_Copy(&TFTPs_DispTbl[14][0], (CPU_CHAR *)"Source IP  : xx.xx.xx.xx                                                       ");
-    Str_Copy(&TFTPs_DispTbl[15][0], (CPU_CHAR *)"Dest   IP  : xx.xx.xx.xx                                                       ");
-                                              /*           1111111111222222222233333333334444444444555555555566666666667777777777 */
-                                              /* 01234567890123456789012345678901234567890123456789012345678901234567890123456789 */
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(0u);
+    }
 
-                                                                /* Display state of TFTPs state machine.                */
-    switch (TFTPs_State) {
-        case TFTPs_STATE_IDLE:
-             Str_Copy(&TFTPs_DispTbl[1][13], (CPU_CHAR *)"IDLE      ");
-             break;
+    if (p_stat_tbl == DEF_NULL) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
 
-        case TFTPs_STATE_DATA_RD:
-             Str_Copy(&TFTPs_DispTbl[1][13], (CPU_CHAR *)"DATA READ ");
-             break;
+    nbr = 0u;
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    p_sess = TFTPs_SessActiveFirstGet();
+    while ((p_sess != DEF_NULL) &&
+           (nbr    <  stat_nbr_max)) {
+        p_stat = &p_stat_tbl[nbr];
+
+        Mem_Copy(&p_stat->ClientAddr[0], &p_sess->Key.Addr[0], sizeof(p_stat->ClientAddr));
+        p_stat->ClientPort   = NET_UTIL_NET_TO_HOST_16(p_sess->Key.Port);
+        p_stat->ClientFamily = p_sess->Key.Family;
+        p_stat->BlkSize      = p_sess->BlkSize;
+        p_stat->WinSize      = p_sess->WinSize;
+        p_stat->WinEff       = p_sess->WinEff;
+        p_stat->RTT_Avg      = p_sess->RTT_Avg;
+        p_stat->XferRem      = p_sess->XferRem;
+
+        nbr++;
+        p_sess = p_sess->NextPtr;
+    }
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+
+    return (nbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_StatGet()
+*
+* Description : Get the statistics of the server.
+*
+* Argument(s) : p_stat      Pointer to variable that will receive the statistics.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_NULL_PTR
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The counters are read with interrupts disabled, so that they are consistent with one
+*                   another.
+*********************************************************************************************************
+*/
+
+void  TFTPs_StatGet (TFTPs_STAT  *p_stat,
+                     TFTPs_ERR   *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+
+    if (p_stat == DEF_NULL) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+   *p_stat          = TFTPs_Stat;
+    p_stat->RxPktCtr = TFTPs_RxMsgCtr;
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_SimRun()
+*
+* Description : Run the server against a simulated network.
+*
+* Argument(s) : p_scenario  Pointer to scenario of the run (see 'tftp-s_type.h  SIMULATION SCENARIO DATA
+*                           TYPE').
+*
+*               p_result    Pointer to variable that will receive the results of the run.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_NULL_PTR
+*
+*                               ----------- RETURNED BY TFTPs_SimStart() ------------
+*                               See TFTPs_SimStart() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The server loop runs in the calling task until the run is done (see 'tftp-s_sim.c
+*                   Note #2'), so that runs are computed one after the other.  The server MUST be initialized
+*                   & enabled first.
+*
+*               (2) A run whose clients did NOT all end their transfer is NOT an error : the status of each
+*                   client is returned in its result (see 'tftp-s_type.h  SIMULATION RESULT DATA TYPES').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+void  TFTPs_SimRun (const  TFTPs_SIM_SCENARIO  *p_scenario,
+                           TFTPs_SIM_RESULT    *p_result,
+                           TFTPs_ERR           *p_err)
+{
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+
+    if ((p_scenario == DEF_NULL) ||
+        (p_result   == DEF_NULL)) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+    TFTPs_SimStart(p_scenario, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        return;
+    }
+
+    TFTPs_Task(DEF_NULL);                                       /* See Note #1.                                         */
+
+    TFTPs_SimResultGet(p_result);                               /* See Note #2.                                         */
+
+   *p_err = TFTPs_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            TFTPs_Disp()
+*
+* Description : Output information about the TFTP server module for displaying on an ASCII display.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
+void  TFTPs_Disp (void)
+{
+#ifdef  NET_IPv4_MODULE_EN
+    NET_SOCK_ADDR_IPv4  *p_addrv4;
+#endif
+#ifdef  NET_IPv6_MODULE_EN
+    NET_SOCK_ADDR_IPv6  *p_addrv6;
+#endif
+    TFTPs_SESS          *p_sess;
+    CPU_INT08U          *p_tx_buf;
+    CPU_SIZE_T           tx_len;
+    CPU_INT16U           rx_blk_nbr;
+    CPU_INT16U           tx_blk_nbr;
+    CPU_INT08U           state;
+    CPU_CHAR             str[TFTPs_TRACE_STR_SIZE];
+    CPU_INT16U           i;
+    NET_ERR              err;
+
+
+                                              /*           1111111111222222222233333333334444444444555555555566666666667777777777 */
+                                              /* 01234567890123456789012345678901234567890123456789012345678901234567890123456789 */
+    Str_Copy(&TFTPs_DispTbl[ 0][0], (CPU_CHAR *)"------------------------------------ TFTPs ------------------------------------");
+    Str_Copy(&TFTPs_DispTbl[ 1][0], (CPU_CHAR *)"State      : xxxxxxxxxx                                                        ");
+    Str_Copy(&TFTPs_DispTbl[ 2][0], (CPU_CHAR *)"OpCode     : xxxxxx                                                            ");
+    Str_Copy(&TFTPs_DispTbl[ 3][0], (CPU_CHAR *)"Sessions   : xxxxx                                                             ");
+    Str_Copy(&TFTPs_DispTbl[ 4][0], (CPU_CHAR *)"Rx Msg Ctr : xxxxx                                                             ");
+    Str_Copy(&TFTPs_DispTbl[ 5][0], (CPU_CHAR *)"Rx Block # : xxxxx                                                             ");
+    Str_Copy(&TFTPs_DispTbl[ 6][0], (CPU_CHAR *)"Rx Msg Len : xxxxx                                                             ");
+    Str_Copy(&TFTPs_DispTbl[ 7][0], (CPU_CHAR *)"Rx Msg     : xx xx xx xx xx xx xx xx xx xx xx                                  ");
+    Str_Copy(&TFTPs_DispTbl[ 8][0], (CPU_CHAR *)"                                                                               ");
+    Str_Copy(&TFTPs_DispTbl[ 9][0], (CPU_CHAR *)"Tx Msg Ctr : xxxxx                                                             ");
+    Str_Copy(&TFTPs_DispTbl[10][0], (CPU_CHAR *)"Tx Block # : xxxxx                                                             ");
+    Str_Copy(&TFTPs_DispTbl[11][0], (CPU_CHAR *)"Tx Msg Len : xxxxx                                                             ");
+    Str_Copy(&TFTPs_DispTbl[12][0], (CPU_CHAR *)"Tx Msg     : xx xx xx xx xx xx xx xx xx xx xx                                  ");
+    Str_Copy(&TFTPs_DispTbl[13][0], (CPU_CHAR *)"                                                                               ");
+    Str_Copy(&TFTPs_DispTbl[14][0], (CPU_CHAR *)"Source IP  : xx.xx.xx.xx                                                       ");
+    Str_Copy(&TFTPs_DispTbl[15][0], (CPU_CHAR *)"Dest   IP  : xx.xx.xx.xx                                                       ");
+                                              /*           1111111111222222222233333333334444444444555555555566666666667777777777 */
+                                              /* 01234567890123456789012345678901234567890123456789012345678901234567890123456789 */
+
+    p_sess = TFTPs_SessCurPtr;                                  /* Display last session handled.                        */
+    if (p_sess != DEF_NULL) {
+        state      = p_sess->State;
+        rx_blk_nbr = p_sess->RxBlkNbr;
+        tx_blk_nbr = p_sess->TxBlkNbr;
+        tx_len     = p_sess->TxMsgLen;
+        p_tx_buf   = p_sess->TxBufPtr;
+    } else {
+        state      = TFTPs_STATE_IDLE;
+        rx_blk_nbr = 0u;
+        tx_blk_nbr = 0u;
+        tx_len     = 0u;
+        p_tx_buf   = DEF_NULL;
+    }
+
+                                                                /* Display state of TFTPs state machine.                */
+    switch (state) {
+        case TFTPs_STATE_IDLE:
+             Str_Copy(&TFTPs_DispTbl[1][13], (CPU_CHAR *)"IDLE      ");
+             break;
+
+        case TFTPs_STATE_DATA_RD:
+             Str_Copy(&TFTPs_DispTbl[1][13], (CPU_CHAR *)"DATA READ ");
+             break;
 
         case TFTPs_STATE_DATA_WR:
              Str_Copy(&TFTPs_DispTbl[1][13], (CPU_CHAR *)"DATA WRITE");
              break;
+
+        case TFTPs_STATE_DALLY:
+             Str_Copy(&TFTPs_DispTbl[1][13], (CPU_CHAR *)"DALLY     ");
+             break;
     };
 
                                                                 /* Display Op-Code received.                            */
@@ -547,13 +1228,16 @@ void  TFTPs_Disp (void)
              break;
     };
 
+                                                                /* Display number of active sessions.                   */
+    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)TFTPs_SessNbrActiveGet());
+    Str_Copy(&TFTPs_DispTbl[3][13], str);
 
                                                                 /* Display number of messages received.                 */
     Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)TFTPs_RxMsgCtr);
     Str_Copy(&TFTPs_DispTbl[4][13], str);
 
                                                                 /* Display current block number.                        */
-    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)TFTPs_RxBlkNbr);
+    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)rx_blk_nbr);
     Str_Copy(&TFTPs_DispTbl[5][13], str);
 
                                                                 /* Display received message length.                     */
@@ -578,25 +1262,27 @@ void  TFTPs_Disp (void)
     Str_Copy(&TFTPs_DispTbl[ 9][13], str);
 
                                                                 /* Display current block number.                        */
-    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)TFTPs_TxBlkNbr);
+    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)tx_blk_nbr);
     Str_Copy(&TFTPs_DispTbl[10][13], str);
 
                                                                 /* Display sent message length.                         */
-    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)TFTPs_TxMsgLen);
+    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%5u", (unsigned int)tx_len);
     Str_Copy(&TFTPs_DispTbl[11][13], str);
 
-    Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%02X %02X %02X %02X %02X %02X %02X %02X %02X %02X",
-                 TFTPs_TxMsgBuf[0],
-                 TFTPs_TxMsgBuf[1],
-                 TFTPs_TxMsgBuf[2],
-                 TFTPs_TxMsgBuf[3],
-                 TFTPs_TxMsgBuf[4],
-                 TFTPs_TxMsgBuf[5],
-                 TFTPs_TxMsgBuf[6],
-                 TFTPs_TxMsgBuf[7],
-                 TFTPs_TxMsgBuf[8],
-                 TFTPs_TxMsgBuf[9]);
-    Str_Copy(&TFTPs_DispTbl[12][13], str);
+    if (p_tx_buf != DEF_NULL) {
+        Str_FmtPrint((char *)str, TFTPs_TRACE_STR_SIZE, "%02X %02X %02X %02X %02X %02X %02X %02X %02X %02X",
+                     p_tx_buf[0],
+                     p_tx_buf[1],
+                     p_tx_buf[2],
+                     p_tx_buf[3],
+                     p_tx_buf[4],
+                     p_tx_buf[5],
+                     p_tx_buf[6],
+                     p_tx_buf[7],
+                     p_tx_buf[8],
+                     p_tx_buf[9]);
+        Str_Copy(&TFTPs_DispTbl[12][13], str);
+    }
 
     switch (TFTPs_SockAddr.AddrFamily) {
 #ifdef  NET_IPv4_MODULE_EN
@@ -641,16 +1327,18 @@ void  TFTPs_Disp (void)
 *               This function is a TFTP server application interface (API) function & MAY be called by
 *               application function(s).
 *
-* Note(s)     : none.
+* Note(s)     : (1) The first 2 lines of the display are the header; trace entry 'i - 2' is thus displayed on
+*                   line 'i'.
 *********************************************************************************************************
 */
 
 #if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
 void  TFTPs_DispTrace (void)
 {
-    CPU_CHAR     str[TFTPs_TRACE_STR_SIZE];
-    CPU_CHAR    *p_str;
-    CPU_INT16U   i;
+    TFTPs_TRACE_STRUCT  *p_trace;
+    CPU_CHAR             str[TFTPs_TRACE_STR_SIZE];
+    CPU_CHAR            *p_str;
+    CPU_INT16U           i;
 
 
                                          /*           1111111111222222222233333333334444444444555555555566666666667777777777 */
@@ -661,9 +1349,11 @@ void  TFTPs_DispTrace (void)
                                          /* 01234567890123456789012345678901234567890123456789012345678901234567890123456789 */
 
     for (i = 2; i < TFTPs_TRACE_HIST_SIZE + 2; i++) {
-        p_str = &TFTPs_DispTbl[i][0];
+        p_str   = &TFTPs_DispTbl[i][0];
+        p_trace = &TFTPs_TraceTbl[i - 2u];                      /* See Note #1.                                         */
 
-        if (i == TFTPs_TraceIx) {                               /* Indicate current position of trace.                  */
+                                                                /* Indicate current position of trace.                  */
+        if ((i - 2u) == TFTPs_TraceIx) {
             Str_Copy(p_str, (CPU_CHAR *)">");
         } else {
             Str_Copy(p_str, (CPU_CHAR *)" ");
@@ -672,11 +1362,11 @@ void  TFTPs_DispTrace (void)
         Str_FmtPrint((char       *) str,
                                     TFTPs_TRACE_STR_SIZE,
                                    "%5u  %5u",
-                     (unsigned int)(TFTPs_TraceTbl[i].TS & 0xFFFF),
-                     (unsigned int) TFTPs_TraceTbl[i].Id);
+                     (unsigned int)(p_trace->TS & 0xFFFF),
+                     (unsigned int) p_trace->Id);
         Str_Cat(p_str, str);
 
-        switch (TFTPs_TraceTbl[i].State) {
+        switch (p_trace->State) {
             case TFTPs_STATE_IDLE:                              /* Idle state, expecting a new 'connection'.            */
                  Str_Cat(p_str, (CPU_CHAR *)"  IDLE ");
                  break;
@@ -692,6 +1382,11 @@ void  TFTPs_DispTrace (void)
                  break;
 
 
+            case TFTPs_STATE_DALLY:                             /* Dallying after the final ACK of a write request.     */
+                 Str_Cat(p_str, (CPU_CHAR *)"  DALLY");
+                 break;
+
+
             default:
                  Str_Cat(p_str, (CPU_CHAR *)"  ERROR");
                  break;
@@ -700,11 +1395,11 @@ void  TFTPs_DispTrace (void)
         Str_FmtPrint((char       *)str,
                                    TFTPs_TRACE_STR_SIZE,
                                    "  %5u  %5u  ",
-                     (unsigned int)TFTPs_TraceTbl[i].RxBlkNbr,
-                     (unsigned int)TFTPs_TraceTbl[i].TxBlkNbr);
+                     (unsigned int)p_trace->RxBlkNbr,
+                     (unsigned int)p_trace->TxBlkNbr);
         Str_Cat(p_str, str);
 
-        Str_Cat(p_str, TFTPs_TraceTbl[i].Str);
+        Str_Cat(p_str, p_trace->Str);
     }
 
     for (i = 0; i < TFTPs_TRACE_HIST_SIZE + 2; i++) {
@@ -745,6 +1440,7 @@ void  TFTPs_DispTrace (void)
 *********************************************************************************************************
 */
 
+#if (TFTPs_CFG_SIM_EN != DEF_ENABLED)
 static void  TFTPs_TaskInit (TFTPs_TASK_CFG  *p_task_cfg,
                              TFTPs_ERR       *p_err)
 {
@@ -797,6 +1493,7 @@ static void  TFTPs_TaskInit (TFTPs_TASK_CFG  *p_task_cfg,
 exit:
     return;
 }
+#endif
 
 
 /*
@@ -809,181 +1506,307 @@ exit:
 *
 * Return(s)   : none.
 *
-* Caller(s)   : TFTPs_Init().
+* Caller(s)   : TFTPs_Init(),
+*               TFTPs_SimRun().
 *
 * Note(s)     : (1) TID stands for "transfer identifier" as referenced by RFC #1350.
 *
-*               (2) #### In case of a timeout error, retransmission of the last sent packet should take
-*                   place.  Terminating the transmission might NOT the correct action to take according
-*                   to RFC #1350, Section 2 'Overview of the Protocol', which states that "If a packet
-*                   gets lost in the network, the intended recipient will timeout and may retransmit
-*                   his last packet [...], thus causing the sender of the lost packet to retransmit that
-*                   lost packet".
+*               (2) The socket receive timeout is set, before each receive, to the time remaining until
+*                   the next timer expiry, so that the task sleeps exactly until either a packet is
+*                   received or a timer needs to be serviced.  A receive timeout is thus NOT an error :
+*                   lost packets are retransmitted by the session's retransmission timer, as stated in
+*                   RFC #1350, Section 2 'Overview of the Protocol' : "If a packet gets lost in the
+*                   network, the intended recipient will timeout and may retransmit his last packet
+*                   [...], thus causing the sender of the lost packet to retransmit that lost packet".
+*
+*               (3) Each packet is dispatched to the session of its sender's TID, looked up in the session
+*                   hash table.  A read or write request from an unknown TID starts a new session, while
+*                   any other packet from an unknown TID is answered with an error packet, as stated in
+*                   RFC #1350, Section 4 'Initial Connection Protocol' : "If a source TID does not match,
+*                   the packet should be discarded as erroneously sent from somewhere else.  An error
+*                   packet should be sent to the source of the incorrect packet".
+*
+*               (4) State handlers never free their session; a session returned to the IDLE state has
+*                   completed its transfer & is freed here.
+*
+*               (5) Packets of a negotiated block size larger than DEF_INT_16S_MAX_VAL overflow the signed
+*                   socket return code, which is thus read as an unsigned length once an error is excluded.
+*
+*               (6) While requests are held (see 'tftp-s.c  Note #5'), the socket is read without blocking;
+*                   once it holds no more packet, a held request is served instead.
+*
+*               (7) A request is refused when its class can NOT be admitted (see 'TFTPs_ClassAdmit()
+*                   Note #1'), when its listener holds its maximum number of sessions (see 'tftp-s_type.h
+*                   LISTENER CONFIGURATION DATA TYPE  Note #2a'), or when NO session is left.
+*
+*               (8) Packets are filtered as soon as they are received (see 'tftp-s.c  Note #9').  Held
+*                   requests were filtered when received.
+*
+*               (9) The sockets of the listeners are opened by TFTPs_Init() (see 'TFTPs_SockInit()  Note #1').
+*
+*              (10) Packets are captured as soon as they are received, before they are filtered (see
+*                   'tftp-s_capture.c  Note #2').  Held requests were captured when received.
+*
+*              (11) When the network is simulated, the loop ends with the simulation run (see 'tftp-s_sim.c
+*                   Note #2'); the sessions still in progress & the held requests are then dropped, & the
+*                   file handles NOT used anymore are closed (see 'tftp-s_fs.c  TFTPs_FS_HandleClr()'), so
+*                   that the next run starts from an idle server.
+*
+*              (12) The processing of each packet dispatched to a session is measured by the packet probe
+*                   (see 'tftp-s_perf.c  Note #2').  Packets dropped or refused before their dispatch are
+*                   NOT measured.
+*
+*              (13) Once a packet is received, the sockets are read without blocking until they hold no more
+*                   packet, or until 'RxBatchNbr' packets were received (see 'tftp-s_type.h  CONFIGURATION
+*                   DATA TYPE  Note #22'), so that the packets queued meanwhile are served in a single
+*                   wakeup of the task.  The packets sent while a batch of received packets is served are
+*                   sent together once it is served (see 'tftp-s_batch.c  Note #1').
+*
+*              (14) With a single packet buffer, the packet received overwrites the last packet of the session,
+*                   which is thus dropped if still deferred by the shaper (see 'tftp-s.c  Note #13'), & counted
+*                   in the server statistics.  Timers are serviced before the socket is read, as the packets
+*                   they rebuild would otherwise overwrite the packet received before it is processed; they
+*                   are thus serviced on every pass of the loop, whether a packet is received or NOT.
 *********************************************************************************************************
 */
 
 static  void  TFTPs_Task (void  *p_data)
 {
-    TFTPs_CFG             *p_cfg;
-#ifdef  NET_IPv4_MODULE_EN
-    NET_SOCK_ADDR_IPv4    *p_addr_v4_remote;
-    NET_SOCK_ADDR_IPv4    *p_addr_v4_server;
-#endif
-#ifdef  NET_IPv6_MODULE_EN
-    NET_SOCK_ADDR_IPv6    *p_addr_v6_remote;
-    NET_SOCK_ADDR_IPv6    *p_addr_v6_server;
-#endif
-    NET_SOCK_FAMILY        sock_family;
-    CPU_INT16U            *p_opcode;
-    CPU_BOOLEAN            same_addr;
-    CPU_BOOLEAN            valid_tid;                             /* See Note #1.                                         */
-    TFTPs_ERR              tftp_err;
-    NET_ERR                net_err;
-    NET_SOCK_ADDR          addr_ip_remote;
-    NET_SOCK_ADDR          addr_ip_server;
-
+           TFTPs_CFG          *p_cfg;
+           TFTPs_SESS         *p_sess;
+           TFTPs_SESS         *p_sess_next;
+           TFTPs_SESS_KEY      sess_key;                        /* See Note #1.                                         */
+           CPU_INT08U          listen_ix;
+           CPU_INT16U          sock_ix;
+           CPU_INT32U          timeout_ms;
+           CPU_INT16S          rx_flags;
+           NET_SOCK_RTN_CODE   rx_len;
+           CPU_INT16U          rx_batch_nbr;
+           CPU_BOOLEAN         req_held;
+           CPU_BOOLEAN         admit;
+           CPU_INT08U          class_ix;
+           CPU_INT16U         *p_opcode;
+           CPU_BOOLEAN         valid_tid;
+           TFTPs_ERR           tftp_err;
+           NET_SOCK_ADDR       addr_ip_remote;
+           TFTPs_PERF_ALLOC();
+
+
+    (void)p_data;                                               /* Prevent 'variable unused' compiler warning.          */
 
     p_cfg    = TFTPs_CfgPtr;
 
-    switch (p_cfg->SockSel) {
-        case TFTPs_SOCK_SEL_IPv4:
-             sock_family = NET_SOCK_FAMILY_IP_V4;
-             break;
+#if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
+    TFTPs_TraceInit();
+#endif
 
-        case TFTPs_SOCK_SEL_IPv6:
-             sock_family = NET_SOCK_FAMILY_IP_V6;
-             break;
+    TFTPs_SockRxIx = 0u;
 
-        case TFTPs_SOCK_SEL_IPv4_IPv6:
-        default:
-            TFTPs_Trace((CPU_INT16U)0,
-                        (CPU_CHAR *)"Init error, Socket IP family");
-            while (DEF_ON) {
-                ;
+    TFTPs_TmrInit();
+    TFTPs_TmrCfg(&TFTPs_TxSchedTmr, TFTPs_TmrTxSchedHandler, DEF_NULL);
+    TFTPs_TxQ_HeadPtr = DEF_NULL;
+    TFTPs_TxQ_TailPtr = DEF_NULL;
+
+    rx_batch_nbr = 0u;
+                                                                /* ----------------- TFTP SERVER LOOP ----------------- */
+    while (DEF_ON) {
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+        if (TFTPs_SimIsDone() == DEF_YES) {                     /* End loop with simulation run (see Note #11).         */
+            break;
+        }
+#endif
+                                                                /* End full rx batch (see Note #13).                    */
+        if ((rx_batch_nbr >  0u) &&
+            (rx_batch_nbr >= p_cfg->RxBatchNbr)) {
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+            TFTPs_TxBatchClose();
+#endif
+            rx_batch_nbr = 0u;
+        }
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+        TFTPs_TmrProcess();                                     /* Service expired tmrs before rx (see Note #14).       */
+#endif
+                                                                /* Block until next tmr expiry (see Note #2).           */
+        timeout_ms = TFTPs_TmrNextGet();
+
+                                                                /* --------------- WAIT FOR INCOMING PKT -------------- */
+                                                                /* See Notes #6 & #13.                                  */
+        rx_flags = ((TFTPs_ReqQ_NbrUsed > 0u) || (rx_batch_nbr > 0u)) ? NET_SOCK_FLAG_RX_NO_BLOCK : NET_SOCK_FLAG_NONE;
+
+        rx_len   = TFTPs_Rx(timeout_ms, rx_flags, &addr_ip_remote, &sock_ix);
+        if (rx_len != NET_SOCK_BSD_ERR_RX) {                    /* Start or grow rx batch (see Note #13).               */
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+            if (rx_batch_nbr == 0u) {
+                TFTPs_TxBatchOpen();
             }
-    }
+#endif
+            rx_batch_nbr++;
 
-                                                                /* ----------------- INIT SERVER SOCK ----------------- */
-    tftp_err = TFTPs_ServerSockInit(sock_family);
-    if (tftp_err != TFTPs_ERR_NONE) {                           /* If sock err, do NOT enter server loop.               */
-        TFTPs_Trace((CPU_INT16U)0,
-                    (CPU_CHAR *)"Init error, server NOT started");
-        while (DEF_ON) {
-            ;
+        } else if (rx_batch_nbr > 0u) {                         /* End drained rx batch.                                */
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+            TFTPs_TxBatchClose();
+#endif
+            rx_batch_nbr = 0u;
         }
-    }
 
-                                                                /* Set sock to blocking until incoming req.             */
-    NetSock_CfgTimeoutRxQ_Set((NET_SOCK_ID) TFTPs_SockID,
-                              (CPU_INT32U ) NET_TMR_TIME_INFINITE,
-                              (NET_ERR   *)&net_err);
+#if (TFTPs_CFG_BUF_SINGLE_EN != DEF_ENABLED)
+        TFTPs_TmrProcess();                                     /* Service expired tmrs.                                */
+#endif
 
+        if (TFTPs_ServerEn != DEF_ENABLED) {                    /* Terminate sessions in progress if server disabled.   */
+            p_sess = TFTPs_SessActiveFirstGet();
+            while (p_sess != DEF_NULL) {
+                p_sess_next = p_sess->NextPtr;
+                TFTPs_Terminate(p_sess);
+                p_sess      = p_sess_next;
+            }
+            TFTPs_ReqQ_Clr();                                   /* Drop held reqs.                                      */
+        }
 
-                                                                /* ----------------- TFTP SERVER LOOP ----------------- */
-    while (DEF_ON) {
-        TFTPs_SockAddrLen = sizeof(addr_ip_remote);
+        TFTPs_PERF_START();                                     /* See Note #12.                                        */
+        req_held = DEF_NO;
+        if (rx_len == NET_SOCK_BSD_ERR_RX) {
+                                                                /* Serve a held req, if any (see Note #6) ...           */
+            req_held = TFTPs_ReqQ_Pop(&addr_ip_remote, &sock_ix);
+            if (req_held != DEF_YES) {                          /* ... else wait again (see Note #2).                   */
+                continue;
+            }
 
-                                                                /* --------------- WAIT FOR INCOMING PKT -------------- */
+        } else {
+            TFTPs_RxMsgLen = (CPU_INT32S)(CPU_INT16U)rx_len;    /* See Note #5.                                         */
+            TFTPs_RxMsgCtr++;                                   /* Inc nbr or rx'd pkts.                                */
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+            p_sess = TFTPs_SessActiveFirstGet();                /* Drop overwritten pkt (see Note #14).                 */
+            if ((p_sess         != DEF_NULL) &&
+                (p_sess->TxPend == DEF_YES)) {
+                TFTPs_TxQ_Remove(p_sess);
+                TFTPs_Stat.ShapeDropCtr++;
+            }
+#endif
+#if (TFTPs_CFG_CAPTURE_EN == DEF_ENABLED)
+            TFTPs_CapturePkt(             TFTPs_CAPTURE_DIR_RX, /* See Note #10.                                        */
+                                         &addr_ip_remote,
+                                          TFTPs_SockTbl[sock_ix].ListenIx,
+                                         &TFTPs_RxMsgBuf[0],
+                             (CPU_INT16U) TFTPs_RxMsgLen);
+#endif
 
-        TFTPs_RxMsgLen = NetSock_RxDataFrom((NET_SOCK_ID        ) TFTPs_SockID,
-                                            (void              *)&TFTPs_RxMsgBuf[0],
-                                            (CPU_INT16U         ) sizeof(TFTPs_RxMsgBuf),
-                                            (CPU_INT16S         ) NET_SOCK_FLAG_NONE,
-                                            (NET_SOCK_ADDR     *)&addr_ip_remote,
-                                            (NET_SOCK_ADDR_LEN *)&TFTPs_SockAddrLen,
-                                            (void              *) 0,
-                                            (CPU_INT08U         ) 0,
-                                            (CPU_INT08U        *) 0,
-                                            (NET_ERR           *)&net_err);
-
-        if (TFTPs_RxMsgLen == NET_SOCK_BSD_ERR_RX) {            /* If an error occurred, ...                            */
-            TFTPs_Terminate();                                  /* ... terminate the current file tx (see Note #2).     */
-            continue;
+#if (TFTPs_CFG_ACL_EN == DEF_ENABLED)
+            if (TFTPs_RxFilter(&addr_ip_remote) != DEF_YES) {   /* Drop pkts of denied clients (see Note #8).           */
+                continue;
+            }
+#endif
         }
 
-        TFTPs_RxMsgCtr++;                                       /* Inc nbr or rx'd pkts.                                */
+        TFTPs_SockAddr = addr_ip_remote;
+        TFTPs_RxMsgBuf[TFTPs_RxMsgLen] = 0u;                    /* NUL-terminate pkt (see 'TFTPs_Init()  Note #2').     */
 
         if (TFTPs_ServerEn != DEF_ENABLED) {
-            TFTPs_TxErr((CPU_INT16U)0,
+            TFTPs_TxErr( sock_ix,
+                        &addr_ip_remote,
+                        (CPU_INT16U)0,
                         (CPU_CHAR *)"Transaction denied, Server DISABLED");
             continue;
         }
 
 
                                                                 /* --------------- PROCESS INCOMING PKT --------------- */
-        valid_tid = DEF_YES;
-
-        switch (addr_ip_remote.AddrFamily) {
-#ifdef  NET_IPv4_MODULE_EN
-            case NET_SOCK_ADDR_FAMILY_IP_V4:
-                 p_addr_v4_remote = (NET_SOCK_ADDR_IPv4 *)&addr_ip_remote;
-                 p_addr_v4_server = (NET_SOCK_ADDR_IPv4 *)&TFTPs_SockAddr;
+        p_opcode     = (CPU_INT16U *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_OPCODE];
+        TFTPs_OpCode =  NET_UTIL_NET_TO_HOST_16(*p_opcode);
 
-                 if ((p_addr_v4_remote->Port != p_addr_v4_server->Port) ||
-                     (p_addr_v4_remote->Addr != p_addr_v4_server->Addr)) {
-                    valid_tid = DEF_NO;
-                 }
-                 (void)&same_addr;
-                 break;
+        valid_tid = TFTPs_SessKeyGet(&addr_ip_remote, &sess_key);
+        if (valid_tid != DEF_OK) {
+            continue;
+        }
+                                                                /* Find session of the sender's TID (see Note #3).      */
+        p_sess = TFTPs_SessFind(&sess_key);
+        if (p_sess == DEF_NULL) {
+            switch (TFTPs_OpCode) {
+                case TFTP_OPCODE_RD_REQ:                        /* New req, alloc a session.                            */
+                case TFTP_OPCODE_WR_REQ:
+                     if (req_held == DEF_NO) {                  /* Hold new req, if possible (see Note #6).             */
+                         req_held = TFTPs_ReqQ_Push(&sess_key, &addr_ip_remote, sock_ix);
+                         if (req_held == DEF_YES) {
+                             continue;
+                         }
+                     }
+
+                     class_ix  = TFTPs_ClassMatch(             &sess_key,
+                                                  (CPU_CHAR *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_FILENAME]);
+                     listen_ix = TFTPs_SockTbl[sock_ix].ListenIx;
+                     admit     = TFTPs_ClassAdmit(class_ix);
+                     if (admit == DEF_YES) {
+                         admit = TFTPs_ListenAdmit(listen_ix);
+                     }
+                     if (admit != DEF_YES) {                    /* See Note #7.                                         */
+                         TFTPs_Trace((CPU_INT16U)3,
+                                     (CPU_CHAR *)"Task, No session available to class");
+                         TFTPs_TxErr( sock_ix,
+                                     &addr_ip_remote,
+                                     (CPU_INT16U)0,
+                                     (CPU_CHAR *)"Transaction denied, Server BUSY");
+                         continue;
+                     }
+
+                     p_sess = TFTPs_SessAlloc(&sess_key, &addr_ip_remote);
+                     if (p_sess == DEF_NULL) {
+                         TFTPs_Trace((CPU_INT16U)2,
+                                     (CPU_CHAR *)"Task, No session available");
+                         TFTPs_TxErr( sock_ix,
+                                     &addr_ip_remote,
+                                     (CPU_INT16U)0,
+                                     (CPU_CHAR *)"Transaction denied, Server BUSY");
+                         continue;
+                     }
+                     p_sess->ClassIx  = class_ix;
+                     p_sess->SockIx   = sock_ix;
+                     p_sess->ListenIx = listen_ix;
+                     TFTPs_ClassSessAdd(class_ix);
+                     TFTPs_ListenSessAdd(listen_ix);
+                     TFTPs_TmrCfg(&p_sess->TmrRetx,  TFTPs_TmrRetxHandler,  p_sess);
+                     TFTPs_TmrCfg(&p_sess->TmrIdle,  TFTPs_TmrIdleHandler,  p_sess);
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+                     TFTPs_TmrCfg(&p_sess->TmrDally, TFTPs_TmrDallyHandler, p_sess);
 #endif
-#ifdef  NET_IPv6_MODULE_EN
-            case NET_SOCK_ADDR_FAMILY_IP_V6:
-                 p_addr_v6_remote = (NET_SOCK_ADDR_IPv6 *)&addr_ip_remote;
-                 p_addr_v6_server = (NET_SOCK_ADDR_IPv6 *)&TFTPs_SockAddr;
+                     TFTPs_TmrCfg(&p_sess->TmrPace,  TFTPs_TmrPaceHandler,  p_sess);
+                     break;
 
-                 same_addr = Mem_Cmp(&p_addr_v6_remote->Addr.Addr,
-                                     &p_addr_v6_server->Addr.Addr,
-                                      NET_IPv6_ADDR_SIZE);
 
-                 if (same_addr == DEF_NO) {
-                     valid_tid = DEF_NO;
-                 }
-                 break;
-#endif
+                case TFTP_OPCODE_ERR:                           /* Never answer an ERR pkt.                             */
+                     continue;
 
-            default:
-                valid_tid = DEF_NO;
-                break;
+
+                default:                                        /* Pkt of an unknown TID (see Note #3).                 */
+                     TFTPs_TxErr( sock_ix,
+                                 &addr_ip_remote,
+                                 (CPU_INT16U)TFTPs_ERR_CODE_BAD_PORT_NBR,
+                                 (CPU_CHAR *)"Unknown transfer ID");
+                     continue;
+            }
         }
-#if 0
-        valid_tid    = ((addr_ip_remote.Port == TFTPs_SockAddr.Port) &&
-                        (addr_ip_remote.Addr == TFTPs_SockAddr.Addr)) ? DEF_YES : DEF_NO;
-#endif
-        p_opcode     = (CPU_INT16U *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_OPCODE];
-        TFTPs_OpCode =  NET_UTIL_NET_TO_HOST_16(*p_opcode);
-        switch (TFTPs_State) {
+
+        TFTPs_SessCurPtr = p_sess;
+        switch (p_sess->State) {
             case TFTPs_STATE_IDLE:                              /* Idle state, expecting a new req.                     */
-                 TFTPs_SockAddr = addr_ip_remote;
-                 tftp_err       = TFTPs_StateIdle();
+                 tftp_err = TFTPs_StateIdle(p_sess);
                  break;
 
 
             case TFTPs_STATE_DATA_RD:                           /* Processing a rd req.                                 */
-                 if (valid_tid == DEF_YES) {
-                     tftp_err       = TFTPs_StateDataRd();
-                 } else {
-                     addr_ip_server = TFTPs_SockAddr;
-                     TFTPs_SockAddr = addr_ip_remote;
-                     TFTPs_TxErr((CPU_INT16U)0,
-                                 (CPU_CHAR *)"Transaction denied, Server BUSY");
-                     TFTPs_SockAddr = addr_ip_server;
-                     tftp_err       = TFTPs_ERR_NONE;
-                 }
+                 tftp_err = TFTPs_StateDataRd(p_sess);
                  break;
 
 
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
             case TFTPs_STATE_DATA_WR:                           /* Processing a wr req.                                 */
-                 if (valid_tid == DEF_YES) {
-                     tftp_err       = TFTPs_StateDataWr();
-                 } else {
-                     addr_ip_server = TFTPs_SockAddr;
-                     TFTPs_SockAddr = addr_ip_remote;
-                     TFTPs_TxErr((CPU_INT16U)0,
-                                 (CPU_CHAR *)"Transaction denied, Server BUSY");
-                     TFTPs_SockAddr = addr_ip_server;
-                     tftp_err       = TFTPs_ERR_NONE;
-                 }
+                 tftp_err = TFTPs_StateDataWr(p_sess);
+                 break;
+
+
+            case TFTPs_STATE_DALLY:                             /* Dallying after the final ACK of a wr req.            */
+                 tftp_err = TFTPs_StateDally(p_sess);
                  break;
+#endif
 
 
             default:
@@ -995,74 +1818,451 @@ static  void  TFTPs_Task (void  *p_data)
         if (tftp_err != TFTPs_ERR_NONE) {                       /* If err, terminate file tx.                           */
             TFTPs_Trace((CPU_INT16U)1,
                         (CPU_CHAR *)"Task, Error, session terminated");
-            TFTPs_Terminate();
+            TFTPs_Terminate(p_sess);
+
+        } else if (p_sess->State == TFTPs_STATE_IDLE) {         /* If xfer done, free session (see Note #4).            */
+            TFTPs_Terminate(p_sess);
+
+        } else if ((p_sess->State == TFTPs_STATE_DATA_RD) ||    /* Restart idle tmr on session activity.                */
+                   (p_sess->State == TFTPs_STATE_DATA_WR)) {
+            TFTPs_TmrStart(&p_sess->TmrIdle, p_cfg->RxTimeoutMax);
         }
+
+        TFTPs_PERF_STOP(TFTPs_PERF_PROBE_PKT, TFTPs_RxMsgLen);  /* See Note #12.                                        */
     }
+
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+    if (rx_batch_nbr > 0u) {                                    /* End rx batch in progress.                            */
+        TFTPs_TxBatchClose();
+    }
+#endif
+    p_sess = TFTPs_SessActiveFirstGet();                        /* Drop sessions & held reqs (see Note #11).            */
+    while (p_sess != DEF_NULL) {
+        p_sess_next = p_sess->NextPtr;
+        TFTPs_Terminate(p_sess);
+        p_sess      = p_sess_next;
+    }
+    TFTPs_ReqQ_Clr();
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    TFTPs_FS_HandleClr();
+#endif
+#endif
 }
 
 
 /*
 *********************************************************************************************************
-*                                       TFTPs_ServerSockInit()
+*                                          TFTPs_RxFilter()
 *
-* Description : Initialize the TFTP server socket.
+* Description : Check the permissions of the sender of the received packet.
 *
-* Argument(s) : family    IP family of the server socket.
+* Argument(s) : p_addr      Pointer to remote address of the received packet.
 *
-* Return(s)   : TFTP_ERR_NONE,              if server successfully initialized.
-*               TFTP_ERR_NO_SOCK,           if the socket could not be opened.
-*               TFTP_ERR_CANT_BIND,         if the socket could not be bound.
-*               TFTP_ERR_INVALID_FAMILY,    if the socket family is not supported.
-*               TFTP_ERR_INVALID_ADDR,      if the socket address configuration fails.
+* Return(s)   : DEF_YES, if the packet is allowed.
+*
+*               DEF_NO,  if the packet is rejected.
 *
 * Caller(s)   : TFTPs_Task().
 *
-* Note(s)     : none.
+* Note(s)     : (1) A read request needs the read permission & a write request the write permission.  Any
+*                   other packet is allowed from a client holding any permission, as it belongs to (or is
+*                   answered as NOT belonging to) a session of that client.
+*
+*               (2) Packets of an address family NOT supported are NOT filtered; they are dropped when
+*                   dispatched.
 *********************************************************************************************************
 */
 
-static  TFTPs_ERR  TFTPs_ServerSockInit (NET_SOCK_FAMILY  family)
+#if (TFTPs_CFG_ACL_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_RxFilter (NET_SOCK_ADDR  *p_addr)
 {
-    TFTPs_CFG          *p_cfg;
-#ifdef  NET_IPv4_MODULE_EN
-    NET_IPv4_ADDR       ipv4_addr;
-#endif
-    CPU_INT08U         *p_addr;
-    NET_IP_ADDR_LEN     addr_len;
-    NET_SOCK_RTN_CODE   bind_status;
-    NET_ERR             err;
+    TFTPs_SESS_KEY  key;
+    CPU_INT16U     *p_opcode;
+    CPU_INT16U      opcode;
+    CPU_INT08U      perm;
+    CPU_BOOLEAN     valid;
+    CPU_SR_ALLOC();
 
 
-    p_cfg = TFTPs_CfgPtr;
-
-#if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
-    TFTPs_TraceInit();
-#endif
-
-                                                                /* Open a socket to listen for incoming connections.    */
-    TFTPs_SockID = NetSock_Open((NET_SOCK_PROTOCOL_FAMILY)family,
-                                                          NET_SOCK_TYPE_DATAGRAM,
-                                                          NET_SOCK_PROTOCOL_UDP,
-                                                         &err);
+    valid = TFTPs_SessKeyGet(p_addr, &key);
+    if (valid != DEF_OK) {                                      /* See Note #2.                                         */
+        return (DEF_YES);
+    }
 
-    if (TFTPs_SockID < 0) {                                     /* Could not open a socket.                             */
-        return (TFTPs_ERR_NO_SOCK);
+    perm   = TFTPs_ACL_PermGet(&key);
+    opcode = 0u;
+    if (TFTPs_RxMsgLen >= (CPU_INT32S)sizeof(CPU_INT16U)) {
+        p_opcode = (CPU_INT16U *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_OPCODE];
+        opcode   =  NET_UTIL_NET_TO_HOST_16(*p_opcode);
     }
 
-    Mem_Set(&TFTPs_SockAddr, (CPU_CHAR)0, NET_SOCK_ADDR_SIZE);  /* Bind a local address so the client can send to us.   */
+    switch (opcode) {                                           /* See Note #1.                                         */
+        case TFTP_OPCODE_RD_REQ:
+             if (DEF_BIT_IS_SET(perm, TFTPs_ACL_PERM_RD) == DEF_YES) {
+                 return (DEF_YES);
+             }
+             CPU_CRITICAL_ENTER();
+             TFTPs_Stat.ACL_RejRdCtr++;
+             CPU_CRITICAL_EXIT();
+             break;
 
-    switch (family) {
+        case TFTP_OPCODE_WR_REQ:
+             if (DEF_BIT_IS_SET(perm, TFTPs_ACL_PERM_WR) == DEF_YES) {
+                 return (DEF_YES);
+             }
+             CPU_CRITICAL_ENTER();
+             TFTPs_Stat.ACL_RejWrCtr++;
+             CPU_CRITICAL_EXIT();
+             break;
+
+        default:
+             if (perm != TFTPs_ACL_PERM_NONE) {
+                 return (DEF_YES);
+             }
+             CPU_CRITICAL_ENTER();
+             TFTPs_Stat.ACL_RejPktCtr++;
+             CPU_CRITICAL_EXIT();
+             break;
+    }
+
+    return (DEF_NO);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             TFTPs_Rx()
+*
+* Description : Receive the next packet from the server sockets.
+*
+* Argument(s) : timeout_ms  Time to wait for a packet (in milliseconds), or TFTPs_TMR_TIME_INFINITE.
+*
+*               rx_flags    Receive flags :
+*
+*                               NET_SOCK_FLAG_NONE          Wait for a packet.
+*                               NET_SOCK_FLAG_RX_NO_BLOCK   Do NOT wait.
+*
+*               p_addr      Pointer to variable that will receive the remote address of the packet.
+*
+*               p_sock_ix   Pointer to variable that will receive the index of the server socket the packet
+*                           was received on.
+*
+* Return(s)   : Length of the packet received in 'TFTPs_RxMsgBuf', if NO error.
+*
+*               NET_SOCK_BSD_ERR_RX,        if NO packet was received in time.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) A single server socket is waited on directly, with its receive timeout.
+*
+*               (2) Several server sockets (see 'tftp-s.c  Note #11') are read in turn without blocking,
+*                   starting after the socket of the last packet received, so that a burst of packets on
+*                   one socket does NOT starve the others.  When NONE holds a packet, the task waits on
+*                   all of them at once with a socket select.
+*
+*               (3) When the network is simulated, packets are received from the simulated clients, which
+*                   reach the first server socket (see 'tftp-s_sim.c  Note #1a').
+*********************************************************************************************************
+*/
+
+static  NET_SOCK_RTN_CODE  TFTPs_Rx (CPU_INT32U      timeout_ms,
+                                     CPU_INT16S      rx_flags,
+                                     NET_SOCK_ADDR  *p_addr,
+                                     CPU_INT16U     *p_sock_ix)
+{
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+   *p_sock_ix = 0u;                                             /* See Note #3.                                         */
+
+    return (TFTPs_SimRx(             timeout_ms,
+                                     rx_flags,
+                                     p_addr,
+                                    &TFTPs_RxMsgBuf[0],
+                        (CPU_INT16U)(TFTPs_RxMsgBufSize - 1u)));
+#else
+#if (NET_SOCK_CFG_SEL_EN == DEF_ENABLED)
+    NET_SOCK_DESC       sock_desc;
+    NET_SOCK_TIMEOUT    sock_timeout;
+    NET_SOCK_TIMEOUT   *p_sock_timeout;
+    NET_SOCK_QTY        sock_nbr_max;
+    NET_SOCK_RTN_CODE   sel_nbr;
+    CPU_INT16U          sock_ix;
+    CPU_INT16U          i;
+#endif
+    NET_SOCK_RTN_CODE   rx_len;
+    NET_ERR             net_err;
+
+
+    if (TFTPs_SockNbr == 1u) {                                  /* See Note #1.                                         */
+        if (timeout_ms == TFTPs_TMR_TIME_INFINITE) {
+            timeout_ms =  NET_TMR_TIME_INFINITE;
+        }
+        NetSock_CfgTimeoutRxQ_Set((NET_SOCK_ID) TFTPs_SockTbl[0].ID,
+                                  (CPU_INT32U ) timeout_ms,
+                                  (NET_ERR   *)&net_err);
+
+       *p_sock_ix         = 0u;
+        TFTPs_SockAddrLen = sizeof(NET_SOCK_ADDR);
+        rx_len = NetSock_RxDataFrom((NET_SOCK_ID        ) TFTPs_SockTbl[0].ID,
+                                    (void              *)&TFTPs_RxMsgBuf[0],
+                                    (CPU_INT16U         )(TFTPs_RxMsgBufSize - 1u),
+                                    (CPU_INT16S         ) rx_flags,
+                                    (NET_SOCK_ADDR     *) p_addr,
+                                    (NET_SOCK_ADDR_LEN *)&TFTPs_SockAddrLen,
+                                    (void              *) 0,
+                                    (CPU_INT08U         ) 0,
+                                    (CPU_INT08U        *) 0,
+                                    (NET_ERR           *)&net_err);
+        return (rx_len);
+    }
+
+#if (NET_SOCK_CFG_SEL_EN == DEF_ENABLED)
+    while (DEF_ON) {
+        for (i = 0u; i < TFTPs_SockNbr; i++) {                  /* Rd socks in turn (see Note #2).                      */
+            sock_ix = (CPU_INT16U)((TFTPs_SockRxIx + i) % TFTPs_SockNbr);
+
+            TFTPs_SockAddrLen = sizeof(NET_SOCK_ADDR);
+            rx_len = NetSock_RxDataFrom((NET_SOCK_ID        ) TFTPs_SockTbl[sock_ix].ID,
+                                        (void              *)&TFTPs_RxMsgBuf[0],
+                                        (CPU_INT16U         )(TFTPs_RxMsgBufSize - 1u),
+                                        (CPU_INT16S         ) NET_SOCK_FLAG_RX_NO_BLOCK,
+                                        (NET_SOCK_ADDR     *) p_addr,
+                                        (NET_SOCK_ADDR_LEN *)&TFTPs_SockAddrLen,
+                                        (void              *) 0,
+                                        (CPU_INT08U         ) 0,
+                                        (CPU_INT08U        *) 0,
+                                        (NET_ERR           *)&net_err);
+            if (rx_len != NET_SOCK_BSD_ERR_RX) {
+               *p_sock_ix      =  sock_ix;
+                TFTPs_SockRxIx = (CPU_INT16U)((sock_ix + 1u) % TFTPs_SockNbr);
+                return (rx_len);
+            }
+        }
+
+        if (rx_flags == NET_SOCK_FLAG_RX_NO_BLOCK) {
+            return (NET_SOCK_BSD_ERR_RX);
+        }
+
+        NET_SOCK_DESC_INIT(&sock_desc);                         /* Wait on all socks (see Note #2).                     */
+        sock_nbr_max = 0;
+        for (sock_ix = 0u; sock_ix < TFTPs_SockNbr; sock_ix++) {
+            NET_SOCK_DESC_SET(TFTPs_SockTbl[sock_ix].ID, &sock_desc);
+            if (TFTPs_SockTbl[sock_ix].ID >= sock_nbr_max) {
+                sock_nbr_max = (NET_SOCK_QTY)(TFTPs_SockTbl[sock_ix].ID + 1);
+            }
+        }
+
+        p_sock_timeout = DEF_NULL;
+        if (timeout_ms != TFTPs_TMR_TIME_INFINITE) {
+            sock_timeout.timeout_sec = (CPU_INT32S)( timeout_ms / DEF_TIME_NBR_mS_PER_SEC);
+            sock_timeout.timeout_us  = (CPU_INT32S)((timeout_ms % DEF_TIME_NBR_mS_PER_SEC) *
+                                                    (DEF_TIME_NBR_uS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC));
+            p_sock_timeout           = &sock_timeout;
+        }
+
+        sel_nbr = NetSock_Sel( sock_nbr_max,
+                              &sock_desc,
+                               DEF_NULL,
+                               DEF_NULL,
+                               p_sock_timeout,
+                              &net_err);
+        if (sel_nbr <= 0) {                                     /* Tmr expiry or err (see 'TFTPs_Task()  Note #2').     */
+            return (NET_SOCK_BSD_ERR_RX);
+        }
+    }
+#else
+    return (NET_SOCK_BSD_ERR_RX);
+#endif
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SockInit()
+*
+* Description : Open the server sockets of all the listeners.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE                      Sockets successfully opened.
+*                               TFTPs_ERR_CFG_INVALID_SOCK_FAMILY   Invalid IP families of a listener.
+*
+*                               -------- RETURNED BY TFTPs_ServerSockInit() ----------
+*                               See TFTPs_ServerSockInit() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) One socket is opened per IP family of each listener (see 'tftp-s.c  Note #11').
+*
+*               (2) A socket that can NOT be opened or bound, e.g. on a local address NOT configured on
+*                   any interface, fails the initialization of the server : the sockets already opened are
+*                   closed, & the error is returned to the application.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SockInit (TFTPs_ERR  *p_err)
+{
+    const  TFTPs_LISTEN_CFG  *p_listen_cfg;
+           TFTPs_SOCK        *p_sock;
+           NET_SOCK_FAMILY    sock_family_tbl[2];
+           CPU_INT08U         sock_family_nbr;
+           CPU_INT08U         listen_ix;
+           CPU_INT08U         i;
+
+
+    TFTPs_SockNbr  = 0u;
+    TFTPs_SockRxIx = 0u;
+    for (listen_ix = 0u; listen_ix < TFTPs_ListenNbrGet(); listen_ix++) {
+        p_listen_cfg = TFTPs_ListenCfgGet(listen_ix);
+
+        switch (p_listen_cfg->SockSel) {                        /* See Note #1.                                         */
+            case TFTPs_SOCK_SEL_IPv4:
+                 sock_family_tbl[0] = NET_SOCK_FAMILY_IP_V4;
+                 sock_family_nbr    = 1u;
+                 break;
+
+            case TFTPs_SOCK_SEL_IPv6:
+                 sock_family_tbl[0] = NET_SOCK_FAMILY_IP_V6;
+                 sock_family_nbr    = 1u;
+                 break;
+
+            case TFTPs_SOCK_SEL_IPv4_IPv6:
+                 sock_family_tbl[0] = NET_SOCK_FAMILY_IP_V4;
+                 sock_family_tbl[1] = NET_SOCK_FAMILY_IP_V6;
+                 sock_family_nbr    = 2u;
+                 break;
+
+            default:
+                 TFTPs_SockClose();
+                *p_err = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
+                 return;
+        }
+
+        for (i = 0u; i < sock_family_nbr; i++) {
+            p_sock = &TFTPs_SockTbl[TFTPs_SockNbr];
+           *p_err  =  TFTPs_ServerSockInit( sock_family_tbl[i],
+                                            p_listen_cfg,
+                                           &p_sock->ID);
+            if (*p_err != TFTPs_ERR_NONE) {                     /* See Note #2.                                         */
+                TFTPs_SockClose();
+                return;
+            }
+            p_sock->Family   = sock_family_tbl[i];
+            p_sock->ListenIx = listen_ix;
+            TFTPs_SockNbr++;
+        }
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SockClose()
+*
+* Description : Close the server sockets opened.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init(),
+*               TFTPs_SockInit().
+*
+* Note(s)     : (1) When the network is simulated, NO socket is opened (see 'TFTPs_ServerSockInit()
+*                   Note #2').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SockClose (void)
+{
+#if (TFTPs_CFG_SIM_EN != DEF_ENABLED)                           /* See Note #1.                                         */
+    CPU_INT16U  sock_ix;
+    NET_ERR     err;
+
+
+    for (sock_ix = 0u; sock_ix < TFTPs_SockNbr; sock_ix++) {
+        NetSock_Close(TFTPs_SockTbl[sock_ix].ID, &err);
+    }
+#endif
+
+    TFTPs_SockNbr = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_ServerSockInit()
+*
+* Description : Initialize a TFTP server socket.
+*
+* Argument(s) : family          IP family of the server socket.
+*
+*               p_listen_cfg    Pointer to configuration of the listener of the server socket.
+*
+*               p_sock_id       Pointer to variable that will receive the ID of the server socket.
+*
+* Return(s)   : TFTP_ERR_NONE,              if server successfully initialized.
+*               TFTP_ERR_NO_SOCK,           if the socket could not be opened.
+*               TFTP_ERR_CANT_BIND,         if the socket could not be bound.
+*               TFTP_ERR_INVALID_FAMILY,    if the socket family is not supported.
+*               TFTP_ERR_INVALID_ADDR,      if the socket address configuration fails.
+*
+* Caller(s)   : TFTPs_SockInit().
+*
+* Note(s)     : (1) The socket is bound to the local address of its listener, in network order; an all-zero
+*                   address binds the socket to any local address of its family (see 'tftp-s_type.h
+*                   LISTENER CONFIGURATION DATA TYPE  Note #1').
+*
+*               (2) When the network is simulated, NO socket is opened (see 'tftp-s_sim.c  Note #1a').
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR  TFTPs_ServerSockInit (       NET_SOCK_FAMILY    family,
+                                         const  TFTPs_LISTEN_CFG  *p_listen_cfg,
+                                                NET_SOCK_ID       *p_sock_id)
+{
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+    (void)family;                                               /* See Note #2.                                         */
+    (void)p_listen_cfg;
+
+   *p_sock_id = (NET_SOCK_ID)0;
+
+    return (TFTPs_ERR_NONE);
+#else
+    NET_SOCK_ID         sock_id;
+    NET_IP_ADDR_LEN     addr_len;
+    NET_SOCK_RTN_CODE   bind_status;
+    NET_SOCK_ADDR       addr_server;
+    NET_ERR             err;
+
+
+                                                                /* Open a socket to listen for incoming connections.    */
+    sock_id = NetSock_Open((NET_SOCK_PROTOCOL_FAMILY)family,
+                                                     NET_SOCK_TYPE_DATAGRAM,
+                                                     NET_SOCK_PROTOCOL_UDP,
+                                                    &err);
+
+    if (sock_id < 0) {                                          /* Could not open a socket.                             */
+        return (TFTPs_ERR_NO_SOCK);
+    }
+
+    Mem_Set(&addr_server, (CPU_CHAR)0, NET_SOCK_ADDR_SIZE);     /* Bind a local address so the client can send to us.   */
+
+    switch (family) {
 #ifdef  NET_IPv4_MODULE_EN
         case NET_SOCK_FAMILY_IP_V4:
-             ipv4_addr = NET_UTIL_HOST_TO_NET_32(NET_IPv4_ADDR_NONE);
-             p_addr    = (CPU_INT08U *)&ipv4_addr;
-             addr_len  = NET_IPv4_ADDR_SIZE;
+             addr_len = NET_IPv4_ADDR_SIZE;
              break;
 #endif
 #ifdef  NET_IPv6_MODULE_EN
         case NET_SOCK_FAMILY_IP_V6:
-             p_addr    = (CPU_INT08U *)&NET_IPv6_ADDR_ANY;
-             addr_len  = NET_IPv6_ADDR_SIZE;
+             addr_len = NET_IPv6_ADDR_SIZE;
              break;
 #endif
 
@@ -1070,26 +2270,29 @@ static  TFTPs_ERR  TFTPs_ServerSockInit (NET_SOCK_FAMILY  family)
             return (TFTPs_ERR_INVALID_FAMILY);
     }
 
-    NetApp_SetSockAddr(                     &TFTPs_SockAddr,
+    NetApp_SetSockAddr(                     &addr_server,       /* See Note #1.                                         */
                        (NET_SOCK_ADDR_FAMILY)family,
-                                             p_cfg->Port,
-                                             p_addr,
+                                             p_listen_cfg->Port,
+                       (CPU_INT08U         *)&p_listen_cfg->Addr[0],
                                              addr_len,
                                             &err);
     if (err != NET_APP_ERR_NONE) {
         return (TFTPs_ERR_INVALID_ADDR);
     }
 
-    bind_status = NetSock_Bind((NET_SOCK_ID       ) TFTPs_SockID,
-                               (NET_SOCK_ADDR    *)&TFTPs_SockAddr,
+    bind_status = NetSock_Bind((NET_SOCK_ID       ) sock_id,
+                               (NET_SOCK_ADDR    *)&addr_server,
                                (NET_SOCK_ADDR_LEN ) NET_SOCK_ADDR_SIZE,
                                (NET_ERR          *)&err);
     if (bind_status != NET_SOCK_BSD_ERR_NONE) {                 /* Could not bind to the TFTPs port.                    */
-        NetSock_Close(TFTPs_SockID, &err);
+        NetSock_Close(sock_id, &err);
         return (TFTPs_ERR_CANT_BIND);
     }
 
+   *p_sock_id = sock_id;
+
     return (TFTPs_ERR_NONE);
+#endif
 }
 
 
@@ -1099,36 +2302,30 @@ static  TFTPs_ERR  TFTPs_ServerSockInit (NET_SOCK_FAMILY  family)
 *
 * Description : TFTP server idle state handler.
 *
-* Argument(s) : none.
+* Argument(s) : p_sess      Pointer to session.
 *
 * Return(s)   : Error code for this function.
 *
 * Caller(s)   : TFTPs_Task().
 *
-* Note(s)     : none.
+* Note(s)     : (1) See 'tftp-s.c  Note #12'.
 *********************************************************************************************************
 */
 
-static  TFTPs_ERR  TFTPs_StateIdle (void)
+static  TFTPs_ERR  TFTPs_StateIdle (TFTPs_SESS  *p_sess)
 {
-    TFTPs_CFG  *p_cfg;
     TFTPs_ERR   err;
-    NET_ERR     err_sock;
-
 
-    p_cfg = TFTPs_CfgPtr;
 
     TFTPs_Trace(10, (CPU_CHAR *)"Idle State");
+    err = TFTPs_ERR_INVALID_STATE;                              /* Any other opcode is unexpected in the Idle state.    */
     switch (TFTPs_OpCode) {
         case TFTP_OPCODE_RD_REQ:
-                                                                /* Open the desired file for reading.                   */
-             err = TFTPs_FileOpen(TFTPs_FILE_OPEN_RD);
+                                                                /* Open the desired file for reading & send the first  */
+                                                                /* block of data (or OACK) to client.                   */
+             err = TFTPs_ReqStart(p_sess, TFTPs_FILE_OPEN_RD);
              if (err == TFTPs_ERR_NONE) {
                  TFTPs_Trace(11, (CPU_CHAR *)"Rd Request, File Opened");
-                 TFTPs_TxBlkNbr = 0;
-                 TFTPs_State    = TFTPs_STATE_DATA_RD;
-                 err            = TFTPs_DataRd();               /* Read the first block of data from the file and send  */
-                                                                /* to client.                                           */
              }
              break;
 
@@ -1140,15 +2337,20 @@ static  TFTPs_ERR  TFTPs_StateIdle (void)
 
 
         case TFTP_OPCODE_WR_REQ:
-             TFTPs_TxBlkNbr = 0;
-                                                                /* Open the desired file for writing.                   */
-             err = TFTPs_FileOpen(TFTPs_FILE_OPEN_WR);
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+                                                                /* Open the desired file for writing & ack the client. */
+             err = TFTPs_ReqStart(p_sess, TFTPs_FILE_OPEN_WR);
              if (err == TFTPs_ERR_NONE) {
                  TFTPs_Trace(13, (CPU_CHAR *)"Wr Request, File Opened");
-                 TFTPs_State = TFTPs_STATE_DATA_WR;
-                 TFTPs_DataWrAck(TFTPs_TxBlkNbr);               /* Acknowledge the client.                              */
-                 err = TFTPs_ERR_NONE;
              }
+#else                                                           /* Refuse wr req on read-only server (see Note #1).     */
+             TFTPs_Trace(16, (CPU_CHAR *)"Wr Request, Server read-only");
+             TFTPs_TxErr( p_sess->SockIx,
+                         &p_sess->SockAddr,
+                          TFTPs_ERR_CODE_ACCESS_VIOLATION,
+                         (CPU_CHAR *)"Write NOT allowed");
+             err = TFTPs_ERR_WR_REQ;
+#endif
              break;
 
 
@@ -1164,9 +2366,6 @@ static  TFTPs_ERR  TFTPs_StateIdle (void)
 
     if (err == TFTPs_ERR_NONE) {
         TFTPs_Trace(14, (CPU_CHAR *)"No error, Timeout set");
-        NetSock_CfgTimeoutRxQ_Set((NET_SOCK_ID) TFTPs_SockID,
-                                  (CPU_INT32U ) p_cfg->RxTimeoutMax,
-                                  (NET_ERR   *)&err_sock);
     }
 
     return (err);
@@ -1179,567 +2378,2373 @@ static  TFTPs_ERR  TFTPs_StateIdle (void)
 *
 * Description : Process read action.
 *
-* Argument(s) : none.
+* Argument(s) : p_sess      Pointer to session.
 *
 * Return(s)   : Error code for this function.
 *
 * Caller(s)   : TFTPs_Task().
 *
-* Note(s)     : none.
+* Note(s)     : (1) Duplicate ACKs are ignored, as recommended by RFC #1123, Section 4.2.3.1, to avoid the
+*                   "Sorcerer's Apprentice" syndrome.  Lost packets are retransmitted by the session's
+*                   retransmission timer.
+*
+*               (2) The transfer completes when the ACK of the last DATA block is received.  The session
+*                   is then returned to the IDLE state, to be freed by TFTPs_Task().
+*
+*               (3) RFC #7440, Section 4 'Traffic Flow and Error Handling' states that the receiver of a
+*                   window acknowledges the last block received in sequence when a block is missing.  An
+*                   ACK of a block sent before the last one thus sends the window again from the block
+*                   following it.
+*
+*               (4) The round-trip time is sampled on the ACK of the last packet sent, unless that packet
+*                   was retransmitted, as the ACK could then answer any of its copies.
+*
+*               (5) See 'tftp-s.c  Note #7'.
+*
+*               (6) The handling of an ACK is measured by the ACK probe (see 'tftp-s_perf.c  Note #2').
+*
+*               (7) Once the window went back, the client MAY still acknowledge a block sent before, e.g.
+*                   when the retransmission timers of the server & client expire together.  The window is
+*                   then sent again from the block following it, or the transfer completes if it was the
+*                   last block of the file (see 'tftp-s_sess.h  SESSION DATA TYPE  Note #12').
 *********************************************************************************************************
 */
 
-static  TFTPs_ERR  TFTPs_StateDataRd (void)
+static  TFTPs_ERR  TFTPs_StateDataRd (TFTPs_SESS  *p_sess)
 {
-    NET_SOCK_RTN_CODE  tx_size;
     TFTPs_ERR          err;
+    CPU_INT16U         blk_acked;
+    CPU_INT16U         blk_sent;
+    CPU_INT32U         rtt;
+    TFTPs_PERF_ALLOC();
 
 
     err = TFTPs_ERR_NONE;
 
     switch (TFTPs_OpCode) {
         case TFTP_OPCODE_RD_REQ:                                /* NOT supposed to get RRQ pkts in the DATA Read state. */
-                                                                /* Close and re-open file.                              */
-             NetFS_FileClose(TFTPs_FileHandle);
-             err = TFTPs_FileOpen(TFTPs_FILE_OPEN_RD);
+                                                                /* Re-open file & restart xfer.                         */
+             err = TFTPs_ReqStart(p_sess, TFTPs_FILE_OPEN_RD);
              if (err == TFTPs_ERR_NONE) {
                  TFTPs_Trace(20, (CPU_CHAR *)"Data Rd, Rx RD_REQ.");
-                 TFTPs_TxBlkNbr = 0;
-                 TFTPs_State    = TFTPs_STATE_DATA_RD;
-                 err            = TFTPs_DataRd();               /* Read first block of data and tx to client.           */
-            }
-            break;
+             }
+             break;
 
 
         case TFTP_OPCODE_ACK:
-             TFTPs_GetRxBlkNbr();
-             if (TFTPs_RxBlkNbr == TFTPs_TxBlkNbr) {            /* If sent data ACK'd, ...                              */
-                 TFTPs_Trace(21, (CPU_CHAR *)"Data Rd, ACK Rx'd");
-                 err = TFTPs_DataRd();                          /* ... read next block of data and tx to client.        */
+             TFTPs_PERF_START();                                /* See Note #6.                                         */
+             TFTPs_GetRxBlkNbr(p_sess);
+             blk_acked = (CPU_INT16U)(p_sess->RxBlkNbr - p_sess->WinAckNbr);
+             blk_sent  = (CPU_INT16U)(p_sess->TxBlkNbr - p_sess->WinAckNbr);
+
+             if (p_sess->RxBlkNbr == p_sess->TxBlkNbr) {        /* If sent data ACK'd, ...                              */
+                 if ((p_sess->TxRetryCtr == 0u) &&              /* ... sample RTT (see Note #4) ...                     */
+                     (p_sess->TxPend     == DEF_NO)) {
+                     rtt = TFTPs_TmrNowGet() - p_sess->TxTS;
+                     p_sess->RTT_Avg = (p_sess->RTT_Avg == 0u) ? rtt
+                                                               : ((p_sess->RTT_Avg * 7u) + rtt) / 8u;
+                 }
+                 p_sess->TxRetryCtr  = 0u;
+                 p_sess->WinAckNbr   = p_sess->RxBlkNbr;
+                 p_sess->WinAckPos  += (CPU_INT32U)blk_acked * p_sess->BlkSize;
+                                                                /* Grow window once fully ACK'd (see Note #5).          */
+                 if ((blk_acked      >= p_sess->WinEff) &&
+                     (p_sess->WinEff <  p_sess->WinSize)) {
+                     p_sess->WinEff++;
+                 }
 
-             } else {                                           /* Else re-tx prev block.                               */
+                 if (p_sess->TxLastBlk == DEF_YES) {            /* ... & last block ACK'd, xfer done (see Note #2).     */
+                     TFTPs_Trace(22, (CPU_CHAR *)"Data Rd, last ACK Rx'd");
+                     TFTPs_XferDone(p_sess, DEF_NO);
+                     p_sess->State = TFTPs_STATE_IDLE;
+                 } else {
+                     TFTPs_Trace(21, (CPU_CHAR *)"Data Rd, ACK Rx'd");
+                     err = TFTPs_WinTx(p_sess);                 /* ... read next window of data and tx to client.       */
+                 }
 
-                 tx_size = TFTPs_Tx((CPU_INT16U  ) TFTP_OPCODE_DATA,
-                                    (CPU_INT16U  ) TFTPs_TxBlkNbr,
-                                    (CPU_INT08U *)&TFTPs_TxMsgBuf[0],
-                                    (CPU_INT16U  ) TFTPs_TxMsgLen);
+             } else if ((blk_acked >  blk_sent) &&
+                        (blk_acked <= (CPU_INT16U)(p_sess->WinTxMaxNbr - p_sess->WinAckNbr))) {
+                 TFTPs_Trace(27, (CPU_CHAR *)"Data Rd, ACK of blk sent before go-back");
+                 p_sess->TxRetryCtr  = 0u;                      /* See Note #7.                                         */
+                 p_sess->WinAckNbr   = p_sess->RxBlkNbr;
+                 p_sess->WinAckPos  += (CPU_INT32U)blk_acked * p_sess->BlkSize;
+                 if ((p_sess->RxBlkNbr     == p_sess->WinTxMaxNbr) &&
+                     (p_sess->WinTxMaxLast == DEF_YES)) {
+                     TFTPs_XferDone(p_sess, DEF_NO);
+                     p_sess->State = TFTPs_STATE_IDLE;
+                 } else {
+                     err = TFTPs_WinRewind(p_sess);
+                     if (err == TFTPs_ERR_NONE) {
+                         err = TFTPs_WinTx(p_sess);
+                     }
+                 }
 
-                 if (tx_size < 0) {
-                     TFTPs_TxErr(0, (CPU_CHAR *)"RRQ file read error");
-                     err = TFTPs_ERR_TX;
+             } else if ((p_sess->WinSize >  1u) &&              /* If window partially ACK'd, go back (see Note #3).    */
+                        (blk_acked       <  blk_sent)) {
+                 TFTPs_Trace(26, (CPU_CHAR *)"Data Rd, window partially ACK'd");
+                 TFTPs_WinEffDec(p_sess);                       /* See Note #5.                                         */
+                 if (blk_acked > 0u) {
+                     p_sess->TxRetryCtr  = 0u;
+                     p_sess->WinAckNbr   = p_sess->RxBlkNbr;
+                     p_sess->WinAckPos  += (CPU_INT32U)blk_acked * p_sess->BlkSize;
                  }
-             }
+                 err = TFTPs_WinRewind(p_sess);
+                 if (err == TFTPs_ERR_NONE) {
+                     err = TFTPs_WinTx(p_sess);
+                 }
+             }                                                  /* Else ignore duplicate ACK (see Note #1).             */
+             TFTPs_PERF_STOP(TFTPs_PERF_PROBE_ACK, TFTPs_RxMsgLen);
              break;
 
 
         case TFTP_OPCODE_WR_REQ:                                /* NOT supposed to get WRQ pkts in the DATA Read state. */
              TFTPs_Trace(23, (CPU_CHAR *)"Data Rd, Rx'd WR_REQ");
-             TFTPs_TxErr(0,  (CPU_CHAR *)"RRQ server busy, WRQ  opcode?");
+             TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"RRQ server busy, WRQ  opcode?");
              err = TFTPs_ERR_WR_REQ;
              break;
 
 
         case TFTP_OPCODE_DATA:                                  /* NOT supposed to get DATA pkts in the DATA Read state.*/
              TFTPs_Trace(24, (CPU_CHAR *)"Data Rd, Rx'd DATA");
-             TFTPs_TxErr(0,  (CPU_CHAR *)"RRQ server busy, DATA opcode?");
+             TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"RRQ server busy, DATA opcode?");
              err= TFTPs_ERR_DATA;
              break;
 
 
-        case TFTP_OPCODE_ERR:
-             TFTPs_Trace(25, (CPU_CHAR *)"Data Rd, Rx'd ERR");
-             TFTPs_TxErr(0,  (CPU_CHAR *)"RRQ server busy, ERR  opcode?");
-             err = TFTPs_ERR_ERR;
-             break;
-    }
+        case TFTP_OPCODE_ERR:
+             TFTPs_Trace(25, (CPU_CHAR *)"Data Rd, Rx'd ERR");
+             TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"RRQ server busy, ERR  opcode?");
+             err = TFTPs_ERR_ERR;
+             break;
+    }
+
+
+    return (err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_StateDataWr()
+*
+* Description : Process write action.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : Error code for this function.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  TFTPs_ERR  TFTPs_StateDataWr (TFTPs_SESS  *p_sess)
+{
+    TFTPs_ERR  err;
+
+
+    err = TFTPs_ERR_NONE;
+    switch (TFTPs_OpCode) {
+        case TFTP_OPCODE_RD_REQ:
+             TFTPs_Trace(30, (CPU_CHAR *)"Data Wr, WRQ server busy, RRQ  opcode?");
+             TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"WRQ server busy, RRQ  opcode?");
+             err = TFTPs_ERR_RD_REQ;
+             break;
+
+
+        case TFTP_OPCODE_ACK:
+             TFTPs_Trace(31, (CPU_CHAR *)"Data Wr, WRQ server busy, ACK  opcode?");
+             TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"WRQ server busy, ACK  opcode?");
+             err = TFTPs_ERR_ACK;
+             break;
+
+
+        case TFTP_OPCODE_WR_REQ:                                /* Re-open file & restart xfer.                         */
+             err = TFTPs_ReqStart(p_sess, TFTPs_FILE_OPEN_WR);
+             if (err == TFTPs_ERR_NONE) {
+                 TFTPs_Trace(32, (CPU_CHAR *)"Data Wr, Rx'd WR_REQ again");
+             }
+             break;
+
+
+        case TFTP_OPCODE_DATA:
+             TFTPs_Trace(33, (CPU_CHAR *)"Data Wr, Rx'd DATA --- OK");
+             err = TFTPs_DataWr(p_sess);                        /* Write data to file.                                  */
+             break;
+
+
+        case TFTP_OPCODE_ERR:
+             TFTPs_Trace(34, (CPU_CHAR *)"Data Wr, WRQ server busy, ERR  opcode?");
+             TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"WRQ server busy, ERR  opcode?");
+             err = TFTPs_ERR_ERR;
+             break;
+    }
+
+    return (err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_StateDally()
+*
+* Description : Process packets received while dallying after the final ACK of a write request.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : Error code for this function.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) RFC #1350, Section 6 'Normal Termination', states that "the host sending the final ACK
+*                   will wait for a while before terminating in order to retransmit the final ACK if it
+*                   has been lost".  A retransmitted final DATA packet is thus acknowledged again, while
+*                   any other packet is ignored.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  TFTPs_ERR  TFTPs_StateDally (TFTPs_SESS  *p_sess)
+{
+    if (TFTPs_OpCode == TFTP_OPCODE_DATA) {                     /* See Note #1.                                         */
+        TFTPs_GetRxBlkNbr(p_sess);
+        if (p_sess->RxBlkNbr == p_sess->TxBlkNbr) {
+            TFTPs_Trace(35, (CPU_CHAR *)"Dally, Rx'd final DATA again");
+            TFTPs_DataWrAck(p_sess, p_sess->TxBlkNbr);
+        }
+    }
+
+    return (TFTPs_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_GetRxBlkNbr()
+*
+* Description : Extract the block number from the received TFTP command packet.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_StateDataRd(),
+*               TFTPs_StateDally().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_GetRxBlkNbr (TFTPs_SESS  *p_sess)
+{
+    CPU_INT16U  *p_blk_nbr;
+
+
+    p_blk_nbr        = (CPU_INT16U *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_BLK_NBR];
+    p_sess->RxBlkNbr =  NET_UTIL_NET_TO_HOST_16(*p_blk_nbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_Terminate()
+*
+* Description : Terminate a file transfer process & free its session.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task(),
+*               TFTPs_TmrRetxHandler(),
+*               TFTPs_TmrIdleHandler(),
+*               TFTPs_TmrDallyHandler(),
+*               TFTPs_TmrPaceHandler().
+*
+* Note(s)     : (1) The session MUST NOT be accessed once terminated.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_Terminate (TFTPs_SESS  *p_sess)
+{
+    p_sess->State = TFTPs_STATE_IDLE;                           /* Abort current file transfer.                         */
+    if (p_sess->FileHandle != (void *)0) {
+        TFTPs_FS_Close(p_sess->FileHandle);                     /* Close the current opened file.                       */
+        p_sess->FileHandle = (void *)0;
+    }
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+    TFTPs_DataWrHeldFree(p_sess);                               /* Free blocks rx'd out of order.                       */
+#endif
+
+    p_sess->TxLastBlk = DEF_NO;
+                                                                /* Stop session tmrs.                                   */
+    TFTPs_TmrStop(&p_sess->TmrRetx);
+    TFTPs_TmrStop(&p_sess->TmrIdle);
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+    TFTPs_TmrStop(&p_sess->TmrDally);
+#endif
+    TFTPs_TmrStop(&p_sess->TmrPace);
+
+    TFTPs_TxQ_Remove(p_sess);                                   /* Drop pkt deferred by the shaper, if any.             */
+    TFTPs_BufFree(p_sess->TxBufPtr, p_sess->BufClass);          /* Return pkt buf to its pool.                          */
+    p_sess->TxBufPtr = DEF_NULL;
+    p_sess->BufClass = TFTPs_BUF_CLASS_NONE;
+
+    TFTPs_ClassSessRemove(p_sess->ClassIx);                     /* Release class session.                               */
+    TFTPs_ListenSessRemove(p_sess->ListenIx);                   /* Release listener session.                            */
+
+    TFTPs_SessFree(p_sess);                                     /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_XferDone()
+*
+* Description : Pass the completion record of a transfer to the application.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+*               wr          DEF_YES for a write request, DEF_NO for a read request.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_StateDataRd(),
+*               TFTPs_DataWr().
+*
+* Note(s)     : (1) See 'tftp-s.c  Note #8' & 'tftp-s_type.h  TRANSFER COMPLETION DATA TYPE'.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_XferDone (TFTPs_SESS   *p_sess,
+                              CPU_BOOLEAN   wr)
+{
+    TFTPs_XFER_REC  rec;
+
+
+    if (TFTPs_CfgPtr->XferDoneHook == DEF_NULL) {
+        return;
+    }
+
+    rec.FileNamePtr  = p_sess->FileName;
+    rec.Wr           = wr;
+    Mem_Copy(&rec.ClientAddr[0], &p_sess->Key.Addr[0], sizeof(rec.ClientAddr));
+    rec.ClientPort   = NET_UTIL_NET_TO_HOST_16(p_sess->Key.Port);
+    rec.ClientFamily = p_sess->Key.Family;
+    rec.Size         = p_sess->XferLen;
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+    rec.DigestAlg    = p_sess->Digest.Alg;
+    rec.DigestLen    = TFTPs_DigestFinish(&p_sess->Digest, &rec.Digest[0]);
+#else
+    rec.DigestAlg    = TFTPs_DIGEST_ALG_NONE;
+    rec.DigestLen    = 0u;
+#endif
+
+    TFTPs_CfgPtr->XferDoneHook(&rec);                           /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TxRetxStart()
+*
+* Description : Start the retransmission timer of the last packet sent.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_ReqStart(),
+*               TFTPs_DataWr().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TxRetxStart (TFTPs_SESS  *p_sess)
+{
+    p_sess->TxRetryCtr = 0u;
+    TFTPs_TmrStart(&p_sess->TmrRetx, TFTPs_CfgPtr->TxTimeoutMax);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_TmrRetxHandler()
+*
+* Description : Retransmit the last packet sent, when it was not answered in time.
+*
+* Argument(s) : p_arg       Pointer to session of the timer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrProcess().
+*
+* Note(s)     : (1) The session is terminated once the packet was retransmitted 'TxRetryMax' times.
+*
+*               (2) A packet still deferred by the shaper has NOT been sent yet, so its retransmission
+*                   timeout starts over without counting a retry (see also TFTPs_TxSched()).
+*
+*               (3) A window NOT acknowledged in time is sent again from its first block, as the session's
+*                   buffer only holds the last block sent (see 'tftp-s.c  Note #6').
+*
+*               (4) A write request receiving NO block in time acknowledges the last block received in
+*                   order, when NOT acknowledged yet (see 'tftp-s.c  Note #10').
+*
+*               (5) With a single packet buffer, the last packet is built again (see 'tftp-s.c  Note #13').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrRetxHandler (void  *p_arg)
+{
+    TFTPs_SESS  *p_sess;
+    TFTPs_ERR    err;
+
+
+    p_sess           = (TFTPs_SESS *)p_arg;
+    TFTPs_SessCurPtr =  p_sess;
+
+    if (p_sess->TxPend == DEF_YES) {                            /* See Note #2.                                         */
+        TFTPs_TmrStart(&p_sess->TmrRetx, TFTPs_CfgPtr->TxTimeoutMax);
+        return;
+    }
+
+    if (p_sess->TxRetryCtr >= TFTPs_CfgPtr->TxRetryMax) {       /* See Note #1.                                         */
+        TFTPs_Trace(40, (CPU_CHAR *)"Tmr, Retry max reached");
+        TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"Retransmission timeout");
+        TFTPs_Terminate(p_sess);
+        return;
+    }
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+                                                                /* See Note #5.                                         */
+    TFTPs_Trace(47, (CPU_CHAR *)"Tmr, Rebuild last pkt");
+    p_sess->TxRetryCtr++;
+    TFTPs_TmrStart(&p_sess->TmrRetx, TFTPs_CfgPtr->TxTimeoutMax);
+    err = TFTPs_TxRegen(p_sess);
+    if (err != TFTPs_ERR_NONE) {
+        TFTPs_Terminate(p_sess);
+    }
+#else
+    if ((p_sess->State    == TFTPs_STATE_DATA_RD) &&            /* See Note #3.                                         */
+        (p_sess->WinSize  >  1u)                  &&
+        (p_sess->TxBlkNbr != p_sess->WinAckNbr)) {
+        TFTPs_Trace(44, (CPU_CHAR *)"Tmr, Retransmit window");
+        p_sess->TxRetryCtr++;
+        TFTPs_WinEffDec(p_sess);
+        err = TFTPs_WinRewind(p_sess);
+        if (err == TFTPs_ERR_NONE) {
+            err = TFTPs_WinTx(p_sess);
+        }
+        if (err != TFTPs_ERR_NONE) {
+            TFTPs_Terminate(p_sess);
+        }
+        return;
+    }
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+    if ((p_sess->State    == TFTPs_STATE_DATA_WR) &&            /* See Note #4.                                         */
+        (p_sess->TxBlkNbr != p_sess->WinAckNbr)) {
+        TFTPs_Trace(46, (CPU_CHAR *)"Tmr, Acknowledge partial window");
+        p_sess->TxRetryCtr++;
+        TFTPs_TmrStart(&p_sess->TmrRetx, TFTPs_CfgPtr->TxTimeoutMax);
+        TFTPs_DataWrAck(p_sess, p_sess->TxBlkNbr);
+        return;
+    }
+#endif
+
+    TFTPs_Trace(41, (CPU_CHAR *)"Tmr, Retransmit last pkt");
+    p_sess->TxRetryCtr++;
+    TFTPs_TxMsgCtr++;
+    TFTPs_TmrStart(&p_sess->TmrRetx, TFTPs_CfgPtr->TxTimeoutMax);
+    TFTPs_TxSess(p_sess);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_TmrIdleHandler()
+*
+* Description : Reclaim the session when nothing was received from the client for too long.
+*
+* Argument(s) : p_arg       Pointer to session of the timer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrProcess().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrIdleHandler (void  *p_arg)
+{
+    TFTPs_SESS  *p_sess;
+
+
+    p_sess           = (TFTPs_SESS *)p_arg;
+    TFTPs_SessCurPtr =  p_sess;
+
+    TFTPs_Trace(42, (CPU_CHAR *)"Tmr, Session idle, terminated");
+    TFTPs_Terminate(p_sess);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_TmrDallyHandler()
+*
+* Description : End the dally period following the final ACK of a write request.
+*
+* Argument(s) : p_arg       Pointer to session of the timer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrProcess().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  void  TFTPs_TmrDallyHandler (void  *p_arg)
+{
+    TFTPs_SESS  *p_sess;
+
+
+    p_sess           = (TFTPs_SESS *)p_arg;
+    TFTPs_SessCurPtr =  p_sess;
+
+    TFTPs_Trace(43, (CPU_CHAR *)"Tmr, Dally done");
+    TFTPs_Terminate(p_sess);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_TmrTxSchedHandler()
+*
+* Description : Send the queued packets once the shaper's token buckets are refilled.
+*
+* Argument(s) : p_arg       Pointer to timer argument (unused).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrProcess().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrTxSchedHandler (void  *p_arg)
+{
+    (void)&p_arg;
+
+    TFTPs_TxSched();
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_TmrPaceHandler()
+*
+* Description : Send the next block of a paced window.
+*
+* Argument(s) : p_arg       Pointer to session of the timer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrProcess().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrPaceHandler (void  *p_arg)
+{
+    TFTPs_SESS  *p_sess;
+    TFTPs_ERR    err;
+
+
+    p_sess           = (TFTPs_SESS *)p_arg;
+    TFTPs_SessCurPtr =  p_sess;
+
+    err = TFTPs_WinTx(p_sess);
+    if (err != TFTPs_ERR_NONE) {
+        TFTPs_Trace(45, (CPU_CHAR *)"Tmr, Paced tx error");
+        TFTPs_Terminate(p_sess);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_ReqStart()
+*
+* Description : (1) Start the transfer requested by a read or write request :
+*
+*                   (a) Open the requested file
+*                   (b) Parse the options of the request
+*                   (c) Get a packet buffer for the negotiated block size
+*                   (d) Acknowledge the options or send the first DATA/ACK packet
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+*               rw          File access :
+*
+*                               TFTPs_FILE_OPEN_RD      Open for reading
+*                               TFTPs_FILE_OPEN_WR      Open for writing
+*
+* Return(s)   : TFTPs_ERR_NONE,           if NO error.
+*
+*               TFTPs_ERR_FILE_NOT_FOUND, if file not found.
+*
+*               TFTPs_ERR_BUF_UNAVAIL,    if no packet buffer is available.
+*
+*               TFTPs_ERR_FILE_RD,        if file read error.
+*
+* Caller(s)   : TFTPs_StateIdle(),
+*               TFTPs_StateDataRd(),
+*               TFTPs_StateDataWr().
+*
+* Note(s)     : (2) A request received again restarts the transfer, e.g. when the first answer to the
+*                   request was lost.  The buffer held by the session is returned to its pool first, so
+*                   that the options of the request are negotiated again.
+*
+*               (3) Requests without a block size option use the RFC #1350 block size, which can NOT be
+*                   reduced.  Requests with a block size option MAY fall back to a smaller block size when
+*                   the buffers of the requested size are all in use (see 'TFTPs_BufGet()  Note #1').
+*
+*               (4) RFC #2347, Section 'Packet Formats' states that "if the server supports option
+*                   negotiation and it recognizes one or more of the options specified in the request
+*                   packet, the server may respond with an Options Acknowledgment (OACK)".  The client
+*                   answers a read request's OACK with the ACK of block 0 & a write request's OACK with
+*                   DATA block 1, so the session's block number starts at 0 in both cases.
+*
+*               (5) The size of a file read is taken when the request is received, to order the transmit
+*                   queue (see 'tftp-s_sess.h  SESSION DATA TYPE  Note #3'), from the file metadata index
+*                   when the file is indexed (see 'tftp-s_fs.c  Note #5').  A file of unknown size is
+*                   handled as the largest possible file.
+*
+*               (6) The window size is negotiated for read requests, & for write requests when
+*                   TFTPs_CFG_WR_WIN_EN is enabled (see 'tftp-s.c  Notes #6 & #10').  It is granted up to
+*                   the maximum window size of the session's listener (see 'tftp-s_type.h  LISTENER
+*                   CONFIGURATION DATA TYPE  Note #2c').
+*
+*               (7) RFC #2349 states that, for a read request, "the server [...] will respond with the size
+*                   of the file", i.e. the decoded size of a compressed file (see 'tftp-s_fs.c  Note #2').
+*                   The option is NOT acknowledged for a file of unknown size.  For a write request, the
+*                   size sent by the client is acknowledged as is.
+*
+*               (8) With a single packet buffer, the OACK is built again from the options acknowledged when
+*                   retransmitted (see 'TFTPs_TxRegen()  Note #1a').
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR  TFTPs_ReqStart (TFTPs_SESS   *p_sess,
+                                   CPU_BOOLEAN   rw)
+{
+    TFTPs_OPT    opt;
+    CPU_BOOLEAN  ok;
+    CPU_BOOLEAN  fallback_en;
+    CPU_BOOLEAN  win_en;
+    CPU_INT16U   blk_size_req;
+    CPU_INT16U   win_size_max;
+    TFTPs_ERR    err;
+
+
+    if (p_sess->FileHandle != (void *)0) {                      /* Close file of previous req (see Note #2).            */
+        TFTPs_FS_Close(p_sess->FileHandle);
+        p_sess->FileHandle = (void *)0;
+    }
+    if (p_sess->TxBufPtr != DEF_NULL) {
+        TFTPs_TxQ_Remove(p_sess);
+        TFTPs_BufFree(p_sess->TxBufPtr, p_sess->BufClass);
+        p_sess->TxBufPtr = DEF_NULL;
+        p_sess->BufClass = TFTPs_BUF_CLASS_NONE;
+    }
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+    TFTPs_DataWrHeldFree(p_sess);
+#endif
+    TFTPs_TmrStop(&p_sess->TmrRetx);
+    TFTPs_TmrStop(&p_sess->TmrPace);
+
+                                                                /* ------------------ OPEN REQ'D FILE ----------------- */
+    err = TFTPs_FileOpen(p_sess, rw);
+    if (err != TFTPs_ERR_NONE) {
+        return (err);
+    }
+
+    p_sess->XferRem = 0u;                                       /* Get size of xfer (see Note #5).                      */
+    if (rw == TFTPs_FILE_OPEN_RD) {
+        ok = TFTPs_FS_SizeGet(p_sess->FileHandle, &p_sess->XferRem);
+        if (ok != DEF_OK) {
+            p_sess->XferRem = DEF_INT_32U_MAX_VAL;
+        }
+    }
+
+    p_sess->XferLen = 0u;                                       /* Start digest of xfer (see 'tftp-s.c  Note #8').      */
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+    if ((rw                      == TFTPs_FILE_OPEN_WR) ||
+        (TFTPs_CfgPtr->DigestRdEn == DEF_ENABLED)) {
+        TFTPs_DigestStart(&p_sess->Digest, TFTPs_CfgPtr->DigestAlg);
+    } else {
+        TFTPs_DigestStart(&p_sess->Digest, TFTPs_DIGEST_ALG_NONE);
+    }
+#endif
+
+                                                                /* ------------- PARSE OPT & GET PKT BUF -------------- */
+    TFTPs_OptParse(&opt);
+
+    if (opt.BlkSize != 0u) {                                    /* See Note #3.                                         */
+        blk_size_req = (CPU_INT16U)opt.BlkSize;
+        fallback_en  =  DEF_YES;
+    } else {
+        blk_size_req =  TFTPs_BUF_BLK_SIZE_DFLT;
+        fallback_en  =  DEF_NO;
+    }
+
+    p_sess->TxBufPtr = TFTPs_BufGet( blk_size_req,
+                                     fallback_en,
+                                    &p_sess->BlkSize,
+                                    &p_sess->BufClass);
+    if (p_sess->TxBufPtr == DEF_NULL) {
+        TFTPs_Trace(15, (CPU_CHAR *)"Req, No buffer available");
+        TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"Transaction denied, Server BUSY");
+        return (TFTPs_ERR_BUF_UNAVAIL);
+    }
+    if (opt.BlkSize != 0u) {
+        opt.BlkSize = p_sess->BlkSize;                          /* Ack granted blk size.                                */
+    }
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)                        /* Negotiate window size (see Note #6).                 */
+    win_en = DEF_YES;
+#else
+    win_en = (rw == TFTPs_FILE_OPEN_RD) ? DEF_YES : DEF_NO;
+#endif
+    win_size_max    = TFTPs_ListenWinSizeMaxGet(p_sess->ListenIx);
+    p_sess->WinSize = 1u;
+    if ((opt.WinSize  != 0u)      &&
+        (win_en       == DEF_YES) &&
+        (win_size_max >  1u)) {
+        opt.WinSize     = DEF_MIN(opt.WinSize, win_size_max);
+        p_sess->WinSize = (CPU_INT16U)opt.WinSize;
+    } else {
+        opt.WinSize     = 0u;
+    }
+    p_sess->WinEff = DEF_MIN(p_sess->WinSize, TFTPs_WIN_EFF_INIT);
+    p_sess->PaceEn = TFTPs_CfgPtr->PaceEn;
+
+    if ((opt.TSizeReq == DEF_YES) &&                            /* Ack xfer size (see Note #7).                         */
+        (rw           == TFTPs_FILE_OPEN_RD)) {
+        opt.TSize    =  p_sess->XferRem;
+        opt.TSizeReq = (p_sess->XferRem != DEF_INT_32U_MAX_VAL) ? DEF_YES : DEF_NO;
+    }
+
+                                                                /* --------------------- START XFER ------------------- */
+    p_sess->TxBlkNbr     = 0u;
+    p_sess->TxLastBlk    = DEF_NO;
+    p_sess->TxRetryCtr   = 0u;
+    p_sess->WinAckNbr    = 0u;
+    p_sess->WinAckPos    = 0u;
+    p_sess->WinTxMaxNbr  = 0u;
+    p_sess->WinTxMaxLast = DEF_NO;
+    p_sess->State      = (rw == TFTPs_FILE_OPEN_RD) ? TFTPs_STATE_DATA_RD
+                                                    : TFTPs_STATE_DATA_WR;
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    TFTPs_OAckOpt = opt;                                        /* Keep opt to rebuild OACK (see Note #8).              */
+#endif
+
+    if ((opt.BlkSize  != 0u) ||                                 /* Ack opt (see Note #4).                               */
+        (opt.WinSize  != 0u) ||
+        (opt.TSizeReq == DEF_YES)) {
+        TFTPs_TxRetxStart(p_sess);
+        TFTPs_TxOAck(p_sess, &opt);
+        err = TFTPs_ERR_NONE;
+
+    } else if (rw == TFTPs_FILE_OPEN_RD) {                      /* Read the first block of data from the file and send  */
+        err = TFTPs_WinTx(p_sess);                              /* to client.                                           */
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+    } else {
+        TFTPs_DataWrAck(p_sess, p_sess->TxBlkNbr);              /* Acknowledge the client.                              */
+        TFTPs_TxRetxStart(p_sess);
+        err = TFTPs_ERR_NONE;
+#endif
+    }
+
+    return (err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_OptParse()
+*
+* Description : Parse the options of the received read or write request.
+*
+* Argument(s) : p_opt       Pointer to variable that will receive the requested options.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_ReqStart().
+*
+* Note(s)     : (1) RFC #2347, Section 'Packet Formats' appends the options to the request as pairs of
+*                   NUL-terminated strings, following the file name & the mode :
+*
+*                       | opc | filename | 0 | mode | 0 | opt1 | 0 | value1 | 0 | ... | optN | 0 | valueN | 0 |
+*
+*                   Option names are case insensitive; unknown options are ignored.
+*
+*               (2) The received packet is NUL-terminated (see 'TFTPs_Init()  Note #2'), so that a
+*                   truncated request can NOT be parsed beyond its end.
+*
+*               (3) RFC #2348 states that the block size "MUST be between 8 and 65464 octets, inclusive";
+*                   a request for a larger block size is acknowledged with the largest one.
+*
+*               (4) RFC #7440 states that the window size "MUST be between 1 and 65535 blocks, inclusive".
+*
+*               (5) RFC #2349 states that the transfer size is 0 in a read request, & the size of the file in
+*                   a write request.
+*
+*               (6) The parsing is measured by the request parsing probe (see 'tftp-s_perf.c  Note #2').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_OptParse (TFTPs_OPT  *p_opt)
+{
+    CPU_CHAR    *p_str;
+    CPU_CHAR    *p_end;
+    CPU_CHAR    *p_val;
+    CPU_INT32U   val;
+    CPU_INT08U   field_ix;
+    TFTPs_PERF_ALLOC();
+
+
+    TFTPs_PERF_START();                                         /* See Note #6.                                         */
+    p_opt->BlkSize  = 0u;
+    p_opt->WinSize  = 0u;
+    p_opt->TSizeReq = DEF_NO;
+    p_opt->TSize    = 0u;
+
+    p_str = (CPU_CHAR *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_OPT];
+    p_end = (CPU_CHAR *)&TFTPs_RxMsgBuf[TFTPs_RxMsgLen];        /* See Note #2.                                         */
+
+    field_ix = 0u;                                              /* Skip over file name & mode.                          */
+    while ((field_ix <  2u) &&
+           (p_str    < p_end)) {
+        p_str += Str_Len(p_str) + 1u;
+        field_ix++;
+    }
+
+    while (p_str < p_end) {                                     /* Parse opt pairs (see Note #1).                       */
+        p_val = p_str + Str_Len(p_str) + 1u;
+        if (p_val >= p_end) {                                   /* Opt without val.                                     */
+            break;
+        }
+
+        if (Str_CmpIgnoreCase(p_str, (CPU_CHAR *)TFTPs_OPT_NAME_BLK_SIZE) == 0) {
+            val = Str_ParseNbr_Int32U(p_val, DEF_NULL, 10u);
+            if (val >= TFTPs_BUF_BLK_SIZE_MIN) {                /* See Note #3.                                         */
+                if (val > TFTPs_BUF_BLK_SIZE_MAX) {
+                    val = TFTPs_BUF_BLK_SIZE_MAX;
+                }
+                p_opt->BlkSize = val;
+            }
+
+        } else if (Str_CmpIgnoreCase(p_str, (CPU_CHAR *)TFTPs_OPT_NAME_WIN_SIZE) == 0) {
+            val = Str_ParseNbr_Int32U(p_val, DEF_NULL, 10u);
+            if ((val >= 1u) &&                                  /* See Note #4.                                         */
+                (val <= DEF_INT_16U_MAX_VAL)) {
+                p_opt->WinSize = val;
+            }
+
+        } else if (Str_CmpIgnoreCase(p_str, (CPU_CHAR *)TFTPs_OPT_NAME_TSIZE) == 0) {
+            p_opt->TSizeReq = DEF_YES;                          /* See Note #5.                                         */
+            p_opt->TSize    = Str_ParseNbr_Int32U(p_val, DEF_NULL, 10u);
+        }
+
+        p_str = p_val + Str_Len(p_val) + 1u;
+    }
+
+    TFTPs_PERF_STOP(TFTPs_PERF_PROBE_REQ_PARSE, TFTPs_RxMsgLen);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_FileOpen()
+*
+* Description : Get filename and file mode from the TFTP packet and attempt to open that file.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+*               rw          File access :
+*
+*                               TFTPs_FILE_OPEN_RD      Open for reading
+*                               TFTPs_FILE_OPEN_WR      Open for writing
+*
+* Return(s)   : TFTP_ERR_NONE,           if NO error.
+*
+*               TFTP_ERR_FILE_NOT_FOUND, if file not found.
+*
+* Caller(s)   : TFTPs_ReqStart().
+*
+* Note(s)     : (1) The file mode & the options of the request are parsed by TFTPs_OptParse().
+*
+*               (2) The requested file name is rewritten by the rule table in use (see 'tftp-s_rewrite.c'),
+*                   & the file opened & recorded under its rewritten name.  A name rewritten beyond the
+*                   maximum file name length is NOT found.
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR  TFTPs_FileOpen (TFTPs_SESS   *p_sess,
+                                   CPU_BOOLEAN   rw)
+{
+    CPU_CHAR  *p_filename;
+
+                                                                /* ---- GET FILENAME ---------------------------------- */
+    p_filename = (CPU_CHAR *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_FILENAME];
+#if (TFTPs_CFG_REWRITE_EN == DEF_ENABLED)
+    p_filename = TFTPs_RewriteApply(&p_sess->Key, p_filename);  /* See Note #2.                                         */
+#endif
+                                                                /* ---- OPEN THE FILE --------------------------------- */
+    p_sess->FileHandle = DEF_NULL;
+    if (p_filename != DEF_NULL) {
+        p_sess->FileHandle = TFTPs_FileOpenMode(p_filename, rw);
+    }
+
+    if (p_sess->FileHandle == (void *)0) {
+        TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"file not found");
+        return (TFTPs_ERR_FILE_NOT_FOUND);
+    }
+                                                                /* Keep name for completion record.                     */
+    (void)Str_Copy_N(p_sess->FileName, p_filename, TFTPs_FS_NAME_LEN_MAX);
+    p_sess->FileName[TFTPs_FS_NAME_LEN_MAX] = ASCII_CHAR_NULL;
+
+    return (TFTPs_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FileOpenMode()
+*
+* Description : Open the specified file, through the file storage layer (see 'tftp-s_fs.c').
+*
+* Argument(s) : p_filename  File name to open.
+*
+*               rw          File access :
+*
+*                               TFTPs_FILE_OPEN_RD      Open for reading
+*                               TFTPs_FILE_OPEN_WR      Open for writing
+*
+* Return(s)   : Pointer to a file handle for the opened file, if NO error.
+*
+*               Pointer to NULL,                              otherwise.
+*
+* Caller(s)   : TFTPs_FileOpen().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  TFTPs_FS_FILE  *TFTPs_FileOpenMode (CPU_CHAR     *p_filename,
+                                           CPU_BOOLEAN   rw)
+{
+    TFTPs_FS_FILE  *p_file;
+
+
+    p_file = (void *)0;
+    switch (rw) {
+        case TFTPs_FILE_OPEN_RD:
+             p_file = TFTPs_FS_Open(p_filename, TFTPs_FS_ACCESS_RD);
+             break;
+
+        case TFTPs_FILE_OPEN_WR:
+             p_file = TFTPs_FS_Open(p_filename, TFTPs_FS_ACCESS_WR);
+             break;
+
+
+        default:
+             break;
+    }
+
+    return (p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_DataRd()
+*
+* Description : Read data from the opened file and send it to the client.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : TFTP_ERR_NONE,    if NO error.
+*
+*               TFTP_ERR_FILE_RD, if file read error.
+*
+* Caller(s)   : TFTPs_WinTx().
+*
+* Note(s)     : (1) The file is closed once its last block is read, but the session is kept until the last
+*                   block is acknowledged so that it can be retransmitted.  The file of a windowed transfer
+*                   is kept open, as a window may be read again (see 'tftp-s.c  Note #6'), as is the file of
+*                   any transfer with a single packet buffer (see 'tftp-s.c  Note #13').
+*
+*               (2) The retry counter is only cleared when the client acknowledges new data, so that the
+*                   blocks of a window sent again count as a retry (see TFTPs_StateDataRd()).
+*
+*               (3) The file position of the block is found from the last block acknowledged.  Only the data
+*                   beyond 'XferLen' is new, the rest was read before the window went back & is already
+*                   digested (see 'tftp-s.c  Note #8').
+*
+*               (4) See 'tftp-s_sess.h  SESSION DATA TYPE  Note #12'.
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR  TFTPs_DataRd (TFTPs_SESS  *p_sess)
+{
+    CPU_BOOLEAN  ok;
+    CPU_INT32U   pos;
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+    CPU_INT32U   new_off;
+#endif
+
+
+                                                                /* Read data from file.                                 */
+    ok = TFTPs_FS_Rd(               p_sess->FileHandle,
+                     (void       *)&p_sess->TxBufPtr[TFTP_PKT_OFFSET_DATA],
+                     (CPU_SIZE_T  ) p_sess->BlkSize,
+                     (CPU_SIZE_T *)&p_sess->TxMsgLen);
+
+    if (p_sess->TxMsgLen < p_sess->BlkSize) {                   /* Close file when all data read (see Note #1).         */
+#if (TFTPs_CFG_BUF_SINGLE_EN != DEF_ENABLED)
+        if (p_sess->WinSize <= 1u) {
+            TFTPs_FS_Close(p_sess->FileHandle);
+            p_sess->FileHandle = (void *)0;
+        }
+#endif
+        p_sess->TxLastBlk  = DEF_YES;
+    }
+
+    if (ok == DEF_FAIL) {                                       /* If read err, ...                                     */
+                                                                /* ... tx  err pkt.                                     */
+        TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"RRQ file read error");
+        return (TFTPs_ERR_FILE_RD);
+    }
+
+    if (p_sess->XferRem > p_sess->TxMsgLen) {                   /* Update remaining xfer size.                          */
+        p_sess->XferRem -= (CPU_INT32U)p_sess->TxMsgLen;
+    } else {
+        p_sess->XferRem  = 0u;
+    }
+                                                                /* Digest new data (see Note #3).                       */
+    pos = p_sess->WinAckPos + (CPU_INT32U)(CPU_INT16U)(p_sess->TxBlkNbr - p_sess->WinAckNbr) * p_sess->BlkSize;
+    if (pos + p_sess->TxMsgLen > p_sess->XferLen) {
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+        new_off = p_sess->XferLen - pos;
+        TFTPs_DigestUpdate(&p_sess->Digest,
+                           &p_sess->TxBufPtr[TFTP_PKT_OFFSET_DATA + new_off],
+                            p_sess->TxMsgLen - new_off);
+#endif
+        p_sess->XferLen = pos + (CPU_INT32U)p_sess->TxMsgLen;
+    }
+
+    TFTPs_TxMsgCtr++;
+    p_sess->TxBlkNbr++;
+    if ((CPU_INT16S)(p_sess->TxBlkNbr - p_sess->WinTxMaxNbr) > 0) {
+        p_sess->WinTxMaxNbr  = p_sess->TxBlkNbr;                /* Track last blk sent (see Note #4).                   */
+        p_sess->WinTxMaxLast = p_sess->TxLastBlk;
+    }
+
+    p_sess->TxMsgLen += TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR;
+
+    TFTPs_TxHdrSet(p_sess->TxBufPtr, TFTP_OPCODE_DATA, p_sess->TxBlkNbr);
+                                                                /* Restart retx tmr (see Note #2).                      */
+    TFTPs_TmrStart(&p_sess->TmrRetx, TFTPs_CfgPtr->TxTimeoutMax);
+    TFTPs_TxSess(p_sess);
+
+    return (TFTPs_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_WinTx()
+*
+* Description : Send the blocks of the current window NOT sent yet.
+*
+*               The window holds the negotiated number of blocks of the session (see 'tftp-s.c  Note #7').
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : TFTPs_ERR_NONE,    if NO error.
+*
+*               TFTPs_ERR_FILE_RD, if file read error.
+*
+* Caller(s)   : TFTPs_ReqStart(),
+*               TFTPs_StateDataRd(),
+*               TFTPs_TmrRetxHandler(),
+*               TFTPs_TmrPaceHandler(),
+*               TFTPs_TxRegen().
+*
+* Note(s)     : (1) Blocks are read in turn into the session's buffer, which can NOT be reused while it holds
+*                   a packet deferred by the shaper.  The next block is then sent by the pacing timer.
+*
+*               (2) With pacing, or while the effective window is smaller than the window, a single block
+*                   is sent per call & the next one is sent by the pacing timer once the pacing gap has
+*                   elapsed (see 'TFTPs_WinPaceGapGet()  Note #3').
+*
+*               (3) The blocks of the window are sent together, in a single batch (see 'tftp-s_batch.c
+*                   Note #1').
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR  TFTPs_WinTx (TFTPs_SESS  *p_sess)
+{
+    CPU_INT16U  blk_sent;
+    CPU_INT32U  gap_ms;
+    TFTPs_ERR   err;
+
+
+    TFTPs_TmrStop(&p_sess->TmrPace);
+
+    gap_ms   =  TFTPs_WinPaceGapGet(p_sess);
+    blk_sent = (CPU_INT16U)(p_sess->TxBlkNbr - p_sess->WinAckNbr);
+    err      =  TFTPs_ERR_NONE;
+
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+    TFTPs_TxBatchOpen();                                        /* See Note #3.                                         */
+#endif
+    while ((blk_sent          <  p_sess->WinSize) &&
+           (p_sess->TxLastBlk == DEF_NO)) {
+        if (p_sess->TxPend == DEF_YES) {                        /* See Note #1.                                         */
+            TFTPs_TmrStart(&p_sess->TmrPace, gap_ms);
+            break;
+        }
+
+        err = TFTPs_DataRd(p_sess);
+        if (err != TFTPs_ERR_NONE) {
+            break;
+        }
+        blk_sent++;
+
+        if ((gap_ms            >  0u)             &&            /* See Note #2.                                         */
+            (blk_sent          <  p_sess->WinSize) &&
+            (p_sess->TxLastBlk == DEF_NO)) {
+            TFTPs_TmrStart(&p_sess->TmrPace, gap_ms);
+            break;
+        }
+    }
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+    TFTPs_TxBatchClose();
+#endif
+
+    return (err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_WinRewind()
+*
+* Description : Go back to the first block of the window NOT acknowledged by the client.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : TFTPs_ERR_NONE,    if NO error.
+*
+*               TFTPs_ERR_FILE_RD, if the file position could NOT be set.
+*
+* Caller(s)   : TFTPs_StateDataRd(),
+*               TFTPs_TmrRetxHandler(),
+*               TFTPs_TxRegen().
+*
+* Note(s)     : (1) The data sent again is added back to the remaining transfer size of the session (see
+*                   'tftp-s_sess.h  SESSION DATA TYPE  Note #3').  The data acknowledged beyond the file
+*                   position, once the window went back (see 'TFTPs_StateDataRd()  Note #7'), is removed
+*                   from it.
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR  TFTPs_WinRewind (TFTPs_SESS  *p_sess)
+{
+    CPU_INT32U   pos;
+    CPU_BOOLEAN  ok;
+
+
+    ok = TFTPs_FS_PosGet(p_sess->FileHandle, &pos);
+    if ((ok              == DEF_OK) &&                          /* See Note #1.                                         */
+        (p_sess->XferRem != DEF_INT_32U_MAX_VAL)) {
+        if (pos > p_sess->WinAckPos) {
+            p_sess->XferRem += pos - p_sess->WinAckPos;
+        } else {
+            p_sess->XferRem -= DEF_MIN(p_sess->XferRem, p_sess->WinAckPos - pos);
+        }
+    }
+
+    ok = TFTPs_FS_PosSet(p_sess->FileHandle, p_sess->WinAckPos);
+    if (ok != DEF_OK) {
+        TFTPs_TxErr(p_sess->SockIx, &p_sess->SockAddr, 0, (CPU_CHAR *)"RRQ file read error");
+        return (TFTPs_ERR_FILE_RD);
+    }
+
+    p_sess->TxBlkNbr  = p_sess->WinAckNbr;
+    p_sess->TxLastBlk = DEF_NO;
+
+    return (TFTPs_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_WinPaceGapGet()
+*
+* Description : Get the time between two blocks of a paced window, or of a window larger than the effective
+*               window size.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : Pacing gap, in milliseconds, if the blocks are spread.
+*
+*               0,                           otherwise.
+*
+* Caller(s)   : TFTPs_WinTx().
+*
+* Note(s)     : (1) The blocks of a window are spread over the smoothed round-trip time of the session, but
+*                   are never closer than 'PaceGapMin'.  Before the first round-trip time sample, blocks are
+*                   thus 'PaceGapMin' apart.
+*
+*               (2) The pacing timer can NOT wait less than one tick of the timer wheel (see 'tftp-s_tmr.c').
+*                   A shorter gap would be rounded up to a full tick, & the window sent slower than without
+*                   pacing; the blocks are then sent back to back.
+*
+*               (3) While the effective window is smaller than the negotiated window, the blocks are 'WinEff'
+*                   per round-trip time apart, even without pacing (see 'tftp-s.c  Note #7').  Before the first
+*                   round-trip time sample, the window is sent back to back.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_WinPaceGapGet (TFTPs_SESS  *p_sess)
+{
+    CPU_INT32U  gap_ms;
+
+
+    if (p_sess->WinSize <= 1u) {
+        return (0u);
+    }
+
+    if ((p_sess->PaceEn != DEF_ENABLED) &&                      /* See Note #3.                                         */
+        (p_sess->WinEff >= p_sess->WinSize)) {
+        return (0u);
+    }
+
+    gap_ms = p_sess->RTT_Avg / p_sess->WinEff;                  /* See Notes #1 & #3.                                   */
+    if (p_sess->PaceEn == DEF_ENABLED) {
+        gap_ms = DEF_MAX(gap_ms, TFTPs_CfgPtr->PaceGapMin);
+    }
+    if (gap_ms < TFTPs_CFG_TMR_TICK_MS) {                       /* See Note #2.                                         */
+        return (0u);
+    }
+
+    return (gap_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_WinEffDec()
+*
+* Description : Halve the effective window size of a session, on loss.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_StateDataRd(),
+*               TFTPs_TmrRetxHandler(),
+*               TFTPs_TxRegen().
+*
+* Note(s)     : (1) See 'tftp-s.c  Note #7'.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_WinEffDec (TFTPs_SESS  *p_sess)
+{
+    p_sess->WinEff /= 2u;                                       /* See Note #1.                                         */
+    if (p_sess->WinEff < 1u) {
+        p_sess->WinEff = 1u;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_DataWr()
+*
+* Description : Write data to the opened file.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : TFTP_ERR_NONE.
+*
+* Caller(s)   : TFTPs_StateDataWr().
+*
+* Note(s)     : (1) Once the last block is written, the session dallies so that the final ACK can be sent
+*                   again if the client retransmits the last block (see TFTPs_StateDally()).
+*
+*               (2) The write request completes once its last block is written & acknowledged.  The final
+*                   ACK is sent before the completion record, so that the client is NOT delayed by the hook.
+*
+*               (3) Block numbers are compared modulo 2^16, from the last block written.  Blocks before the
+*                   last block written, or past the window, are ignored.
+*
+*               (4) See 'tftp-s.c  Note #10'.  Without a window, every block is acknowledged.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  TFTPs_ERR  TFTPs_DataWr (TFTPs_SESS  *p_sess)
+{
+    CPU_INT16U   blk_nbr;
+    CPU_INT16U   blk_ahead;
+    CPU_INT32S   data_bytes;
+    CPU_BOOLEAN  last_blk;
+    CPU_BOOLEAN  ack;
+    CPU_INT16U  *p_blk_nbr;
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+    CPU_BOOLEAN  held;
+#endif
+
+
+                                                                /* Get block nbr.                                       */
+    p_blk_nbr  = (CPU_INT16U *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_BLK_NBR];
+    blk_nbr    =  NET_UTIL_NET_TO_HOST_16(*p_blk_nbr);
+    blk_ahead  = (CPU_INT16U)(blk_nbr - p_sess->TxBlkNbr);      /* See Note #3.                                         */
+    data_bytes =  TFTPs_RxMsgLen - TFTP_PKT_SIZE_OPCODE - TFTP_PKT_SIZE_BLK_NBR;
+
+
+    ack = DEF_NO;
+    if (blk_ahead == 1u) {                                      /* If next block, ...                                   */
+        last_blk         = TFTPs_DataWrBlk(p_sess,              /* ... wr data to file, ...                             */
+                                           &TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_DATA],
+                                           data_bytes);
+        p_sess->TxBlkNbr = blk_nbr;
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+        held = DEF_YES;                                         /* ... & the held blocks following it (see Note #4).    */
+        while ((last_blk == DEF_NO) &&
+               (held     == DEF_YES)) {
+            held = TFTPs_DataWrHeldWr(p_sess, &last_blk);
+        }
+#endif
+
+        if (last_blk == DEF_YES) {                              /* If last block of transmission, ...                   */
+            TFTPs_FS_Close(p_sess->FileHandle);                 /* ... close file.                                      */
+            p_sess->FileHandle = (void *)0;
+            p_sess->State      = TFTPs_STATE_DALLY;             /* See Note #1.                                         */
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+            TFTPs_DataWrHeldFree(p_sess);
+#endif
+            ack = DEF_YES;
+                                                                /* Ack end of window (see Note #4).                     */
+        } else if ((CPU_INT16U)(p_sess->TxBlkNbr - p_sess->WinAckNbr) >= p_sess->WinSize) {
+            ack = DEF_YES;
+        }
+
+    } else if (blk_ahead == 0u) {                               /* If last block rx'd again, ACK was lost.              */
+        ack = DEF_YES;
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+    } else if (blk_ahead <= p_sess->WinSize) {                  /* If block ahead in window, hold it (see Note #4).     */
+        TFTPs_Trace(36, (CPU_CHAR *)"Data Wr, Rx'd DATA out of order");
+        held = TFTPs_DataWrHold(p_sess,
+                                blk_nbr,
+                               &TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_DATA],
+                                data_bytes);
+        if ((held                                        == DEF_NO) ||
+            ((CPU_INT16U)(blk_nbr - p_sess->WinAckNbr) >= p_sess->WinSize)) {
+            TFTPs_Trace(37, (CPU_CHAR *)"Data Wr, Gap in window, ACK'd");
+            ack = DEF_YES;
+        }
+#endif
+    }
+
+
+    if (ack == DEF_YES) {
+        TFTPs_DataWrAck(p_sess, p_sess->TxBlkNbr);
+    }
+
+    if (p_sess->State == TFTPs_STATE_DALLY) {
+        TFTPs_TmrStop(&p_sess->TmrRetx);
+        TFTPs_TmrStop(&p_sess->TmrIdle);
+        TFTPs_TmrStart(&p_sess->TmrDally, TFTPs_CfgPtr->DallyTimeoutMax);
+        TFTPs_XferDone(p_sess, DEF_YES);                        /* See Note #2.                                         */
+    } else if ((ack       == DEF_YES) ||
+               (blk_ahead == 1u)) {
+        TFTPs_TxRetxStart(p_sess);
+    }
+
+
+    return (TFTPs_ERR_NONE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_DataWrBlk()
+*
+* Description : Write the data of a block to the opened file.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+*               p_data      Pointer to data of the block.
+*
+*               data_len    Length of the data of the block.
+*
+* Return(s)   : DEF_YES, if the block is the last block of the transfer.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_DataWr(),
+*               TFTPs_DataWrHeldWr().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_DataWrBlk (TFTPs_SESS  *p_sess,
+                                      CPU_INT08U  *p_data,
+                                      CPU_INT32S   data_len)
+{
+    CPU_SIZE_T  data_len_wr;
+
+
+    if (data_len > 0) {
+        (void)TFTPs_FS_Wr(               p_sess->FileHandle,
+                          (void       *) p_data,
+                          (CPU_SIZE_T  ) data_len,
+                          (CPU_SIZE_T *)&data_len_wr);
+        (void)&data_len_wr;
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+        TFTPs_DigestUpdate(&p_sess->Digest,                     /* Digest data (see 'tftp-s.c  Note #8').               */
+                            p_data,
+                           (CPU_SIZE_T)data_len);
+#endif
+        p_sess->XferLen += (CPU_INT32U)data_len;
+    }
+
+    if (data_len < p_sess->BlkSize) {
+        return (DEF_YES);
+    }
+
+    return (DEF_NO);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_DataWrAck()
+*
+* Description : Send an acknowledgement to the client.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+*               blk_nbr     Block number to acknowledge.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_ReqStart(),
+*               TFTPs_StateDally(),
+*               TFTPs_TmrRetxHandler(),
+*               TFTPs_DataWr(),
+*               TFTPs_TxRegen().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+static  void  TFTPs_DataWrAck (TFTPs_SESS  *p_sess,
+                               CPU_INT32U   blk_nbr)
+{
+                                                                /* Keep len for re-tx.                                  */
+    p_sess->TxMsgLen = TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR;
+    TFTPs_TxMsgCtr++;
+
+    TFTPs_TxHdrSet(p_sess->TxBufPtr, TFTP_OPCODE_ACK, (CPU_INT16U)blk_nbr);
+    TFTPs_TxSess(p_sess);
+
+    p_sess->WinAckNbr = (CPU_INT16U)blk_nbr;                    /* Last block ACK'd by the server.                      */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_DataWrHold()
+*
+* Description : Hold a block of a write request received out of order.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+*               blk_nbr     Block number.
+*
+*               p_data      Pointer to data of the block.
+*
+*               data_len    Length of the data of the block.
+*
+* Return(s)   : DEF_YES, if the block is held.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_DataWr().
+*
+* Note(s)     : (1) A block already held is NOT held twice.
+*
+*               (2) The block is NOT held when the session holds TFTPs_CFG_WR_REORDER_NBR_MAX blocks, or
+*                   when NO packet buffer of the session's block size is available.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_DataWrHold (TFTPs_SESS  *p_sess,
+                                       CPU_INT16U   blk_nbr,
+                                       CPU_INT08U  *p_data,
+                                       CPU_INT32S   data_len)
+{
+    TFTPs_WR_BLK  *p_blk;
+    CPU_INT08U    *p_buf;
+    CPU_INT08U     buf_class;
+    CPU_INT16U     blk_size;
+    CPU_INT08U     ix;
+
+
+    for (ix = 0u; ix < p_sess->WrHeldNbr; ix++) {               /* See Note #1.                                         */
+        if (p_sess->WrHeldTbl[ix].BlkNbr == blk_nbr) {
+            return (DEF_YES);
+        }
+    }
+
+    if ((p_sess->WrHeldNbr >= TFTPs_CFG_WR_REORDER_NBR_MAX) ||  /* See Note #2.                                         */
+        (data_len          <  0)                            ||
+        (data_len          >  p_sess->BlkSize)) {
+        return (DEF_NO);
+    }
+
+    p_buf = TFTPs_BufGet( p_sess->BlkSize,
+                          DEF_NO,
+                         &blk_size,
+                         &buf_class);
+    if (p_buf == DEF_NULL) {
+        return (DEF_NO);
+    }
+    Mem_Copy(p_buf, p_data, (CPU_SIZE_T)data_len);
+
+    p_blk           = &p_sess->WrHeldTbl[p_sess->WrHeldNbr];
+    p_blk->BufPtr   =  p_buf;
+    p_blk->BufClass =  buf_class;
+    p_blk->BlkNbr   =  blk_nbr;
+    p_blk->Len      = (CPU_INT16U)data_len;
+    p_sess->WrHeldNbr++;
+
+    return (DEF_YES);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_DataWrHeldWr()
+*
+* Description : Write the held block following the last block written, if held.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+*               p_last_blk  Pointer to variable that will receive whether the block written is the last
+*                           block of the transfer.
+*
+* Return(s)   : DEF_YES, if a held block was written.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_DataWr().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_DataWrHeldWr (TFTPs_SESS   *p_sess,
+                                         CPU_BOOLEAN  *p_last_blk)
+{
+    TFTPs_WR_BLK  *p_blk;
+    CPU_INT16U     blk_nbr;
+    CPU_INT08U     ix;
+
+
+    blk_nbr = (CPU_INT16U)(p_sess->TxBlkNbr + 1u);
+    for (ix = 0u; ix < p_sess->WrHeldNbr; ix++) {
+        p_blk = &p_sess->WrHeldTbl[ix];
+        if (p_blk->BlkNbr == blk_nbr) {
+           *p_last_blk       = TFTPs_DataWrBlk(p_sess, p_blk->BufPtr, (CPU_INT32S)p_blk->Len);
+            p_sess->TxBlkNbr = blk_nbr;
+
+            TFTPs_BufFree(p_blk->BufPtr, p_blk->BufClass);      /* Free block, replaced by the last held block.         */
+            p_sess->WrHeldNbr--;
+           *p_blk = p_sess->WrHeldTbl[p_sess->WrHeldNbr];
+            return (DEF_YES);
+        }
+    }
+
+    return (DEF_NO);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_DataWrHeldFree()
+*
+* Description : Free the blocks held by a session.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Terminate(),
+*               TFTPs_ReqStart(),
+*               TFTPs_DataWr().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+static  void  TFTPs_DataWrHeldFree (TFTPs_SESS  *p_sess)
+{
+    CPU_INT08U  ix;
+
+
+    for (ix = 0u; ix < p_sess->WrHeldNbr; ix++) {
+        TFTPs_BufFree(p_sess->WrHeldTbl[ix].BufPtr, p_sess->WrHeldTbl[ix].BufClass);
+    }
+    p_sess->WrHeldNbr = 0u;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            TFTPs_TxErr()
+*
+* Description : Send error message to the client.
+*
+* Argument(s) : sock_ix     Index of the server socket to send from.
+*
+*               p_addr      Pointer to socket address of the client.
+*
+*               err_code    TFTP error code        indicating the nature of the error.
+*
+*               p_err_msg   NULL terminated string indicating the nature of the error.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task(),
+*               TFTPs_StateDataRd(),
+*               TFTPs_StateDataWr(),
+*               TFTPs_FileOpen(),
+*               TFTPs_DataRd(),
+*               TFTPs_TmrRetxHandler().
+*
+* Note(s)     : (1) Error packets are built in their own buffer so that the last packet of the session in
+*                   progress, kept in its session's buffer for retransmission, is never overwritten.  With a
+*                   single packet buffer, they are built in the receive buffer (see 'tftp-s.c  Note #13').
+*
+*               (2) The building of the message is measured by the error building probe (see
+*                   'tftp-s_perf.c  Note #2').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TxErr (CPU_INT16U      sock_ix,
+                           NET_SOCK_ADDR  *p_addr,
+                           CPU_INT16U      err_code,
+                           CPU_CHAR       *p_err_msg)
+{
+    CPU_INT08U  *p_buf;
+    CPU_INT16S   tx_len;
+    TFTPs_PERF_ALLOC();
+
+
+    TFTPs_PERF_START();                                         /* See Note #2.                                         */
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    p_buf = TFTPs_RxMsgBuf;                                     /* See Note #1.                                         */
+#else
+    p_buf = TFTPs_TxErrBuf;
+#endif
+    (void)Str_Copy_N((CPU_CHAR *)&p_buf[TFTP_PKT_OFFSET_ERR_MSG], p_err_msg, TFTPs_ERR_MSG_LEN_MAX);
+    p_buf[TFTP_PKT_OFFSET_ERR_MSG + TFTPs_ERR_MSG_LEN_MAX] = 0u;
+
+    tx_len = Str_Len((CPU_CHAR *)&p_buf[TFTP_PKT_OFFSET_ERR_MSG]) + TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_ERR_CODE + 1;
+    TFTPs_PERF_STOP(TFTPs_PERF_PROBE_ERR_BUILD, tx_len);
+
+    TFTPs_Tx( sock_ix,
+              p_addr,
+              TFTP_OPCODE_ERR,
+              err_code,
+              p_buf,
+              tx_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             TFTPs_Tx()
+*
+* Description : Send TFTP packet.
+*
+* Argument(s) : sock_ix     Index of the server socket to send from.
+*
+*               p_addr      Pointer to socket address of the client.
+*
+*               opcode      TFTP packet operation code.
+*
+*               blk_nbr     Block number (or error code) for packet to transmit.
+*
+*               p_buf       Pointer to                       packet to transmit.
+*
+*               tx_len      Length of the                    packet to transmit (in octets).
+*
+* Return(s)   : Number of positive data octets transmitted, if NO errors.
+*
+*               NET_SOCK_BSD_RTN_CODE_CONN_CLOSED,          if socket connection closed.
+*
+*               NET_SOCK_BSD_ERR_TX,                        otherwise.
+*
+* Caller(s)   : TFTPs_TxErr().
+*
+* Note(s)     : (1) The packet is sent at once, bypassing the transmit queue (see 'tftp-s.c  Note #4').
+*********************************************************************************************************
+*/
+
+static  NET_SOCK_RTN_CODE  TFTPs_Tx (CPU_INT16U      sock_ix,
+                                     NET_SOCK_ADDR  *p_addr,
+                                     CPU_INT16U      opcode,
+                                     CPU_INT16U      blk_nbr,
+                                     CPU_INT08U     *p_buf,
+                                     CPU_INT16U      tx_len)
+{
+    NET_SOCK_RTN_CODE  bytes_sent;
+
 
+    TFTPs_TxHdrSet(p_buf, opcode, blk_nbr);
 
-    return (err);
+    bytes_sent = TFTPs_TxPkt(sock_ix, p_addr, p_buf, tx_len);   /* See Note #1.                                         */
+
+    return (bytes_sent);
 }
 
 
 /*
 *********************************************************************************************************
-*                                         TFTPs_StateDataWr()
+*                                           TFTPs_TxOAck()
 *
-* Description : Process write action.
+* Description : Send an option acknowledgement to the client.
 *
-* Argument(s) : none.
+* Argument(s) : p_sess      Pointer to session.
 *
-* Return(s)   : Error code for this function.
+*               p_opt       Pointer to the options to acknowledge.
 *
-* Caller(s)   : TFTPs_Task().
+* Return(s)   : none.
 *
-* Note(s)     : none.
+* Caller(s)   : TFTPs_ReqStart(),
+*               TFTPs_TxRegen().
+*
+* Note(s)     : (1) The OACK packet is built in the session's buffer, so that it is retransmitted as any
+*                   other packet until the client answers it :
+*
+*                       | opc | opt1 | 0 | value1 | 0 | ... | optN | 0 | valueN | 0 |
 *********************************************************************************************************
 */
 
-static  TFTPs_ERR  TFTPs_StateDataWr (void)
+static  void  TFTPs_TxOAck (TFTPs_SESS  *p_sess,
+                            TFTPs_OPT   *p_opt)
 {
-    TFTPs_ERR  err;
-
-
-    err = TFTPs_ERR_NONE;
-    switch (TFTPs_OpCode) {
-        case TFTP_OPCODE_RD_REQ:
-             TFTPs_Trace(30, (CPU_CHAR *)"Data Wr, WRQ server busy, RRQ  opcode?");
-             TFTPs_TxErr(0,  (CPU_CHAR *)"WRQ server busy, RRQ  opcode?");
-             err = TFTPs_ERR_RD_REQ;
-             break;
-
-
-        case TFTP_OPCODE_ACK:
-             TFTPs_Trace(31, (CPU_CHAR *)"Data Wr, WRQ server busy, ACK  opcode?");
-             TFTPs_TxErr(0,  (CPU_CHAR *)"WRQ server busy, ACK  opcode?");
-             err = TFTPs_ERR_ACK;
-             break;
-
-
-        case TFTP_OPCODE_WR_REQ:
-             NetFS_FileClose(TFTPs_FileHandle);
-             TFTPs_TxBlkNbr  = 0;
-                                                                /* Open the desired file for writing.                   */
-             err = TFTPs_FileOpen(TFTPs_FILE_OPEN_WR);
-             if (err == TFTPs_ERR_NONE) {
-                 TFTPs_Trace(32, (CPU_CHAR *)"Data Wr, Rx'd WR_REQ again");
-                 TFTPs_State = TFTPs_STATE_DATA_WR;
-                 TFTPs_DataWrAck(TFTPs_TxBlkNbr);               /* Acknowledge the client.                              */
-                 err = TFTPs_ERR_NONE;
-             }
-             break;
-
-
-        case TFTP_OPCODE_DATA:
-             TFTPs_Trace(33, (CPU_CHAR *)"Data Wr, Rx'd DATA --- OK");
-             err = TFTPs_DataWr();                  /* Write data to file.                                  */
-             break;
+    CPU_INT08U  *p_buf;
+    CPU_CHAR    *p_str;
+    CPU_INT16U  *p_opcode;
+    CPU_SIZE_T   len;
+
+
+    p_buf     =  p_sess->TxBufPtr;                              /* See Note #1.                                         */
+    p_opcode  = (CPU_INT16U *)&p_buf[TFTP_PKT_OFFSET_OPCODE];
+   *p_opcode  =  NET_UTIL_HOST_TO_NET_16(TFTP_OPCODE_OACK);
+    len       =  TFTP_PKT_SIZE_OPCODE;
+
+    if (p_opt->BlkSize != 0u) {
+        p_str = (CPU_CHAR *)&p_buf[len];
+        (void)Str_Copy(p_str, (CPU_CHAR *)TFTPs_OPT_NAME_BLK_SIZE);
+        len  += Str_Len(p_str) + 1u;
+
+        p_str = (CPU_CHAR *)&p_buf[len];
+        (void)Str_FmtNbr_Int32U(p_opt->BlkSize,
+                                TFTPs_OPT_VAL_LEN_MAX,
+                                DEF_NBR_BASE_DEC,
+                                ASCII_CHAR_NULL,
+                                DEF_NO,
+                                DEF_YES,
+                                p_str);
+        len  += Str_Len(p_str) + 1u;
+    }
 
+    if (p_opt->WinSize != 0u) {
+        p_str = (CPU_CHAR *)&p_buf[len];
+        (void)Str_Copy(p_str, (CPU_CHAR *)TFTPs_OPT_NAME_WIN_SIZE);
+        len  += Str_Len(p_str) + 1u;
+
+        p_str = (CPU_CHAR *)&p_buf[len];
+        (void)Str_FmtNbr_Int32U(p_opt->WinSize,
+                                TFTPs_OPT_VAL_LEN_MAX,
+                                DEF_NBR_BASE_DEC,
+                                ASCII_CHAR_NULL,
+                                DEF_NO,
+                                DEF_YES,
+                                p_str);
+        len  += Str_Len(p_str) + 1u;
+    }
 
-        case TFTP_OPCODE_ERR:
-             TFTPs_Trace(34, (CPU_CHAR *)"Data Wr, WRQ server busy, ERR  opcode?");
-             TFTPs_TxErr(0,  (CPU_CHAR *)"WRQ server busy, ERR  opcode?");
-             err = TFTPs_ERR_ERR;
-             break;
+    if (p_opt->TSizeReq == DEF_YES) {
+        p_str = (CPU_CHAR *)&p_buf[len];
+        (void)Str_Copy(p_str, (CPU_CHAR *)TFTPs_OPT_NAME_TSIZE);
+        len  += Str_Len(p_str) + 1u;
+
+        p_str = (CPU_CHAR *)&p_buf[len];
+        (void)Str_FmtNbr_Int32U(p_opt->TSize,
+                                TFTPs_OPT_TSIZE_LEN_MAX,
+                                DEF_NBR_BASE_DEC,
+                                ASCII_CHAR_NULL,
+                                DEF_NO,
+                                DEF_YES,
+                                p_str);
+        len  += Str_Len(p_str) + 1u;
     }
 
-    return (err);
+    p_sess->TxMsgLen = len;                                     /* Keep len for re-tx.                                  */
+    TFTPs_TxMsgCtr++;
+
+    TFTPs_TxSess(p_sess);
 }
 
 
 /*
 *********************************************************************************************************
-*                                         TFTPs_GetRxBlkNbr()
+*                                           TFTPs_TxSess()
 *
-* Description : Extract the block number from the received TFTP command packet.
+* Description : Queue the packet held in a session's buffer for transmission.
 *
-* Argument(s) : none.
+* Argument(s) : p_sess      Pointer to session.
 *
 * Return(s)   : none.
 *
-* Caller(s)   : TFTPs_StateDataRd().
+* Caller(s)   : TFTPs_TmrRetxHandler(),
+*               TFTPs_DataRd(),
+*               TFTPs_DataWrAck(),
+*               TFTPs_TxOAck().
+*
+* Note(s)     : (1) A session holds at most one packet to send (i.e. its last one).  A packet built while
+*                   the previous one is still queued replaces it, at the same position in the queue.
 *
-* Note(s)     : none.
+*               (2) The queue is serviced at once, so that a packet allowed by the shaper is sent before
+*                   this function returns.
 *********************************************************************************************************
 */
 
-static  void  TFTPs_GetRxBlkNbr (void)
+static  void  TFTPs_TxSess (TFTPs_SESS  *p_sess)
 {
-    CPU_INT16U  *p_blk_nbr;
-
+    if (p_sess->TxPend != DEF_YES) {                            /* Queue pkt (see Note #1).                             */
+        TFTPs_TxQ_Insert(p_sess);
+    }
 
-    p_blk_nbr      = (CPU_INT16U *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_BLK_NBR];
-    TFTPs_RxBlkNbr =  NET_UTIL_NET_TO_HOST_16(*p_blk_nbr);
+    TFTPs_TxSched();                                            /* See Note #2.                                         */
 }
 
 
 /*
 *********************************************************************************************************
-*                                          TFTPs_Terminate()
+*                                           TFTPs_TxRegen()
 *
-* Description : Terminate the current file transfer process.
+* Description : Build again & send the last packet of a session, for its retransmission.
 *
-* Argument(s) : none.
+* Argument(s) : p_sess      Pointer to session.
 *
-* Return(s)   : none.
+* Return(s)   : TFTPs_ERR_NONE,    if NO error.
 *
-* Caller(s)   : TFTPs_Dis(),
-*               TFTPs_Task().
+*               TFTPs_ERR_FILE_RD, if file read error.
 *
-* Note(s)     : none.
+* Caller(s)   : TFTPs_TmrRetxHandler().
+*
+* Note(s)     : (1) With a single packet buffer, the session's buffer does NOT hold its last packet anymore
+*                   (see 'tftp-s.c  Note #13'), which is built from the state of the session :
+*
+*                   (a) The OACK, from the options of the request, until the client answers it, i.e. while
+*                       NO block was transferred.
+*
+*                   (b) The DATA blocks of a read request, read again from the last block acknowledged, as
+*                       a window NOT acknowledged in time (see 'TFTPs_TmrRetxHandler()  Note #3').
+*
+*                   (c) The ACK of a write request, of the last block written.
 *********************************************************************************************************
 */
 
-static  void  TFTPs_Terminate (void)
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+static  TFTPs_ERR  TFTPs_TxRegen (TFTPs_SESS  *p_sess)
 {
-    NET_ERR  err_sock;
+    TFTPs_OPT  *p_opt;
+    TFTPs_ERR   err;
+
 
+    p_opt = &TFTPs_OAckOpt;
+    if ((p_sess->TxBlkNbr == 0u) &&                             /* See Note #1a.                                        */
+        (p_sess->XferLen  == 0u) &&
+       ((p_opt->BlkSize   != 0u) ||
+        (p_opt->WinSize   != 0u) ||
+        (p_opt->TSizeReq  == DEF_YES))) {
+        TFTPs_TxOAck(p_sess, p_opt);
+        return (TFTPs_ERR_NONE);
+    }
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+    if (p_sess->State != TFTPs_STATE_DATA_RD) {                 /* See Note #1c.                                        */
+        TFTPs_DataWrAck(p_sess, p_sess->TxBlkNbr);
+        return (TFTPs_ERR_NONE);
+    }
+#endif
 
-    TFTPs_State = TFTPs_STATE_IDLE;                             /* Abort current file transfer.                         */
-    if (TFTPs_FileHandle != (void *)0) {
-        NetFS_FileClose(TFTPs_FileHandle);                      /* Close the current opened file.                       */
-        TFTPs_FileHandle = (void *)0;
+    TFTPs_WinEffDec(p_sess);                                    /* See Note #1b.                                        */
+    err = TFTPs_WinRewind(p_sess);
+    if (err == TFTPs_ERR_NONE) {
+        err = TFTPs_WinTx(p_sess);
     }
 
-                                                                /* Reset blocking timeout to infinite.                  */
-    NetSock_CfgTimeoutRxQ_Set((NET_SOCK_ID) TFTPs_SockID,
-                              (CPU_INT32U ) NET_TMR_TIME_INFINITE,
-                              (NET_ERR   *)&err_sock);
+    return (err);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                          TFTPs_FileOpen()
+*                                           TFTPs_TxSched()
 *
-* Description : Get filename and file mode from the TFTP packet and attempt to open that file.
-*
-* Argument(s) : rw          File access :
-*
-*                               TFTPs_FILE_OPEN_RD      Open for reading
-*                               TFTPs_FILE_OPEN_WR      Open for writing
+* Description : Send the queued packets allowed by the egress shaper.
 *
-* Return(s)   : TFTP_ERR_NONE,           if NO error.
+* Argument(s) : none.
 *
-*               TFTP_ERR_FILE_NOT_FOUND, if file not found.
+* Return(s)   : none.
 *
-* Caller(s)   : TFTPs_StateIdle(),
-*               TFTPs_StateDataRd(),
-*               TFTPs_StateDataWr().
+* Caller(s)   : TFTPs_TmrTxSchedHandler(),
+*               TFTPs_TxSess().
 *
-* Note(s)     : (1) This function also extracts options as specified in RFC #2349 :
+* Note(s)     : (1) Sessions are visited in queue order, so that the packet first in the scheduler policy's
+*                   order is the first one offered the global tokens.  A packet blocked by its client bucket
+*                   does NOT hold back the packets of the other clients.
 *
-*                       "timeout"     specifies the timeout in seconds to wait in case we don't receive
-*                                     data request after we initiated a read request.
+*               (2) A packet that could NOT be sent by the network stack is recovered like a lost packet,
+*                   by the session's retransmission timer.  That timer is restarted once a deferred packet
+*                   is sent, so that it measures the time the client had to answer.
 *
-*                       "tsize"       specifies the size of the file in bytes that the client is writing.
+*               (3) When packets remain queued, the scheduler timer is set to the shortest estimated delay
+*                   (see 'TFTPs_ShapeTxDlyGet()  Note #1').
 *
-*                   Note that both these options may not be supported by the client and thus, we assume
-*                   default values if they are not specified..
+*               (4) The packets allowed by the shaper are sent together, in a single batch (see
+*                   'tftp-s_batch.c  Note #1').
 *********************************************************************************************************
 */
 
-static  TFTPs_ERR  TFTPs_FileOpen (CPU_BOOLEAN  rw)
+static  void  TFTPs_TxSched (void)
 {
-    CPU_CHAR  *p_filename;
-    CPU_CHAR  *p_mode;
-    CPU_CHAR  *p_name;
-#if 0
-    CPU_CHAR  *p_value;
-#endif
-
-                                                                /* ---- GET FILENAME ---------------------------------- */
-    p_filename = (CPU_CHAR *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_FILENAME];
-                                                                /* ---- GET FILE MODE --------------------------------- */
-    p_mode = p_filename;                                        /* Point to the 'Mode' string.                          */
-    while (*p_mode > (CPU_CHAR)0) {
-        p_mode++;
-    }
-    p_mode++;
-                                                                /* ---- GET RFC2349 "timeout" OPTION (IF AVAILABLE) --- */
-    p_name = p_mode;                                            /* Skip over the 'Mode' string.                         */
-    while (*p_name > (CPU_CHAR)0) {
-        p_name++;
-    }
-    p_name++;
+    TFTPs_SESS  *p_sess;
+    TFTPs_SESS  *p_sess_next;
+    CPU_INT32U   dly_ms;
+    CPU_INT32U   dly_ms_min;
 
 
-#if 0
-                                                                /* See if the client specified a "timeout" string       */
-    if (Str_Cmp(p_name, (CPU_CHAR *)"timeout") == 0) {          /* (RFC2349).                                           */
+    TFTPs_TmrStop(&TFTPs_TxSchedTmr);
+    dly_ms_min = TFTPs_TMR_TIME_INFINITE;
 
-        p_value = p_name;                                       /* Yes, skip over the "timeout" string.                 */
-        while (*p_value > (CPU_CHAR)0) {
-            p_value++;
-        }
-        p_value++;
-                                                                /* Get the timeout (in seconds).                        */
-        TFTPs_Timeout_s = Str_ParseNbr_Int32U(p_value, (CPU_CHAR  **)0, 0);
-    } else {
-        TFTPs_Timeout_s = TFTPs_TIMEOUT_SEC_DFLT;               /* No,  assume the default timeout (in seconds).        */
-
-                                                                /* ---- GET RFC2349 "tsize" OPTION (IF AVAILABLE) ----- */
-                                                                /* See if the client specified a "tsize" string         */
-                                                                /* (RFC2349).                                           */
-        if (Str_Cmp(p_name, (CPU_CHAR *)"tsize") == 0) {
-            p_value = p_name;
-            while (*p_value > (CPU_CHAR)0) {                    /* Yes, skip over the "tsize" string.                   */
-                p_value++;
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+    TFTPs_TxBatchOpen();                                        /* See Note #4.                                         */
+#endif
+    p_sess = TFTPs_TxQ_HeadPtr;                                 /* See Note #1.                                         */
+    while (p_sess != DEF_NULL) {
+        p_sess_next = p_sess->TxQ_NextPtr;
+
+        dly_ms = TFTPs_ShapeTxDlyGet( p_sess->ShapePtr, p_sess->ClassIx, p_sess->ListenIx, (CPU_INT32U)p_sess->TxMsgLen);
+        if (dly_ms == 0u) {
+            TFTPs_TxQ_Remove(p_sess);
+            (void)TFTPs_TxPkt( p_sess->SockIx,                  /* See Note #2.                                         */
+                              &p_sess->SockAddr,
+                               p_sess->TxBufPtr,
+                              (CPU_INT16U)p_sess->TxMsgLen);
+            TFTPs_ShapeTxDone( p_sess->ShapePtr, p_sess->ClassIx, p_sess->ListenIx, (CPU_INT32U)p_sess->TxMsgLen);
+            p_sess->TxTS = TFTPs_TmrNowGet();
+
+            if (TFTPs_TmrIsActive(&p_sess->TmrRetx) == DEF_YES) {
+                TFTPs_TmrStart(&p_sess->TmrRetx, TFTPs_CfgPtr->TxTimeoutMax);
             }
-            p_value++;
-                                                                /* Get the size of the file to write.                   */
-            TFTPs_WrSize = Str_ParseNbr_Int32U(p_value, (CPU_CHAR  **)0, 0);
-        } else {
-            TFTPs_WrSize = 0;                                   /* Assume a default value of 0.                         */
+
+        } else if (dly_ms < dly_ms_min) {
+            dly_ms_min = dly_ms;
         }
+
+        p_sess = p_sess_next;
     }
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+    TFTPs_TxBatchClose();
 #endif
-                                                                /* ---- OPEN THE FILE --------------------------------- */
-    TFTPs_FileHandle = TFTPs_FileOpenMode(p_filename, rw);
 
-    if (TFTPs_FileHandle == (void *)0) {
-        TFTPs_TxErr(0, (CPU_CHAR *)"file not found");
-        return (TFTPs_ERR_FILE_NOT_FOUND);
+    if (dly_ms_min != TFTPs_TMR_TIME_INFINITE) {                /* See Note #3.                                         */
+        TFTPs_TmrStart(&TFTPs_TxSchedTmr, dly_ms_min);
     }
-
-    return (TFTPs_ERR_NONE);
 }
 
 
 /*
 *********************************************************************************************************
-*                                        TFTPs_FileOpenMode()
+*                                         TFTPs_TxQ_Insert()
 *
-* Description : Open the specified file.
+* Description : Insert a session in the transmit queue, at the position set by the scheduler policy.
 *
-* Argument(s) : p_filename  File name to open.
+* Argument(s) : p_sess      Pointer to session.
 *
-*               rw          File access :
+* Return(s)   : none.
 *
-*                               TFTPs_FILE_OPEN_RD      Open for reading
-*                               TFTPs_FILE_OPEN_WR      Open for writing
+* Caller(s)   : TFTPs_TxSess().
 *
-* Return(s)   : Pointer to a file handle for the opened file, if NO error.
+* Note(s)     : (1) With the SRTF policy, the priority of a queued packet is its session's remaining transfer
+*                   size, less the aging credit earned while queued (see 'tftp-s_type.h  Note #7') :
 *
-*               Pointer to NULL,                              otherwise.
+*                       prio = XferRem - (SchedAgingRate * (now - TxQ_TS))
 *
-* Caller(s)   : TFTPs_FileOpen().
+*                   All queued packets age at the same rate, so their relative order does NOT change while
+*                   they wait.  A new packet is thus inserted once, behind every packet of higher priority,
+*                   by walking the queue from its tail; the packet at the head is always the one with the
+*                   highest priority.
 *
-* Note(s)     : none.
+*               (2) Packets of equal priority keep their queue order.
 *********************************************************************************************************
 */
 
-static  void  *TFTPs_FileOpenMode (CPU_CHAR     *p_filename,
-                                   CPU_BOOLEAN   rw)
+static  void  TFTPs_TxQ_Insert (TFTPs_SESS  *p_sess)
 {
-    void  *p_file;
+    TFTPs_SESS  *p_prev;
+    TFTPs_SESS  *p_next;
+    CPU_INT64U   prio_new;
+    CPU_INT64U   prio_prev;
+    CPU_INT32U   age_ms;
+
+
+    p_sess->TxPend = DEF_YES;
+    p_sess->TxQ_TS = TFTPs_TmrNowGet();
+
+    p_prev = TFTPs_TxQ_TailPtr;
+    p_next = DEF_NULL;
+
+    if (TFTPs_CfgPtr->SchedPolicy == TFTPs_SCHED_POLICY_SRTF) { /* See Note #1.                                         */
+        prio_new = p_sess->XferRem;
+        while (p_prev != DEF_NULL) {
+            age_ms    =  p_sess->TxQ_TS - p_prev->TxQ_TS;
+            prio_prev = (CPU_INT64U)p_prev->XferRem;
+            if ((prio_new + ((CPU_INT64U)age_ms * TFTPs_CfgPtr->SchedAgingRate)) >= prio_prev) {
+                break;                                          /* See Note #2.                                         */
+            }
+            p_next = p_prev;
+            p_prev = p_prev->TxQ_PrevPtr;
+        }
+    }
 
+    p_sess->TxQ_PrevPtr = p_prev;                               /* Link between prev & next.                            */
+    p_sess->TxQ_NextPtr = p_next;
+    if (p_prev != DEF_NULL) {
+        p_prev->TxQ_NextPtr = p_sess;
+    } else {
+        TFTPs_TxQ_HeadPtr   = p_sess;
+    }
+    if (p_next != DEF_NULL) {
+        p_next->TxQ_PrevPtr = p_sess;
+    } else {
+        TFTPs_TxQ_TailPtr   = p_sess;
+    }
+}
 
-    p_file = (void *)0;
-    switch (rw) {
-        case TFTPs_FILE_OPEN_RD:
-             p_file = NetFS_FileOpen(p_filename,
-                                     NET_FS_FILE_MODE_OPEN,
-                                     NET_FS_FILE_ACCESS_RD);
-             break;
 
-        case TFTPs_FILE_OPEN_WR:
-             p_file = NetFS_FileOpen(p_filename,
-                                     NET_FS_FILE_MODE_CREATE,
-                                     NET_FS_FILE_ACCESS_WR);
-             break;
+/*
+*********************************************************************************************************
+*                                         TFTPs_TxQ_Remove()
+*
+* Description : Remove a session from the transmit queue.
+*
+* Argument(s) : p_sess      Pointer to session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Terminate(),
+*               TFTPs_ReqStart(),
+*               TFTPs_TxSched().
+*
+* Note(s)     : (1) Sessions NOT queued are ignored.
+*********************************************************************************************************
+*/
 
+static  void  TFTPs_TxQ_Remove (TFTPs_SESS  *p_sess)
+{
+    if (p_sess->TxPend != DEF_YES) {                            /* See Note #1.                                         */
+        return;
+    }
 
-        default:
-             break;
+    if (p_sess->TxQ_PrevPtr != DEF_NULL) {
+        p_sess->TxQ_PrevPtr->TxQ_NextPtr = p_sess->TxQ_NextPtr;
+    } else {
+        TFTPs_TxQ_HeadPtr                = p_sess->TxQ_NextPtr;
+    }
+    if (p_sess->TxQ_NextPtr != DEF_NULL) {
+        p_sess->TxQ_NextPtr->TxQ_PrevPtr = p_sess->TxQ_PrevPtr;
+    } else {
+        TFTPs_TxQ_TailPtr                = p_sess->TxQ_PrevPtr;
     }
 
-    return (p_file);
+    p_sess->TxQ_PrevPtr = DEF_NULL;
+    p_sess->TxQ_NextPtr = DEF_NULL;
+    p_sess->TxPend      = DEF_NO;
 }
 
 
 /*
 *********************************************************************************************************
-*                                           TFTPs_DataRd()
+*                                         TFTPs_ReqQ_Push()
 *
-* Description : Read data from the opened file and send it to the client.
+* Description : Hold the request received in the receive buffer in the request queue.
 *
-* Argument(s) : none.
+* Argument(s) : p_key       Pointer to session key of the client.
 *
-* Return(s)   : TFTP_ERR_NONE,    if NO error.
+*               p_addr      Pointer to socket address of the client.
 *
-*               TFTP_ERR_FILE_RD, if file read error.
+*               sock_ix     Index of the server socket the request was received on.
 *
-*               TFTP_ERR_TX,      if transmit  error.
+* Return(s)   : DEF_YES, if the request is held.
 *
-* Caller(s)   : TFTPs_StateIdle(),
-*               TFTPs_StateDataRd().
+*               DEF_NO,  if the request MUST be served now.
 *
-* Note(s)     : none.
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) A request retransmitted by a client while its first copy is held is dropped.
+*
+*               (2) Requests are served now when the queue is disabled or full, or when they are too long
+*                   to be held.
 *********************************************************************************************************
 */
 
-static  TFTPs_ERR  TFTPs_DataRd (void)
+static  CPU_BOOLEAN  TFTPs_ReqQ_Push (TFTPs_SESS_KEY  *p_key,
+                                      NET_SOCK_ADDR   *p_addr,
+                                      CPU_INT16U       sock_ix)
 {
-    NET_SOCK_RTN_CODE  tx_size;
-    CPU_BOOLEAN        ok;
-
-
-                                                                /* Read data from file.                                 */
-    ok = NetFS_FileRd((void       *) TFTPs_FileHandle,
-                      (void       *)&TFTPs_TxMsgBuf[TFTP_PKT_OFFSET_DATA],
-                      (CPU_SIZE_T  ) TFTPs_BLOCK_SIZE,
-                      (CPU_SIZE_T *)&TFTPs_TxMsgLen);
+    TFTPs_REQ    *p_req;
+    TFTPs_REQ    *p_req_free;
+    CPU_BOOLEAN   same;
+    CPU_INT16U    ix;
 
-    if (TFTPs_TxMsgLen < TFTPs_BLOCK_SIZE) {                    /* Close file when all data read.                       */
-        NetFS_FileClose(TFTPs_FileHandle);
-        TFTPs_State = TFTPs_STATE_IDLE;
-    }
 
-    if (ok == DEF_FAIL) {                                       /* If read err, ...                                     */
-        TFTPs_TxErr(0, (CPU_CHAR *)"RRQ file read error");      /* ... tx  err pkt.                                     */
-        return (TFTPs_ERR_FILE_RD);
+    if (TFTPs_RxMsgLen > TFTPs_REQ_LEN_MAX) {                   /* See Note #2.                                         */
+        return (DEF_NO);
     }
 
-    TFTPs_TxMsgCtr++;
-    TFTPs_TxBlkNbr++;
-
-    TFTPs_TxMsgLen += TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR;
+    p_req_free = DEF_NULL;
+    for (ix = 0u; ix < TFTPs_CfgPtr->ReqQ_Size; ix++) {
+        p_req = &TFTPs_ReqQ_Tbl[ix];
+        if (p_req->Used == DEF_NO) {
+            if (p_req_free == DEF_NULL) {
+                p_req_free = p_req;
+            }
+            continue;
+        }
 
-    tx_size = TFTPs_Tx((CPU_INT16U  ) TFTP_OPCODE_DATA,
-                       (CPU_INT16U  ) TFTPs_TxBlkNbr,
-                       (CPU_INT08U *)&TFTPs_TxMsgBuf[0],
-                       (CPU_INT16U  ) TFTPs_TxMsgLen);
+        same = TFTPs_SessKeyCmp(&p_req->Key, p_key);
+        if (same == DEF_YES) {                                  /* See Note #1.                                         */
+            return (DEF_YES);
+        }
+    }
 
-    if (tx_size < 0) {                                          /* If tx  err, ...                                      */
-        TFTPs_TxErr(0, (CPU_CHAR *)"RRQ file read error");      /* ... tx err pkt.                                      */
-        return (TFTPs_ERR_TX);
+    if (p_req_free == DEF_NULL) {                               /* See Note #2.                                         */
+        return (DEF_NO);
     }
 
-    return (TFTPs_ERR_NONE);
+    p_req_free->Used     = DEF_YES;
+    p_req_free->Key      = *p_key;
+    p_req_free->SockAddr = *p_addr;
+    p_req_free->SockIx   =  sock_ix;
+    p_req_free->Seq      =  TFTPs_ReqQ_SeqNext++;
+    p_req_free->ClassIx  =  TFTPs_ClassMatch(             p_key,
+                                             (CPU_CHAR *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_FILENAME]);
+    p_req_free->Len      = (CPU_INT16U)TFTPs_RxMsgLen;
+    Mem_Copy(&p_req_free->Buf[0], &TFTPs_RxMsgBuf[0], (CPU_SIZE_T)TFTPs_RxMsgLen);
+    TFTPs_ReqQ_NbrUsed++;
+
+    return (DEF_YES);
 }
 
 
 /*
 *********************************************************************************************************
-*                                           TFTPs_DataWr()
+*                                          TFTPs_ReqQ_Pop()
 *
-* Description : Write data to the opened file.
+* Description : Move the next held request to the receive buffer.
 *
-* Argument(s) : none.
+* Argument(s) : p_addr      Pointer to variable that will receive the socket address of the client.
 *
-* Return(s)   : TFTP_ERR_NONE.
+*               p_sock_ix   Pointer to variable that will receive the index of the server socket the request
+*                           was received on.
 *
-* Caller(s)   : TFTPs_StateDataWr().
+* Return(s)   : DEF_YES, if a request was moved to the receive buffer.
 *
-* Note(s)     : none.
+*               DEF_NO,  if NO request is held.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) See 'HELD REQUEST DATA TYPE  Note #1'.
 *********************************************************************************************************
 */
 
-static  TFTPs_ERR  TFTPs_DataWr (void)
+static  CPU_BOOLEAN  TFTPs_ReqQ_Pop (NET_SOCK_ADDR  *p_addr,
+                                     CPU_INT16U     *p_sock_ix)
 {
-    CPU_INT16U   blk_nbr;
-    CPU_INT16S   data_bytes;
-    CPU_SIZE_T   data_bytes_wr;
-    CPU_INT16U  *p_blk_nbr;
-
-
-                                                                /* Get block nbr.                                       */
-    p_blk_nbr = (CPU_INT16U *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_BLK_NBR];
-    blk_nbr   =  NET_UTIL_NET_TO_HOST_16(*p_blk_nbr);
+    TFTPs_REQ   *p_req;
+    TFTPs_REQ   *p_req_next;
+    CPU_INT16U   ix;
 
 
-    if (blk_nbr > TFTPs_TxBlkNbr) {                             /* If block nbr > last block nbr, ...                   */
-        data_bytes = TFTPs_RxMsgLen - TFTP_PKT_SIZE_OPCODE - TFTP_PKT_SIZE_BLK_NBR;
-
-        if (data_bytes > 0) {                                   /* ... wr data to file.                                 */
-            (void)NetFS_FileWr((void       *) TFTPs_FileHandle,
-                               (void       *)&TFTPs_RxMsgBuf[TFTP_PKT_OFFSET_DATA],
-                               (CPU_SIZE_T  ) data_bytes,
-                               (CPU_SIZE_T *)&data_bytes_wr);
-            (void)&data_bytes_wr;
+    p_req_next = DEF_NULL;
+    for (ix = 0u; ix < TFTPs_CfgPtr->ReqQ_Size; ix++) {        /* See Note #1.                                         */
+        p_req = &TFTPs_ReqQ_Tbl[ix];
+        if (p_req->Used == DEF_NO) {
+            continue;
         }
 
-        if (data_bytes < TFTPs_BLOCK_SIZE) {                    /* If last block of transmission, ...                   */
-            NetFS_FileClose(TFTPs_FileHandle);                  /* ... close file.                                      */
-            TFTPs_State = TFTPs_STATE_IDLE;
+        if ((p_req_next        == DEF_NULL)            ||
+            (p_req->ClassIx    <  p_req_next->ClassIx) ||
+           ((p_req->ClassIx    == p_req_next->ClassIx) &&
+            (p_req->Seq - p_req_next->Seq > DEF_INT_32S_MAX_VAL))) {
+            p_req_next = p_req;
         }
     }
 
+    if (p_req_next == DEF_NULL) {
+        return (DEF_NO);
+    }
 
-    TFTPs_DataWrAck(blk_nbr);
-
-    TFTPs_TxBlkNbr = blk_nbr;
-
+    Mem_Copy(&TFTPs_RxMsgBuf[0], &p_req_next->Buf[0], p_req_next->Len);
+    TFTPs_RxMsgLen   = (CPU_INT32S)p_req_next->Len;
+   *p_addr           =  p_req_next->SockAddr;
+   *p_sock_ix        =  p_req_next->SockIx;
+    p_req_next->Used =  DEF_NO;
+    TFTPs_ReqQ_NbrUsed--;
 
-    return (TFTPs_ERR_NONE);
+    return (DEF_YES);
 }
 
 
 /*
 *********************************************************************************************************
-*                                          TFTPs_DataWrAck()
+*                                          TFTPs_ReqQ_Clr()
 *
-* Description : Send an acknowledgement to the client.
+* Description : Drop all the held requests.
 *
-* Argument(s) : blk_nbr     Block number to acknowledge.
+* Argument(s) : none.
 *
 * Return(s)   : none.
 *
-* Caller(s)   : TFTPs_StateIdle(),
-*               TFTPs_StateDataWr(),
-*               TFTPs_DataWr().
+* Caller(s)   : TFTPs_Init(),
+*               TFTPs_Task().
 *
 * Note(s)     : none.
 *********************************************************************************************************
 */
 
-static  void  TFTPs_DataWrAck (CPU_INT32U  blk_nbr)
+static  void  TFTPs_ReqQ_Clr (void)
 {
-    CPU_INT16S  tx_len;
-
+    CPU_INT16U  ix;
 
-    tx_len = TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR;
-    TFTPs_TxMsgCtr++;
 
-    TFTPs_Tx((CPU_INT16U  ) TFTP_OPCODE_ACK,
-             (CPU_INT16U  ) blk_nbr,
-             (CPU_INT08U *)&TFTPs_TxMsgBuf[0],
-             (CPU_INT16U  ) tx_len);
+    for (ix = 0u; ix < TFTPs_CfgPtr->ReqQ_Size; ix++) {
+        TFTPs_ReqQ_Tbl[ix].Used = DEF_NO;
+    }
+    TFTPs_ReqQ_NbrUsed = 0u;
 }
 
 
 /*
 *********************************************************************************************************
-*                                            TFTPs_TxErr()
+*                                          TFTPs_TxHdrSet()
 *
-* Description : Send error message to the client.
+* Description : Write the opcode & block number (or error code) of a TFTP packet.
 *
-* Argument(s) : err_code    TFTP error code        indicating the nature of the error.
+* Argument(s) : p_buf       Pointer to packet buffer.
 *
-*               p_err_msg   NULL terminated string indicating the nature of the error.
+*               opcode      TFTP packet operation code.
+*
+*               blk_nbr     Block number (or error code).
 *
 * Return(s)   : none.
 *
-* Caller(s)   : TFTPs_Task(),
-*               TFTPs_StateDataRd(),
-*               TFTPs_StateDataWr(),
-*               TFTPs_FileOpen(),
-*               TFTPs_DataRd().
+* Caller(s)   : TFTPs_DataRd(),
+*               TFTPs_DataWrAck(),
+*               TFTPs_Tx().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The building of the header is measured by the header building probe (see 'tftp-s_perf.c
+*                   Note #2').
 *********************************************************************************************************
 */
 
-static  void  TFTPs_TxErr (CPU_INT16U   err_code,
-                           CPU_CHAR    *p_err_msg)
+static  void  TFTPs_TxHdrSet (CPU_INT08U  *p_buf,
+                              CPU_INT16U   opcode,
+                              CPU_INT16U   blk_nbr)
 {
-    CPU_INT16S  tx_len;
+    CPU_INT16U  *p_buf16;
+    TFTPs_PERF_ALLOC();
 
 
-    tx_len = Str_Len(p_err_msg) + TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR + 1;
-
-    Str_Copy((CPU_CHAR *)&TFTPs_TxMsgBuf[TFTP_PKT_OFFSET_DATA], p_err_msg);
+    TFTPs_PERF_START();                                         /* See Note #1.                                         */
+    p_buf16 = (CPU_INT16U *)&p_buf[TFTP_PKT_OFFSET_OPCODE];
+   *p_buf16 = NET_UTIL_NET_TO_HOST_16(opcode);
 
-    TFTPs_Tx( TFTP_OPCODE_ERR,
-              err_code,
-             &TFTPs_TxMsgBuf[0],
-              tx_len);
+    p_buf16 = (CPU_INT16U *)&p_buf[TFTP_PKT_OFFSET_BLK_NBR];
+   *p_buf16 = NET_UTIL_NET_TO_HOST_16(blk_nbr);
+    TFTPs_PERF_STOP(TFTPs_PERF_PROBE_HDR_BUILD, TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR);
 }
 
 
 /*
 *********************************************************************************************************
-*                                             TFTPs_Tx()
+*                                            TFTPs_TxPkt()
 *
-* Description : Send TFTP packet.
+* Description : Send an already built TFTP packet to a client.
 *
-* Argument(s) : opcode      TFTP packet operation code.
+* Argument(s) : sock_ix     Index of the server socket to send from (see Note #1).
 *
-*               blk_nbr     Block number (or error code) for packet to transmit.
+*               p_addr      Pointer to socket address of the client.
 *
-*               p_buf       Pointer to                       packet to transmit.
+*               p_buf       Pointer to packet to transmit.
 *
-*               tx_len      Length of the                    packet to transmit (in octets).
+*               tx_len      Length of the packet to transmit (in octets).
 *
 * Return(s)   : Number of positive data octets transmitted, if NO errors.
 *
@@ -1747,39 +4752,69 @@ static  void  TFTPs_TxErr (CPU_INT16U   err_code,
 *
 *               NET_SOCK_BSD_ERR_TX,                        otherwise.
 *
-* Caller(s)   : TFTPs_StateDataRd(),
-*               TFTPs_DataRd(),
-*               TFTPs_DataWrAck(),
-*               TFTPs_TxErr().
+* Caller(s)   : TFTPs_Tx(),
+*               TFTPs_TxSched().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The packet is sent from the server socket the client's request was received on, so that
+*                   its source address is the local address of the listener the client reached (see
+*                   'tftp-s.c  Note #11').
+*
+*               (2) Packets are captured as they are handed to the socket (see 'tftp-s_capture.c  Note #2').
+*
+*               (3) When the network is simulated, packets are sent to the simulated clients (see
+*                   'tftp-s_sim.c  Note #1a').
+*
+*               (4) While a batch is open, the packet is added to it & sent with the batch, when closed (see
+*                   'tftp-s_batch.c  Note #1').  It is then reported as sent.
 *********************************************************************************************************
 */
 
-static  NET_SOCK_RTN_CODE  TFTPs_Tx (CPU_INT16U   opcode,
-                                     CPU_INT16U   blk_nbr,
-                                     CPU_INT08U  *p_buf,
-                                     CPU_INT16U   tx_len)
+static  NET_SOCK_RTN_CODE  TFTPs_TxPkt (CPU_INT16U      sock_ix,
+                                        NET_SOCK_ADDR  *p_addr,
+                                        CPU_INT08U     *p_buf,
+                                        CPU_INT16U      tx_len)
 {
-    CPU_INT16U         *p_buf16;
     NET_SOCK_RTN_CODE   bytes_sent;
+#if (TFTPs_CFG_SIM_EN != DEF_ENABLED)
     NET_ERR             err;
+#endif
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+    CPU_BOOLEAN         batched;
+
+
+                                                                /* See Note #4.                                         */
+    batched = TFTPs_TxBatchAdd(TFTPs_SockTbl[sock_ix].ID,
+                               TFTPs_SockTbl[sock_ix].ListenIx,
+                               p_addr,
+                               p_buf,
+                               tx_len);
+    if (batched == DEF_YES) {
+        return ((NET_SOCK_RTN_CODE)tx_len);
+    }
+#endif
 
 
-    p_buf16 = (CPU_INT16U *)&TFTPs_TxMsgBuf[TFTP_PKT_OFFSET_OPCODE];
-   *p_buf16 = NET_UTIL_NET_TO_HOST_16(opcode);
-
-    p_buf16 = (CPU_INT16U *)&TFTPs_TxMsgBuf[TFTP_PKT_OFFSET_BLK_NBR];
-   *p_buf16 = NET_UTIL_NET_TO_HOST_16(blk_nbr);
-
-
-    bytes_sent = NetSock_TxDataTo((NET_SOCK_ID      ) TFTPs_SockID,
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+    (void)sock_ix;
+    bytes_sent = TFTPs_SimTx(p_addr, p_buf, tx_len);            /* See Note #3.                                         */
+#else
+    bytes_sent = NetSock_TxDataTo((NET_SOCK_ID      ) TFTPs_SockTbl[sock_ix].ID,
                                   (void            *) p_buf,
                                   (CPU_INT16U       ) tx_len,
                                   (CPU_INT16S       ) NET_SOCK_FLAG_NONE,
-                                  (NET_SOCK_ADDR   *)&TFTPs_SockAddr,
+                                  (NET_SOCK_ADDR   *) p_addr,
                                   (NET_SOCK_ADDR_LEN) NET_SOCK_ADDR_SIZE,
                                   (NET_ERR         *)&err);
+#endif
+#if (TFTPs_CFG_CAPTURE_EN == DEF_ENABLED)
+    if (bytes_sent > 0) {                                       /* See Note #2.                                         */
+        TFTPs_CapturePkt(TFTPs_CAPTURE_DIR_TX,
+                         p_addr,
+                         TFTPs_SockTbl[sock_ix].ListenIx,
+                         p_buf,
+                         tx_len);
+    }
+#endif
 
     return (bytes_sent);
 }
@@ -1795,7 +4830,7 @@ static  NET_SOCK_RTN_CODE  TFTPs_Tx (CPU_INT16U   opcode,
 *
 * Return(s)   : none.
 *
-* Caller(s)   : TFTPs_ServerSockInit().
+* Caller(s)   : TFTPs_Task().
 *
 * Note(s)     : none.
 *********************************************************************************************************
@@ -1834,30 +4869,47 @@ static  void  TFTPs_TraceInit (void)
 *               TFTPs_StateDataWr(),
 *               TFTPs_Disp().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The recording of a trace is measured by the trace probe, at any trace level (see
+*                   'tftp-s_perf.c  Note #3').
 *********************************************************************************************************
 */
 
 static  void  TFTPs_Trace (CPU_INT16U   id,
                            CPU_CHAR    *p_str)
 {
-    KAL_ERR  err_kal;
+#if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
+    TFTPs_SESS  *p_sess;
+    KAL_ERR      err_kal;
+#endif
+    TFTPs_PERF_ALLOC();
 
 
+    TFTPs_PERF_START();                                         /* See Note #1.                                         */
 #if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
+    p_sess = TFTPs_SessCurPtr;
+
     TFTPs_TraceTbl[TFTPs_TraceIx].Id       = id;
     TFTPs_TraceTbl[TFTPs_TraceIx].TS       = KAL_TickGet(&err_kal);
-    TFTPs_TraceTbl[TFTPs_TraceIx].State    = TFTPs_State;
+    TFTPs_TraceTbl[TFTPs_TraceIx].State    = TFTPs_STATE_IDLE;
+    TFTPs_TraceTbl[TFTPs_TraceIx].RxBlkNbr = 0u;
+    TFTPs_TraceTbl[TFTPs_TraceIx].TxBlkNbr = 0u;
 
     Str_Copy(TFTPs_TraceTbl[TFTPs_TraceIx].Str, p_str);
 
-    TFTPs_TraceTbl[TFTPs_TraceIx].RxBlkNbr = TFTPs_RxBlkNbr;
-    TFTPs_TraceTbl[TFTPs_TraceIx].TxBlkNbr = TFTPs_TxBlkNbr;
+    if (p_sess != DEF_NULL) {                                   /* Record state of current session, if any.             */
+        TFTPs_TraceTbl[TFTPs_TraceIx].State    = p_sess->State;
+        TFTPs_TraceTbl[TFTPs_TraceIx].RxBlkNbr = p_sess->RxBlkNbr;
+        TFTPs_TraceTbl[TFTPs_TraceIx].TxBlkNbr = p_sess->TxBlkNbr;
+    }
 
     TFTPs_TraceIx++;
     if (TFTPs_TraceIx >= TFTPs_TRACE_HIST_SIZE) {
         TFTPs_TraceIx  = 0;
     }
+#else
+    (void)id;                                                   /* Prevent 'variable unused' compiler warning.          */
+    (void)p_str;
 #endif
+    TFTPs_PERF_STOP(TFTPs_PERF_PROBE_TRACE, 0u);
 }
 
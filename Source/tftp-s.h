@@ -99,6 +99,40 @@
 *
 *               (c) (1) \<TFTPs>\Source\tftp-s.h
 *                                      \tftp-s.c
+*                                      \tftp-s_tmr.h
+*                                      \tftp-s_tmr.c
+*                                      \tftp-s_sess.h
+*                                      \tftp-s_sess.c
+*                                      \tftp-s_buf.h
+*                                      \tftp-s_buf.c
+*                                      \tftp-s_shape.h
+*                                      \tftp-s_shape.c
+*                                      \tftp-s_class.h
+*                                      \tftp-s_class.c
+*                                      \tftp-s_fs.h
+*                                      \tftp-s_fs.c
+*                                      \tftp-s_lz4.h
+*                                      \tftp-s_lz4.c
+*                                      \tftp-s_digest.h
+*                                      \tftp-s_digest.c
+*                                      \tftp-s_trie.h
+*                                      \tftp-s_trie.c
+*                                      \tftp-s_rewrite.h
+*                                      \tftp-s_rewrite.c
+*                                      \tftp-s_acl.h
+*                                      \tftp-s_acl.c
+*                                      \tftp-s_meta.h
+*                                      \tftp-s_meta.c
+*                                      \tftp-s_perf.h
+*                                      \tftp-s_perf.c
+*                                      \tftp-s_batch.h
+*                                      \tftp-s_batch.c
+*
+*                   (2) \<TFTPs>\Tests\Host\tftp-s_sim.h
+*                                          \tftp-s_sim.c
+*
+*                       The network simulation is part of the host tests, & is only built when
+*                       TFTPs_CFG_SIM_EN is enabled (see 'tftp-s_sim.c  Note #8').
 *
 *           (2) CPU-configuration software files are located in the following directories :
 *
@@ -143,6 +177,7 @@
 
 #include  <lib_def.h>                                           /* Standard        Defines        (see Note #3a)        */
 #include  <lib_str.h>                                           /* Standard String Library        (see Note #3a)        */
+#include  <lib_mem.h>                                           /* Memory          Library        (see Note #3a)        */
 
 #include  <tftp-s_cfg.h>                                        /* TFTP Server Configuration File (see Note #1a)        */
 #include  <FS/net_fs.h>                                         /* File System Interface          (see Note #1b)        */
@@ -190,7 +225,31 @@ typedef  enum tftps_err {
     TFTPs_ERR_NO_SOCK,                                          /* No socket available.                                 */
     TFTPs_ERR_CANT_BIND,                                        /* Could not bind to the TFTPs port.                    */
     TFTPs_ERR_INVALID_FAMILY,                                   /* Invalid Socket Family.                               */
-    TFTPs_ERR_INVALID_ADDR                                      /* Invalid Socket Address.                              */
+    TFTPs_ERR_INVALID_ADDR,                                     /* Invalid Socket Address.                              */
+    TFTPs_ERR_CFG_INVALID_SESS_NBR,                             /* Invalid max nbr of sessions.                         */
+    TFTPs_ERR_MEM_ALLOC,                                        /* Could not alloc memory.                              */
+    TFTPs_ERR_SESS_UNAVAIL,                                     /* No session available.                                */
+    TFTPs_ERR_CFG_INVALID_BUF_NBR,                              /* Invalid nbr of pkt bufs.                             */
+    TFTPs_ERR_BUF_UNAVAIL,                                      /* No pkt buf available.                                */
+    TFTPs_ERR_CFG_INVALID_SHAPE,                                /* Invalid shaping rate or burst size.                  */
+    TFTPs_ERR_CFG_INVALID_SCHED,                                /* Invalid tx scheduler policy.                         */
+    TFTPs_ERR_CFG_INVALID_CLASS,                                /* Invalid traffic class tbl.                           */
+    TFTPs_ERR_CFG_INVALID_WIN,                                  /* Invalid max window size.                             */
+    TFTPs_ERR_CFG_INVALID_LZ4,                                  /* Invalid LZ4 decoder cfg.                             */
+    TFTPs_ERR_CFG_INVALID_DIGEST,                               /* Invalid digest alg.                                  */
+    TFTPs_ERR_FS_PROVIDER_FULL,                                 /* No file provider slot available.                     */
+    TFTPs_ERR_CFG_INVALID_REWRITE,                              /* Invalid rewrite rule tbl.                            */
+    TFTPs_ERR_REWRITE_BUSY,                                     /* Rewrite rules being looked up.                       */
+    TFTPs_ERR_CFG_INVALID_ACL,                                  /* Invalid addr filter rule tbl or perm.                */
+    TFTPs_ERR_CFG_INVALID_LISTEN,                               /* Invalid listener tbl.                                */
+    TFTPs_ERR_CFG_INVALID_CAPTURE,                              /* Invalid pkt capture cfg.                             */
+    TFTPs_ERR_CAPTURE_BUSY,                                     /* Pkt capture being exported.                          */
+    TFTPs_ERR_CAPTURE_WR,                                       /* Pkt capture export aborted by writer.                */
+    TFTPs_ERR_CFG_INVALID_SIM,                                  /* Invalid simulation cfg.                              */
+    TFTPs_ERR_SIM_INVALID_SCENARIO,                             /* Invalid simulation scenario.                         */
+    TFTPs_ERR_PERF_NO_MEASURE,                                  /* Probe NOT measured.                                  */
+    TFTPs_ERR_CFG_INVALID_TX_BATCH,                             /* Invalid batched tx cfg.                              */
+    TFTPs_ERR_CFG_INVALID_BUF_SINGLE                            /* Invalid single pkt buf cfg.                          */
 } TFTPs_ERR;
 
 
@@ -202,18 +261,76 @@ typedef  enum tftps_err {
 *********************************************************************************************************
 */
 
-CPU_BOOLEAN  TFTPs_Init       (const TFTPs_CFG             *p_cfg,
-                               const TFTPs_TASK_CFG        *p_task_cfg,
-                                     TFTPs_ERR             *p_err);
+CPU_BOOLEAN  TFTPs_Init          (const TFTPs_CFG             *p_cfg,
+                                  const TFTPs_TASK_CFG        *p_task_cfg,
+                                        TFTPs_ERR             *p_err);
+
+void         TFTPs_En            (void);
+
+void         TFTPs_Dis           (void);
+
+void         TFTPs_ShapeGlobalSet(      CPU_INT32U             rate,
+                                        CPU_INT32U             burst,
+                                        TFTPs_ERR             *p_err);
+
+void         TFTPs_ShapeClientSet(      CPU_INT32U             rate,
+                                        CPU_INT32U             burst,
+                                        TFTPs_ERR             *p_err);
+
+CPU_INT16U   TFTPs_SessStatGet   (      TFTPs_SESS_STAT       *p_stat_tbl,
+                                        CPU_INT16U             stat_nbr_max,
+                                        TFTPs_ERR             *p_err);
+
+void         TFTPs_StatGet       (      TFTPs_STAT            *p_stat,
+                                        TFTPs_ERR             *p_err);
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+void         TFTPs_FS_ProviderAdd(const TFTPs_FS_PROVIDER     *p_provider,
+                                        TFTPs_ERR             *p_err);
+#endif
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+void         TFTPs_MetaInvalidate(      TFTPs_ERR             *p_err);
+#endif
+
+#if (TFTPs_CFG_REWRITE_EN == DEF_ENABLED)
+void         TFTPs_RewriteSet    (const TFTPs_REWRITE_RULE    *p_tbl,
+                                        CPU_INT16U             nbr,
+                                        TFTPs_ERR             *p_err);
+#endif
+
+#if (TFTPs_CFG_CAPTURE_EN == DEF_ENABLED)
+void         TFTPs_CaptureFiltSet(const TFTPs_CAPTURE_FILT    *p_filt,
+                                        TFTPs_ERR             *p_err);
+
+void         TFTPs_CaptureClr    (      TFTPs_ERR             *p_err);
+
+CPU_INT32U   TFTPs_CaptureExport (      TFTPs_CAPTURE_WR_FNCT  wr_fnct,
+                                        void                  *p_arg,
+                                        TFTPs_ERR             *p_err);
+#endif
+
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+void         TFTPs_SimRun        (const TFTPs_SIM_SCENARIO    *p_scenario,
+                                        TFTPs_SIM_RESULT      *p_result,
+                                        TFTPs_ERR             *p_err);
+#endif
 
-void         TFTPs_En         (void);
+#if (TFTPs_CFG_PERF_EN == DEF_ENABLED)
+void         TFTPs_PerfGet       (      TFTPs_PERF_STAT       *p_stat_tbl,
+                                        TFTPs_ERR             *p_err);
 
-void         TFTPs_Dis        (void);
+void         TFTPs_PerfClr       (      TFTPs_ERR             *p_err);
+
+CPU_INT32S   TFTPs_PerfCmp       (const TFTPs_PERF_STAT       *p_baseline,
+                                  const TFTPs_PERF_STAT       *p_stat,
+                                        TFTPs_ERR             *p_err);
+#endif
 
 #if (TFTPs_TRACE_LEVEL >= TRACE_LEVEL_INFO)
-void         TFTPs_Disp       (void);
+void         TFTPs_Disp          (void);
 
-void         TFTPs_DispTrace  (void);
+void         TFTPs_DispTrace     (void);
 #endif
 
 
@@ -299,6 +416,259 @@ void         TFTPs_DispTrace  (void);
 #endif
 
 
+#ifndef  TFTPs_CFG_TMR_TICK_MS
+#error  "TFTPs_CFG_TMR_TICK_MS              not #define'd in 'tftp-s_cfg.h'"
+#error  "                             [MUST be  >= 1   ]                   "
+#error  "                             [     &&  <= 255 ]                   "
+
+#elif  ((TFTPs_CFG_TMR_TICK_MS < 1) || \
+        (TFTPs_CFG_TMR_TICK_MS > 255))
+#error  "TFTPs_CFG_TMR_TICK_MS        illegally #define'd in 'tftp-s_cfg.h'"
+#error  "                             [MUST be  >= 1   ]                   "
+#error  "                             [     &&  <= 255 ]                   "
+#endif
+
+
+#ifndef  TFTPs_CFG_FS_LZ4_EN
+    #error  "TFTPs_CFG_FS_LZ4_EN                      not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_FS_LZ4_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_FS_LZ4_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_FS_LZ4_EN                illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#endif
+
+
+#ifndef  TFTPs_CFG_FS_PROVIDER_EN
+    #error  "TFTPs_CFG_FS_PROVIDER_EN                 not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_FS_PROVIDER_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_FS_PROVIDER_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_FS_PROVIDER_EN           illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif   (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+#ifndef  TFTPs_CFG_FS_PROVIDER_NBR_MAX
+    #error  "TFTPs_CFG_FS_PROVIDER_NBR_MAX            not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+#elif   (TFTPs_CFG_FS_PROVIDER_NBR_MAX < 1)
+    #error  "TFTPs_CFG_FS_PROVIDER_NBR_MAX      illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+#endif
+#endif
+
+
+#ifndef  TFTPs_CFG_FS_META_EN
+    #error  "TFTPs_CFG_FS_META_EN                     not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_FS_META_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_FS_META_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_FS_META_EN               illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif   (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+#ifndef  TFTPs_CFG_FS_META_NAME_LEN_MAX
+    #error  "TFTPs_CFG_FS_META_NAME_LEN_MAX           not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+#elif   (TFTPs_CFG_FS_META_NAME_LEN_MAX < 1)
+    #error  "TFTPs_CFG_FS_META_NAME_LEN_MAX     illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+#endif
+#endif
+
+
+#ifndef  TFTPs_CFG_FS_HANDLE_EN
+    #error  "TFTPs_CFG_FS_HANDLE_EN                   not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_FS_HANDLE_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_FS_HANDLE_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_FS_HANDLE_EN             illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif   (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+#ifndef  TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX
+    #error  "TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX         not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+#elif   (TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX < 1)
+    #error  "TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX   illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+#endif
+#endif
+
+
+#ifndef  TFTPs_CFG_FS_STREAM_EN
+    #error  "TFTPs_CFG_FS_STREAM_EN                   not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_FS_STREAM_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_FS_STREAM_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_FS_STREAM_EN             illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED ) && \
+        (TFTPs_CFG_FS_HANDLE_EN != DEF_ENABLED))
+    #error  "TFTPs_CFG_FS_STREAM_EN             illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED when]               "
+    #error  "                             [TFTPs_CFG_FS_HANDLE_EN DEF_DISABLED]      "
+#endif
+
+
+#ifndef  TFTPs_CFG_WR_EN
+    #error  "TFTPs_CFG_WR_EN                          not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_WR_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_WR_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_WR_EN                    illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#endif
+
+
+#ifndef  TFTPs_CFG_WR_WIN_EN
+    #error  "TFTPs_CFG_WR_WIN_EN                      not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_WR_WIN_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_WR_WIN_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_WR_WIN_EN                illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_WR_WIN_EN == DEF_ENABLED ) && \
+        (TFTPs_CFG_WR_EN     != DEF_ENABLED))
+    #error  "TFTPs_CFG_WR_WIN_EN                illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED when]               "
+    #error  "                             [TFTPs_CFG_WR_EN          DEF_DISABLED]    "
+#elif   (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+#ifndef  TFTPs_CFG_WR_REORDER_NBR_MAX
+    #error  "TFTPs_CFG_WR_REORDER_NBR_MAX             not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+    #error  "                             [     &&  <= 255]                          "
+#elif  ((TFTPs_CFG_WR_REORDER_NBR_MAX < 1) || \
+        (TFTPs_CFG_WR_REORDER_NBR_MAX > 255))
+    #error  "TFTPs_CFG_WR_REORDER_NBR_MAX       illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  >= 1]                            "
+    #error  "                             [     &&  <= 255]                          "
+#endif
+#endif
+
+
+#ifndef  TFTPs_CFG_REWRITE_EN
+    #error  "TFTPs_CFG_REWRITE_EN                     not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_REWRITE_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_REWRITE_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_REWRITE_EN               illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#endif
+
+
+#ifndef  TFTPs_CFG_ACL_EN
+    #error  "TFTPs_CFG_ACL_EN                         not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_ACL_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_ACL_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_ACL_EN                   illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#endif
+
+
+#ifndef  TFTPs_CFG_CAPTURE_EN
+    #error  "TFTPs_CFG_CAPTURE_EN                     not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_CAPTURE_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_CAPTURE_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_CAPTURE_EN               illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#endif
+
+
+#ifndef  TFTPs_CFG_SIM_EN
+    #error  "TFTPs_CFG_SIM_EN                         not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_SIM_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_SIM_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_SIM_EN                   illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_SIM_EN         == DEF_ENABLED ) && \
+        (TFTPs_CFG_FS_PROVIDER_EN != DEF_ENABLED))
+    #error  "TFTPs_CFG_SIM_EN                   illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED when]               "
+    #error  "                             [TFTPs_CFG_FS_PROVIDER_EN DEF_DISABLED]    "
+#endif
+
+
+#ifndef  TFTPs_CFG_PERF_EN
+    #error  "TFTPs_CFG_PERF_EN                        not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_PERF_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_PERF_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_PERF_EN                  illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_PERF_EN == DEF_ENABLED ) && \
+        (CPU_CFG_TS_TMR_EN != DEF_ENABLED))
+    #error  "TFTPs_CFG_PERF_EN                  illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED when]               "
+    #error  "                             [CPU_CFG_TS_TMR_EN        DEF_DISABLED]    "
+#endif
+
+
+#ifndef  TFTPs_CFG_TX_BATCH_EN
+    #error  "TFTPs_CFG_TX_BATCH_EN                    not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_TX_BATCH_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_TX_BATCH_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_TX_BATCH_EN              illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#endif
+
+
+#ifndef  TFTPs_CFG_BUF_SINGLE_EN
+    #error  "TFTPs_CFG_BUF_SINGLE_EN                  not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_BUF_SINGLE_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_BUF_SINGLE_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_BUF_SINGLE_EN            illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED ) && \
+        (TFTPs_CFG_WR_WIN_EN     == DEF_ENABLED))
+    #error  "TFTPs_CFG_BUF_SINGLE_EN            illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED when]               "
+    #error  "                             [TFTPs_CFG_WR_WIN_EN      DEF_ENABLED ]    "
+#endif
+
+
+#ifndef  TFTPs_CFG_DIGEST_EN
+    #error  "TFTPs_CFG_DIGEST_EN                      not #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#elif  ((TFTPs_CFG_DIGEST_EN != DEF_ENABLED ) && \
+        (TFTPs_CFG_DIGEST_EN != DEF_DISABLED))
+    #error  "TFTPs_CFG_DIGEST_EN                illegally #define'd in 'tftp-s_cfg.h'"
+    #error  "                             [MUST be  DEF_DISABLED]                    "
+    #error  "                             [     ||  DEF_ENABLED ]                    "
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
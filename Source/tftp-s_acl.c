@@ -0,0 +1,248 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     TFTP SERVER ADDRESS FILTER
+*
+* Filename : tftp-s_acl.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The subnets of the rules are kept in one prefix trie per address family (see 'tftp-s_trie.c'),
+*                so that the permissions of a client are found with one trie lookup, whatever the number of
+*                rules.  The first rule of the TFTPs_CLASS_FAMILY_ANY family is kept apart, as it matches
+*                any client.
+*
+*            (2) Packets are filtered as soon as they are received, before any session or file is looked
+*                up (see 'tftp-s.c  TFTPs_RxFilter()').
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_ACL_MODULE
+#include  "tftp-s_acl.h"
+#include  "tftp-s_trie.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_ACL_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  TFTPs_ACL_RULE  *TFTPs_ACL_TblPtr;               /* Rule tbl.                                            */
+static  TFTPs_TRIE_POOL         TFTPs_ACL_NodePool;             /* Trie nodes of rules.                                 */
+static  TFTPs_TRIE_NODE        *TFTPs_ACL_RootIPv4Ptr;          /* Rules of IPv4 subnets (see Note #1).                 */
+static  TFTPs_TRIE_NODE        *TFTPs_ACL_RootIPv6Ptr;          /* Rules of IPv6 subnets (see Note #1).                 */
+static  CPU_INT32U              TFTPs_ACL_RuleAnyIx;            /* Rule matching any client (see Note #1).              */
+static  CPU_INT08U              TFTPs_ACL_PermDflt;             /* Perm of clients matching NO rule.                    */
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_ACL_Init()
+*
+* Description : Validate the address filter rules of the configuration & build their tries.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_ACL
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) A trie of N prefixes holds at most 2 * N nodes (see 'tftp-s_trie.c  Note #1').
+*
+*               (2) A rule whose subnet equals that of a previous rule is kept, but never wins (see
+*                   'tftp-s_trie.c  TFTPs_TrieInsert()  Note #1').
+*********************************************************************************************************
+*/
+
+void  TFTPs_ACL_Init (const  TFTPs_CFG  *p_cfg,
+                             TFTPs_ERR  *p_err)
+{
+    const  TFTPs_ACL_RULE  *p_rule;
+           CPU_INT16U       ix;
+           CPU_BOOLEAN      ok;
+
+
+    if ((p_cfg->ACL_Nbr      > 0u)       &&
+        (p_cfg->ACL_TblPtr  == DEF_NULL)) {
+       *p_err = TFTPs_ERR_CFG_INVALID_ACL;
+        return;
+    }
+
+    if ((p_cfg->ACL_PermDflt & ~TFTPs_ACL_PERM_RD_WR) != 0u) {
+       *p_err = TFTPs_ERR_CFG_INVALID_ACL;
+        return;
+    }
+
+    TFTPs_ACL_TblPtr      = p_cfg->ACL_TblPtr;
+    TFTPs_ACL_RootIPv4Ptr = DEF_NULL;
+    TFTPs_ACL_RootIPv6Ptr = DEF_NULL;
+    TFTPs_ACL_RuleAnyIx   = TFTPs_TRIE_VAL_NONE;
+    TFTPs_ACL_PermDflt    = p_cfg->ACL_PermDflt;
+    if (p_cfg->ACL_Nbr == 0u) {                                 /* No rule : all clients get the dflt perm.             */
+       *p_err = TFTPs_ERR_NONE;
+        return;
+    }
+
+    TFTPs_TriePoolAlloc(&TFTPs_ACL_NodePool,                    /* See Note #1.                                         */
+                        (CPU_CHAR *)"TFTPs ACL Trie Nodes",
+                         2u * (CPU_INT32U)p_cfg->ACL_Nbr,
+                         p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        return;
+    }
+
+    for (ix = 0u; ix < p_cfg->ACL_Nbr; ix++) {
+        p_rule = &p_cfg->ACL_TblPtr[ix];
+
+        if ((p_rule->Perm & ~TFTPs_ACL_PERM_RD_WR) != 0u) {
+           *p_err = TFTPs_ERR_CFG_INVALID_ACL;
+            return;
+        }
+
+        ok = DEF_OK;                                            /* See Note #2.                                         */
+        switch (p_rule->SubnetFamily) {
+            case TFTPs_CLASS_FAMILY_ANY:
+                 if (TFTPs_ACL_RuleAnyIx == TFTPs_TRIE_VAL_NONE) {
+                     TFTPs_ACL_RuleAnyIx = ix;
+                 }
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv4:
+                 if (p_rule->SubnetPrefixLen > TFTPs_TRIE_ADDR_LEN_IPv4) {
+                     ok = DEF_FAIL;
+                     break;
+                 }
+                 ok = TFTPs_TrieInsert(&TFTPs_ACL_NodePool,
+                                       &TFTPs_ACL_RootIPv4Ptr,
+                                        p_rule->SubnetAddr,
+                                        p_rule->SubnetPrefixLen,
+                                        ix);
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv6:
+                 if (p_rule->SubnetPrefixLen > TFTPs_TRIE_ADDR_LEN_IPv6) {
+                     ok = DEF_FAIL;
+                     break;
+                 }
+                 ok = TFTPs_TrieInsert(&TFTPs_ACL_NodePool,
+                                       &TFTPs_ACL_RootIPv6Ptr,
+                                        p_rule->SubnetAddr,
+                                        p_rule->SubnetPrefixLen,
+                                        ix);
+                 break;
+
+            default:
+                 ok = DEF_FAIL;
+                 break;
+        }
+
+        if (ok != DEF_OK) {
+           *p_err = TFTPs_ERR_CFG_INVALID_ACL;
+            return;
+        }
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ACL_PermGet()
+*
+* Description : Get the permissions of a client.
+*
+* Argument(s) : p_key       Pointer to session key of the client.
+*
+* Return(s)   : Permissions of the client (see 'tftp-s_type.h  ADDRESS FILTER PERMISSION DEFINES').
+*
+* Caller(s)   : TFTPs_RxFilter().
+*
+* Note(s)     : (1) See 'tftp-s_type.h  ADDRESS FILTER RULE DATA TYPE  Note #2'.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  TFTPs_ACL_PermGet (const  TFTPs_SESS_KEY  *p_key)
+{
+    CPU_INT32U  rule_ix;
+
+
+    rule_ix = TFTPs_TRIE_VAL_NONE;                              /* See Note #1.                                         */
+    switch (p_key->Family) {
+        case NET_SOCK_ADDR_FAMILY_IP_V4:
+             rule_ix = TFTPs_TrieLookup(TFTPs_ACL_RootIPv4Ptr, (CPU_INT08U *)p_key->Addr, TFTPs_TRIE_ADDR_LEN_IPv4);
+             break;
+
+        case NET_SOCK_ADDR_FAMILY_IP_V6:
+             rule_ix = TFTPs_TrieLookup(TFTPs_ACL_RootIPv6Ptr, (CPU_INT08U *)p_key->Addr, TFTPs_TRIE_ADDR_LEN_IPv6);
+             break;
+
+        default:
+             break;
+    }
+
+    if (rule_ix == TFTPs_TRIE_VAL_NONE) {
+        rule_ix = TFTPs_ACL_RuleAnyIx;
+    }
+
+    if (rule_ix == TFTPs_TRIE_VAL_NONE) {
+        return (TFTPs_ACL_PermDflt);
+    }
+
+    return (TFTPs_ACL_TblPtr[rule_ix].Perm);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of ACL module include.                           */
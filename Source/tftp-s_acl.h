@@ -0,0 +1,76 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     TFTP SERVER ADDRESS FILTER
+*
+* Filename : tftp-s_acl.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs ACL present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_ACL_MODULE_PRESENT                               /* See Note #1.                                         */
+#define  TFTPs_ACL_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+#include  "tftp-s_sess.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void        TFTPs_ACL_Init   (const  TFTPs_CFG       *p_cfg,
+                                     TFTPs_ERR       *p_err);
+
+CPU_INT08U  TFTPs_ACL_PermGet(const  TFTPs_SESS_KEY  *p_key);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_ACL_MODULE_PRESENT  */
@@ -0,0 +1,406 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  TFTP SERVER BATCHED TRANSMISSION
+*
+* Filename : tftp-s_batch.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The packets built while a batch is open, e.g. the blocks of a window (see 'tftp-s.c
+*                TFTPs_WinTx()') or the answers to the packets received in a single wakeup (see 'tftp-s.c
+*                TFTPs_Task()  Note #13'), are NOT handed to the socket at once but added to the batch,
+*                which is sent when it is closed.  Batches may be nested : only the outermost one is sent.
+*                A batch is also sent when it is full, before a packet is added.
+*
+*            (2) Packets are built in the buffer of their session, which is reused for its next packet.
+*                Each packet added is thus copied to a slot of the batch, the size of the largest packet
+*                buffer, along with the address of its client.  The slots are allocated at init.
+*
+*            (3) A batch is sent with the batch transmit function of the configuration, if any, in a single
+*                call to the socket layer of the host (see 'tftp-s_type.h  BATCHED TRANSMISSION DATA
+*                TYPE').  Otherwise, e.g. with the uC/TCP-IP stack, its packets are sent one at a time.
+*                When the network is simulated, packets are always sent one at a time to the simulated
+*                clients (see 'tftp-s_sim.c  Note #1a').
+*
+*            (4) Packets are captured once the batch is sent, so that they are stamped when they reach the
+*                network (see 'tftp-s_capture.c  Note #2').
+*
+*            (5) Batches are only built & sent from the TFTP server task context.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_BATCH_MODULE
+#include  "tftp-s_batch.h"
+#include  "tftp-s_buf.h"
+#include  "tftp-s_capture.h"
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+#include  "tftp-s_sim.h"
+#endif
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_TX_BATCH_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_TX_PKT         *TFTPs_TxBatchTbl;                 /* Pkts of batch.                                       */
+static  NET_SOCK_ADDR        *TFTPs_TxBatchAddrTbl;             /* Client addr of pkts            (see Note #2).        */
+static  CPU_INT08U           *TFTPs_TxBatchListenIxTbl;         /* Listener of pkts               (see Note #4).        */
+static  CPU_INT08U           *TFTPs_TxBatchSlotPtr;             /* Slots of pkts                  (see Note #2).        */
+static  CPU_SIZE_T            TFTPs_TxBatchSlotSize;            /* Size of a slot.                                      */
+static  CPU_INT16U            TFTPs_TxBatchNbrMax;              /* Nbr of slots.                                        */
+static  CPU_INT16U            TFTPs_TxBatchNbr;                 /* Nbr of pkts in batch.                                */
+static  CPU_INT08U            TFTPs_TxBatchNestCtr;             /* Nbr of nested batches open     (see Note #1).        */
+static  TFTPs_TX_BATCH_FNCT   TFTPs_TxBatchFnct;                /* Batch tx fnct                  (see Note #3).        */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TxBatchFlush(void);
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TxBatchInit()
+*
+* Description : Validate the batched transmission configuration & allocate the slots of the batch.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_TX_BATCH
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) The packet buffers MUST be initialized first, so that the slots fit the largest packet.
+*                   Error packets are shorter than the smallest packet buffer.
+*
+*               (2) A batch transmit function requires at least one slot.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TxBatchInit (const  TFTPs_CFG  *p_cfg,
+                                TFTPs_ERR  *p_err)
+{
+    LIB_ERR  err_lib;
+
+
+    TFTPs_TxBatchNbrMax  = 0u;
+    TFTPs_TxBatchNbr     = 0u;
+    TFTPs_TxBatchNestCtr = 0u;
+    TFTPs_TxBatchFnct    = p_cfg->TxBatchFnct;
+    if (p_cfg->TxBatchNbr == 0u) {                              /* No slot : pkts are sent at once.                     */
+        if (p_cfg->TxBatchFnct != DEF_NULL) {                   /* See Note #2.                                         */
+           *p_err = TFTPs_ERR_CFG_INVALID_TX_BATCH;
+            return;
+        }
+       *p_err = TFTPs_ERR_NONE;
+        return;
+    }
+                                                                /* See Note #1.                                         */
+    TFTPs_TxBatchSlotSize = ((CPU_SIZE_T)TFTPs_BufBlkSizeMaxGet() + TFTPs_BUF_HDR_SIZE + sizeof(CPU_INT32U) - 1u)
+                          & ~(sizeof(CPU_INT32U) - 1u);
+
+    TFTPs_TxBatchTbl = (TFTPs_TX_PKT *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Tx Batch Tbl",
+                                                               DEF_NULL,
+                                                   (CPU_SIZE_T)p_cfg->TxBatchNbr * sizeof(TFTPs_TX_PKT),
+                                                              &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_TxBatchAddrTbl = (NET_SOCK_ADDR *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Tx Batch Addr Tbl",
+                                                                    DEF_NULL,
+                                                        (CPU_SIZE_T)p_cfg->TxBatchNbr * sizeof(NET_SOCK_ADDR),
+                                                                   &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_TxBatchListenIxTbl = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Tx Batch Listener Tbl",
+                                                                     DEF_NULL,
+                                                         (CPU_SIZE_T)p_cfg->TxBatchNbr,
+                                                                    &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_TxBatchSlotPtr = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Tx Batch Slots",
+                                                                 DEF_NULL,
+                                                     (CPU_SIZE_T)p_cfg->TxBatchNbr * TFTPs_TxBatchSlotSize,
+                                                                &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_TxBatchNbrMax = p_cfg->TxBatchNbr;
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TxBatchOpen()
+*
+* Description : Open a batch : the packets built until it is closed are sent together.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task(),
+*               TFTPs_WinTx(),
+*               TFTPs_TxSched().
+*
+* Note(s)     : (1) Each call MUST be matched by a call to TFTPs_TxBatchClose() (see Note #1).
+*********************************************************************************************************
+*/
+
+void  TFTPs_TxBatchOpen (void)
+{
+    if (TFTPs_TxBatchNbrMax == 0u) {                            /* Batches disabled.                                    */
+        return;
+    }
+
+    TFTPs_TxBatchNestCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_TxBatchClose()
+*
+* Description : Close a batch, & send its packets if it is the outermost one.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task(),
+*               TFTPs_WinTx(),
+*               TFTPs_TxSched().
+*
+* Note(s)     : (1) See 'tftp-s_batch.c  Note #1'.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TxBatchClose (void)
+{
+    if (TFTPs_TxBatchNestCtr == 0u) {                           /* No batch open.                                       */
+        return;
+    }
+
+    TFTPs_TxBatchNestCtr--;
+    if (TFTPs_TxBatchNestCtr == 0u) {                           /* See Note #1.                                         */
+        TFTPs_TxBatchFlush();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TxBatchAdd()
+*
+* Description : Add a packet to the open batch.
+*
+* Argument(s) : sock_id     Socket to send the packet from.
+*
+*               listen_ix   Index of the listener of the socket.
+*
+*               p_addr      Pointer to socket address of the client.
+*
+*               p_pkt       Pointer to packet.
+*
+*               len         Length of the packet (in octets).
+*
+* Return(s)   : DEF_YES, if the packet was added to the batch.
+*
+*               DEF_NO,  if NO batch is open : the caller MUST send the packet.
+*
+* Caller(s)   : TFTPs_TxPkt().
+*
+* Note(s)     : (1) The packet & the address of its client are copied, so that the session's buffer can be
+*                   reused at once (see 'tftp-s_batch.c  Note #2').
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_TxBatchAdd (       NET_SOCK_ID     sock_id,
+                                      CPU_INT08U      listen_ix,
+                                      NET_SOCK_ADDR  *p_addr,
+                               const  CPU_INT08U     *p_pkt,
+                                      CPU_INT16U      len)
+{
+    TFTPs_TX_PKT  *p_tx_pkt;
+    CPU_INT08U    *p_slot;
+
+
+    if ((TFTPs_TxBatchNestCtr == 0u) ||
+        (len                  >  TFTPs_TxBatchSlotSize)) {
+        return (DEF_NO);
+    }
+
+    if (TFTPs_TxBatchNbr >= TFTPs_TxBatchNbrMax) {              /* Send full batch.                                     */
+        TFTPs_TxBatchFlush();
+    }
+
+    p_slot   = &TFTPs_TxBatchSlotPtr[(CPU_SIZE_T)TFTPs_TxBatchNbr * TFTPs_TxBatchSlotSize];
+    p_tx_pkt = &TFTPs_TxBatchTbl[TFTPs_TxBatchNbr];
+                                                                /* See Note #1.                                         */
+    Mem_Copy(p_slot,                                   p_pkt,  len);
+    Mem_Copy(&TFTPs_TxBatchAddrTbl[TFTPs_TxBatchNbr], p_addr, sizeof(NET_SOCK_ADDR));
+    TFTPs_TxBatchListenIxTbl[TFTPs_TxBatchNbr] = listen_ix;
+
+    p_tx_pkt->SockID  =  sock_id;
+    p_tx_pkt->AddrPtr = &TFTPs_TxBatchAddrTbl[TFTPs_TxBatchNbr];
+    p_tx_pkt->BufPtr  =  p_slot;
+    p_tx_pkt->Len     =  len;
+
+    TFTPs_TxBatchNbr++;
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_TxBatchFlush()
+*
+* Description : Send the packets of the batch.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TxBatchAdd(),
+*               TFTPs_TxBatchClose().
+*
+* Note(s)     : (1) See 'tftp-s_batch.c  Note #3'.  The packets NOT sent are recovered by the retransmission
+*                   timers of their sessions, as packets lost by the network.
+*
+*               (2) See 'tftp-s_batch.c  Note #4'.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TxBatchFlush (void)
+{
+    TFTPs_TX_PKT       *p_tx_pkt;
+    NET_SOCK_RTN_CODE   bytes_sent;
+    CPU_INT16U          nbr_sent;
+    CPU_INT16U          ix;
+#if (TFTPs_CFG_SIM_EN != DEF_ENABLED)
+    NET_ERR             err;
+#endif
+
+
+    if (TFTPs_TxBatchNbr == 0u) {
+        return;
+    }
+
+    nbr_sent = TFTPs_TxBatchNbr;                                /* See Note #1.                                         */
+#if (TFTPs_CFG_SIM_EN != DEF_ENABLED)
+    if (TFTPs_TxBatchFnct != DEF_NULL) {
+        nbr_sent = TFTPs_TxBatchFnct(TFTPs_TxBatchTbl, TFTPs_TxBatchNbr);
+    }
+#endif
+
+    for (ix = 0u; ix < TFTPs_TxBatchNbr; ix++) {
+        p_tx_pkt   = &TFTPs_TxBatchTbl[ix];
+        bytes_sent =  0;
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+        bytes_sent =  TFTPs_SimTx(p_tx_pkt->AddrPtr, p_tx_pkt->BufPtr, p_tx_pkt->Len);
+#else
+        if (TFTPs_TxBatchFnct == DEF_NULL) {
+            bytes_sent = NetSock_TxDataTo((NET_SOCK_ID      ) p_tx_pkt->SockID,
+                                          (void            *) p_tx_pkt->BufPtr,
+                                          (CPU_INT16U       ) p_tx_pkt->Len,
+                                          (CPU_INT16S       ) NET_SOCK_FLAG_NONE,
+                                          (NET_SOCK_ADDR   *) p_tx_pkt->AddrPtr,
+                                          (NET_SOCK_ADDR_LEN) NET_SOCK_ADDR_SIZE,
+                                          (NET_ERR         *)&err);
+        } else if (ix < nbr_sent) {
+            bytes_sent = (NET_SOCK_RTN_CODE)p_tx_pkt->Len;
+        }
+#endif
+#if (TFTPs_CFG_CAPTURE_EN == DEF_ENABLED)
+        if (bytes_sent > 0) {                                   /* See Note #2.                                         */
+            TFTPs_CapturePkt(TFTPs_CAPTURE_DIR_TX,
+                             p_tx_pkt->AddrPtr,
+                             TFTPs_TxBatchListenIxTbl[ix],
+                             p_tx_pkt->BufPtr,
+                             p_tx_pkt->Len);
+        }
+#else
+        (void)&bytes_sent;
+#endif
+    }
+
+    (void)&nbr_sent;
+    TFTPs_TxBatchNbr = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of batch module include.                         */
@@ -0,0 +1,83 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  TFTP SERVER BATCHED TRANSMISSION
+*
+* Filename : tftp-s_batch.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs batch present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_BATCH_MODULE_PRESENT                             /* See Note #1.                                         */
+#define  TFTPs_BATCH_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void         TFTPs_TxBatchInit (const  TFTPs_CFG      *p_cfg,
+                                       TFTPs_ERR      *p_err);
+
+void         TFTPs_TxBatchOpen (       void);
+
+void         TFTPs_TxBatchClose(       void);
+
+CPU_BOOLEAN  TFTPs_TxBatchAdd  (       NET_SOCK_ID     sock_id,
+                                       CPU_INT08U      listen_ix,
+                                       NET_SOCK_ADDR  *p_addr,
+                                const  CPU_INT08U     *p_pkt,
+                                       CPU_INT16U      len);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_BATCH_MODULE_PRESENT  */
@@ -0,0 +1,381 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      TFTP SERVER BUFFER POOLS
+*
+* Filename : tftp-s_buf.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Each buffer size class is a uC/LIB dynamic memory pool whose blocks are ALL allocated by
+*                TFTPs_BufInit() (i.e. initial & maximum number of blocks are equal), so that the RAM used
+*                by the server is fixed at initialization & getting or freeing a buffer is O(1) & never
+*                reaches the general heap.
+*
+*            (2) This module is NOT re-entrant & MUST only be called from the TFTP server task context.
+*
+*            (3) When TFTPs_CFG_BUF_SINGLE_EN is enabled, NO pool is allocated : the server's receive buffer
+*                is the only packet buffer (see 'tftp-s.c  Note #13').  It is lent to the session by
+*                TFTPs_BufGet(), as a buffer of the largest class configured, so that the buffer classes
+*                only set the largest block size granted.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_BUF_MODULE
+#include  "tftp-s_buf.h"
+
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  CPU_INT16U  TFTPs_BufClassBlkSize[TFTPs_BUF_CLASS_NBR] = {
+    512u,
+    1428u,
+    8192u,
+    65464u
+};
+
+#if (TFTPs_CFG_BUF_SINGLE_EN != DEF_ENABLED)
+static  MEM_DYN_POOL  TFTPs_BufPool[TFTPs_BUF_CLASS_NBR];       /* Buf pools, one per size class (see Note #1).         */
+#endif
+static  CPU_INT16U    TFTPs_BufNbrAvail[TFTPs_BUF_CLASS_NBR];   /* Nbr of free bufs, per size class.                    */
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+static  CPU_INT08U   *TFTPs_BufSinglePtr;                       /* Single pkt buf (see Note #3).                        */
+static  CPU_INT08U    TFTPs_BufSingleClass;                     /* Class of single pkt buf.                             */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_BufInit()
+*
+* Description : Allocate the packet buffer pools.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_BUF_NBR
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) At least one buffer class MUST hold buffers.
+*
+*               (2) See 'tftp-s_buf.c  Note #1'.
+*
+*               (3) See 'tftp-s_buf.c  Note #3'.  The single packet buffer is set once the receive buffer
+*                   is allocated (see TFTPs_BufSingleSet()).
+*********************************************************************************************************
+*/
+
+void  TFTPs_BufInit (const  TFTPs_CFG  *p_cfg,
+                            TFTPs_ERR  *p_err)
+{
+    CPU_INT16U  nbr[TFTPs_BUF_CLASS_NBR];
+    CPU_INT08U  ix;
+    LIB_ERR     err_lib;
+
+
+    nbr[TFTPs_BUF_CLASS_512]   = p_cfg->Buf512Nbr;
+    nbr[TFTPs_BUF_CLASS_1428]  = p_cfg->Buf1428Nbr;
+    nbr[TFTPs_BUF_CLASS_8192]  = p_cfg->Buf8192Nbr;
+    nbr[TFTPs_BUF_CLASS_65464] = p_cfg->Buf65464Nbr;
+
+    if ((nbr[TFTPs_BUF_CLASS_512]   == 0u) &&                   /* See Note #1.                                         */
+        (nbr[TFTPs_BUF_CLASS_1428]  == 0u) &&
+        (nbr[TFTPs_BUF_CLASS_8192]  == 0u) &&
+        (nbr[TFTPs_BUF_CLASS_65464] == 0u)) {
+       *p_err = TFTPs_ERR_CFG_INVALID_BUF_NBR;
+        return;
+    }
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    TFTPs_BufSinglePtr = DEF_NULL;                              /* See Note #3.                                         */
+    for (ix = 0u; ix < TFTPs_BUF_CLASS_NBR; ix++) {
+        TFTPs_BufNbrAvail[ix] = 0u;
+        if (nbr[ix] > 0u) {
+            TFTPs_BufSingleClass = ix;
+        }
+    }
+    TFTPs_BufNbrAvail[TFTPs_BufSingleClass] = 1u;
+    (void)&err_lib;
+#else
+    for (ix = 0u; ix < TFTPs_BUF_CLASS_NBR; ix++) {
+        TFTPs_BufNbrAvail[ix] = 0u;
+        if (nbr[ix] == 0u) {
+            continue;
+        }
+                                                                /* Alloc every blk of the pool (see Note #2).           */
+        Mem_DynPoolCreate((CPU_CHAR *)"TFTPs Buf Pool",
+                                     &TFTPs_BufPool[ix],
+                                      DEF_NULL,
+                                      TFTPs_BufClassBlkSize[ix] + TFTPs_BUF_HDR_SIZE,
+                                      sizeof(CPU_ALIGN),
+                                      nbr[ix],
+                                      nbr[ix],
+                                     &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+        TFTPs_BufNbrAvail[ix] = nbr[ix];
+    }
+#endif
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_BufGet()
+*
+* Description : Get a packet buffer able to hold a block of the requested size, or of a smaller size.
+*
+* Argument(s) : blk_size_req    Requested block size, in octets.
+*
+*               fallback_en     Indicate whether a smaller block size MAY be used :
+*
+*                                   DEF_YES     Block size was negotiated (see Note #1).
+*                                   DEF_NO      Block size is fixed   ...
+*
+*               p_blk_size      Pointer to variable that will receive the block size granted.
+*
+*               p_class         Pointer to variable that will receive the class of the buffer.
+*
+* Return(s)   : Pointer to packet buffer, if a buffer is available.
+*
+*               Pointer to NULL,          otherwise.
+*
+* Caller(s)   : TFTPs_ReqStart().
+*
+* Note(s)     : (1) RFC #2348, Section 'Blocksize Option Specification' states that the server MAY reply
+*                   with a block size smaller than the one requested.  When the buffers of the best-fitting
+*                   class are all in use, the request thus falls back to the next smaller class(es).
+*
+*               (2) A fixed size request (i.e. the default block size of RFC #1350) can only use buffers
+*                   of its own class, or of larger classes.
+*
+*               (3) The single packet buffer fits the largest block size granted (see 'tftp-s_buf.c
+*                   Note #3').
+*********************************************************************************************************
+*/
+
+CPU_INT08U  *TFTPs_BufGet (CPU_INT16U    blk_size_req,
+                           CPU_BOOLEAN   fallback_en,
+                           CPU_INT16U   *p_blk_size,
+                           CPU_INT08U   *p_class)
+{
+    CPU_INT08U  *p_buf;
+    CPU_INT08U   ix;
+    CPU_INT08U   ix_fit;
+    LIB_ERR      err_lib;
+
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    ix = TFTPs_BufSingleClass;                                  /* See Note #3.                                         */
+    if (TFTPs_BufNbrAvail[ix] == 0u) {
+        return (DEF_NULL);
+    }
+    p_buf = TFTPs_BufSinglePtr;
+    (void)&fallback_en;
+    (void)&ix_fit;
+    (void)&err_lib;
+#else
+    ix_fit = 0u;                                                /* Find best-fitting class.                             */
+    while ((ix_fit                        < (TFTPs_BUF_CLASS_NBR - 1u)) &&
+           (TFTPs_BufClassBlkSize[ix_fit] <  blk_size_req)) {
+        ix_fit++;
+    }
+
+    ix = ix_fit;
+    while (TFTPs_BufNbrAvail[ix] == 0u) {
+        if (fallback_en == DEF_YES) {                           /* See Note #1.                                         */
+            if (ix == 0u) {
+                return (DEF_NULL);
+            }
+            ix--;
+        } else {                                                /* See Note #2.                                         */
+            ix++;
+            if (ix >= TFTPs_BUF_CLASS_NBR) {
+                return (DEF_NULL);
+            }
+        }
+    }
+
+    p_buf = (CPU_INT08U *)Mem_DynPoolBlkGet(&TFTPs_BufPool[ix], &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+        return (DEF_NULL);
+    }
+#endif
+    TFTPs_BufNbrAvail[ix]--;
+
+    if (blk_size_req > TFTPs_BufClassBlkSize[ix]) {
+        blk_size_req = TFTPs_BufClassBlkSize[ix];
+    }
+   *p_blk_size = blk_size_req;
+   *p_class    = ix;
+
+    return (p_buf);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_BufFree()
+*
+* Description : Return a packet buffer to its pool.
+*
+* Argument(s) : p_buf       Pointer to packet buffer.
+*
+*               class_ix    Class of the buffer, as returned by TFTPs_BufGet().
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Terminate(),
+*               TFTPs_ReqStart().
+*
+* Note(s)     : (1) The single packet buffer is only marked as free (see 'tftp-s_buf.c  Note #3').
+*********************************************************************************************************
+*/
+
+void  TFTPs_BufFree (CPU_INT08U  *p_buf,
+                     CPU_INT08U   class_ix)
+{
+    LIB_ERR  err_lib;
+
+
+    if ((p_buf    == DEF_NULL) ||
+        (class_ix >= TFTPs_BUF_CLASS_NBR)) {
+        return;
+    }
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    TFTPs_BufNbrAvail[class_ix]++;                              /* See Note #1.                                         */
+    (void)&err_lib;
+#else
+    Mem_DynPoolBlkFree(&TFTPs_BufPool[class_ix], p_buf, &err_lib);
+    if (err_lib == LIB_MEM_ERR_NONE) {
+        TFTPs_BufNbrAvail[class_ix]++;
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_BufSingleSet()
+*
+* Description : Set the single packet buffer.
+*
+* Argument(s) : p_buf       Pointer to receive buffer of the server.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) See 'tftp-s_buf.c  Note #3'.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+void  TFTPs_BufSingleSet (CPU_INT08U  *p_buf)
+{
+    TFTPs_BufSinglePtr = p_buf;                                 /* See Note #1.                                         */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_BufBlkSizeMaxGet()
+*
+* Description : Get the largest block size of the configured buffer classes.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Largest block size, in octets.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) The receive buffer MUST be large enough for the largest block a session can negotiate.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_BufBlkSizeMaxGet (void)
+{
+    CPU_INT08U  ix;
+
+
+    ix = TFTPs_BUF_CLASS_NBR;
+    while (ix > 1u) {
+        ix--;
+        if (TFTPs_BufNbrAvail[ix] > 0u) {
+            return (TFTPs_BufClassBlkSize[ix]);
+        }
+    }
+
+    return (TFTPs_BufClassBlkSize[0]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_BufNbrAvailGet()
+*
+* Description : Get the number of free buffers of a class.
+*
+* Argument(s) : class_ix    Buffer class.
+*
+* Return(s)   : Number of free buffers.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  TFTPs_BufNbrAvailGet (CPU_INT08U  class_ix)
+{
+    if (class_ix >= TFTPs_BUF_CLASS_NBR) {
+        return (0u);
+    }
+
+    return (TFTPs_BufNbrAvail[class_ix]);
+}
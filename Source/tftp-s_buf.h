@@ -0,0 +1,121 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      TFTP SERVER BUFFER POOLS
+*
+* Filename : tftp-s_buf.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs buffer present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_BUF_MODULE_PRESENT                               /* See Note #1.                                         */
+#define  TFTPs_BUF_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*
+* Note(s) : (1) Packet buffers are pooled in TFTPs_BUF_CLASS_NBR size classes, each one holding a block of
+*               the class size plus the TFTP opcode & block number header :
+*
+*                   (a) TFTPs_BUF_CLASS_512       RFC #1350 default block size.
+*                   (b) TFTPs_BUF_CLASS_1428      Largest block fitting an Ethernet frame (IPv4 & IPv6).
+*                   (c) TFTPs_BUF_CLASS_8192      Largest block size suggested by RFC #2348.
+*                   (d) TFTPs_BUF_CLASS_65464     Largest block size allowed  by RFC #2348.
+*
+*           (2) The hdr of a DATA pkt holds the opcode & the block number, 2 octets each.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_BUF_CLASS_512                               0u   /* See Note #1.                                         */
+#define  TFTPs_BUF_CLASS_1428                              1u
+#define  TFTPs_BUF_CLASS_8192                              2u
+#define  TFTPs_BUF_CLASS_65464                             3u
+#define  TFTPs_BUF_CLASS_NBR                               4u
+#define  TFTPs_BUF_CLASS_NONE                           0xFFu
+
+#define  TFTPs_BUF_BLK_SIZE_DFLT                         512u
+#define  TFTPs_BUF_BLK_SIZE_MIN                            8u   /* Min blk size allowed by RFC #2348.                   */
+#define  TFTPs_BUF_BLK_SIZE_MAX                        65464u
+
+#define  TFTPs_BUF_HDR_SIZE                                4u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void         TFTPs_BufInit         (const  TFTPs_CFG     *p_cfg,
+                                           TFTPs_ERR     *p_err);
+
+CPU_INT08U  *TFTPs_BufGet          (CPU_INT16U     blk_size_req,
+                                    CPU_BOOLEAN    fallback_en,
+                                    CPU_INT16U    *p_blk_size,
+                                    CPU_INT08U    *p_class);
+
+void         TFTPs_BufFree         (CPU_INT08U    *p_buf,
+                                    CPU_INT08U     class_ix);
+
+CPU_INT32U   TFTPs_BufBlkSizeMaxGet(void);
+
+CPU_INT16U   TFTPs_BufNbrAvailGet  (CPU_INT08U     class_ix);
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+void         TFTPs_BufSingleSet    (CPU_INT08U    *p_buf);
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_BUF_MODULE_PRESENT  */
@@ -0,0 +1,780 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     TFTP SERVER PACKET CAPTURE
+*
+* Filename : tftp-s_capture.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The packets received & sent by the server are captured in a ring of 'CaptureNbr' slots,
+*                each holding the first 'CaptureSnapLen' octets of a packet with its time stamp & the
+*                addresses it was exchanged between.  Once the ring is full, the oldest packets are
+*                replaced.
+*
+*            (2) Packets are captured as they are received, before the address filter, & as they are
+*                handed to the socket (see 'tftp-s.c  TFTPs_TxPkt()'), so that retransmissions & packets
+*                deferred by the shaper are stamped when they reach the network.  Only the packets of the
+*                clients selected by the capture filter are captured (see TFTPs_CaptureFiltSet()).
+*
+*            (3) The ring is exported as a pcap file of raw IP packets (link type LINKTYPE_RAW), the IP &
+*                UDP headers of each packet being built from its addresses (see TFTPs_CaptureExport()).
+*
+*            (4) Packets are stamped in microseconds by the CPU timestamp timer when 64-bit timestamps are
+*                enabled in uC/CPU, & in milliseconds by the network time otherwise.  When the network is
+*                simulated, packets are stamped by the virtual clock (see 'tftp-s_sim.c  Note #1b').
+*
+*            (5) The ring is written from the TFTP server task context only, & MAY be exported from any
+*                task.  Packets handed while the ring is exported are NOT captured.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_CAPTURE_MODULE
+#include  "tftp-s_capture.h"
+#include  "tftp-s_listen.h"
+#include  "tftp-s_sess.h"
+#include  "tftp-s_tmr.h"
+#include  <Source/net_util.h>
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_CAPTURE_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CAPTURE_SNAP_LEN_MIN                        4u   /* Opcode & blk nbr.                                    */
+
+#define  TFTPs_CAPTURE_ADDR_LEN_IPv4                       4u
+#define  TFTPs_CAPTURE_ADDR_LEN_IPv6                      16u
+
+#define  TFTPs_CAPTURE_PCAP_MAGIC                 0xA1B2C3D4u   /* pcap file with time stamps in us.                    */
+#define  TFTPs_CAPTURE_PCAP_VER_MAJOR                      2u
+#define  TFTPs_CAPTURE_PCAP_VER_MINOR                      4u
+#define  TFTPs_CAPTURE_PCAP_LINKTYPE_RAW                 101u   /* Pkts start with their IPv4 or IPv6 hdr.              */
+#define  TFTPs_CAPTURE_PCAP_HDR_LEN                       24u   /* Len of pcap file hdr.                                */
+#define  TFTPs_CAPTURE_PCAP_REC_HDR_LEN                   16u   /* Len of pcap pkt hdr.                                 */
+
+#define  TFTPs_CAPTURE_IPv4_HDR_LEN                       20u
+#define  TFTPs_CAPTURE_IPv6_HDR_LEN                       40u
+#define  TFTPs_CAPTURE_UDP_HDR_LEN                         8u
+#define  TFTPs_CAPTURE_IP_TTL                             64u
+#define  TFTPs_CAPTURE_IP_PROTOCOL_UDP                    17u
+#define  TFTPs_CAPTURE_IPv4_FLAG_DF                   0x4000u   /* Don't fragment.                                      */
+                                                                /* Len of largest hdrs built per pkt.                   */
+#define  TFTPs_CAPTURE_HDR_LEN_MAX               (TFTPs_CAPTURE_PCAP_REC_HDR_LEN + \
+                                                  TFTPs_CAPTURE_IPv6_HDR_LEN     + \
+                                                  TFTPs_CAPTURE_UDP_HDR_LEN)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U          *TFTPs_CaptureRingPtr;              /* Slots of captured pkts (see Note #1).                */
+static  CPU_SIZE_T           TFTPs_CaptureSlotSize;             /* Size of a slot.                                      */
+static  CPU_INT16U           TFTPs_CaptureNbr;                  /* Nbr of slots.                                        */
+static  CPU_INT16U           TFTPs_CaptureSnapLen;              /* Max len of pkts captured.                            */
+static  CPU_INT16U           TFTPs_CaptureHeadIx;               /* Next slot written.                                   */
+static  CPU_INT16U           TFTPs_CaptureNbrUsed;              /* Nbr of slots holding a pkt.                          */
+static  CPU_BOOLEAN          TFTPs_CaptureWrActive;             /* Slot being written (see Note #5).                    */
+static  CPU_BOOLEAN          TFTPs_CaptureExportActive;         /* Ring being exported (see Note #5).                   */
+static  TFTPs_CAPTURE_FILT   TFTPs_CaptureFilt;                 /* Capture filter (see Note #2).                        */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN         TFTPs_CaptureFiltMatch(const  TFTPs_SESS_KEY     *p_key);
+
+static  TFTPs_CAPTURE_PKT  *TFTPs_CaptureSlotGet  (       CPU_INT16U          ix);
+
+static  void                TFTPs_CaptureTS_Get   (       CPU_INT32U         *p_sec,
+                                                          CPU_INT32U         *p_usec);
+
+static  CPU_INT16U          TFTPs_CaptureHdrBuild (const  TFTPs_CAPTURE_PKT  *p_pkt,
+                                                          CPU_INT16U          id,
+                                                          CPU_INT08U         *p_buf);
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_CaptureInit()
+*
+* Description : Validate the packet capture configuration & allocate the capture ring.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_CAPTURE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) Each slot holds a captured packet & its first 'CaptureSnapLen' octets, rounded up so that
+*                   the next slot is aligned.
+*
+*               (2) The packets of all clients are captured until a filter is set.
+*********************************************************************************************************
+*/
+
+void  TFTPs_CaptureInit (const  TFTPs_CFG  *p_cfg,
+                                TFTPs_ERR  *p_err)
+{
+    CPU_SIZE_T  snap_size;
+    LIB_ERR     err_lib;
+
+
+    TFTPs_CaptureNbr          = 0u;
+    TFTPs_CaptureSnapLen      = p_cfg->CaptureSnapLen;
+    TFTPs_CaptureHeadIx       = 0u;
+    TFTPs_CaptureNbrUsed      = 0u;
+    TFTPs_CaptureWrActive     = DEF_NO;
+    TFTPs_CaptureExportActive = DEF_NO;
+    Mem_Clr(&TFTPs_CaptureFilt, sizeof(TFTPs_CaptureFilt));
+    TFTPs_CaptureFilt.Family  = TFTPs_CLASS_FAMILY_ANY;         /* See Note #2.                                         */
+    if (p_cfg->CaptureNbr == 0u) {                              /* No slot : pkts are never captured.                   */
+       *p_err = TFTPs_ERR_NONE;
+        return;
+    }
+
+    if (p_cfg->CaptureSnapLen < TFTPs_CAPTURE_SNAP_LEN_MIN) {
+       *p_err = TFTPs_ERR_CFG_INVALID_CAPTURE;
+        return;
+    }
+
+                                                                /* See Note #1.                                         */
+    snap_size             = ((CPU_SIZE_T)p_cfg->CaptureSnapLen + sizeof(CPU_INT32U) - 1u) & ~(sizeof(CPU_INT32U) - 1u);
+    TFTPs_CaptureSlotSize =   sizeof(TFTPs_CAPTURE_PKT) + snap_size;
+
+    TFTPs_CaptureRingPtr = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Capture Ring",
+                                                                  DEF_NULL,
+                                                      (CPU_SIZE_T)p_cfg->CaptureNbr * TFTPs_CaptureSlotSize,
+                                                                 &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_CaptureNbr = p_cfg->CaptureNbr;
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_CaptureFiltSet()
+*
+* Description : Select the packets captured by client.
+*
+* Argument(s) : p_filt      Pointer to capture filter (see 'tftp-s_type.h  PACKET CAPTURE FILTER DATA TYPE'),
+*                           or DEF_NULL to capture the packets of all clients.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_INVALID_FAMILY
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The packets already captured are kept.  Call TFTPs_CaptureClr() to capture the packets of
+*                   the new filter only.
+*********************************************************************************************************
+*/
+
+void  TFTPs_CaptureFiltSet (const  TFTPs_CAPTURE_FILT  *p_filt,
+                                   TFTPs_ERR           *p_err)
+{
+    TFTPs_CAPTURE_FILT  filt;
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+#endif
+
+    Mem_Clr(&filt, sizeof(filt));
+    filt.Family = TFTPs_CLASS_FAMILY_ANY;
+    if (p_filt != DEF_NULL) {
+        switch (p_filt->Family) {
+            case TFTPs_CLASS_FAMILY_ANY:
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv4:
+            case TFTPs_CLASS_FAMILY_IPv6:
+                 filt      = *p_filt;
+                 filt.Port =  NET_UTIL_HOST_TO_NET_16(p_filt->Port);
+                 break;
+
+            default:
+                *p_err = TFTPs_ERR_INVALID_FAMILY;
+                 return;
+        }
+    }
+
+    CPU_CRITICAL_ENTER();
+    TFTPs_CaptureFilt = filt;
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_CaptureClr()
+*
+* Description : Drop the packets captured.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The slot being written, if any, is kept : it is committed once written (see
+*                   TFTPs_CapturePkt()).
+*********************************************************************************************************
+*/
+
+void  TFTPs_CaptureClr (TFTPs_ERR  *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    TFTPs_CaptureNbrUsed = 0u;
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_CaptureExport()
+*
+* Description : Export the packets captured as a pcap file.
+*
+* Argument(s) : wr_fnct     Function called with each part of the file in turn (see 'tftp-s_type.h  PACKET
+*                           CAPTURE FILTER DATA TYPE  Note #2').
+*
+*               p_arg       Argument passed to 'wr_fnct'.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_NULL_PTR
+*                               TFTPs_ERR_CAPTURE_BUSY
+*                               TFTPs_ERR_CAPTURE_WR
+*
+* Return(s)   : Number of packets exported, if NO error.
+*
+*               0,                          otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The file holds the packets captured when the export starts, oldest first, the packets
+*                   captured meanwhile being dropped (see 'tftp-s_capture.c  Note #5').  The slot being
+*                   written, if any, is NOT exported.
+*
+*               (2) The pcap file header & the packet headers are written in host order, as the pcap format
+*                   requires; readers detect the order from the magic number.
+*
+*               (3) Each packet is written as a pcap packet header & the IP & UDP headers built for it, then
+*                   as its captured octets.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_CaptureExport (TFTPs_CAPTURE_WR_FNCT   wr_fnct,
+                                 void                   *p_arg,
+                                 TFTPs_ERR              *p_err)
+{
+    CPU_INT08U          hdr_buf[TFTPs_CAPTURE_HDR_LEN_MAX];
+    TFTPs_CAPTURE_PKT  *p_pkt;
+    CPU_INT16U          head_ix;
+    CPU_INT16U          nbr;
+    CPU_INT16U          ix;
+    CPU_INT16U          i;
+    CPU_INT16U          hdr_len;
+    CPU_INT32U          snap_len_max;
+    CPU_BOOLEAN         ok;
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(0u);
+    }
+
+    if (wr_fnct == DEF_NULL) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    if (TFTPs_CaptureExportActive == DEF_YES) {
+        CPU_CRITICAL_EXIT();
+       *p_err = TFTPs_ERR_CAPTURE_BUSY;
+        return (0u);
+    }
+    TFTPs_CaptureExportActive = DEF_YES;
+    head_ix = TFTPs_CaptureHeadIx;
+    nbr     = TFTPs_CaptureNbrUsed;
+    if ((TFTPs_CaptureWrActive == DEF_YES) &&                   /* Oldest slot being overwritten.                       */
+        (nbr                   == TFTPs_CaptureNbr)) {
+        nbr--;
+    }
+    CPU_CRITICAL_EXIT();
+
+    snap_len_max = (CPU_INT32U)TFTPs_CaptureSnapLen + TFTPs_CAPTURE_IPv6_HDR_LEN + TFTPs_CAPTURE_UDP_HDR_LEN;
+
+                                                                /* ------------------- WR FILE HDR -------------------- */
+                                                                /* See Note #2.                                         */
+    NET_UTIL_VAL_SET_HOST_32(&hdr_buf[ 0], TFTPs_CAPTURE_PCAP_MAGIC);
+    NET_UTIL_VAL_SET_HOST_16(&hdr_buf[ 4], TFTPs_CAPTURE_PCAP_VER_MAJOR);
+    NET_UTIL_VAL_SET_HOST_16(&hdr_buf[ 6], TFTPs_CAPTURE_PCAP_VER_MINOR);
+    NET_UTIL_VAL_SET_HOST_32(&hdr_buf[ 8], 0u);                 /* Time stamps in UTC.                                  */
+    NET_UTIL_VAL_SET_HOST_32(&hdr_buf[12], 0u);
+    NET_UTIL_VAL_SET_HOST_32(&hdr_buf[16], snap_len_max);
+    NET_UTIL_VAL_SET_HOST_32(&hdr_buf[20], TFTPs_CAPTURE_PCAP_LINKTYPE_RAW);
+    ok = wr_fnct(p_arg, &hdr_buf[0], TFTPs_CAPTURE_PCAP_HDR_LEN);
+
+                                                                /* --------------------- WR PKTS ---------------------- */
+    ix = 0u;
+    if (nbr > 0u) {                                             /* Oldest pkt exported first.                           */
+        ix = (CPU_INT16U)((head_ix + TFTPs_CaptureNbr - nbr) % TFTPs_CaptureNbr);
+    }
+    for (i = 0u; (i < nbr) && (ok == DEF_OK); i++) {
+        p_pkt   = TFTPs_CaptureSlotGet(ix);
+        hdr_len = TFTPs_CaptureHdrBuild(p_pkt, i, &hdr_buf[0]); /* See Note #3.                                         */
+        ok      = wr_fnct(p_arg, &hdr_buf[0], hdr_len);
+        if (ok == DEF_OK) {
+            ok  = wr_fnct(p_arg, (CPU_INT08U *)(p_pkt + 1), p_pkt->CapLen);
+        }
+        ix = (CPU_INT16U)((ix + 1u) % TFTPs_CaptureNbr);
+    }
+
+    CPU_CRITICAL_ENTER();
+    TFTPs_CaptureExportActive = DEF_NO;
+    CPU_CRITICAL_EXIT();
+
+    if (ok != DEF_OK) {
+       *p_err = TFTPs_ERR_CAPTURE_WR;
+        return (0u);
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+
+    return (nbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_CapturePkt()
+*
+* Description : Capture a packet received from or sent to a client.
+*
+* Argument(s) : dir         Direction of the packet :
+*
+*                               TFTPs_CAPTURE_DIR_RX    Packet received from the client.
+*                               TFTPs_CAPTURE_DIR_TX    Packet sent     to   the client.
+*
+*               p_addr      Pointer to socket address of the client.
+*
+*               listen_ix   Index of the listener of the server socket the packet was exchanged on.
+*
+*               p_pkt       Pointer to TFTP packet.
+*
+*               len         Length of the TFTP packet (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task(),
+*               TFTPs_TxPkt().
+*
+* Note(s)     : (1) The slot is written outside of any critical section, while flagged as being written, &
+*                   is only committed to the ring once written (see 'tftp-s_capture.c  Note #5').
+*********************************************************************************************************
+*/
+
+void  TFTPs_CapturePkt (       CPU_INT08U      dir,
+                               NET_SOCK_ADDR  *p_addr,
+                               CPU_INT08U      listen_ix,
+                        const  CPU_INT08U     *p_pkt,
+                               CPU_INT16U      len)
+{
+    const  TFTPs_LISTEN_CFG   *p_listen_cfg;
+           TFTPs_CAPTURE_PKT  *p_cap;
+           TFTPs_SESS_KEY      key;
+           CPU_BOOLEAN         ok;
+           CPU_BOOLEAN         match;
+    CPU_SR_ALLOC();
+
+
+    if (TFTPs_CaptureNbr == 0u) {
+        return;
+    }
+
+    ok = TFTPs_SessKeyGet(p_addr, &key);
+    if (ok != DEF_OK) {
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    match = TFTPs_CaptureFiltMatch(&key);
+    if ((match                     != DEF_YES) ||
+        (TFTPs_CaptureExportActive == DEF_YES)) {
+        CPU_CRITICAL_EXIT();
+        return;
+    }
+    TFTPs_CaptureWrActive = DEF_YES;                            /* See Note #1.                                         */
+    CPU_CRITICAL_EXIT();
+
+    p_cap        = TFTPs_CaptureSlotGet(TFTPs_CaptureHeadIx);
+    p_listen_cfg = TFTPs_ListenCfgGet(listen_ix);
+
+    TFTPs_CaptureTS_Get(&p_cap->TS_Sec, &p_cap->TS_uSec);
+    Mem_Copy(&p_cap->ClientAddr[0], &key.Addr[0],           sizeof(p_cap->ClientAddr));
+    Mem_Copy(&p_cap->ServerAddr[0], &p_listen_cfg->Addr[0], sizeof(p_cap->ServerAddr));
+    p_cap->ClientPort = key.Port;
+    p_cap->ServerPort = p_listen_cfg->Port;
+    p_cap->Family     = key.Family;
+    p_cap->Len        = len;
+    p_cap->CapLen     = DEF_MIN(len, TFTPs_CaptureSnapLen);
+    p_cap->Dir        = dir;
+    Mem_Copy((CPU_INT08U *)(p_cap + 1), p_pkt, p_cap->CapLen);
+
+    CPU_CRITICAL_ENTER();
+    TFTPs_CaptureHeadIx = (CPU_INT16U)((TFTPs_CaptureHeadIx + 1u) % TFTPs_CaptureNbr);
+    if (TFTPs_CaptureNbrUsed < TFTPs_CaptureNbr) {              /* Oldest pkt replaced once ring full.                  */
+        TFTPs_CaptureNbrUsed++;
+    }
+    TFTPs_CaptureWrActive = DEF_NO;
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_CaptureFiltMatch()
+*
+* Description : Check whether the packets of a client are captured.
+*
+* Argument(s) : p_key       Pointer to session key of the client.
+*
+* Return(s)   : DEF_YES, if the client matches the capture filter.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_CapturePkt().
+*
+* Note(s)     : (1) MUST be called with interrupts disabled, as the filter MAY be set by the application.
+*
+*               (2) See 'tftp-s_type.h  PACKET CAPTURE FILTER DATA TYPE  Note #1'.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_CaptureFiltMatch (const  TFTPs_SESS_KEY  *p_key)
+{
+    CPU_SIZE_T   addr_len;
+    CPU_BOOLEAN  same;
+
+
+    switch (TFTPs_CaptureFilt.Family) {                         /* See Note #2.                                         */
+        case TFTPs_CLASS_FAMILY_IPv4:
+             if (p_key->Family != NET_SOCK_ADDR_FAMILY_IP_V4) {
+                 return (DEF_NO);
+             }
+             addr_len = TFTPs_CAPTURE_ADDR_LEN_IPv4;
+             break;
+
+        case TFTPs_CLASS_FAMILY_IPv6:
+             if (p_key->Family != NET_SOCK_ADDR_FAMILY_IP_V6) {
+                 return (DEF_NO);
+             }
+             addr_len = TFTPs_CAPTURE_ADDR_LEN_IPv6;
+             break;
+
+        case TFTPs_CLASS_FAMILY_ANY:
+        default:
+             return (DEF_YES);
+    }
+
+    same = Mem_Cmp(&TFTPs_CaptureFilt.Addr[0], &p_key->Addr[0], addr_len);
+    if (same != DEF_YES) {
+        return (DEF_NO);
+    }
+
+    if ((TFTPs_CaptureFilt.Port != 0u) &&
+        (TFTPs_CaptureFilt.Port != p_key->Port)) {
+        return (DEF_NO);
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_CaptureSlotGet()
+*
+* Description : Get a slot of the capture ring.
+*
+* Argument(s) : ix          Index of the slot.
+*
+* Return(s)   : Pointer to the captured packet of the slot.
+*
+* Caller(s)   : TFTPs_CaptureExport(),
+*               TFTPs_CapturePkt().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  TFTPs_CAPTURE_PKT  *TFTPs_CaptureSlotGet (CPU_INT16U  ix)
+{
+    return ((TFTPs_CAPTURE_PKT *)&TFTPs_CaptureRingPtr[(CPU_SIZE_T)ix * TFTPs_CaptureSlotSize]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_CaptureTS_Get()
+*
+* Description : Get the time stamp of a captured packet.
+*
+* Argument(s) : p_sec       Pointer to variable that will receive the seconds of the time stamp.
+*
+*               p_usec      Pointer to variable that will receive the microseconds within the second.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_CapturePkt().
+*
+* Note(s)     : (1) See 'tftp-s_capture.c  Note #4'.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_CaptureTS_Get (CPU_INT32U  *p_sec,
+                                   CPU_INT32U  *p_usec)
+{
+#if ((CPU_CFG_TS_64_EN  == DEF_ENABLED) && \
+     (CPU_CFG_TS_TMR_EN == DEF_ENABLED) && \
+     (TFTPs_CFG_SIM_EN  != DEF_ENABLED))
+    CPU_INT64U  ts_us;
+
+
+    ts_us   = CPU_TS64_to_uSec(CPU_TS_Get64());                 /* See Note #1.                                         */
+   *p_sec   = (CPU_INT32U)(ts_us / DEF_TIME_NBR_uS_PER_SEC);
+   *p_usec  = (CPU_INT32U)(ts_us % DEF_TIME_NBR_uS_PER_SEC);
+#else
+    CPU_INT32U  ts_ms;
+
+
+    ts_ms   = TFTPs_TmrNowGet();                                /* See Note #1.                                         */
+   *p_sec   =  ts_ms / DEF_TIME_NBR_mS_PER_SEC;
+   *p_usec  = (ts_ms % DEF_TIME_NBR_mS_PER_SEC) * (DEF_TIME_NBR_uS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_CaptureHdrBuild()
+*
+* Description : Build the pcap packet header & the IP & UDP headers of a captured packet.
+*
+* Argument(s) : p_pkt       Pointer to captured packet.
+*
+*               id          Identification of the IPv4 header.
+*
+*               p_buf       Pointer to buffer that will receive the headers, of TFTPs_CAPTURE_HDR_LEN_MAX octets.
+*
+* Return(s)   : Length of the headers built (in octets).
+*
+* Caller(s)   : TFTPs_CaptureExport().
+*
+* Note(s)     : (1) The packets received are from the client to the listener, the packets sent from the
+*                   listener to the client.  The address of a listener bound to any address is the
+*                   unspecified address.
+*
+*               (2) The UDP checksum is NOT computed, as the packet MAY NOT be captured whole : it is null,
+*                   i.e. NOT present, for IPv4, & MUST NOT be checked for IPv6.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPs_CaptureHdrBuild (const  TFTPs_CAPTURE_PKT  *p_pkt,
+                                                  CPU_INT16U          id,
+                                                  CPU_INT08U         *p_buf)
+{
+    const  CPU_INT08U  *p_addr_src;
+    const  CPU_INT08U  *p_addr_dst;
+           CPU_INT08U  *p_ip;
+           CPU_INT08U  *p_udp;
+           CPU_INT16U   port_src;
+           CPU_INT16U   port_dst;
+           CPU_INT16U   ip_hdr_len;
+           CPU_INT16U   udp_len;
+           CPU_INT32U   chk_sum;
+           CPU_INT16U   i;
+
+
+    if (p_pkt->Dir == TFTPs_CAPTURE_DIR_RX) {                   /* See Note #1.                                         */
+        p_addr_src = &p_pkt->ClientAddr[0];
+        p_addr_dst = &p_pkt->ServerAddr[0];
+        port_src   =  NET_UTIL_NET_TO_HOST_16(p_pkt->ClientPort);
+        port_dst   =  p_pkt->ServerPort;
+    } else {
+        p_addr_src = &p_pkt->ServerAddr[0];
+        p_addr_dst = &p_pkt->ClientAddr[0];
+        port_src   =  p_pkt->ServerPort;
+        port_dst   =  NET_UTIL_NET_TO_HOST_16(p_pkt->ClientPort);
+    }
+
+    p_ip    = &p_buf[TFTPs_CAPTURE_PCAP_REC_HDR_LEN];
+    udp_len = (CPU_INT16U)(TFTPs_CAPTURE_UDP_HDR_LEN + p_pkt->Len);
+                                                                /* ---------------------- IP HDR ---------------------- */
+    if (p_pkt->Family == NET_SOCK_ADDR_FAMILY_IP_V4) {
+        ip_hdr_len = TFTPs_CAPTURE_IPv4_HDR_LEN;
+        p_ip[0]    = 0x45u;                                     /* Version 4, hdr len of 5 words.                       */
+        p_ip[1]    = 0u;
+        NET_UTIL_VAL_SET_NET_16(&p_ip[2], ip_hdr_len + udp_len);
+        NET_UTIL_VAL_SET_NET_16(&p_ip[4], id);
+        NET_UTIL_VAL_SET_NET_16(&p_ip[6], TFTPs_CAPTURE_IPv4_FLAG_DF);
+        p_ip[8]    = TFTPs_CAPTURE_IP_TTL;
+        p_ip[9]    = TFTPs_CAPTURE_IP_PROTOCOL_UDP;
+        NET_UTIL_VAL_SET_NET_16(&p_ip[10], 0u);
+        Mem_Copy(&p_ip[12], p_addr_src, TFTPs_CAPTURE_ADDR_LEN_IPv4);
+        Mem_Copy(&p_ip[16], p_addr_dst, TFTPs_CAPTURE_ADDR_LEN_IPv4);
+
+        chk_sum = 0u;                                           /* Hdr chk sum (see RFC #791).                          */
+        for (i = 0u; i < TFTPs_CAPTURE_IPv4_HDR_LEN; i += 2u) {
+            chk_sum += ((CPU_INT32U)p_ip[i] << 8u) | p_ip[i + 1u];
+        }
+        while ((chk_sum >> 16u) != 0u) {
+            chk_sum = (chk_sum & DEF_INT_16U_MAX_VAL) + (chk_sum >> 16u);
+        }
+        NET_UTIL_VAL_SET_NET_16(&p_ip[10], (CPU_INT16U)~chk_sum);
+
+    } else {
+        ip_hdr_len = TFTPs_CAPTURE_IPv6_HDR_LEN;
+        p_ip[0]    = 0x60u;                                     /* Version 6, NO traffic class & flow label.            */
+        p_ip[1]    = 0u;
+        p_ip[2]    = 0u;
+        p_ip[3]    = 0u;
+        NET_UTIL_VAL_SET_NET_16(&p_ip[4], udp_len);
+        p_ip[6]    = TFTPs_CAPTURE_IP_PROTOCOL_UDP;
+        p_ip[7]    = TFTPs_CAPTURE_IP_TTL;
+        Mem_Copy(&p_ip[ 8], p_addr_src, TFTPs_CAPTURE_ADDR_LEN_IPv6);
+        Mem_Copy(&p_ip[24], p_addr_dst, TFTPs_CAPTURE_ADDR_LEN_IPv6);
+    }
+                                                                /* --------------------- UDP HDR ---------------------- */
+    p_udp = &p_ip[ip_hdr_len];
+    NET_UTIL_VAL_SET_NET_16(&p_udp[0], port_src);
+    NET_UTIL_VAL_SET_NET_16(&p_udp[2], port_dst);
+    NET_UTIL_VAL_SET_NET_16(&p_udp[4], udp_len);
+    NET_UTIL_VAL_SET_NET_16(&p_udp[6], 0u);                     /* See Note #2.                                         */
+
+                                                                /* ------------------ PCAP PKT HDR -------------------- */
+    NET_UTIL_VAL_SET_HOST_32(&p_buf[ 0], p_pkt->TS_Sec);
+    NET_UTIL_VAL_SET_HOST_32(&p_buf[ 4], p_pkt->TS_uSec);
+    NET_UTIL_VAL_SET_HOST_32(&p_buf[ 8], (CPU_INT32U)ip_hdr_len + TFTPs_CAPTURE_UDP_HDR_LEN + p_pkt->CapLen);
+    NET_UTIL_VAL_SET_HOST_32(&p_buf[12], (CPU_INT32U)ip_hdr_len + udp_len);
+
+    return ((CPU_INT16U)(TFTPs_CAPTURE_PCAP_REC_HDR_LEN + ip_hdr_len + TFTPs_CAPTURE_UDP_HDR_LEN));
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of capture module include.                       */
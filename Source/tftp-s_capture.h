@@ -0,0 +1,126 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     TFTP SERVER PACKET CAPTURE
+*
+* Filename : tftp-s_capture.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs capture present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_CAPTURE_MODULE_PRESENT                           /* See Note #1.                                         */
+#define  TFTPs_CAPTURE_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CAPTURE_DIR_RX                              0u   /* Pkt rx'd from client.                                */
+#define  TFTPs_CAPTURE_DIR_TX                              1u   /* Pkt sent to client.                                  */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      CAPTURED PACKET DATA TYPE
+*
+* Note(s) : (1) Each slot of the capture ring holds a captured packet, followed by its first 'CapLen'
+*               octets (see 'tftp-s_capture.c  Note #1').
+*
+*           (2) Addresses are kept in network order, the IPv4 addresses in the first 4 octets.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_CAPTURE_EN == DEF_ENABLED)
+typedef  struct  tftps_capture_pkt {
+    CPU_INT32U         TS_Sec;                                  /* Time stamp (s).                                      */
+    CPU_INT32U         TS_uSec;                                 /* Time stamp (us) within the second.                   */
+    CPU_INT08U         ClientAddr[16];                          /* Client addr                    (see Note #2).        */
+    CPU_INT08U         ServerAddr[16];                          /* Local addr of listener         (see Note #2).        */
+    CPU_INT16U         ClientPort;                              /* Client port, network order.                          */
+    CPU_INT16U         ServerPort;                              /* Local port of listener.                              */
+    CPU_INT16U         Family;                                  /* Client addr family.                                  */
+    CPU_INT16U         Len;                                     /* Len of TFTP pkt.                                     */
+    CPU_INT16U         CapLen;                                  /* Len of TFTP pkt kept           (see Note #1).        */
+    CPU_INT08U         Dir;                                     /* TFTPs_CAPTURE_DIR_xx.                                */
+} TFTPs_CAPTURE_PKT;
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void  TFTPs_CaptureInit(const  TFTPs_CFG      *p_cfg,
+                               TFTPs_ERR      *p_err);
+
+void  TFTPs_CapturePkt (       CPU_INT08U      dir,
+                               NET_SOCK_ADDR  *p_addr,
+                               CPU_INT08U      listen_ix,
+                        const  CPU_INT08U     *p_pkt,
+                               CPU_INT16U      len);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_CAPTURE_MODULE_PRESENT  */
@@ -0,0 +1,431 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER TRAFFIC CLASSES
+*
+* Filename : tftp-s_class.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Traffic classes give critical transfers (e.g. recovery images) capacity that bulk transfers
+*                can NOT take from them :
+*
+*                (a) Reserved sessions, see 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION DATA TYPE  Note #4'.
+*                (b) Bandwidth caps,    see 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION DATA TYPE  Note #5'.
+*                (c) Request priority : new requests are parsed in class table order (see 'tftp-s.c').
+*
+*            (2) This module is NOT re-entrant & MUST only be called from the TFTP server task context.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_CLASS_MODULE
+#include  "tftp-s_class.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  TFTPs_CLASS_CFG  *TFTPs_ClassTblPtr;             /* Class tbl.                                           */
+static         CPU_INT08U        TFTPs_ClassNbr;                /* Nbr of classes in tbl.                               */
+
+static         CPU_INT16U        TFTPs_ClassSessNbr[TFTPs_CLASS_NBR_MAX + 1u];  /* Active sess, per class.           */
+static         CPU_INT16U        TFTPs_ClassSessNbrTot;         /* Active sess, all classes.                            */
+static         CPU_INT16U        TFTPs_ClassSessNbrMax;         /* Max nbr of sess.                                     */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_ClassSubnetMatch(const  TFTPs_CLASS_CFG  *p_class,
+                                                   TFTPs_SESS_KEY   *p_key);
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_ClassInit()
+*
+* Description : Validate the traffic class table & reset the class session counters.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_CLASS
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) The sessions reserved by all the classes MUST fit in the sessions of the server, so
+*                   that every class can get its reserved sessions at the same time.
+*
+*               (2) A bandwidth share is a percentage of the global shaping rate, & thus has NO effect while
+*                   the global rate is unlimited (see 'tftp-s_shape.c  Note #3').  A class with a share that
+*                   caps it is rejected when the configured global rate is unlimited.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ClassInit (const  TFTPs_CFG  *p_cfg,
+                              TFTPs_ERR  *p_err)
+{
+    const  TFTPs_CLASS_CFG  *p_class;
+           CPU_INT32U        sess_rsvd;
+           CPU_INT08U        prefix_len_max;
+           CPU_INT08U        ix;
+
+
+    if ((p_cfg->ClassNbr    >  TFTPs_CLASS_NBR_MAX) ||
+       ((p_cfg->ClassNbr    >  0u)                  &&
+        (p_cfg->ClassTblPtr == DEF_NULL))) {
+       *p_err = TFTPs_ERR_CFG_INVALID_CLASS;
+        return;
+    }
+
+    sess_rsvd = 0u;
+    for (ix = 0u; ix < p_cfg->ClassNbr; ix++) {
+        p_class = &p_cfg->ClassTblPtr[ix];
+
+        switch (p_class->SubnetFamily) {
+            case TFTPs_CLASS_FAMILY_ANY:
+                 prefix_len_max = 0u;
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv4:
+                 prefix_len_max = 32u;
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv6:
+                 prefix_len_max = 128u;
+                 break;
+
+            default:
+                *p_err = TFTPs_ERR_CFG_INVALID_CLASS;
+                 return;
+        }
+
+        if ((p_class->SubnetPrefixLen > prefix_len_max) ||
+            (p_class->BwSharePct      > 100u)) {
+           *p_err = TFTPs_ERR_CFG_INVALID_CLASS;
+            return;
+        }
+                                                                /* See Note #2.                                         */
+        if ((p_class->BwSharePct      >  0u)   &&
+            (p_class->BwSharePct      <  100u) &&
+            (p_cfg->ShapeRateGlobal   == 0u)) {
+           *p_err = TFTPs_ERR_CFG_INVALID_CLASS;
+            return;
+        }
+
+        sess_rsvd += p_class->SessRsvd;
+    }
+
+    if (sess_rsvd > p_cfg->SessNbrMax) {                        /* See Note #1.                                         */
+       *p_err = TFTPs_ERR_CFG_INVALID_CLASS;
+        return;
+    }
+
+    TFTPs_ClassTblPtr     = p_cfg->ClassTblPtr;
+    TFTPs_ClassNbr        = p_cfg->ClassNbr;
+    TFTPs_ClassSessNbrMax = p_cfg->SessNbrMax;
+    TFTPs_ClassSessNbrTot = 0u;
+    for (ix = 0u; ix <= TFTPs_CLASS_NBR_MAX; ix++) {
+        TFTPs_ClassSessNbr[ix] = 0u;
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ClassMatch()
+*
+* Description : Find the traffic class of a request.
+*
+* Argument(s) : p_key       Pointer to session key of the client.
+*
+*               p_filename  Pointer to NUL-terminated requested file name.
+*
+* Return(s)   : Index of the first matching class, if any.
+*
+*               Index of the default class,         otherwise.
+*
+* Caller(s)   : TFTPs_Task(),
+*               TFTPs_ReqQ_Push().
+*
+* Note(s)     : (1) See 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION DATA TYPE  Note #1'.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  TFTPs_ClassMatch (TFTPs_SESS_KEY  *p_key,
+                              CPU_CHAR        *p_filename)
+{
+    const  TFTPs_CLASS_CFG  *p_class;
+           CPU_SIZE_T        prefix_len;
+           CPU_INT16S        cmp;
+           CPU_BOOLEAN       match;
+           CPU_INT08U        ix;
+
+
+    for (ix = 0u; ix < TFTPs_ClassNbr; ix++) {                  /* See Note #1.                                         */
+        p_class = &TFTPs_ClassTblPtr[ix];
+
+        if (p_class->FilenamePrefixPtr != DEF_NULL) {
+            prefix_len = Str_Len((CPU_CHAR *)p_class->FilenamePrefixPtr);
+            cmp        = Str_Cmp_N(p_filename, (CPU_CHAR *)p_class->FilenamePrefixPtr, prefix_len);
+            if (cmp != 0) {
+                continue;
+            }
+        }
+
+        match = TFTPs_ClassSubnetMatch(p_class, p_key);
+        if (match == DEF_YES) {
+            return (ix);
+        }
+    }
+
+    return (TFTPs_ClassNbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ClassAdmit()
+*
+* Description : Check whether a new session of a class may be allocated.
+*
+* Argument(s) : class_ix    Index of the class of the new session.
+*
+* Return(s)   : DEF_YES, if a session is available to the class.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) A session is available to a class when the free sessions outnumber the sessions still
+*                   reserved by the OTHER classes (see 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION DATA TYPE
+*                   Note #4').  A class that did NOT use all its reserved sessions is thus always admitted.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_ClassAdmit (CPU_INT08U  class_ix)
+{
+    CPU_INT32U  sess_free;
+    CPU_INT32U  sess_rsvd;
+    CPU_INT16U  rsvd;
+    CPU_INT08U  ix;
+
+
+    sess_free = (CPU_INT32U)TFTPs_ClassSessNbrMax - TFTPs_ClassSessNbrTot;
+
+    sess_rsvd = 0u;                                             /* See Note #1.                                         */
+    for (ix = 0u; ix < TFTPs_ClassNbr; ix++) {
+        rsvd = TFTPs_ClassTblPtr[ix].SessRsvd;
+        if ((ix                     != class_ix) &&
+            (TFTPs_ClassSessNbr[ix] <  rsvd)) {
+            sess_rsvd += rsvd - TFTPs_ClassSessNbr[ix];
+        }
+    }
+
+    return ((sess_free > sess_rsvd) ? DEF_YES : DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_ClassSessAdd()
+*
+* Description : Count a new session of a class.
+*
+* Argument(s) : class_ix    Index of the class of the session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ClassSessAdd (CPU_INT08U  class_ix)
+{
+    if (class_ix > TFTPs_ClassNbr) {
+        return;
+    }
+
+    TFTPs_ClassSessNbr[class_ix]++;
+    TFTPs_ClassSessNbrTot++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_ClassSessRemove()
+*
+* Description : Uncount a terminated session of a class.
+*
+* Argument(s) : class_ix    Index of the class of the session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Terminate().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ClassSessRemove (CPU_INT08U  class_ix)
+{
+    if ((class_ix                     > TFTPs_ClassNbr) ||
+        (TFTPs_ClassSessNbr[class_ix] == 0u)) {
+        return;
+    }
+
+    TFTPs_ClassSessNbr[class_ix]--;
+    TFTPs_ClassSessNbrTot--;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_ClassBwShareGet()
+*
+* Description : Get the bandwidth cap of a class.
+*
+* Argument(s) : class_ix    Index of the class.
+*
+* Return(s)   : Percentage of the global shaping rate the class may use, if the class is capped.
+*
+*               0,                                                       otherwise.
+*
+* Caller(s)   : TFTPs_ShapeInit(),
+*               TFTPs_ShapeTxDlyGet().
+*
+* Note(s)     : (1) The default class is never capped.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  TFTPs_ClassBwShareGet (CPU_INT08U  class_ix)
+{
+    if (class_ix >= TFTPs_ClassNbr) {                           /* See Note #1.                                         */
+        return (0u);
+    }
+
+    return (TFTPs_ClassTblPtr[class_ix].BwSharePct);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_ClassSubnetMatch()
+*
+* Description : Check whether a client address belongs to the subnet of a class.
+*
+* Argument(s) : p_class     Pointer to class.
+*
+*               p_key       Pointer to session key of the client.
+*
+* Return(s)   : DEF_YES, if the client belongs to the subnet.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_ClassMatch().
+*
+* Note(s)     : (1) Session keys hold the client address in network order (see 'tftp-s_sess.h  SESSION KEY
+*                   DATA TYPE  Note #1'), so that the address is compared octet by octet, from the most
+*                   significant one.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_ClassSubnetMatch (const  TFTPs_CLASS_CFG  *p_class,
+                                                    TFTPs_SESS_KEY   *p_key)
+{
+    CPU_INT08U  *p_addr;
+    CPU_INT08U   mask;
+    CPU_INT08U   bits_rem;
+    CPU_INT08U   ix;
+
+
+    switch (p_class->SubnetFamily) {
+        case TFTPs_CLASS_FAMILY_ANY:
+             return (DEF_YES);
+
+        case TFTPs_CLASS_FAMILY_IPv4:
+             if (p_key->Family != NET_SOCK_ADDR_FAMILY_IP_V4) {
+                 return (DEF_NO);
+             }
+             break;
+
+        case TFTPs_CLASS_FAMILY_IPv6:
+             if (p_key->Family != NET_SOCK_ADDR_FAMILY_IP_V6) {
+                 return (DEF_NO);
+             }
+             break;
+
+        default:
+             return (DEF_NO);
+    }
+
+    p_addr   = (CPU_INT08U *)&p_key->Addr[0];                   /* See Note #1.                                         */
+    bits_rem =  p_class->SubnetPrefixLen;
+    ix       =  0u;
+    while (bits_rem >= DEF_OCTET_NBR_BITS) {
+        if (p_addr[ix] != p_class->SubnetAddr[ix]) {
+            return (DEF_NO);
+        }
+        bits_rem -= DEF_OCTET_NBR_BITS;
+        ix++;
+    }
+
+    if (bits_rem > 0u) {
+        mask = (CPU_INT08U)(0xFFu << (DEF_OCTET_NBR_BITS - bits_rem));
+        if ((p_addr[ix] & mask) != (p_class->SubnetAddr[ix] & mask)) {
+            return (DEF_NO);
+        }
+    }
+
+    return (DEF_YES);
+}
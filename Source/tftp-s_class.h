@@ -0,0 +1,99 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER TRAFFIC CLASSES
+*
+* Filename : tftp-s_class.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs class present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_CLASS_MODULE_PRESENT                             /* See Note #1.                                         */
+#define  TFTPs_CLASS_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+#include  "tftp-s_sess.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*
+* Note(s) : (1) The default class, of the requests matching no configured class, follows the configured
+*               classes (i.e. its index is the number of configured classes).
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_CLASS_NBR_MAX                               8u   /* Max nbr of configured classes (see Note #1).         */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void         TFTPs_ClassInit       (const  TFTPs_CFG  *p_cfg,
+                                           TFTPs_ERR  *p_err);
+
+CPU_INT08U   TFTPs_ClassMatch      (TFTPs_SESS_KEY  *p_key,
+                                    CPU_CHAR        *p_filename);
+
+CPU_BOOLEAN  TFTPs_ClassAdmit      (CPU_INT08U       class_ix);
+
+void         TFTPs_ClassSessAdd    (CPU_INT08U       class_ix);
+
+void         TFTPs_ClassSessRemove (CPU_INT08U       class_ix);
+
+CPU_INT08U   TFTPs_ClassBwShareGet (CPU_INT08U       class_ix);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_CLASS_MODULE_PRESENT  */
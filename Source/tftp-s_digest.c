@@ -0,0 +1,499 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER TRANSFER DIGEST
+*
+* Filename : tftp-s_digest.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The digest is updated with the data of each block as it is read from or written to the
+*                file, so that the file does NOT need to be read again to be verified once transferred.
+*
+*            (2) CRC-32 is computed one octet at a time with a 256-entry table, i.e. the reflected CRC of
+*                polynomial 0x04C11DB7, initial & final value 0xFFFFFFFF.
+*
+*            (3) SHA-256 is computed as specified by FIPS 180-4, on the 64-octet blocks of the message.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_DIGEST_MODULE
+#include  "tftp-s_digest.h"
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_DIGEST_CRC32_INIT                  0xFFFFFFFFu
+#define  TFTPs_DIGEST_CRC32_LEN                            4u
+#define  TFTPs_DIGEST_SHA256_LEN                          32u
+#define  TFTPs_DIGEST_SHA256_LEN_SIZE                      8u   /* Size of the msg len appended by the padding.         */
+
+#define  TFTPs_DIGEST_ROTR(x, n)                (((x) >> (n)) | ((x) << (32u - (n))))
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                        LOCAL CONSTANTS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  CPU_INT32U  TFTPs_DigestCRC32_Tbl[256] = {       /* See Note #2.                                         */
+    0x00000000u, 0x77073096u, 0xEE0E612Cu, 0x990951BAu,
+    0x076DC419u, 0x706AF48Fu, 0xE963A535u, 0x9E6495A3u,
+    0x0EDB8832u, 0x79DCB8A4u, 0xE0D5E91Eu, 0x97D2D988u,
+    0x09B64C2Bu, 0x7EB17CBDu, 0xE7B82D07u, 0x90BF1D91u,
+    0x1DB71064u, 0x6AB020F2u, 0xF3B97148u, 0x84BE41DEu,
+    0x1ADAD47Du, 0x6DDDE4EBu, 0xF4D4B551u, 0x83D385C7u,
+    0x136C9856u, 0x646BA8C0u, 0xFD62F97Au, 0x8A65C9ECu,
+    0x14015C4Fu, 0x63066CD9u, 0xFA0F3D63u, 0x8D080DF5u,
+    0x3B6E20C8u, 0x4C69105Eu, 0xD56041E4u, 0xA2677172u,
+    0x3C03E4D1u, 0x4B04D447u, 0xD20D85FDu, 0xA50AB56Bu,
+    0x35B5A8FAu, 0x42B2986Cu, 0xDBBBC9D6u, 0xACBCF940u,
+    0x32D86CE3u, 0x45DF5C75u, 0xDCD60DCFu, 0xABD13D59u,
+    0x26D930ACu, 0x51DE003Au, 0xC8D75180u, 0xBFD06116u,
+    0x21B4F4B5u, 0x56B3C423u, 0xCFBA9599u, 0xB8BDA50Fu,
+    0x2802B89Eu, 0x5F058808u, 0xC60CD9B2u, 0xB10BE924u,
+    0x2F6F7C87u, 0x58684C11u, 0xC1611DABu, 0xB6662D3Du,
+    0x76DC4190u, 0x01DB7106u, 0x98D220BCu, 0xEFD5102Au,
+    0x71B18589u, 0x06B6B51Fu, 0x9FBFE4A5u, 0xE8B8D433u,
+    0x7807C9A2u, 0x0F00F934u, 0x9609A88Eu, 0xE10E9818u,
+    0x7F6A0DBBu, 0x086D3D2Du, 0x91646C97u, 0xE6635C01u,
+    0x6B6B51F4u, 0x1C6C6162u, 0x856530D8u, 0xF262004Eu,
+    0x6C0695EDu, 0x1B01A57Bu, 0x8208F4C1u, 0xF50FC457u,
+    0x65B0D9C6u, 0x12B7E950u, 0x8BBEB8EAu, 0xFCB9887Cu,
+    0x62DD1DDFu, 0x15DA2D49u, 0x8CD37CF3u, 0xFBD44C65u,
+    0x4DB26158u, 0x3AB551CEu, 0xA3BC0074u, 0xD4BB30E2u,
+    0x4ADFA541u, 0x3DD895D7u, 0xA4D1C46Du, 0xD3D6F4FBu,
+    0x4369E96Au, 0x346ED9FCu, 0xAD678846u, 0xDA60B8D0u,
+    0x44042D73u, 0x33031DE5u, 0xAA0A4C5Fu, 0xDD0D7CC9u,
+    0x5005713Cu, 0x270241AAu, 0xBE0B1010u, 0xC90C2086u,
+    0x5768B525u, 0x206F85B3u, 0xB966D409u, 0xCE61E49Fu,
+    0x5EDEF90Eu, 0x29D9C998u, 0xB0D09822u, 0xC7D7A8B4u,
+    0x59B33D17u, 0x2EB40D81u, 0xB7BD5C3Bu, 0xC0BA6CADu,
+    0xEDB88320u, 0x9ABFB3B6u, 0x03B6E20Cu, 0x74B1D29Au,
+    0xEAD54739u, 0x9DD277AFu, 0x04DB2615u, 0x73DC1683u,
+    0xE3630B12u, 0x94643B84u, 0x0D6D6A3Eu, 0x7A6A5AA8u,
+    0xE40ECF0Bu, 0x9309FF9Du, 0x0A00AE27u, 0x7D079EB1u,
+    0xF00F9344u, 0x8708A3D2u, 0x1E01F268u, 0x6906C2FEu,
+    0xF762575Du, 0x806567CBu, 0x196C3671u, 0x6E6B06E7u,
+    0xFED41B76u, 0x89D32BE0u, 0x10DA7A5Au, 0x67DD4ACCu,
+    0xF9B9DF6Fu, 0x8EBEEFF9u, 0x17B7BE43u, 0x60B08ED5u,
+    0xD6D6A3E8u, 0xA1D1937Eu, 0x38D8C2C4u, 0x4FDFF252u,
+    0xD1BB67F1u, 0xA6BC5767u, 0x3FB506DDu, 0x48B2364Bu,
+    0xD80D2BDAu, 0xAF0A1B4Cu, 0x36034AF6u, 0x41047A60u,
+    0xDF60EFC3u, 0xA867DF55u, 0x316E8EEFu, 0x4669BE79u,
+    0xCB61B38Cu, 0xBC66831Au, 0x256FD2A0u, 0x5268E236u,
+    0xCC0C7795u, 0xBB0B4703u, 0x220216B9u, 0x5505262Fu,
+    0xC5BA3BBEu, 0xB2BD0B28u, 0x2BB45A92u, 0x5CB36A04u,
+    0xC2D7FFA7u, 0xB5D0CF31u, 0x2CD99E8Bu, 0x5BDEAE1Du,
+    0x9B64C2B0u, 0xEC63F226u, 0x756AA39Cu, 0x026D930Au,
+    0x9C0906A9u, 0xEB0E363Fu, 0x72076785u, 0x05005713u,
+    0x95BF4A82u, 0xE2B87A14u, 0x7BB12BAEu, 0x0CB61B38u,
+    0x92D28E9Bu, 0xE5D5BE0Du, 0x7CDCEFB7u, 0x0BDBDF21u,
+    0x86D3D2D4u, 0xF1D4E242u, 0x68DDB3F8u, 0x1FDA836Eu,
+    0x81BE16CDu, 0xF6B9265Bu, 0x6FB077E1u, 0x18B74777u,
+    0x88085AE6u, 0xFF0F6A70u, 0x66063BCAu, 0x11010B5Cu,
+    0x8F659EFFu, 0xF862AE69u, 0x616BFFD3u, 0x166CCF45u,
+    0xA00AE278u, 0xD70DD2EEu, 0x4E048354u, 0x3903B3C2u,
+    0xA7672661u, 0xD06016F7u, 0x4969474Du, 0x3E6E77DBu,
+    0xAED16A4Au, 0xD9D65ADCu, 0x40DF0B66u, 0x37D83BF0u,
+    0xA9BCAE53u, 0xDEBB9EC5u, 0x47B2CF7Fu, 0x30B5FFE9u,
+    0xBDBDF21Cu, 0xCABAC28Au, 0x53B39330u, 0x24B4A3A6u,
+    0xBAD03605u, 0xCDD70693u, 0x54DE5729u, 0x23D967BFu,
+    0xB3667A2Eu, 0xC4614AB8u, 0x5D681B02u, 0x2A6F2B94u,
+    0xB40BBE37u, 0xC30C8EA1u, 0x5A05DF1Bu, 0x2D02EF8Du
+};
+
+static  const  CPU_INT32U  TFTPs_DigestSHA256_K[64] = {         /* Round constants (see Note #3).                       */
+    0x428A2F98u, 0x71374491u, 0xB5C0FBCFu, 0xE9B5DBA5u,
+    0x3956C25Bu, 0x59F111F1u, 0x923F82A4u, 0xAB1C5ED5u,
+    0xD807AA98u, 0x12835B01u, 0x243185BEu, 0x550C7DC3u,
+    0x72BE5D74u, 0x80DEB1FEu, 0x9BDC06A7u, 0xC19BF174u,
+    0xE49B69C1u, 0xEFBE4786u, 0x0FC19DC6u, 0x240CA1CCu,
+    0x2DE92C6Fu, 0x4A7484AAu, 0x5CB0A9DCu, 0x76F988DAu,
+    0x983E5152u, 0xA831C66Du, 0xB00327C8u, 0xBF597FC7u,
+    0xC6E00BF3u, 0xD5A79147u, 0x06CA6351u, 0x14292967u,
+    0x27B70A85u, 0x2E1B2138u, 0x4D2C6DFCu, 0x53380D13u,
+    0x650A7354u, 0x766A0ABBu, 0x81C2C92Eu, 0x92722C85u,
+    0xA2BFE8A1u, 0xA81A664Bu, 0xC24B8B70u, 0xC76C51A3u,
+    0xD192E819u, 0xD6990624u, 0xF40E3585u, 0x106AA070u,
+    0x19A4C116u, 0x1E376C08u, 0x2748774Cu, 0x34B0BCB5u,
+    0x391C0CB3u, 0x4ED8AA4Au, 0x5B9CCA4Fu, 0x682E6FF3u,
+    0x748F82EEu, 0x78A5636Fu, 0x84C87814u, 0x8CC70208u,
+    0x90BEFFFAu, 0xA4506CEBu, 0xBEF9A3F7u, 0xC67178F2u
+};
+
+static  const  CPU_INT32U  TFTPs_DigestSHA256_H0[8] = {         /* Initial hash value (see Note #3).                    */
+    0x6A09E667u, 0xBB67AE85u, 0x3C6EF372u, 0xA54FF53Au,
+    0x510E527Fu, 0x9B05688Cu, 0x1F83D9ABu, 0x5BE0CD19u
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_DigestSHA256_BlkProc(       CPU_INT32U  *p_state,
+                                         const  CPU_INT08U  *p_blk);
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_DigestStart()
+*
+* Description : Start the digest of a transfer.
+*
+* Argument(s) : p_digest    Pointer to digest.
+*
+*               alg         Digest algorithm (see 'tftp-s_type.h  DIGEST ALGORITHM DATA TYPE').
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_ReqStart().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_DigestStart (TFTPs_DIGEST      *p_digest,
+                         TFTPs_DIGEST_ALG   alg)
+{
+    p_digest->Alg = alg;
+
+    switch (alg) {
+        case TFTPs_DIGEST_ALG_CRC32:
+             p_digest->Ctx.CRC32 = TFTPs_DIGEST_CRC32_INIT;
+             break;
+
+
+        case TFTPs_DIGEST_ALG_SHA256:
+             Mem_Copy(&p_digest->Ctx.SHA256.State[0],
+                      &TFTPs_DigestSHA256_H0[0],
+                       sizeof(TFTPs_DigestSHA256_H0));
+             p_digest->Ctx.SHA256.Len = 0u;
+             break;
+
+
+        case TFTPs_DIGEST_ALG_NONE:
+        default:
+             p_digest->Alg = TFTPs_DIGEST_ALG_NONE;
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_DigestUpdate()
+*
+* Description : Add data to the digest of a transfer.
+*
+* Argument(s) : p_digest    Pointer to digest.
+*
+*               p_data      Pointer to data.
+*
+*               len         Length of data.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_DataRd(),
+*               TFTPs_DataWr(),
+*               TFTPs_DigestFinish().
+*
+* Note(s)     : (1) Complete blocks are hashed from the data itself, without being copied.
+*********************************************************************************************************
+*/
+
+void  TFTPs_DigestUpdate (       TFTPs_DIGEST  *p_digest,
+                          const  CPU_INT08U    *p_data,
+                                 CPU_SIZE_T     len)
+{
+    TFTPs_DIGEST_SHA256  *p_sha;
+    CPU_INT32U            crc;
+    CPU_SIZE_T            blk_len;
+    CPU_SIZE_T            copy_len;
+
+
+    switch (p_digest->Alg) {
+        case TFTPs_DIGEST_ALG_CRC32:                            /* See 'tftp-s_digest.c  Note #2'.                      */
+             crc = p_digest->Ctx.CRC32;
+             while (len > 0u) {
+                 crc = TFTPs_DigestCRC32_Tbl[(crc ^ *p_data) & DEF_OCTET_MASK] ^ (crc >> DEF_OCTET_NBR_BITS);
+                 p_data++;
+                 len--;
+             }
+             p_digest->Ctx.CRC32 = crc;
+             break;
+
+
+        case TFTPs_DIGEST_ALG_SHA256:                           /* See 'tftp-s_digest.c  Note #3'.                      */
+             p_sha       = &p_digest->Ctx.SHA256;
+             blk_len     = (CPU_SIZE_T)(p_sha->Len % TFTPs_DIGEST_SHA256_BLK_SIZE);
+             p_sha->Len += len;
+
+             while (len > 0u) {
+                 if ((blk_len == 0u) &&                         /* See Note #1.                                         */
+                     (len     >= TFTPs_DIGEST_SHA256_BLK_SIZE)) {
+                     TFTPs_DigestSHA256_BlkProc(p_sha->State, p_data);
+                     p_data += TFTPs_DIGEST_SHA256_BLK_SIZE;
+                     len    -= TFTPs_DIGEST_SHA256_BLK_SIZE;
+                     continue;
+                 }
+
+                 copy_len = DEF_MIN(TFTPs_DIGEST_SHA256_BLK_SIZE - blk_len, len);
+                 Mem_Copy(&p_sha->Blk[blk_len], p_data, copy_len);
+                 blk_len += copy_len;
+                 p_data  += copy_len;
+                 len     -= copy_len;
+
+                 if (blk_len == TFTPs_DIGEST_SHA256_BLK_SIZE) {
+                     TFTPs_DigestSHA256_BlkProc(p_sha->State, p_sha->Blk);
+                     blk_len = 0u;
+                 }
+             }
+             break;
+
+
+        case TFTPs_DIGEST_ALG_NONE:
+        default:
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_DigestFinish()
+*
+* Description : Get the digest of a transfer.
+*
+* Argument(s) : p_digest    Pointer to digest.
+*
+*               p_dest      Pointer to buffer that will receive the digest, at least TFTPs_DIGEST_LEN_MAX
+*                           octets long.
+*
+* Return(s)   : Length of the digest, 0 if NO digest was computed.
+*
+* Caller(s)   : TFTPs_XferDone().
+*
+* Note(s)     : (1) The digest is written most significant octet first (see 'tftp-s_type.h  TRANSFER
+*                   COMPLETION DATA TYPE  Note #3').
+*
+*               (2) FIPS 180-4, Section 5.1.1 pads the message with a '1' bit, '0' bits up to 8 octets
+*                   before the end of a block, & the message length in bits, on 64 bits.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  TFTPs_DigestFinish (TFTPs_DIGEST  *p_digest,
+                                CPU_INT08U    *p_dest)
+{
+    TFTPs_DIGEST_SHA256  *p_sha;
+    CPU_INT08U            pad[TFTPs_DIGEST_SHA256_BLK_SIZE];
+    CPU_INT64U            bit_len;
+    CPU_INT32U            crc;
+    CPU_SIZE_T            blk_len;
+    CPU_SIZE_T            pad_len;
+    CPU_INT08U            len;
+    CPU_INT08U            ix;
+
+
+    switch (p_digest->Alg) {
+        case TFTPs_DIGEST_ALG_CRC32:
+             crc = p_digest->Ctx.CRC32 ^ TFTPs_DIGEST_CRC32_INIT;
+                                                                /* See Note #1.                                         */
+             for (ix = 0u; ix < TFTPs_DIGEST_CRC32_LEN; ix++) {
+                 p_dest[ix] = (CPU_INT08U)(crc >> (DEF_OCTET_NBR_BITS * (TFTPs_DIGEST_CRC32_LEN - 1u - ix)));
+             }
+             len = TFTPs_DIGEST_CRC32_LEN;
+             break;
+
+
+        case TFTPs_DIGEST_ALG_SHA256:
+             p_sha   = &p_digest->Ctx.SHA256;
+             bit_len =  p_sha->Len * DEF_OCTET_NBR_BITS;
+             blk_len = (CPU_SIZE_T)(p_sha->Len % TFTPs_DIGEST_SHA256_BLK_SIZE);
+                                                                /* Pad msg (see Note #2).                               */
+             pad_len = (blk_len < (TFTPs_DIGEST_SHA256_BLK_SIZE - TFTPs_DIGEST_SHA256_LEN_SIZE))
+                     ? (    TFTPs_DIGEST_SHA256_BLK_SIZE - TFTPs_DIGEST_SHA256_LEN_SIZE - blk_len)
+                     : (2u * TFTPs_DIGEST_SHA256_BLK_SIZE - TFTPs_DIGEST_SHA256_LEN_SIZE - blk_len);
+             Mem_Clr(pad, sizeof(pad));
+             pad[0] = 0x80u;
+             TFTPs_DigestUpdate(p_digest, pad, pad_len);
+
+             for (ix = 0u; ix < TFTPs_DIGEST_SHA256_LEN_SIZE; ix++) {
+                 pad[ix] = (CPU_INT08U)(bit_len >> (DEF_OCTET_NBR_BITS * (TFTPs_DIGEST_SHA256_LEN_SIZE - 1u - ix)));
+             }
+             TFTPs_DigestUpdate(p_digest, pad, TFTPs_DIGEST_SHA256_LEN_SIZE);
+
+                                                                /* See Note #1.                                         */
+             for (ix = 0u; ix < TFTPs_DIGEST_SHA256_LEN; ix++) {
+                 p_dest[ix] = (CPU_INT08U)(p_sha->State[ix / 4u] >> (DEF_OCTET_NBR_BITS * (3u - (ix % 4u))));
+             }
+             len = TFTPs_DIGEST_SHA256_LEN;
+             break;
+
+
+        case TFTPs_DIGEST_ALG_NONE:
+        default:
+             len = 0u;
+             break;
+    }
+
+    return (len);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                    TFTPs_DigestSHA256_BlkProc()
+*
+* Description : Process a 64-octet block of a SHA-256 message.
+*
+* Argument(s) : p_state     Pointer to hash state.
+*
+*               p_blk       Pointer to block.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_DigestUpdate().
+*
+* Note(s)     : (1) See FIPS 180-4, Section 6.2.2.  The message schedule is computed in a 16-word circular
+*                   buffer, to limit the stack usage of the TFTP server task.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_DigestSHA256_BlkProc (       CPU_INT32U  *p_state,
+                                          const  CPU_INT08U  *p_blk)
+{
+    CPU_INT32U  w[16];
+    CPU_INT32U  a;
+    CPU_INT32U  b;
+    CPU_INT32U  c;
+    CPU_INT32U  d;
+    CPU_INT32U  e;
+    CPU_INT32U  f;
+    CPU_INT32U  g;
+    CPU_INT32U  h;
+    CPU_INT32U  s0;
+    CPU_INT32U  s1;
+    CPU_INT32U  t1;
+    CPU_INT32U  t2;
+    CPU_INT08U  ix;
+
+
+    for (ix = 0u; ix < 16u; ix++) {
+        w[ix] = ((CPU_INT32U)p_blk[4u * ix]      << 24u) |
+                ((CPU_INT32U)p_blk[4u * ix + 1u] << 16u) |
+                ((CPU_INT32U)p_blk[4u * ix + 2u] <<  8u) |
+                 (CPU_INT32U)p_blk[4u * ix + 3u];
+    }
+
+    a = p_state[0];
+    b = p_state[1];
+    c = p_state[2];
+    d = p_state[3];
+    e = p_state[4];
+    f = p_state[5];
+    g = p_state[6];
+    h = p_state[7];
+
+    for (ix = 0u; ix < 64u; ix++) {
+        if (ix >= 16u) {                                        /* Extend msg schedule (see Note #1).                   */
+            s0 = w[(ix + 1u) & 15u];
+            s0 = TFTPs_DIGEST_ROTR(s0, 7u) ^ TFTPs_DIGEST_ROTR(s0, 18u) ^ (s0 >> 3u);
+            s1 = w[(ix + 14u) & 15u];
+            s1 = TFTPs_DIGEST_ROTR(s1, 17u) ^ TFTPs_DIGEST_ROTR(s1, 19u) ^ (s1 >> 10u);
+            w[ix & 15u] += s0 + s1 + w[(ix + 9u) & 15u];
+        }
+
+        s1 = TFTPs_DIGEST_ROTR(e, 6u) ^ TFTPs_DIGEST_ROTR(e, 11u) ^ TFTPs_DIGEST_ROTR(e, 25u);
+        t1 = h + s1 + ((e & f) ^ (~e & g)) + TFTPs_DigestSHA256_K[ix] + w[ix & 15u];
+        s0 = TFTPs_DIGEST_ROTR(a, 2u) ^ TFTPs_DIGEST_ROTR(a, 13u) ^ TFTPs_DIGEST_ROTR(a, 22u);
+        t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    p_state[0] += a;
+    p_state[1] += b;
+    p_state[2] += c;
+    p_state[3] += d;
+    p_state[4] += e;
+    p_state[5] += f;
+    p_state[6] += g;
+    p_state[7] += h;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of digest module include.                        */
@@ -0,0 +1,123 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER TRANSFER DIGEST
+*
+* Filename : tftp-s_digest.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs digest present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_DIGEST_MODULE_PRESENT                            /* See Note #1.                                         */
+#define  TFTPs_DIGEST_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_DIGEST_SHA256_BLK_SIZE                     64u   /* SHA-256 msg blk size (octets).                       */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         DIGEST DATA TYPE
+*
+* Note(s) : (1) SHA-256 processes the message in 64-octet blocks; 'Blk' holds the octets of the block
+*               NOT yet complete.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_digest_sha256 {
+    CPU_INT32U          State[8];                               /* Hash state.                                          */
+    CPU_INT64U          Len;                                    /* Msg len (octets).                                    */
+    CPU_INT08U          Blk[TFTPs_DIGEST_SHA256_BLK_SIZE];      /* Partial msg blk (see Note #1).                       */
+} TFTPs_DIGEST_SHA256;
+
+typedef  struct  tftps_digest {
+    TFTPs_DIGEST_ALG    Alg;                                    /* Digest alg.                                          */
+    union {
+        CPU_INT32U           CRC32;                             /* CRC-32 register.                                     */
+        TFTPs_DIGEST_SHA256  SHA256;
+    } Ctx;
+} TFTPs_DIGEST;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void        TFTPs_DigestStart (       TFTPs_DIGEST      *p_digest,
+                                      TFTPs_DIGEST_ALG   alg);
+
+void        TFTPs_DigestUpdate(       TFTPs_DIGEST      *p_digest,
+                               const  CPU_INT08U        *p_data,
+                                      CPU_SIZE_T         len);
+
+CPU_INT08U  TFTPs_DigestFinish(       TFTPs_DIGEST      *p_digest,
+                                      CPU_INT08U        *p_dest);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_DIGEST_MODULE_PRESENT  */
@@ -0,0 +1,1754 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     TFTP SERVER FILE STORAGE
+*
+* Filename : tftp-s_fs.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The files of the sessions are accessed through this module, which opens them with the
+*                network file system (see 'net_fs.h') & hides how they are stored from the protocol.  One
+*                file object is allocated per session, as a session has at most one file opened.
+*
+*            (2) When TFTPs_CFG_FS_LZ4_EN is enabled, a file opened for reading that does NOT exist is
+*                looked for with the TFTPs_FS_LZ4_EXT extension appended to its name.  Such a file MUST
+*                hold an LZ4 frame (see 'tftp-s_lz4.c  Note #1'), which is decoded on the fly : positions
+*                & sizes are those of the decoded data.  A compressed file is NOT served while all the
+*                decoders are in use.
+*
+*            (3) Files are only accessed from the TFTP server task context.
+*
+*            (4) When TFTPs_CFG_FS_PROVIDER_EN is enabled, a file opened for reading is first looked for
+*                among the files of the providers added by the application (see TFTPs_FS_ProviderAdd()),
+*                in the order they were added, then in the file system.  Generated files are thus served
+*                without being stored first.
+*
+*            (5) When TFTPs_CFG_FS_META_EN is enabled, files read are looked up in the file metadata index
+*                (see 'tftp-s_meta.c') before storage is accessed : a file indexed as missing is NOT looked
+*                for, & the size of an indexed file is NOT queried.  Files NOT found are indexed as missing,
+*                files found with their size, & the entry of a file written is removed.  Files of the
+*                providers are NOT indexed, as their content is generated.
+*
+*            (6) When TFTPs_CFG_FS_HANDLE_EN is enabled, the handle of a file opened for reading is shared
+*                by all the sessions reading the same file, instead of the file being opened once per
+*                session.  Each session reads from its own position : the shared handle is only moved
+*                when it is NOT already at the position read, so that sessions reading the file in turn
+*                cost a seek each, but a single session reading it costs none.  A handle NOT used anymore
+*                is kept open for TFTPs_CFG.FS_HandleIdleTimeout, so that the file of a request repeated
+*                by the same or another client is NOT opened again.  Opening a file for writing stops
+*                the sharing of its handles, which are closed once NOT used anymore.
+*
+*            (7) When TFTPs_CFG_FS_STREAM_EN is enabled, the sessions reading a file through a shared
+*                handle also share a stream : the file is read from storage in chunks of
+*                TFTPs_CFG.FS_StreamChunkSize octets, each read once & copied to all the sessions reading
+*                it.  The chunks of a stream form a window of at most TFTPs_CFG.FS_StreamWinNbr chunks :
+*                when the window is full, its first chunk is dropped, & the sessions still reading it are
+*                detached from the stream.  A detached session, or a session reading behind the window,
+*                reads the shared handle (see Note #6) from then on.  Storage reads per file thus remain
+*                nearly constant as the number of sessions reading it grows, as long as they read it at
+*                nearby positions.  Chunks come from a pool of TFTPs_CFG.FS_StreamChunkNbr chunks shared
+*                by all the streams; a chunk read by NO session MAY be reclaimed for another stream.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_FS_MODULE
+#include  "tftp-s_fs.h"
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_FS_FILE  *TFTPs_FS_FileTbl;                       /* File objects (see Note #1).                          */
+static  TFTPs_FS_FILE  *TFTPs_FS_FileFreePtr;                   /* Free files list.                                     */
+static  CPU_INT16U      TFTPs_FS_FileNbr;                       /* Nbr of file objects.                                 */
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)                        /* Name of compressed file (see Note #2).               */
+static  CPU_CHAR        TFTPs_FS_NameBuf[TFTPs_FS_NAME_LEN_MAX + sizeof(TFTPs_FS_LZ4_EXT)];
+#endif
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)                   /* File providers (see Note #4).                        */
+static  const  TFTPs_FS_PROVIDER  *TFTPs_FS_ProviderTbl[TFTPs_CFG_FS_PROVIDER_NBR_MAX];
+static         CPU_INT08U          TFTPs_FS_ProviderNbr;
+#endif
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  TFTPs_FS_HANDLE  *TFTPs_FS_HandleTbl;                   /* Shared handles (see Note #6).                        */
+static  CPU_INT16U        TFTPs_FS_HandleNbr;                   /* Nbr of shared handles.                               */
+static  CPU_INT32U        TFTPs_FS_HandleIdleTimeout;           /* Time (in ms) unused handles are kept open.           */
+#endif
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+static  TFTPs_FS_CHUNK   *TFTPs_FS_ChunkTbl;                    /* Stream chunks (see Note #7).                         */
+static  TFTPs_FS_CHUNK   *TFTPs_FS_ChunkFreePtr;                /* Free chunks list.                                    */
+static  CPU_INT16U        TFTPs_FS_ChunkNbr;                    /* Nbr of chunks, 0 if streams disabled.                */
+static  CPU_INT32U        TFTPs_FS_ChunkSize;                   /* Size of chunks (octets).                             */
+static  CPU_INT16U        TFTPs_FS_StreamWinNbr;                /* Max nbr of chunks of a stream window.                */
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  void             *TFTPs_FS_StorageOpen    (TFTPs_FS_FILE    *p_file,
+                                                   CPU_CHAR         *p_name,
+                                                   CPU_INT08U        access);
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  TFTPs_FS_HANDLE  *TFTPs_FS_HandleGet      (CPU_CHAR         *p_name);
+
+static  TFTPs_FS_HANDLE  *TFTPs_FS_HandleAdd      (CPU_CHAR         *p_name,
+                                                   TFTPs_FS_FILE    *p_file);
+
+static  void              TFTPs_FS_HandleDrop     (CPU_CHAR         *p_name);
+
+static  void              TFTPs_FS_HandleRelease  (TFTPs_FS_HANDLE  *p_handle);
+
+static  void              TFTPs_FS_HandleClose    (TFTPs_FS_HANDLE  *p_handle);
+
+static  CPU_BOOLEAN       TFTPs_FS_HandleRd       (TFTPs_FS_HANDLE  *p_handle,
+                                                   CPU_INT32U        pos,
+                                                   void             *p_dest,
+                                                   CPU_SIZE_T        size,
+                                                   CPU_SIZE_T       *p_size_rd);
+
+static  void              TFTPs_FS_HandleTmrHandler(void            *p_arg);
+#endif
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+static  CPU_BOOLEAN       TFTPs_FS_StreamRd       (TFTPs_FS_FILE    *p_file,
+                                                   void             *p_dest,
+                                                   CPU_SIZE_T        size,
+                                                   CPU_SIZE_T       *p_size_rd);
+
+static  void              TFTPs_FS_StreamDetach   (TFTPs_FS_FILE    *p_file);
+
+static  TFTPs_FS_CHUNK   *TFTPs_FS_ChunkFind      (TFTPs_FS_HANDLE  *p_handle,
+                                                   CPU_INT32U        pos);
+
+static  TFTPs_FS_CHUNK   *TFTPs_FS_ChunkFill      (TFTPs_FS_HANDLE  *p_handle,
+                                                   CPU_INT32U        pos);
+
+static  void              TFTPs_FS_ChunkDrop      (TFTPs_FS_CHUNK   *p_chunk);
+#endif
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_FS_ProviderOpen(TFTPs_FS_FILE  *p_file,
+                                           CPU_CHAR       *p_name,
+                                           CPU_BOOLEAN    *p_match);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_FS_Init()
+*
+* Description : Allocate the file objects, the shared file handles, the stream chunks & the decoders of
+*               compressed files.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+*                               ------------ RETURNED BY TFTPs_LZ4_Init() ------------
+*                               See TFTPs_LZ4_Init() for additional return error codes.
+*
+*                               ----------- RETURNED BY TFTPs_MetaInit() -------------
+*                               See TFTPs_MetaInit() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) Streams are disabled when TFTPs_CFG.FS_StreamChunkNbr, TFTPs_CFG.FS_StreamChunkSize or
+*                   TFTPs_CFG.FS_StreamWinNbr is null.
+*********************************************************************************************************
+*/
+
+void  TFTPs_FS_Init (const  TFTPs_CFG  *p_cfg,
+                            TFTPs_ERR  *p_err)
+{
+    TFTPs_FS_FILE    *p_file;
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    TFTPs_FS_HANDLE  *p_handle;
+#endif
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+    TFTPs_FS_CHUNK   *p_chunk;
+    CPU_INT08U       *p_buf;
+#endif
+    CPU_INT16U        ix;
+    LIB_ERR           err_lib;
+
+
+    TFTPs_FS_FileTbl = (TFTPs_FS_FILE *)Mem_SegAlloc((CPU_CHAR *)"TFTPs FS File Tbl",
+                                                                 DEF_NULL,
+                                                                 sizeof(TFTPs_FS_FILE) * p_cfg->SessNbrMax,
+                                                                &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_FS_FileNbr     = p_cfg->SessNbrMax;
+    TFTPs_FS_FileFreePtr = DEF_NULL;                            /* Build free list.                                     */
+    for (ix = p_cfg->SessNbrMax; ix > 0u; ix--) {
+        p_file                = &TFTPs_FS_FileTbl[ix - 1u];
+        Mem_Clr(p_file, sizeof(TFTPs_FS_FILE));
+        p_file->NextPtr       =  TFTPs_FS_FileFreePtr;
+        TFTPs_FS_FileFreePtr  =  p_file;
+    }
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)                     /* A file uses at most one handle (see Note #6).        */
+    TFTPs_FS_HandleTbl = (TFTPs_FS_HANDLE *)Mem_SegAlloc((CPU_CHAR *)"TFTPs FS Handle Tbl",
+                                                                     DEF_NULL,
+                                                                     sizeof(TFTPs_FS_HANDLE) * p_cfg->SessNbrMax,
+                                                                    &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_FS_HandleNbr         = p_cfg->SessNbrMax;
+    TFTPs_FS_HandleIdleTimeout = p_cfg->FS_HandleIdleTimeout;
+    for (ix = 0u; ix < TFTPs_FS_HandleNbr; ix++) {
+        p_handle = &TFTPs_FS_HandleTbl[ix];
+        Mem_Clr(p_handle, sizeof(TFTPs_FS_HANDLE));
+        TFTPs_TmrCfg(&p_handle->TmrIdle, TFTPs_FS_HandleTmrHandler, p_handle);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+    TFTPs_FS_ChunkNbr     = 0u;
+    TFTPs_FS_ChunkFreePtr = DEF_NULL;
+    if ((p_cfg->FS_StreamChunkNbr  > 0u) &&                     /* See Note #1.                                         */
+        (p_cfg->FS_StreamChunkSize > 0u) &&
+        (p_cfg->FS_StreamWinNbr    > 0u)) {
+        TFTPs_FS_ChunkTbl = (TFTPs_FS_CHUNK *)Mem_SegAlloc((CPU_CHAR *)"TFTPs FS Chunk Tbl",
+                                                                       DEF_NULL,
+                                                                       sizeof(TFTPs_FS_CHUNK) * p_cfg->FS_StreamChunkNbr,
+                                                                      &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        p_buf = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs FS Chunk Bufs",
+                                                       DEF_NULL,
+                                                       p_cfg->FS_StreamChunkSize * p_cfg->FS_StreamChunkNbr,
+                                                      &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        for (ix = p_cfg->FS_StreamChunkNbr; ix > 0u; ix--) {    /* Build free list.                                     */
+            p_chunk                = &TFTPs_FS_ChunkTbl[ix - 1u];
+            Mem_Clr(p_chunk, sizeof(TFTPs_FS_CHUNK));
+            p_chunk->BufPtr        = &p_buf[(ix - 1u) * p_cfg->FS_StreamChunkSize];
+            p_chunk->NextPtr       =  TFTPs_FS_ChunkFreePtr;
+            TFTPs_FS_ChunkFreePtr  =  p_chunk;
+        }
+
+        TFTPs_FS_ChunkNbr     = p_cfg->FS_StreamChunkNbr;
+        TFTPs_FS_ChunkSize    = p_cfg->FS_StreamChunkSize;
+        TFTPs_FS_StreamWinNbr = p_cfg->FS_StreamWinNbr;
+    }
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    TFTPs_LZ4_Init(p_cfg, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        return;
+    }
+#endif
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    TFTPs_MetaInit(p_cfg, p_err);
+#else
+   *p_err = TFTPs_ERR_NONE;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_FS_Open()
+*
+* Description : Open a file.
+*
+* Argument(s) : p_name      Name of the file.
+*
+*               access      File access :
+*
+*                               TFTPs_FS_ACCESS_RD      Open an existing file for reading.
+*                               TFTPs_FS_ACCESS_WR      Create or truncate a file for writing.
+*
+* Return(s)   : Pointer to the opened file, if NO error.
+*
+*               Pointer to NULL,            otherwise.
+*
+* Caller(s)   : TFTPs_FileOpenMode().
+*
+* Note(s)     : (1) See 'tftp-s_fs.c  Note #2'.
+*
+*               (2) See 'tftp-s_fs.c  Note #4'.
+*
+*               (3) See 'tftp-s_fs.c  Note #5'.
+*
+*               (4) See 'tftp-s_fs.c  Note #6'.  A file is read through a private handle when no shared
+*                   handle is available.
+*********************************************************************************************************
+*/
+
+TFTPs_FS_FILE  *TFTPs_FS_Open (CPU_CHAR    *p_name,
+                               CPU_INT08U   access)
+{
+    TFTPs_FS_FILE  *p_file;
+    void           *p_handle;
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    CPU_BOOLEAN     match;
+    CPU_BOOLEAN     ok;
+#endif
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    CPU_INT08U      meta_state;
+    CPU_INT32U      size;
+    CPU_BOOLEAN     size_ok;
+#endif
+
+
+    p_file = TFTPs_FS_FileFreePtr;
+    if (p_file == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    p_file->Size   = TFTPs_META_SIZE_UNKNOWN;
+    p_file->MetaWr = DEF_NO;
+#endif
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    p_file->ProviderPtr = DEF_NULL;
+    if (access == TFTPs_FS_ACCESS_RD) {                         /* Look for provided file (see Note #2).                */
+        ok = TFTPs_FS_ProviderOpen(p_file, p_name, &match);
+        if (match == DEF_YES) {
+            if (ok != DEF_OK) {
+                return (DEF_NULL);
+            }
+            TFTPs_FS_FileFreePtr = p_file->NextPtr;
+            p_file->NextPtr      = DEF_NULL;
+            return (p_file);
+        }
+    }
+#endif
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    if (access == TFTPs_FS_ACCESS_RD) {                         /* Look up index (see Note #3).                         */
+        meta_state = TFTPs_MetaGet(p_name, &p_file->Size);
+        if (meta_state == TFTPs_META_STATE_MISSING) {
+            return (DEF_NULL);
+        }
+    } else {                                                    /* Remove entry of file written.                        */
+        p_file->MetaHash = TFTPs_MetaHash(p_name);
+        p_file->MetaWr   = DEF_YES;
+        TFTPs_MetaRemove(p_file->MetaHash);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    p_file->HandlePtr = DEF_NULL;
+    p_file->Pos       = 0u;
+    if (access == TFTPs_FS_ACCESS_RD) {                         /* Share handle of file open (see Note #4).             */
+        p_file->HandlePtr = TFTPs_FS_HandleGet(p_name);
+    } else {                                                    /* Drop handles of file written.                        */
+        TFTPs_FS_HandleDrop(p_name);
+    }
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+    p_file->ChunkPtr       = DEF_NULL;
+    p_file->StreamDetached = DEF_NO;
+#endif
+
+    if (p_file->HandlePtr != DEF_NULL) {
+        p_handle = p_file->HandlePtr->FileHandlePtr;
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+        p_file->LZ4_DecPtr = p_file->HandlePtr->LZ4_DecPtr;
+#endif
+    } else {
+        p_handle = TFTPs_FS_StorageOpen(p_file, p_name, access);
+    }
+#else
+    p_handle = TFTPs_FS_StorageOpen(p_file, p_name, access);
+#endif
+    if (p_handle == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    TFTPs_FS_FileFreePtr  = p_file->NextPtr;
+    p_file->FileHandlePtr = p_handle;
+    p_file->NextPtr       = DEF_NULL;
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    if ((access            == TFTPs_FS_ACCESS_RD) &&            /* Share handle of file opened (see Note #4).           */
+        (p_file->HandlePtr == DEF_NULL)) {
+        p_file->HandlePtr = TFTPs_FS_HandleAdd(p_name, p_file);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    if ((access       == TFTPs_FS_ACCESS_RD) &&                 /* Index size of file found (see Note #3).              */
+        (p_file->Size == TFTPs_META_SIZE_UNKNOWN)) {
+        size_ok = TFTPs_FS_SizeGet(p_file, &size);
+        if (size_ok == DEF_OK) {
+            p_file->Size = size;
+            TFTPs_MetaSet(p_name, TFTPs_META_STATE_FOUND, size);
+        }
+    }
+#endif
+
+    return (p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_FS_Close()
+*
+* Description : Close a file.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SessTerminate(),
+*               TFTPs_ReqStart(),
+*               TFTPs_DataRd(),
+*               TFTPs_DataWr().
+*
+* Note(s)     : (1) The shared handle of a file is released, NOT closed (see 'tftp-s_fs.c  Note #6').
+*********************************************************************************************************
+*/
+
+void  TFTPs_FS_Close (TFTPs_FS_FILE  *p_file)
+{
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    if (p_file->ProviderPtr != DEF_NULL) {
+        p_file->ProviderPtr->Close(p_file->FileHandlePtr);
+        p_file->ProviderPtr = DEF_NULL;
+    } else
+#endif
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    if (p_file->HandlePtr != DEF_NULL) {                        /* See Note #1.                                         */
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+        TFTPs_FS_StreamDetach(p_file);
+#endif
+        TFTPs_FS_HandleRelease(p_file->HandlePtr);
+        p_file->HandlePtr  = DEF_NULL;
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+        p_file->LZ4_DecPtr = DEF_NULL;
+#endif
+    } else
+#endif
+    {
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+        if (p_file->LZ4_DecPtr != DEF_NULL) {
+            TFTPs_LZ4_Close(p_file->LZ4_DecPtr);
+            p_file->LZ4_DecPtr = DEF_NULL;
+        }
+#endif
+        NetFS_FileClose(p_file->FileHandlePtr);
+    }
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    if (p_file->MetaWr == DEF_YES) {                            /* Remove entry of file written.                        */
+        TFTPs_MetaRemove(p_file->MetaHash);
+        p_file->MetaWr = DEF_NO;
+    }
+#endif
+
+    p_file->FileHandlePtr = DEF_NULL;
+    p_file->NextPtr       = TFTPs_FS_FileFreePtr;
+    TFTPs_FS_FileFreePtr  = p_file;
+}
+
+
+/*
+*********************************************************************************************************
+*                                            TFTPs_FS_Rd()
+*
+* Description : Read data from the current position of a file.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Number of octets to read.
+*
+*               p_size_rd   Pointer to variable that will receive the number of octets read, fewer than
+*                           'size' at the end of the file.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_DataRd().
+*
+* Note(s)     : (1) A file sharing its handle is read from its own position (see 'tftp-s_fs.c  Note #6'),
+*                   through the stream of the handle (see 'tftp-s_fs.c  Note #7').
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_FS_Rd (TFTPs_FS_FILE  *p_file,
+                          void           *p_dest,
+                          CPU_SIZE_T      size,
+                          CPU_SIZE_T     *p_size_rd)
+{
+    CPU_BOOLEAN  ok;
+
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    if (p_file->ProviderPtr != DEF_NULL) {
+        ok = p_file->ProviderPtr->Rd(p_file->FileHandlePtr,
+                                     p_file->Pos,
+                                     p_dest,
+                                     size,
+                                     p_size_rd);
+        if (ok == DEF_OK) {
+            p_file->Pos += (CPU_INT32U)*p_size_rd;
+        }
+        return (ok);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    if (p_file->HandlePtr != DEF_NULL) {                        /* See Note #1.                                         */
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+        ok = TFTPs_FS_StreamRd(p_file, p_dest, size, p_size_rd);
+#else
+        ok = TFTPs_FS_HandleRd(p_file->HandlePtr, p_file->Pos, p_dest, size, p_size_rd);
+        if (ok == DEF_OK) {
+            p_file->Pos += (CPU_INT32U)*p_size_rd;
+        }
+#endif
+        return (ok);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    if (p_file->LZ4_DecPtr != DEF_NULL) {
+        ok = TFTPs_LZ4_Rd(              p_file->LZ4_DecPtr,
+                                        p_file->FileHandlePtr,
+                          (CPU_INT08U *)p_dest,
+                                        size,
+                                        p_size_rd);
+        return (ok);
+    }
+#endif
+
+    ok = NetFS_FileRd(p_file->FileHandlePtr, p_dest, size, p_size_rd);
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            TFTPs_FS_Wr()
+*
+* Description : Write data at the current position of a file.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+*               p_src       Pointer to source buffer.
+*
+*               size        Number of octets to write.
+*
+*               p_size_wr   Pointer to variable that will receive the number of octets written.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_DataWr().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPs_FS_Wr (TFTPs_FS_FILE  *p_file,
+                          void           *p_src,
+                          CPU_SIZE_T      size,
+                          CPU_SIZE_T     *p_size_wr)
+{
+    CPU_BOOLEAN  ok;
+
+
+    ok = NetFS_FileWr(p_file->FileHandlePtr, p_src, size, p_size_wr);
+
+    return (ok);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_FS_PosSet()
+*
+* Description : Set the position of the next read of a file.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+*               pos         Position, from the start of the file.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_WinRewind().
+*
+* Note(s)     : (1) The shared handle of a file is only moved when the file is read (see 'tftp-s_fs.c
+*                   Note #6').
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_FS_PosSet (TFTPs_FS_FILE  *p_file,
+                              CPU_INT32U      pos)
+{
+    CPU_BOOLEAN  ok;
+
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    if (p_file->ProviderPtr != DEF_NULL) {
+        p_file->Pos = pos;
+        return (DEF_OK);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    if (p_file->HandlePtr != DEF_NULL) {                        /* See Note #1.                                         */
+        p_file->Pos = pos;
+        return (DEF_OK);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    if (p_file->LZ4_DecPtr != DEF_NULL) {
+        ok = TFTPs_LZ4_PosSet(p_file->LZ4_DecPtr, pos);
+        return (ok);
+    }
+#endif
+
+    ok = NetFS_FilePosSet(p_file->FileHandlePtr, (CPU_INT32S)pos, NET_FS_SEEK_ORIGIN_START);
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_FS_PosGet()
+*
+* Description : Get the position of the next read of a file.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+*               p_pos       Pointer to variable that will receive the position, from the start of the file.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_WinRewind().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_FS_PosGet (TFTPs_FS_FILE  *p_file,
+                              CPU_INT32U     *p_pos)
+{
+    CPU_BOOLEAN  ok;
+
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    if (p_file->ProviderPtr != DEF_NULL) {
+       *p_pos = p_file->Pos;
+        return (DEF_OK);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    if (p_file->HandlePtr != DEF_NULL) {
+       *p_pos = p_file->Pos;
+        return (DEF_OK);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    if (p_file->LZ4_DecPtr != DEF_NULL) {
+       *p_pos = TFTPs_LZ4_PosGet(p_file->LZ4_DecPtr);
+        return (DEF_OK);
+    }
+#endif
+
+    ok = NetFS_FilePosGet(p_file->FileHandlePtr, p_pos);
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_FS_SizeGet()
+*
+* Description : Get the size of a file.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+*               p_size      Pointer to variable that will receive the size of the file, decoded size for a
+*                           compressed file (see 'tftp-s_fs.c  Note #2').
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise, or if the size of a provided file is NOT known.
+*
+* Caller(s)   : TFTPs_ReqStart(),
+*               TFTPs_FS_Open().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_FS_SizeGet (TFTPs_FS_FILE  *p_file,
+                               CPU_INT32U     *p_size)
+{
+    CPU_BOOLEAN  ok;
+
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    if (p_file->ProviderPtr != DEF_NULL) {
+        ok = p_file->ProviderPtr->SizeGet(p_file->FileHandlePtr, p_size);
+        return (ok);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    if (p_file->Size != TFTPs_META_SIZE_UNKNOWN) {              /* Size from index (see 'tftp-s_fs.c  Note #5').        */
+       *p_size = p_file->Size;
+        return (DEF_OK);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    if (p_file->LZ4_DecPtr != DEF_NULL) {
+       *p_size = TFTPs_LZ4_SizeGet(p_file->LZ4_DecPtr);
+        return (DEF_OK);
+    }
+#endif
+
+    ok = NetFS_FileSizeGet(p_file->FileHandlePtr, p_size);
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FS_ProviderAdd()
+*
+* Description : Add a file provider, serving files generated by the application.
+*
+* Argument(s) : p_provider  Pointer to file provider (see 'tftp-s_type.h  FILE PROVIDER DATA TYPE').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_NULL_PTR
+*                               TFTPs_ERR_FS_PROVIDER_FULL
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The provider MUST remain valid while the server runs : it is referenced, NOT copied.
+*
+*               (2) Providers MAY be added before or after TFTPs_Init().  A provider is looked for from the
+*                   next read request received.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+void  TFTPs_FS_ProviderAdd (const  TFTPs_FS_PROVIDER  *p_provider,
+                                   TFTPs_ERR          *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+
+    if ((p_provider          == DEF_NULL) ||
+        (p_provider->Match   == DEF_NULL) ||
+        (p_provider->Open    == DEF_NULL) ||
+        (p_provider->Rd      == DEF_NULL) ||
+        (p_provider->SizeGet == DEF_NULL) ||
+        (p_provider->Close   == DEF_NULL)) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    if (TFTPs_FS_ProviderNbr >= TFTPs_CFG_FS_PROVIDER_NBR_MAX) {
+        CPU_CRITICAL_EXIT();
+       *p_err = TFTPs_ERR_FS_PROVIDER_FULL;
+        return;
+    }
+    TFTPs_FS_ProviderTbl[TFTPs_FS_ProviderNbr] = p_provider;    /* Add provider before it is counted.                   */
+    TFTPs_FS_ProviderNbr++;
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_FS_HandleClr()
+*
+* Description : Close the shared handles NOT used anymore.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task().
+*
+*               This function is an INTERNAL TFTP server function & MUST NOT be called by application
+*               function(s).
+*
+* Note(s)     : (1) A simulation run ends with the server task (see 'tftp-s.c  TFTPs_Task()  Note #11'),
+*                   whose next run restarts the timers : the idle timers of the handles released during
+*                   the run would never expire, & their files would stay open for the next runs.
+*********************************************************************************************************
+*/
+
+#if ((TFTPs_CFG_SIM_EN       == DEF_ENABLED) && \
+     (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED))
+void  TFTPs_FS_HandleClr (void)
+{
+    TFTPs_FS_HANDLE  *p_handle;
+    CPU_INT16U        ix;
+
+
+    for (ix = 0u; ix < TFTPs_FS_HandleNbr; ix++) {
+        p_handle = &TFTPs_FS_HandleTbl[ix];
+        if ((p_handle->FileHandlePtr != DEF_NULL) &&
+            (p_handle->RefCtr        == 0u)) {
+            TFTPs_FS_HandleClose(p_handle);
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_FS_StorageOpen()
+*
+* Description : Open a file of the network file system.
+*
+* Argument(s) : p_file      Pointer to file, that will receive the decoder of a compressed file.
+*
+*               p_name      Name of the file.
+*
+*               access      File access (see TFTPs_FS_Open()).
+*
+* Return(s)   : Pointer to the handle of the opened file, if NO error.
+*
+*               Pointer to NULL,                          otherwise.
+*
+* Caller(s)   : TFTPs_FS_Open().
+*
+* Note(s)     : (1) See 'tftp-s_fs.c  Note #2'.
+*
+*               (2) Files read that are NOT found are indexed as missing (see 'tftp-s_fs.c  Note #5').
+*********************************************************************************************************
+*/
+
+static  void  *TFTPs_FS_StorageOpen (TFTPs_FS_FILE  *p_file,
+                                     CPU_CHAR       *p_name,
+                                     CPU_INT08U      access)
+{
+    void           *p_handle;
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    TFTPs_LZ4_DEC  *p_dec;
+    CPU_SIZE_T      name_len;
+#endif
+
+
+    if (access == TFTPs_FS_ACCESS_WR) {
+        p_handle = NetFS_FileOpen(p_name,
+                                  NET_FS_FILE_MODE_CREATE,
+                                  NET_FS_FILE_ACCESS_WR);
+    } else {
+        p_handle = NetFS_FileOpen(p_name,
+                                  NET_FS_FILE_MODE_OPEN,
+                                  NET_FS_FILE_ACCESS_RD);
+    }
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    p_dec = DEF_NULL;
+    if ((p_handle == DEF_NULL) &&                               /* Look for compressed file (see Note #1).              */
+        (access   == TFTPs_FS_ACCESS_RD)) {
+        name_len = Str_Len_N(p_name, TFTPs_FS_NAME_LEN_MAX + 1u);
+        if (name_len > TFTPs_FS_NAME_LEN_MAX) {
+            return (DEF_NULL);
+        }
+        Mem_Copy(TFTPs_FS_NameBuf, p_name, name_len);
+        Mem_Copy(&TFTPs_FS_NameBuf[name_len], TFTPs_FS_LZ4_EXT, sizeof(TFTPs_FS_LZ4_EXT));
+
+        p_handle = NetFS_FileOpen(TFTPs_FS_NameBuf,
+                                  NET_FS_FILE_MODE_OPEN,
+                                  NET_FS_FILE_ACCESS_RD);
+        if (p_handle != DEF_NULL) {
+            p_dec = TFTPs_LZ4_Open(p_handle);
+            if (p_dec == DEF_NULL) {
+                NetFS_FileClose(p_handle);
+                return (DEF_NULL);
+            }
+        }
+    }
+    p_file->LZ4_DecPtr = p_dec;
+#else
+    (void)p_file;
+#endif
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    if ((p_handle == DEF_NULL) &&                               /* Index missing file (see Note #2).                    */
+        (access   == TFTPs_FS_ACCESS_RD)) {
+        TFTPs_MetaSet(p_name, TFTPs_META_STATE_MISSING, 0u);
+    }
+#endif
+
+    return (p_handle);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FS_HandleGet()
+*
+* Description : Get the shared handle of a file, if the file is already open for reading.
+*
+* Argument(s) : p_name      Name of the file.
+*
+* Return(s)   : Pointer to the shared handle, if found.
+*
+*               Pointer to NULL,              otherwise.
+*
+* Caller(s)   : TFTPs_FS_Open().
+*
+* Note(s)     : (1) A handle NOT used anymore is used again, & kept open (see 'tftp-s_fs.c  Note #6').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  TFTPs_FS_HANDLE  *TFTPs_FS_HandleGet (CPU_CHAR  *p_name)
+{
+    TFTPs_FS_HANDLE  *p_handle;
+    CPU_SIZE_T        name_len;
+    CPU_INT16U        ix;
+    CPU_INT16S        cmp;
+
+
+    name_len = Str_Len_N(p_name, TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX + 1u);
+    if (name_len > TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX) {
+        return (DEF_NULL);
+    }
+
+    for (ix = 0u; ix < TFTPs_FS_HandleNbr; ix++) {
+        p_handle = &TFTPs_FS_HandleTbl[ix];
+        if ((p_handle->FileHandlePtr == DEF_NULL) ||
+            (p_handle->Stale         == DEF_YES)) {
+            continue;
+        }
+
+        cmp = Str_Cmp_N(p_handle->Name, p_name, TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX + 1u);
+        if (cmp == 0) {
+            if (p_handle->RefCtr == 0u) {                       /* See Note #1.                                         */
+                TFTPs_TmrStop(&p_handle->TmrIdle);
+            }
+            p_handle->RefCtr++;
+            return (p_handle);
+        }
+    }
+
+    return (DEF_NULL);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FS_HandleAdd()
+*
+* Description : Share the handle of a file just opened for reading.
+*
+* Argument(s) : p_name      Name of the file.
+*
+*               p_file      Pointer to file, holding the handle to share.
+*
+* Return(s)   : Pointer to the shared handle, if NO error.
+*
+*               Pointer to NULL,              otherwise.
+*
+* Caller(s)   : TFTPs_FS_Open().
+*
+* Note(s)     : (1) When all the handles are in use, the first handle NOT used anymore is closed & used
+*                   for the file.  The file keeps its handle private when NO handle can be used.
+*
+*               (2) The file, just opened, is at the start of the file.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  TFTPs_FS_HANDLE  *TFTPs_FS_HandleAdd (CPU_CHAR       *p_name,
+                                              TFTPs_FS_FILE  *p_file)
+{
+    TFTPs_FS_HANDLE  *p_handle;
+    TFTPs_FS_HANDLE  *p_handle_idle;
+    CPU_SIZE_T        name_len;
+    CPU_INT16U        ix;
+
+
+    name_len = Str_Len_N(p_name, TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX + 1u);
+    if (name_len > TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX) {
+        return (DEF_NULL);
+    }
+
+    p_handle      = DEF_NULL;
+    p_handle_idle = DEF_NULL;
+    for (ix = 0u; ix < TFTPs_FS_HandleNbr; ix++) {
+        if (TFTPs_FS_HandleTbl[ix].FileHandlePtr == DEF_NULL) {
+            p_handle = &TFTPs_FS_HandleTbl[ix];
+            break;
+        }
+        if ((p_handle_idle                  == DEF_NULL) &&
+            (TFTPs_FS_HandleTbl[ix].RefCtr  == 0u)) {
+            p_handle_idle = &TFTPs_FS_HandleTbl[ix];
+        }
+    }
+
+    if (p_handle == DEF_NULL) {                                 /* See Note #1.                                         */
+        if (p_handle_idle == DEF_NULL) {
+            return (DEF_NULL);
+        }
+        TFTPs_FS_HandleClose(p_handle_idle);
+        p_handle = p_handle_idle;
+    }
+
+    Mem_Copy(p_handle->Name, p_name, name_len);
+    p_handle->Name[name_len]  = ASCII_CHAR_NULL;
+    p_handle->FileHandlePtr   = p_file->FileHandlePtr;
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    p_handle->LZ4_DecPtr      = p_file->LZ4_DecPtr;
+#endif
+    p_handle->Pos             = 0u;                             /* See Note #2.                                         */
+    p_handle->RefCtr          = 1u;
+    p_handle->Stale           = DEF_NO;
+
+    return (p_handle);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FS_HandleDrop()
+*
+* Description : Stop sharing the handles of a file opened for writing.
+*
+* Argument(s) : p_name      Name of the file.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Open().
+*
+* Note(s)     : (1) Handles NOT used anymore are closed; handles in use are closed once released (see
+*                   'tftp-s_fs.h  SHARED FILE HANDLE DATA TYPE  Note #3').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  void  TFTPs_FS_HandleDrop (CPU_CHAR  *p_name)
+{
+    TFTPs_FS_HANDLE  *p_handle;
+    CPU_INT16U        ix;
+    CPU_INT16S        cmp;
+
+
+    for (ix = 0u; ix < TFTPs_FS_HandleNbr; ix++) {
+        p_handle = &TFTPs_FS_HandleTbl[ix];
+        if (p_handle->FileHandlePtr == DEF_NULL) {
+            continue;
+        }
+
+        cmp = Str_Cmp_N(p_handle->Name, p_name, TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX + 1u);
+        if (cmp != 0) {
+            continue;
+        }
+
+        if (p_handle->RefCtr == 0u) {                           /* See Note #1.                                         */
+            TFTPs_FS_HandleClose(p_handle);
+        } else {
+            p_handle->Stale = DEF_YES;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_FS_HandleRelease()
+*
+* Description : Release a shared handle, used by a file closed.
+*
+* Argument(s) : p_handle    Pointer to shared handle.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Close().
+*
+* Note(s)     : (1) A handle NOT used anymore is kept open for TFTPs_CFG.FS_HandleIdleTimeout, unless it
+*                   is stale or the timeout is null.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  void  TFTPs_FS_HandleRelease (TFTPs_FS_HANDLE  *p_handle)
+{
+    if (p_handle->RefCtr > 0u) {
+        p_handle->RefCtr--;
+    }
+    if (p_handle->RefCtr > 0u) {
+        return;
+    }
+
+    if ((p_handle->Stale             == DEF_YES) ||             /* See Note #1.                                         */
+        (TFTPs_FS_HandleIdleTimeout  == 0u)) {
+        TFTPs_FS_HandleClose(p_handle);
+        return;
+    }
+
+    TFTPs_TmrStart(&p_handle->TmrIdle, TFTPs_FS_HandleIdleTimeout);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_FS_HandleClose()
+*
+* Description : Close a shared handle NOT used anymore, & free it.
+*
+* Argument(s) : p_handle    Pointer to shared handle.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_HandleAdd(),
+*               TFTPs_FS_HandleDrop(),
+*               TFTPs_FS_HandleRelease(),
+*               TFTPs_FS_HandleTmrHandler().
+*
+* Note(s)     : (1) The chunks of the stream of the handle, read by NO file, are freed.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  void  TFTPs_FS_HandleClose (TFTPs_FS_HANDLE  *p_handle)
+{
+    TFTPs_TmrStop(&p_handle->TmrIdle);
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+    while (p_handle->ChunkHeadPtr != DEF_NULL) {                /* See Note #1.                                         */
+        TFTPs_FS_ChunkDrop(p_handle->ChunkHeadPtr);
+    }
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    if (p_handle->LZ4_DecPtr != DEF_NULL) {
+        TFTPs_LZ4_Close(p_handle->LZ4_DecPtr);
+        p_handle->LZ4_DecPtr = DEF_NULL;
+    }
+#endif
+    NetFS_FileClose(p_handle->FileHandlePtr);
+
+    p_handle->FileHandlePtr = DEF_NULL;
+    p_handle->Name[0]       = ASCII_CHAR_NULL;
+    p_handle->RefCtr        = 0u;
+    p_handle->Stale         = DEF_NO;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_FS_HandleRd()
+*
+* Description : Read data from a position of a file, through its shared handle.
+*
+* Argument(s) : p_handle    Pointer to shared handle.
+*
+*               pos         Position of the data, from the start of the file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Number of octets to read.
+*
+*               p_size_rd   Pointer to variable that will receive the number of octets read.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_FS_Rd(),
+*               TFTPs_FS_StreamRd(),
+*               TFTPs_FS_ChunkFill().
+*
+* Note(s)     : (1) The network file system has NO positional read : the handle is moved to the position,
+*                   when NOT already there (see 'tftp-s_fs.h  SHARED FILE HANDLE DATA TYPE  Note #2').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_FS_HandleRd (TFTPs_FS_HANDLE  *p_handle,
+                                        CPU_INT32U        pos,
+                                        void             *p_dest,
+                                        CPU_SIZE_T        size,
+                                        CPU_SIZE_T       *p_size_rd)
+{
+    CPU_BOOLEAN  ok;
+
+
+    if (p_handle->Pos != pos) {                                 /* See Note #1.                                         */
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+        if (p_handle->LZ4_DecPtr != DEF_NULL) {
+            ok = TFTPs_LZ4_PosSet(p_handle->LZ4_DecPtr, pos);
+        } else
+#endif
+        {
+            ok = NetFS_FilePosSet(p_handle->FileHandlePtr, (CPU_INT32S)pos, NET_FS_SEEK_ORIGIN_START);
+        }
+        if (ok != DEF_OK) {
+            p_handle->Pos = TFTPs_FS_HANDLE_POS_UNKNOWN;
+            return (DEF_FAIL);
+        }
+        p_handle->Pos = pos;
+    }
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    if (p_handle->LZ4_DecPtr != DEF_NULL) {
+        ok = TFTPs_LZ4_Rd(              p_handle->LZ4_DecPtr,
+                                        p_handle->FileHandlePtr,
+                          (CPU_INT08U *)p_dest,
+                                        size,
+                                        p_size_rd);
+    } else
+#endif
+    {
+        ok = NetFS_FileRd(p_handle->FileHandlePtr, p_dest, size, p_size_rd);
+    }
+    if (ok != DEF_OK) {
+        p_handle->Pos = TFTPs_FS_HANDLE_POS_UNKNOWN;
+        return (DEF_FAIL);
+    }
+
+    p_handle->Pos += (CPU_INT32U)*p_size_rd;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_FS_HandleTmrHandler()
+*
+* Description : Close a shared handle left unused for TFTPs_CFG.FS_HandleIdleTimeout.
+*
+* Argument(s) : p_arg       Pointer to shared handle of the timer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrProcess().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  void  TFTPs_FS_HandleTmrHandler (void  *p_arg)
+{
+    TFTPs_FS_HANDLE  *p_handle;
+
+
+    p_handle = (TFTPs_FS_HANDLE *)p_arg;
+    if ((p_handle->FileHandlePtr != DEF_NULL) &&
+        (p_handle->RefCtr        == 0u)) {
+        TFTPs_FS_HandleClose(p_handle);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_FS_StreamRd()
+*
+* Description : Read data from the position of a file sharing its handle, through the stream of the handle.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Number of octets to read.
+*
+*               p_size_rd   Pointer to variable that will receive the number of octets read, fewer than
+*                           'size' at the end of the file.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_FS_Rd().
+*
+* Note(s)     : (1) See 'tftp-s_fs.c  Note #7'.
+*
+*               (2) The chunk read by the file is released as soon as the file reads past it, so that it
+*                   MAY be dropped from the window or reclaimed.
+*
+*               (3) A file reading behind the window fell behind the other files of the stream : it is
+*                   detached from the stream.
+*
+*               (4) A file detached from the stream, or for which NO chunk is available, reads the shared
+*                   handle.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_FS_StreamRd (TFTPs_FS_FILE  *p_file,
+                                        void           *p_dest,
+                                        CPU_SIZE_T      size,
+                                        CPU_SIZE_T     *p_size_rd)
+{
+    TFTPs_FS_HANDLE  *p_handle;
+    TFTPs_FS_CHUNK   *p_chunk;
+    CPU_INT08U       *p_dest_08;
+    CPU_SIZE_T        size_rd;
+    CPU_SIZE_T        size_copy;
+    CPU_INT32U        offset;
+    CPU_BOOLEAN       ok;
+
+
+    p_handle  = p_file->HandlePtr;
+    p_dest_08 = (CPU_INT08U *)p_dest;
+    size_rd   = 0u;
+    while (size_rd < size) {
+        p_chunk = DEF_NULL;
+        if ((TFTPs_FS_ChunkNbr      > 0u) &&                    /* See Note #1.                                         */
+            (p_file->StreamDetached == DEF_NO)) {
+            p_chunk = p_file->ChunkPtr;
+            if ((p_chunk != DEF_NULL) &&                        /* Release chunk read past (see Note #2).               */
+               ((p_file->Pos <  p_chunk->Pos) ||
+                (p_file->Pos -  p_chunk->Pos >= TFTPs_FS_ChunkSize))) {
+                p_chunk->RefCtr--;
+                p_file->ChunkPtr = DEF_NULL;
+                p_chunk          = DEF_NULL;
+            }
+
+            if (p_chunk == DEF_NULL) {
+                p_chunk = TFTPs_FS_ChunkFind(p_handle, p_file->Pos);
+            }
+
+            if (p_chunk == DEF_NULL) {
+                if ((p_handle->ChunkHeadPtr      != DEF_NULL) &&
+                    (p_handle->ChunkHeadPtr->Pos >  p_file->Pos)) {
+                    TFTPs_FS_StreamDetach(p_file);              /* See Note #3.                                         */
+                } else {
+                    p_chunk = TFTPs_FS_ChunkFill(p_handle, p_file->Pos);
+                }
+            }
+        }
+
+        if (p_chunk == DEF_NULL) {                              /* Rd shared handle (see Note #4).                      */
+            ok = TFTPs_FS_HandleRd(p_handle, p_file->Pos, &p_dest_08[size_rd], size - size_rd, &size_copy);
+            if (ok != DEF_OK) {
+                return (DEF_FAIL);
+            }
+            p_file->Pos += (CPU_INT32U)size_copy;
+            size_rd     +=             size_copy;
+            break;
+        }
+
+        if (p_file->ChunkPtr != p_chunk) {
+            p_chunk->RefCtr++;
+            p_file->ChunkPtr = p_chunk;
+        }
+
+        offset = p_file->Pos - p_chunk->Pos;
+        if (offset >= p_chunk->Len) {                           /* End of file.                                         */
+            break;
+        }
+
+        size_copy = DEF_MIN((CPU_SIZE_T)(p_chunk->Len - offset), size - size_rd);
+        Mem_Copy(&p_dest_08[size_rd], &p_chunk->BufPtr[offset], size_copy);
+        p_file->Pos += (CPU_INT32U)size_copy;
+        size_rd     +=             size_copy;
+    }
+
+   *p_size_rd = size_rd;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_FS_StreamDetach()
+*
+* Description : Detach a file from the stream of its shared handle.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Close(),
+*               TFTPs_FS_StreamRd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+static  void  TFTPs_FS_StreamDetach (TFTPs_FS_FILE  *p_file)
+{
+    if (p_file->ChunkPtr != DEF_NULL) {
+        p_file->ChunkPtr->RefCtr--;
+        p_file->ChunkPtr = DEF_NULL;
+    }
+
+    p_file->StreamDetached = DEF_YES;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FS_ChunkFind()
+*
+* Description : Find the chunk of the window of a stream holding a position.
+*
+* Argument(s) : p_handle    Pointer to shared handle of the stream.
+*
+*               pos         Position, from the start of the file.
+*
+* Return(s)   : Pointer to the chunk, if found.
+*
+*               Pointer to NULL,      otherwise.
+*
+* Caller(s)   : TFTPs_FS_StreamRd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+static  TFTPs_FS_CHUNK  *TFTPs_FS_ChunkFind (TFTPs_FS_HANDLE  *p_handle,
+                                             CPU_INT32U        pos)
+{
+    TFTPs_FS_CHUNK  *p_chunk;
+
+
+    p_chunk = p_handle->ChunkHeadPtr;
+    while ((p_chunk      != DEF_NULL) &&                        /* Window is ordered by pos.                            */
+           (p_chunk->Pos <= pos)) {
+        if (pos - p_chunk->Pos < TFTPs_FS_ChunkSize) {
+            return (p_chunk);
+        }
+        p_chunk = p_chunk->NextPtr;
+    }
+
+    return (DEF_NULL);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FS_ChunkFill()
+*
+* Description : Read the chunk of a file holding a position, & add it to the window of the stream.
+*
+* Argument(s) : p_handle    Pointer to shared handle of the stream.
+*
+*               pos         Position, from the start of the file.
+*
+* Return(s)   : Pointer to the chunk read, if NO error.
+*
+*               Pointer to NULL,           otherwise.
+*
+* Caller(s)   : TFTPs_FS_StreamRd().
+*
+* Note(s)     : (1) The first chunk of a full window is dropped (see 'tftp-s_fs.c  Note #7').
+*
+*               (2) When NO chunk is free, the first chunk read by NO file is reclaimed, from any stream.
+*
+*               (3) Chunks start at a multiple of the chunk size, so that the chunks of a stream never
+*                   overlap.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+static  TFTPs_FS_CHUNK  *TFTPs_FS_ChunkFill (TFTPs_FS_HANDLE  *p_handle,
+                                             CPU_INT32U        pos)
+{
+    TFTPs_FS_CHUNK  *p_chunk;
+    TFTPs_FS_CHUNK  *p_chunk_prev;
+    TFTPs_FS_CHUNK  *p_chunk_next;
+    CPU_SIZE_T       len;
+    CPU_INT16U       ix;
+    CPU_BOOLEAN      ok;
+
+
+    if (p_handle->ChunkNbr >= TFTPs_FS_StreamWinNbr) {          /* See Note #1.                                         */
+        TFTPs_FS_ChunkDrop(p_handle->ChunkHeadPtr);
+    }
+
+    if (TFTPs_FS_ChunkFreePtr == DEF_NULL) {                    /* See Note #2.                                         */
+        for (ix = 0u; ix < TFTPs_FS_ChunkNbr; ix++) {
+            if (TFTPs_FS_ChunkTbl[ix].RefCtr == 0u) {
+                TFTPs_FS_ChunkDrop(&TFTPs_FS_ChunkTbl[ix]);
+                break;
+            }
+        }
+        if (TFTPs_FS_ChunkFreePtr == DEF_NULL) {
+            return (DEF_NULL);
+        }
+    }
+
+    p_chunk               = TFTPs_FS_ChunkFreePtr;
+    TFTPs_FS_ChunkFreePtr = p_chunk->NextPtr;
+
+    p_chunk->Pos = pos - (pos % TFTPs_FS_ChunkSize);            /* See Note #3.                                         */
+    ok           = TFTPs_FS_HandleRd(p_handle,
+                                     p_chunk->Pos,
+                                     p_chunk->BufPtr,
+                                     (CPU_SIZE_T)TFTPs_FS_ChunkSize,
+                                    &len);
+    if (ok != DEF_OK) {
+        p_chunk->NextPtr      = TFTPs_FS_ChunkFreePtr;
+        TFTPs_FS_ChunkFreePtr = p_chunk;
+        return (DEF_NULL);
+    }
+
+    p_chunk->HandlePtr = p_handle;
+    p_chunk->Len       = (CPU_INT32U)len;
+    p_chunk->RefCtr    = 0u;
+
+    p_chunk_prev = DEF_NULL;                                    /* Insert chunk in window, by pos.                      */
+    p_chunk_next = p_handle->ChunkHeadPtr;
+    while ((p_chunk_next      != DEF_NULL) &&
+           (p_chunk_next->Pos <  p_chunk->Pos)) {
+        p_chunk_prev = p_chunk_next;
+        p_chunk_next = p_chunk_next->NextPtr;
+    }
+
+    p_chunk->NextPtr = p_chunk_next;
+    if (p_chunk_prev == DEF_NULL) {
+        p_handle->ChunkHeadPtr = p_chunk;
+    } else {
+        p_chunk_prev->NextPtr  = p_chunk;
+    }
+    p_handle->ChunkNbr++;
+
+    return (p_chunk);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_FS_ChunkDrop()
+*
+* Description : Drop a chunk from the window of its stream, & free it.
+*
+* Argument(s) : p_chunk     Pointer to chunk.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_HandleClose(),
+*               TFTPs_FS_ChunkFill().
+*
+* Note(s)     : (1) The files still reading the chunk are detached from the stream (see 'tftp-s_fs.c
+*                   Note #7').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+static  void  TFTPs_FS_ChunkDrop (TFTPs_FS_CHUNK  *p_chunk)
+{
+    TFTPs_FS_HANDLE  *p_handle;
+    TFTPs_FS_CHUNK   *p_chunk_prev;
+    TFTPs_FS_FILE    *p_file;
+    CPU_INT16U        ix;
+
+
+    p_handle     = p_chunk->HandlePtr;
+    p_chunk_prev = DEF_NULL;                                    /* Unlink chunk from window.                            */
+    if (p_handle->ChunkHeadPtr != p_chunk) {
+        p_chunk_prev = p_handle->ChunkHeadPtr;
+        while (p_chunk_prev->NextPtr != p_chunk) {
+            p_chunk_prev = p_chunk_prev->NextPtr;
+        }
+    }
+
+    if (p_chunk_prev == DEF_NULL) {
+        p_handle->ChunkHeadPtr = p_chunk->NextPtr;
+    } else {
+        p_chunk_prev->NextPtr  = p_chunk->NextPtr;
+    }
+    p_handle->ChunkNbr--;
+
+    if (p_chunk->RefCtr > 0u) {                                 /* See Note #1.                                         */
+        for (ix = 0u; ix < TFTPs_FS_FileNbr; ix++) {
+            p_file = &TFTPs_FS_FileTbl[ix];
+            if (p_file->ChunkPtr == p_chunk) {
+                TFTPs_FS_StreamDetach(p_file);
+            }
+        }
+    }
+
+    p_chunk->HandlePtr    = DEF_NULL;
+    p_chunk->NextPtr      = TFTPs_FS_ChunkFreePtr;
+    TFTPs_FS_ChunkFreePtr = p_chunk;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_FS_ProviderOpen()
+*
+* Description : Open a file with the first provider whose name matches.
+*
+* Argument(s) : p_file      Pointer to file.
+*
+*               p_name      Name of the file.
+*
+*               p_match     Pointer to variable that will receive :
+*
+*                               DEF_YES     if a provider serves the file,
+*                               DEF_NO      otherwise.
+*
+* Return(s)   : DEF_OK,   if the file was opened by a provider.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_FS_Open().
+*
+* Note(s)     : (1) A name matched by a provider is NOT looked for in the file system, even if the provider
+*                   fails to open it (see 'tftp-s_type.h  FILE PROVIDER DATA TYPE  Note #2').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_FS_ProviderOpen (TFTPs_FS_FILE  *p_file,
+                                            CPU_CHAR       *p_name,
+                                            CPU_BOOLEAN    *p_match)
+{
+    const  TFTPs_FS_PROVIDER  *p_provider;
+           void               *p_handle;
+           CPU_INT08U          provider_nbr;
+           CPU_INT08U          ix;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    provider_nbr = TFTPs_FS_ProviderNbr;
+    CPU_CRITICAL_EXIT();
+
+   *p_match = DEF_NO;
+    for (ix = 0u; ix < provider_nbr; ix++) {
+        p_provider = TFTPs_FS_ProviderTbl[ix];
+        if (p_provider->Match(p_name) == DEF_YES) {
+           *p_match  = DEF_YES;                                 /* See Note #1.                                         */
+            p_handle = p_provider->Open(p_name);
+            if (p_handle == DEF_NULL) {
+                return (DEF_FAIL);
+            }
+            p_file->FileHandlePtr = p_handle;
+            p_file->ProviderPtr   = p_provider;
+            p_file->Pos           = 0u;
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+#endif
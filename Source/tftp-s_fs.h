@@ -0,0 +1,253 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     TFTP SERVER FILE STORAGE
+*
+* Filename : tftp-s_fs.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs file storage present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_FS_MODULE_PRESENT                                /* See Note #1.                                         */
+#define  TFTPs_FS_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+#include  "tftp-s_lz4.h"
+#include  "tftp-s_meta.h"
+#include  "tftp-s_tmr.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_FS_ACCESS_RD                                0u
+#define  TFTPs_FS_ACCESS_WR                                1u
+
+#define  TFTPs_FS_NAME_LEN_MAX                           255u   /* Max len of a file name.                              */
+#define  TFTPs_FS_LZ4_EXT                             ".lz4"    /* Ext of LZ4 files (see 'tftp-s_fs.c  Note #2').       */
+
+#define  TFTPs_FS_HANDLE_POS_UNKNOWN            DEF_INT_32U_MAX_VAL
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      STREAM CHUNK DATA TYPE
+*
+* Note(s) : (1) A chunk holds TFTPs_CFG.FS_StreamChunkSize octets of a file read through a shared handle,
+*               from position 'Pos' (see 'tftp-s_fs.c  Note #7').  'Len' is fewer than the chunk size
+*               only for the last chunk of the file.
+*
+*           (2) 'RefCtr' is the number of files reading from the chunk.  A chunk NOT read by any file MAY
+*               be reclaimed for another stream.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+typedef  struct  tftps_fs_chunk  TFTPs_FS_CHUNK;
+
+struct  tftps_fs_chunk {
+    struct  tftps_fs_handle  *HandlePtr;                        /* Stream of chunk, NULL if free.                       */
+    CPU_INT08U               *BufPtr;                           /* Data of chunk.                                       */
+    CPU_INT32U                Pos;                              /* Pos of data in file             (see Note #1).       */
+    CPU_INT32U                Len;                              /* Len of data                     (see Note #1).       */
+    CPU_INT16U                RefCtr;                           /* Nbr of files reading chunk      (see Note #2).       */
+    TFTPs_FS_CHUNK           *NextPtr;                          /* Next chunk of stream, or next free chunk.            */
+};
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      SHARED FILE HANDLE DATA TYPE
+*
+* Note(s) : (1) A file opened for reading is opened once, & its handle shared by the files of all the
+*               sessions reading it (see 'tftp-s_fs.c  Note #6').  'RefCtr' is the number of files using the
+*               handle; a handle NOT used anymore is closed once 'TmrIdle' expires.
+*
+*           (2) 'Pos' is the position of the handle, i.e. of the next octet read from the file.  The files
+*               sharing a handle each keep their own position, & the handle is moved to the position of a
+*               file before the file is read, unless it is already there.  'Pos' is set to
+*               TFTPs_FS_HANDLE_POS_UNKNOWN when a read or a move of the handle fails.
+*
+*           (3) A handle is stale once its file is opened for writing : it is no longer shared, & it is
+*               closed as soon as it is NOT used anymore.
+*
+*           (4) The chunks read through the handle form its stream window, ordered by position (see
+*               'tftp-s_fs.c  Note #7').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+typedef  struct  tftps_fs_handle {
+                                                                /* File name.                                           */
+    CPU_CHAR                  Name[TFTPs_CFG_FS_HANDLE_NAME_LEN_MAX + 1u];
+    void                     *FileHandlePtr;                    /* File handle, NULL if free.                           */
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    TFTPs_LZ4_DEC            *LZ4_DecPtr;                       /* Decoder, NULL if NOT compressed.                     */
+#endif
+    CPU_INT32U                Pos;                              /* Pos of handle                   (see Note #2).       */
+    CPU_INT16U                RefCtr;                           /* Nbr of files using handle       (see Note #1).       */
+    CPU_BOOLEAN               Stale;                            /* Handle NOT shared anymore       (see Note #3).       */
+    TFTPs_TMR                 TmrIdle;                          /* Closes unused handle            (see Note #1).       */
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+    TFTPs_FS_CHUNK           *ChunkHeadPtr;                     /* First chunk of window           (see Note #4).       */
+    CPU_INT16U                ChunkNbr;                         /* Nbr of chunks of window         (see Note #4).       */
+#endif
+} TFTPs_FS_HANDLE;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FILE DATA TYPE
+*
+* Note(s) : (1) 'FileHandlePtr' is the handle of the file opened with the network file system (see
+*               'net_fs.h').  Reads of a compressed file go through its decoder, which reads the file.
+*
+*           (2) For a file served by a file provider, 'FileHandlePtr' is the handle returned by the
+*               provider & 'Pos' the offset of the next read, as providers read at a given offset.
+*
+*           (3) 'Size' is the size of a file read, taken from the file metadata index or queried once when
+*               the file is opened (see 'tftp-s_fs.c  Note #5').  'MetaHash' is the hash of the name of a
+*               file written, whose entry is removed from the index once the file is closed.
+*
+*           (4) A file read through a shared handle (see 'SHARED FILE HANDLE DATA TYPE') points to it with
+*               'HandlePtr', & 'Pos' is the offset of the next read of the file.
+*
+*           (5) 'ChunkPtr' is the chunk of the stream window of the shared handle the file reads from.  A
+*               file falling behind the window is detached from the stream, & reads the shared handle
+*               from then on (see 'tftp-s_fs.c  Note #7').
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_fs_file  TFTPs_FS_FILE;
+
+struct  tftps_fs_file {
+    void                     *FileHandlePtr;                    /* File handle          (see Notes #1 & #2).            */
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    TFTPs_LZ4_DEC            *LZ4_DecPtr;                       /* Decoder, NULL if NOT compressed (see Note #1).       */
+#endif
+#if (TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED)
+    const  TFTPs_FS_PROVIDER *ProviderPtr;                      /* Provider, NULL if NOT provided  (see Note #2).       */
+#endif
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    TFTPs_FS_HANDLE          *HandlePtr;                        /* Shared handle, NULL if none     (see Note #4).       */
+#endif
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+    TFTPs_FS_CHUNK           *ChunkPtr;                         /* Chunk read, NULL if none        (see Note #5).       */
+    CPU_BOOLEAN               StreamDetached;                   /* File detached from stream       (see Note #5).       */
+#endif
+#if ((TFTPs_CFG_FS_PROVIDER_EN == DEF_ENABLED) || \
+     (TFTPs_CFG_FS_HANDLE_EN   == DEF_ENABLED))
+    CPU_INT32U                Pos;                              /* Pos of next rd  (see Notes #2 & #4).                 */
+#endif
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+    CPU_INT32U                Size;                             /* File size, if known             (see Note #3).       */
+    CPU_INT32U                MetaHash;                         /* Hash of name of file written    (see Note #3).       */
+    CPU_BOOLEAN               MetaWr;                           /* File written.                                        */
+#endif
+    TFTPs_FS_FILE            *NextPtr;                          /* Next free file.                                      */
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void            TFTPs_FS_Init   (const  TFTPs_CFG      *p_cfg,
+                                        TFTPs_ERR      *p_err);
+
+TFTPs_FS_FILE  *TFTPs_FS_Open   (       CPU_CHAR       *p_name,
+                                        CPU_INT08U      access);
+
+void            TFTPs_FS_Close  (       TFTPs_FS_FILE  *p_file);
+
+CPU_BOOLEAN     TFTPs_FS_Rd     (       TFTPs_FS_FILE  *p_file,
+                                        void           *p_dest,
+                                        CPU_SIZE_T      size,
+                                        CPU_SIZE_T     *p_size_rd);
+
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+CPU_BOOLEAN     TFTPs_FS_Wr     (       TFTPs_FS_FILE  *p_file,
+                                        void           *p_src,
+                                        CPU_SIZE_T      size,
+                                        CPU_SIZE_T     *p_size_wr);
+#endif
+
+CPU_BOOLEAN     TFTPs_FS_PosSet (       TFTPs_FS_FILE  *p_file,
+                                        CPU_INT32U      pos);
+
+CPU_BOOLEAN     TFTPs_FS_PosGet (       TFTPs_FS_FILE  *p_file,
+                                        CPU_INT32U     *p_pos);
+
+CPU_BOOLEAN     TFTPs_FS_SizeGet(       TFTPs_FS_FILE  *p_file,
+                                        CPU_INT32U     *p_size);
+
+#if ((TFTPs_CFG_SIM_EN       == DEF_ENABLED) && \
+     (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED))
+void            TFTPs_FS_HandleClr(void);
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_FS_MODULE_PRESENT  */
@@ -0,0 +1,461 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        TFTP SERVER LISTENERS
+*
+* Filename : tftp-s_listen.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Listeners let a single server serve several interfaces or ports, each with its own policy
+*                (see 'tftp-s_type.h  LISTENER CONFIGURATION DATA TYPE  Note #2').  The sessions, buffers,
+*                file caches & traffic classes stay shared by all the listeners; the policy of a listener
+*                only bounds what its own sessions take from them, so that the traffic of one network
+*                segment can NOT starve the others.
+*
+*            (2) This module is NOT re-entrant & MUST only be called from the TFTP server task context.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_LISTEN_MODULE
+#include  "tftp-s_listen.h"
+#include  "tftp-s_tmr.h"
+#include  <Source/net_cfg_net.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_listen {
+    const  TFTPs_LISTEN_CFG  *CfgPtr;                           /* Listener cfg.                                        */
+    CPU_INT16U                SessNbr;                          /* Nbr of active sessions.                              */
+    TFTPs_SHAPE_BUCKET        Shape;                            /* Listener token bucket.                               */
+} TFTPs_LISTEN;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_LISTEN      *TFTPs_ListenTbl;                     /* Listeners.                                           */
+static  CPU_INT08U         TFTPs_ListenNbr;                     /* Nbr of listeners.                                    */
+static  CPU_INT16U         TFTPs_ListenWinSizeMaxDflt;          /* Server max window size.                              */
+static  TFTPs_LISTEN_CFG   TFTPs_ListenCfgDflt;                 /* Cfg of single listener (see 'TFTPs_ListenInit()').   */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  TFTPs_ListenSockSelChk(TFTPs_SOCK_SEL  sock_sel);
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_ListenInit()
+*
+* Description : Validate the listener table of the configuration & allocate the listeners.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_SOCK_FAMILY
+*                               TFTPs_ERR_CFG_INVALID_LISTEN
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) Without a listener table, a single listener is built from the 'SockSel' & 'Port' of the
+*                   configuration (see 'tftp-s_type.h  CONFIGURATION DATA TYPE  Note #18').
+*
+*               (2) Several server sockets are waited on at once with a socket select (see 'tftp-s.c
+*                   Note #11').
+*
+*               (3) Buckets start full (see 'tftp-s_shape.c  TFTPs_ShapeInit()  Note #1').
+*********************************************************************************************************
+*/
+
+void  TFTPs_ListenInit (const  TFTPs_CFG  *p_cfg,
+                               TFTPs_ERR  *p_err)
+{
+    const  TFTPs_LISTEN_CFG  *p_tbl;
+    const  TFTPs_LISTEN_CFG  *p_listen_cfg;
+           TFTPs_LISTEN      *p_listen;
+           CPU_INT08U         listen_nbr;
+           CPU_INT08U         family_nbr;
+           CPU_INT16U         sock_nbr;
+           CPU_INT08U         ix;
+           CPU_INT08U         i;
+           LIB_ERR            err_lib;
+
+
+    if ((p_cfg->ListenNbr    > 0u)       &&
+        (p_cfg->ListenTblPtr == DEF_NULL)) {
+       *p_err = TFTPs_ERR_CFG_INVALID_LISTEN;
+        return;
+    }
+
+    p_tbl      = p_cfg->ListenTblPtr;
+    listen_nbr = p_cfg->ListenNbr;
+    if (listen_nbr == 0u) {                                     /* See Note #1.                                         */
+        Mem_Clr(&TFTPs_ListenCfgDflt, sizeof(TFTPs_ListenCfgDflt));
+        TFTPs_ListenCfgDflt.SockSel = p_cfg->SockSel;
+        TFTPs_ListenCfgDflt.Port    = p_cfg->Port;
+        p_tbl                       = &TFTPs_ListenCfgDflt;
+        listen_nbr                  = 1u;
+    }
+
+    sock_nbr = 0u;
+    for (ix = 0u; ix < listen_nbr; ix++) {
+        p_listen_cfg = &p_tbl[ix];
+
+        family_nbr = TFTPs_ListenSockSelChk(p_listen_cfg->SockSel);
+        if (family_nbr == 0u) {
+           *p_err = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
+            return;
+        }
+
+        if (family_nbr > 1u) {                                  /* Dual-family listeners bind any addr.                 */
+            for (i = 0u; i < sizeof(p_listen_cfg->Addr); i++) {
+                if (p_listen_cfg->Addr[i] != 0u) {
+                   *p_err = TFTPs_ERR_CFG_INVALID_LISTEN;
+                    return;
+                }
+            }
+        }
+
+        if ((p_listen_cfg->ShapeRate  != TFTPs_SHAPE_RATE_UNLIMITED) &&
+            (p_listen_cfg->ShapeBurst == 0u)) {
+           *p_err = TFTPs_ERR_CFG_INVALID_LISTEN;
+            return;
+        }
+        if (p_listen_cfg->ShapeBurst > TFTPs_SHAPE_BURST_MAX) {
+           *p_err = TFTPs_ERR_CFG_INVALID_LISTEN;
+            return;
+        }
+
+        sock_nbr += family_nbr;
+    }
+
+#if (NET_SOCK_CFG_SEL_EN != DEF_ENABLED)
+    if (sock_nbr > 1u) {                                        /* See Note #2.                                         */
+       *p_err = TFTPs_ERR_CFG_INVALID_SOCK_FAMILY;
+        return;
+    }
+#endif
+
+    TFTPs_ListenTbl = (TFTPs_LISTEN *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Listener Tbl",
+                                                              DEF_NULL,
+                                                   (CPU_SIZE_T)listen_nbr * sizeof(TFTPs_LISTEN),
+                                                             &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    for (ix = 0u; ix < listen_nbr; ix++) {
+        p_listen                = &TFTPs_ListenTbl[ix];
+        p_listen->CfgPtr        = &p_tbl[ix];
+        p_listen->SessNbr       =  0u;
+                                                                /* See Note #3.                                         */
+        p_listen->Shape.Tokens  = (CPU_INT32S)p_tbl[ix].ShapeBurst;
+        p_listen->Shape.TS_Last =  TFTPs_TmrNowGet();
+    }
+
+    TFTPs_ListenNbr            = listen_nbr;
+    TFTPs_ListenWinSizeMaxDflt = p_cfg->WinSizeMax;
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ListenNbrGet()
+*
+* Description : Get the number of listeners.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Number of listeners.
+*
+* Caller(s)   : TFTPs_Init(),
+*               TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  TFTPs_ListenNbrGet (void)
+{
+    return (TFTPs_ListenNbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ListenCfgGet()
+*
+* Description : Get the configuration of a listener.
+*
+* Argument(s) : listen_ix   Index of the listener.
+*
+* Return(s)   : Pointer to configuration of the listener.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+const  TFTPs_LISTEN_CFG  *TFTPs_ListenCfgGet (CPU_INT08U  listen_ix)
+{
+    return (TFTPs_ListenTbl[listen_ix].CfgPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ListenAdmit()
+*
+* Description : Check whether a new session of a listener may be allocated.
+*
+* Argument(s) : listen_ix   Index of the listener of the new session.
+*
+* Return(s)   : DEF_YES, if the listener holds fewer sessions than its maximum, or has NO maximum.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_ListenAdmit (CPU_INT08U  listen_ix)
+{
+    TFTPs_LISTEN  *p_listen;
+
+
+    p_listen = &TFTPs_ListenTbl[listen_ix];
+    if ((p_listen->CfgPtr->SessNbrMax >  0u) &&
+        (p_listen->SessNbr            >= p_listen->CfgPtr->SessNbrMax)) {
+        return (DEF_NO);
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_ListenSessAdd()
+*
+* Description : Count a new session of a listener.
+*
+* Argument(s) : listen_ix   Index of the listener of the session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ListenSessAdd (CPU_INT08U  listen_ix)
+{
+    if (listen_ix >= TFTPs_ListenNbr) {
+        return;
+    }
+
+    TFTPs_ListenTbl[listen_ix].SessNbr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_ListenSessRemove()
+*
+* Description : Uncount a terminated session of a listener.
+*
+* Argument(s) : listen_ix   Index of the listener of the session.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Terminate().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ListenSessRemove (CPU_INT08U  listen_ix)
+{
+    if ((listen_ix                           >= TFTPs_ListenNbr) ||
+        (TFTPs_ListenTbl[listen_ix].SessNbr ==  0u)) {
+        return;
+    }
+
+    TFTPs_ListenTbl[listen_ix].SessNbr--;
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_ListenWinSizeMaxGet()
+*
+* Description : Get the largest window size granted to the requests of a listener.
+*
+* Argument(s) : listen_ix   Index of the listener.
+*
+* Return(s)   : Max window size of the listener, if configured.
+*
+*               Max window size of the server,   otherwise.
+*
+* Caller(s)   : TFTPs_ReqStart().
+*
+* Note(s)     : (1) See 'tftp-s_type.h  LISTENER CONFIGURATION DATA TYPE  Note #2c'.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  TFTPs_ListenWinSizeMaxGet (CPU_INT08U  listen_ix)
+{
+    CPU_INT16U  win_size_max;
+
+
+    win_size_max = TFTPs_ListenTbl[listen_ix].CfgPtr->WinSizeMax;
+    if (win_size_max == 0u) {                                   /* See Note #1.                                         */
+        win_size_max =  TFTPs_ListenWinSizeMaxDflt;
+    }
+
+    return (win_size_max);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_ListenBucketGet()
+*
+* Description : Get the token bucket of a listener & its parameters.
+*
+* Argument(s) : listen_ix   Index of the listener.
+*
+*               p_rate      Pointer to variable that will receive the rate of the bucket, in octets per second.
+*
+*               p_burst     Pointer to variable that will receive the burst size of the bucket, in octets.
+*
+* Return(s)   : Pointer to token bucket of the listener.
+*
+* Caller(s)   : TFTPs_ShapeTxDlyGet(),
+*               TFTPs_ShapeTxDone().
+*
+* Note(s)     : (1) The bucket is disabled when the rate is TFTPs_SHAPE_RATE_UNLIMITED (see 'tftp-s_shape.c
+*                   Note #4').
+*********************************************************************************************************
+*/
+
+TFTPs_SHAPE_BUCKET  *TFTPs_ListenBucketGet (CPU_INT08U   listen_ix,
+                                            CPU_INT32U  *p_rate,
+                                            CPU_INT32U  *p_burst)
+{
+    TFTPs_LISTEN  *p_listen;
+
+
+    p_listen = &TFTPs_ListenTbl[listen_ix];
+   *p_rate   =  p_listen->CfgPtr->ShapeRate;                    /* See Note #1.                                         */
+   *p_burst  =  p_listen->CfgPtr->ShapeBurst;
+
+    return (&p_listen->Shape);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_ListenSockSelChk()
+*
+* Description : Validate the IP families of a listener.
+*
+* Argument(s) : sock_sel    IP families of the listener.
+*
+* Return(s)   : Number of IP families of the listener, if supported by the network stack.
+*
+*               0,                                     otherwise.
+*
+* Caller(s)   : TFTPs_ListenInit().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  TFTPs_ListenSockSelChk (TFTPs_SOCK_SEL  sock_sel)
+{
+    switch (sock_sel) {
+#ifdef  NET_IPv4_MODULE_EN
+        case TFTPs_SOCK_SEL_IPv4:
+             return (1u);
+#endif
+
+#ifdef  NET_IPv6_MODULE_EN
+        case TFTPs_SOCK_SEL_IPv6:
+             return (1u);
+#endif
+
+#if (defined(NET_IPv4_MODULE_EN) && \
+     defined(NET_IPv6_MODULE_EN))
+        case TFTPs_SOCK_SEL_IPv4_IPv6:
+             return (2u);
+#endif
+
+        default:
+             return (0u);
+    }
+}
@@ -0,0 +1,90 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        TFTP SERVER LISTENERS
+*
+* Filename : tftp-s_listen.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs listen present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_LISTEN_MODULE_PRESENT                            /* See Note #1.                                         */
+#define  TFTPs_LISTEN_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+#include  "tftp-s_shape.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void                      TFTPs_ListenInit         (const  TFTPs_CFG   *p_cfg,
+                                                           TFTPs_ERR   *p_err);
+
+CPU_INT08U                TFTPs_ListenNbrGet       (void);
+
+const  TFTPs_LISTEN_CFG  *TFTPs_ListenCfgGet       (CPU_INT08U   listen_ix);
+
+CPU_BOOLEAN               TFTPs_ListenAdmit        (CPU_INT08U   listen_ix);
+
+void                      TFTPs_ListenSessAdd      (CPU_INT08U   listen_ix);
+
+void                      TFTPs_ListenSessRemove   (CPU_INT08U   listen_ix);
+
+CPU_INT16U                TFTPs_ListenWinSizeMaxGet(CPU_INT08U   listen_ix);
+
+TFTPs_SHAPE_BUCKET       *TFTPs_ListenBucketGet    (CPU_INT08U   listen_ix,
+                                                    CPU_INT32U  *p_rate,
+                                                    CPU_INT32U  *p_burst);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_LISTEN_MODULE_PRESENT  */
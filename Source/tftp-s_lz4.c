@@ -0,0 +1,913 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER LZ4 FRAME DECODER
+*
+* Filename : tftp-s_lz4.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Decodes files stored in the LZ4 frame format, version 1.6 :
+*
+*                    | Magic | FLG | BD | (Content Size) | HC | Block 1 | ... | Block N | EndMark | (Checksum) |
+*
+*                (a) Only frames of independent blocks (i.e. FLG 'B.Indep' set) are decoded, so that any
+*                    block can be decoded without the blocks before it.  Frames using a dictionary are
+*                    NOT decoded.
+*
+*                (b) The header, block & content checksums are skipped, NOT verified.
+*
+*                (c) A file holds a single frame; skippable & concatenated frames are NOT supported.
+*
+*            (2) The header of every block is read when the file is opened, & its offset recorded in the
+*                seek index of the decoder.  A read at any decoded position, e.g. for a retransmission or
+*                a go-back of a window, only decodes the block holding that position.
+*
+*            (3) The block decoder checks every literal & match length against the source & destination
+*                buffers, so that a corrupted file can NOT make it read or write out of bounds.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_LZ4_MODULE
+#include  "tftp-s_lz4.h"
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_LZ4_MAGIC                          0x184D2204u   /* Frame magic nbr.                                     */
+
+#define  TFTPs_LZ4_FLG_VER_MASK                         0xC0u   /* FLG version, MUST be 01.                             */
+#define  TFTPs_LZ4_FLG_VER_01                           0x40u
+#define  TFTPs_LZ4_FLG_BLK_INDEP                  DEF_BIT_05    /* Independent blks.                                    */
+#define  TFTPs_LZ4_FLG_BLK_CHKSUM                 DEF_BIT_04    /* Blk checksum present.                                */
+#define  TFTPs_LZ4_FLG_CONTENT_SIZE               DEF_BIT_03    /* Content size present.                                */
+#define  TFTPs_LZ4_FLG_DICT_ID                    DEF_BIT_00    /* Dictionary ID present.                               */
+
+#define  TFTPs_LZ4_BD_BLK_SIZE_SHIFT                       4u   /* BD blk max size field.                               */
+#define  TFTPs_LZ4_BD_BLK_SIZE_MASK                     0x07u
+#define  TFTPs_LZ4_BD_BLK_SIZE_CODE_MIN                    4u   /* Code 4 = 64 KB, ... 7 = 4 MB.                        */
+
+#define  TFTPs_LZ4_HDR_SIZE_FIXED                          6u   /* Magic, FLG & BD.                                     */
+#define  TFTPs_LZ4_HDR_SIZE_CONTENT                        8u
+#define  TFTPs_LZ4_BLK_HDR_SIZE                            4u
+#define  TFTPs_LZ4_BLK_CHKSUM_SIZE                         4u
+#define  TFTPs_LZ4_BLK_UNCOMPRESSED               DEF_BIT_31    /* Blk stored uncompressed.                             */
+
+#define  TFTPs_LZ4_MATCH_LEN_MIN                           4u
+#define  TFTPs_LZ4_LEN_EXT                                15u   /* Len continued on following octets.                   */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_LZ4_DEC  *TFTPs_LZ4_DecFreePtr;                   /* Free decoders list.                                  */
+static  CPU_INT32U      TFTPs_LZ4_BlkSizeMax;
+static  CPU_INT32U      TFTPs_LZ4_IdxNbrMax;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_LZ4_HdrParse (TFTPs_LZ4_DEC     *p_dec,
+                                         void              *p_file,
+                                         CPU_INT32U        *p_off,
+                                         CPU_INT32U        *p_size);
+
+static  CPU_BOOLEAN  TFTPs_LZ4_IdxBuild (TFTPs_LZ4_DEC     *p_dec,
+                                         void              *p_file,
+                                         CPU_INT32U         off);
+
+static  CPU_BOOLEAN  TFTPs_LZ4_BlkLoad  (TFTPs_LZ4_DEC     *p_dec,
+                                         void              *p_file,
+                                         CPU_INT32U         blk_ix);
+
+static  CPU_BOOLEAN  TFTPs_LZ4_BlkDecode(const  CPU_INT08U  *p_src,
+                                         CPU_INT32U          src_len,
+                                         CPU_INT08U         *p_dest,
+                                         CPU_INT32U          dest_size,
+                                         CPU_INT32U         *p_dest_len);
+
+static  CPU_BOOLEAN  TFTPs_LZ4_FileRd   (void              *p_file,
+                                         CPU_INT32U         off,
+                                         CPU_INT08U        *p_dest,
+                                         CPU_INT32U         len);
+
+static  CPU_INT32U   TFTPs_LZ4_RdLE32   (const  CPU_INT08U  *p_src);
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_LZ4_Init()
+*
+* Description : Allocate the LZ4 frame decoders.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_LZ4
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Init().
+*
+* Note(s)     : (1) A configuration without decoder disables LZ4 files, without allocating any memory.
+*
+*               (2) Every frame may use blocks of 64 KB, the smallest block size of the format.
+*********************************************************************************************************
+*/
+
+void  TFTPs_LZ4_Init (const  TFTPs_CFG  *p_cfg,
+                             TFTPs_ERR  *p_err)
+{
+    TFTPs_LZ4_DEC  *p_dec;
+    CPU_INT16U      ix;
+    LIB_ERR         err_lib;
+
+
+    TFTPs_LZ4_DecFreePtr = DEF_NULL;
+    TFTPs_LZ4_BlkSizeMax = p_cfg->LZ4_BlkSizeMax;
+    TFTPs_LZ4_IdxNbrMax  = p_cfg->LZ4_BlkNbrMax;
+
+    if (p_cfg->LZ4_DecNbr == 0u) {                              /* See Note #1.                                         */
+       *p_err = TFTPs_ERR_NONE;
+        return;
+    }
+
+    if ((p_cfg->LZ4_BlkSizeMax < TFTPs_LZ4_BLK_SIZE_MIN) ||     /* See Note #2.                                         */
+        (p_cfg->LZ4_BlkNbrMax  == 0u)) {
+       *p_err = TFTPs_ERR_CFG_INVALID_LZ4;
+        return;
+    }
+
+    for (ix = 0u; ix < p_cfg->LZ4_DecNbr; ix++) {
+        p_dec = (TFTPs_LZ4_DEC *)Mem_SegAlloc((CPU_CHAR *)"TFTPs LZ4 Dec",
+                                                          DEF_NULL,
+                                                          sizeof(TFTPs_LZ4_DEC),
+                                                         &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        p_dec->BlkBufPtr = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs LZ4 Blk Buf",
+                                                                  DEF_NULL,
+                                                                  p_cfg->LZ4_BlkSizeMax,
+                                                                 &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        p_dec->SrcBufPtr = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs LZ4 Src Buf",
+                                                                  DEF_NULL,
+                                                                  p_cfg->LZ4_BlkSizeMax,
+                                                                 &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        p_dec->IdxTbl    = (CPU_INT32U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs LZ4 Idx Tbl",
+                                                                  DEF_NULL,
+                                                                  sizeof(CPU_INT32U) * p_cfg->LZ4_BlkNbrMax,
+                                                                 &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        p_dec->NextPtr       = TFTPs_LZ4_DecFreePtr;
+        TFTPs_LZ4_DecFreePtr = p_dec;
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_LZ4_Open()
+*
+* Description : Get a decoder for an opened file, if the file holds an LZ4 frame it can decode.
+*
+* Argument(s) : p_file      Handle of the opened file.
+*
+* Return(s)   : Pointer to the decoder, positioned at the start of the decoded data, if NO error.
+*
+*               Pointer to NULL,                                                        otherwise.
+*
+* Caller(s)   : TFTPs_FS_Open().
+*
+* Note(s)     : (1) The decoded size of the frame is its content size, when present in the frame header.
+*                   Otherwise, it is found by decoding the last block, which is then ready for the end of
+*                   the transfer.
+*********************************************************************************************************
+*/
+
+TFTPs_LZ4_DEC  *TFTPs_LZ4_Open (void  *p_file)
+{
+    TFTPs_LZ4_DEC  *p_dec;
+    CPU_INT32U      off;
+    CPU_INT32U      size;
+    CPU_INT32U      blk_full_len;
+    CPU_BOOLEAN     ok;
+
+
+    p_dec = TFTPs_LZ4_DecFreePtr;
+    if (p_dec == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    p_dec->IdxNbr    = 0u;
+    p_dec->BlkCurIx  = TFTPs_LZ4_BLK_IX_NONE;
+    p_dec->BlkCurLen = 0u;
+    p_dec->Pos       = 0u;
+
+    ok = TFTPs_LZ4_HdrParse(p_dec, p_file, &off, &size);
+    if (ok != DEF_OK) {
+        return (DEF_NULL);
+    }
+
+    ok = TFTPs_LZ4_IdxBuild(p_dec, p_file, off);
+    if (ok != DEF_OK) {
+        return (DEF_NULL);
+    }
+
+    if (p_dec->IdxNbr == 0u) {                                  /* Empty frame.                                         */
+        if ((size != TFTPs_LZ4_BLK_IX_NONE) &&
+            (size != 0u)) {
+            return (DEF_NULL);
+        }
+        p_dec->Size = 0u;
+
+    } else {
+        blk_full_len = (p_dec->IdxNbr - 1u) * p_dec->BlkSize;
+        if (size == TFTPs_LZ4_BLK_IX_NONE) {                    /* Decode last blk to get size (see Note #1).           */
+            ok = TFTPs_LZ4_BlkLoad(p_dec, p_file, p_dec->IdxNbr - 1u);
+            if (ok != DEF_OK) {
+                return (DEF_NULL);
+            }
+            size = blk_full_len + p_dec->BlkCurLen;
+        }
+        if ((size <= blk_full_len) ||                           /* Content size inconsistent with nbr of blks.          */
+            (size -  blk_full_len > p_dec->BlkSize)) {
+            return (DEF_NULL);
+        }
+        p_dec->Size = size;
+    }
+
+    TFTPs_LZ4_DecFreePtr = p_dec->NextPtr;
+    p_dec->NextPtr       = DEF_NULL;
+
+    return (p_dec);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_LZ4_Close()
+*
+* Description : Return a decoder to the free decoders list.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Close().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_LZ4_Close (TFTPs_LZ4_DEC  *p_dec)
+{
+    p_dec->NextPtr       = TFTPs_LZ4_DecFreePtr;
+    TFTPs_LZ4_DecFreePtr = p_dec;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_LZ4_Rd()
+*
+* Description : Read decoded data from the current position of a decoder.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+*               p_file      Handle of the decoded file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Number of octets to read.
+*
+*               p_size_rd   Pointer to variable that will receive the number of octets read, fewer than
+*                           'size' at the end of the decoded data.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if the file could NOT be read or holds a corrupted block.
+*
+* Caller(s)   : TFTPs_FS_Rd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_LZ4_Rd (TFTPs_LZ4_DEC  *p_dec,
+                           void           *p_file,
+                           CPU_INT08U     *p_dest,
+                           CPU_SIZE_T      size,
+                           CPU_SIZE_T     *p_size_rd)
+{
+    CPU_INT32U   blk_ix;
+    CPU_INT32U   blk_off;
+    CPU_INT32U   len;
+    CPU_BOOLEAN  ok;
+
+
+   *p_size_rd = 0u;
+
+    while ((size       > 0u) &&
+           (p_dec->Pos < p_dec->Size)) {
+        blk_ix  = p_dec->Pos / p_dec->BlkSize;
+        blk_off = p_dec->Pos % p_dec->BlkSize;
+
+        if (blk_ix != p_dec->BlkCurIx) {
+            ok = TFTPs_LZ4_BlkLoad(p_dec, p_file, blk_ix);
+            if (ok != DEF_OK) {
+                return (DEF_FAIL);
+            }
+        }
+        if (blk_off >= p_dec->BlkCurLen) {                      /* Blk shorter than expected.                           */
+            return (DEF_FAIL);
+        }
+
+        len = DEF_MIN(p_dec->BlkCurLen - blk_off, size);
+        Mem_Copy(p_dest, &p_dec->BlkBufPtr[blk_off], len);
+
+        p_dest     += len;
+        size       -= len;
+       *p_size_rd  += len;
+        p_dec->Pos += len;
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_LZ4_PosSet()
+*
+* Description : Set the decoded position of the next read.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+*               pos         Decoded position, from the start of the file.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if the position is beyond the end of the decoded data.
+*
+* Caller(s)   : TFTPs_FS_PosSet().
+*
+* Note(s)     : (1) The block holding the position is only decoded by the next read (see 'tftp-s_lz4.c
+*                   Note #2').
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_LZ4_PosSet (TFTPs_LZ4_DEC  *p_dec,
+                               CPU_INT32U      pos)
+{
+    if (pos > p_dec->Size) {
+        return (DEF_FAIL);
+    }
+
+    p_dec->Pos = pos;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_LZ4_PosGet()
+*
+* Description : Get the decoded position of the next read.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+* Return(s)   : Decoded position, from the start of the file.
+*
+* Caller(s)   : TFTPs_FS_PosGet().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_LZ4_PosGet (TFTPs_LZ4_DEC  *p_dec)
+{
+    return (p_dec->Pos);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_LZ4_SizeGet()
+*
+* Description : Get the decoded size of a file.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+* Return(s)   : Decoded size, in octets.
+*
+* Caller(s)   : TFTPs_FS_SizeGet().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_LZ4_SizeGet (TFTPs_LZ4_DEC  *p_dec)
+{
+    return (p_dec->Size);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_LZ4_HdrParse()
+*
+* Description : Parse & check the frame header of a file.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+*               p_file      Handle of the file.
+*
+*               p_off       Pointer to variable that will receive the offset of the first block.
+*
+*               p_size      Pointer to variable that will receive the content size of the frame, or
+*                           TFTPs_LZ4_BLK_IX_NONE if absent.
+*
+* Return(s)   : DEF_OK,   if the frame can be decoded.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_LZ4_Open().
+*
+* Note(s)     : (1) See 'tftp-s_lz4.c  Note #1'.
+*
+*               (2) Content sizes of 4 GB or more are refused, as the size of a file is 32-bit wide.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_LZ4_HdrParse (TFTPs_LZ4_DEC  *p_dec,
+                                         void           *p_file,
+                                         CPU_INT32U     *p_off,
+                                         CPU_INT32U     *p_size)
+{
+    CPU_INT08U   hdr[TFTPs_LZ4_HDR_SIZE_CONTENT];
+    CPU_INT08U   flg;
+    CPU_INT08U   blk_size_code;
+    CPU_INT32U   off;
+    CPU_BOOLEAN  ok;
+
+
+    ok = TFTPs_LZ4_FileRd(p_file, 0u, hdr, TFTPs_LZ4_HDR_SIZE_FIXED);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    if (TFTPs_LZ4_RdLE32(hdr) != TFTPs_LZ4_MAGIC) {
+        return (DEF_FAIL);
+    }
+
+    flg = hdr[4];                                               /* See Note #1.                                         */
+    if (((flg & TFTPs_LZ4_FLG_VER_MASK) != TFTPs_LZ4_FLG_VER_01) ||
+        (DEF_BIT_IS_CLR(flg, TFTPs_LZ4_FLG_BLK_INDEP) == DEF_YES) ||
+        (DEF_BIT_IS_SET(flg, TFTPs_LZ4_FLG_DICT_ID)   == DEF_YES)) {
+        return (DEF_FAIL);
+    }
+
+    blk_size_code = (hdr[5] >> TFTPs_LZ4_BD_BLK_SIZE_SHIFT) & TFTPs_LZ4_BD_BLK_SIZE_MASK;
+    if (blk_size_code < TFTPs_LZ4_BD_BLK_SIZE_CODE_MIN) {
+        return (DEF_FAIL);
+    }
+    p_dec->BlkSize = 1u << (2u * blk_size_code + 8u);           /* 64 KB, 256 KB, 1 MB or 4 MB.                         */
+    if (p_dec->BlkSize > TFTPs_LZ4_BlkSizeMax) {
+        return (DEF_FAIL);
+    }
+    p_dec->BlkChkSumEn = DEF_BIT_IS_SET(flg, TFTPs_LZ4_FLG_BLK_CHKSUM);
+
+    off     = TFTPs_LZ4_HDR_SIZE_FIXED;
+   *p_size  = TFTPs_LZ4_BLK_IX_NONE;
+    if (DEF_BIT_IS_SET(flg, TFTPs_LZ4_FLG_CONTENT_SIZE) == DEF_YES) {
+        ok = TFTPs_LZ4_FileRd(p_file, off, hdr, TFTPs_LZ4_HDR_SIZE_CONTENT);
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+        if (TFTPs_LZ4_RdLE32(&hdr[4]) != 0u) {                  /* See Note #2.                                         */
+            return (DEF_FAIL);
+        }
+       *p_size = TFTPs_LZ4_RdLE32(&hdr[0]);
+        off   += TFTPs_LZ4_HDR_SIZE_CONTENT;
+    }
+
+   *p_off = off + 1u;                                           /* Skip HC.                                             */
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_LZ4_IdxBuild()
+*
+* Description : Build the seek index of a frame from its block headers.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+*               p_file      Handle of the file.
+*
+*               off         Offset of the first block.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if the frame is truncated, holds a block larger than the frame block size, or
+*                         holds more blocks than the seek index.
+*
+* Caller(s)   : TFTPs_LZ4_Open().
+*
+* Note(s)     : (1) See 'tftp-s_lz4.c  Note #2'.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_LZ4_IdxBuild (TFTPs_LZ4_DEC  *p_dec,
+                                         void           *p_file,
+                                         CPU_INT32U      off)
+{
+    CPU_INT08U   blk_hdr[TFTPs_LZ4_BLK_HDR_SIZE];
+    CPU_INT32U   blk_len;
+    CPU_BOOLEAN  ok;
+
+
+    while (DEF_TRUE) {
+        ok = TFTPs_LZ4_FileRd(p_file, off, blk_hdr, TFTPs_LZ4_BLK_HDR_SIZE);
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+
+        blk_len = TFTPs_LZ4_RdLE32(blk_hdr);
+        if (blk_len == 0u) {                                    /* EndMark.                                             */
+            break;
+        }
+
+        blk_len &= ~TFTPs_LZ4_BLK_UNCOMPRESSED;
+        if ((blk_len       >  p_dec->BlkSize) ||
+            (p_dec->IdxNbr >= TFTPs_LZ4_IdxNbrMax)) {
+            return (DEF_FAIL);
+        }
+
+        p_dec->IdxTbl[p_dec->IdxNbr] = off;                     /* See Note #1.                                         */
+        p_dec->IdxNbr++;
+
+        off += TFTPs_LZ4_BLK_HDR_SIZE + blk_len;
+        if (p_dec->BlkChkSumEn == DEF_YES) {
+            off += TFTPs_LZ4_BLK_CHKSUM_SIZE;
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_LZ4_BlkLoad()
+*
+* Description : Read & decode a block of a frame into the block buffer of the decoder.
+*
+* Argument(s) : p_dec       Pointer to decoder.
+*
+*               p_file      Handle of the file.
+*
+*               blk_ix      Index of the block.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if the block could NOT be read or is corrupted.
+*
+* Caller(s)   : TFTPs_LZ4_Open(),
+*               TFTPs_LZ4_Rd().
+*
+* Note(s)     : (1) See 'tftp-s_lz4.h  LZ4 FRAME DECODER DATA TYPE  Note #2'.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_LZ4_BlkLoad (TFTPs_LZ4_DEC  *p_dec,
+                                        void           *p_file,
+                                        CPU_INT32U      blk_ix)
+{
+    CPU_INT08U   blk_hdr[TFTPs_LZ4_BLK_HDR_SIZE];
+    CPU_INT32U   blk_hdr_val;
+    CPU_INT32U   blk_len;
+    CPU_INT32U   off;
+    CPU_BOOLEAN  ok;
+
+
+    p_dec->BlkCurIx = TFTPs_LZ4_BLK_IX_NONE;                    /* Invalidate blk buf until decoded.                    */
+
+    off = p_dec->IdxTbl[blk_ix];
+    ok  = TFTPs_LZ4_FileRd(p_file, off, blk_hdr, TFTPs_LZ4_BLK_HDR_SIZE);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    blk_hdr_val = TFTPs_LZ4_RdLE32(blk_hdr);
+    blk_len     = blk_hdr_val & ~TFTPs_LZ4_BLK_UNCOMPRESSED;
+    off        += TFTPs_LZ4_BLK_HDR_SIZE;
+
+    if (DEF_BIT_IS_SET(blk_hdr_val, TFTPs_LZ4_BLK_UNCOMPRESSED) == DEF_YES) {
+        ok = TFTPs_LZ4_FileRd(p_file, off, p_dec->BlkBufPtr, blk_len);
+        p_dec->BlkCurLen = blk_len;
+    } else {
+        ok = TFTPs_LZ4_FileRd(p_file, off, p_dec->SrcBufPtr, blk_len);
+        if (ok == DEF_OK) {
+            ok = TFTPs_LZ4_BlkDecode( p_dec->SrcBufPtr,
+                                      blk_len,
+                                      p_dec->BlkBufPtr,
+                                      p_dec->BlkSize,
+                                     &p_dec->BlkCurLen);
+        }
+    }
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+                                                                /* Only the last blk may be partial (see Note #1).      */
+    if ((blk_ix           <  p_dec->IdxNbr - 1u) &&
+        (p_dec->BlkCurLen != p_dec->BlkSize)) {
+        return (DEF_FAIL);
+    }
+
+    p_dec->BlkCurIx = blk_ix;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_LZ4_BlkDecode()
+*
+* Description : Decode an LZ4 compressed block.
+*
+* Argument(s) : p_src       Pointer to compressed block.
+*
+*               src_len     Length of compressed block.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               dest_size   Size of destination buffer.
+*
+*               p_dest_len  Pointer to variable that will receive the decoded length.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if the block is corrupted.
+*
+* Caller(s)   : TFTPs_LZ4_BlkLoad().
+*
+* Note(s)     : (1) A block is a series of sequences, each one made of a token, literals & a match :
+*
+*                       | token | (literal len ext) | literals | offset | (match len ext) |
+*
+*                   The high nibble of the token is the literal length, the low nibble the match length
+*                   minus 4; a nibble of 15 is continued by octets added to it, up to an octet below 255.
+*                   The last sequence only holds literals.
+*
+*               (2) See 'tftp-s_lz4.c  Note #3'.  Matches may overlap their own output, so they are copied
+*                   one octet at a time.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_LZ4_BlkDecode (const  CPU_INT08U  *p_src,
+                                                 CPU_INT32U   src_len,
+                                                 CPU_INT08U  *p_dest,
+                                                 CPU_INT32U   dest_size,
+                                                 CPU_INT32U  *p_dest_len)
+{
+    CPU_INT32U  src_ix;
+    CPU_INT32U  dest_ix;
+    CPU_INT32U  len;
+    CPU_INT32U  match_off;
+    CPU_INT08U  token;
+    CPU_INT08U  ext;
+
+
+    src_ix  = 0u;
+    dest_ix = 0u;
+
+    while (src_ix < src_len) {                                  /* See Note #1.                                         */
+        token = p_src[src_ix++];
+                                                                /* ------------------- COPY LITERALS ------------------ */
+        len = token >> 4u;
+        if (len == TFTPs_LZ4_LEN_EXT) {
+            do {
+                if (src_ix >= src_len) {
+                    return (DEF_FAIL);
+                }
+                ext  = p_src[src_ix++];
+                len += ext;
+            } while (ext == DEF_INT_08U_MAX_VAL);
+        }
+        if ((len > src_len   - src_ix) ||                       /* See Note #2.                                         */
+            (len > dest_size - dest_ix)) {
+            return (DEF_FAIL);
+        }
+        Mem_Copy(&p_dest[dest_ix], &p_src[src_ix], len);
+        src_ix  += len;
+        dest_ix += len;
+
+        if (src_ix == src_len) {                                /* Last sequence.                                       */
+            break;
+        }
+                                                                /* -------------------- COPY MATCH -------------------- */
+        if (src_len - src_ix < 2u) {
+            return (DEF_FAIL);
+        }
+        match_off = (CPU_INT32U)p_src[src_ix] | ((CPU_INT32U)p_src[src_ix + 1u] << 8u);
+        src_ix   += 2u;
+        if ((match_off == 0u) ||
+            (match_off >  dest_ix)) {
+            return (DEF_FAIL);
+        }
+
+        len = token & TFTPs_LZ4_LEN_EXT;
+        if (len == TFTPs_LZ4_LEN_EXT) {
+            do {
+                if (src_ix >= src_len) {
+                    return (DEF_FAIL);
+                }
+                ext  = p_src[src_ix++];
+                len += ext;
+            } while (ext == DEF_INT_08U_MAX_VAL);
+        }
+        len += TFTPs_LZ4_MATCH_LEN_MIN;
+        if (len > dest_size - dest_ix) {
+            return (DEF_FAIL);
+        }
+        while (len > 0u) {
+            p_dest[dest_ix] = p_dest[dest_ix - match_off];
+            dest_ix++;
+            len--;
+        }
+    }
+
+   *p_dest_len = dest_ix;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_LZ4_FileRd()
+*
+* Description : Read octets at an offset of a file.
+*
+* Argument(s) : p_file      Handle of the file.
+*
+*               off         Offset, from the start of the file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               len         Number of octets to read.
+*
+* Return(s)   : DEF_OK,   if all the octets were read.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_LZ4_FileRd (void        *p_file,
+                                       CPU_INT32U   off,
+                                       CPU_INT08U  *p_dest,
+                                       CPU_INT32U   len)
+{
+    CPU_SIZE_T   len_rd;
+    CPU_BOOLEAN  ok;
+
+
+    ok = NetFS_FilePosSet(p_file, (CPU_INT32S)off, NET_FS_SEEK_ORIGIN_START);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+
+    ok = NetFS_FileRd(p_file, p_dest, len, &len_rd);
+    if ((ok     != DEF_OK) ||
+        (len_rd != len)) {
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_LZ4_RdLE32()
+*
+* Description : Get a 32-bit little-endian value.
+*
+* Argument(s) : p_src       Pointer to value.
+*
+* Return(s)   : Value.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_LZ4_RdLE32 (const  CPU_INT08U  *p_src)
+{
+    return ( (CPU_INT32U)p_src[0]         |
+            ((CPU_INT32U)p_src[1] <<  8u) |
+            ((CPU_INT32U)p_src[2] << 16u) |
+            ((CPU_INT32U)p_src[3] << 24u));
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of LZ4 module include.                           */
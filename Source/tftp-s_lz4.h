@@ -0,0 +1,141 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER LZ4 FRAME DECODER
+*
+* Filename : tftp-s_lz4.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs LZ4 present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_LZ4_MODULE_PRESENT                               /* See Note #1.                                         */
+#define  TFTPs_LZ4_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_LZ4_BLK_SIZE_MIN                        65536u   /* Smallest frame blk size (64 KB).                     */
+#define  TFTPs_LZ4_BLK_IX_NONE           DEF_INT_32U_MAX_VAL
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      LZ4 FRAME DECODER DATA TYPE
+*
+* Note(s) : (1) 'IdxTbl' holds the file offset of the header of each block of the frame, found when the
+*               file is opened (see 'tftp-s_lz4.c  Note #2').
+*
+*           (2) Every block of a frame but the last one decodes to exactly 'BlkSize' octets, so that the
+*               block holding a decoded position is found by a division.  The last decoded block is kept
+*               in 'BlkBufPtr', so that sequential reads & retransmissions of the same block are served
+*               without decoding again.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_lz4_dec  TFTPs_LZ4_DEC;
+
+struct  tftps_lz4_dec {
+    CPU_INT08U     *BlkBufPtr;                                  /* Decoded blk                    (see Note #2).        */
+    CPU_INT08U     *SrcBufPtr;                                  /* Compressed blk.                                      */
+    CPU_INT32U     *IdxTbl;                                     /* Blk hdr offsets                (see Note #1).        */
+    CPU_INT32U      IdxNbr;                                     /* Nbr of blks of the frame.                            */
+    CPU_INT32U      BlkSize;                                    /* Frame blk size                 (see Note #2).        */
+    CPU_BOOLEAN     BlkChkSumEn;                                /* Blks followed by a checksum.                         */
+    CPU_INT32U      BlkCurIx;                                   /* Ix  of decoded blk             (see Note #2).        */
+    CPU_INT32U      BlkCurLen;                                  /* Len of decoded blk.                                  */
+    CPU_INT32U      Size;                                       /* Decoded size of the frame.                           */
+    CPU_INT32U      Pos;                                        /* Decoded pos of next rd.                              */
+    TFTPs_LZ4_DEC  *NextPtr;                                    /* Next free decoder.                                   */
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void            TFTPs_LZ4_Init   (const  TFTPs_CFG      *p_cfg,
+                                         TFTPs_ERR      *p_err);
+
+TFTPs_LZ4_DEC  *TFTPs_LZ4_Open   (       void           *p_file);
+
+void            TFTPs_LZ4_Close  (       TFTPs_LZ4_DEC  *p_dec);
+
+CPU_BOOLEAN     TFTPs_LZ4_Rd     (       TFTPs_LZ4_DEC  *p_dec,
+                                         void           *p_file,
+                                         CPU_INT08U     *p_dest,
+                                         CPU_SIZE_T      size,
+                                         CPU_SIZE_T     *p_size_rd);
+
+CPU_BOOLEAN     TFTPs_LZ4_PosSet (       TFTPs_LZ4_DEC  *p_dec,
+                                         CPU_INT32U      pos);
+
+CPU_INT32U      TFTPs_LZ4_PosGet (       TFTPs_LZ4_DEC  *p_dec);
+
+CPU_INT32U      TFTPs_LZ4_SizeGet(       TFTPs_LZ4_DEC  *p_dec);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_LZ4_MODULE_PRESENT  */
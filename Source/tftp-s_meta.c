@@ -0,0 +1,616 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER FILE METADATA INDEX
+*
+* Filename : tftp-s_meta.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The index holds, by file name, the size of the files found & the names of the files known
+*                to be missing, in a hash table.  A read request for a missing file is thus refused without
+*                opening any file, & the size of a file found is NOT queried again from storage.
+*
+*            (2) An entry expires 'MetaTTL' milliseconds after the file was looked for, so that files
+*                stored, changed or deleted since are looked for again.  An entry is also replaced when the
+*                file is written by a write request, & dropped when the index is invalidated by the
+*                application (see TFTPs_MetaInvalidate()), which SHOULD be done when files are changed
+*                outside of the TFTP server.  With a null 'MetaTTL', entries of files found never expire
+*                & missing files are NOT indexed.
+*
+*            (3) Once all the entries are in use, the oldest entries are replaced in turn.  Names longer
+*                than TFTPs_CFG_FS_META_NAME_LEN_MAX are NOT indexed.
+*
+*            (4) The index MAY be filled at initialization from the entries of the 'MetaDirPtr' directory
+*                of the configuration; it is otherwise filled as files are opened.
+*
+*            (5) The index is only accessed from the TFTP server task context, except for its generation,
+*                incremented by TFTPs_MetaInvalidate().
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_META_MODULE
+#include  "tftp-s_meta.h"
+#include  "tftp-s_tmr.h"
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_META_HASH_INIT                     2166136261u   /* FNV-1a offset basis.                                 */
+#define  TFTPs_META_HASH_PRIME                      16777619u   /* FNV-1a prime.                                        */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_META_ENTRY   *TFTPs_MetaTbl;                      /* Entries.                                             */
+static  TFTPs_META_ENTRY  **TFTPs_MetaBucketTbl;                /* Hash buckets of entries.                             */
+static  CPU_INT32U          TFTPs_MetaBucketMask;               /* Nbr of hash buckets, minus 1.                        */
+static  CPU_INT16U          TFTPs_MetaNbr;                      /* Nbr of entries.                                      */
+static  CPU_INT16U          TFTPs_MetaNbrUsed;                  /* Nbr of entries ever used.                            */
+static  CPU_INT16U          TFTPs_MetaReplaceIx;                /* Next entry replaced (see Note #3).                   */
+static  CPU_INT32U          TFTPs_MetaGen;                      /* Generation of index (see Note #5).                   */
+static  CPU_INT32U          TFTPs_MetaTTL;                      /* Lifetime of entries (see Note #2).                   */
+                                                                /* Name of scanned file (see Note #4).                  */
+static  CPU_CHAR            TFTPs_MetaNameBuf[TFTPs_CFG_FS_META_NAME_LEN_MAX + 1u];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_META_ENTRY  *TFTPs_MetaFind  (const  CPU_CHAR          *p_name,
+                                                   CPU_INT32U         hash);
+
+static  void               TFTPs_MetaUnlink(       TFTPs_META_ENTRY  *p_entry);
+
+static  void               TFTPs_MetaScan  (const  CPU_CHAR          *p_dir);
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_MetaInit()
+*
+* Description : Allocate the entries of the index & fill them from the directory of the configuration.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Init().
+*
+* Note(s)     : (1) A power of 2 of hash buckets, at least equal to the number of entries, is allocated.
+*
+*               (2) See 'tftp-s_meta.c  Note #4'.  A directory that can NOT be read is NOT an error : the
+*                   index is then filled as files are opened.
+*********************************************************************************************************
+*/
+
+void  TFTPs_MetaInit (const  TFTPs_CFG  *p_cfg,
+                             TFTPs_ERR  *p_err)
+{
+    CPU_INT32U  bucket_nbr;
+    CPU_INT32U  ix;
+    LIB_ERR     err_lib;
+
+
+    TFTPs_MetaNbr       = p_cfg->MetaNbr;
+    TFTPs_MetaNbrUsed   = 0u;
+    TFTPs_MetaReplaceIx = 0u;
+    TFTPs_MetaGen       = 0u;
+    TFTPs_MetaTTL       = p_cfg->MetaTTL;
+    if (TFTPs_MetaNbr == 0u) {                                  /* No entry : files are never indexed.                  */
+       *p_err = TFTPs_ERR_NONE;
+        return;
+    }
+
+    bucket_nbr = 1u;                                            /* See Note #1.                                         */
+    while (bucket_nbr < TFTPs_MetaNbr) {
+        bucket_nbr <<= 1u;
+    }
+    TFTPs_MetaBucketMask = bucket_nbr - 1u;
+
+    TFTPs_MetaTbl = (TFTPs_META_ENTRY *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Meta Tbl",
+                                                                 DEF_NULL,
+                                                                 TFTPs_MetaNbr * sizeof(TFTPs_META_ENTRY),
+                                                                &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_MetaBucketTbl = (TFTPs_META_ENTRY **)Mem_SegAlloc((CPU_CHAR *)"TFTPs Meta Bucket Tbl",
+                                                                        DEF_NULL,
+                                                                        bucket_nbr * sizeof(TFTPs_META_ENTRY *),
+                                                                       &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    for (ix = 0u; ix < bucket_nbr; ix++) {
+        TFTPs_MetaBucketTbl[ix] = DEF_NULL;
+    }
+
+    if (p_cfg->MetaDirPtr != DEF_NULL) {                        /* See Note #2.                                         */
+        TFTPs_MetaScan(p_cfg->MetaDirPtr);
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_MetaInvalidate()
+*
+* Description : Invalidate all the entries of the file metadata index.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) This function MUST be called once files are stored, changed or deleted other than by the
+*                   write requests of the TFTP server (see 'tftp-s_meta.c  Note #2').  The entries are
+*                   invalidated by incrementing the generation of the index, in constant time.
+*********************************************************************************************************
+*/
+
+void  TFTPs_MetaInvalidate (TFTPs_ERR  *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    TFTPs_MetaGen++;
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_MetaGet()
+*
+* Description : Look up a file name in the index.
+*
+* Argument(s) : p_name      Pointer to NUL-terminated file name.
+*
+*               p_size      Pointer to variable that will receive the size of the file, if found.
+*
+* Return(s)   : TFTPs_META_STATE_FOUND,   if the file is indexed as found.
+*
+*               TFTPs_META_STATE_MISSING, if the file is indexed as missing.
+*
+*               TFTPs_META_STATE_NONE,    if the file is NOT indexed, or its entry is no longer valid.
+*
+* Caller(s)   : TFTPs_FS_Open().
+*
+* Note(s)     : (1) See 'tftp-s_meta.h  INDEX ENTRY DATA TYPE  Note #1'.
+*
+*               (2) See 'tftp-s_meta.h  INDEX ENTRY DATA TYPE  Note #2'.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  TFTPs_MetaGet (const  CPU_CHAR    *p_name,
+                                  CPU_INT32U  *p_size)
+{
+    TFTPs_META_ENTRY  *p_entry;
+    CPU_INT32U         gen;
+    CPU_INT32U         ts_now;
+    CPU_SR_ALLOC();
+
+
+    if (TFTPs_MetaNbr == 0u) {
+        return (TFTPs_META_STATE_NONE);
+    }
+
+    p_entry = TFTPs_MetaFind(p_name, TFTPs_MetaHash(p_name));
+    if (p_entry == DEF_NULL) {
+        return (TFTPs_META_STATE_NONE);
+    }
+
+    CPU_CRITICAL_ENTER();
+    gen = TFTPs_MetaGen;
+    CPU_CRITICAL_EXIT();
+    if (p_entry->Gen != gen) {                                  /* See Note #1.                                         */
+        return (TFTPs_META_STATE_NONE);
+    }
+
+    if (TFTPs_MetaTTL != 0u) {                                  /* See Note #2.                                         */
+        ts_now = TFTPs_TmrNowGet();
+        if ((CPU_INT32S)(ts_now - p_entry->ExpiryTS) >= 0) {
+            return (TFTPs_META_STATE_NONE);
+        }
+    }
+
+    if (p_entry->State == TFTPs_META_STATE_FOUND) {
+       *p_size = p_entry->Size;
+    }
+
+    return (p_entry->State);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_MetaSet()
+*
+* Description : Index a file as found or as missing.
+*
+* Argument(s) : p_name      Pointer to NUL-terminated file name.
+*
+*               state       State of file :
+*
+*                               TFTPs_META_STATE_FOUND      File found, of size 'size'.
+*                               TFTPs_META_STATE_MISSING    File missing.
+*
+*               size        Size of the file, if found.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Open(),
+*               TFTPs_MetaScan().
+*
+* Note(s)     : (1) Missing files are NOT indexed when 'MetaTTL' is null (see 'tftp-s_meta.c  Note #2').
+*
+*               (2) See 'tftp-s_meta.c  Note #3'.
+*********************************************************************************************************
+*/
+
+void  TFTPs_MetaSet (const  CPU_CHAR    *p_name,
+                            CPU_INT08U   state,
+                            CPU_INT32U   size)
+{
+    TFTPs_META_ENTRY   *p_entry;
+    TFTPs_META_ENTRY  **p_bucket;
+    CPU_SIZE_T          name_len;
+    CPU_INT32U          hash;
+    CPU_SR_ALLOC();
+
+
+    if (TFTPs_MetaNbr == 0u) {
+        return;
+    }
+
+    if ((state         == TFTPs_META_STATE_MISSING) &&          /* See Note #1.                                         */
+        (TFTPs_MetaTTL == 0u)) {
+        return;
+    }
+
+    name_len = Str_Len_N(p_name, TFTPs_CFG_FS_META_NAME_LEN_MAX + 1u);
+    if (name_len > TFTPs_CFG_FS_META_NAME_LEN_MAX) {            /* See Note #2.                                         */
+        return;
+    }
+
+    hash    = TFTPs_MetaHash(p_name);
+    p_entry = TFTPs_MetaFind(p_name, hash);
+    if (p_entry == DEF_NULL) {
+        if (TFTPs_MetaNbrUsed < TFTPs_MetaNbr) {                /* Get unused entry ...                                 */
+            p_entry = &TFTPs_MetaTbl[TFTPs_MetaNbrUsed];
+            TFTPs_MetaNbrUsed++;
+        } else {                                                /* ... or replace oldest entry (see Note #2).           */
+            p_entry = &TFTPs_MetaTbl[TFTPs_MetaReplaceIx];
+            TFTPs_MetaReplaceIx++;
+            if (TFTPs_MetaReplaceIx >= TFTPs_MetaNbr) {
+                TFTPs_MetaReplaceIx = 0u;
+            }
+            TFTPs_MetaUnlink(p_entry);
+        }
+
+        Mem_Copy(p_entry->Name, p_name, name_len);
+        p_entry->Name[name_len] = ASCII_CHAR_NULL;
+        p_entry->Hash           = hash;
+
+        p_bucket         = &TFTPs_MetaBucketTbl[hash & TFTPs_MetaBucketMask];
+        p_entry->NextPtr = *p_bucket;
+       *p_bucket         =  p_entry;
+    }
+
+    CPU_CRITICAL_ENTER();
+    p_entry->Gen = TFTPs_MetaGen;
+    CPU_CRITICAL_EXIT();
+
+    p_entry->State    = state;
+    p_entry->Size     = size;
+    p_entry->ExpiryTS = TFTPs_TmrNowGet() + TFTPs_MetaTTL;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_MetaHash()
+*
+* Description : Hash a file name.
+*
+* Argument(s) : p_name      Pointer to NUL-terminated file name.
+*
+* Return(s)   : FNV-1a hash of the file name.
+*
+* Caller(s)   : TFTPs_FS_Open(),
+*               TFTPs_MetaGet(),
+*               TFTPs_MetaSet().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_MetaHash (const  CPU_CHAR  *p_name)
+{
+    CPU_INT32U  hash;
+
+
+    hash = TFTPs_META_HASH_INIT;
+    while (*p_name != ASCII_CHAR_NULL) {
+        hash = (hash ^ (CPU_INT08U)*p_name) * TFTPs_META_HASH_PRIME;
+        p_name++;
+    }
+
+    return (hash);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_MetaRemove()
+*
+* Description : Remove the entries of a file name hash from the index.
+*
+* Argument(s) : hash        Hash of file name (see TFTPs_MetaHash()).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Open(),
+*               TFTPs_FS_Close().
+*
+* Note(s)     : (1) The entries of other names of the same hash are removed too, which only costs a lookup
+*                   in storage the next time they are opened.
+*********************************************************************************************************
+*/
+
+void  TFTPs_MetaRemove (CPU_INT32U  hash)
+{
+    TFTPs_META_ENTRY   *p_entry;
+    TFTPs_META_ENTRY  **p_link;
+
+
+    if (TFTPs_MetaNbr == 0u) {
+        return;
+    }
+
+    p_link = &TFTPs_MetaBucketTbl[hash & TFTPs_MetaBucketMask];
+    while (*p_link != DEF_NULL) {
+        p_entry = *p_link;
+        if (p_entry->Hash == hash) {                            /* See Note #1.                                         */
+           *p_link           = p_entry->NextPtr;
+            p_entry->NextPtr = DEF_NULL;
+            p_entry->State   = TFTPs_META_STATE_NONE;
+        } else {
+            p_link = &p_entry->NextPtr;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_MetaFind()
+*
+* Description : Find the entry of a file name.
+*
+* Argument(s) : p_name      Pointer to NUL-terminated file name.
+*
+*               hash        Hash of file name.
+*
+* Return(s)   : Pointer to the entry of the file name, if any.
+*
+*               Pointer to NULL,                       otherwise.
+*
+* Caller(s)   : TFTPs_MetaGet(),
+*               TFTPs_MetaSet().
+*
+* Note(s)     : (1) The entry is returned whatever its validity.
+*********************************************************************************************************
+*/
+
+static  TFTPs_META_ENTRY  *TFTPs_MetaFind (const  CPU_CHAR    *p_name,
+                                                  CPU_INT32U   hash)
+{
+    TFTPs_META_ENTRY  *p_entry;
+    CPU_INT16S         cmp;
+
+
+    p_entry = TFTPs_MetaBucketTbl[hash & TFTPs_MetaBucketMask];
+    while (p_entry != DEF_NULL) {
+        if (p_entry->Hash == hash) {
+            cmp = Str_Cmp_N(p_entry->Name, p_name, TFTPs_CFG_FS_META_NAME_LEN_MAX + 1u);
+            if (cmp == 0) {
+                return (p_entry);
+            }
+        }
+        p_entry = p_entry->NextPtr;
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_MetaUnlink()
+*
+* Description : Remove an entry from its hash bucket.
+*
+* Argument(s) : p_entry     Pointer to entry.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_MetaSet().
+*
+* Note(s)     : (1) An entry already removed (see TFTPs_MetaRemove()) is in NO bucket.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_MetaUnlink (TFTPs_META_ENTRY  *p_entry)
+{
+    TFTPs_META_ENTRY  **p_link;
+
+
+    p_link = &TFTPs_MetaBucketTbl[p_entry->Hash & TFTPs_MetaBucketMask];
+    while (*p_link != DEF_NULL) {                               /* See Note #1.                                         */
+        if (*p_link == p_entry) {
+           *p_link           = p_entry->NextPtr;
+            p_entry->NextPtr = DEF_NULL;
+            return;
+        }
+        p_link = &(*p_link)->NextPtr;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_MetaScan()
+*
+* Description : Index the files of a directory.
+*
+* Argument(s) : p_dir       Pointer to NUL-terminated directory name.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_MetaInit().
+*
+* Note(s)     : (1) The files are indexed under the directory name followed by their name : the directory
+*                   name MUST thus end with the path separator of the requested file names (e.g. "boot/"),
+*                   or be empty for the root directory.
+*
+*               (2) Sub-directories are NOT scanned.  The scan stops once all the entries are in use.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_MetaScan (const  CPU_CHAR  *p_dir)
+{
+    void          *p_dir_handle;
+    NET_FS_ENTRY   entry;
+    CPU_SIZE_T     dir_len;
+    CPU_SIZE_T     name_len;
+    CPU_BOOLEAN    ok;
+
+
+    dir_len = Str_Len_N(p_dir, TFTPs_CFG_FS_META_NAME_LEN_MAX + 1u);
+    if (dir_len > TFTPs_CFG_FS_META_NAME_LEN_MAX) {
+        return;
+    }
+    Mem_Copy(TFTPs_MetaNameBuf, p_dir, dir_len);                /* See Note #1.                                         */
+
+    p_dir_handle = NetFS_DirOpen((CPU_CHAR *)p_dir);
+    if (p_dir_handle == DEF_NULL) {
+        return;
+    }
+
+    ok = NetFS_DirRd(p_dir_handle, &entry);
+    while ((ok                == DEF_OK) &&                     /* See Note #2.                                         */
+           (TFTPs_MetaNbrUsed <  TFTPs_MetaNbr)) {
+        if (DEF_BIT_IS_CLR(entry.Attrib, NET_FS_ENTRY_ATTRIB_DIR) == DEF_YES) {
+            name_len = Str_Len_N(entry.NamePtr, TFTPs_CFG_FS_META_NAME_LEN_MAX + 1u);
+            if (dir_len + name_len <= TFTPs_CFG_FS_META_NAME_LEN_MAX) {
+                Mem_Copy(&TFTPs_MetaNameBuf[dir_len], entry.NamePtr, name_len);
+                TFTPs_MetaNameBuf[dir_len + name_len] = ASCII_CHAR_NULL;
+                TFTPs_MetaSet(TFTPs_MetaNameBuf, TFTPs_META_STATE_FOUND, entry.Size);
+            }
+        }
+        ok = NetFS_DirRd(p_dir_handle, &entry);
+    }
+
+    NetFS_DirClose(p_dir_handle);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of meta module include.                          */
@@ -0,0 +1,135 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER FILE METADATA INDEX
+*
+* Filename : tftp-s_meta.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs meta present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_META_MODULE_PRESENT                              /* See Note #1.                                         */
+#define  TFTPs_META_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_META_STATE_NONE                             0u   /* Name NOT indexed.                                    */
+#define  TFTPs_META_STATE_FOUND                            1u   /* File exists, of known size.                          */
+#define  TFTPs_META_STATE_MISSING                          2u   /* File known NOT to exist.                             */
+
+#define  TFTPs_META_SIZE_UNKNOWN                DEF_INT_32U_MAX_VAL
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       INDEX ENTRY DATA TYPE
+*
+* Note(s) : (1) An entry is only valid while 'Gen' equals the generation of the index, which is incremented
+*               when the application invalidates the index (see TFTPs_MetaInvalidate()).
+*
+*           (2) An entry is only valid until 'ExpiryTS', unless 'MetaTTL' is null (see 'tftp-s_meta.c
+*               Note #2').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_META_EN == DEF_ENABLED)
+typedef  struct  tftps_meta_entry  TFTPs_META_ENTRY;
+
+struct  tftps_meta_entry {
+                                                                /* File name.                                           */
+    CPU_CHAR           Name[TFTPs_CFG_FS_META_NAME_LEN_MAX + 1u];
+    CPU_INT32U         Hash;                                    /* Hash of file name.                                   */
+    CPU_INT32U         Size;                                    /* File size, of a found file.                          */
+    CPU_INT32U         Gen;                                     /* Generation of entry            (see Note #1).        */
+    CPU_INT32U         ExpiryTS;                                /* Expiry of entry                (see Note #2).        */
+    CPU_INT08U         State;                                   /* TFTPs_META_STATE_xx.                                 */
+    TFTPs_META_ENTRY  *NextPtr;                                 /* Next entry of hash bucket.                           */
+};
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void        TFTPs_MetaInit  (const  TFTPs_CFG   *p_cfg,
+                                    TFTPs_ERR   *p_err);
+
+CPU_INT08U  TFTPs_MetaGet   (const  CPU_CHAR    *p_name,
+                                    CPU_INT32U  *p_size);
+
+void        TFTPs_MetaSet   (const  CPU_CHAR    *p_name,
+                                    CPU_INT08U   state,
+                                    CPU_INT32U   size);
+
+CPU_INT32U  TFTPs_MetaHash  (const  CPU_CHAR    *p_name);
+
+void        TFTPs_MetaRemove(       CPU_INT32U   hash);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_META_MODULE_PRESENT  */
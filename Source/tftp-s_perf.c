@@ -0,0 +1,389 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER PERFORMANCE PROBES
+*
+* Filename : tftp-s_perf.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The probes measure the cycles spent in the per-packet code of the server, on the target CPU,
+*                so that a change of the code is shown to be faster before it is used :
+*
+*                (a) The statistics are read with TFTPs_PerfGet(), once the server has handled a workload,
+*                    e.g. a simulation run (see 'tftp-s_sim.c') with requests of varied options & file name
+*                    lengths.
+*
+*                (b) The statistics of a reference build, stored by the application, are the baseline which
+*                    the statistics of a changed build are compared to (see TFTPs_PerfCmp()).  The host
+*                    benchmark runs a fixed workload & compares it to the baseline stored with it (see
+*                    'Tests/Host/tftp-s_perf_bench.c').
+*
+*            (2) Each probe is a timestamp taken before its operation & a timestamp taken after it, from the
+*                CPU timestamp timer (see 'tftp-s_perf.h  MACRO'S').  Probes of nested operations are
+*                independent, e.g. the ACK probe includes the header building of the DATA packets sent.
+*
+*            (3) The trace probe measures the trace level of the build (see 'tftp-s.h  TRACING'); the
+*                overhead of each level is measured by a build of each level.
+*
+*            (4) The statistics are written from the TFTP server task context only, & MAY be read from any
+*                task.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_PERF_MODULE
+#include  "tftp-s_perf.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_PERF_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_PERF_OVHD_MEAS_NBR                         16u   /* Nbr of measures of probe overhead.                   */
+
+#define  TFTPs_PERF_NS_PER_SEC                    1000000000u
+#define  TFTPs_PERF_CMP_SCALE                           1000    /* Cmp result in 0.1 % (see TFTPs_PerfCmp()).           */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_PERF_STAT  TFTPs_PerfStatTbl[TFTPs_PERF_PROBE_NBR];
+static  CPU_INT32U       TFTPs_PerfOvhd;                        /* Cycles of an empty probe (see TFTPs_PerfInit()).     */
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_PerfInit()
+*
+* Description : Clear the statistics of the probes & measure the overhead of a probe.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) The overhead of a probe is the smallest time of an empty probe, i.e. of two timestamps
+*                   taken in a row, the larger times being those of interrupted probes.
+*********************************************************************************************************
+*/
+
+void  TFTPs_PerfInit (void)
+{
+    CPU_TS_TMR  ts_start;
+    CPU_INT32U  cycles;
+    CPU_INT08U  i;
+
+
+    Mem_Clr(&TFTPs_PerfStatTbl[0], sizeof(TFTPs_PerfStatTbl));
+
+    TFTPs_PerfOvhd = DEF_INT_32U_MAX_VAL;                       /* See Note #1.                                         */
+    for (i = 0u; i < TFTPs_PERF_OVHD_MEAS_NBR; i++) {
+        ts_start = CPU_TS_TmrRd();
+        cycles   = (CPU_INT32U)(CPU_TS_TMR)(CPU_TS_TmrRd() - ts_start);
+        if (cycles < TFTPs_PerfOvhd) {
+            TFTPs_PerfOvhd = cycles;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_PerfRec()
+*
+* Description : Record the measure of a probe.
+*
+* Argument(s) : probe       Probe measured (see 'tftp-s_type.h  PERFORMANCE PROBE DATA TYPES').
+*
+*               ts_start    Timestamp taken before the operation measured.
+*
+*               octets      Length of the packet or request handled by the operation (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_PERF_STOP().
+*
+* Note(s)     : (1) The timestamp after the operation is taken first, so that the update of the statistics
+*                   is NOT measured.  The difference is computed on the width of the timer, so that a timer
+*                   wrap between both timestamps is handled.
+*
+*               (2) The statistics are updated with interrupts disabled, so that they are read consistent
+*                   with one another (see 'tftp-s_perf.c  Note #4').
+*********************************************************************************************************
+*/
+
+void  TFTPs_PerfRec (TFTPs_PERF_PROBE  probe,
+                     CPU_TS_TMR        ts_start,
+                     CPU_INT32U        octets)
+{
+    TFTPs_PERF_STAT  *p_stat;
+    CPU_INT32U        cycles;
+    CPU_SR_ALLOC();
+
+
+                                                                /* See Note #1.                                         */
+    cycles = (CPU_INT32U)(CPU_TS_TMR)(CPU_TS_TmrRd() - ts_start);
+    cycles = (cycles > TFTPs_PerfOvhd) ? (cycles - TFTPs_PerfOvhd) : 0u;
+
+    p_stat = &TFTPs_PerfStatTbl[probe];
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #2.                                         */
+    if ((p_stat->Nbr   == 0u) ||
+        (cycles         < p_stat->CyclesMin)) {
+        p_stat->CyclesMin = cycles;
+    }
+    if (cycles > p_stat->CyclesMax) {
+        p_stat->CyclesMax = cycles;
+    }
+    p_stat->CyclesTot += cycles;
+    p_stat->Octets    += octets;
+    p_stat->Nbr++;
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_PerfGet()
+*
+* Description : Get the statistics of the probes.
+*
+* Argument(s) : p_stat_tbl  Pointer to table of TFTPs_PERF_PROBE_NBR statistics that will receive the
+*                           statistics of each probe, indexed by probe.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_NULL_PTR
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The average time of an operation is computed from the frequency of the CPU timestamp
+*                   timer, & is 0 when the frequency is NOT known.
+*********************************************************************************************************
+*/
+
+void  TFTPs_PerfGet (TFTPs_PERF_STAT  *p_stat_tbl,
+                     TFTPs_ERR        *p_err)
+{
+    TFTPs_PERF_STAT   *p_stat;
+    CPU_TS_TMR_FREQ    freq;
+    CPU_ERR            err_cpu;
+    CPU_INT08U         probe;
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+
+    if (p_stat_tbl == DEF_NULL) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    Mem_Copy(p_stat_tbl, &TFTPs_PerfStatTbl[0], sizeof(TFTPs_PerfStatTbl));
+    CPU_CRITICAL_EXIT();
+
+    freq = CPU_TS_TmrFreqGet(&err_cpu);                         /* See Note #1.                                         */
+    if (err_cpu != CPU_ERR_NONE) {
+        freq = 0u;
+    }
+
+    for (probe = 0u; probe < TFTPs_PERF_PROBE_NBR; probe++) {
+        p_stat            = &p_stat_tbl[probe];
+        p_stat->CyclesAvg =  0u;
+        p_stat->NsAvg     =  0u;
+        if (p_stat->Nbr == 0u) {
+            continue;
+        }
+
+        p_stat->CyclesAvg = (CPU_INT32U)(p_stat->CyclesTot / p_stat->Nbr);
+        if (freq != 0u) {
+            p_stat->NsAvg = (CPU_INT32U)(((CPU_INT64U)p_stat->CyclesAvg * TFTPs_PERF_NS_PER_SEC) / freq);
+        }
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_PerfClr()
+*
+* Description : Clear the statistics of the probes.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The statistics are cleared before a workload, so that they only measure it.
+*********************************************************************************************************
+*/
+
+void  TFTPs_PerfClr (TFTPs_ERR  *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    Mem_Clr(&TFTPs_PerfStatTbl[0], sizeof(TFTPs_PerfStatTbl));
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_PerfCmp()
+*
+* Description : Compare the statistics of a probe to its baseline.
+*
+* Argument(s) : p_baseline  Pointer to baseline statistics of the probe, e.g. stored from a reference build.
+*
+*               p_stat      Pointer to statistics of the probe to compare.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_NULL_PTR
+*                               TFTPs_ERR_PERF_NO_MEASURE
+*
+* Return(s)   : Change of the average cycles of an operation, in 0.1 % of the baseline, if NO error, i.e.
+*               negative when the operation is faster than its baseline.
+*
+*               0, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The averages are computed from the total cycles of both statistics, so that statistics
+*                   stored without their averages MAY be compared.
+*
+*               (2) A probe that measured NO operation, in either statistics, or NO cycle in its baseline, can
+*                   NOT be compared.
+*********************************************************************************************************
+*/
+
+CPU_INT32S  TFTPs_PerfCmp (const  TFTPs_PERF_STAT  *p_baseline,
+                           const  TFTPs_PERF_STAT  *p_stat,
+                                  TFTPs_ERR        *p_err)
+{
+    CPU_INT64U  avg_base;
+    CPU_INT64U  avg_stat;
+    CPU_INT64S  change;
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(0);
+    }
+
+    if ((p_baseline == DEF_NULL) ||
+        (p_stat     == DEF_NULL)) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return (0);
+    }
+#endif
+
+    if ((p_baseline->Nbr == 0u) ||                              /* See Note #2.                                         */
+        (p_stat->Nbr     == 0u)) {
+       *p_err = TFTPs_ERR_PERF_NO_MEASURE;
+        return (0);
+    }
+                                                                /* See Note #1.                                         */
+    avg_base = (p_baseline->CyclesTot * TFTPs_PERF_CMP_SCALE) / p_baseline->Nbr;
+    avg_stat = (p_stat->CyclesTot     * TFTPs_PERF_CMP_SCALE) / p_stat->Nbr;
+    if (avg_base == 0u) {
+       *p_err = TFTPs_ERR_PERF_NO_MEASURE;
+        return (0);
+    }
+
+    change = (((CPU_INT64S)avg_stat - (CPU_INT64S)avg_base) * TFTPs_PERF_CMP_SCALE) / (CPU_INT64S)avg_base;
+
+   *p_err = TFTPs_ERR_NONE;
+
+    return ((CPU_INT32S)change);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of perf module include.                          */
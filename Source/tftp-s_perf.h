@@ -0,0 +1,105 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER PERFORMANCE PROBES
+*
+* Filename : tftp-s_perf.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs performance probes present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_PERF_MODULE_PRESENT                              /* See Note #1.                                         */
+#define  TFTPs_PERF_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MACRO'S
+*
+* Note(s) : (1) A probe is placed around the operation it measures :
+*
+*                   TFTPs_PERF_ALLOC();                 In the declarations of the function.
+*                   ...
+*                   TFTPs_PERF_START();                 Before the operation.
+*                   ...
+*                   TFTPs_PERF_STOP(probe, octets);     After  the operation.
+*
+*               The probes expand to nothing when TFTPs_CFG_PERF_EN is disabled.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_PERF_EN == DEF_ENABLED)
+#define  TFTPs_PERF_ALLOC()                 CPU_TS_TMR  tftps_perf_ts = (CPU_TS_TMR)0
+#define  TFTPs_PERF_START()                 tftps_perf_ts = CPU_TS_TmrRd()
+#define  TFTPs_PERF_STOP(probe, octets)     TFTPs_PerfRec((probe), tftps_perf_ts, (CPU_INT32U)(octets))
+#else
+#define  TFTPs_PERF_ALLOC()
+#define  TFTPs_PERF_START()
+#define  TFTPs_PERF_STOP(probe, octets)
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void  TFTPs_PerfInit(void);
+
+void  TFTPs_PerfRec (TFTPs_PERF_PROBE  probe,
+                     CPU_TS_TMR        ts_start,
+                     CPU_INT32U        octets);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_PERF_MODULE_PRESENT  */
@@ -0,0 +1,706 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER FILE NAME REWRITING
+*
+* Filename : tftp-s_rewrite.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The rule table is compiled when it is set : rules are grouped by pattern in a hash table,
+*                & the subnets of the rules of a pattern are kept in prefix tries (see 'tftp-s_rewrite.h
+*                REWRITE PATTERN DATA TYPE').  A name is thus rewritten with one hash lookup per length of
+*                prefix pattern it may match, & one trie lookup per pattern found, whatever the number of
+*                rules.
+*
+*            (2) The name is hashed once, each prefix length being looked up as the hash of the name is
+*                computed.  The longest pattern with a rule matching the client wins; a whole name is
+*                looked up last, so that it wins over a prefix of the same length (see 'tftp-s_type.h
+*                FILE NAME REWRITE RULE DATA TYPE  Note #3').
+*
+*            (3) Two banks are allocated, so that a new table is compiled while the rules of the table in
+*                use are looked up.  The new table is swapped in once compiled; a bank is NOT compiled
+*                while its rules are looked up, in which case TFTPs_RewriteSet() fails.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_REWRITE_MODULE
+#include  "tftp-s_rewrite.h"
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_REWRITE_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_REWRITE_HASH_INIT                  2166136261u   /* FNV-1a offset basis.                                 */
+#define  TFTPs_REWRITE_HASH_PRIME                   16777619u   /* FNV-1a prime.                                        */
+
+#define  TFTPs_REWRITE_HASH_STEP(hash, c)       (((hash) ^ (CPU_INT08U)(c)) * TFTPs_REWRITE_HASH_PRIME)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+                                                                /* Rule banks (see Note #3).                            */
+static  TFTPs_REWRITE_BANK  TFTPs_RewriteBankTbl[TFTPs_REWRITE_BANK_NBR];
+static  CPU_INT08U          TFTPs_RewriteBankActive;            /* Bank of the table in use.                            */
+static  CPU_INT08U          TFTPs_RewriteBankLookup;            /* Bank being looked up, if any.                        */
+static  CPU_INT16U          TFTPs_RewriteNbrMax;                /* Max nbr of rules of a bank.                          */
+static  CPU_INT32U          TFTPs_RewriteBucketMask;            /* Nbr of hash buckets, minus 1.                        */
+                                                                /* Rewritten name.                                      */
+static  CPU_CHAR            TFTPs_RewritePathBuf[TFTPs_FS_NAME_LEN_MAX + 1u];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN         TFTPs_RewriteCompile(       TFTPs_REWRITE_BANK  *p_bank,
+                                                 const  TFTPs_REWRITE_RULE  *p_tbl,
+                                                        CPU_INT16U           nbr);
+
+static  TFTPs_REWRITE_PAT  *TFTPs_RewritePatFind(       TFTPs_REWRITE_BANK  *p_bank,
+                                                 const  CPU_CHAR            *p_name,
+                                                        CPU_INT16U           name_len,
+                                                        CPU_BOOLEAN          prefix,
+                                                        CPU_INT32U           hash);
+
+static  CPU_INT32U          TFTPs_RewriteRuleGet(       TFTPs_REWRITE_BANK  *p_bank,
+                                                        TFTPs_SESS_KEY      *p_key,
+                                                 const  CPU_CHAR            *p_name,
+                                                        CPU_INT16U           name_len,
+                                                        CPU_BOOLEAN          prefix,
+                                                        CPU_INT32U           hash);
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_RewriteInit()
+*
+* Description : Allocate the rule banks & compile the rule table of the configuration.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_REWRITE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) Each bank holds a pattern per rule, a power of 2 of hash buckets at least equal to the
+*                   number of rules, & the trie nodes of the rules (see 'tftp-s_trie.h  TRIE NODE POOL DATA
+*                   TYPE  Note #1').
+*********************************************************************************************************
+*/
+
+void  TFTPs_RewriteInit (const  TFTPs_CFG  *p_cfg,
+                                TFTPs_ERR  *p_err)
+{
+    TFTPs_REWRITE_BANK  *p_bank;
+    CPU_INT32U           bucket_nbr;
+    CPU_INT08U           ix;
+    CPU_BOOLEAN          ok;
+    LIB_ERR              err_lib;
+
+
+    if (( p_cfg->RewriteNbr    > p_cfg->RewriteNbrMax) ||
+        ((p_cfg->RewriteNbr    > 0u)                   &&
+         (p_cfg->RewriteTblPtr == DEF_NULL))) {
+       *p_err = TFTPs_ERR_CFG_INVALID_REWRITE;
+        return;
+    }
+
+    TFTPs_RewriteNbrMax     = p_cfg->RewriteNbrMax;
+    TFTPs_RewriteBankActive = 0u;
+    TFTPs_RewriteBankLookup = TFTPs_REWRITE_BANK_NONE;
+    if (TFTPs_RewriteNbrMax == 0u) {                            /* No rule : names are never rewritten.                 */
+       *p_err = TFTPs_ERR_NONE;
+        return;
+    }
+
+    bucket_nbr = 1u;                                            /* See Note #1.                                         */
+    while (bucket_nbr < TFTPs_RewriteNbrMax) {
+        bucket_nbr <<= 1u;
+    }
+    TFTPs_RewriteBucketMask = bucket_nbr - 1u;
+
+    for (ix = 0u; ix < TFTPs_REWRITE_BANK_NBR; ix++) {
+        p_bank         = &TFTPs_RewriteBankTbl[ix];
+        p_bank->PatTbl = (TFTPs_REWRITE_PAT *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Rewrite Pat Tbl",
+                                                                        DEF_NULL,
+                                                                        TFTPs_RewriteNbrMax * sizeof(TFTPs_REWRITE_PAT),
+                                                                       &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        p_bank->BucketTbl = (TFTPs_REWRITE_PAT **)Mem_SegAlloc((CPU_CHAR *)"TFTPs Rewrite Bucket Tbl",
+                                                                            DEF_NULL,
+                                                                            bucket_nbr * sizeof(TFTPs_REWRITE_PAT *),
+                                                                           &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+
+        TFTPs_TriePoolAlloc(&p_bank->NodePool,
+                            (CPU_CHAR *)"TFTPs Rewrite Trie Nodes",
+                             2u * (CPU_INT32U)TFTPs_RewriteNbrMax,
+                             p_err);
+        if (*p_err != TFTPs_ERR_NONE) {
+            return;
+        }
+    }
+
+    ok = TFTPs_RewriteCompile(&TFTPs_RewriteBankTbl[0], p_cfg->RewriteTblPtr, p_cfg->RewriteNbr);
+    if (ok != DEF_OK) {
+       *p_err = TFTPs_ERR_CFG_INVALID_REWRITE;
+        return;
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_RewriteSet()
+*
+* Description : Replace the file name rewrite rule table.
+*
+* Argument(s) : p_tbl       Pointer to rule table (see 'tftp-s_type.h  FILE NAME REWRITE RULE DATA TYPE').
+*
+*               nbr         Number of rules in table, at most the 'RewriteNbrMax' rules of the configuration.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_NULL_PTR
+*                               TFTPs_ERR_CFG_INVALID_REWRITE
+*                               TFTPs_ERR_REWRITE_BUSY
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The table is compiled in the bank NOT in use, then swapped in (see 'tftp-s_rewrite.c
+*                   Note #3').  The rules of the table apply from the next request received; on error, the
+*                   rules in use are kept.
+*
+*               (2) The table is referenced, NOT copied : it MUST remain valid while it is in use.  A table
+*                   is no longer used once the next call to this function returns without error.
+*
+*               (3) This function MUST NOT be called from several tasks at once.
+*********************************************************************************************************
+*/
+
+void  TFTPs_RewriteSet (const  TFTPs_REWRITE_RULE  *p_tbl,
+                               CPU_INT16U           nbr,
+                               TFTPs_ERR           *p_err)
+{
+    CPU_INT08U   bank_ix;
+    CPU_BOOLEAN  ok;
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+
+    if ((nbr   >  0u) &&
+        (p_tbl == DEF_NULL)) {
+       *p_err = TFTPs_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+    if ((TFTPs_RewriteNbrMax == 0u) ||
+        (nbr                 >  TFTPs_RewriteNbrMax)) {
+       *p_err = TFTPs_ERR_CFG_INVALID_REWRITE;
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();                                       /* Get bank NOT in use (see Note #1).                   */
+    bank_ix = (CPU_INT08U)(TFTPs_RewriteBankActive ^ 1u);
+    if (TFTPs_RewriteBankLookup == bank_ix) {
+        CPU_CRITICAL_EXIT();
+       *p_err = TFTPs_ERR_REWRITE_BUSY;
+        return;
+    }
+    CPU_CRITICAL_EXIT();
+
+    ok = TFTPs_RewriteCompile(&TFTPs_RewriteBankTbl[bank_ix], p_tbl, nbr);
+    if (ok != DEF_OK) {
+       *p_err = TFTPs_ERR_CFG_INVALID_REWRITE;
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    TFTPs_RewriteBankActive = bank_ix;
+    CPU_CRITICAL_EXIT();
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_RewriteApply()
+*
+* Description : Rewrite the file name of a request with the rule table in use.
+*
+* Argument(s) : p_key       Pointer to session key of the client.
+*
+*               p_name      Pointer to NUL-terminated requested file name.
+*
+* Return(s)   : Pointer to the rewritten file name, if a rule matches the request.
+*
+*               Pointer to the requested file name, if NO rule matches the request.
+*
+*               Pointer to NULL,                    if the rewritten file name is too long.
+*
+* Caller(s)   : TFTPs_FileOpen().
+*
+* Note(s)     : (1) See 'tftp-s_rewrite.c  Note #2'.
+*
+*               (2) The rewritten name is valid until the next call; it does NOT reference the rule table,
+*                   which MAY be replaced once the lookup is done.
+*********************************************************************************************************
+*/
+
+CPU_CHAR  *TFTPs_RewriteApply (TFTPs_SESS_KEY  *p_key,
+                               CPU_CHAR        *p_name)
+{
+           TFTPs_REWRITE_BANK  *p_bank;
+    const  TFTPs_REWRITE_RULE  *p_rule;
+           CPU_CHAR            *p_path;
+           CPU_SIZE_T           name_len;
+           CPU_SIZE_T           path_len;
+           CPU_SIZE_T           tail_len;
+           CPU_INT16U           match_len;
+           CPU_INT16U           len;
+           CPU_INT32U           hash;
+           CPU_INT32U           rule_ix;
+           CPU_INT32U           rule_ix_len;
+           CPU_INT08U           bank_ix;
+    CPU_SR_ALLOC();
+
+
+    if (TFTPs_RewriteNbrMax == 0u) {
+        return (p_name);
+    }
+
+    name_len = Str_Len_N(p_name, TFTPs_FS_NAME_LEN_MAX + 1u);
+    if (name_len > TFTPs_FS_NAME_LEN_MAX) {                     /* Name too long to be rewritten.                       */
+        return (p_name);
+    }
+
+    CPU_CRITICAL_ENTER();                                       /* Lock bank in use (see 'tftp-s_rewrite.c  Note #3').  */
+    bank_ix                 = TFTPs_RewriteBankActive;
+    TFTPs_RewriteBankLookup = bank_ix;
+    CPU_CRITICAL_EXIT();
+    p_bank = &TFTPs_RewriteBankTbl[bank_ix];
+
+    rule_ix   = TFTPs_REWRITE_RULE_NONE;                        /* Look up prefix patterns (see Note #1).               */
+    match_len = 0u;
+    hash      = TFTPs_REWRITE_HASH_INIT;
+    for (len = 0u; len <= name_len; len++) {
+        if (DEF_BIT_IS_SET(p_bank->PrefixLenMap[len / DEF_OCTET_NBR_BITS],
+                           DEF_BIT(len % DEF_OCTET_NBR_BITS)) == DEF_YES) {
+            rule_ix_len = TFTPs_RewriteRuleGet(p_bank, p_key, p_name, len, DEF_YES, hash);
+            if (rule_ix_len != TFTPs_REWRITE_RULE_NONE) {
+                rule_ix   = rule_ix_len;
+                match_len = len;
+            }
+        }
+        if (len < name_len) {
+            hash = TFTPs_REWRITE_HASH_STEP(hash, p_name[len]);
+        }
+    }
+                                                                /* Look up whole name.                                  */
+    rule_ix_len = TFTPs_RewriteRuleGet(p_bank, p_key, p_name, (CPU_INT16U)name_len, DEF_NO, hash);
+    if (rule_ix_len != TFTPs_REWRITE_RULE_NONE) {
+        rule_ix   = rule_ix_len;
+        match_len = (CPU_INT16U)name_len;
+    }
+
+    p_path = p_name;
+    if (rule_ix != TFTPs_REWRITE_RULE_NONE) {                   /* Build rewritten name (see Note #2).                  */
+        p_rule   = &p_bank->RuleTblPtr[rule_ix];
+        path_len =  Str_Len(p_rule->PathPtr);
+        tail_len =  name_len - match_len;
+        if (path_len + tail_len > TFTPs_FS_NAME_LEN_MAX) {
+            p_path = DEF_NULL;
+        } else {
+            Mem_Copy(TFTPs_RewritePathBuf,            p_rule->PathPtr,     path_len);
+            Mem_Copy(&TFTPs_RewritePathBuf[path_len], &p_name[match_len], tail_len);
+            TFTPs_RewritePathBuf[path_len + tail_len] = ASCII_CHAR_NULL;
+            p_path = TFTPs_RewritePathBuf;
+        }
+    }
+
+    CPU_CRITICAL_ENTER();
+    TFTPs_RewriteBankLookup = TFTPs_REWRITE_BANK_NONE;
+    CPU_CRITICAL_EXIT();
+
+    return (p_path);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_RewriteCompile()
+*
+* Description : Validate a rule table & compile it in a bank.
+*
+* Argument(s) : p_bank      Pointer to bank.
+*
+*               p_tbl       Pointer to rule table.
+*
+*               nbr         Number of rules in table.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if a rule is invalid.
+*
+* Caller(s)   : TFTPs_RewriteInit(),
+*               TFTPs_RewriteSet().
+*
+* Note(s)     : (1) See 'tftp-s_rewrite.c  Note #1'.
+*
+*               (2) The wildcard is only allowed at the end of a pattern.
+*
+*               (3) A rule whose pattern & subnet equal those of a previous rule is kept, but never wins
+*                   (see 'tftp-s_trie.c  TFTPs_TrieInsert()  Note #1').
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_RewriteCompile (       TFTPs_REWRITE_BANK  *p_bank,
+                                           const  TFTPs_REWRITE_RULE  *p_tbl,
+                                                  CPU_INT16U           nbr)
+{
+    const  TFTPs_REWRITE_RULE  *p_rule;
+           TFTPs_REWRITE_PAT   *p_pat;
+           TFTPs_REWRITE_PAT  **p_bucket;
+           CPU_CHAR            *p_wildcard;
+           CPU_SIZE_T           name_len;
+           CPU_SIZE_T           path_len;
+           CPU_BOOLEAN          prefix;
+           CPU_BOOLEAN          ok;
+           CPU_INT32U           hash;
+           CPU_INT16U           len;
+           CPU_INT16U           ix;
+
+
+    p_bank->RuleTblPtr = p_tbl;
+    p_bank->PatNbr     = 0u;
+    Mem_Clr(p_bank->BucketTbl,    (CPU_SIZE_T)(TFTPs_RewriteBucketMask + 1u) * sizeof(TFTPs_REWRITE_PAT *));
+    Mem_Clr(p_bank->PrefixLenMap, sizeof(p_bank->PrefixLenMap));
+    TFTPs_TriePoolClr(&p_bank->NodePool);
+
+    for (ix = 0u; ix < nbr; ix++) {
+        p_rule = &p_tbl[ix];
+                                                                /* ------------------ VALIDATE RULE ------------------- */
+        if ((p_rule->FilenamePatternPtr == DEF_NULL) ||
+            (p_rule->PathPtr            == DEF_NULL)) {
+            return (DEF_FAIL);
+        }
+
+        name_len = Str_Len_N(p_rule->FilenamePatternPtr, TFTPs_FS_NAME_LEN_MAX + 1u);
+        path_len = Str_Len_N(p_rule->PathPtr,            TFTPs_FS_NAME_LEN_MAX + 1u);
+        if ((name_len > TFTPs_FS_NAME_LEN_MAX) ||
+            (path_len > TFTPs_FS_NAME_LEN_MAX)) {
+            return (DEF_FAIL);
+        }
+
+        prefix     = DEF_NO;
+        p_wildcard = Str_Char_N(p_rule->FilenamePatternPtr, name_len, TFTPs_REWRITE_WILDCARD);
+        if (p_wildcard != DEF_NULL) {
+            if (p_wildcard != &p_rule->FilenamePatternPtr[name_len - 1u]) {
+                return (DEF_FAIL);                              /* See Note #2.                                         */
+            }
+            prefix = DEF_YES;
+            name_len--;
+        }
+
+        switch (p_rule->SubnetFamily) {
+            case TFTPs_CLASS_FAMILY_ANY:
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv4:
+                 if (p_rule->SubnetPrefixLen > TFTPs_TRIE_ADDR_LEN_IPv4) {
+                     return (DEF_FAIL);
+                 }
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv6:
+                 if (p_rule->SubnetPrefixLen > TFTPs_TRIE_ADDR_LEN_IPv6) {
+                     return (DEF_FAIL);
+                 }
+                 break;
+
+            default:
+                 return (DEF_FAIL);
+        }
+
+                                                                /* ----------------- GET RULE PATTERN ----------------- */
+        hash = TFTPs_REWRITE_HASH_INIT;
+        for (len = 0u; len < name_len; len++) {
+            hash = TFTPs_REWRITE_HASH_STEP(hash, p_rule->FilenamePatternPtr[len]);
+        }
+
+        p_pat = TFTPs_RewritePatFind(p_bank, p_rule->FilenamePatternPtr, (CPU_INT16U)name_len, prefix, hash);
+        if (p_pat == DEF_NULL) {
+            p_pat = &p_bank->PatTbl[p_bank->PatNbr];
+            p_bank->PatNbr++;
+
+            p_pat->NamePtr     =  p_rule->FilenamePatternPtr;
+            p_pat->Hash        =  hash;
+            p_pat->NameLen     = (CPU_INT16U)name_len;
+            p_pat->Prefix      =  prefix;
+            p_pat->RuleAnyIx   =  TFTPs_REWRITE_RULE_NONE;
+            p_pat->RootIPv4Ptr =  DEF_NULL;
+            p_pat->RootIPv6Ptr =  DEF_NULL;
+
+            p_bucket       = &p_bank->BucketTbl[hash & TFTPs_RewriteBucketMask];
+            p_pat->NextPtr = *p_bucket;
+           *p_bucket       =  p_pat;
+
+            if (prefix == DEF_YES) {
+                DEF_BIT_SET(p_bank->PrefixLenMap[name_len / DEF_OCTET_NBR_BITS],
+                            DEF_BIT(name_len % DEF_OCTET_NBR_BITS));
+            }
+        }
+
+                                                                /* ---------------- ADD RULE TO PATTERN --------------- */
+        ok = DEF_OK;
+        switch (p_rule->SubnetFamily) {
+            case TFTPs_CLASS_FAMILY_IPv4:
+                 ok = TFTPs_TrieInsert(&p_bank->NodePool,
+                                       &p_pat->RootIPv4Ptr,
+                                        p_rule->SubnetAddr,
+                                        p_rule->SubnetPrefixLen,
+                                        ix);
+                 break;
+
+            case TFTPs_CLASS_FAMILY_IPv6:
+                 ok = TFTPs_TrieInsert(&p_bank->NodePool,
+                                       &p_pat->RootIPv6Ptr,
+                                        p_rule->SubnetAddr,
+                                        p_rule->SubnetPrefixLen,
+                                        ix);
+                 break;
+
+            case TFTPs_CLASS_FAMILY_ANY:
+            default:
+                 if (p_pat->RuleAnyIx == TFTPs_REWRITE_RULE_NONE) {
+                     p_pat->RuleAnyIx = ix;                     /* See Note #3.                                         */
+                 }
+                 break;
+        }
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_RewritePatFind()
+*
+* Description : Find a pattern of a bank.
+*
+* Argument(s) : p_bank      Pointer to bank.
+*
+*               p_name      Pointer to pattern name.
+*
+*               name_len    Length of the pattern name, wildcard excluded.
+*
+*               prefix      DEF_YES for a prefix pattern, DEF_NO for a whole name.
+*
+*               hash        Hash of the pattern name.
+*
+* Return(s)   : Pointer to pattern, if found.
+*
+*               Pointer to NULL,    otherwise.
+*
+* Caller(s)   : TFTPs_RewriteCompile(),
+*               TFTPs_RewriteRuleGet().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  TFTPs_REWRITE_PAT  *TFTPs_RewritePatFind (       TFTPs_REWRITE_BANK  *p_bank,
+                                                  const  CPU_CHAR            *p_name,
+                                                         CPU_INT16U           name_len,
+                                                         CPU_BOOLEAN          prefix,
+                                                         CPU_INT32U           hash)
+{
+    TFTPs_REWRITE_PAT  *p_pat;
+    CPU_BOOLEAN         same;
+
+
+    p_pat = p_bank->BucketTbl[hash & TFTPs_RewriteBucketMask];
+    while (p_pat != DEF_NULL) {
+        if ((p_pat->Hash    == hash)     &&
+            (p_pat->NameLen == name_len) &&
+            (p_pat->Prefix  == prefix)) {
+            same = Mem_Cmp(p_pat->NamePtr, p_name, name_len);
+            if (same == DEF_YES) {
+                return (p_pat);
+            }
+        }
+        p_pat = p_pat->NextPtr;
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_RewriteRuleGet()
+*
+* Description : Find the rule of a pattern matching a client.
+*
+* Argument(s) : p_bank      Pointer to bank.
+*
+*               p_key       Pointer to session key of the client.
+*
+*               p_name      Pointer to requested file name.
+*
+*               name_len    Length of the name to look up.
+*
+*               prefix      DEF_YES to look up a prefix pattern, DEF_NO to look up a whole name.
+*
+*               hash        Hash of the 'name_len' first characters of the name.
+*
+* Return(s)   : Index of the matching rule, if any.
+*
+*               TFTPs_REWRITE_RULE_NONE,    otherwise.
+*
+* Caller(s)   : TFTPs_RewriteApply().
+*
+* Note(s)     : (1) The rule of the longest subnet prefix holding the client wins over a rule matching any
+*                   client (see 'tftp-s_class.c  TFTPs_ClassSubnetMatch()  Note #1').
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_RewriteRuleGet (       TFTPs_REWRITE_BANK  *p_bank,
+                                                 TFTPs_SESS_KEY      *p_key,
+                                          const  CPU_CHAR            *p_name,
+                                                 CPU_INT16U           name_len,
+                                                 CPU_BOOLEAN          prefix,
+                                                 CPU_INT32U           hash)
+{
+    TFTPs_REWRITE_PAT  *p_pat;
+    CPU_INT32U          rule_ix;
+
+
+    p_pat = TFTPs_RewritePatFind(p_bank, p_name, name_len, prefix, hash);
+    if (p_pat == DEF_NULL) {
+        return (TFTPs_REWRITE_RULE_NONE);
+    }
+
+    rule_ix = TFTPs_REWRITE_RULE_NONE;                          /* See Note #1.                                         */
+    switch (p_key->Family) {
+        case NET_SOCK_ADDR_FAMILY_IP_V4:
+             rule_ix = TFTPs_TrieLookup(p_pat->RootIPv4Ptr, (CPU_INT08U *)p_key->Addr, TFTPs_TRIE_ADDR_LEN_IPv4);
+             break;
+
+        case NET_SOCK_ADDR_FAMILY_IP_V6:
+             rule_ix = TFTPs_TrieLookup(p_pat->RootIPv6Ptr, (CPU_INT08U *)p_key->Addr, TFTPs_TRIE_ADDR_LEN_IPv6);
+             break;
+
+        default:
+             break;
+    }
+
+    if (rule_ix == TFTPs_REWRITE_RULE_NONE) {
+        rule_ix = p_pat->RuleAnyIx;
+    }
+
+    return (rule_ix);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of rewrite module include.                       */
@@ -0,0 +1,154 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER FILE NAME REWRITING
+*
+* Filename : tftp-s_rewrite.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs rewrite present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_REWRITE_MODULE_PRESENT                           /* See Note #1.                                         */
+#define  TFTPs_REWRITE_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+#include  "tftp-s_sess.h"
+#include  "tftp-s_trie.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_REWRITE_WILDCARD                          '*'    /* Ends a file name prefix pattern.                     */
+
+#define  TFTPs_REWRITE_BANK_NBR                            2u   /* See 'tftp-s_rewrite.c  Note #3'.                     */
+#define  TFTPs_REWRITE_BANK_NONE                 DEF_INT_08U_MAX_VAL
+
+#define  TFTPs_REWRITE_RULE_NONE         TFTPs_TRIE_VAL_NONE   /* Rule ix are trie vals.                               */
+                                                                /* Size of map of name lens.                            */
+#define  TFTPs_REWRITE_MAP_SIZE         ((TFTPs_FS_NAME_LEN_MAX + 1u) / DEF_OCTET_NBR_BITS)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      REWRITE PATTERN DATA TYPE
+*
+* Note(s) : (1) The rules of the same pattern are grouped under one pattern, hashed on its name.  The rules
+*               of each address family are kept in a prefix trie (see 'tftp-s_trie.c'), & the first rule
+*               of the TFTPs_CLASS_FAMILY_ANY family is kept apart, as it matches any client.
+*
+*           (2) 'NamePtr' points to the pattern of the first rule of the pattern, in the rule table;
+*               'NameLen' excludes the wildcard of a prefix pattern.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_rewrite_pat  TFTPs_REWRITE_PAT;
+
+struct  tftps_rewrite_pat {
+    const  CPU_CHAR         *NamePtr;                           /* Pattern                        (see Note #2).        */
+    CPU_INT32U               Hash;                              /* Hash of pattern.                                     */
+    CPU_INT16U               NameLen;                           /* Len of pattern                 (see Note #2).        */
+    CPU_BOOLEAN              Prefix;                            /* Prefix pattern.                                      */
+    CPU_INT32U               RuleAnyIx;                         /* Rule matching any client       (see Note #1).        */
+    TFTPs_TRIE_NODE         *RootIPv4Ptr;                       /* Rules of IPv4 subnets          (see Note #1).        */
+    TFTPs_TRIE_NODE         *RootIPv6Ptr;                       /* Rules of IPv6 subnets          (see Note #1).        */
+    TFTPs_REWRITE_PAT       *NextPtr;                           /* Next pattern of hash bucket.                         */
+};
+
+
+/*
+*********************************************************************************************************
+*                                       REWRITE BANK DATA TYPE
+*
+* Note(s) : (1) A bank holds the rules of a rule table, compiled for lookup (see 'tftp-s_rewrite.c
+*               Note #1').
+*
+*           (2) 'PrefixLenMap' holds one bit per name length, set when a prefix pattern of that length
+*               exists, so that a name is only looked up at the lengths of the prefix patterns.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_rewrite_bank {
+    const  TFTPs_REWRITE_RULE  *RuleTblPtr;                     /* Rule tbl.                                            */
+    TFTPs_REWRITE_PAT          *PatTbl;                         /* Patterns.                                            */
+    CPU_INT32U                  PatNbr;                         /* Nbr of patterns.                                     */
+    TFTPs_REWRITE_PAT         **BucketTbl;                      /* Hash buckets of patterns.                            */
+    TFTPs_TRIE_POOL             NodePool;                       /* Trie nodes of patterns.                              */
+                                                                /* Prefix pattern lens            (see Note #2).        */
+    CPU_INT08U                  PrefixLenMap[TFTPs_REWRITE_MAP_SIZE];
+} TFTPs_REWRITE_BANK;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void       TFTPs_RewriteInit (const  TFTPs_CFG       *p_cfg,
+                                     TFTPs_ERR       *p_err);
+
+CPU_CHAR  *TFTPs_RewriteApply(       TFTPs_SESS_KEY  *p_key,
+                                     CPU_CHAR        *p_name);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_REWRITE_MODULE_PRESENT  */
@@ -0,0 +1,593 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        TFTP SERVER SESSIONS
+*
+* Filename : tftp-s_sess.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Sessions are indexed by client TID in an open-addressing hash table using linear probing.
+*                The table holds at least twice as many slots as there are sessions, so that a lookup
+*                probes a small, bounded number of slots whatever the number of active sessions.
+*
+*            (2) Removal uses backward-shift deletion, so that no tombstone is ever left in the table &
+*                lookups of absent keys stop at the first empty slot.
+*
+*            (3) Every session object & the hash table are allocated once, by TFTPs_SessInit(), so that the
+*                session pool is O(1) & no memory is allocated while processing packets.  Packet buffers
+*                are taken from the buffer pools (see 'tftp-s_buf.c').
+*
+*            (4) This module is NOT re-entrant & MUST only be called from the TFTP server task context.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_SESS_MODULE
+#include  "tftp-s_sess.h"
+#include  <Source/net_cfg_net.h>
+
+#ifdef  NET_IPv4_MODULE_EN
+#include  <IP/IPv4/net_ipv4.h>
+#endif
+#ifdef  NET_IPv6_MODULE_EN
+#include  <IP/IPv6/net_ipv6.h>
+#endif
+
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_SESS_HASH_MULT                     0x9E3779B1u   /* Golden ratio multiplier.                             */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_SESS   *TFTPs_SessTbl;                            /* Session objects.                                     */
+static  TFTPs_SESS   *TFTPs_SessFreePtr;                        /* Free sessions list.                                  */
+static  TFTPs_SESS   *TFTPs_SessActivePtr;                      /* Active sessions list.                                */
+static  CPU_INT16U    TFTPs_SessNbrActive;
+
+static  TFTPs_SESS  **TFTPs_SessHashTbl;                        /* Hash tbl of active sessions (see Note #1).           */
+static  CPU_INT32U    TFTPs_SessHashMask;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U   TFTPs_SessHash     (TFTPs_SESS_KEY  *p_key,
+                                         CPU_INT16U       port);
+
+static  void         TFTPs_SessHashRemove(TFTPs_SESS     *p_sess);
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SessInit()
+*
+* Description : Allocate & initialize the session objects & the session hash table.
+*
+* Argument(s) : sess_nbr    Maximum number of concurrent sessions.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_SessInit (CPU_INT16U   sess_nbr,
+                      TFTPs_ERR   *p_err)
+{
+    TFTPs_SESS  *p_sess;
+    CPU_INT32U   hash_size;
+    CPU_INT32U   ix;
+    LIB_ERR      err_lib;
+
+
+    hash_size = 1u;                                             /* Hash tbl size is pwr of 2 >= 2 * sess_nbr.           */
+    while (hash_size < (2u * (CPU_INT32U)sess_nbr)) {
+        hash_size <<= 1u;
+    }
+
+    TFTPs_SessTbl = (TFTPs_SESS *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Sess Tbl",
+                                                           DEF_NULL,
+                                                           sizeof(TFTPs_SESS) * sess_nbr,
+                                                          &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_SessHashTbl = (TFTPs_SESS **)Mem_SegAlloc((CPU_CHAR *)"TFTPs Sess Hash Tbl",
+                                                                DEF_NULL,
+                                                                sizeof(TFTPs_SESS *) * hash_size,
+                                                               &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_SessHashMask = hash_size - 1u;
+    for (ix = 0u; ix < hash_size; ix++) {
+        TFTPs_SessHashTbl[ix] = DEF_NULL;
+    }
+
+    TFTPs_SessFreePtr = DEF_NULL;                               /* Build free list.                                     */
+    for (ix = sess_nbr; ix > 0u; ix--) {
+        p_sess             = &TFTPs_SessTbl[ix - 1u];
+        Mem_Clr(p_sess, sizeof(TFTPs_SESS));
+        p_sess->BufClass   =  TFTPs_BUF_CLASS_NONE;
+        p_sess->NextPtr    =  TFTPs_SessFreePtr;
+        TFTPs_SessFreePtr  =  p_sess;
+    }
+
+    TFTPs_SessActivePtr = DEF_NULL;
+    TFTPs_SessNbrActive = 0u;
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SessKeyGet()
+*
+* Description : Build the session key of a client socket address.
+*
+* Argument(s) : p_addr      Pointer to client socket address.
+*
+*               p_key       Pointer to variable that will receive the session key.
+*
+* Return(s)   : DEF_OK,   if the address family is supported.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_SessKeyGet (NET_SOCK_ADDR   *p_addr,
+                               TFTPs_SESS_KEY  *p_key)
+{
+#ifdef  NET_IPv4_MODULE_EN
+    NET_SOCK_ADDR_IPv4  *p_addr_v4;
+#endif
+#ifdef  NET_IPv6_MODULE_EN
+    NET_SOCK_ADDR_IPv6  *p_addr_v6;
+#endif
+
+
+    p_key->Addr[1] = 0u;
+    p_key->Addr[2] = 0u;
+    p_key->Addr[3] = 0u;
+
+    switch (p_addr->AddrFamily) {
+#ifdef  NET_IPv4_MODULE_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V4:
+             p_addr_v4      = (NET_SOCK_ADDR_IPv4 *)p_addr;
+             p_key->Addr[0] =  p_addr_v4->Addr;
+             p_key->Port    =  p_addr_v4->Port;
+             break;
+#endif
+#ifdef  NET_IPv6_MODULE_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V6:
+             p_addr_v6      = (NET_SOCK_ADDR_IPv6 *)p_addr;
+             Mem_Copy(&p_key->Addr[0], &p_addr_v6->Addr.Addr[0], NET_IPv6_ADDR_SIZE);
+             p_key->Port    =  p_addr_v6->Port;
+             break;
+#endif
+
+        default:
+             return (DEF_FAIL);
+    }
+
+    p_key->Family = (CPU_INT16U)p_addr->AddrFamily;
+    p_key->Hash   =  TFTPs_SessHash(p_key, p_key->Port);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SessFind()
+*
+* Description : Find the active session of a client.
+*
+* Argument(s) : p_key       Pointer to session key of the client.
+*
+* Return(s)   : Pointer to the client's session, if found.
+*
+*               Pointer to NULL,                 otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+TFTPs_SESS  *TFTPs_SessFind (TFTPs_SESS_KEY  *p_key)
+{
+    TFTPs_SESS  *p_sess;
+    CPU_INT32U   ix;
+    CPU_BOOLEAN  same;
+
+
+    ix     = p_key->Hash & TFTPs_SessHashMask;
+    p_sess = TFTPs_SessHashTbl[ix];
+    while (p_sess != DEF_NULL) {
+        same = TFTPs_SessKeyCmp(&p_sess->Key, p_key);
+        if (same == DEF_YES) {
+            return (p_sess);
+        }
+        ix     = (ix + 1u) & TFTPs_SessHashMask;
+        p_sess =  TFTPs_SessHashTbl[ix];
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SessAlloc()
+*
+* Description : Allocate a session for a new client & index it.
+*
+* Argument(s) : p_key       Pointer to session key of the client.
+*
+*               p_addr      Pointer to client socket address.
+*
+* Return(s)   : Pointer to the allocated session, if a session is available.
+*
+*               Pointer to NULL,                  otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) The caller MUST have checked that the client has no active session.
+*
+*               (2) The client token bucket is shared by the sessions of the host, & thus looked up by the
+*                   hash of the key without the port (see 'tftp-s_shape.c  Note #5').
+*********************************************************************************************************
+*/
+
+TFTPs_SESS  *TFTPs_SessAlloc (TFTPs_SESS_KEY  *p_key,
+                              NET_SOCK_ADDR   *p_addr)
+{
+    TFTPs_SESS          *p_sess;
+    TFTPs_SHAPE_BUCKET  *p_bucket;
+    CPU_INT32U           ix;
+
+
+    p_sess = TFTPs_SessFreePtr;
+    if (p_sess == DEF_NULL) {
+        return (DEF_NULL);
+    }
+                                                                /* See Note #2.                                         */
+    p_bucket = TFTPs_ShapeClientGet(p_key->Family, &p_key->Addr[0], TFTPs_SessHash(p_key, 0u));
+    if (p_bucket == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    TFTPs_SessFreePtr = p_sess->NextPtr;
+
+    p_sess->Key           = *p_key;
+    p_sess->SockAddr      = *p_addr;
+    p_sess->State         =  TFTPs_STATE_IDLE;
+    p_sess->FileHandle    =  DEF_NULL;
+    p_sess->RxBlkNbr      =  0u;
+    p_sess->TxBlkNbr      =  0u;
+    p_sess->TxBufPtr      =  DEF_NULL;
+    p_sess->BufClass      =  TFTPs_BUF_CLASS_NONE;
+    p_sess->BlkSize       =  TFTPs_BUF_BLK_SIZE_DFLT;
+    p_sess->TxMsgLen      =  0u;
+    p_sess->TxRetryCtr    =  0u;
+    p_sess->TxLastBlk     =  DEF_NO;
+    p_sess->TxPend        =  DEF_NO;
+    p_sess->XferRem       =  0u;
+    p_sess->TxQ_PrevPtr   =  DEF_NULL;
+    p_sess->TxQ_NextPtr   =  DEF_NULL;
+    p_sess->WinSize       =  1u;
+    p_sess->WinEff        =  1u;
+    p_sess->WinAckNbr     =  0u;
+    p_sess->WinAckPos     =  0u;
+    p_sess->PaceEn        =  DEF_NO;
+    p_sess->RTT_Avg       =  0u;
+    p_sess->TxTS          =  0u;
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+    p_sess->WrHeldNbr     =  0u;
+#endif
+    p_sess->ShapePtr      =  p_bucket;
+
+                                                                /* Insert in hash tbl (see Note #1).                    */
+    ix = p_key->Hash & TFTPs_SessHashMask;
+    while (TFTPs_SessHashTbl[ix] != DEF_NULL) {
+        ix = (ix + 1u) & TFTPs_SessHashMask;
+    }
+    TFTPs_SessHashTbl[ix] = p_sess;
+
+                                                                /* Insert in active list.                               */
+    p_sess->PrevPtr = DEF_NULL;
+    p_sess->NextPtr = TFTPs_SessActivePtr;
+    if (TFTPs_SessActivePtr != DEF_NULL) {
+        TFTPs_SessActivePtr->PrevPtr = p_sess;
+    }
+    TFTPs_SessActivePtr = p_sess;
+    TFTPs_SessNbrActive++;
+
+    return (p_sess);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SessFree()
+*
+* Description : Remove a session from the index & return it to the free list.
+*
+* Argument(s) : p_sess      Pointer to session to free.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Terminate().
+*
+* Note(s)     : (1) The session's timers MUST be stopped, its file closed & its buffer freed by the caller.
+*********************************************************************************************************
+*/
+
+void  TFTPs_SessFree (TFTPs_SESS  *p_sess)
+{
+    TFTPs_SessHashRemove(p_sess);
+    TFTPs_ShapeClientRelease(p_sess->ShapePtr);
+    p_sess->ShapePtr = DEF_NULL;
+                                                                /* Remove from active list.                             */
+    if (p_sess->PrevPtr != DEF_NULL) {
+        p_sess->PrevPtr->NextPtr = p_sess->NextPtr;
+    } else {
+        TFTPs_SessActivePtr      = p_sess->NextPtr;
+    }
+    if (p_sess->NextPtr != DEF_NULL) {
+        p_sess->NextPtr->PrevPtr = p_sess->PrevPtr;
+    }
+    TFTPs_SessNbrActive--;
+
+    p_sess->State     = TFTPs_STATE_IDLE;
+    p_sess->PrevPtr   = DEF_NULL;
+    p_sess->NextPtr   = TFTPs_SessFreePtr;
+    TFTPs_SessFreePtr = p_sess;
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_SessActiveFirstGet()
+*
+* Description : Get the first session of the active sessions list.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Pointer to the first active session, if any.
+*
+*               Pointer to NULL,                     otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) The next active session is found with the session's 'NextPtr'.
+*********************************************************************************************************
+*/
+
+TFTPs_SESS  *TFTPs_SessActiveFirstGet (void)
+{
+    return (TFTPs_SessActivePtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SessNbrActiveGet()
+*
+* Description : Get the number of active sessions.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Number of active sessions.
+*
+* Caller(s)   : TFTPs_Task(),
+*               TFTPs_Disp().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  TFTPs_SessNbrActiveGet (void)
+{
+    return (TFTPs_SessNbrActive);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SessKeyCmp()
+*
+* Description : Compare two session keys.
+*
+* Argument(s) : p_key1      Pointer to first  session key.
+*
+*               p_key2      Pointer to second session key.
+*
+* Return(s)   : DEF_YES, if both keys identify the same client.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_SessFind(),
+*               TFTPs_ReqQ_Push().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_SessKeyCmp (TFTPs_SESS_KEY  *p_key1,
+                               TFTPs_SESS_KEY  *p_key2)
+{
+    if ((p_key1->Hash    != p_key2->Hash)    ||
+        (p_key1->Port    != p_key2->Port)    ||
+        (p_key1->Family  != p_key2->Family)  ||
+        (p_key1->Addr[0] != p_key2->Addr[0]) ||
+        (p_key1->Addr[1] != p_key2->Addr[1]) ||
+        (p_key1->Addr[2] != p_key2->Addr[2]) ||
+        (p_key1->Addr[3] != p_key2->Addr[3])) {
+        return (DEF_NO);
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SessHash()
+*
+* Description : Compute the hash of a session key.
+*
+* Argument(s) : p_key       Pointer to session key.
+*
+*               port        Port hashed in place of the key's port, 0 to hash the host address only.
+*
+* Return(s)   : Hash of the session key.
+*
+* Caller(s)   : TFTPs_SessKeyGet(),
+*               TFTPs_SessAlloc().
+*
+* Note(s)     : (1) Each key word is mixed with a multiplicative hash, then the result goes through the
+*                   MurmurHash3 finalizer so that the low-order bits, used to index the table, depend on
+*                   every bit of the key.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_SessHash (TFTPs_SESS_KEY  *p_key,
+                                    CPU_INT16U       port)
+{
+    CPU_INT32U  hash;
+    CPU_INT08U  ix;
+
+                                                                /* See Note #1.                                         */
+    hash = ((CPU_INT32U)p_key->Family << 16u) | port;
+    for (ix = 0u; ix < 4u; ix++) {
+        hash  = (hash ^ p_key->Addr[ix]) * TFTPs_SESS_HASH_MULT;
+        hash ^=  hash >> 16u;
+    }
+
+    hash ^= hash >> 16u;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13u;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16u;
+
+    return (hash);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SessHashRemove()
+*
+* Description : Remove a session from the hash table.
+*
+* Argument(s) : p_sess      Pointer to session to remove.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SessFree().
+*
+* Note(s)     : (1) Every following entry of the probe sequence whose home slot is NOT cyclically within
+*                   ]hole, entry] is shifted back into the hole (see 'tftp-s_sess.c  Note #2').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SessHashRemove (TFTPs_SESS  *p_sess)
+{
+    TFTPs_SESS  *p_entry;
+    CPU_INT32U   hole;
+    CPU_INT32U   ix;
+    CPU_INT32U   home;
+
+
+    hole = p_sess->Key.Hash & TFTPs_SessHashMask;
+    while (TFTPs_SessHashTbl[hole] != p_sess) {
+        if (TFTPs_SessHashTbl[hole] == DEF_NULL) {              /* Sess not indexed.                                    */
+            return;
+        }
+        hole = (hole + 1u) & TFTPs_SessHashMask;
+    }
+
+    ix = (hole + 1u) & TFTPs_SessHashMask;                      /* See Note #1.                                         */
+    p_entry = TFTPs_SessHashTbl[ix];
+    while (p_entry != DEF_NULL) {
+        home = p_entry->Key.Hash & TFTPs_SessHashMask;
+        if (((ix - home) & TFTPs_SessHashMask) >= ((ix - hole) & TFTPs_SessHashMask)) {
+            TFTPs_SessHashTbl[hole] = p_entry;
+            hole                    = ix;
+        }
+        ix      = (ix + 1u) & TFTPs_SessHashMask;
+        p_entry =  TFTPs_SessHashTbl[ix];
+    }
+
+    TFTPs_SessHashTbl[hole] = DEF_NULL;
+}
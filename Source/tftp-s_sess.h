@@ -0,0 +1,265 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        TFTP SERVER SESSIONS
+*
+* Filename : tftp-s_sess.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs session present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_SESS_MODULE_PRESENT                              /* See Note #1.                                         */
+#define  TFTPs_SESS_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+#include  "tftp-s_tmr.h"
+#include  "tftp-s_buf.h"
+#include  "tftp-s_shape.h"
+#include  "tftp-s_fs.h"
+#include  "tftp-s_digest.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+                                                                /* ---- TFTP Server session states -------------------- */
+#define  TFTPs_STATE_IDLE                                  0
+#define  TFTPs_STATE_DATA_RD                               1
+#define  TFTPs_STATE_DATA_WR                               2
+#define  TFTPs_STATE_DALLY                                 3
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       SESSION KEY DATA TYPE
+*
+* Note(s) : (1) A session is identified by the address family, address & port of the client (i.e. its
+*               TID, see RFC #1350).  IPv4 addresses are stored in the first word of 'Addr', so that IPv4
+*               & IPv6 clients are hashed & compared the same way.
+*
+*           (2) 'Hash' is computed once per received packet by TFTPs_SessKeyGet() & is NOT part of the
+*               compared key.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sess_key {
+    CPU_INT32U  Addr[4];                                        /* Client addr (see Note #1), network order.            */
+    CPU_INT16U  Port;                                           /* Client port,               network order.            */
+    CPU_INT16U  Family;                                         /* Client addr family.                                  */
+    CPU_INT32U  Hash;                                           /* Hash of the fields above (see Note #2).              */
+} TFTPs_SESS_KEY;
+
+
+/*
+*********************************************************************************************************
+*                                       HELD BLOCK DATA TYPE
+*
+* Note(s) : (1) A DATA block of a write request received ahead of the next block expected is held until
+*               the blocks before it are received (see 'tftp-s.c  Note #10').  Its data is copied to a
+*               packet buffer of the session's block size (see 'tftp-s_buf.c').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+typedef  struct  tftps_wr_blk {
+    CPU_INT08U         *BufPtr;                                 /* Data of block (see Note #1).                         */
+    CPU_INT08U          BufClass;                               /* Class of BufPtr buffer.                              */
+    CPU_INT16U          BlkNbr;                                 /* Block nbr.                                           */
+    CPU_INT16U          Len;                                    /* Len of data.                                         */
+} TFTPs_WR_BLK;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          SESSION DATA TYPE
+*
+* Note(s) : (1) The outgoing packet buffer is taken from the buffer pool matching the negotiated block
+*               size when the request is accepted (see 'tftp-s_buf.c').
+*
+*           (2) A packet deferred by the egress shaper (see 'tftp-s_shape.c  Note #1') is kept in TxBufPtr &
+*               the session is linked in the transmit queue until the packet is sent.
+*
+*           (3) 'XferRem' is the file data left to send, used to order the transmit queue (see
+*               'tftp-s_type.h  TRANSMIT SCHEDULER POLICY DATA TYPE').  Sessions of a write request
+*               only send ACKs & are thus queued as if their transfer was complete.
+*
+*           (4) 'ClassIx' is the traffic class of the request (see 'tftp-s_class.c'), set when the request
+*               is accepted.
+*
+*           (5) Requests MAY negotiate a window of 'WinSize' DATA blocks sent before an ACK is awaited
+*               (see RFC #7440).  For a read request, 'WinAckNbr' is the last block acknowledged by the
+*               client & 'WinAckPos' the file offset of the block following it, from which the window is
+*               sent again on loss.  For a write request, 'WinAckNbr' is the last block acknowledged by
+*               the server, & 'TxBlkNbr' the last block written.
+*
+*           (6) With pacing, the blocks of a window are spread over the smoothed round-trip time 'RTT_Avg'
+*               by the pacing timer, rather than sent back to back (see 'tftp-s.c  Note #6').
+*
+*           (7) 'WinEff' is the number of blocks actually sent per round-trip time, adapted to losses
+*               between 1 & 'WinSize' (see 'tftp-s.c  Note #7').
+*
+*           (8) 'XferLen' is the number of octets of file data transferred so far, each octet counted once
+*               even when sent again.  'Digest' is computed over the same octets (see 'tftp-s.c  Note #8').
+*
+*           (9) 'WrHeldTbl' holds the first 'WrHeldNbr' blocks of a write request received out of order
+*               (see 'HELD BLOCK DATA TYPE').
+*
+*          (10) 'SockIx' is the server socket the request was received on, from which all the packets of
+*               the session are sent, & 'ListenIx' the listener of that socket (see 'tftp-s.c  Note #11').
+*
+*          (11) 'ShapePtr' is shared by all the sessions of the client host (see 'tftp-s_shape.c  Note #5').
+*
+*          (12) 'WinTxMaxNbr' is the last block sent to the client, even when the window went back since,
+*               & 'WinTxMaxLast' is DEF_YES if it is the last block of the file.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sess  TFTPs_SESS;
+
+struct  tftps_sess {
+    TFTPs_SESS_KEY      Key;                                    /* Client TID.                                          */
+    NET_SOCK_ADDR       SockAddr;                               /* Client sock addr.                                    */
+
+    CPU_INT08U          State;                                  /* Current state of session state machine.              */
+    TFTPs_FS_FILE      *FileHandle;                             /* File handle of currently opened file.                */
+
+    CPU_INT16U          RxBlkNbr;                               /* Current block number received.                       */
+    CPU_INT16U          TxBlkNbr;                               /* Current block number being sent.                     */
+
+    CPU_INT08U         *TxBufPtr;                               /* Outgoing packet buffer (see Note #1).                */
+    CPU_INT08U          BufClass;                               /* Class of TxBufPtr buffer.                            */
+    CPU_INT16U          BlkSize;                                /* Negotiated block size.                               */
+    CPU_SIZE_T          TxMsgLen;                               /* Length of last pkt sent from TxBufPtr.               */
+    CPU_INT08U          TxRetryCtr;                             /* Nbr of re-tx of the last pkt sent.                   */
+    CPU_BOOLEAN         TxLastBlk;                              /* Last block of the file was sent.                     */
+    CPU_BOOLEAN         TxPend;                                 /* Pkt in TxBufPtr waits in tx Q (see Note #2).         */
+    TFTPs_SHAPE_BUCKET *ShapePtr;                               /* Client token bucket of the host (see Note #11).      */
+    CPU_INT32U          XferRem;                                /* Nbr of octets left to send (see Note #3).            */
+    CPU_INT32U          TxQ_TS;                                 /* Time stamp (ms) the session was queued.              */
+    CPU_INT08U          ClassIx;                                /* Traffic class (see Note #4).                         */
+    CPU_INT16U          SockIx;                                 /* Server sock   (see Note #10).                        */
+    CPU_INT08U          ListenIx;                               /* Listener      (see Note #10).                        */
+
+    CPU_INT16U          WinSize;                                /* Negotiated window size (see Note #5).                */
+    CPU_INT16U          WinEff;                                 /* Effective window size  (see Note #7).                */
+    CPU_INT16U          WinAckNbr;                              /* Last block ACK'd       (see Note #5).                */
+    CPU_INT32U          WinAckPos;                              /* File pos after WinAckNbr (see Note #5).              */
+    CPU_INT16U          WinTxMaxNbr;                            /* Last block sent        (see Note #12).               */
+    CPU_BOOLEAN         WinTxMaxLast;                           /* Last block of file sent (see Note #12).              */
+    CPU_BOOLEAN         PaceEn;                                 /* Window pacing en       (see Note #6).                */
+    CPU_INT32U          RTT_Avg;                                /* Smoothed RTT (ms)      (see Note #6).                */
+    CPU_INT32U          TxTS;                                   /* Time stamp (ms) of last pkt sent.                    */
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)
+                                                                /* Blocks rx'd out of order (see Note #9).              */
+    TFTPs_WR_BLK        WrHeldTbl[TFTPs_CFG_WR_REORDER_NBR_MAX];
+    CPU_INT08U          WrHeldNbr;                              /* Nbr of held blocks     (see Note #9).                */
+#endif
+
+    CPU_CHAR            FileName[TFTPs_FS_NAME_LEN_MAX + 1u];   /* Requested file name.                                 */
+    CPU_INT32U          XferLen;                                /* Nbr of octets xfer'd   (see Note #8).                */
+#if (TFTPs_CFG_DIGEST_EN == DEF_ENABLED)
+    TFTPs_DIGEST        Digest;                                 /* Digest of xfer'd data  (see Note #8).                */
+#endif
+
+    TFTPs_TMR           TmrRetx;                                /* Retransmission timer.                                */
+    TFTPs_TMR           TmrIdle;                                /* Idle session timer.                                  */
+#if (TFTPs_CFG_WR_EN == DEF_ENABLED)
+    TFTPs_TMR           TmrDally;                               /* Dally timer, after final ACK of a WRQ.               */
+#endif
+    TFTPs_TMR           TmrPace;                                /* Window pacing timer    (see Note #6).                */
+
+    TFTPs_SESS         *PrevPtr;                                /* Ptr to prev sess in active list.                     */
+    TFTPs_SESS         *NextPtr;                                /* Ptr to next sess in active or free list.             */
+    TFTPs_SESS         *TxQ_PrevPtr;                            /* Ptr to prev sess in tx Q.                            */
+    TFTPs_SESS         *TxQ_NextPtr;                            /* Ptr to next sess in tx Q.                            */
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void         TFTPs_SessInit          (CPU_INT16U       sess_nbr,
+                                      TFTPs_ERR       *p_err);
+
+CPU_BOOLEAN  TFTPs_SessKeyGet        (NET_SOCK_ADDR   *p_addr,
+                                      TFTPs_SESS_KEY  *p_key);
+
+CPU_BOOLEAN  TFTPs_SessKeyCmp        (TFTPs_SESS_KEY  *p_key1,
+                                      TFTPs_SESS_KEY  *p_key2);
+
+TFTPs_SESS  *TFTPs_SessFind          (TFTPs_SESS_KEY  *p_key);
+
+TFTPs_SESS  *TFTPs_SessAlloc         (TFTPs_SESS_KEY  *p_key,
+                                      NET_SOCK_ADDR   *p_addr);
+
+void         TFTPs_SessFree          (TFTPs_SESS      *p_sess);
+
+TFTPs_SESS  *TFTPs_SessActiveFirstGet(void);
+
+CPU_INT16U   TFTPs_SessNbrActiveGet  (void);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_SESS_MODULE_PRESENT  */
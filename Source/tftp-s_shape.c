@@ -0,0 +1,813 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER EGRESS SHAPING
+*
+* Filename : tftp-s_shape.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The packets of the sessions are shaped by two token buckets : a global bucket shared by all
+*                the sessions, that bounds the bandwidth used by the server, & a client bucket per client
+*                host, shared by all the sessions of the host whatever their port, that bounds the bandwidth
+*                a single host can take from the global bucket.  A packet is sent only once both buckets
+*                hold enough tokens; it is deferred otherwise, never dropped.
+*
+*            (2) The rate & burst size of both buckets can be changed at run-time by the application, while
+*                the buckets are only accessed from the TFTP server task context.
+*
+*            (3) The sessions of a traffic class with a bandwidth share also go through a class bucket, whose
+*                rate & burst size are the share of the global ones (see 'tftp-s_type.h  TRAFFIC CLASS
+*                CONFIGURATION DATA TYPE  Note #5').  A class bucket is thus disabled while the global bucket
+*                is disabled.
+*
+*            (4) The sessions of a listener with a rate also go through the listener's bucket (see
+*                'tftp-s_type.h  LISTENER CONFIGURATION DATA TYPE  Note #2b'), so that the sessions of a
+*                listener can NOT take the bandwidth of the others.
+*
+*            (5) The client buckets are kept in a table of one entry per session, indexed by a hash table
+*                on the session key hash computed without the port (see 'tftp-s_sess.c  TFTPs_SessAlloc()').
+*                An entry is taken by the first session of a host & freed with its last session.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_SHAPE_MODULE
+#include  "tftp-s_shape.h"
+#include  "tftp-s_tmr.h"
+#include  "tftp-s_class.h"
+#include  "tftp-s_listen.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_shape_param {
+    CPU_INT32U  Rate;                                           /* Rate  (octets/s), 0 if unlimited.                    */
+    CPU_INT32U  Burst;                                          /* Burst (octets).                                      */
+} TFTPs_SHAPE_PARAM;
+
+
+typedef  struct  tftps_shape_client  TFTPs_SHAPE_CLIENT;
+
+struct  tftps_shape_client {
+    TFTPs_SHAPE_BUCKET   Bucket;                                /* Client bucket, MUST be first (see Note #5).          */
+    CPU_INT32U           Addr[4];                               /* Host addr, network order.                            */
+    CPU_INT16U           Family;                                /* Host addr family.                                    */
+    CPU_INT16U           SessNbr;                               /* Nbr of sessions of the host.                         */
+    CPU_INT32U           Hash;                                  /* Hash of host addr.                                   */
+    TFTPs_SHAPE_CLIENT  *NextPtr;                               /* Next free entry.                                     */
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_SHAPE_PARAM   TFTPs_ShapeGlobalParam;             /* Global bucket params (see Note #2).                  */
+static  TFTPs_SHAPE_PARAM   TFTPs_ShapeClientParam;             /* Client bucket params (see Note #2).                  */
+
+static  TFTPs_SHAPE_BUCKET  TFTPs_ShapeGlobalBucket;
+                                                                /* Class buckets (see Note #3).                         */
+static  TFTPs_SHAPE_BUCKET  TFTPs_ShapeClassBucket[TFTPs_CLASS_NBR_MAX];
+
+static  TFTPs_SHAPE_CLIENT   *TFTPs_ShapeClientTbl;             /* Client buckets (see Note #5).                        */
+static  TFTPs_SHAPE_CLIENT  **TFTPs_ShapeClientHashTbl;         /* Hash tbl of client buckets in use.                   */
+static  CPU_INT32U            TFTPs_ShapeClientHashMask;
+static  TFTPs_SHAPE_CLIENT   *TFTPs_ShapeClientFreePtr;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR   TFTPs_ShapeParamChk     (CPU_INT32U           rate,
+                                             CPU_INT32U           burst);
+
+static  void        TFTPs_ShapeRefill       (TFTPs_SHAPE_BUCKET  *p_bucket,
+                                             TFTPs_SHAPE_PARAM   *p_param,
+                                             CPU_INT32U           ts_now);
+
+static  CPU_INT32U  TFTPs_ShapeDlyCalc      (TFTPs_SHAPE_BUCKET  *p_bucket,
+                                             TFTPs_SHAPE_PARAM   *p_param,
+                                             CPU_INT32U           len);
+
+static  void        TFTPs_ShapeClassParamGet(TFTPs_SHAPE_PARAM   *p_param_global,
+                                             CPU_INT08U           class_ix,
+                                             TFTPs_SHAPE_PARAM   *p_param_class);
+
+static  void        TFTPs_ShapeClientRemove (TFTPs_SHAPE_CLIENT  *p_client);
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_ShapeInit()
+*
+* Description : Initialize the shaping parameters, the global & the class token buckets, & allocate the
+*               client token buckets.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_SHAPE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) Buckets start full, so that the first burst of the server is NOT delayed.
+*
+*               (2) Each session holds at most one client bucket, so that one entry per session is enough
+*                   (see 'tftp-s_shape.c  Note #5').  The hash table is at least twice as large.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ShapeInit (const  TFTPs_CFG  *p_cfg,
+                              TFTPs_ERR  *p_err)
+{
+    TFTPs_SHAPE_PARAM  param_class;
+    CPU_INT32U         hash_size;
+    CPU_INT32U         client_ix;
+    CPU_INT08U         ix;
+    LIB_ERR            err_lib;
+
+
+   *p_err = TFTPs_ShapeParamChk(p_cfg->ShapeRateGlobal, p_cfg->ShapeBurstGlobal);
+    if (*p_err != TFTPs_ERR_NONE) {
+         return;
+    }
+   *p_err = TFTPs_ShapeParamChk(p_cfg->ShapeRateClient, p_cfg->ShapeBurstClient);
+    if (*p_err != TFTPs_ERR_NONE) {
+         return;
+    }
+
+    TFTPs_ShapeGlobalParam.Rate  = p_cfg->ShapeRateGlobal;
+    TFTPs_ShapeGlobalParam.Burst = p_cfg->ShapeBurstGlobal;
+    TFTPs_ShapeClientParam.Rate  = p_cfg->ShapeRateClient;
+    TFTPs_ShapeClientParam.Burst = p_cfg->ShapeBurstClient;
+
+                                                                /* See Note #1.                                         */
+    TFTPs_ShapeGlobalBucket.Tokens  = (CPU_INT32S)TFTPs_ShapeGlobalParam.Burst;
+    TFTPs_ShapeGlobalBucket.TS_Last =  TFTPs_TmrNowGet();
+
+    for (ix = 0u; ix < TFTPs_CLASS_NBR_MAX; ix++) {
+        TFTPs_ShapeClassParamGet(&TFTPs_ShapeGlobalParam, ix, &param_class);
+        TFTPs_ShapeClassBucket[ix].Tokens  = (CPU_INT32S)param_class.Burst;
+        TFTPs_ShapeClassBucket[ix].TS_Last =  TFTPs_TmrNowGet();
+    }
+
+    hash_size = 1u;                                             /* See Note #2.                                         */
+    while (hash_size < (2u * (CPU_INT32U)p_cfg->SessNbrMax)) {
+        hash_size <<= 1u;
+    }
+
+    TFTPs_ShapeClientTbl = (TFTPs_SHAPE_CLIENT *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Shape Client Tbl",
+                                                                          DEF_NULL,
+                                                                          sizeof(TFTPs_SHAPE_CLIENT) * p_cfg->SessNbrMax,
+                                                                         &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_ShapeClientHashTbl = (TFTPs_SHAPE_CLIENT **)Mem_SegAlloc((CPU_CHAR *)"TFTPs Shape Client Hash Tbl",
+                                                                               DEF_NULL,
+                                                                               sizeof(TFTPs_SHAPE_CLIENT *) * hash_size,
+                                                                              &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_ShapeClientHashMask = hash_size - 1u;
+    for (client_ix = 0u; client_ix < hash_size; client_ix++) {
+        TFTPs_ShapeClientHashTbl[client_ix] = DEF_NULL;
+    }
+
+    TFTPs_ShapeClientFreePtr = DEF_NULL;                        /* Build free list.                                     */
+    for (client_ix = p_cfg->SessNbrMax; client_ix > 0u; client_ix--) {
+        TFTPs_ShapeClientTbl[client_ix - 1u].SessNbr = 0u;
+        TFTPs_ShapeClientTbl[client_ix - 1u].NextPtr = TFTPs_ShapeClientFreePtr;
+        TFTPs_ShapeClientFreePtr = &TFTPs_ShapeClientTbl[client_ix - 1u];
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_ShapeGlobalSet()
+*
+* Description : Change the rate & burst size of the global token bucket.
+*
+* Argument(s) : rate        Rate, in octets per second, of all the sessions together.
+*
+*                               TFTPs_SHAPE_RATE_UNLIMITED      Disable the global bucket.
+*
+*               burst       Burst size, in octets.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_SHAPE
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The new parameters apply to the next packet sent by the server.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ShapeGlobalSet (CPU_INT32U   rate,
+                            CPU_INT32U   burst,
+                            TFTPs_ERR   *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+#endif
+
+   *p_err = TFTPs_ShapeParamChk(rate, burst);
+    if (*p_err != TFTPs_ERR_NONE) {
+         return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    TFTPs_ShapeGlobalParam.Rate  = rate;
+    TFTPs_ShapeGlobalParam.Burst = burst;
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_ShapeClientSet()
+*
+* Description : Change the rate & burst size of the client token buckets.
+*
+* Argument(s) : rate        Rate, in octets per second, of each client host (see 'tftp-s_shape.c  Note #1').
+*
+*                               TFTPs_SHAPE_RATE_UNLIMITED      Disable the client buckets.
+*
+*               burst       Burst size, in octets.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_SHAPE
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP server application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The new parameters apply to the sessions in progress (see 'tftp-s_shape.h  TOKEN BUCKET
+*                   DATA TYPE  Note #2').
+*********************************************************************************************************
+*/
+
+void  TFTPs_ShapeClientSet (CPU_INT32U   rate,
+                            CPU_INT32U   burst,
+                            TFTPs_ERR   *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#if (TFTPs_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(;);
+    }
+#endif
+
+   *p_err = TFTPs_ShapeParamChk(rate, burst);
+    if (*p_err != TFTPs_ERR_NONE) {
+         return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    TFTPs_ShapeClientParam.Rate  = rate;
+    TFTPs_ShapeClientParam.Burst = burst;
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_ShapeClientGet()
+*
+* Description : Get the client token bucket of the host of a new session.
+*
+* Argument(s) : family      Address family of the host.
+*
+*               p_addr      Pointer to address of the host (see 'tftp-s_sess.h  SESSION KEY DATA TYPE
+*                           Note #1').
+*
+*               hash        Hash of the session key, computed without the port.
+*
+* Return(s)   : Pointer to the client token bucket of the host, if available.
+*
+*               Pointer to NULL,                                otherwise.
+*
+* Caller(s)   : TFTPs_SessAlloc().
+*
+* Note(s)     : (1) The sessions of a host share its bucket (see 'tftp-s_shape.c  Note #5').  The bucket of
+*                   the first session of a host starts full (see 'TFTPs_ShapeInit()  Note #1').
+*
+*               (2) Each call MUST be matched by a call to TFTPs_ShapeClientRelease() once the session ends.
+*********************************************************************************************************
+*/
+
+TFTPs_SHAPE_BUCKET  *TFTPs_ShapeClientGet (       CPU_INT16U   family,
+                                           const  CPU_INT32U  *p_addr,
+                                                  CPU_INT32U   hash)
+{
+    TFTPs_SHAPE_CLIENT  *p_client;
+    CPU_INT32U           burst;
+    CPU_INT32U           ix;
+    CPU_SR_ALLOC();
+
+                                                                /* Find bucket of the host (see Note #1).               */
+    ix       = hash & TFTPs_ShapeClientHashMask;
+    p_client = TFTPs_ShapeClientHashTbl[ix];
+    while (p_client != DEF_NULL) {
+        if ((p_client->Hash    == hash)      &&
+            (p_client->Family  == family)    &&
+            (p_client->Addr[0] == p_addr[0]) &&
+            (p_client->Addr[1] == p_addr[1]) &&
+            (p_client->Addr[2] == p_addr[2]) &&
+            (p_client->Addr[3] == p_addr[3])) {
+            p_client->SessNbr++;
+            return (&p_client->Bucket);
+        }
+        ix       = (ix + 1u) & TFTPs_ShapeClientHashMask;
+        p_client =  TFTPs_ShapeClientHashTbl[ix];
+    }
+
+    p_client = TFTPs_ShapeClientFreePtr;                        /* First session of the host.                           */
+    if (p_client == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    TFTPs_ShapeClientFreePtr = p_client->NextPtr;
+
+    CPU_CRITICAL_ENTER();
+    burst = TFTPs_ShapeClientParam.Burst;
+    CPU_CRITICAL_EXIT();
+
+    p_client->Bucket.Tokens  = (CPU_INT32S)burst;
+    p_client->Bucket.TS_Last =  TFTPs_TmrNowGet();
+    p_client->Addr[0]        =  p_addr[0];
+    p_client->Addr[1]        =  p_addr[1];
+    p_client->Addr[2]        =  p_addr[2];
+    p_client->Addr[3]        =  p_addr[3];
+    p_client->Family         =  family;
+    p_client->SessNbr        =  1u;
+    p_client->Hash           =  hash;
+    p_client->NextPtr        =  DEF_NULL;
+
+    TFTPs_ShapeClientHashTbl[ix] = p_client;                    /* First free slot of the probe sequence.               */
+
+    return (&p_client->Bucket);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_ShapeClientRelease()
+*
+* Description : Release the client token bucket of an ending session.
+*
+* Argument(s) : p_bucket    Pointer to client token bucket, as returned by TFTPs_ShapeClientGet().
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SessFree().
+*
+* Note(s)     : (1) The bucket is freed with the last session of its host (see 'tftp-s_shape.c  Note #5').
+*********************************************************************************************************
+*/
+
+void  TFTPs_ShapeClientRelease (TFTPs_SHAPE_BUCKET  *p_bucket)
+{
+    TFTPs_SHAPE_CLIENT  *p_client;
+
+
+    if (p_bucket == DEF_NULL) {
+        return;
+    }
+
+    p_client = (TFTPs_SHAPE_CLIENT *)p_bucket;                  /* Bucket is the first member of the entry.             */
+    p_client->SessNbr--;
+    if (p_client->SessNbr > 0u) {                               /* See Note #1.                                         */
+        return;
+    }
+
+    TFTPs_ShapeClientRemove(p_client);
+    p_client->NextPtr        = TFTPs_ShapeClientFreePtr;
+    TFTPs_ShapeClientFreePtr = p_client;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_ShapeTxDlyGet()
+*
+* Description : Get the time to wait before a session's packet may be sent.
+*
+* Argument(s) : p_bucket    Pointer to client token bucket of the session's host.
+*
+*               class_ix    Index of the traffic class of the session.
+*
+*               listen_ix   Index of the listener of the session.
+*
+*               len         Length of the packet, in octets.
+*
+* Return(s)   : Time to wait, in milliseconds, if the global, class, listener or client bucket lacks tokens.
+*
+*               0,                             if the packet may be sent now.
+*
+* Caller(s)   : TFTPs_TxSched().
+*
+* Note(s)     : (1) The delay is only an estimate, as the global bucket may be drained by other sessions
+*                   in the meantime.  A deferred packet is thus checked again once the delay has elapsed.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_ShapeTxDlyGet (TFTPs_SHAPE_BUCKET  *p_bucket,
+                                 CPU_INT08U           class_ix,
+                                 CPU_INT08U           listen_ix,
+                                 CPU_INT32U           len)
+{
+    TFTPs_SHAPE_PARAM   param_global;
+    TFTPs_SHAPE_PARAM   param_client;
+    TFTPs_SHAPE_PARAM   param_class;
+    TFTPs_SHAPE_PARAM   param_listen;
+    TFTPs_SHAPE_BUCKET *p_bucket_listen;
+    CPU_INT32U          ts_now;
+    CPU_INT32U          dly_global;
+    CPU_INT32U          dly_client;
+    CPU_INT32U          dly_class;
+    CPU_INT32U          dly_listen;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    param_global = TFTPs_ShapeGlobalParam;
+    param_client = TFTPs_ShapeClientParam;
+    CPU_CRITICAL_EXIT();
+
+    ts_now = TFTPs_TmrNowGet();
+
+    TFTPs_ShapeRefill(&TFTPs_ShapeGlobalBucket, &param_global, ts_now);
+    TFTPs_ShapeRefill( p_bucket,                &param_client, ts_now);
+
+    dly_global = TFTPs_ShapeDlyCalc(&TFTPs_ShapeGlobalBucket, &param_global, len);
+    dly_client = TFTPs_ShapeDlyCalc( p_bucket,                &param_client, len);
+    dly_class  = 0u;
+
+    if (class_ix < TFTPs_CLASS_NBR_MAX) {
+        TFTPs_ShapeClassParamGet(&param_global, class_ix, &param_class);
+        TFTPs_ShapeRefill(&TFTPs_ShapeClassBucket[class_ix], &param_class, ts_now);
+        dly_class = TFTPs_ShapeDlyCalc(&TFTPs_ShapeClassBucket[class_ix], &param_class, len);
+    }
+                                                                /* See Note #4.                                         */
+    p_bucket_listen = TFTPs_ListenBucketGet(listen_ix, &param_listen.Rate, &param_listen.Burst);
+    TFTPs_ShapeRefill(p_bucket_listen, &param_listen, ts_now);
+    dly_listen      = TFTPs_ShapeDlyCalc(p_bucket_listen, &param_listen, len);
+
+    dly_global = DEF_MAX(dly_global, dly_class);
+    dly_client = DEF_MAX(dly_client, dly_listen);
+    return (DEF_MAX(dly_global, dly_client));                   /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ShapeTxDone()
+*
+* Description : Take the tokens of a packet sent from the global, class, listener & client token buckets.
+*
+* Argument(s) : p_bucket    Pointer to client token bucket of the session's host.
+*
+*               class_ix    Index of the traffic class of the session.
+*
+*               listen_ix   Index of the listener of the session.
+*
+*               len         Length of the packet, in octets.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TxSched().
+*
+* Note(s)     : (1) Tokens are taken even when a bucket is disabled, so that a bucket enabled at run-time
+*                   starts from a bounded state; they are refilled up to the burst size at the next refill.
+*********************************************************************************************************
+*/
+
+void  TFTPs_ShapeTxDone (TFTPs_SHAPE_BUCKET  *p_bucket,
+                         CPU_INT08U           class_ix,
+                         CPU_INT08U           listen_ix,
+                         CPU_INT32U           len)
+{
+    TFTPs_SHAPE_BUCKET  *p_bucket_listen;
+    CPU_INT32U           rate;
+    CPU_INT32U           burst;
+
+
+    TFTPs_ShapeGlobalBucket.Tokens -= (CPU_INT32S)len;          /* See Note #1.                                         */
+    p_bucket->Tokens               -= (CPU_INT32S)len;
+
+    p_bucket_listen                 = TFTPs_ListenBucketGet(listen_ix, &rate, &burst);
+    p_bucket_listen->Tokens        -= (CPU_INT32S)len;
+
+    if (class_ix < TFTPs_CLASS_NBR_MAX) {
+        TFTPs_ShapeClassBucket[class_ix].Tokens -= (CPU_INT32S)len;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_ShapeParamChk()
+*
+* Description : Validate the rate & burst size of a token bucket.
+*
+* Argument(s) : rate        Rate, in octets per second.
+*
+*               burst       Burst size, in octets.
+*
+* Return(s)   : TFTPs_ERR_NONE,              if parameters are valid.
+*
+*               TFTPs_ERR_CFG_INVALID_SHAPE, otherwise.
+*
+* Caller(s)   : TFTPs_ShapeInit(),
+*               TFTPs_ShapeGlobalSet(),
+*               TFTPs_ShapeClientSet().
+*
+* Note(s)     : (1) A limited bucket MUST have a non-zero burst size, as no packet could ever be sent
+*                   otherwise.
+*********************************************************************************************************
+*/
+
+static  TFTPs_ERR  TFTPs_ShapeParamChk (CPU_INT32U  rate,
+                                        CPU_INT32U  burst)
+{
+    if ((rate  != TFTPs_SHAPE_RATE_UNLIMITED) &&                /* See Note #1.                                         */
+        (burst == 0u)) {
+        return (TFTPs_ERR_CFG_INVALID_SHAPE);
+    }
+
+    if (burst > TFTPs_SHAPE_BURST_MAX) {
+        return (TFTPs_ERR_CFG_INVALID_SHAPE);
+    }
+
+    return (TFTPs_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_ShapeRefill()
+*
+* Description : Add the tokens earned since the last refill to a token bucket.
+*
+* Argument(s) : p_bucket    Pointer to token bucket.
+*
+*               p_param     Pointer to parameters of the bucket.
+*
+*               ts_now      Current time stamp, in milliseconds.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_ShapeTxDlyGet().
+*
+* Note(s)     : (1) The time stamp of the bucket only moves by the time matching the tokens added, so that
+*                   the fraction of a token earned between two refills is NOT lost at low rates.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_ShapeRefill (TFTPs_SHAPE_BUCKET  *p_bucket,
+                                 TFTPs_SHAPE_PARAM   *p_param,
+                                 CPU_INT32U           ts_now)
+{
+    CPU_INT64U  tokens_add;
+    CPU_INT64S  tokens_room;
+
+
+    if (p_param->Rate == TFTPs_SHAPE_RATE_UNLIMITED) {
+        p_bucket->Tokens  = (CPU_INT32S)p_param->Burst;
+        p_bucket->TS_Last =  ts_now;
+        return;
+    }
+
+    tokens_add  = ((CPU_INT64U)(ts_now - p_bucket->TS_Last) * p_param->Rate) / DEF_TIME_NBR_mS_PER_SEC;
+    tokens_room =  (CPU_INT64S)p_param->Burst - p_bucket->Tokens;
+
+    if ((CPU_INT64S)tokens_add >= tokens_room) {                /* Bucket full (or burst size reduced).                 */
+        p_bucket->Tokens   = (CPU_INT32S)p_param->Burst;
+        p_bucket->TS_Last  =  ts_now;
+
+    } else if (tokens_add > 0u) {                               /* See Note #1.                                         */
+        p_bucket->Tokens  += (CPU_INT32S)tokens_add;
+        p_bucket->TS_Last += (CPU_INT32U)((tokens_add * DEF_TIME_NBR_mS_PER_SEC) / p_param->Rate);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_ShapeDlyCalc()
+*
+* Description : Compute the time until a token bucket holds enough tokens for a packet.
+*
+* Argument(s) : p_bucket    Pointer to token bucket.
+*
+*               p_param     Pointer to parameters of the bucket.
+*
+*               len         Length of the packet, in octets.
+*
+* Return(s)   : Time to wait, in milliseconds.
+*
+* Caller(s)   : TFTPs_ShapeTxDlyGet().
+*
+* Note(s)     : (1) See 'tftp-s_shape.h  TOKEN BUCKET DATA TYPE  Note #1'.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_ShapeDlyCalc (TFTPs_SHAPE_BUCKET  *p_bucket,
+                                        TFTPs_SHAPE_PARAM   *p_param,
+                                        CPU_INT32U           len)
+{
+    CPU_INT32S  tokens_needed;
+    CPU_INT64U  dly_ms;
+
+
+    if (p_param->Rate == TFTPs_SHAPE_RATE_UNLIMITED) {
+        return (0u);
+    }
+
+    tokens_needed = (CPU_INT32S)DEF_MIN(len, p_param->Burst);   /* See Note #1.                                         */
+    if (p_bucket->Tokens >= tokens_needed) {
+        return (0u);
+    }
+
+    dly_ms = ((CPU_INT64U)((CPU_INT64S)tokens_needed - p_bucket->Tokens) * DEF_TIME_NBR_mS_PER_SEC
+           +  p_param->Rate - 1u) / p_param->Rate;
+    if (dly_ms >= TFTPs_TMR_TIME_INFINITE) {
+        dly_ms  = TFTPs_TMR_TIME_INFINITE - 1u;
+    }
+
+    return ((CPU_INT32U)dly_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_ShapeClassParamGet()
+*
+* Description : Get the parameters of the token bucket of a traffic class.
+*
+* Argument(s) : p_param_global  Pointer to parameters of the global bucket.
+*
+*               class_ix        Index of the traffic class.
+*
+*               p_param_class   Pointer to variable that will receive the parameters of the class bucket.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_ShapeInit(),
+*               TFTPs_ShapeTxDlyGet().
+*
+* Note(s)     : (1) The class bucket is disabled when the class has NO bandwidth share (or the whole
+*                   bandwidth), or when the global bucket is disabled (see 'tftp-s_shape.c  Note #3').
+*
+*               (2) The rate & burst size of an enabled class bucket are kept non-zero (see
+*                   'TFTPs_ShapeParamChk()  Note #1').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_ShapeClassParamGet (TFTPs_SHAPE_PARAM  *p_param_global,
+                                        CPU_INT08U          class_ix,
+                                        TFTPs_SHAPE_PARAM  *p_param_class)
+{
+    CPU_INT08U  share_pct;
+
+
+    share_pct = TFTPs_ClassBwShareGet(class_ix);
+
+    if ((share_pct              == 0u)   ||                     /* See Note #1.                                         */
+        (share_pct              >= 100u) ||
+        (p_param_global->Rate   == TFTPs_SHAPE_RATE_UNLIMITED)) {
+        p_param_class->Rate  = TFTPs_SHAPE_RATE_UNLIMITED;
+        p_param_class->Burst = p_param_global->Burst;
+        return;
+    }
+                                                                /* See Note #2.                                         */
+    p_param_class->Rate  = (CPU_INT32U)(((CPU_INT64U)p_param_global->Rate  * share_pct) / 100u);
+    p_param_class->Burst = (CPU_INT32U)(((CPU_INT64U)p_param_global->Burst * share_pct) / 100u);
+    p_param_class->Rate  =  DEF_MAX(p_param_class->Rate,  1u);
+    p_param_class->Burst =  DEF_MAX(p_param_class->Burst, 1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_ShapeClientRemove()
+*
+* Description : Remove a client token bucket from the hash table.
+*
+* Argument(s) : p_client    Pointer to client bucket entry to remove.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_ShapeClientRelease().
+*
+* Note(s)     : (1) See 'tftp-s_sess.c  TFTPs_SessHashRemove()  Note #1'.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_ShapeClientRemove (TFTPs_SHAPE_CLIENT  *p_client)
+{
+    TFTPs_SHAPE_CLIENT  *p_entry;
+    CPU_INT32U           hole;
+    CPU_INT32U           ix;
+    CPU_INT32U           home;
+
+
+    hole = p_client->Hash & TFTPs_ShapeClientHashMask;
+    while (TFTPs_ShapeClientHashTbl[hole] != p_client) {
+        if (TFTPs_ShapeClientHashTbl[hole] == DEF_NULL) {       /* Entry not indexed.                                   */
+            return;
+        }
+        hole = (hole + 1u) & TFTPs_ShapeClientHashMask;
+    }
+
+    ix = (hole + 1u) & TFTPs_ShapeClientHashMask;               /* See Note #1.                                         */
+    p_entry = TFTPs_ShapeClientHashTbl[ix];
+    while (p_entry != DEF_NULL) {
+        home = p_entry->Hash & TFTPs_ShapeClientHashMask;
+        if (((ix - home) & TFTPs_ShapeClientHashMask) >= ((ix - hole) & TFTPs_ShapeClientHashMask)) {
+            TFTPs_ShapeClientHashTbl[hole] = p_entry;
+            hole                           = ix;
+        }
+        ix      = (ix + 1u) & TFTPs_ShapeClientHashMask;
+        p_entry =  TFTPs_ShapeClientHashTbl[ix];
+    }
+
+    TFTPs_ShapeClientHashTbl[hole] = DEF_NULL;
+}
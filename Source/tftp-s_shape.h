@@ -0,0 +1,115 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER EGRESS SHAPING
+*
+* Filename : tftp-s_shape.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs shaping present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_SHAPE_MODULE_PRESENT                             /* See Note #1.                                         */
+#define  TFTPs_SHAPE_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       TOKEN BUCKET DATA TYPE
+*
+* Note(s) : (1) Tokens are counted in octets.  A packet larger than the burst size is sent once the bucket
+*               is full, leaving the bucket in deficit (i.e. 'Tokens' negative) until it is refilled.
+*
+*           (2) The rate & burst size of a bucket are NOT part of the bucket : every client bucket uses
+*               the client rate & burst size in effect, so that a change applies to sessions in progress.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_shape_bucket {
+    CPU_INT32S  Tokens;                                         /* Nbr of octets that may be sent (see Note #1).        */
+    CPU_INT32U  TS_Last;                                        /* Time stamp (ms) of last refill.                      */
+} TFTPs_SHAPE_BUCKET;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void                 TFTPs_ShapeInit         (const  TFTPs_CFG           *p_cfg,
+                                                     TFTPs_ERR           *p_err);
+
+TFTPs_SHAPE_BUCKET  *TFTPs_ShapeClientGet    (       CPU_INT16U           family,
+                                              const  CPU_INT32U          *p_addr,
+                                                     CPU_INT32U           hash);
+
+void                 TFTPs_ShapeClientRelease(       TFTPs_SHAPE_BUCKET  *p_bucket);
+
+CPU_INT32U           TFTPs_ShapeTxDlyGet     (       TFTPs_SHAPE_BUCKET  *p_bucket,
+                                                     CPU_INT08U           class_ix,
+                                                     CPU_INT08U           listen_ix,
+                                                     CPU_INT32U           len);
+
+void                 TFTPs_ShapeTxDone       (       TFTPs_SHAPE_BUCKET  *p_bucket,
+                                                     CPU_INT08U           class_ix,
+                                                     CPU_INT08U           listen_ix,
+                                                     CPU_INT32U           len);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_SHAPE_MODULE_PRESENT  */
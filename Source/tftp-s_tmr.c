@@ -0,0 +1,722 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                       TFTP SERVER TIMER WHEEL
+*
+* Filename : tftp-s_tmr.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) This module implements a hierarchical timing wheel, as described by Varghese & Lauck in
+*                "Hashed and Hierarchical Timing Wheels" :
+*
+*                (a) Starting & stopping a timer are O(1).
+*
+*                (b) Expiring timers is O(1) per timer, plus one cascade of a higher level slot every
+*                    TFTPs_TMR_WHEEL_SLOT_NBR ticks of the level below it.
+*
+*                (c) The time to the next expiry is found from per-level slot occupancy bitmaps, so that
+*                    the server task can sleep exactly until the next timer needs to be serviced.
+*
+*            (2) This module is NOT re-entrant & MUST only be called from the TFTP server task context.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_TMR_MODULE
+#include  "tftp-s_tmr.h"
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+#include  "tftp-s_sim.h"
+#endif
+#include  <Source/net_util.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_TMR_SLOT_IX_NONE                       0xFFFFu   /* Tmr is NOT in any list.                              */
+#define  TFTPs_TMR_SLOT_IX_WORK                       0xFFFEu   /* Tmr is in the work list being expired or cascaded.   */
+
+#define  TFTPs_TMR_WHEEL_SLOT_MASK             (TFTPs_TMR_WHEEL_SLOT_NBR - 1u)
+
+                                                                /* Max nbr of ticks the wheel can hold.                 */
+#define  TFTPs_TMR_WHEEL_TICK_MAX            ((1uL << (TFTPs_TMR_WHEEL_SLOT_NBR_BITS * TFTPs_TMR_WHEEL_LVL_NBR)) - 1u)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_TMR_LINK  TFTPs_TmrWheel[TFTPs_TMR_WHEEL_LVL_NBR][TFTPs_TMR_WHEEL_SLOT_NBR];
+static  CPU_INT64U      TFTPs_TmrWheelMap[TFTPs_TMR_WHEEL_LVL_NBR];     /* Slot occupancy bitmap, per level.            */
+
+static  CPU_INT32U      TFTPs_TmrTickNext;                      /* Next wheel tick to process.                          */
+static  CPU_INT32U      TFTPs_TmrTS_Last;                       /* Time stamp (ms) of last wheel update.                */
+static  CPU_INT32U      TFTPs_TmrTS_Rem;                        /* Time (ms) elapsed since last processed tick.         */
+static  CPU_INT32U      TFTPs_TmrNbrActive;                     /* Nbr of armed tmrs.                                   */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  void        TFTPs_TmrInsert     (TFTPs_TMR       *p_tmr);
+
+static  void        TFTPs_TmrUnlink     (TFTPs_TMR       *p_tmr);
+
+static  void        TFTPs_TmrSlotDetach (CPU_INT08U       lvl,
+                                         CPU_INT08U       slot,
+                                         TFTPs_TMR_LINK  *p_work);
+
+static  void        TFTPs_TmrTickRun    (void);
+
+static  CPU_INT32U  TFTPs_TmrTickSkipGet(void);
+
+static  CPU_INT08U  TFTPs_TmrMapNext    (CPU_INT64U       map,
+                                         CPU_INT08U       pos);
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_TmrInit()
+*
+* Description : Initialize the timer wheel.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TmrInit (void)
+{
+    TFTPs_TMR_LINK  *p_slot;
+    CPU_INT08U       lvl;
+    CPU_INT08U       slot;
+
+
+    for (lvl = 0u; lvl < TFTPs_TMR_WHEEL_LVL_NBR; lvl++) {
+        for (slot = 0u; slot < TFTPs_TMR_WHEEL_SLOT_NBR; slot++) {
+            p_slot          = &TFTPs_TmrWheel[lvl][slot];
+            p_slot->PrevPtr =  p_slot;
+            p_slot->NextPtr =  p_slot;
+        }
+        TFTPs_TmrWheelMap[lvl] = 0u;
+    }
+
+    TFTPs_TmrTickNext  = 0u;
+    TFTPs_TmrTS_Last   = TFTPs_TmrNowGet();
+    TFTPs_TmrTS_Rem    = 0u;
+    TFTPs_TmrNbrActive = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_TmrCfg()
+*
+* Description : Configure a timer object.
+*
+* Argument(s) : p_tmr       Pointer to timer to configure.
+*
+*               fnct        Function to call when the timer expires.
+*
+*               p_arg       Argument passed to 'fnct'.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : (1) The timer MUST NOT be active.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TmrCfg (TFTPs_TMR       *p_tmr,
+                    TFTPs_TMR_FNCT   fnct,
+                    void            *p_arg)
+{
+    p_tmr->Link.PrevPtr = DEF_NULL;
+    p_tmr->Link.NextPtr = DEF_NULL;
+    p_tmr->Fnct         = fnct;
+    p_tmr->FnctArgPtr   = p_arg;
+    p_tmr->ExpiryTick   = 0u;
+    p_tmr->SlotIx       = TFTPs_TMR_SLOT_IX_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_TmrStart()
+*
+* Description : (Re)start a timer.
+*
+* Argument(s) : p_tmr       Pointer to timer to start.
+*
+*               timeout_ms  Time (in milliseconds) before the timer expires.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : (1) If the timer is already active, it is first stopped.
+*
+*               (2) A timer always expires at least one tick after it is started, even from within an
+*                   expiry callback.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TmrStart (TFTPs_TMR   *p_tmr,
+                      CPU_INT32U   timeout_ms)
+{
+    CPU_INT32U  ticks;
+
+
+    if (p_tmr->SlotIx != TFTPs_TMR_SLOT_IX_NONE) {              /* See Note #1.                                         */
+        TFTPs_TmrUnlink(p_tmr);
+    }
+
+    ticks = (timeout_ms + TFTPs_CFG_TMR_TICK_MS - 1u) / TFTPs_CFG_TMR_TICK_MS;
+    if (ticks < 1u) {                                           /* See Note #2.                                         */
+        ticks = 1u;
+    }
+    if (ticks > TFTPs_TMR_WHEEL_TICK_MAX) {
+        ticks = TFTPs_TMR_WHEEL_TICK_MAX;
+    }
+
+    p_tmr->ExpiryTick = TFTPs_TmrTickNext + ticks - 1u;
+    TFTPs_TmrInsert(p_tmr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_TmrStop()
+*
+* Description : Stop a timer.
+*
+* Argument(s) : p_tmr       Pointer to timer to stop.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : (1) Stopping an inactive timer has no effect.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TmrStop (TFTPs_TMR  *p_tmr)
+{
+    if (p_tmr->SlotIx == TFTPs_TMR_SLOT_IX_NONE) {              /* See Note #1.                                         */
+        return;
+    }
+
+    TFTPs_TmrUnlink(p_tmr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TmrIsActive()
+*
+* Description : Check whether a timer is armed.
+*
+* Argument(s) : p_tmr       Pointer to timer.
+*
+* Return(s)   : DEF_YES, if the timer is armed.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_TmrIsActive (TFTPs_TMR  *p_tmr)
+{
+    return ((p_tmr->SlotIx != TFTPs_TMR_SLOT_IX_NONE) ? DEF_YES : DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TmrProcess()
+*
+* Description : Advance the timer wheel up to the current time & call the expiry function of every timer
+*               that expired.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) Ticks that have neither expiring timers nor pending cascades are skipped in one step.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TmrProcess (void)
+{
+    CPU_INT32U  ts_now;
+    CPU_INT32U  ts_elapsed;
+    CPU_INT32U  ticks;
+    CPU_INT32U  skip;
+
+
+    ts_now           = TFTPs_TmrNowGet();
+    ts_elapsed       = (ts_now - TFTPs_TmrTS_Last) + TFTPs_TmrTS_Rem;
+    TFTPs_TmrTS_Last =  ts_now;
+
+    ticks            = ts_elapsed / TFTPs_CFG_TMR_TICK_MS;
+    TFTPs_TmrTS_Rem  = ts_elapsed % TFTPs_CFG_TMR_TICK_MS;
+
+    while (ticks > 0u) {
+        if (TFTPs_TmrNbrActive == 0u) {
+            TFTPs_TmrTickNext += ticks;
+            break;
+        }
+
+        skip = TFTPs_TmrTickSkipGet();                          /* See Note #1.                                         */
+        if (skip >= ticks) {
+            TFTPs_TmrTickNext += ticks;
+            break;
+        }
+
+        TFTPs_TmrTickNext += skip;
+        ticks             -= skip;
+
+        TFTPs_TmrTickRun();
+        ticks--;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TmrNextGet()
+*
+* Description : Get the time until the timer wheel needs to be processed again.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Time (in milliseconds) until the next expiry or cascade, if any timer is armed.
+*
+*               TFTPs_TMR_TIME_INFINITE,                                otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : (1) The returned time is never null, so that it can be used directly as a socket timeout.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_TmrNextGet (void)
+{
+    CPU_INT32U  ticks;
+    CPU_INT32U  time_ms;
+
+
+    if (TFTPs_TmrNbrActive == 0u) {
+        return (TFTPs_TMR_TIME_INFINITE);
+    }
+
+    ticks   = TFTPs_TmrTickSkipGet() + 1u;
+    time_ms = ticks * TFTPs_CFG_TMR_TICK_MS;
+    if (time_ms > TFTPs_TmrTS_Rem) {
+        time_ms -= TFTPs_TmrTS_Rem;
+    } else {
+        time_ms  = 1u;                                          /* See Note #1.                                         */
+    }
+
+    return (time_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_TmrNowGet()
+*
+* Description : Get the current time of the TFTP server.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Current time stamp, in milliseconds.
+*
+* Caller(s)   : various.
+*
+* Note(s)     : (1) When the network is simulated, the time of the server is the virtual clock of the
+*                   simulation (see 'tftp-s_sim.c  Note #1b').
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_TmrNowGet (void)
+{
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+    return (TFTPs_SimNowGet());                                 /* See Note #1.                                         */
+#else
+    return ((CPU_INT32U)NetUtil_TS_Get_ms());
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_TmrInsert()
+*
+* Description : Insert a timer in the wheel slot matching its expiry tick.
+*
+* Argument(s) : p_tmr       Pointer to timer to insert.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrStart(),
+*               TFTPs_TmrTickRun().
+*
+* Note(s)     : (1) The level is selected from the distance to the expiry tick, while the slot within the
+*                   level is selected from the absolute expiry tick.  A timer in level 'n' is cascaded to
+*                   a lower level when the lower bits of the current tick wrap to its slot.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrInsert (TFTPs_TMR  *p_tmr)
+{
+    TFTPs_TMR_LINK  *p_slot;
+    CPU_INT32U       delta;
+    CPU_INT08U       lvl;
+    CPU_INT08U       slot;
+    CPU_INT08U       shift;
+
+
+    delta = p_tmr->ExpiryTick - TFTPs_TmrTickNext;
+    if (delta > TFTPs_TMR_WHEEL_TICK_MAX) {                     /* Tmr already due: expire on next tick.                */
+        p_tmr->ExpiryTick = TFTPs_TmrTickNext;
+        delta             = 0u;
+    }
+                                                                /* See Note #1.                                         */
+    lvl = 0u;
+    while ((lvl < (TFTPs_TMR_WHEEL_LVL_NBR - 1u)) &&
+           (delta >= (1uL << (TFTPs_TMR_WHEEL_SLOT_NBR_BITS * (lvl + 1u))))) {
+        lvl++;
+    }
+
+    shift  =  lvl * TFTPs_TMR_WHEEL_SLOT_NBR_BITS;
+    slot   = (CPU_INT08U)((p_tmr->ExpiryTick >> shift) & TFTPs_TMR_WHEEL_SLOT_MASK);
+    p_slot = &TFTPs_TmrWheel[lvl][slot];
+
+    p_tmr->Link.PrevPtr          =  p_slot->PrevPtr;            /* Append to slot list.                                 */
+    p_tmr->Link.NextPtr          =  p_slot;
+    p_slot->PrevPtr->NextPtr     = &p_tmr->Link;
+    p_slot->PrevPtr              = &p_tmr->Link;
+    p_tmr->SlotIx                = (CPU_INT16U)((lvl * TFTPs_TMR_WHEEL_SLOT_NBR) + slot);
+
+    TFTPs_TmrWheelMap[lvl]      |= ((CPU_INT64U)1u << slot);
+    TFTPs_TmrNbrActive++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_TmrUnlink()
+*
+* Description : Remove a timer from the list it is in.
+*
+* Argument(s) : p_tmr       Pointer to timer to remove.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrStart(),
+*               TFTPs_TmrStop(),
+*               TFTPs_TmrTickRun().
+*
+* Note(s)     : (1) The slot occupancy bit is cleared when the last timer of a wheel slot is removed.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrUnlink (TFTPs_TMR  *p_tmr)
+{
+    TFTPs_TMR_LINK  *p_slot;
+    CPU_INT08U       lvl;
+    CPU_INT08U       slot;
+
+
+    p_tmr->Link.PrevPtr->NextPtr = p_tmr->Link.NextPtr;
+    p_tmr->Link.NextPtr->PrevPtr = p_tmr->Link.PrevPtr;
+
+    if (p_tmr->SlotIx != TFTPs_TMR_SLOT_IX_WORK) {              /* See Note #1.                                         */
+        lvl    = (CPU_INT08U)(p_tmr->SlotIx / TFTPs_TMR_WHEEL_SLOT_NBR);
+        slot   = (CPU_INT08U)(p_tmr->SlotIx % TFTPs_TMR_WHEEL_SLOT_NBR);
+        p_slot = &TFTPs_TmrWheel[lvl][slot];
+        if (p_slot->NextPtr == p_slot) {
+            TFTPs_TmrWheelMap[lvl] &= ~((CPU_INT64U)1u << slot);
+        }
+    }
+
+    p_tmr->Link.PrevPtr = DEF_NULL;
+    p_tmr->Link.NextPtr = DEF_NULL;
+    p_tmr->SlotIx       = TFTPs_TMR_SLOT_IX_NONE;
+    TFTPs_TmrNbrActive--;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_TmrSlotDetach()
+*
+* Description : Move every timer of a wheel slot to a work list.
+*
+* Argument(s) : lvl         Wheel level.
+*
+*               slot        Slot within the level.
+*
+*               p_work      Pointer to the (empty) work list sentinel.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrTickRun().
+*
+* Note(s)     : (1) Timers are moved to a work list so that timers (re)started from an expiry callback,
+*                   which could hash into the slot being processed, are kept for the next wheel turn.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrSlotDetach (CPU_INT08U       lvl,
+                                   CPU_INT08U       slot,
+                                   TFTPs_TMR_LINK  *p_work)
+{
+    TFTPs_TMR_LINK  *p_slot;
+    TFTPs_TMR_LINK  *p_link;
+
+
+    p_slot = &TFTPs_TmrWheel[lvl][slot];
+
+    if (p_slot->NextPtr == p_slot) {
+        p_work->PrevPtr = p_work;
+        p_work->NextPtr = p_work;
+        return;
+    }
+
+    p_work->NextPtr          = p_slot->NextPtr;
+    p_work->PrevPtr          = p_slot->PrevPtr;
+    p_work->NextPtr->PrevPtr = p_work;
+    p_work->PrevPtr->NextPtr = p_work;
+
+    p_slot->PrevPtr          = p_slot;
+    p_slot->NextPtr          = p_slot;
+    TFTPs_TmrWheelMap[lvl]  &= ~((CPU_INT64U)1u << slot);
+
+    p_link = p_work->NextPtr;
+    while (p_link != p_work) {
+        ((TFTPs_TMR *)p_link)->SlotIx = TFTPs_TMR_SLOT_IX_WORK;
+        p_link = p_link->NextPtr;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TmrTickRun()
+*
+* Description : Process the next wheel tick.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_TmrProcess().
+*
+* Note(s)     : (1) When the slot index of a level wraps to zero, the current slot of the level above is
+*                   cascaded, i.e. its timers are re-inserted in lower levels.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_TmrTickRun (void)
+{
+    TFTPs_TMR_LINK   work;
+    TFTPs_TMR       *p_tmr;
+    CPU_INT08U       lvl;
+    CPU_INT08U       slot;
+
+
+    slot = (CPU_INT08U)(TFTPs_TmrTickNext & TFTPs_TMR_WHEEL_SLOT_MASK);
+    if (slot == 0u) {                                           /* See Note #1.                                         */
+        for (lvl = 1u; lvl < TFTPs_TMR_WHEEL_LVL_NBR; lvl++) {
+            slot = (CPU_INT08U)((TFTPs_TmrTickNext >> (lvl * TFTPs_TMR_WHEEL_SLOT_NBR_BITS)) & TFTPs_TMR_WHEEL_SLOT_MASK);
+            TFTPs_TmrSlotDetach(lvl, slot, &work);
+            while (work.NextPtr != &work) {
+                p_tmr = (TFTPs_TMR *)work.NextPtr;
+                TFTPs_TmrUnlink(p_tmr);
+                TFTPs_TmrInsert(p_tmr);
+            }
+            if (slot != 0u) {
+                break;
+            }
+        }
+        slot = 0u;
+    }
+
+    TFTPs_TmrSlotDetach(0u, slot, &work);
+    TFTPs_TmrTickNext++;
+                                                                /* Expire every tmr of the slot.                        */
+    while (work.NextPtr != &work) {
+        p_tmr = (TFTPs_TMR *)work.NextPtr;
+        TFTPs_TmrUnlink(p_tmr);
+        p_tmr->Fnct(p_tmr->FnctArgPtr);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_TmrTickSkipGet()
+*
+* Description : Get the number of ticks that can be skipped before a tick needs to be processed.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Number of ticks, starting at the next tick to process, that have no work to do.
+*
+* Caller(s)   : TFTPs_TmrProcess(),
+*               TFTPs_TmrNextGet().
+*
+* Note(s)     : (1) A non-empty slot of level 'n' (n > 0) is cascaded on the first tick whose lower
+*                   'n' slot indexes are all zero & whose level 'n' index matches the slot.  When the
+*                   current tick is not aligned on a level 'n' boundary, the current slot of that level
+*                   was already cascaded & its next cascade is one full level turn away.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_TmrTickSkipGet (void)
+{
+    CPU_INT32U  skip;
+    CPU_INT32U  skip_lvl;
+    CPU_INT32U  base;
+    CPU_INT32U  dist;
+    CPU_INT08U  lvl;
+    CPU_INT08U  shift;
+    CPU_INT08U  cur;
+
+
+    skip = TFTPs_TMR_WHEEL_TICK_MAX;
+
+    if (TFTPs_TmrWheelMap[0] != 0u) {
+        cur  = (CPU_INT08U)(TFTPs_TmrTickNext & TFTPs_TMR_WHEEL_SLOT_MASK);
+        skip =  TFTPs_TmrMapNext(TFTPs_TmrWheelMap[0], cur);
+    }
+
+    for (lvl = 1u; lvl < TFTPs_TMR_WHEEL_LVL_NBR; lvl++) {      /* See Note #1.                                         */
+        if (TFTPs_TmrWheelMap[lvl] == 0u) {
+            continue;
+        }
+
+        shift = lvl * TFTPs_TMR_WHEEL_SLOT_NBR_BITS;
+        base  = TFTPs_TmrTickNext >> shift;
+        cur   = (CPU_INT08U)(base & TFTPs_TMR_WHEEL_SLOT_MASK);
+
+        if ((TFTPs_TmrTickNext & ((1uL << shift) - 1u)) == 0u) {
+            dist = TFTPs_TmrMapNext(TFTPs_TmrWheelMap[lvl], cur);
+        } else {
+            dist = TFTPs_TmrMapNext(TFTPs_TmrWheelMap[lvl], (CPU_INT08U)((cur + 1u) & TFTPs_TMR_WHEEL_SLOT_MASK)) + 1u;
+        }
+
+        skip_lvl = ((base + dist) << shift) - TFTPs_TmrTickNext;
+        if (skip_lvl < skip) {
+            skip = skip_lvl;
+        }
+    }
+
+    return (skip);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TmrMapNext()
+*
+* Description : Find the next set bit of a slot occupancy bitmap, circularly from a given position.
+*
+* Argument(s) : map         Slot occupancy bitmap.
+*
+*               pos         Position from which to start the search.
+*
+* Return(s)   : Distance from 'pos' to the next set bit, if any.
+*
+*               TFTPs_TMR_WHEEL_SLOT_NBR,                   otherwise.
+*
+* Caller(s)   : TFTPs_TmrTickSkipGet().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  TFTPs_TmrMapNext (CPU_INT64U  map,
+                                      CPU_INT08U  pos)
+{
+    CPU_INT64U  rot;
+    CPU_INT32U  word;
+
+
+    if (map == 0u) {
+        return (TFTPs_TMR_WHEEL_SLOT_NBR);
+    }
+
+    if (pos == 0u) {
+        rot = map;
+    } else {
+        rot = (map >> pos) | (map << (TFTPs_TMR_WHEEL_SLOT_NBR - pos));
+    }
+
+    word = (CPU_INT32U)rot;
+    if (word != 0u) {
+        return ((CPU_INT08U)CPU_CntTrailZeros32(word));
+    }
+
+    word = (CPU_INT32U)(rot >> 32u);
+    return ((CPU_INT08U)(32u + CPU_CntTrailZeros32(word)));
+}
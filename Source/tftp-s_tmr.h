@@ -0,0 +1,162 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                       TFTP SERVER TIMER WHEEL
+*
+* Filename : tftp-s_tmr.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs timer present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_TMR_MODULE_PRESENT                               /* See Note #1.                                         */
+#define  TFTPs_TMR_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*
+* Note(s) : (1) The timer wheel is made of TFTPs_TMR_WHEEL_LVL_NBR levels of TFTPs_TMR_WHEEL_SLOT_NBR slots.
+*               Each level covers TFTPs_TMR_WHEEL_SLOT_NBR times the span of the level below it, so that
+*               the wheel can hold timeouts of up to 2^24 ticks (i.e. ~46 hours with a 10 ms tick).
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_TMR_TIME_INFINITE                DEF_INT_32U_MAX_VAL
+
+#define  TFTPs_TMR_WHEEL_LVL_NBR                           4u   /* See Note #1.                                         */
+#define  TFTPs_TMR_WHEEL_SLOT_NBR_BITS                     6u
+#define  TFTPs_TMR_WHEEL_SLOT_NBR              (1u << TFTPs_TMR_WHEEL_SLOT_NBR_BITS)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                     TIMER CALLBACK FUNCTION DATA TYPE
+*********************************************************************************************************
+*/
+
+typedef  void  (*TFTPs_TMR_FNCT)(void  *p_arg);
+
+
+/*
+*********************************************************************************************************
+*                                          TIMER LINK DATA TYPE
+*
+* Note(s) : (1) Timers are kept in circular doubly-linked lists anchored on a sentinel link, so that a
+*               timer can be removed from any list in constant time without knowing the list head.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_tmr_link  TFTPs_TMR_LINK;
+
+struct  tftps_tmr_link {
+    TFTPs_TMR_LINK  *PrevPtr;                                   /* Ptr to prev link in list.                            */
+    TFTPs_TMR_LINK  *NextPtr;                                   /* Ptr to next link in list.                            */
+};
+
+
+/*
+*********************************************************************************************************
+*                                            TIMER DATA TYPE
+*
+* Note(s) : (1) Timer objects are owned by the caller (typically embedded in a session object) & MUST be
+*               configured with TFTPs_TmrCfg() before they are started.
+*
+*           (2) 'Link' MUST be the first member of the structure.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_tmr {
+    TFTPs_TMR_LINK   Link;                                      /* Wheel slot link (see Note #2).                       */
+    TFTPs_TMR_FNCT   Fnct;                                      /* Fnct called on expiry.                               */
+    void            *FnctArgPtr;                                /* Arg  passed to expiry fnct.                          */
+    CPU_INT32U       ExpiryTick;                                /* Wheel tick at which the tmr expires.                 */
+    CPU_INT16U       SlotIx;                                    /* Wheel slot holding the tmr, if any.                  */
+} TFTPs_TMR;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void         TFTPs_TmrInit    (void);
+
+void         TFTPs_TmrCfg     (TFTPs_TMR       *p_tmr,
+                               TFTPs_TMR_FNCT   fnct,
+                               void            *p_arg);
+
+void         TFTPs_TmrStart   (TFTPs_TMR       *p_tmr,
+                               CPU_INT32U       timeout_ms);
+
+void         TFTPs_TmrStop    (TFTPs_TMR       *p_tmr);
+
+CPU_BOOLEAN  TFTPs_TmrIsActive(TFTPs_TMR       *p_tmr);
+
+void         TFTPs_TmrProcess (void);
+
+CPU_INT32U   TFTPs_TmrNextGet (void);
+
+CPU_INT32U   TFTPs_TmrNowGet  (void);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_TMR_MODULE_PRESENT  */
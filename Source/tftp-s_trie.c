@@ -0,0 +1,473 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER ADDRESS PREFIX TRIE
+*
+* Filename : tftp-s_trie.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Address prefixes are kept in a path-compressed binary trie (i.e. a PATRICIA trie) : a node
+*                is only inserted where prefixes diverge, so that a trie of N prefixes holds at most 2 * N
+*                nodes, & an address is looked up in at most one step per node on its path, whatever the
+*                number of prefixes.
+*
+*            (2) A lookup returns the value of the longest prefix of the trie that holds the address.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_TRIE_MODULE
+#include  "tftp-s_trie.h"
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if ((TFTPs_CFG_REWRITE_EN == DEF_ENABLED) || \
+     (TFTPs_CFG_ACL_EN     == DEF_ENABLED))
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_TRIE_NODE  *TFTPs_TrieNodeGet  (       TFTPs_TRIE_POOL  *p_pool,
+                                              const  CPU_INT08U       *p_addr,
+                                                     CPU_INT08U        prefix_len,
+                                                     CPU_INT32U        val);
+
+static  CPU_INT08U        TFTPs_TrieBitGet   (const  CPU_INT08U       *p_addr,
+                                                     CPU_INT08U        bit_ix);
+
+static  CPU_INT08U        TFTPs_TrieCommonLen(const  CPU_INT08U       *p_addr_a,
+                                              const  CPU_INT08U       *p_addr_b,
+                                                     CPU_INT08U        len_start,
+                                                     CPU_INT08U        len_max);
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_TriePoolAlloc()
+*
+* Description : Allocate the nodes of a trie node pool.
+*
+* Argument(s) : p_pool      Pointer to node pool.
+*
+*               p_name      Name of the memory segment.
+*
+*               node_nbr    Number of nodes.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_MEM_ALLOC
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_RewriteInit(),
+*               TFTPs_ACL_Init().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TriePoolAlloc (TFTPs_TRIE_POOL  *p_pool,
+                           CPU_CHAR         *p_name,
+                           CPU_INT32U        node_nbr,
+                           TFTPs_ERR        *p_err)
+{
+    LIB_ERR  err_lib;
+
+
+    p_pool->NodeTbl     = DEF_NULL;
+    p_pool->NodeNbrMax  = 0u;
+    p_pool->NodeNbrUsed = 0u;
+
+    if (node_nbr > 0u) {
+        p_pool->NodeTbl = (TFTPs_TRIE_NODE *)Mem_SegAlloc(p_name,
+                                                          DEF_NULL,
+                                                          (CPU_SIZE_T)node_nbr * sizeof(TFTPs_TRIE_NODE),
+                                                         &err_lib);
+        if (err_lib != LIB_MEM_ERR_NONE) {
+           *p_err = TFTPs_ERR_MEM_ALLOC;
+            return;
+        }
+        p_pool->NodeNbrMax = node_nbr;
+    }
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TriePoolClr()
+*
+* Description : Return all the nodes of a trie node pool.
+*
+* Argument(s) : p_pool      Pointer to node pool.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_RewriteCompile().
+*
+* Note(s)     : (1) The tries built from the pool MUST NOT be used anymore.
+*********************************************************************************************************
+*/
+
+void  TFTPs_TriePoolClr (TFTPs_TRIE_POOL  *p_pool)
+{
+    p_pool->NodeNbrUsed = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TrieInsert()
+*
+* Description : Insert an address prefix in a trie.
+*
+* Argument(s) : p_pool      Pointer to node pool of the trie.
+*
+*               p_root      Pointer to the root node pointer of the trie, NULL for an empty trie.
+*
+*               p_addr      Pointer to prefix, in network order.
+*
+*               prefix_len  Length of the prefix, in bits.
+*
+*               val         Value of the prefix.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if NO node is available.
+*
+* Caller(s)   : TFTPs_RewriteCompile(),
+*               TFTPs_ACL_Init().
+*
+* Note(s)     : (1) A prefix already in the trie keeps its first value, so that the first of several equal
+*                   prefixes wins.
+*
+*               (2) A node whose prefix is NOT a prefix of the new one is split at the last common bit :
+*                   either the new prefix becomes the parent of the node, or a node without value is
+*                   inserted to join both (see 'tftp-s_trie.c  Note #1').
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_TrieInsert (       TFTPs_TRIE_POOL   *p_pool,
+                                      TFTPs_TRIE_NODE  **p_root,
+                               const  CPU_INT08U        *p_addr,
+                                      CPU_INT08U         prefix_len,
+                                      CPU_INT32U         val)
+{
+    TFTPs_TRIE_NODE  **p_link;
+    TFTPs_TRIE_NODE   *p_node;
+    TFTPs_TRIE_NODE   *p_node_new;
+    TFTPs_TRIE_NODE   *p_node_join;
+    CPU_INT08U         len_common;
+    CPU_INT08U         len_matched;
+
+
+    if (p_pool->NodeNbrUsed + 2u > p_pool->NodeNbrMax) {        /* Insertion takes at most 2 nodes.                     */
+        return (DEF_FAIL);
+    }
+
+    p_link      = p_root;
+    len_common  = 0u;
+    len_matched = 0u;
+    while (*p_link != DEF_NULL) {
+        p_node     = *p_link;
+        len_common =  TFTPs_TrieCommonLen(p_node->Addr,
+                                          p_addr,
+                                          len_matched,
+                                          DEF_MIN(p_node->PrefixLen, prefix_len));
+        if (len_common < p_node->PrefixLen) {                   /* Node must be split (see Note #2).                    */
+            break;
+        }
+
+        if (p_node->PrefixLen == prefix_len) {                  /* Prefix already in trie (see Note #1).                */
+            if (p_node->Val == TFTPs_TRIE_VAL_NONE) {
+                p_node->Val = val;
+            }
+            return (DEF_OK);
+        }
+
+        len_matched = p_node->PrefixLen;
+        p_link      = &p_node->ChildTbl[TFTPs_TrieBitGet(p_addr, len_matched)];
+    }
+
+    p_node_new = TFTPs_TrieNodeGet(p_pool, p_addr, prefix_len, val);
+    p_node     = *p_link;
+    if (p_node == DEF_NULL) {                                   /* Add leaf.                                            */
+       *p_link = p_node_new;
+        return (DEF_OK);
+    }
+
+    if (len_common == prefix_len) {                             /* New prefix is the parent of the node.                */
+        p_node_new->ChildTbl[TFTPs_TrieBitGet(p_node->Addr, len_common)] = p_node;
+       *p_link = p_node_new;
+        return (DEF_OK);
+    }
+                                                                /* Join node & new prefix.                              */
+    p_node_join = TFTPs_TrieNodeGet(p_pool, p_addr, len_common, TFTPs_TRIE_VAL_NONE);
+    p_node_join->ChildTbl[TFTPs_TrieBitGet(p_node->Addr, len_common)] = p_node;
+    p_node_join->ChildTbl[TFTPs_TrieBitGet(p_addr,       len_common)] = p_node_new;
+   *p_link = p_node_join;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TrieLookup()
+*
+* Description : Find the longest prefix of a trie holding an address.
+*
+* Argument(s) : p_root      Pointer to the root node of the trie, NULL for an empty trie.
+*
+*               p_addr      Pointer to address, in network order.
+*
+*               addr_len    Length of the address, in bits :
+*
+*                               TFTPs_TRIE_ADDR_LEN_IPv4
+*                               TFTPs_TRIE_ADDR_LEN_IPv6
+*
+* Return(s)   : Value of the longest prefix holding the address, if any.
+*
+*               TFTPs_TRIE_VAL_NONE,                             otherwise.
+*
+* Caller(s)   : TFTPs_RewriteRuleGet(),
+*               TFTPs_ACL_PermGet().
+*
+* Note(s)     : (1) See 'tftp-s_trie.c  Note #2'.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_TrieLookup (const  TFTPs_TRIE_NODE  *p_root,
+                              const  CPU_INT08U       *p_addr,
+                                     CPU_INT08U        addr_len)
+{
+    const  TFTPs_TRIE_NODE  *p_node;
+           CPU_INT32U        val;
+           CPU_INT08U        len_matched;
+
+
+    val         = TFTPs_TRIE_VAL_NONE;
+    len_matched = 0u;
+    p_node      = p_root;
+    while (p_node != DEF_NULL) {
+        if (p_node->PrefixLen > addr_len) {
+            break;
+        }
+
+        len_matched = TFTPs_TrieCommonLen(p_node->Addr, p_addr, len_matched, p_node->PrefixLen);
+        if (len_matched < p_node->PrefixLen) {
+            break;
+        }
+
+        if (p_node->Val != TFTPs_TRIE_VAL_NONE) {               /* Keep longest prefix (see Note #1).                   */
+            val = p_node->Val;
+        }
+
+        if (len_matched == addr_len) {
+            break;
+        }
+
+        p_node = p_node->ChildTbl[TFTPs_TrieBitGet(p_addr, len_matched)];
+    }
+
+    return (val);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TrieNodeGet()
+*
+* Description : Take a node from a node pool & set its prefix.
+*
+* Argument(s) : p_pool      Pointer to node pool.
+*
+*               p_addr      Pointer to prefix, in network order.
+*
+*               prefix_len  Length of the prefix, in bits.
+*
+*               val         Value of the prefix.
+*
+* Return(s)   : Pointer to node.
+*
+* Caller(s)   : TFTPs_TrieInsert().
+*
+* Note(s)     : (1) The caller checks that the pool holds enough nodes.
+*
+*               (2) The bits beyond the prefix are cleared (see 'tftp-s_trie.h  TRIE NODE DATA TYPE
+*                   Note #1').
+*********************************************************************************************************
+*/
+
+static  TFTPs_TRIE_NODE  *TFTPs_TrieNodeGet (       TFTPs_TRIE_POOL  *p_pool,
+                                             const  CPU_INT08U       *p_addr,
+                                                    CPU_INT08U        prefix_len,
+                                                    CPU_INT32U        val)
+{
+    TFTPs_TRIE_NODE  *p_node;
+    CPU_INT08U        len_octets;
+    CPU_INT08U        bits_rem;
+
+
+    p_node = &p_pool->NodeTbl[p_pool->NodeNbrUsed];             /* See Note #1.                                         */
+    p_pool->NodeNbrUsed++;
+
+    Mem_Clr(p_node, sizeof(TFTPs_TRIE_NODE));
+    len_octets = prefix_len / DEF_OCTET_NBR_BITS;               /* Copy prefix (see Note #2).                           */
+    bits_rem   = prefix_len % DEF_OCTET_NBR_BITS;
+    Mem_Copy(p_node->Addr, p_addr, len_octets);
+    if (bits_rem > 0u) {
+        p_node->Addr[len_octets] = p_addr[len_octets] & (CPU_INT08U)(DEF_OCTET_MASK << (DEF_OCTET_NBR_BITS - bits_rem));
+    }
+
+    p_node->PrefixLen = prefix_len;
+    p_node->Val       = val;
+
+    return (p_node);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_TrieBitGet()
+*
+* Description : Get a bit of an address.
+*
+* Argument(s) : p_addr      Pointer to address, in network order.
+*
+*               bit_ix      Index of the bit, from the most significant bit of the address.
+*
+* Return(s)   : Value of the bit, 0 or 1.
+*
+* Caller(s)   : TFTPs_TrieInsert(),
+*               TFTPs_TrieLookup(),
+*               TFTPs_TrieCommonLen().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  TFTPs_TrieBitGet (const  CPU_INT08U  *p_addr,
+                                             CPU_INT08U   bit_ix)
+{
+    CPU_INT08U  octet;
+
+
+    octet = p_addr[bit_ix / DEF_OCTET_NBR_BITS];
+
+    return ((CPU_INT08U)((octet >> (DEF_OCTET_NBR_BITS - 1u - (bit_ix % DEF_OCTET_NBR_BITS))) & 1u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_TrieCommonLen()
+*
+* Description : Get the length of the common prefix of two addresses.
+*
+* Argument(s) : p_addr_a    Pointer to first  address, in network order.
+*
+*               p_addr_b    Pointer to second address, in network order.
+*
+*               len_start   Length of the prefix already known to be common, in bits.
+*
+*               len_max     Length at which to stop comparing, in bits.
+*
+* Return(s)   : Length of the common prefix, in bits, at most 'len_max'.
+*
+* Caller(s)   : TFTPs_TrieInsert(),
+*               TFTPs_TrieLookup().
+*
+* Note(s)     : (1) Whole octets are compared at once once the comparison is aligned on an octet.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  TFTPs_TrieCommonLen (const  CPU_INT08U  *p_addr_a,
+                                         const  CPU_INT08U  *p_addr_b,
+                                                CPU_INT08U   len_start,
+                                                CPU_INT08U   len_max)
+{
+    CPU_INT16U  len;
+
+
+    len = len_start;
+    while ((len                      <  len_max) &&
+           (len % DEF_OCTET_NBR_BITS != 0u)      &&
+           (TFTPs_TrieBitGet(p_addr_a, (CPU_INT08U)len) == TFTPs_TrieBitGet(p_addr_b, (CPU_INT08U)len))) {
+        len++;
+    }
+    if ((len % DEF_OCTET_NBR_BITS) != 0u) {                     /* Bits differ before octet boundary.                   */
+        return ((CPU_INT08U)DEF_MIN(len, len_max));
+    }
+                                                                /* Compare whole octets (see Note #1).                  */
+    while ((len + DEF_OCTET_NBR_BITS <= len_max) &&
+           (p_addr_a[len / DEF_OCTET_NBR_BITS] == p_addr_b[len / DEF_OCTET_NBR_BITS])) {
+        len += DEF_OCTET_NBR_BITS;
+    }
+
+    while ((len < len_max) &&
+           (TFTPs_TrieBitGet(p_addr_a, (CPU_INT08U)len) == TFTPs_TrieBitGet(p_addr_b, (CPU_INT08U)len))) {
+        len++;
+    }
+
+    return ((CPU_INT08U)len);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of trie module include.                          */
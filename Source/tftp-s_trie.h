@@ -0,0 +1,149 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP SERVER ADDRESS PREFIX TRIE
+*
+* Filename : tftp-s_trie.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs trie present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_TRIE_MODULE_PRESENT                              /* See Note #1.                                         */
+#define  TFTPs_TRIE_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_TRIE_ADDR_SIZE                             16u   /* Size of the largest addr (IPv6).                     */
+
+#define  TFTPs_TRIE_ADDR_LEN_IPv4                         32u   /* Len (bits) of an IPv4 addr.                          */
+#define  TFTPs_TRIE_ADDR_LEN_IPv6                        128u   /* Len (bits) of an IPv6 addr.                          */
+
+#define  TFTPs_TRIE_VAL_NONE             DEF_INT_32U_MAX_VAL
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         TRIE NODE DATA TYPE
+*
+* Note(s) : (1) A node holds a prefix of 'PrefixLen' bits, in network order, with the bits beyond the
+*               prefix cleared.  The children of a node hold longer prefixes, selected by their first bit
+*               beyond the prefix of the node (see 'tftp-s_trie.c  Note #1').
+*
+*           (2) Nodes inserted only to join two children hold NO value (i.e. TFTPs_TRIE_VAL_NONE).
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_trie_node  TFTPs_TRIE_NODE;
+
+struct  tftps_trie_node {
+    CPU_INT08U        Addr[TFTPs_TRIE_ADDR_SIZE];               /* Prefix                         (see Note #1).        */
+    CPU_INT08U        PrefixLen;                                /* Prefix len (bits)              (see Note #1).        */
+    CPU_INT32U        Val;                                      /* Val of prefix                  (see Note #2).        */
+    TFTPs_TRIE_NODE  *ChildTbl[2];                              /* Children, by next bit          (see Note #1).        */
+};
+
+
+/*
+*********************************************************************************************************
+*                                       TRIE NODE POOL DATA TYPE
+*
+* Note(s) : (1) Nodes are taken in order from the pool & only returned all at once, when the tries built
+*               from the pool are rebuilt.  Inserting a prefix takes at most 2 nodes.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_trie_pool {
+    TFTPs_TRIE_NODE  *NodeTbl;                                  /* Nodes.                                               */
+    CPU_INT32U        NodeNbrMax;                               /* Nbr of nodes.                                        */
+    CPU_INT32U        NodeNbrUsed;                              /* Nbr of nodes in use            (see Note #1).        */
+} TFTPs_TRIE_POOL;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void         TFTPs_TriePoolAlloc(       TFTPs_TRIE_POOL   *p_pool,
+                                        CPU_CHAR          *p_name,
+                                        CPU_INT32U         node_nbr,
+                                        TFTPs_ERR         *p_err);
+
+void         TFTPs_TriePoolClr  (       TFTPs_TRIE_POOL   *p_pool);
+
+CPU_BOOLEAN  TFTPs_TrieInsert   (       TFTPs_TRIE_POOL   *p_pool,
+                                        TFTPs_TRIE_NODE  **p_root,
+                                 const  CPU_INT08U        *p_addr,
+                                        CPU_INT08U         prefix_len,
+                                        CPU_INT32U         val);
+
+CPU_INT32U   TFTPs_TrieLookup   (const  TFTPs_TRIE_NODE   *p_root,
+                                 const  CPU_INT08U        *p_addr,
+                                        CPU_INT08U         addr_len);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_TRIE_MODULE_PRESENT  */
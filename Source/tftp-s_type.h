@@ -48,6 +48,7 @@
 */
 
 #include  <cpu.h>
+#include  <Source/net_sock.h>
 
 
 /*
@@ -71,6 +72,555 @@ typedef enum tftps_sock_sel {
 } TFTPs_SOCK_SEL;
 
 
+/*
+*********************************************************************************************************
+*                                  TRANSMIT SCHEDULER POLICY DATA TYPE
+*
+* Note(s) : (1) The policy sets the order in which the packets deferred by the egress shaper are sent :
+*
+*               (a) TFTPs_SCHED_POLICY_FIFO     In the order they were queued.  This is the default policy.
+*
+*               (b) TFTPs_SCHED_POLICY_SRTF     Shortest remaining transfer first : packets of the sessions
+*                                               with the least file data left to send are sent first, so
+*                                               that small files complete ahead of large images.  SRTF is
+*                                               opt-in : it reorders sessions by size, & thus delays large
+*                                               transfers behind small ones (see 'CONFIGURATION DATA
+*                                               TYPE  Note #7').
+*********************************************************************************************************
+*/
+
+typedef enum tftps_sched_policy {
+    TFTPs_SCHED_POLICY_FIFO,
+    TFTPs_SCHED_POLICY_SRTF
+} TFTPs_SCHED_POLICY;
+
+
+/*
+*********************************************************************************************************
+*                                    TRAFFIC CLASS FAMILY DATA TYPE
+*********************************************************************************************************
+*/
+
+typedef enum tftps_class_family {
+    TFTPs_CLASS_FAMILY_ANY,
+    TFTPs_CLASS_FAMILY_IPv4,
+    TFTPs_CLASS_FAMILY_IPv6
+} TFTPs_CLASS_FAMILY;
+
+
+/*
+*********************************************************************************************************
+*                                TRAFFIC CLASS CONFIGURATION DATA TYPE
+*
+* Note(s) : (1) A request belongs to the first class of the class table it matches.  Requests matching NO
+*               class belong to the default class, that has NO reserved session & NO bandwidth share.
+*
+*           (2) A request matches a class when its file name starts with 'FilenamePrefixPtr' & its client
+*               belongs to the class subnet.  A NULL prefix matches any file name.
+*
+*           (3) The class subnet is 'SubnetAddr', in network order, & 'SubnetPrefixLen' bits long.  A
+*               subnet of the TFTPs_CLASS_FAMILY_ANY family matches any client.
+*
+*           (4) 'SessRsvd' sessions are reserved to the class : sessions of other classes are refused
+*               while they would leave fewer free sessions than the reserved sessions NOT in use.
+*
+*           (5) 'BwSharePct' caps the bandwidth of all the sessions of the class to a percentage of the
+*               global shaping rate (see 'CONFIGURATION DATA TYPE  Note #6').  A share of 0 leaves the
+*               class uncapped.  A share has NO effect without a global rate : it is rejected at init if
+*               the global rate is unlimited, & stops applying if the global rate is set unlimited with
+*               TFTPs_ShapeGlobalSet().
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_class_cfg {
+    const  CPU_CHAR    *FilenamePrefixPtr;                      /* File name prefix, or NULL      (see Note #2).        */
+    TFTPs_CLASS_FAMILY  SubnetFamily;                           /* Family of subnet               (see Note #3).        */
+    CPU_INT08U          SubnetAddr[16];                         /* Subnet addr                    (see Note #3).        */
+    CPU_INT08U          SubnetPrefixLen;                        /* Subnet prefix len (bits)       (see Note #3).        */
+    CPU_INT16U          SessRsvd;                               /* Nbr of reserved sessions       (see Note #4).        */
+    CPU_INT08U          BwSharePct;                             /* Bandwidth cap (%)              (see Note #5).        */
+} TFTPs_CLASS_CFG;
+
+
+/*
+*********************************************************************************************************
+*                                 FILE NAME REWRITE RULE DATA TYPE
+*
+* Note(s) : (1) A rule rewrites the names requested by the clients of its subnet that match its pattern
+*               into 'PathPtr'.  The subnet is given as for traffic classes (see 'TRAFFIC CLASS
+*               CONFIGURATION DATA TYPE  Note #3').
+*
+*           (2) 'FilenamePatternPtr' is either a file name, matched as a whole, or a file name prefix
+*               followed by '*', matching any name starting with the prefix.  The part of the name matched
+*               by '*' is appended to 'PathPtr', e.g. the prefix pattern of the "cfg/" prefix rewrites
+*               "cfg/ab" into 'PathPtr' followed by "ab".
+*
+*           (3) When several rules match a request, the rule of the longest pattern wins, a whole name
+*               before a prefix of the same length, then the rule of the longest subnet prefix, then the
+*               first rule of the table (see 'tftp-s_rewrite.c  Note #2').
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_rewrite_rule {
+    const  CPU_CHAR    *FilenamePatternPtr;                     /* File name pattern              (see Note #2).        */
+    TFTPs_CLASS_FAMILY  SubnetFamily;                           /* Family of subnet               (see Note #1).        */
+    CPU_INT08U          SubnetAddr[16];                         /* Subnet addr                    (see Note #1).        */
+    CPU_INT08U          SubnetPrefixLen;                        /* Subnet prefix len (bits)       (see Note #1).        */
+    const  CPU_CHAR    *PathPtr;                                /* Rewritten path                 (see Note #2).        */
+} TFTPs_REWRITE_RULE;
+
+
+/*
+*********************************************************************************************************
+*                                   ADDRESS FILTER PERMISSION DEFINES
+*********************************************************************************************************
+*/
+
+#define  TFTPs_ACL_PERM_NONE                        DEF_BIT_NONE  /* Client denied.                                     */
+#define  TFTPs_ACL_PERM_RD                          DEF_BIT_00    /* Client may send read  requests.                    */
+#define  TFTPs_ACL_PERM_WR                          DEF_BIT_01    /* Client may send write requests.                    */
+#define  TFTPs_ACL_PERM_RD_WR                      (TFTPs_ACL_PERM_RD | TFTPs_ACL_PERM_WR)
+
+
+/*
+*********************************************************************************************************
+*                                       EGRESS SHAPING DEFINES
+*
+* Note(s): (1) See 'CONFIGURATION DATA TYPE  Note #6'.
+*********************************************************************************************************
+*/
+
+#define  TFTPs_SHAPE_RATE_UNLIMITED                        0u   /* Rate that disables a bucket.                         */
+#define  TFTPs_SHAPE_BURST_MAX               DEF_INT_32S_MAX_VAL
+
+
+/*
+*********************************************************************************************************
+*                                    ADDRESS FILTER RULE DATA TYPE
+*
+* Note(s) : (1) A rule gives permissions to the clients of its subnet, given as for traffic classes (see
+*               'TRAFFIC CLASS CONFIGURATION DATA TYPE  Note #3').  A rule of the TFTPs_CLASS_FAMILY_ANY
+*               family holds every client, as a prefix of length 0 of both families.
+*
+*           (2) A client gets the permissions of the rule of the longest subnet prefix holding it, the
+*               first of several rules of the same subnet, or the default permissions of the configuration
+*               if NO rule holds it.  A rule with NO permission thus denies its subnet.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_acl_rule {
+    TFTPs_CLASS_FAMILY  SubnetFamily;                           /* Family of subnet               (see Note #1).        */
+    CPU_INT08U          SubnetAddr[16];                         /* Subnet addr                    (see Note #1).        */
+    CPU_INT08U          SubnetPrefixLen;                        /* Subnet prefix len (bits)       (see Note #1).        */
+    CPU_INT08U          Perm;                                   /* TFTPs_ACL_PERM_xx              (see Note #2).        */
+} TFTPs_ACL_RULE;
+
+
+/*
+*********************************************************************************************************
+*                                   LISTENER CONFIGURATION DATA TYPE
+*
+* Note(s) : (1) A listener opens one server socket per IP family of 'SockSel', bound to 'Port' & to the
+*               local address 'Addr', in network order (the first 4 octets for IPv4).  An all-zero address
+*               binds the sockets to any address, & is required with TFTPs_SOCK_SEL_IPv4_IPv6.  Listeners
+*               bound to the address of each interface thus serve each interface on its own.
+*
+*           (2) The sessions of the requests received by a listener are bound by the listener's policy, on
+*               top of the limits of the server & of their traffic class :
+*
+*               (a) 'SessNbrMax' caps the number of sessions of the listener; 0 leaves it uncapped.
+*
+*               (b) 'ShapeRate' & 'ShapeBurst' configure a token bucket shared by the sessions of the
+*                   listener (see 'CONFIGURATION DATA TYPE  Note #6'); a rate of 0 disables it.
+*
+*               (c) 'WinSizeMax' is the largest window size granted to the requests of the listener; 0
+*                   grants the 'WinSizeMax' of the server configuration.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_listen_cfg {
+    TFTPs_SOCK_SEL      SockSel;                                /* IP families of socks           (see Note #1).        */
+    CPU_INT08U          Addr[16];                               /* Local addr, or all zeros       (see Note #1).        */
+    CPU_INT16U          Port;                                   /* Local port                     (see Note #1).        */
+    CPU_INT16U          SessNbrMax;                             /* Max nbr of sessions            (see Note #2a).       */
+    CPU_INT32U          ShapeRate;                              /* Rate (octets/s)                (see Note #2b).       */
+    CPU_INT32U          ShapeBurst;                             /* Burst size (octets)            (see Note #2b).       */
+    CPU_INT16U          WinSizeMax;                             /* Max window size (blocks)       (see Note #2c).       */
+} TFTPs_LISTEN_CFG;
+
+
+/*
+*********************************************************************************************************
+*                                      SERVER STATISTICS DATA TYPE
+*
+* Note(s) : (1) See TFTPs_StatGet().  Counters wrap around once they reach their maximum value.
+*
+*           (2) Packets rejected by the address filter (see 'tftp-s_acl.c'), counted as read requests, write
+*               requests & other packets from denied clients.
+*
+*           (3) Packets deferred by the egress shaper & dropped as the single packet buffer received a packet
+*               (see 'tftp-s.c  Note #13').  Always 0 unless TFTPs_CFG_BUF_SINGLE_EN is enabled.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_stat {
+    CPU_INT32U          RxPktCtr;                               /* Nbr of pkts rx'd.                                    */
+    CPU_INT32U          ACL_RejRdCtr;                           /* Nbr of RRQ rejected            (see Note #2).        */
+    CPU_INT32U          ACL_RejWrCtr;                           /* Nbr of WRQ rejected            (see Note #2).        */
+    CPU_INT32U          ACL_RejPktCtr;                          /* Nbr of other pkts rejected     (see Note #2).        */
+    CPU_INT32U          ShapeDropCtr;                           /* Nbr of deferred pkts dropped   (see Note #3).        */
+} TFTPs_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                     SESSION STATISTICS DATA TYPE
+*
+* Note(s) : (1) See TFTPs_SessStatGet().
+*
+*           (2) 'WinEff' is the number of DATA blocks the server currently sends per round-trip time,
+*               between 1 & the negotiated 'WinSize' (see 'tftp-s.c  Note #7').
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sess_stat {
+    CPU_INT08U          ClientAddr[16];                         /* Client addr, network order.                          */
+    CPU_INT16U          ClientPort;                             /* Client port.                                         */
+    CPU_INT16U          ClientFamily;                           /* Client addr family (NET_SOCK_ADDR_FAMILY_IP_V4/V6).  */
+    CPU_INT16U          BlkSize;                                /* Negotiated block size.                               */
+    CPU_INT16U          WinSize;                                /* Negotiated window size.                              */
+    CPU_INT16U          WinEff;                                 /* Effective window size (see Note #2).                 */
+    CPU_INT32U          RTT_Avg;                                /* Smoothed round-trip time (ms).                       */
+    CPU_INT32U          XferRem;                                /* Nbr of octets left to send.                          */
+} TFTPs_SESS_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                    PACKET CAPTURE FILTER DATA TYPE
+*
+* Note(s) : (1) See TFTPs_CaptureFiltSet().  A filter selects the packets captured by the client they are
+*               exchanged with :
+*
+*               (a) A filter of the TFTPs_CLASS_FAMILY_ANY family captures the packets of all clients.
+*               (b) A filter of a null 'Port' captures the packets of all the sessions of the client
+*                   'Addr', in network order (the first 4 octets for IPv4).
+*               (c) A filter of a 'Port' captures the packets of the single session of the client 'Addr'
+*                   from that port (i.e. of the client's TID, see RFC #1350).
+*
+*           (2) 'WrFnct' is called by TFTPs_CaptureExport() with each part of the pcap file in turn, & returns
+*               DEF_OK to go on or DEF_FAIL to abort the export.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_capture_filt {
+    TFTPs_CLASS_FAMILY  Family;                                 /* Family of client               (see Note #1a).       */
+    CPU_INT08U          Addr[16];                               /* Client addr                    (see Note #1b).       */
+    CPU_INT16U          Port;                                   /* Client port, 0 for any         (see Note #1c).       */
+} TFTPs_CAPTURE_FILT;
+                                                                /* See Note #2.                                         */
+typedef  CPU_BOOLEAN  (*TFTPs_CAPTURE_WR_FNCT)(       void        *p_arg,
+                                               const  CPU_INT08U  *p_data,
+                                                      CPU_SIZE_T   len);
+
+
+/*
+*********************************************************************************************************
+*                                  SIMULATED LINK CONFIGURATION DATA TYPE
+*
+* Note(s) : (1) The link of a simulated client applies to the packets of both directions, each packet being
+*               delayed, lost, duplicated or reordered independently (see 'tftp-s_sim.c  Note #3').
+*
+*           (2) Rates are in packets per 10000 packets, e.g. 100 for 1 % of the packets.
+*
+*           (3) A reordered packet is delayed by 'ReorderDly' ms on top of its latency & jitter, so that
+*               the packets sent after it overtake it.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sim_link {
+    CPU_INT32U  Dly;                                            /* One-way latency (ms), i.e. half the RTT.             */
+    CPU_INT32U  Jitter;                                         /* Max random extra latency (ms).                       */
+    CPU_INT16U  LossRate;                                       /* Pkts lost       (see Note #2).                       */
+    CPU_INT16U  DupRate;                                        /* Pkts duplicated (see Note #2).                       */
+    CPU_INT16U  ReorderRate;                                    /* Pkts reordered  (see Note #2).                       */
+    CPU_INT32U  ReorderDly;                                     /* Extra latency (ms) of reordered pkts (see Note #3).  */
+} TFTPs_SIM_LINK;
+
+
+/*
+*********************************************************************************************************
+*                                     SIMULATED CLIENT DATA TYPE
+*
+* Note(s) : (1) Each simulated client reads, or writes when 'Wr' is DEF_YES, a file of 'FileSize' octets
+*               generated by the simulation (see 'tftp-s_sim.c  Note #4'), starting 'StartTime' ms after the
+*               start of the run.
+*
+*           (2) 'BlkSize' & 'WinSize' are requested from the server (see RFC #2348 & RFC #7440) unless 0.
+*               The transfer size is requested when 'TSize' is DEF_YES (see RFC #2349).
+*
+*           (3) The client retransmits its last packet when NO packet is received from the server for
+*               'Timeout' ms, & gives up after 'RetryMax' retransmissions in a row.
+*
+*           (4) A client MAY instead read or write the file named 'FileNamePtr', e.g. a file stored by the
+*               application, holding the 'FileSize' octets of 'FileDataPtr'.  A NULL name or data pointer
+*               selects the simulated file name or data of the client.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sim_client {
+    CPU_INT32U          FileSize;                               /* Size of file read or written   (see Note #1).        */
+    CPU_BOOLEAN         Wr;                                     /* Wr file instead of rd'ing it   (see Note #1).        */
+    CPU_INT32U          StartTime;                              /* Time (ms) of req               (see Note #1).        */
+    CPU_INT16U          BlkSize;                                /* Blk size requested             (see Note #2).        */
+    CPU_INT16U          WinSize;                                /* Window size requested          (see Note #2).        */
+    CPU_INT32U          Timeout;                                /* Retransmission timeout (ms)    (see Note #3).        */
+    CPU_INT08U          RetryMax;                               /* Max nbr of retransmissions     (see Note #3).        */
+    TFTPs_SIM_LINK      Link;                                   /* Link to server.                                      */
+    CPU_BOOLEAN         TSize;                                  /* Transfer size requested        (see Note #2).        */
+    const  CPU_CHAR    *FileNamePtr;                            /* Name of file, or NULL          (see Note #4).        */
+    const  CPU_INT08U  *FileDataPtr;                            /* Data of file, or NULL          (see Note #4).        */
+} TFTPs_SIM_CLIENT;
+
+
+/*
+*********************************************************************************************************
+*                                    SIMULATION SCENARIO DATA TYPE
+*
+* Note(s) : (1) See TFTPs_SimRun().  A run with the same scenario, including its 'Seed', on the same server
+*               configuration always gives the same results.
+*
+*           (2) A run ends when all clients are done, or after 'TimeMax' ms of simulated time.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sim_scenario {
+    const  TFTPs_SIM_CLIENT  *ClientTblPtr;                     /* Clients of the run.                                  */
+    CPU_INT16U          ClientNbr;                              /* Nbr of clients.                                      */
+    CPU_INT32U          Seed;                                   /* Seed of link randomness        (see Note #1).        */
+    CPU_INT32U          TimeMax;                                /* Max duration (ms) of the run   (see Note #2).        */
+} TFTPs_SIM_SCENARIO;
+
+
+/*
+*********************************************************************************************************
+*                                       SIMULATION RESULT DATA TYPES
+*
+* Note(s) : (1) A client is TFTPs_SIM_STATUS_INCOMPLETE when the run ended before its transfer did.
+*
+*           (2) 'Time' is the time, in ms, from the request to the last DATA block received, or to the
+*               last block acknowledged, & 'Goodput' the number of file octets transferred per second over
+*               that time.
+*
+*           (3) 'ClientResultTblPtr', if NOT NULL, points to a table of one result per client of the
+*               scenario, filled by TFTPs_SimRun().
+*********************************************************************************************************
+*/
+
+typedef enum tftps_sim_status {
+    TFTPs_SIM_STATUS_INCOMPLETE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_TIMEOUT,
+    TFTPs_SIM_STATUS_ERR_PKT,
+    TFTPs_SIM_STATUS_ERR_DATA
+} TFTPs_SIM_STATUS;
+
+
+typedef  struct  tftps_sim_client_result {
+    TFTPs_SIM_STATUS  Status;                                   /* Status of xfer                 (see Note #1).        */
+    CPU_INT32U        Octets;                                   /* Nbr of file octets rx'd or ACK'd.                    */
+    CPU_INT32U        Time;                                     /* Xfer time (ms)                 (see Note #2).        */
+    CPU_INT32U        Goodput;                                  /* Goodput (octets/s)             (see Note #2).        */
+    CPU_INT32U        PktRxCtr;                                 /* Nbr of pkts rx'd from server.                        */
+    CPU_INT32U        PktDupCtr;                                /* Nbr of DATA or ACK pkts rx'd again.                  */
+    CPU_INT32U        RetxCtr;                                  /* Nbr of pkts retransmitted by client.                 */
+} TFTPs_SIM_CLIENT_RESULT;
+
+
+typedef  struct  tftps_sim_result {
+    TFTPs_SIM_CLIENT_RESULT  *ClientResultTblPtr;               /* Per-client results             (see Note #3).        */
+    CPU_INT16U          DoneNbr;                                /* Nbr of clients done.                                 */
+    CPU_INT32U          Time;                                   /* Time (ms) of last client done.                       */
+    CPU_INT32U          Octets;                                 /* Nbr of file octets xfer'd by all clients.            */
+    CPU_INT32U          Goodput;                                /* Aggregate goodput (octets/s).                        */
+    CPU_INT32U          PktCtr;                                 /* Nbr of pkts sent on the links.                       */
+    CPU_INT32U          PktLostCtr;                             /* Nbr of pkts lost.                                    */
+    CPU_INT32U          PktDupCtr;                              /* Nbr of pkts duplicated.                              */
+    CPU_INT32U          PktReorderCtr;                          /* Nbr of pkts reordered.                               */
+    CPU_INT32U          PktDropCtr;                             /* Nbr of pkts dropped, link Q full.                    */
+} TFTPs_SIM_RESULT;
+
+
+/*
+*********************************************************************************************************
+*                                    PERFORMANCE PROBE DATA TYPES
+*
+* Note(s) : (1) Each probe measures one operation of the per-packet code (see 'tftp-s_perf.c  Note #2') :
+*
+*               (a) TFTPs_PERF_PROBE_PKT        the processing of a received packet by the server task, from
+*                                               its reception to the end of its dispatch, i.e. the cycles per
+*                                               packet.
+*
+*               (b) TFTPs_PERF_PROBE_REQ_PARSE  the parsing of the mode & options of a request.
+*
+*               (c) TFTPs_PERF_PROBE_HDR_BUILD  the building of the header of a DATA, ACK or ERROR packet.
+*
+*               (d) TFTPs_PERF_PROBE_ERR_BUILD  the building of the message of an ERROR packet.
+*
+*               (e) TFTPs_PERF_PROBE_ACK        the handling of an ACK of a read transfer, including the
+*                                               sending of the next window.
+*
+*               (f) TFTPs_PERF_PROBE_TRACE      the recording of a trace, at the trace level of the build.
+*
+*           (2) Cycles are counts of the CPU timestamp timer, i.e. CPU cycles when the timer is a cycle
+*               counter.  The overhead of a probe is measured at init & subtracted from each measure.
+*
+*           (3) 'CyclesAvg' & 'NsAvg' are computed when the statistics are read.  'Octets' is the total
+*               length of the packets or requests handled, so that the cost of an operation is split
+*               between its fixed & per-octet parts.
+*********************************************************************************************************
+*/
+
+typedef  enum  tftps_perf_probe {
+    TFTPs_PERF_PROBE_PKT,                                       /* See Note #1a.                                        */
+    TFTPs_PERF_PROBE_REQ_PARSE,                                 /* See Note #1b.                                        */
+    TFTPs_PERF_PROBE_HDR_BUILD,                                 /* See Note #1c.                                        */
+    TFTPs_PERF_PROBE_ERR_BUILD,                                 /* See Note #1d.                                        */
+    TFTPs_PERF_PROBE_ACK,                                       /* See Note #1e.                                        */
+    TFTPs_PERF_PROBE_TRACE,                                     /* See Note #1f.                                        */
+    TFTPs_PERF_PROBE_NBR
+} TFTPs_PERF_PROBE;
+
+
+typedef  struct  tftps_perf_stat {
+    CPU_INT32U  Nbr;                                            /* Nbr of ops measured.                                 */
+    CPU_INT64U  CyclesTot;                                      /* Total cycles of ops            (see Note #2).        */
+    CPU_INT32U  CyclesMin;                                      /* Min   cycles of an op.                               */
+    CPU_INT32U  CyclesMax;                                      /* Max   cycles of an op.                               */
+    CPU_INT32U  CyclesAvg;                                      /* Avg   cycles of an op          (see Note #3).        */
+    CPU_INT32U  NsAvg;                                          /* Avg   time (ns) of an op       (see Note #3).        */
+    CPU_INT64U  Octets;                                         /* Nbr of octets handled          (see Note #3).        */
+} TFTPs_PERF_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                   BATCHED TRANSMISSION DATA TYPE
+*
+* Note(s) : (1) A batch is a vector of packets ready to be sent, each one to its own client & from its own
+*               socket (see 'tftp-s_batch.c  Note #1').  Packets are in the order they were built; the
+*               packets of a window are thus consecutive & of the same length, except the last block.
+*
+*           (2) 'TxBatchFnct' sends the packets of a batch in a single call to the socket layer of the host,
+*               e.g. with sendmmsg() on Linux, or with the UDP generic segmentation offload (UDP_SEGMENT) for
+*               consecutive packets of the same socket & client.  It returns the number of packets sent
+*               from the start of the vector; the packets NOT sent are recovered like lost packets, by the
+*               retransmission timers of their sessions.
+*
+*           (3) 'AddrPtr' & 'BufPtr' are only valid during the call to 'TxBatchFnct'.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_tx_pkt {
+    NET_SOCK_ID         SockID;                                 /* Sock to send from.                                   */
+    NET_SOCK_ADDR      *AddrPtr;                                /* Client addr                    (see Note #3).        */
+    CPU_INT08U         *BufPtr;                                 /* Pkt                            (see Note #3).        */
+    CPU_INT16U          Len;                                    /* Len of pkt.                                          */
+} TFTPs_TX_PKT;
+                                                                /* See Note #2.                                         */
+typedef  CPU_INT16U  (*TFTPs_TX_BATCH_FNCT)(const  TFTPs_TX_PKT  *p_pkt_tbl,
+                                                   CPU_INT16U     pkt_nbr);
+
+
+/*
+*********************************************************************************************************
+*                                    DIGEST ALGORITHM DATA TYPE
+*
+* Note(s) : (1) The digest of the data of a transfer is computed while it is transferred :
+*
+*               (a) TFTPs_DIGEST_ALG_NONE       No digest.
+*               (b) TFTPs_DIGEST_ALG_CRC32      CRC-32 of IEEE 802.3, 4 octets.
+*               (c) TFTPs_DIGEST_ALG_SHA256     SHA-256 of FIPS 180-4, 32 octets.
+*********************************************************************************************************
+*/
+
+typedef enum tftps_digest_alg {
+    TFTPs_DIGEST_ALG_NONE,
+    TFTPs_DIGEST_ALG_CRC32,
+    TFTPs_DIGEST_ALG_SHA256
+} TFTPs_DIGEST_ALG;
+
+#define  TFTPs_DIGEST_LEN_MAX                             32u   /* Len of largest digest (SHA-256).                     */
+
+
+/*
+*********************************************************************************************************
+*                                    TRANSFER COMPLETION DATA TYPE
+*
+* Note(s) : (1) A transfer completion record is passed to the 'XferDoneHook' of the configuration when the
+*               last block of a transfer is acknowledged (see 'CONFIGURATION DATA TYPE  Note #12').
+*
+*           (2) 'FileNamePtr' is only valid during the call to the hook.
+*
+*           (3) 'Digest' holds 'DigestLen' octets, in the order they are usually displayed (i.e. the CRC-32
+*               most significant octet first).  'DigestAlg' is TFTPs_DIGEST_ALG_NONE when NO digest was
+*               computed for the transfer.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_xfer_rec {
+    const  CPU_CHAR    *FileNamePtr;                            /* Requested file name (see Note #2).                   */
+    CPU_BOOLEAN         Wr;                                     /* DEF_YES for a WRQ, DEF_NO for a RRQ.                 */
+    CPU_INT08U          ClientAddr[16];                         /* Client addr, network order.                          */
+    CPU_INT16U          ClientPort;                             /* Client port.                                         */
+    CPU_INT16U          ClientFamily;                           /* Client addr family (NET_SOCK_ADDR_FAMILY_IP_V4/V6).  */
+    CPU_INT32U          Size;                                   /* Nbr of octets transferred.                           */
+    TFTPs_DIGEST_ALG    DigestAlg;                              /* Digest alg (see Note #3).                            */
+    CPU_INT08U          DigestLen;                              /* Digest len (octets).                                 */
+    CPU_INT08U          Digest[TFTPs_DIGEST_LEN_MAX];           /* Digest (see Note #3).                                */
+} TFTPs_XFER_REC;
+
+typedef  void  (*TFTPs_XFER_DONE_HOOK)(const  TFTPs_XFER_REC  *p_rec);
+
+
+/*
+*********************************************************************************************************
+*                                      FILE PROVIDER DATA TYPE
+*
+* Note(s) : (1) A file provider serves files generated by the application, e.g. from a template in memory,
+*               instead of files of the file system (see TFTPs_FS_ProviderAdd()).
+*
+*           (2) 'Match' returns DEF_YES for the file names the provider serves.  A name matched by a
+*               provider is only served by it : the file system is NOT searched when 'Open' fails.
+*
+*           (3) 'Open' returns a handle passed to the other callbacks, or NULL when the file can NOT be
+*               served.  'Rd' reads up to 'size' octets at offset 'off' of the file, fewer at its end.
+*               'SizeGet' returns DEF_FAIL when the size is NOT known in advance.
+*
+*           (4) Provided files are read only : write requests are always served by the file system.
+*
+*           (5) The callbacks are called from the TFTP server task & MUST NOT block.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_fs_provider {
+    CPU_BOOLEAN   (*Match)  (const  CPU_CHAR    *p_name);       /* See Note #2.                                         */
+
+    void         *(*Open)   (const  CPU_CHAR    *p_name);       /* See Note #3.                                         */
+
+    CPU_BOOLEAN   (*Rd)     (       void        *p_handle,
+                                    CPU_INT32U   off,
+                                    void        *p_dest,
+                                    CPU_SIZE_T   size,
+                                    CPU_SIZE_T  *p_size_rd);
+
+    CPU_BOOLEAN   (*SizeGet)(       void        *p_handle,
+                                    CPU_INT32U  *p_size);
+
+    void          (*Close)  (       void        *p_handle);
+} TFTPs_FS_PROVIDER;
+
+
 /*
 *********************************************************************************************************
 *                                     TASK CONFIGURATION DATA TYPE
@@ -90,14 +640,165 @@ typedef  struct  tftps_task_cfg {
 /*
 *********************************************************************************************************
 *                                       CONFIGURATION DATA TYPE
+*
+* Note(s): (1) 'RxTimeoutMax' is the maximum time without any packet received from the client before a
+*              session is terminated.
+*
+*          (2) 'TxTimeoutMax' is the time to wait for the client to answer the last packet sent before it
+*              is retransmitted, up to 'TxRetryMax' times.
+*
+*          (3) 'DallyTimeoutMax' is the time a session is kept after the final ACK of a write request is
+*              sent, so that a retransmitted final DATA packet can be acknowledged again.
+*
+*          (4) 'SessNbrMax' is the maximum number of transfers served concurrently.  One session object is
+*              allocated for each of them at initialization.
+*
+*          (5) 'Buf512Nbr' .. 'Buf65464Nbr' are the number of packet buffers of each block size class (see
+*              'tftp-s_buf.h').  A session holds one buffer, of the class matching the block size
+*              negotiated with its client (see RFC #2348), for the duration of its transfer.  Classes
+*              configured with no buffer are never negotiated; at least one class MUST hold buffers.
+*
+*          (6) 'ShapeRate..' & 'ShapeBurst..' configure the egress shaper (see 'tftp-s_shape.c') :
+*
+*              (a) The global rate bounds the bandwidth of all the sessions together.
+*              (b) The client rate bounds the bandwidth of each client host, whatever the number of
+*                  sessions the host opens.
+*
+*              Rates are in octets per second of TFTP packets (i.e. UDP & IP headers excluded); a rate of
+*              0 disables its token bucket.  The burst size is the number of octets that may be sent at
+*              once after an idle period, & MUST NOT be 0 for a limited rate.  Both can be changed at
+*              run-time with TFTPs_ShapeGlobalSet() & TFTPs_ShapeClientSet().
+*
+*          (7) 'SchedPolicy' selects the order of the transmit queue (see 'TRANSMIT SCHEDULER POLICY DATA
+*              TYPE').  With the SRTF policy, 'SchedAgingRate' is the number of octets a queued packet's
+*              remaining transfer is credited with per millisecond of wait, so that packets of large
+*              transfers are NOT starved by a stream of small ones : a packet is delayed at most by its
+*              remaining transfer size divided by the aging rate.  An aging rate of 0 disables aging.
+*
+*          (8) 'ClassTblPtr' points to a table of 'ClassNbr' traffic classes (see 'TRAFFIC CLASS
+*              CONFIGURATION DATA TYPE').  A NULL table or 0 classes puts every request in the default
+*              class.
+*
+*          (9) 'ReqQ_Size' is the number of new requests held while packets of sessions in progress are
+*              pending on the socket (see 'tftp-s.c  Note #5').  A size of 0 serves requests as received.
+*
+*         (10) 'WinSizeMax' is the largest window size granted to a read request (see RFC #7440); 1
+*              disables windows.  When 'PaceEn' is enabled, the blocks of a window are spread over the
+*              round-trip time of the session, at least 'PaceGapMin' ms apart (see 'tftp-s.c  Note #6').
+*              Blocks closer than one timer tick (see 'tftp-s_cfg.h  TFTPs_CFG_TMR_TICK_MS') are sent back
+*              to back.
+*
+*         (11) 'LZ4_DecNbr' is the number of LZ4 frame decoders, i.e. of compressed files that can be read
+*              concurrently (see 'tftp-s_lz4.c').  Each decoder holds two buffers of 'LZ4_BlkSizeMax'
+*              octets, the largest block size of the frames served, & a seek index of 'LZ4_BlkNbrMax'
+*              blocks, which bounds the size of the files served to 'LZ4_BlkSizeMax * LZ4_BlkNbrMax'.
+*              These are ignored when TFTPs_CFG_FS_LZ4_EN is disabled.
+*
+*         (12) 'DigestAlg' selects the digest computed over the data of write requests, & of read requests
+*              when 'DigestRdEn' is enabled (see 'tftp-s.c  Note #8').  'XferDoneHook', if NOT NULL, is
+*              called from the TFTP server task with the completion record of each transfer (see
+*              'TRANSFER COMPLETION DATA TYPE'); it MUST return promptly, as NO packet is served meanwhile.
+*              A digest other than TFTPs_DIGEST_ALG_NONE requires TFTPs_CFG_DIGEST_EN to be enabled.
+*
+*         (13) 'RewriteTblPtr' points to a table of 'RewriteNbr' file name rewrite rules (see 'FILE NAME
+*              REWRITE RULE DATA TYPE'), applied from initialization.  The table can be replaced at
+*              run-time by a table of at most 'RewriteNbrMax' rules with TFTPs_RewriteSet().  These are
+*              ignored when TFTPs_CFG_REWRITE_EN is disabled.
+*
+*         (14) 'ACL_TblPtr' points to a table of 'ACL_Nbr' address filter rules (see 'ADDRESS FILTER RULE
+*              DATA TYPE'); 'ACL_PermDflt' holds the permissions of the clients matching NO rule.  These are
+*              ignored when TFTPs_CFG_ACL_EN is disabled.
+*
+*         (15) 'MetaNbr' is the number of entries of the file metadata index, & 'MetaTTL' the time, in
+*              milliseconds, an entry of a file found or missing is kept (see 'tftp-s_meta.c  Note #2').  The
+*              files of the 'MetaDirPtr' directory, if NOT DEF_NULL, are indexed at initialization (see
+*              'tftp-s_meta.c  Note #4').  These are ignored when TFTPs_CFG_FS_META_EN is disabled.
+*
+*         (16) 'FS_HandleIdleTimeout' is the time, in milliseconds, the shared handle of a file NOT read
+*              anymore is kept open (see 'tftp-s_fs.c  Note #6'); 0 closes it as soon as it is NOT used.
+*              It is ignored when TFTPs_CFG_FS_HANDLE_EN is disabled.
+*
+*         (17) 'FS_StreamChunkNbr' chunks of 'FS_StreamChunkSize' octets are shared by the streams of the
+*              files read, whose window holds at most 'FS_StreamWinNbr' chunks (see 'tftp-s_fs.c
+*              Note #7').  Streams are disabled when any of these is 0; they are ignored when
+*              TFTPs_CFG_FS_STREAM_EN is disabled.
+*
+*         (18) 'ListenTblPtr' points to a table of 'ListenNbr' listeners (see 'LISTENER CONFIGURATION DATA
+*              TYPE').  A NULL table or 0 listeners opens a single listener of 'SockSel' & 'Port', bound to
+*              any address, with NO policy of its own; 'SockSel' & 'Port' are ignored otherwise.
+*
+*         (19) 'CaptureNbr' is the number of packets kept by the packet capture ring, each truncated to its
+*              first 'CaptureSnapLen' octets (see 'tftp-s_capture.c  Note #1').  A null number disables the
+*              capture.  These are ignored when TFTPs_CFG_CAPTURE_EN is disabled.
+*
+*         (20) 'SimClientNbrMax' is the largest number of clients of a simulation run, & 'SimPktNbr' the
+*              number of packets the simulated links can hold in flight (see 'tftp-s_sim.c').  These are
+*              ignored when TFTPs_CFG_SIM_EN is disabled.
+*
+*         (21) 'TxBatchNbr' is the largest number of packets sent in a batch, each one copied to a slot the
+*              size of the largest packet buffer (see 'tftp-s_batch.c  Note #2').  'TxBatchFnct', if NOT
+*              NULL, sends a batch in a single call (see 'BATCHED TRANSMISSION DATA TYPE  Note #2'); the
+*              packets are sent one at a time otherwise.  A null number disables batches.  These are
+*              ignored when TFTPs_CFG_TX_BATCH_EN is disabled.
+*
+*         (22) 'RxBatchNbr' is the largest number of packets received per wakeup of the server task (see
+*              'tftp-s.c  TFTPs_Task()  Note #13') : the sockets are read without blocking until they are
+*              drained or this number is reached.  0 or 1 serves a single packet per wakeup.
 *********************************************************************************************************
 */
 
 typedef  struct  tftps_cfg {
-    TFTPs_SOCK_SEL  SockSel;
-    CPU_INT16U      Port;
-    CPU_INT32U      RxTimeoutMax;
-    CPU_INT32U      TxTimeoutMax;
+    TFTPs_SOCK_SEL      SockSel;
+    CPU_INT16U          Port;
+    CPU_INT32U          RxTimeoutMax;                           /* Session idle timeout (ms) (see Note #1).             */
+    CPU_INT32U          TxTimeoutMax;                           /* Retransmission timeout (ms) (see Note #2).           */
+    CPU_INT08U          TxRetryMax;                             /* Max nbr of retransmissions (see Note #2).            */
+    CPU_INT32U          DallyTimeoutMax;                        /* Dally time (ms) after final ACK (see Note #3).       */
+    CPU_INT16U          SessNbrMax;                             /* Max nbr of concurrent sessions (see Note #4).        */
+    CPU_INT16U          Buf512Nbr;                              /* Nbr of   512-octet blk bufs    (see Note #5).        */
+    CPU_INT16U          Buf1428Nbr;                             /* Nbr of  1428-octet blk bufs    (see Note #5).        */
+    CPU_INT16U          Buf8192Nbr;                             /* Nbr of  8192-octet blk bufs    (see Note #5).        */
+    CPU_INT16U          Buf65464Nbr;                            /* Nbr of 65464-octet blk bufs    (see Note #5).        */
+    CPU_INT32U          ShapeRateGlobal;                        /* Global rate (octets/s)         (see Note #6a).       */
+    CPU_INT32U          ShapeBurstGlobal;                       /* Global burst size (octets)     (see Note #6).        */
+    CPU_INT32U          ShapeRateClient;                        /* Client rate (octets/s)         (see Note #6b).       */
+    CPU_INT32U          ShapeBurstClient;                       /* Client burst size (octets)     (see Note #6).        */
+    TFTPs_SCHED_POLICY  SchedPolicy;                            /* Tx Q policy                    (see Note #7).        */
+    CPU_INT32U          SchedAgingRate;                         /* SRTF aging (octets/ms)         (see Note #7).        */
+    const  TFTPs_CLASS_CFG  *ClassTblPtr;                       /* Traffic class tbl              (see Note #8).        */
+    CPU_INT08U          ClassNbr;                               /* Nbr of traffic classes         (see Note #8).        */
+    CPU_INT16U          ReqQ_Size;                              /* Nbr of held requests           (see Note #9).        */
+    CPU_INT16U          WinSizeMax;                             /* Max window size (blocks)       (see Note #10).       */
+    CPU_BOOLEAN         PaceEn;                                 /* Window pacing en               (see Note #10).       */
+    CPU_INT32U          PaceGapMin;                             /* Min gap (ms) between DATA pkts (see Note #10).       */
+    CPU_INT16U          LZ4_DecNbr;                             /* Nbr of LZ4 decoders            (see Note #11).       */
+    CPU_INT32U          LZ4_BlkSizeMax;                         /* Max LZ4 blk size (octets)      (see Note #11).       */
+    CPU_INT16U          LZ4_BlkNbrMax;                          /* Max nbr of LZ4 blks per file   (see Note #11).       */
+    TFTPs_DIGEST_ALG    DigestAlg;                              /* Digest alg                     (see Note #12).       */
+    CPU_BOOLEAN         DigestRdEn;                             /* Digest of RRQ data en          (see Note #12).       */
+    TFTPs_XFER_DONE_HOOK  XferDoneHook;                         /* Xfer completion hook           (see Note #12).       */
+    const  TFTPs_REWRITE_RULE  *RewriteTblPtr;                  /* Rewrite rule tbl               (see Note #13).       */
+    CPU_INT16U          RewriteNbr;                             /* Nbr of rewrite rules           (see Note #13).       */
+    CPU_INT16U          RewriteNbrMax;                          /* Max nbr of rewrite rules       (see Note #13).       */
+    const  TFTPs_ACL_RULE  *ACL_TblPtr;                         /* Addr filter rule tbl           (see Note #14).       */
+    CPU_INT16U          ACL_Nbr;                                /* Nbr of addr filter rules       (see Note #14).       */
+    CPU_INT08U          ACL_PermDflt;                           /* Dflt perm (TFTPs_ACL_PERM_xx)  (see Note #14).       */
+    CPU_INT16U          MetaNbr;                                /* Nbr of file index entries      (see Note #15).       */
+    CPU_INT32U          MetaTTL;                                /* Lifetime of index entry (ms)   (see Note #15).       */
+    CPU_CHAR           *MetaDirPtr;                             /* Dir indexed at init            (see Note #15).       */
+    CPU_INT32U          FS_HandleIdleTimeout;                   /* Unused file handle timeout (ms) (see Note #16).      */
+    CPU_INT32U          FS_StreamChunkSize;                     /* Size of stream chunks          (see Note #17).       */
+    CPU_INT16U          FS_StreamChunkNbr;                      /* Nbr of stream chunks           (see Note #17).       */
+    CPU_INT16U          FS_StreamWinNbr;                        /* Max nbr of chunks per stream   (see Note #17).       */
+    const  TFTPs_LISTEN_CFG  *ListenTblPtr;                     /* Listener tbl                   (see Note #18).       */
+    CPU_INT08U          ListenNbr;                              /* Nbr of listeners               (see Note #18).       */
+    CPU_INT16U          CaptureNbr;                             /* Nbr of pkts captured           (see Note #19).       */
+    CPU_INT16U          CaptureSnapLen;                         /* Max len of pkts captured       (see Note #19).       */
+    CPU_INT16U          SimClientNbrMax;                        /* Max nbr of simulated clients   (see Note #20).       */
+    CPU_INT16U          SimPktNbr;                              /* Nbr of simulated pkts in flight (see Note #20).      */
+    CPU_INT16U          TxBatchNbr;                             /* Max nbr of pkts per tx batch   (see Note #21).       */
+    TFTPs_TX_BATCH_FNCT  TxBatchFnct;                           /* Batch tx fnct                  (see Note #21).       */
+    CPU_INT16U          RxBatchNbr;                             /* Max nbr of pkts rx'd per wakeup (see Note #22).      */
 } TFTPs_CFG;
 
 
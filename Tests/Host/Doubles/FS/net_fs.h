@@ -0,0 +1,103 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                           HOST TEST DOUBLE : NETWORK FILE SYSTEM INTERFACE
+*
+* Filename : net_fs.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  NET_FS_H
+#define  NET_FS_H
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+#define  NET_FS_FILE_MODE_OPEN                             1u
+#define  NET_FS_FILE_MODE_CREATE                           2u
+
+#define  NET_FS_FILE_ACCESS_RD                             1u
+#define  NET_FS_FILE_ACCESS_WR                             2u
+
+#define  NET_FS_SEEK_ORIGIN_START                          1u
+
+#define  NET_FS_ENTRY_ATTRIB_DIR                        0x08u
+
+
+typedef  CPU_INT08U  NET_FS_FILE_MODE;
+typedef  CPU_INT08U  NET_FS_FILE_ACCESS;
+typedef  CPU_INT08U  NET_FS_ENTRY_ATTRIB;
+
+typedef  struct  net_fs_date_time {
+    CPU_INT16U  Yr;
+} NET_FS_DATE_TIME;
+
+typedef  struct  net_fs_entry {
+    NET_FS_ENTRY_ATTRIB   Attrib;
+    CPU_INT32U            Size;
+    NET_FS_DATE_TIME      DateTimeCreate;
+    CPU_CHAR             *NamePtr;
+} NET_FS_ENTRY;
+
+
+void         *NetFS_FileOpen   (CPU_CHAR            *p_name,
+                                NET_FS_FILE_MODE     mode,
+                                NET_FS_FILE_ACCESS   access);
+
+void          NetFS_FileClose  (void                *p_file);
+
+CPU_BOOLEAN   NetFS_FileRd     (void                *p_file,
+                                void                *p_dest,
+                                CPU_SIZE_T           size,
+                                CPU_SIZE_T          *p_size_rd);
+
+CPU_BOOLEAN   NetFS_FileWr     (void                *p_file,
+                                void                *p_src,
+                                CPU_SIZE_T           size,
+                                CPU_SIZE_T          *p_size_wr);
+
+CPU_BOOLEAN   NetFS_FilePosSet (void                *p_file,
+                                CPU_INT32S           offset,
+                                CPU_INT08U           origin);
+
+CPU_BOOLEAN   NetFS_FilePosGet (void                *p_file,
+                                CPU_INT32U          *p_pos);
+
+CPU_BOOLEAN   NetFS_FileSizeGet(void                *p_file,
+                                CPU_INT32U          *p_size);
+
+void         *NetFS_DirOpen    (CPU_CHAR            *p_name);
+
+void          NetFS_DirClose   (void                *p_dir);
+
+CPU_BOOLEAN   NetFS_DirRd      (void                *p_dir,
+                                NET_FS_ENTRY        *p_entry);
+
+
+                                                                /* Host tests only (see 'doubles.c  FILE SYSTEM').      */
+CPU_BOOLEAN   HostFS_FileStatGet(const  CPU_CHAR    *p_name,
+                                        CPU_INT32U  *p_open_ctr,
+                                        CPU_INT32U  *p_rd_ctr);
+
+void          HostFS_FileStatClr(void);
+
+#endif
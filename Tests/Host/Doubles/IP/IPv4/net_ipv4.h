@@ -0,0 +1,37 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST TEST DOUBLE : IPv4 LAYER
+*
+* Filename : net_ipv4.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  NET_IPv4_H
+#define  NET_IPv4_H
+
+#include  <Source/net_sock.h>
+
+
+#define  NET_IPv4_ADDR_NONE                                0u
+#define  NET_IPv4_ADDR_SIZE                                4u
+
+#endif
@@ -0,0 +1,65 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                              HOST TEST DOUBLE : KERNEL ABSTRACTION LAYER
+*
+* Filename : kal.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  KAL_H
+#define  KAL_H
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+#define  KAL_ERR_NONE                                      0u
+#define  KAL_ERR_INVALID_ARG                               1u
+#define  KAL_ERR_MEM_ALLOC                                 2u
+#define  KAL_ERR_ISR                                       3u
+#define  KAL_ERR_OS                                        4u
+
+
+typedef  CPU_INT16U  KAL_ERR;
+typedef  CPU_INT32U  KAL_TICK;
+
+typedef  struct  kal_task_handle {
+    void  *TaskObjPtr;
+} KAL_TASK_HANDLE;
+
+
+KAL_TASK_HANDLE  KAL_TaskAlloc (const  CPU_CHAR         *p_name,
+                                       CPU_INT08U       *p_stk_base,
+                                       CPU_SIZE_T        stk_size_bytes,
+                                       void             *p_cfg,
+                                       KAL_ERR          *p_err);
+
+void             KAL_TaskCreate(       KAL_TASK_HANDLE   task_handle,
+                                       void            (*p_fnct)(void  *p_arg),
+                                       void             *p_task_arg,
+                                       CPU_INT08U        prio,
+                                       void             *p_cfg,
+                                       KAL_ERR          *p_err);
+
+KAL_TICK         KAL_TickGet   (       KAL_ERR          *p_err);
+
+#endif
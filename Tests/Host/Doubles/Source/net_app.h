@@ -0,0 +1,41 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                           HOST TEST DOUBLE : NETWORK APPLICATION INTERFACE
+*
+* Filename : net_app.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  NET_APP_H
+#define  NET_APP_H
+
+#include  <Source/net_sock.h>
+
+
+void  NetApp_SetSockAddr(NET_SOCK_ADDR         *p_sock_addr,
+                         NET_SOCK_ADDR_FAMILY   addr_family,
+                         NET_PORT_NBR           port_nbr,
+                         CPU_INT08U            *p_addr,
+                         NET_IP_ADDR_LEN        addr_len,
+                         NET_ERR               *p_err);
+
+#endif
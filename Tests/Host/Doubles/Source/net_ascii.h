@@ -0,0 +1,45 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                               HOST TEST DOUBLE : NETWORK ASCII LIBRARY
+*
+* Filename : net_ascii.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  NET_ASCII_H
+#define  NET_ASCII_H
+
+#include  <Source/net_sock.h>
+
+
+void  NetASCII_IPv4_to_Str(NET_IPv4_ADDR   addr,
+                           CPU_CHAR       *p_addr_str,
+                           CPU_BOOLEAN     lead_zeros,
+                           NET_ERR        *p_err);
+
+void  NetASCII_IPv6_to_Str(NET_IPv6_ADDR  *p_addr,
+                           CPU_CHAR       *p_addr_str,
+                           CPU_BOOLEAN     hex_lower_case,
+                           CPU_BOOLEAN     lead_zeros,
+                           NET_ERR        *p_err);
+
+#endif
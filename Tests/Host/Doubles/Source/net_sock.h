@@ -0,0 +1,156 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST TEST DOUBLE : NETWORK SOCKETS
+*
+* Filename : net_sock.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  NET_SOCK_H
+#define  NET_SOCK_H
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+#define  NET_SOCK_NBR_SOCK                                16
+
+#define  NET_SOCK_FAMILY_IP_V4                             2
+#define  NET_SOCK_FAMILY_IP_V6                            10
+#define  NET_SOCK_ADDR_FAMILY_IP_V4                        2
+#define  NET_SOCK_ADDR_FAMILY_IP_V6                       10
+#define  NET_SOCK_TYPE_DATAGRAM                            1
+#define  NET_SOCK_PROTOCOL_UDP                            17
+
+#define  NET_SOCK_FLAG_NONE                                0
+#define  NET_SOCK_FLAG_RX_NO_BLOCK                         1
+
+#define  NET_SOCK_BSD_ERR_NONE                             0
+#define  NET_SOCK_BSD_ERR_RX                              -1
+#define  NET_SOCK_BSD_ERR_TX                              -1
+
+#define  NET_SOCK_ERR_NONE                                 0u
+#define  NET_SOCK_ERR_INVALID_FAMILY                       1u
+#define  NET_APP_ERR_NONE                                  0u
+
+#define  NET_TMR_TIME_INFINITE                             0u
+
+#define  NET_SOCK_ADDR_SIZE                               28u
+
+
+typedef  CPU_INT16U  NET_ERR;
+typedef  CPU_INT16S  NET_SOCK_ID;
+typedef  CPU_INT16S  NET_SOCK_QTY;
+typedef  CPU_INT16S  NET_SOCK_RTN_CODE;
+typedef  CPU_INT16S  NET_SOCK_ADDR_LEN;
+typedef  CPU_INT16S  NET_SOCK_API_FLAGS;
+typedef  CPU_INT08U  NET_SOCK_FAMILY;
+typedef  CPU_INT08U  NET_SOCK_PROTOCOL_FAMILY;
+typedef  CPU_INT16U  NET_SOCK_ADDR_FAMILY;
+typedef  CPU_INT16U  NET_PORT_NBR;
+typedef  CPU_INT08U  NET_IP_ADDR_LEN;
+typedef  CPU_INT32U  NET_IPv4_ADDR;
+
+typedef  struct  net_ipv6_addr {
+    CPU_INT08U  Addr[16];
+} NET_IPv6_ADDR;
+
+typedef  struct  net_sock_addr {
+    NET_SOCK_ADDR_FAMILY  AddrFamily;
+    CPU_INT08U            Addr[NET_SOCK_ADDR_SIZE - sizeof(NET_SOCK_ADDR_FAMILY)];
+} NET_SOCK_ADDR;
+
+typedef  struct  net_sock_addr_ipv4 {
+    NET_SOCK_ADDR_FAMILY  AddrFamily;
+    NET_PORT_NBR          Port;
+    NET_IPv4_ADDR         Addr;
+    CPU_INT08U            Unused[8];
+} NET_SOCK_ADDR_IPv4;
+
+typedef  struct  net_sock_addr_ipv6 {
+    NET_SOCK_ADDR_FAMILY  AddrFamily;
+    NET_PORT_NBR          Port;
+    CPU_INT32U            FlowInfo;
+    NET_IPv6_ADDR         Addr;
+    CPU_INT32U            ScopeID;
+} NET_SOCK_ADDR_IPv6;
+
+typedef  struct  net_sock_desc {
+    CPU_INT32U  SockID_Bits;
+} NET_SOCK_DESC;
+
+typedef  struct  net_sock_timeout {
+    CPU_INT32S  timeout_sec;
+    CPU_INT32S  timeout_us;
+} NET_SOCK_TIMEOUT;
+
+
+#define  NET_SOCK_DESC_INIT(p_desc)               ((p_desc)->SockID_Bits  =  0u)
+#define  NET_SOCK_DESC_SET(id, p_desc)            ((p_desc)->SockID_Bits |=  DEF_BIT(id))
+#define  NET_SOCK_DESC_CLR(id, p_desc)            ((p_desc)->SockID_Bits &= ~DEF_BIT(id))
+#define  NET_SOCK_DESC_IS_SET(id, p_desc)         ((((p_desc)->SockID_Bits & DEF_BIT(id)) != 0u) ? DEF_YES : DEF_NO)
+
+
+NET_SOCK_ID        NetSock_Open             (NET_SOCK_PROTOCOL_FAMILY   protocol_family,
+                                             CPU_INT08U                 sock_type,
+                                             CPU_INT08U                 protocol,
+                                             NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_Bind             (NET_SOCK_ID                sock_id,
+                                             NET_SOCK_ADDR             *p_addr_local,
+                                             NET_SOCK_ADDR_LEN          addr_len,
+                                             NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_Close            (NET_SOCK_ID                sock_id,
+                                             NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_RxDataFrom       (NET_SOCK_ID                sock_id,
+                                             void                      *p_data_buf,
+                                             CPU_INT16U                 data_buf_len,
+                                             NET_SOCK_API_FLAGS         flags,
+                                             NET_SOCK_ADDR             *p_addr_remote,
+                                             NET_SOCK_ADDR_LEN         *p_addr_len,
+                                             void                      *p_ip_opts_buf,
+                                             CPU_INT08U                 ip_opts_buf_len,
+                                             CPU_INT08U                *p_ip_opts_len,
+                                             NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_TxDataTo         (NET_SOCK_ID                sock_id,
+                                             void                      *p_data,
+                                             CPU_INT16U                 data_len,
+                                             NET_SOCK_API_FLAGS         flags,
+                                             NET_SOCK_ADDR             *p_addr_remote,
+                                             NET_SOCK_ADDR_LEN          addr_len,
+                                             NET_ERR                   *p_err);
+
+CPU_BOOLEAN        NetSock_CfgTimeoutRxQ_Set(NET_SOCK_ID                sock_id,
+                                             CPU_INT32U                 timeout_ms,
+                                             NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_Sel              (NET_SOCK_QTY               sock_nbr_max,
+                                             NET_SOCK_DESC             *p_sock_desc_rd,
+                                             NET_SOCK_DESC             *p_sock_desc_wr,
+                                             NET_SOCK_DESC             *p_sock_desc_err,
+                                             NET_SOCK_TIMEOUT          *p_timeout,
+                                             NET_ERR                   *p_err);
+
+#endif
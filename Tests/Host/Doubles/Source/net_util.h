@@ -0,0 +1,58 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                 HOST TEST DOUBLE : NETWORK UTILITIES
+*
+* Filename : net_util.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  NET_UTIL_H
+#define  NET_UTIL_H
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+#define  NET_UTIL_HOST_TO_NET_16(val)             ((CPU_INT16U)((((CPU_INT16U)(val) & 0x00FFu) << 8) | \
+                                                                (((CPU_INT16U)(val) & 0xFF00u) >> 8)))
+#define  NET_UTIL_HOST_TO_NET_32(val)             ((CPU_INT32U)((((CPU_INT32U)(val) & 0x000000FFu) << 24) | \
+                                                                (((CPU_INT32U)(val) & 0x0000FF00u) <<  8) | \
+                                                                (((CPU_INT32U)(val) & 0x00FF0000u) >>  8) | \
+                                                                (((CPU_INT32U)(val) & 0xFF000000u) >> 24)))
+#define  NET_UTIL_NET_TO_HOST_16(val)             NET_UTIL_HOST_TO_NET_16(val)
+#define  NET_UTIL_NET_TO_HOST_32(val)             NET_UTIL_HOST_TO_NET_32(val)
+
+#define  NET_UTIL_VAL_SET_NET_16(p_addr, val)     do { ((CPU_INT08U *)(p_addr))[0] = (CPU_INT08U)((val) >>  8);  \
+                                                       ((CPU_INT08U *)(p_addr))[1] = (CPU_INT08U)((val) & 0xFFu); \
+                                                     } while (0)
+#define  NET_UTIL_VAL_SET_HOST_16(p_addr, val)    do { CPU_INT16U  val_16 = (CPU_INT16U)(val);                   \
+                                                       Mem_Copy((p_addr), &val_16, sizeof(val_16)); } while (0)
+#define  NET_UTIL_VAL_SET_HOST_32(p_addr, val)    do { CPU_INT32U  val_32 = (CPU_INT32U)(val);                   \
+                                                       Mem_Copy((p_addr), &val_32, sizeof(val_32)); } while (0)
+
+
+typedef  CPU_INT32U  NET_TS_MS;
+
+
+NET_TS_MS  NetUtil_TS_Get_ms(void);
+
+#endif
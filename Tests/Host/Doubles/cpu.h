@@ -0,0 +1,55 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      HOST TEST DOUBLE : CPU PORT
+*
+* Filename : cpu.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  CPU_H
+#define  CPU_H
+
+#include  <stdint.h>
+#include  <stddef.h>
+
+
+typedef  char           CPU_CHAR;
+typedef  uint8_t        CPU_BOOLEAN;
+typedef  uint8_t        CPU_INT08U;
+typedef  int8_t         CPU_INT08S;
+typedef  uint16_t       CPU_INT16U;
+typedef  int16_t        CPU_INT16S;
+typedef  uint32_t       CPU_INT32U;
+typedef  int32_t        CPU_INT32S;
+typedef  uint64_t       CPU_INT64U;
+typedef  int64_t        CPU_INT64S;
+typedef  size_t         CPU_SIZE_T;
+typedef  uint32_t       CPU_DATA;
+typedef  uintptr_t      CPU_ADDR;
+typedef  uint32_t       CPU_ALIGN;
+typedef  uint32_t       CPU_SR;
+typedef  uint32_t       CPU_TS32;
+typedef  uint64_t       CPU_TS64;
+typedef  uint32_t       CPU_TS_TMR;
+typedef  uint32_t       CPU_TS_TMR_FREQ;
+
+#endif
@@ -0,0 +1,62 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      HOST TEST DOUBLE : CPU CORE
+*
+* Filename : cpu_core.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  CPU_CORE_H
+#define  CPU_CORE_H
+
+#include  <stdlib.h>
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+#define  CPU_CFG_TS_32_EN                         DEF_DISABLED
+#define  CPU_CFG_TS_64_EN                         DEF_DISABLED
+#define  CPU_CFG_TS_TMR_EN                        DEF_ENABLED
+
+#define  CPU_ERR_NONE                                      0u
+
+#define  CPU_SW_EXCEPTION(err_rtn_val)            abort()
+
+#define  CPU_SR_ALLOC()                           CPU_SR  cpu_sr = 0u
+#define  CPU_CRITICAL_ENTER()                     (void)cpu_sr
+#define  CPU_CRITICAL_EXIT()
+
+
+typedef  CPU_INT16U  CPU_ERR;
+
+
+CPU_DATA         CPU_CntTrailZeros32(CPU_INT32U   val);
+
+CPU_TS_TMR       CPU_TS_TmrRd       (void);
+
+CPU_TS_TMR_FREQ  CPU_TS_TmrFreqGet  (CPU_ERR     *p_err);
+
+CPU_TS64         CPU_TS_Get64       (void);
+
+CPU_INT64U       CPU_TS64_to_uSec   (CPU_TS64     ts);
+
+#endif
@@ -0,0 +1,927 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST TEST DOUBLES : IMPLEMENTATION
+*
+* Filename : doubles.c
+*********************************************************************************************************
+* Note(s)  : (1) Implements the services of uC/CPU, uC/LIB, the kernel abstraction layer & uC/TCP-IP that
+*                the TFTP server calls, on top of the C library of the host, for host builds of the tests
+*                only (see 'Tests/Host/Makefile').
+*
+*            (2) The sockets are NOT implemented : the tests run the server against the network simulation
+*                (see 'tftp-s_sim.c'), which opens NO socket.
+*
+*            (3) The file system is a flat file system in memory, holding up to HOST_FS_FILE_NBR_MAX files
+*                with NO directories, so that the files written by the server can be read back.
+*
+*            (4) The CPU timestamp timer counts the nanoseconds of the monotonic clock of the host.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  _POSIX_C_SOURCE  200809L
+
+#include  <stdarg.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <strings.h>
+#include  <time.h>
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+#include  <lib_def.h>
+#include  <lib_mem.h>
+#include  <lib_str.h>
+#include  <KAL/kal.h>
+#include  <Source/net_sock.h>
+#include  <Source/net_app.h>
+#include  <Source/net_ascii.h>
+#include  <Source/net_util.h>
+#include  <IP/IPv6/net_ipv6.h>
+#include  <FS/net_fs.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  HOST_FS_FILE_NBR_MAX                             32u   /* See Note #3.                                         */
+#define  HOST_FS_HANDLE_NBR_MAX                           32u
+#define  HOST_FS_NAME_LEN_MAX                            127u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  host_fs_file {
+    CPU_BOOLEAN   Used;
+    CPU_CHAR      Name[HOST_FS_NAME_LEN_MAX + 1u];
+    CPU_INT08U   *DataPtr;
+    CPU_SIZE_T    Size;
+    CPU_SIZE_T    SizeMax;                                      /* Size of data buf.                                    */
+    CPU_INT32U    OpenCtr;                                      /* Nbr of opens for rd   (see 'FILE SYSTEM  Note #2').  */
+    CPU_INT32U    RdCtr;                                        /* Nbr of octets rd      (see 'FILE SYSTEM  Note #2').  */
+} HOST_FS_FILE;
+
+
+typedef  struct  host_fs_handle {
+    HOST_FS_FILE  *FilePtr;                                     /* NULL if handle free.                                 */
+    CPU_SIZE_T     Pos;
+    CPU_BOOLEAN    Wr;
+} HOST_FS_HANDLE;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+const  NET_IPv6_ADDR    NET_IPv6_ADDR_ANY = { { 0u } };
+
+static  HOST_FS_FILE    HostFS_FileTbl[HOST_FS_FILE_NBR_MAX];
+static  HOST_FS_HANDLE  HostFS_HandleTbl[HOST_FS_HANDLE_NBR_MAX];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          CPU CORE SERVICES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+CPU_DATA  CPU_CntTrailZeros32 (CPU_INT32U  val)
+{
+    if (val == 0u) {
+        return (32u);
+    }
+
+    return ((CPU_DATA)__builtin_ctz(val));
+}
+
+
+CPU_TS_TMR  CPU_TS_TmrRd (void)                                 /* See Note #4.                                         */
+{
+    struct  timespec  ts;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((CPU_TS_TMR)((CPU_INT64U)ts.tv_sec * 1000000000u + (CPU_INT64U)ts.tv_nsec));
+}
+
+
+CPU_TS_TMR_FREQ  CPU_TS_TmrFreqGet (CPU_ERR  *p_err)
+{
+   *p_err = CPU_ERR_NONE;
+
+    return (1000000000u);
+}
+
+
+CPU_TS64  CPU_TS_Get64 (void)
+{
+    struct  timespec  ts;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((CPU_TS64)ts.tv_sec * 1000000000u + (CPU_TS64)ts.tv_nsec);
+}
+
+
+CPU_INT64U  CPU_TS64_to_uSec (CPU_TS64  ts)
+{
+    return (ts / 1000u);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MEMORY LIBRARY
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void  Mem_Set (void        *p_mem,
+               CPU_INT08U   data_val,
+               CPU_SIZE_T   size)
+{
+    memset(p_mem, data_val, size);
+}
+
+
+void  Mem_Clr (void        *p_mem,
+               CPU_SIZE_T   size)
+{
+    memset(p_mem, 0, size);
+}
+
+
+void  Mem_Copy (       void        *p_dest,
+                const  void        *p_src,
+                       CPU_SIZE_T   size)
+{
+    memmove(p_dest, p_src, size);
+}
+
+
+CPU_BOOLEAN  Mem_Cmp (const  void        *p1_mem,
+                      const  void        *p2_mem,
+                             CPU_SIZE_T   size)
+{
+    return ((memcmp(p1_mem, p2_mem, size) == 0) ? DEF_YES : DEF_NO);
+}
+
+
+void  *Mem_SegAlloc (const  CPU_CHAR    *p_name,
+                            MEM_SEG     *p_seg,
+                            CPU_SIZE_T   size,
+                            LIB_ERR     *p_err)
+{
+    void  *p_blk;
+
+
+    (void)p_name;
+    (void)p_seg;
+
+    p_blk = calloc(1u, (size > 0u) ? size : 1u);
+   *p_err = (p_blk != DEF_NULL) ? LIB_MEM_ERR_NONE : LIB_MEM_ERR_POOL_EMPTY;
+
+    return (p_blk);
+}
+
+
+void  Mem_DynPoolCreate (const  CPU_CHAR      *p_name,
+                                MEM_DYN_POOL  *p_pool,
+                                MEM_SEG       *p_seg,
+                                CPU_SIZE_T     blk_size,
+                                CPU_SIZE_T     blk_align,
+                                CPU_SIZE_T     blk_qty_init,
+                                CPU_SIZE_T     blk_qty_max,
+                                LIB_ERR       *p_err)
+{
+    (void)p_name;
+    (void)p_seg;
+    (void)blk_align;
+    (void)blk_qty_init;
+
+    if (blk_size == 0u) {
+       *p_err = LIB_MEM_ERR_INVALID_BLK_SIZE;
+        return;
+    }
+
+    p_pool->BlkSize     = blk_size;
+    p_pool->BlkQtyMax   = blk_qty_max;
+    p_pool->BlkAllocCnt = 0u;
+
+   *p_err = LIB_MEM_ERR_NONE;
+}
+
+
+void  *Mem_DynPoolBlkGet (MEM_DYN_POOL  *p_pool,
+                          LIB_ERR       *p_err)
+{
+    void  *p_blk;
+
+
+    if ((p_pool->BlkQtyMax   != 0u) &&
+        (p_pool->BlkAllocCnt >= p_pool->BlkQtyMax)) {
+       *p_err = LIB_MEM_ERR_POOL_EMPTY;
+        return (DEF_NULL);
+    }
+
+    p_blk = calloc(1u, p_pool->BlkSize);
+    if (p_blk == DEF_NULL) {
+       *p_err = LIB_MEM_ERR_POOL_EMPTY;
+        return (DEF_NULL);
+    }
+    p_pool->BlkAllocCnt++;
+
+   *p_err = LIB_MEM_ERR_NONE;
+
+    return (p_blk);
+}
+
+
+void  Mem_DynPoolBlkFree (MEM_DYN_POOL  *p_pool,
+                          void          *p_blk,
+                          LIB_ERR       *p_err)
+{
+    free(p_blk);
+    p_pool->BlkAllocCnt--;
+
+   *p_err = LIB_MEM_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           STRING LIBRARY
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  Str_Len (const  CPU_CHAR  *p_str)
+{
+    return (strlen(p_str));
+}
+
+
+CPU_SIZE_T  Str_Len_N (const  CPU_CHAR    *p_str,
+                              CPU_SIZE_T   len_max)
+{
+    return (strnlen(p_str, len_max));
+}
+
+
+CPU_CHAR  *Str_Copy (       CPU_CHAR  *p_str_dest,
+                     const  CPU_CHAR  *p_str_src)
+{
+    return (strcpy(p_str_dest, p_str_src));
+}
+
+
+CPU_CHAR  *Str_Copy_N (       CPU_CHAR    *p_str_dest,
+                       const  CPU_CHAR    *p_str_src,
+                              CPU_SIZE_T   len_max)
+{
+    return (strncpy(p_str_dest, p_str_src, len_max));
+}
+
+
+CPU_CHAR  *Str_Cat (       CPU_CHAR  *p_str_dest,
+                    const  CPU_CHAR  *p_str_cat)
+{
+    return (strcat(p_str_dest, p_str_cat));
+}
+
+
+CPU_INT16S  Str_Cmp (const  CPU_CHAR  *p1_str,
+                     const  CPU_CHAR  *p2_str)
+{
+    return ((CPU_INT16S)strcmp(p1_str, p2_str));
+}
+
+
+CPU_INT16S  Str_Cmp_N (const  CPU_CHAR    *p1_str,
+                       const  CPU_CHAR    *p2_str,
+                              CPU_SIZE_T   len_max)
+{
+    return ((CPU_INT16S)strncmp(p1_str, p2_str, len_max));
+}
+
+
+CPU_INT16S  Str_CmpIgnoreCase (const  CPU_CHAR  *p1_str,
+                               const  CPU_CHAR  *p2_str)
+{
+    return ((CPU_INT16S)strcasecmp(p1_str, p2_str));
+}
+
+
+CPU_CHAR  *Str_Char_N (const  CPU_CHAR    *p_str,
+                              CPU_SIZE_T   len_max,
+                              CPU_CHAR     srch_char)
+{
+    CPU_SIZE_T  i;
+
+
+    for (i = 0u; (i < len_max) && (p_str[i] != ASCII_CHAR_NULL); i++) {
+        if (p_str[i] == srch_char) {
+            return ((CPU_CHAR *)&p_str[i]);
+        }
+    }
+
+    return (DEF_NULL);
+}
+
+
+CPU_INT32U  Str_ParseNbr_Int32U (const  CPU_CHAR     *p_str,
+                                        CPU_CHAR    **p_str_next,
+                                        CPU_INT08U    nbr_base)
+{
+    return ((CPU_INT32U)strtoul(p_str, p_str_next, nbr_base));
+}
+
+
+CPU_CHAR  *Str_FmtNbr_Int32U (CPU_INT32U    nbr,
+                              CPU_INT08U    nbr_dig,
+                              CPU_INT08U    nbr_base,
+                              CPU_CHAR      lead_char,
+                              CPU_BOOLEAN   lower_case,
+                              CPU_BOOLEAN   nul,
+                              CPU_CHAR     *p_str)
+{
+    (void)nbr_base;                                             /* Only dec nbrs w/o leading chars are fmt'd.           */
+    (void)lead_char;
+    (void)lower_case;
+    (void)nul;
+
+    (void)snprintf(p_str, (CPU_SIZE_T)nbr_dig + 1u, "%lu", (unsigned long)nbr);
+
+    return (p_str);
+}
+
+
+int  Str_FmtPrint (       CPU_CHAR    *p_str,
+                          CPU_SIZE_T   size,
+                   const  CPU_CHAR    *p_fmt,
+                                       ...)
+{
+    va_list  args;
+    int      len;
+
+
+    va_start(args, p_fmt);
+    len = vsnprintf(p_str, size, p_fmt, args);
+    va_end(args);
+
+    return (len);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                      KERNEL ABSTRACTION LAYER
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+KAL_TASK_HANDLE  KAL_TaskAlloc (const  CPU_CHAR    *p_name,
+                                       CPU_INT08U  *p_stk_base,
+                                       CPU_SIZE_T   stk_size_bytes,
+                                       void        *p_cfg,
+                                       KAL_ERR     *p_err)
+{
+    KAL_TASK_HANDLE  task_handle;
+
+
+    (void)p_name;
+    (void)p_stk_base;
+    (void)stk_size_bytes;
+    (void)p_cfg;
+
+    task_handle.TaskObjPtr = DEF_NULL;
+   *p_err                  = KAL_ERR_NONE;
+
+    return (task_handle);
+}
+
+
+void  KAL_TaskCreate (KAL_TASK_HANDLE    task_handle,
+                      void             (*p_fnct)(void  *p_arg),
+                      void              *p_task_arg,
+                      CPU_INT08U         prio,
+                      void              *p_cfg,
+                      KAL_ERR           *p_err)
+{
+    (void)task_handle;                                          /* Task NOT run : the tests run the server loop.        */
+    (void)p_fnct;
+    (void)p_task_arg;
+    (void)prio;
+    (void)p_cfg;
+
+   *p_err = KAL_ERR_NONE;
+}
+
+
+KAL_TICK  KAL_TickGet (KAL_ERR  *p_err)
+{
+   *p_err = KAL_ERR_NONE;
+
+    return ((KAL_TICK)(CPU_TS_Get64() / 1000000u));
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          NETWORK SERVICES
+*
+* Note(s) : (1) See 'doubles.c  Note #2'.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+NET_SOCK_ID  NetSock_Open (NET_SOCK_PROTOCOL_FAMILY   protocol_family,
+                           CPU_INT08U                 sock_type,
+                           CPU_INT08U                 protocol,
+                           NET_ERR                   *p_err)
+{
+    (void)protocol_family;
+    (void)sock_type;
+    (void)protocol;
+
+   *p_err = NET_SOCK_ERR_INVALID_FAMILY;
+
+    return (-1);
+}
+
+
+NET_SOCK_RTN_CODE  NetSock_Bind (NET_SOCK_ID         sock_id,
+                                 NET_SOCK_ADDR      *p_addr_local,
+                                 NET_SOCK_ADDR_LEN   addr_len,
+                                 NET_ERR            *p_err)
+{
+    (void)sock_id;
+    (void)p_addr_local;
+    (void)addr_len;
+
+   *p_err = NET_SOCK_ERR_INVALID_FAMILY;
+
+    return (NET_SOCK_BSD_ERR_RX);
+}
+
+
+NET_SOCK_RTN_CODE  NetSock_Close (NET_SOCK_ID   sock_id,
+                                  NET_ERR      *p_err)
+{
+    (void)sock_id;
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (NET_SOCK_BSD_ERR_NONE);
+}
+
+
+NET_SOCK_RTN_CODE  NetSock_RxDataFrom (NET_SOCK_ID          sock_id,
+                                       void                *p_data_buf,
+                                       CPU_INT16U           data_buf_len,
+                                       NET_SOCK_API_FLAGS   flags,
+                                       NET_SOCK_ADDR       *p_addr_remote,
+                                       NET_SOCK_ADDR_LEN   *p_addr_len,
+                                       void                *p_ip_opts_buf,
+                                       CPU_INT08U           ip_opts_buf_len,
+                                       CPU_INT08U          *p_ip_opts_len,
+                                       NET_ERR             *p_err)
+{
+    (void)sock_id;
+    (void)p_data_buf;
+    (void)data_buf_len;
+    (void)flags;
+    (void)p_addr_remote;
+    (void)p_addr_len;
+    (void)p_ip_opts_buf;
+    (void)ip_opts_buf_len;
+    (void)p_ip_opts_len;
+
+   *p_err = NET_SOCK_ERR_INVALID_FAMILY;
+
+    return (NET_SOCK_BSD_ERR_RX);
+}
+
+
+NET_SOCK_RTN_CODE  NetSock_TxDataTo (NET_SOCK_ID          sock_id,
+                                     void                *p_data,
+                                     CPU_INT16U           data_len,
+                                     NET_SOCK_API_FLAGS   flags,
+                                     NET_SOCK_ADDR       *p_addr_remote,
+                                     NET_SOCK_ADDR_LEN    addr_len,
+                                     NET_ERR             *p_err)
+{
+    (void)sock_id;
+    (void)p_data;
+    (void)data_len;
+    (void)flags;
+    (void)p_addr_remote;
+    (void)addr_len;
+
+   *p_err = NET_SOCK_ERR_INVALID_FAMILY;
+
+    return (NET_SOCK_BSD_ERR_TX);
+}
+
+
+CPU_BOOLEAN  NetSock_CfgTimeoutRxQ_Set (NET_SOCK_ID   sock_id,
+                                        CPU_INT32U    timeout_ms,
+                                        NET_ERR      *p_err)
+{
+    (void)sock_id;
+    (void)timeout_ms;
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+NET_SOCK_RTN_CODE  NetSock_Sel (NET_SOCK_QTY        sock_nbr_max,
+                                NET_SOCK_DESC      *p_sock_desc_rd,
+                                NET_SOCK_DESC      *p_sock_desc_wr,
+                                NET_SOCK_DESC      *p_sock_desc_err,
+                                NET_SOCK_TIMEOUT   *p_timeout,
+                                NET_ERR            *p_err)
+{
+    (void)sock_nbr_max;
+    (void)p_sock_desc_rd;
+    (void)p_sock_desc_wr;
+    (void)p_sock_desc_err;
+    (void)p_timeout;
+
+   *p_err = NET_SOCK_ERR_INVALID_FAMILY;
+
+    return (-1);
+}
+
+
+void  NetApp_SetSockAddr (NET_SOCK_ADDR         *p_sock_addr,
+                          NET_SOCK_ADDR_FAMILY   addr_family,
+                          NET_PORT_NBR           port_nbr,
+                          CPU_INT08U            *p_addr,
+                          NET_IP_ADDR_LEN        addr_len,
+                          NET_ERR               *p_err)
+{
+    NET_SOCK_ADDR_IPv4  *p_addr_v4;
+    NET_SOCK_ADDR_IPv6  *p_addr_v6;
+
+
+    Mem_Clr(p_sock_addr, sizeof(NET_SOCK_ADDR));
+    p_sock_addr->AddrFamily = addr_family;
+    if (addr_family == NET_SOCK_ADDR_FAMILY_IP_V4) {
+        p_addr_v4       = (NET_SOCK_ADDR_IPv4 *)p_sock_addr;
+        p_addr_v4->Port =  NET_UTIL_HOST_TO_NET_16(port_nbr);
+        Mem_Copy(&p_addr_v4->Addr, p_addr, DEF_MIN(addr_len, sizeof(p_addr_v4->Addr)));
+    } else {
+        p_addr_v6       = (NET_SOCK_ADDR_IPv6 *)p_sock_addr;
+        p_addr_v6->Port =  NET_UTIL_HOST_TO_NET_16(port_nbr);
+        Mem_Copy(&p_addr_v6->Addr, p_addr, DEF_MIN(addr_len, sizeof(p_addr_v6->Addr)));
+    }
+
+   *p_err = NET_APP_ERR_NONE;
+}
+
+
+void  NetASCII_IPv4_to_Str (NET_IPv4_ADDR   addr,
+                            CPU_CHAR       *p_addr_str,
+                            CPU_BOOLEAN     lead_zeros,
+                            NET_ERR        *p_err)
+{
+    (void)lead_zeros;
+
+    (void)sprintf(p_addr_str, "%u.%u.%u.%u",
+                  (unsigned int)((addr >> 24) & 0xFFu),
+                  (unsigned int)((addr >> 16) & 0xFFu),
+                  (unsigned int)((addr >>  8) & 0xFFu),
+                  (unsigned int)( addr        & 0xFFu));
+
+   *p_err = NET_SOCK_ERR_NONE;
+}
+
+
+void  NetASCII_IPv6_to_Str (NET_IPv6_ADDR  *p_addr,
+                            CPU_CHAR       *p_addr_str,
+                            CPU_BOOLEAN     hex_lower_case,
+                            CPU_BOOLEAN     lead_zeros,
+                            NET_ERR        *p_err)
+{
+    CPU_INT08U  i;
+
+
+    (void)hex_lower_case;
+    (void)lead_zeros;
+
+    for (i = 0u; i < 8u; i++) {
+        (void)sprintf(&p_addr_str[i * 5u], (i < 7u) ? "%02x%02x:" : "%02x%02x",
+                      (unsigned int)p_addr->Addr[i * 2u],
+                      (unsigned int)p_addr->Addr[i * 2u + 1u]);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+}
+
+
+NET_TS_MS  NetUtil_TS_Get_ms (void)
+{
+    return ((NET_TS_MS)(CPU_TS_Get64() / 1000000u));
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            FILE SYSTEM
+*
+* Note(s) : (1) See 'doubles.c  Note #3'.  A file opened for writing is created, or truncated if it exists.
+*
+*           (2) Each file counts the opens for reading & the octets read, so that the tests can check how
+*               often the server accesses a file (see 'HostFS_FileStatGet()').
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void  *NetFS_FileOpen (CPU_CHAR            *p_name,
+                       NET_FS_FILE_MODE     mode,
+                       NET_FS_FILE_ACCESS   access)
+{
+    HOST_FS_FILE    *p_file;
+    HOST_FS_FILE    *p_file_free;
+    HOST_FS_HANDLE  *p_handle;
+    CPU_INT32U       ix;
+
+
+    if (strlen(p_name) > HOST_FS_NAME_LEN_MAX) {
+        return (DEF_NULL);
+    }
+
+    p_file      = DEF_NULL;
+    p_file_free = DEF_NULL;
+    for (ix = 0u; ix < HOST_FS_FILE_NBR_MAX; ix++) {
+        if (HostFS_FileTbl[ix].Used == DEF_NO) {
+            if (p_file_free == DEF_NULL) {
+                p_file_free = &HostFS_FileTbl[ix];
+            }
+        } else if (strcmp(HostFS_FileTbl[ix].Name, p_name) == 0) {
+            p_file = &HostFS_FileTbl[ix];
+            break;
+        }
+    }
+
+    if (p_file == DEF_NULL) {
+        if ((mode        != NET_FS_FILE_MODE_CREATE) ||
+            (p_file_free == DEF_NULL)) {
+            return (DEF_NULL);
+        }
+        p_file       = p_file_free;
+        p_file->Used = DEF_YES;
+        (void)strcpy(p_file->Name, p_name);
+    }
+
+    p_handle = DEF_NULL;
+    for (ix = 0u; ix < HOST_FS_HANDLE_NBR_MAX; ix++) {
+        if (HostFS_HandleTbl[ix].FilePtr == DEF_NULL) {
+            p_handle = &HostFS_HandleTbl[ix];
+            break;
+        }
+    }
+    if (p_handle == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    if (access == NET_FS_FILE_ACCESS_WR) {                      /* See Note #1.                                         */
+        p_file->Size = 0u;
+    } else {
+        p_file->OpenCtr++;                                      /* See Note #2.                                         */
+    }
+    p_handle->FilePtr = p_file;
+    p_handle->Pos     = 0u;
+    p_handle->Wr      = (access == NET_FS_FILE_ACCESS_WR) ? DEF_YES : DEF_NO;
+
+    return (p_handle);
+}
+
+
+void  NetFS_FileClose (void  *p_file)
+{
+    HOST_FS_HANDLE  *p_handle;
+
+
+    p_handle          = (HOST_FS_HANDLE *)p_file;
+    p_handle->FilePtr =  DEF_NULL;
+}
+
+
+CPU_BOOLEAN  NetFS_FileRd (void        *p_file,
+                           void        *p_dest,
+                           CPU_SIZE_T   size,
+                           CPU_SIZE_T  *p_size_rd)
+{
+    HOST_FS_HANDLE  *p_handle;
+    HOST_FS_FILE    *p_fs_file;
+
+
+    p_handle   = (HOST_FS_HANDLE *)p_file;
+    p_fs_file  =  p_handle->FilePtr;
+   *p_size_rd  =  0u;
+    if (p_handle->Pos >= p_fs_file->Size) {
+        return (DEF_OK);
+    }
+
+    size = DEF_MIN(size, p_fs_file->Size - p_handle->Pos);
+    memcpy(p_dest, &p_fs_file->DataPtr[p_handle->Pos], size);
+    p_handle->Pos      += size;
+    p_fs_file->RdCtr   += (CPU_INT32U)size;
+   *p_size_rd           = size;
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  NetFS_FileWr (void        *p_file,
+                           void        *p_src,
+                           CPU_SIZE_T   size,
+                           CPU_SIZE_T  *p_size_wr)
+{
+    HOST_FS_HANDLE  *p_handle;
+    HOST_FS_FILE    *p_fs_file;
+    CPU_INT08U      *p_data;
+    CPU_SIZE_T       size_max;
+
+
+    p_handle   = (HOST_FS_HANDLE *)p_file;
+    p_fs_file  =  p_handle->FilePtr;
+   *p_size_wr  =  0u;
+    if (p_handle->Wr == DEF_NO) {
+        return (DEF_FAIL);
+    }
+    if (size == 0u) {
+        return (DEF_OK);
+    }
+
+    if (p_handle->Pos + size > p_fs_file->SizeMax) {            /* Grow data buf.                                       */
+        size_max = DEF_MAX(p_handle->Pos + size, p_fs_file->SizeMax * 2u);
+        p_data   = (CPU_INT08U *)realloc(p_fs_file->DataPtr, size_max);
+        if (p_data == DEF_NULL) {
+            return (DEF_FAIL);
+        }
+        p_fs_file->DataPtr = p_data;
+        p_fs_file->SizeMax = size_max;
+    }
+
+    memcpy(&p_fs_file->DataPtr[p_handle->Pos], p_src, size);
+    p_handle->Pos   += size;
+    p_fs_file->Size  = DEF_MAX(p_fs_file->Size, p_handle->Pos);
+   *p_size_wr        = size;
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  NetFS_FilePosSet (void        *p_file,
+                               CPU_INT32S   offset,
+                               CPU_INT08U   origin)
+{
+    HOST_FS_HANDLE  *p_handle;
+
+
+    p_handle = (HOST_FS_HANDLE *)p_file;
+    if ((origin != NET_FS_SEEK_ORIGIN_START) ||
+        (offset <  0)                        ||
+        ((CPU_SIZE_T)offset > p_handle->FilePtr->Size)) {
+        return (DEF_FAIL);
+    }
+    p_handle->Pos = (CPU_SIZE_T)offset;
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  NetFS_FilePosGet (void        *p_file,
+                               CPU_INT32U  *p_pos)
+{
+    HOST_FS_HANDLE  *p_handle;
+
+
+    p_handle = (HOST_FS_HANDLE *)p_file;
+   *p_pos    = (CPU_INT32U)p_handle->Pos;
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  NetFS_FileSizeGet (void        *p_file,
+                                CPU_INT32U  *p_size)
+{
+    HOST_FS_HANDLE  *p_handle;
+
+
+    p_handle = (HOST_FS_HANDLE *)p_file;
+   *p_size   = (CPU_INT32U)p_handle->FilePtr->Size;
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  HostFS_FileStatGet (const  CPU_CHAR    *p_name,
+                                        CPU_INT32U  *p_open_ctr,
+                                        CPU_INT32U  *p_rd_ctr)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_FS_FILE_NBR_MAX; ix++) {
+        if ((HostFS_FileTbl[ix].Used      == DEF_YES) &&
+            (strcmp(HostFS_FileTbl[ix].Name, p_name) == 0)) {
+           *p_open_ctr = HostFS_FileTbl[ix].OpenCtr;
+           *p_rd_ctr   = HostFS_FileTbl[ix].RdCtr;
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+
+
+void  HostFS_FileStatClr (void)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_FS_FILE_NBR_MAX; ix++) {
+        HostFS_FileTbl[ix].OpenCtr = 0u;
+        HostFS_FileTbl[ix].RdCtr   = 0u;
+    }
+}
+
+
+void  *NetFS_DirOpen (CPU_CHAR  *p_name)
+{
+    (void)p_name;
+
+    return (DEF_NULL);                                          /* NO dirs (see 'doubles.c  Note #3').                  */
+}
+
+
+void  NetFS_DirClose (void  *p_dir)
+{
+    (void)p_dir;
+}
+
+
+CPU_BOOLEAN  NetFS_DirRd (void          *p_dir,
+                          NET_FS_ENTRY  *p_entry)
+{
+    (void)p_dir;
+    (void)p_entry;
+
+    return (DEF_FAIL);
+}
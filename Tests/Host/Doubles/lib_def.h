@@ -0,0 +1,83 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST TEST DOUBLE : STANDARD DEFINES
+*
+* Filename : lib_def.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_DEF_H
+#define  LIB_DEF_H
+
+#include  <cpu.h>
+
+
+#define  DEF_NULL                                 ((void *)0)
+
+#define  DEF_NO                                            0u
+#define  DEF_YES                                           1u
+#define  DEF_FALSE                                         0u
+#define  DEF_TRUE                                          1u
+#define  DEF_OFF                                           0u
+#define  DEF_ON                                            1u
+#define  DEF_DISABLED                                      0u
+#define  DEF_ENABLED                                       1u
+#define  DEF_FAIL                                          0u
+#define  DEF_OK                                            1u
+
+#define  DEF_INT_08U_MAX_VAL                             255u
+#define  DEF_INT_16S_MAX_VAL                           32767
+#define  DEF_INT_16U_MAX_VAL                           65535u
+#define  DEF_INT_32S_MAX_VAL                      2147483647
+#define  DEF_INT_32U_MAX_VAL                      4294967295u
+
+#define  DEF_OCTET_NBR_BITS                                8u
+#define  DEF_OCTET_MASK                                 0xFFu
+
+#define  DEF_NBR_BASE_DEC                                 10u
+
+#define  DEF_TIME_NBR_mS_PER_SEC                        1000u
+#define  DEF_TIME_NBR_uS_PER_SEC                     1000000u
+
+#define  DEF_BIT_NONE                                   0x00u
+#define  DEF_BIT_00                                     0x01u
+#define  DEF_BIT_01                                     0x02u
+#define  DEF_BIT_02                                     0x04u
+#define  DEF_BIT_03                                     0x08u
+#define  DEF_BIT_04                                     0x10u
+#define  DEF_BIT_05                                     0x20u
+#define  DEF_BIT_06                                     0x40u
+#define  DEF_BIT_07                                     0x80u
+#define  DEF_BIT_31                               0x80000000u
+
+#define  DEF_BIT(bit)                             (1u << (bit))
+#define  DEF_BIT_SET(val, mask)                   ((val) |=  (mask))
+#define  DEF_BIT_CLR(val, mask)                   ((val) &= ~(mask))
+#define  DEF_BIT_IS_SET(val, mask)                ((((val) & (mask)) == (mask)) ? DEF_YES : DEF_NO)
+#define  DEF_BIT_IS_CLR(val, mask)                ((((val) & (mask)) ==   0u  ) ? DEF_YES : DEF_NO)
+
+#define  DEF_MIN(a, b)                            (((a) < (b)) ? (a) : (b))
+#define  DEF_MAX(a, b)                            (((a) > (b)) ? (a) : (b))
+
+#define  ASCII_CHAR_NULL                                0x00u
+
+#endif
@@ -0,0 +1,91 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST TEST DOUBLE : MEMORY LIBRARY
+*
+* Filename : lib_mem.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_MEM_H
+#define  LIB_MEM_H
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+#define  LIB_MEM_ERR_NONE                                  0u
+#define  LIB_MEM_ERR_POOL_EMPTY                            1u
+#define  LIB_MEM_ERR_INVALID_BLK_SIZE                      2u
+
+#define  LIB_MEM_BUF_ALIGN_OCTETS                 sizeof(void *)
+
+
+typedef  CPU_INT16U  LIB_ERR;
+
+typedef  struct  mem_seg {
+    CPU_INT08U  Unused;
+} MEM_SEG;
+
+typedef  struct  mem_dyn_pool {
+    CPU_SIZE_T  BlkSize;
+    CPU_SIZE_T  BlkQtyMax;                                      /* Max nbr of blks, 0 for NO limit.                     */
+    CPU_SIZE_T  BlkAllocCnt;
+} MEM_DYN_POOL;
+
+
+void         Mem_Set                  (       void          *p_mem,
+                                              CPU_INT08U     data_val,
+                                              CPU_SIZE_T     size);
+
+void         Mem_Clr                  (       void          *p_mem,
+                                              CPU_SIZE_T     size);
+
+void         Mem_Copy                 (       void          *p_dest,
+                                       const  void          *p_src,
+                                              CPU_SIZE_T     size);
+
+CPU_BOOLEAN  Mem_Cmp                  (const  void          *p1_mem,
+                                       const  void          *p2_mem,
+                                              CPU_SIZE_T     size);
+
+void        *Mem_SegAlloc             (const  CPU_CHAR      *p_name,
+                                              MEM_SEG       *p_seg,
+                                              CPU_SIZE_T     size,
+                                              LIB_ERR       *p_err);
+
+void         Mem_DynPoolCreate        (const  CPU_CHAR      *p_name,
+                                              MEM_DYN_POOL  *p_pool,
+                                              MEM_SEG       *p_seg,
+                                              CPU_SIZE_T     blk_size,
+                                              CPU_SIZE_T     blk_align,
+                                              CPU_SIZE_T     blk_qty_init,
+                                              CPU_SIZE_T     blk_qty_max,
+                                              LIB_ERR       *p_err);
+
+void        *Mem_DynPoolBlkGet        (       MEM_DYN_POOL  *p_pool,
+                                              LIB_ERR       *p_err);
+
+void         Mem_DynPoolBlkFree       (       MEM_DYN_POOL  *p_pool,
+                                              void          *p_blk,
+                                              LIB_ERR       *p_err);
+
+#endif
@@ -0,0 +1,81 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST TEST DOUBLE : STRING LIBRARY
+*
+* Filename : lib_str.h
+* Note(s)  : (1) Stands in for the header of the same name on host builds of the tests, declaring only
+*                what the TFTP server & the tests use (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_STR_H
+#define  LIB_STR_H
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+CPU_SIZE_T   Str_Len            (const  CPU_CHAR     *p_str);
+
+CPU_SIZE_T   Str_Len_N          (const  CPU_CHAR     *p_str,
+                                        CPU_SIZE_T    len_max);
+
+CPU_CHAR    *Str_Copy           (       CPU_CHAR     *p_str_dest,
+                                 const  CPU_CHAR     *p_str_src);
+
+CPU_CHAR    *Str_Copy_N         (       CPU_CHAR     *p_str_dest,
+                                 const  CPU_CHAR     *p_str_src,
+                                        CPU_SIZE_T    len_max);
+
+CPU_CHAR    *Str_Cat            (       CPU_CHAR     *p_str_dest,
+                                 const  CPU_CHAR     *p_str_cat);
+
+CPU_INT16S   Str_Cmp            (const  CPU_CHAR     *p1_str,
+                                 const  CPU_CHAR     *p2_str);
+
+CPU_INT16S   Str_Cmp_N          (const  CPU_CHAR     *p1_str,
+                                 const  CPU_CHAR     *p2_str,
+                                        CPU_SIZE_T    len_max);
+
+CPU_INT16S   Str_CmpIgnoreCase  (const  CPU_CHAR     *p1_str,
+                                 const  CPU_CHAR     *p2_str);
+
+CPU_CHAR    *Str_Char_N         (const  CPU_CHAR     *p_str,
+                                        CPU_SIZE_T    len_max,
+                                        CPU_CHAR      srch_char);
+
+CPU_INT32U   Str_ParseNbr_Int32U(const  CPU_CHAR     *p_str,
+                                        CPU_CHAR    **p_str_next,
+                                        CPU_INT08U    nbr_base);
+
+CPU_CHAR    *Str_FmtNbr_Int32U  (       CPU_INT32U    nbr,
+                                        CPU_INT08U    nbr_dig,
+                                        CPU_INT08U    nbr_base,
+                                        CPU_CHAR      lead_char,
+                                        CPU_BOOLEAN   lower_case,
+                                        CPU_BOOLEAN   nul,
+                                        CPU_CHAR     *p_str);
+
+int          Str_FmtPrint       (       CPU_CHAR     *p_str,
+                                        CPU_SIZE_T    size,
+                                 const  CPU_CHAR     *p_fmt,
+                                                      ...);
+
+#endif
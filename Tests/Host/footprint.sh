@@ -0,0 +1,197 @@
+#!/bin/sh
+#
+#********************************************************************************************************
+#                                              uC/TFTPs
+#                               Trivial File Transfer Protocol (server)
+#
+#                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+#
+#                                 SPDX-License-Identifier: APACHE-2.0
+#
+#               This software is subject to an open source license and is distributed by
+#                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+#                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+#
+#********************************************************************************************************
+#
+#                                   TFTP SERVER FOOTPRINT PROFILES
+#
+# Filename : footprint.sh
+#********************************************************************************************************
+# Note(s)  : (1) Builds the server's sources with each footprint profile of the template configuration (see
+#                'tftp-s_cfg.h  TFTPs MINIMAL FOOTPRINT PROFILES') & prints its footprint, in octets :
+#
+#                    make footprint
+#
+#                (a) Each profile is the template configuration header edited as the profile states, so
+#                    that the figures follow the template.
+#
+#                (b) Only the server's sources are built, against the host test doubles (see 'Doubles') :
+#                    uC/TCP-IP, uC/FS, uC/LIB & the trace function are NOT included.
+#
+#            (2) 'Code' is the text of the objects, & 'Static' their data & bss, as reported by size(1).
+#
+#            (3) 'Stack' is the deepest call chain from TFTPs_Task(), from the stack usage of each function
+#                reported by the compiler (GCC 10 or later, '-fcallgraph-info=su').  Calls through function
+#                pointers & recursion are NOT followed.  The column is '-' when the compiler does NOT
+#                report the call graph.
+#
+#            (4) The heap is NOT a figure of a profile : it is allocated by TFTPs_Init(), as set by the
+#                run-time configuration (see 'tftp-s_cfg.c').
+#********************************************************************************************************
+#
+
+set -e
+
+CC=${CC:-cc}
+SIZE=${SIZE:-size}
+CFLAGS=${CFLAGS:--Os}
+
+HOST=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HOST/../.." && pwd)
+OUT=$HOST/build/footprint
+CFG=$ROOT/Cfg/Template/tftp-s_cfg.h
+
+STACK_FLAGS="-fstack-usage -fcallgraph-info=su"
+
+rm -rf "$OUT"
+mkdir -p "$OUT"
+
+if ! echo 'int x;' | $CC $STACK_FLAGS -x c -c -o "$OUT/probe.o" - 2>/dev/null; then
+    STACK_FLAGS=""                                              # See Note #3.
+fi
+
+
+#********************************************************************************************************
+#                                            cfg_set()
+#
+# Description : Set a '#define' of a profile's configuration header.
+#
+# Argument(s) : $1          Configuration header.
+#               $2          Name of the define.
+#               $3          Value of the define.
+#********************************************************************************************************
+
+cfg_set () {
+    sed -e "s/^\(#define  $2  *\)[^ ]*\( *\)/\1$3\2/" "$1" > "$1.tmp"
+    mv "$1.tmp" "$1"
+}
+
+
+#********************************************************************************************************
+#                                          stack_depth()
+#
+# Description : Print the deepest call chain from TFTPs_Task() of a profile's call graphs (see Note #3).
+#
+# Argument(s) : $1          Directory of the profile's objects.
+#********************************************************************************************************
+
+stack_depth () {
+    if [ -z "$STACK_FLAGS" ]; then
+        echo "-"
+        return
+    fi
+
+    cat "$1"/*.ci | awk '
+        function name_get(title) {
+            sub(/^.*:/, "", title)
+            return (title)
+        }
+        function depth(n,    i, d, best) {
+            if (n in memo) {
+                return (memo[n])
+            }
+            if (n in busy) {
+                return (0)
+            }
+            busy[n] = 1
+            best    = 0
+            for (i = 1; i <= callee_nbr[n]; i++) {
+                d = depth(callee[n, i])
+                if (d > best) {
+                    best = d
+                }
+            }
+            delete busy[n]
+            memo[n] = frame[n] + best
+            return (memo[n])
+        }
+        /^node:/ {
+            split($0, f, "\"")
+            n = name_get(f[2])
+            if (match(f[4], /\\n[0-9]+ bytes/)) {
+                frame[n] = substr(f[4], RSTART + 2, RLENGTH - 8) + 0
+            }
+        }
+        /^edge:/ {
+            split($0, f, "\"")
+            s = name_get(f[2])
+            t = name_get(f[4])
+            if (!((s, t) in edge)) {
+                edge[s, t] = 1
+                callee[s, ++callee_nbr[s]] = t
+            }
+        }
+        END {
+            print depth("TFTPs_Task")
+        }'
+}
+
+
+#********************************************************************************************************
+#                                            profile()
+#
+# Description : Build the server with a profile & print its footprint.
+#
+# Argument(s) : $1          Name of the profile.
+#               $2...       Defines of the profile, as 'NAME=VALUE'.
+#********************************************************************************************************
+
+profile () {
+    name=$1
+    shift
+
+    dir=$OUT/$name
+    mkdir -p "$dir"
+    cp "$CFG" "$dir/tftp-s_cfg.h"
+    for def in "$@"; do
+        cfg_set "$dir/tftp-s_cfg.h" "${def%%=*}" "${def#*=}"
+    done
+
+    for src in "$ROOT"/Source/*.c; do
+        obj=$dir/$(basename "$src" .c).o
+        (cd "$dir" && $CC -std=c99 -Wall -Wextra $CFLAGS $STACK_FLAGS -ffunction-sections -fdata-sections \
+                          -I"$dir" -I"$HOST/Doubles" -I"$ROOT" -I"$ROOT/Source" \
+                          -c -o "$obj" "$src")
+    done
+
+    $SIZE -t "$dir"/*.o | tail -n 1 | {
+        read -r text data bss rest
+        printf "%-14s %8d %8d %8s\n" "$name" "$text" $((data + bss)) "$(stack_depth "$dir")"
+    }
+}
+
+
+#********************************************************************************************************
+#                                             PROFILES
+#
+# Note(s) : (1) See 'tftp-s_cfg.h  TFTPs MINIMAL FOOTPRINT PROFILES  Note #1'.
+#********************************************************************************************************
+
+RD_ONLY="TFTPs_CFG_WR_EN=DEF_DISABLED TFTPs_CFG_WR_WIN_EN=DEF_DISABLED"
+NO_TRACE="TFTPs_TRACE_LEVEL=TRACE_LEVEL_OFF"
+SINGLE="TFTPs_CFG_BUF_SINGLE_EN=DEF_ENABLED TFTPs_CFG_WR_WIN_EN=DEF_DISABLED"
+MINIMAL="TFTPs_CFG_ARG_CHK_EXT_EN=DEF_DISABLED TFTPs_CFG_FS_PROVIDER_EN=DEF_DISABLED \
+         TFTPs_CFG_DIGEST_EN=DEF_DISABLED      TFTPs_CFG_FS_META_EN=DEF_DISABLED     \
+         TFTPs_CFG_FS_HANDLE_EN=DEF_DISABLED   TFTPs_CFG_REWRITE_EN=DEF_DISABLED     \
+         TFTPs_CFG_ACL_EN=DEF_DISABLED         TFTPs_CFG_FS_LZ4_EN=DEF_DISABLED      \
+         TFTPs_CFG_FS_STREAM_EN=DEF_DISABLED   TFTPs_CFG_CAPTURE_EN=DEF_DISABLED     \
+         TFTPs_CFG_PERF_EN=DEF_DISABLED        TFTPs_CFG_TX_BATCH_EN=DEF_DISABLED"
+
+printf "%-14s %8s %8s %8s\n" "Profile" "Code" "Static" "Stack"
+profile  default
+profile  read-only      $RD_ONLY
+profile  no-trace       $NO_TRACE
+profile  single-buffer  $SINGLE
+profile  combined       $RD_ONLY $NO_TRACE $SINGLE
+profile  minimal        $RD_ONLY $NO_TRACE $SINGLE $MINIMAL
@@ -0,0 +1,78 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                               TFTP SERVER CONFIGURATION FOR HOST TESTS
+*
+* Filename : tftp-s_cfg.h
+*********************************************************************************************************
+* Note(s)  : (1) The host tests build the server with the template configuration (see 'Cfg/Template'), with
+*                the network simulation enabled & with the build options of the Makefile, so that the tests
+*                check the configuration shipped.
+*
+*            (2) The performance probes, the trace level & the features below MAY be overridden from the
+*                command line of the compiler, so that the tests & the benchmark run with the footprint
+*                profiles & with the features the template disables (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_HOST_CFG_MODULE_PRESENT
+#define  TFTPs_HOST_CFG_MODULE_PRESENT
+
+#include  "../../Cfg/Template/tftp-s_cfg.h"
+
+
+#undef   TFTPs_CFG_SIM_EN
+#define  TFTPs_CFG_SIM_EN                         DEF_ENABLED
+
+#ifdef   TFTPs_HOST_CFG_PERF_EN                                 /* See Note #2.                                         */
+#undef   TFTPs_CFG_PERF_EN
+#define  TFTPs_CFG_PERF_EN                        TFTPs_HOST_CFG_PERF_EN
+#endif
+
+#ifdef   TFTPs_HOST_CFG_TRACE_LEVEL
+#undef   TFTPs_TRACE_LEVEL
+#define  TFTPs_TRACE_LEVEL                        TFTPs_HOST_CFG_TRACE_LEVEL
+#endif
+
+#ifdef   TFTPs_HOST_CFG_WR_EN
+#undef   TFTPs_CFG_WR_EN
+#define  TFTPs_CFG_WR_EN                          TFTPs_HOST_CFG_WR_EN
+#endif
+
+#ifdef   TFTPs_HOST_CFG_WR_WIN_EN
+#undef   TFTPs_CFG_WR_WIN_EN
+#define  TFTPs_CFG_WR_WIN_EN                      TFTPs_HOST_CFG_WR_WIN_EN
+#endif
+
+#ifdef   TFTPs_HOST_CFG_BUF_SINGLE_EN
+#undef   TFTPs_CFG_BUF_SINGLE_EN
+#define  TFTPs_CFG_BUF_SINGLE_EN                  TFTPs_HOST_CFG_BUF_SINGLE_EN
+#endif
+
+#ifdef   TFTPs_HOST_CFG_FS_LZ4_EN
+#undef   TFTPs_CFG_FS_LZ4_EN
+#define  TFTPs_CFG_FS_LZ4_EN                      TFTPs_HOST_CFG_FS_LZ4_EN
+#endif
+
+#ifdef   TFTPs_HOST_CFG_FS_STREAM_EN
+#undef   TFTPs_CFG_FS_STREAM_EN
+#define  TFTPs_CFG_FS_STREAM_EN                   TFTPs_HOST_CFG_FS_STREAM_EN
+#endif
+
+#endif
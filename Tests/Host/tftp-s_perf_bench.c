@@ -0,0 +1,659 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                 TFTP SERVER PERFORMANCE PROBE BENCHMARK
+*
+* Filename : tftp-s_perf_bench.c
+*********************************************************************************************************
+* Note(s)  : (1) The benchmark measures the probed paths of the server (see 'tftp-s_perf.c') on a fixed
+*                workload of simulation runs (see 'tftp-s_sim.c') : concurrent reads & writes, lockstep &
+*                windowed, a lossy read, requests for missing files & requests of names & options of
+*                varied lengths (see 'LOCAL CONSTANTS').  The workload is run TFTPs_PERF_BENCH_RUN_NBR
+*                times in each batch measured (see Note #3d).  It is built with the probes enabled (see
+*                'tftp-s_cfg.h  Note #2'), once per trace level, so that the cost of a trace is measured at
+*                each level.
+*
+*            (2) The benchmark prints the statistics of each probe, one line per probe, in the format of a
+*                baseline file :
+*
+*                    <probe> <nbr> <cycles tot> <cycles min> <cycles max> <cycles avg> <ns avg> <octets>
+*
+*                Lines starting with '#' are comments.  'make bench-baseline' stores the output of the
+*                build of each trace level as the baseline of that level, 'tftp-s_perf_baseline_<level>.txt'
+*                (see 'Tests/Host/Makefile  Note #2').
+*
+*            (3) Given a baseline file, the benchmark compares each probe to its baseline (see
+*                TFTPs_PerfCmp()), & exits with a non-zero status when a probe is slower than its baseline
+*                by more than TFTPs_PERF_BENCH_TOL & by more than TFTPs_PERF_BENCH_CYCLES_TOL cycles on
+*                average.  'make bench' compares the build of each trace level to the baseline of its level.
+*
+*                (a) On a host, cycles are nanoseconds of the monotonic clock (see 'Doubles/doubles.c'),
+*                    so that a baseline only compares to builds measured on the host that recorded it, as
+*                    noted in its comments.  A baseline SHOULD be recorded again on another host, before
+*                    the change measured.
+*
+*                (b) A probe that measured NO operation, in either statistics, is NOT compared.
+*
+*                (c) Every probe that measured operations is gated.  A probe of a few cycles, e.g. the
+*                    building of a header, is within the resolution of the host clock, & its relative change
+*                    from one run to the next exceeds TFTPs_PERF_BENCH_TOL : it only fails the benchmark
+*                    when it is also slower by TFTPs_PERF_BENCH_CYCLES_TOL cycles.
+*
+*                (d) The statistics of each probe are those of its fastest batch, of up to
+*                    TFTPs_PERF_BENCH_TRY_NBR tries of TFTPs_PERF_BENCH_BATCH_NBR batches (see 'main()
+*                    Note #3').
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+#include  <Source/tftp-s.h>
+#include  <FS/net_fs.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_PERF_EN != DEF_ENABLED)
+#error  "TFTPs_CFG_PERF_EN  illegally #define'd in 'tftp-s_cfg.h' [MUST be DEF_ENABLED for the benchmark]"
+#endif
+
+#define  TFTPs_PERF_BENCH_RUN_NBR                         50u   /* Nbr of runs of the workload per batch.               */
+#define  TFTPs_PERF_BENCH_BATCH_NBR                       10u   /* Nbr of batches per try         (see Note #3d).       */
+#define  TFTPs_PERF_BENCH_TRY_NBR                          5u   /* Max nbr of tries               (see Note #3d).       */
+#define  TFTPs_PERF_BENCH_TIME_MAX                    600000u   /* Max duration (ms) of a run.                          */
+#define  TFTPs_PERF_BENCH_TOL                            250    /* Max slowdown, in 0.1 %         (see Note #3).        */
+#define  TFTPs_PERF_BENCH_CYCLES_TOL                     100    /* Max slowdown, in cycles        (see Note #3c).       */
+#define  TFTPs_PERF_BENCH_LINE_LEN_MAX                   256u
+
+#define  TFTPs_PERF_BENCH_FILE_SIZE                    32768u   /* Size of the files stored       (see Note #3).        */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_CFG   TFTPs_PerfBenchCfg;                         /* Cfg of the server (see 'main()  Note #1').           */
+static  CPU_INT32U  TFTPs_PerfBenchRunCtr;                      /* Nbr of runs of the workload.                         */
+                                                                /* See 'LOCAL CONSTANTS  Note #3'.                      */
+static  CPU_INT08U  TFTPs_PerfBenchFileBuf[TFTPs_PERF_BENCH_FILE_SIZE];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL CONSTANTS
+*
+* Note(s) : (1) See 'tftp-s_sim_test.c  LOCAL CONSTANTS  Note #1'.
+*
+*           (2) The template configuration serves 4 transfers at a time, & keeps the session of a write
+*               for 5 s after its last ACK : the clients that start after 5 s start once the sessions of the
+*               clients before them are free.
+*
+*           (3) The files stored by TFTPs_PerfBenchFileInit() are read & written under names of 1 to 46
+*               characters, with 0 to 3 options, so that the cost of parsing a request varies with the
+*               request.  The requests for missing files are refused with an ERROR packet.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_PERF_BENCH_FILE_NAME_SHORT               "a"
+#define  TFTPs_PERF_BENCH_FILE_NAME_MID                 "img/fw.bin"
+#define  TFTPs_PERF_BENCH_FILE_NAME_LONG                "release/v2/firmware/board-rev-c/image-full.bin"
+#define  TFTPs_PERF_BENCH_FILE_NAME_WR                  "upload/log.txt"
+#define  TFTPs_PERF_BENCH_FILE_NAME_MISSING             "missing"
+#define  TFTPs_PERF_BENCH_FILE_NAME_MISSING_LONG        "no/such/directory/and/a-rather-long-name.bin"
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_PerfBenchClientTbl[] = {
+    { 131072u, DEF_NO,      0u,    0u, 0u, 1000u, 5u, { 5u, 0u,   0u, 0u, 0u, 0u }, DEF_NO,  DEF_NULL, DEF_NULL },
+    { 262144u, DEF_NO,      1u, 1428u, 8u, 1000u, 5u, { 5u, 0u,   0u, 0u, 0u, 0u }, DEF_NO,  DEF_NULL, DEF_NULL },
+    { 131072u, DEF_YES,     2u, 1024u, 8u, 1000u, 5u, { 5u, 0u,   0u, 0u, 0u, 0u }, DEF_NO,  DEF_NULL, DEF_NULL },
+    { 262144u, DEF_NO,      3u, 1024u, 4u,  500u, 8u, { 5u, 2u, 100u, 0u, 0u, 0u }, DEF_NO,  DEF_NULL, DEF_NULL },
+                                                                /* See Note #2.                                         */
+    {  65536u, DEF_YES,  5000u,    0u, 0u, 1000u, 5u, { 5u, 0u,   0u, 0u, 0u, 0u }, DEF_NO,  DEF_NULL, DEF_NULL },
+                                                                /* See Note #3.                                         */
+    {  16384u, DEF_NO,   6000u,    0u, 0u, 1000u, 5u, { 5u, 0u,   0u, 0u, 0u, 0u }, DEF_NO,
+       TFTPs_PERF_BENCH_FILE_NAME_MISSING,      DEF_NULL },
+    {  16384u, DEF_NO,   6001u, 1428u, 8u, 1000u, 5u, { 5u, 0u,   0u, 0u, 0u, 0u }, DEF_YES,
+       TFTPs_PERF_BENCH_FILE_NAME_MISSING_LONG, DEF_NULL },
+    { TFTPs_PERF_BENCH_FILE_SIZE, DEF_NO,  12000u,    0u, 0u, 1000u, 5u, { 5u, 0u, 0u, 0u, 0u, 0u }, DEF_NO,
+       TFTPs_PERF_BENCH_FILE_NAME_SHORT,        &TFTPs_PerfBenchFileBuf[0] },
+    { TFTPs_PERF_BENCH_FILE_SIZE, DEF_NO,  12001u,    0u, 0u, 1000u, 5u, { 5u, 0u, 0u, 0u, 0u, 0u }, DEF_YES,
+       TFTPs_PERF_BENCH_FILE_NAME_MID,          &TFTPs_PerfBenchFileBuf[0] },
+    { TFTPs_PERF_BENCH_FILE_SIZE, DEF_NO,  12002u, 1428u, 0u, 1000u, 5u, { 5u, 0u, 0u, 0u, 0u, 0u }, DEF_YES,
+       TFTPs_PERF_BENCH_FILE_NAME_LONG,         &TFTPs_PerfBenchFileBuf[0] },
+    { TFTPs_PERF_BENCH_FILE_SIZE, DEF_YES, 12003u, 1024u, 8u, 1000u, 5u, { 5u, 0u, 0u, 0u, 0u, 0u }, DEF_YES,
+       TFTPs_PERF_BENCH_FILE_NAME_WR,           &TFTPs_PerfBenchFileBuf[0] }
+};
+
+static  const  TFTPs_SIM_STATUS  TFTPs_PerfBenchStatusTbl[] = {
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_ERR_PKT,                                   /* File NOT found (see Note #3).                        */
+    TFTPs_SIM_STATUS_ERR_PKT,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE
+};
+
+static  const  TFTPs_SIM_SCENARIO  TFTPs_PerfBenchScenario = {
+    TFTPs_PerfBenchClientTbl,
+    sizeof(TFTPs_PerfBenchClientTbl) / sizeof(TFTPs_SIM_CLIENT),
+    0x5EEDu,
+    TFTPs_PERF_BENCH_TIME_MAX
+};
+
+static  const  CPU_CHAR  *TFTPs_PerfBenchFileNameTbl[] = {      /* Files stored (see Note #3).                          */
+    TFTPs_PERF_BENCH_FILE_NAME_SHORT,
+    TFTPs_PERF_BENCH_FILE_NAME_MID,
+    TFTPs_PERF_BENCH_FILE_NAME_LONG
+};
+
+static  const  CPU_CHAR  *TFTPs_PerfBenchProbeNameTbl[TFTPs_PERF_PROBE_NBR] = {
+    "pkt",
+    "req_parse",
+    "hdr_build",
+    "err_build",
+    "ack",
+    "trace"
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchFileInit  (void);
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchMeasure   (       TFTPs_PERF_STAT  *p_stat_tbl);
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchRun       (void);
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchBaselineRd(const  CPU_CHAR         *p_path,
+                                                      TFTPs_PERF_STAT  *p_baseline_tbl);
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchCmp       (const  TFTPs_PERF_STAT  *p_baseline_tbl,
+                                               const  TFTPs_PERF_STAT  *p_stat_tbl,
+                                                      CPU_BOOLEAN       disp);
+
+
+/*
+*********************************************************************************************************
+*                                               main()
+*
+* Description : Run the workload of the benchmark, print the statistics of the probes & compare them to a
+*               baseline.
+*
+* Argument(s) : argc        Number of arguments.
+*
+*               argv        Arguments : path of the baseline file, optional (see 'tftp-s_perf_bench.c
+*                           Note #3').
+*
+* Return(s)   : EXIT_SUCCESS, if the workload ran, & NO probe is slower than its baseline.
+*
+*               EXIT_FAILURE, otherwise.
+*
+* Caller(s)   : Host.
+*
+* Note(s)     : (1) The server is initialized with a copy of the template configuration (see 'tftp-s_cfg.h')
+*                   that simulates all the clients of the workload at once.
+*
+*               (2) A first run of the workload is NOT measured, so that the batches only measure the runs
+*                   of a warm server, whose caches & branch predictors do NOT depend on the code run before.
+*
+*               (3) The batches are measured in up to TFTPs_PERF_BENCH_TRY_NBR tries, each keeping the
+*                   fastest batch of each probe of all tries (see TFTPs_PerfBenchMeasure()) : the speed of a
+*                   host varies over seconds, with the load of the host & of its hypervisor, whereas a
+*                   slower build is slower in every try.  The benchmark stops at the first try that is NOT
+*                   slower than the baseline, & measures a single try to record a baseline.
+*********************************************************************************************************
+*/
+
+int  main (int    argc,
+           char  *argv[])
+{
+    TFTPs_PERF_STAT    stat_tbl[TFTPs_PERF_PROBE_NBR];
+    TFTPs_PERF_STAT    baseline_tbl[TFTPs_PERF_PROBE_NBR];
+    TFTPs_ERR          err;
+    CPU_INT16U         try_nbr;
+    CPU_INT08U         probe;
+    CPU_BOOLEAN        ok;
+
+
+    if (argc > 1) {
+        ok = TFTPs_PerfBenchBaselineRd(argv[1], &baseline_tbl[0]);
+        if (ok != DEF_OK) {
+            fprintf(stderr, "%s : baseline NOT read\n", argv[1]);
+            return (EXIT_FAILURE);
+        }
+    }
+
+    ok = TFTPs_PerfBenchFileInit();
+    if (ok != DEF_OK) {
+        fprintf(stderr, "files NOT stored\n");
+        return (EXIT_FAILURE);
+    }
+
+    TFTPs_PerfBenchCfg                 = TFTPs_Cfg;             /* See Note #1.                                         */
+    TFTPs_PerfBenchCfg.SimClientNbrMax = TFTPs_PerfBenchScenario.ClientNbr;
+
+    (void)TFTPs_Init(&TFTPs_PerfBenchCfg, &TFTPs_TaskCfg, &err);
+    if (err != TFTPs_ERR_NONE) {
+        fprintf(stderr, "TFTPs_Init(), err %u\n", (unsigned)err);
+        return (EXIT_FAILURE);
+    }
+    TFTPs_En();
+
+    ok = TFTPs_PerfBenchRun();                                  /* See Note #2.                                         */
+    if (ok != DEF_OK) {
+        return (EXIT_FAILURE);
+    }
+
+    memset(&stat_tbl[0], 0, sizeof(stat_tbl));
+    for (try_nbr = 1u; try_nbr <= TFTPs_PERF_BENCH_TRY_NBR; try_nbr++) {
+        ok = TFTPs_PerfBenchMeasure(&stat_tbl[0]);              /* See Note #3.                                         */
+        if (ok != DEF_OK) {
+            return (EXIT_FAILURE);
+        }
+        if ((argc < 2) ||
+            (TFTPs_PerfBenchCmp(&baseline_tbl[0], &stat_tbl[0], DEF_NO) == DEF_OK)) {
+            break;
+        }
+    }
+    if (try_nbr > TFTPs_PERF_BENCH_TRY_NBR) {
+        try_nbr = TFTPs_PERF_BENCH_TRY_NBR;
+    }
+
+    printf("# TFTPs performance probes, fastest of %u batches of %u runs, trace level %u\n",
+           (unsigned)(try_nbr * TFTPs_PERF_BENCH_BATCH_NBR),
+           (unsigned)TFTPs_PERF_BENCH_RUN_NBR,
+           (unsigned)TFTPs_TRACE_LEVEL);
+    printf("# probe       nbr   cycles_tot cycles_min cycles_max cycles_avg     ns_avg       octets\n");
+    for (probe = 0u; probe < TFTPs_PERF_PROBE_NBR; probe++) {
+        printf("%-10s %8u %12llu %10u %10u %10u %10u %12llu\n",
+               TFTPs_PerfBenchProbeNameTbl[probe],
+               (unsigned)stat_tbl[probe].Nbr,
+               (unsigned long long)stat_tbl[probe].CyclesTot,
+               (unsigned)stat_tbl[probe].CyclesMin,
+               (unsigned)stat_tbl[probe].CyclesMax,
+               (unsigned)stat_tbl[probe].CyclesAvg,
+               (unsigned)stat_tbl[probe].NsAvg,
+               (unsigned long long)stat_tbl[probe].Octets);
+    }
+
+    if (argc < 2) {
+        return (EXIT_SUCCESS);
+    }
+
+    ok = TFTPs_PerfBenchCmp(&baseline_tbl[0], &stat_tbl[0], DEF_YES);
+
+    return ((ok == DEF_OK) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_PerfBenchFileInit()
+*
+* Description : Store the files read by the clients of the workload.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_OK,   if the files are stored.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) See 'tftp-s_perf_bench.c  LOCAL CONSTANTS  Note #3'.  The files hold the same data, the
+*                   file written by a client included.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchFileInit (void)
+{
+    void         *p_file;
+    CPU_SIZE_T    size_wr;
+    CPU_INT32U    ix;
+    CPU_BOOLEAN   ok;
+
+
+    for (ix = 0u; ix < TFTPs_PERF_BENCH_FILE_SIZE; ix++) {
+        TFTPs_PerfBenchFileBuf[ix] = (CPU_INT08U)((ix * 131u) ^ (ix >> 8));
+    }
+
+    for (ix = 0u; ix < sizeof(TFTPs_PerfBenchFileNameTbl) / sizeof(TFTPs_PerfBenchFileNameTbl[0]); ix++) {
+        p_file = NetFS_FileOpen((CPU_CHAR *)TFTPs_PerfBenchFileNameTbl[ix],
+                                 NET_FS_FILE_MODE_CREATE,
+                                 NET_FS_FILE_ACCESS_WR);
+        if (p_file == DEF_NULL) {
+            return (DEF_FAIL);
+        }
+
+        ok = NetFS_FileWr(p_file, &TFTPs_PerfBenchFileBuf[0], TFTPs_PERF_BENCH_FILE_SIZE, &size_wr);
+        NetFS_FileClose(p_file);
+        if ((ok      != DEF_OK) ||
+            (size_wr != TFTPs_PERF_BENCH_FILE_SIZE)) {
+            return (DEF_FAIL);
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_PerfBenchMeasure()
+*
+* Description : Measure TFTPs_PERF_BENCH_BATCH_NBR batches of runs of the workload.
+*
+* Argument(s) : p_stat_tbl  Pointer to table of the statistics of each probe, that will receive the statistics
+*                           of the batch measured with the lowest average, if lower than its current average.
+*
+* Return(s)   : DEF_OK,   if each run of the workload ended as expected.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The statistics of each probe are cleared before each batch : the preemption of the
+*                   benchmark by the host, or the frequency changes of its CPU, during a batch slow down
+*                   that batch only.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchMeasure (TFTPs_PERF_STAT  *p_stat_tbl)
+{
+    TFTPs_PERF_STAT  batch_tbl[TFTPs_PERF_PROBE_NBR];
+    TFTPs_ERR        err;
+    CPU_INT16U       batch;
+    CPU_INT16U       run;
+    CPU_INT08U       probe;
+    CPU_BOOLEAN      ok;
+
+
+    for (batch = 0u; batch < TFTPs_PERF_BENCH_BATCH_NBR; batch++) {
+        TFTPs_PerfClr(&err);                                    /* See Note #1.                                         */
+        for (run = 0u; run < TFTPs_PERF_BENCH_RUN_NBR; run++) {
+            ok = TFTPs_PerfBenchRun();
+            if (ok != DEF_OK) {
+                return (DEF_FAIL);
+            }
+        }
+
+        TFTPs_PerfGet(&batch_tbl[0], &err);
+        for (probe = 0u; probe < TFTPs_PERF_PROBE_NBR; probe++) {
+            if (batch_tbl[probe].Nbr == 0u) {
+                continue;
+            }
+            if ((p_stat_tbl[probe].Nbr      == 0u) ||
+                (batch_tbl[probe].CyclesAvg < p_stat_tbl[probe].CyclesAvg)) {
+                p_stat_tbl[probe] = batch_tbl[probe];
+            }
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_PerfBenchRun()
+*
+* Description : Run the workload once.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_OK,   if each client ended with the status expected.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main(),
+*               TFTPs_PerfBenchMeasure().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchRun (void)
+{
+    TFTPs_SIM_CLIENT_RESULT  client_result_tbl[sizeof(TFTPs_PerfBenchClientTbl) / sizeof(TFTPs_SIM_CLIENT)];
+    TFTPs_SIM_RESULT         result;
+    TFTPs_ERR                err;
+    CPU_INT16U               ix;
+
+
+    TFTPs_PerfBenchRunCtr++;
+    memset(&result, 0, sizeof(result));
+    result.ClientResultTblPtr = &client_result_tbl[0];
+    TFTPs_SimRun(&TFTPs_PerfBenchScenario, &result, &err);
+    if (err != TFTPs_ERR_NONE) {
+        fprintf(stderr, "run #%u : err %u\n", (unsigned)TFTPs_PerfBenchRunCtr, (unsigned)err);
+        return (DEF_FAIL);
+    }
+
+    for (ix = 0u; ix < TFTPs_PerfBenchScenario.ClientNbr; ix++) {
+        if (client_result_tbl[ix].Status != TFTPs_PerfBenchStatusTbl[ix]) {
+            fprintf(stderr, "run #%u : client #%u status %u, %u expected\n",
+                    (unsigned)TFTPs_PerfBenchRunCtr,
+                    (unsigned)ix,
+                    (unsigned)client_result_tbl[ix].Status,
+                    (unsigned)TFTPs_PerfBenchStatusTbl[ix]);
+            return (DEF_FAIL);
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_PerfBenchBaselineRd()
+*
+* Description : Read the statistics of a baseline file.
+*
+* Argument(s) : p_path          Path of the baseline file.
+*
+*               p_baseline_tbl  Pointer to table of TFTPs_PERF_PROBE_NBR statistics that will receive the
+*                               baseline of each probe, indexed by probe.
+*
+* Return(s)   : DEF_OK,   if the file was read.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) See 'tftp-s_perf_bench.c  Note #2'.  The probes missing from the file keep NO measure,
+*                   & the lines of unknown probes are ignored.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchBaselineRd (const  CPU_CHAR         *p_path,
+                                                       TFTPs_PERF_STAT  *p_baseline_tbl)
+{
+    FILE                *p_file;
+    char                 line[TFTPs_PERF_BENCH_LINE_LEN_MAX];
+    char                 name[TFTPs_PERF_BENCH_LINE_LEN_MAX];
+    unsigned             nbr;
+    unsigned long long   cycles_tot;
+    unsigned             cycles_min;
+    unsigned             cycles_max;
+    unsigned             cycles_avg;
+    unsigned             ns_avg;
+    unsigned long long   octets;
+    CPU_INT08U           probe;
+    int                  field_nbr;
+
+
+    p_file = fopen(p_path, "r");
+    if (p_file == NULL) {
+        return (DEF_FAIL);
+    }
+
+    memset(p_baseline_tbl, 0, TFTPs_PERF_PROBE_NBR * sizeof(TFTPs_PERF_STAT));
+
+    while (fgets(line, sizeof(line), p_file) != NULL) {         /* See Note #1.                                         */
+        if (line[0] == '#') {
+            continue;
+        }
+        field_nbr = sscanf(line, "%255s %u %llu %u %u %u %u %llu",
+                           name,
+                          &nbr,
+                          &cycles_tot,
+                          &cycles_min,
+                          &cycles_max,
+                          &cycles_avg,
+                          &ns_avg,
+                          &octets);
+        if (field_nbr != 8) {
+            continue;
+        }
+
+        for (probe = 0u; probe < TFTPs_PERF_PROBE_NBR; probe++) {
+            if (strcmp(name, TFTPs_PerfBenchProbeNameTbl[probe]) == 0) {
+                p_baseline_tbl[probe].Nbr       = nbr;
+                p_baseline_tbl[probe].CyclesTot = cycles_tot;
+                p_baseline_tbl[probe].CyclesMin = cycles_min;
+                p_baseline_tbl[probe].CyclesMax = cycles_max;
+                p_baseline_tbl[probe].CyclesAvg = cycles_avg;
+                p_baseline_tbl[probe].NsAvg     = ns_avg;
+                p_baseline_tbl[probe].Octets    = octets;
+                break;
+            }
+        }
+    }
+
+    fclose(p_file);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_PerfBenchCmp()
+*
+* Description : Compare the statistics of the probes to their baseline.
+*
+* Argument(s) : p_baseline_tbl  Pointer to table of the baseline of each probe.
+*
+*               p_stat_tbl      Pointer to table of the statistics of each probe.
+*
+*               disp            Print the change of each probe :
+*
+*                                   DEF_YES     Print the change of each probe.
+*                                   DEF_NO      Only compare the probes.
+*
+* Return(s)   : DEF_OK,   if NO probe is slower than its baseline by more than TFTPs_PERF_BENCH_TOL & by more
+*                         than TFTPs_PERF_BENCH_CYCLES_TOL cycles.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) See 'tftp-s_perf_bench.c  Note #3'.
+*
+*               (2) The averages are computed from the total cycles, as by TFTPs_PerfCmp().
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_PerfBenchCmp (const  TFTPs_PERF_STAT  *p_baseline_tbl,
+                                         const  TFTPs_PERF_STAT  *p_stat_tbl,
+                                                CPU_BOOLEAN       disp)
+{
+    CPU_INT32S    change;
+    CPU_INT64S    avg_base;
+    CPU_INT64S    avg_diff;
+    const  char  *p_verdict;
+    TFTPs_ERR     err;
+    CPU_INT08U    probe;
+    CPU_BOOLEAN   ok;
+
+
+    ok = DEF_OK;
+    if (disp == DEF_YES) {
+        printf("# probe      change vs baseline    cycles\n");
+    }
+    for (probe = 0u; probe < TFTPs_PERF_PROBE_NBR; probe++) {
+        change = TFTPs_PerfCmp(&p_baseline_tbl[probe], &p_stat_tbl[probe], &err);
+        if (err != TFTPs_ERR_NONE) {                            /* See Note #1.                                         */
+            if (disp == DEF_YES) {
+                printf("# %-10s n/a\n", TFTPs_PerfBenchProbeNameTbl[probe]);
+            }
+            continue;
+        }
+                                                                /* See Note #2.                                         */
+        avg_base  = (CPU_INT64S)(p_baseline_tbl[probe].CyclesTot / p_baseline_tbl[probe].Nbr);
+        avg_diff  = (CPU_INT64S)(p_stat_tbl[probe].CyclesTot / p_stat_tbl[probe].Nbr) - avg_base;
+        p_verdict = "";
+        if ((change   > TFTPs_PERF_BENCH_TOL) &&                /* See Note #1.                                         */
+            (avg_diff > TFTPs_PERF_BENCH_CYCLES_TOL)) {
+            p_verdict = "  SLOWER";
+            ok        = DEF_FAIL;
+        }
+
+        if (disp == DEF_YES) {
+            printf("# %-10s %+6.1f %%   %+10lld%s\n",
+                   TFTPs_PerfBenchProbeNameTbl[probe],
+                   (double)change / 10.0,
+                   (long long)avg_diff,
+                   p_verdict);
+        }
+    }
+
+    return (ok);
+}
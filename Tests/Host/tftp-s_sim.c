@@ -0,0 +1,2081 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER NETWORK SIMULATION
+*
+* Filename : tftp-s_sim.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) When TFTPs_CFG_SIM_EN is enabled, the network, the time & the files of the server are
+*                simulated, so that its behaviour under latency & losses can be reproduced on a host :
+*
+*                (a) The packets of the server are exchanged with simulated clients over simulated links
+*                    (see Note #3), instead of through the server sockets (see 'tftp-s.c  TFTPs_Rx()' &
+*                    'tftp-s.c  TFTPs_TxPkt()').  The clients reach the first server socket.
+*
+*                (b) The time of the server is a virtual clock, in milliseconds (see TFTPs_TmrNowGet()).
+*                    Instead of waiting for a packet, TFTPs_SimRx() advances the clock to the next event
+*                    of the links & clients, so that a run takes the time needed to compute it, whatever
+*                    the time it simulates.
+*
+*                (c) The files read by the clients are generated by a file provider (see Note #4).  The
+*                    files written by the clients go to the file system.
+*
+*            (2) A run (see TFTPs_SimRun()) is computed in the task calling it, which runs the server loop
+*                until all the clients of the scenario are done.  All the randomness of the links comes
+*                from a pseudo-random generator seeded by the scenario, so that a scenario run again on
+*                the same server configuration gives the same results, e.g. the completion time of a file
+*                read with 1 % of losses & a 50 ms round-trip time.
+*
+*            (3) Each packet sent on a link is lost, duplicated or reordered at the rates of the link of
+*                its client, & delayed by the latency of the link plus a random jitter (see 'tftp-s_type.h
+*                SIMULATED LINK CONFIGURATION DATA TYPE').  Packets in flight are kept in a list ordered
+*                by delivery time, in a pool of 'SimPktNbr' packets; a packet sent while the pool is empty
+*                is dropped.
+*
+*            (4) Client #N reads or writes the file "sim/N", of the size of its scenario entry.  Each octet
+*                of a file is derived from its offset & from the client number, so that the data received by
+*                a client is verified without being stored, & the file written by a client is verified once
+*                its transfer is done.  A client MAY instead read or write a file of its own name & data,
+*                e.g. a file stored by the tests (see 'tftp-s_type.h  SIMULATED CLIENT DATA TYPE  Note #4').
+*
+*            (5) The clients behave as RFC #1350 clients, with the options of RFC #2347 : a client reading
+*                a file sends its read request, acknowledges the last block of each window (see RFC #7440)
+*                & the last block of the file, acknowledges the last block received in order once when a
+*                block is missing, & retransmits its last packet when NO packet is received in time.
+*
+*            (6) A client writing a file sends the blocks of a window in turn, from the block following the
+*                last block acknowledged, & sends the next window when the server acknowledges a block of
+*                the window (see RFC #7440, Section 4 'Traffic Flow and Error Handling').  An ACK of the
+*                last block acknowledged, i.e. of a window whose first block is missing, makes the client
+*                send the window again, once until a block is acknowledged.  The client retransmits its
+*                window when NO ACK is received in time.
+*
+*            (7) This module is NOT re-entrant & MUST only be called from the task running the simulation.
+*
+*            (8) This module is part of the host tests, NOT of the server sources : its directory MUST be
+*                on the include path of the builds enabling TFTPs_CFG_SIM_EN, which link it with the
+*                server (see 'Tests/Host/Makefile').
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPs_SIM_MODULE
+#include  "tftp-s_sim.h"
+#include  "tftp-s_buf.h"
+#include  "tftp-s_tmr.h"
+#include  <Source/net_util.h>
+#include  <FS/net_fs.h>
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            MODULE ENABLE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_SIM_EN == DEF_ENABLED)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_SIM_TIME_NONE                    DEF_INT_32U_MAX_VAL
+
+#define  TFTPs_SIM_DIR_TO_SERVER                           0u   /* Pkt sent by client.                                  */
+#define  TFTPs_SIM_DIR_TO_CLIENT                           1u   /* Pkt sent by server.                                  */
+
+#define  TFTPs_SIM_RATE_SCALE                          10000u   /* Link rates are per 10000 pkts.                       */
+
+#define  TFTPs_SIM_ADDR_BASE                      0x0A000001u   /* Addr of client #0 (10.0.0.1).                        */
+#define  TFTPs_SIM_PORT                                49152u   /* Port of all clients.                                 */
+
+#define  TFTPs_SIM_RUN_GAP                             60000u   /* Idle time (ms) between runs.                         */
+
+#define  TFTPs_SIM_FILE_PREFIX                        "sim/"    /* Prefix of simulated file names (see Note #4).        */
+#define  TFTPs_SIM_FILE_PREFIX_LEN                         4u
+#define  TFTPs_SIM_FILE_IX_LEN_MAX                         5u   /* Max nbr of dig of a client nbr.                      */
+#define  TFTPs_SIM_FILE_NAME_LEN_MAX                      47u   /* Max len of file name of a client.                    */
+
+#define  TFTPs_SIM_CLIENT_BUF_LEN                        128u   /* Len of rd req or ACK kept for re-tx.                 */
+#define  TFTPs_SIM_BLK_SIZE_DFLT                         512u   /* Blk size without OACK (see RFC #1350).               */
+#define  TFTPs_SIM_BLK_SIZE_MIN                            8u   /* See RFC #2348.                                       */
+#define  TFTPs_SIM_BLK_SIZE_MAX                        65464u
+
+#define  TFTPs_SIM_PKT_HDR_SIZE                            4u   /* Opcode & blk nbr.                                    */
+
+#define  TFTPs_SIM_OPCODE_RD_REQ                           1u
+#define  TFTPs_SIM_OPCODE_WR_REQ                           2u
+#define  TFTPs_SIM_OPCODE_DATA                             3u
+#define  TFTPs_SIM_OPCODE_ACK                              4u
+#define  TFTPs_SIM_OPCODE_ERR                              5u
+#define  TFTPs_SIM_OPCODE_OACK                             6u
+
+#define  TFTPs_SIM_OPT_NAME_BLK_SIZE             "blksize"
+#define  TFTPs_SIM_OPT_NAME_WIN_SIZE          "windowsize"
+#define  TFTPs_SIM_OPT_NAME_TSIZE                  "tsize"
+#define  TFTPs_SIM_OPT_VAL_LEN_MAX                         5u
+#define  TFTPs_SIM_OPT_TSIZE_LEN_MAX                      10u
+
+#define  TFTPs_SIM_CLIENT_STATE_IDLE                       0u   /* Req NOT sent yet.                                    */
+#define  TFTPs_SIM_CLIENT_STATE_REQ                        1u   /* Req sent, waiting for OACK, DATA or ACK.             */
+#define  TFTPs_SIM_CLIENT_STATE_DATA                       2u   /* Receiving DATA.                                      */
+#define  TFTPs_SIM_CLIENT_STATE_WR                         3u   /* Sending DATA (see Note #6).                          */
+#define  TFTPs_SIM_CLIENT_STATE_END                        4u   /* Xfer done or failed.                                 */
+
+#define  TFTPs_SIM_FILE_VERIFY_LEN                       256u   /* Nbr of octets of written file verified at a time.    */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       SIMULATED PACKET DATA TYPE
+*
+* Note(s) : (1) Each packet of the pool is followed by 'TFTPs_SimPktLenMax' octets of data.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sim_pkt  TFTPs_SIM_PKT;
+
+struct  tftps_sim_pkt {
+    TFTPs_SIM_PKT  *NextPtr;                                    /* Next pkt in flight, or in free list.                 */
+    CPU_INT32U      TS;                                         /* Delivery time (ms).                                  */
+    CPU_INT16U      ClientIx;                                   /* Client of link.                                      */
+    CPU_INT16U      Len;                                        /* Len of pkt     (see Note #1).                        */
+    CPU_INT08U      Dir;                                        /* TFTPs_SIM_DIR_xx.                                    */
+};
+
+
+/*
+*********************************************************************************************************
+*                                    SIMULATED CLIENT STATE DATA TYPE
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sim_client_state {
+    const  TFTPs_SIM_CLIENT  *CfgPtr;                           /* Client cfg of scenario.                              */
+    CPU_INT08U          State;                                  /* TFTPs_SIM_CLIENT_STATE_xx.                           */
+    TFTPs_SIM_STATUS    Status;                                 /* Status of xfer.                                      */
+    CPU_INT32U          BlkSize;                                /* Negotiated blk size.                                 */
+    CPU_INT32U          WinSize;                                /* Negotiated window size.                              */
+    CPU_INT16U          BlkNext;                                /* Next blk expected.                                   */
+    CPU_INT32U          WinRxNbr;                               /* Nbr of blks rx'd since last ACK.                     */
+    CPU_BOOLEAN         GapAcked;                               /* Missing blk already ACK'd (see Note #5).             */
+    CPU_INT32U          BlkAcked;                               /* Nbr of blks written & ACK'd     (see Note #6).       */
+    CPU_INT32U          BlkSent;                                /* Nbr of blks written & sent      (see Note #6).       */
+    CPU_INT32U          BlkLast;                                /* Nbr of blks of file written.                         */
+    CPU_INT32U          Octets;                                 /* Nbr of file octets rx'd in order, or ACK'd.          */
+    CPU_INT32U          TmrTS;                                  /* Time (ms) of next retransmission.                    */
+    CPU_INT08U          RetryNbr;                               /* Nbr of retransmissions in a row.                     */
+    CPU_INT32U          ReqTS;                                  /* Time (ms) rd req was sent.                           */
+    CPU_INT32U          EndTS;                                  /* Time (ms) xfer ended.                                */
+    CPU_INT32U          PktRxCtr;                               /* Nbr of pkts rx'd from server.                        */
+    CPU_INT32U          PktDupCtr;                              /* Nbr of DATA or ACK pkts rx'd again.                  */
+    CPU_INT32U          RetxCtr;                                /* Nbr of pkts retransmitted.                           */
+    CPU_INT16U          TxLen;                                  /* Len of last pkt sent.                                */
+    CPU_INT08U          TxBuf[TFTPs_SIM_CLIENT_BUF_LEN];        /* Last pkt sent, kept for re-tx.                       */
+} TFTPs_SIM_CLIENT_STATE;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_SIM_CLIENT_STATE  *TFTPs_SimClientTbl;            /* Clients of run.                                      */
+static  CPU_INT16U               TFTPs_SimClientNbrMax;         /* Nbr of client states.                                */
+static  CPU_INT16U               TFTPs_SimClientNbr;            /* Nbr of clients of run.                               */
+static  CPU_INT16U               TFTPs_SimClientEndNbr;         /* Nbr of clients whose xfer ended.                     */
+
+static  CPU_INT08U              *TFTPs_SimPktPoolPtr;           /* Pkts (see 'SIMULATED PACKET DATA TYPE').             */
+static  CPU_SIZE_T               TFTPs_SimPktSize;              /* Size of a pkt, data included.                        */
+static  CPU_INT16U               TFTPs_SimPktNbr;               /* Nbr of pkts in pool.                                 */
+static  CPU_INT16U               TFTPs_SimPktLenMax;            /* Max len of pkt data.                                 */
+static  TFTPs_SIM_PKT           *TFTPs_SimPktFreePtr;           /* Free pkts.                                           */
+static  TFTPs_SIM_PKT           *TFTPs_SimPktHeadPtr;           /* Pkts in flight, by delivery time (see Note #3).      */
+static  CPU_INT08U              *TFTPs_SimDataBufPtr;           /* DATA pkt of writing client being built.              */
+
+static  CPU_INT32U               TFTPs_SimNow;                  /* Virtual clock (ms) (see Note #1b).                   */
+static  CPU_INT32U               TFTPs_SimStartTS;              /* Time (ms) run started.                               */
+static  CPU_INT32U               TFTPs_SimEndTS;                /* Time (ms) run ends at the latest.                    */
+static  CPU_INT32U               TFTPs_SimRandState;            /* Pseudo-random generator state (see Note #2).         */
+
+static  CPU_INT32U               TFTPs_SimPktCtr;               /* Nbr of pkts sent on links.                           */
+static  CPU_INT32U               TFTPs_SimPktLostCtr;           /* Nbr of pkts lost.                                    */
+static  CPU_INT32U               TFTPs_SimPktDupCtr;            /* Nbr of pkts duplicated.                              */
+static  CPU_INT32U               TFTPs_SimPktReorderCtr;        /* Nbr of pkts reordered.                               */
+static  CPU_INT32U               TFTPs_SimPktDropCtr;           /* Nbr of pkts dropped, pool empty.                     */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U    TFTPs_SimRand          (void);
+
+static  CPU_BOOLEAN   TFTPs_SimRandRate      (       CPU_INT16U               rate);
+
+static  void          TFTPs_SimLinkTx        (       CPU_INT16U               client_ix,
+                                                     CPU_INT08U               dir,
+                                              const  CPU_INT08U              *p_pkt,
+                                                     CPU_INT16U               len);
+
+static  void          TFTPs_SimPktQueue      (       CPU_INT16U               client_ix,
+                                                     CPU_INT08U               dir,
+                                                     CPU_INT32U               ts,
+                                              const  CPU_INT08U              *p_pkt,
+                                                     CPU_INT16U               len);
+
+static  void          TFTPs_SimPktFree       (       TFTPs_SIM_PKT           *p_pkt);
+
+static  void          TFTPs_SimClientTmrProcess(void);
+
+static  CPU_INT32U    TFTPs_SimClientTmrNextGet(void);
+
+static  void          TFTPs_SimClientRx      (       CPU_INT16U               client_ix,
+                                              const  CPU_INT08U              *p_pkt,
+                                                     CPU_INT16U               len);
+
+static  void          TFTPs_SimClientDataRx  (       CPU_INT16U               client_ix,
+                                              const  CPU_INT08U              *p_pkt,
+                                                     CPU_INT16U               len);
+
+static  CPU_BOOLEAN   TFTPs_SimClientOptParse(       TFTPs_SIM_CLIENT_STATE  *p_client,
+                                              const  CPU_INT08U              *p_pkt,
+                                                     CPU_INT16U               len);
+
+static  void          TFTPs_SimClientAckRx   (       CPU_INT16U               client_ix,
+                                                     CPU_INT16U               blk_nbr);
+
+static  void          TFTPs_SimClientWinTx   (       CPU_INT16U               client_ix);
+
+static  void          TFTPs_SimClientReqTx   (       CPU_INT16U               client_ix);
+
+static  void          TFTPs_SimClientAckTx   (       CPU_INT16U               client_ix,
+                                                     CPU_INT16U               blk_nbr);
+
+static  void          TFTPs_SimClientEnd     (       TFTPs_SIM_CLIENT_STATE  *p_client,
+                                                     TFTPs_SIM_STATUS         status);
+
+static  CPU_INT08U    TFTPs_SimFileOctetGet  (       CPU_INT16U               client_ix,
+                                                     CPU_INT32U               off);
+
+static  void          TFTPs_SimFileNameGet   (       CPU_INT16U               client_ix,
+                                                     CPU_CHAR                *p_name);
+
+static  CPU_BOOLEAN   TFTPs_SimFileVerify    (       CPU_INT16U               client_ix);
+
+static  CPU_BOOLEAN   TFTPs_SimFileMatch     (const  CPU_CHAR                *p_name);
+
+static  void         *TFTPs_SimFileOpen      (const  CPU_CHAR                *p_name);
+
+static  CPU_BOOLEAN   TFTPs_SimFileRd        (       void                    *p_handle,
+                                                     CPU_INT32U               off,
+                                                     void                    *p_dest,
+                                                     CPU_SIZE_T               size,
+                                                     CPU_SIZE_T              *p_size_rd);
+
+static  CPU_BOOLEAN   TFTPs_SimFileSizeGet   (       void                    *p_handle,
+                                                     CPU_INT32U              *p_size);
+
+static  void          TFTPs_SimFileClose     (       void                    *p_handle);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL CONSTANTS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  TFTPs_FS_PROVIDER  TFTPs_SimFileProvider = {     /* Provider of simulated files (see Note #4).           */
+    TFTPs_SimFileMatch,
+    TFTPs_SimFileOpen,
+    TFTPs_SimFileRd,
+    TFTPs_SimFileSizeGet,
+    TFTPs_SimFileClose
+};
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_SimInit()
+*
+* Description : Allocate the simulated clients & packets, & add the provider of the simulated files.
+*
+* Argument(s) : p_cfg       Pointer to TFTPs Configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_CFG_INVALID_SIM
+*                               TFTPs_ERR_MEM_ALLOC
+*
+*                               -------- RETURNED BY TFTPs_FS_ProviderAdd() ---------
+*                               See TFTPs_FS_ProviderAdd() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_Init().
+*
+* Note(s)     : (1) The packet buffers MUST be initialized first : simulated packets hold the largest packet
+*                   of the server.
+*********************************************************************************************************
+*/
+
+void  TFTPs_SimInit (const  TFTPs_CFG  *p_cfg,
+                            TFTPs_ERR  *p_err)
+{
+    CPU_SIZE_T  len_max;
+    LIB_ERR     err_lib;
+
+
+    TFTPs_SimClientNbrMax = 0u;
+    TFTPs_SimClientNbr    = 0u;
+    TFTPs_SimClientEndNbr = 0u;
+    TFTPs_SimPktNbr       = 0u;
+    TFTPs_SimPktFreePtr   = DEF_NULL;
+    TFTPs_SimPktHeadPtr   = DEF_NULL;
+    TFTPs_SimNow          = 0u;
+
+    if ((p_cfg->SimClientNbrMax == 0u) ||
+        (p_cfg->SimPktNbr       == 0u)) {
+       *p_err = TFTPs_ERR_CFG_INVALID_SIM;
+        return;
+    }
+
+    TFTPs_SimClientTbl = (TFTPs_SIM_CLIENT_STATE *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Sim Clients",
+                                                                            DEF_NULL,
+                                                                (CPU_SIZE_T)p_cfg->SimClientNbrMax *
+                                                                            sizeof(TFTPs_SIM_CLIENT_STATE),
+                                                                           &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+                                                                /* See Note #1.                                         */
+    len_max            =  TFTPs_BufBlkSizeMaxGet() + TFTPs_BUF_HDR_SIZE;
+    TFTPs_SimPktLenMax = (CPU_INT16U)DEF_MIN(len_max, DEF_INT_16U_MAX_VAL);
+    TFTPs_SimPktSize   = (sizeof(TFTPs_SIM_PKT) + TFTPs_SimPktLenMax + sizeof(void *) - 1u) & ~(sizeof(void *) - 1u);
+
+    TFTPs_SimPktPoolPtr = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Sim Pkts",
+                                                                 DEF_NULL,
+                                                     (CPU_SIZE_T)p_cfg->SimPktNbr * TFTPs_SimPktSize,
+                                                                &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_SimDataBufPtr = (CPU_INT08U *)Mem_SegAlloc((CPU_CHAR *)"TFTPs Sim Data Buf",
+                                                                 DEF_NULL,
+                                                                 TFTPs_SimPktLenMax,
+                                                                &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+       *p_err = TFTPs_ERR_MEM_ALLOC;
+        return;
+    }
+
+    TFTPs_FS_ProviderAdd(&TFTPs_SimFileProvider, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        return;
+    }
+
+    TFTPs_SimClientNbrMax = p_cfg->SimClientNbrMax;
+    TFTPs_SimPktNbr       = p_cfg->SimPktNbr;
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SimStart()
+*
+* Description : Start a simulation run.
+*
+* Argument(s) : p_scenario  Pointer to scenario of the run (see 'tftp-s_type.h  SIMULATION SCENARIO DATA
+*                           TYPE').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*                               TFTPs_ERR_SIM_INVALID_SCENARIO
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimRun().
+*
+* Note(s)     : (1) The virtual clock is NOT reset between runs, so that the time stamps kept by the server
+*                   (e.g. by the egress shaper) remain in the past; the times of a run are relative to its
+*                   start.
+*
+*               (2) The pseudo-random generator can NOT be seeded with 0, which is replaced by 1.
+*
+*               (3) A run starts TFTPs_SIM_RUN_GAP ms after the previous run ended, so that every run finds
+*                   the server idle : the timers of the sessions of the previous run expired, its shaping
+*                   buckets are full again & its unused file handles are closed.
+*********************************************************************************************************
+*/
+
+void  TFTPs_SimStart (const  TFTPs_SIM_SCENARIO  *p_scenario,
+                             TFTPs_ERR           *p_err)
+{
+    const  TFTPs_SIM_CLIENT        *p_client_cfg;
+           TFTPs_SIM_CLIENT_STATE  *p_client;
+           TFTPs_SIM_PKT           *p_pkt;
+           CPU_INT16U               ix;
+
+
+    if ((p_scenario->ClientNbr    == 0u)                    ||
+        (p_scenario->ClientNbr     > TFTPs_SimClientNbrMax) ||
+        (p_scenario->ClientTblPtr == DEF_NULL)              ||
+        (p_scenario->TimeMax      == 0u)) {
+       *p_err = TFTPs_ERR_SIM_INVALID_SCENARIO;
+        return;
+    }
+
+    for (ix = 0u; ix < p_scenario->ClientNbr; ix++) {
+        p_client_cfg = &p_scenario->ClientTblPtr[ix];
+        if ((p_client_cfg->Timeout == 0u) ||
+           ((p_client_cfg->BlkSize != 0u) &&
+           ((p_client_cfg->BlkSize  < TFTPs_SIM_BLK_SIZE_MIN) ||
+            (p_client_cfg->BlkSize  > TFTPs_SIM_BLK_SIZE_MAX)))) {
+           *p_err = TFTPs_ERR_SIM_INVALID_SCENARIO;
+            return;
+        }
+        if ((p_client_cfg->FileNamePtr != DEF_NULL) &&
+            (Str_Len_N(p_client_cfg->FileNamePtr, TFTPs_SIM_FILE_NAME_LEN_MAX + 1u) > TFTPs_SIM_FILE_NAME_LEN_MAX)) {
+           *p_err = TFTPs_ERR_SIM_INVALID_SCENARIO;
+            return;
+        }
+    }
+
+    TFTPs_SimPktFreePtr = DEF_NULL;                             /* Free all pkts.                                       */
+    TFTPs_SimPktHeadPtr = DEF_NULL;
+    for (ix = 0u; ix < TFTPs_SimPktNbr; ix++) {
+        p_pkt               = (TFTPs_SIM_PKT *)(TFTPs_SimPktPoolPtr + (ix * TFTPs_SimPktSize));
+        TFTPs_SimPktFree(p_pkt);
+    }
+
+    TFTPs_SimNow      += TFTPs_SIM_RUN_GAP;                     /* See Note #3.                                         */
+    TFTPs_SimStartTS   = TFTPs_SimNow;                          /* See Note #1.                                         */
+    TFTPs_SimEndTS     = TFTPs_SimNow + p_scenario->TimeMax;
+    TFTPs_SimRandState = (p_scenario->Seed != 0u) ? p_scenario->Seed : 1u;
+
+    TFTPs_SimPktCtr        = 0u;
+    TFTPs_SimPktLostCtr    = 0u;
+    TFTPs_SimPktDupCtr     = 0u;
+    TFTPs_SimPktReorderCtr = 0u;
+    TFTPs_SimPktDropCtr    = 0u;
+
+    for (ix = 0u; ix < p_scenario->ClientNbr; ix++) {
+        p_client = &TFTPs_SimClientTbl[ix];
+        Mem_Clr(p_client, sizeof(TFTPs_SIM_CLIENT_STATE));
+        p_client->CfgPtr =  &p_scenario->ClientTblPtr[ix];
+        p_client->State  =   TFTPs_SIM_CLIENT_STATE_IDLE;
+        p_client->Status =   TFTPs_SIM_STATUS_INCOMPLETE;
+        p_client->TmrTS  =   TFTPs_SimStartTS + p_client->CfgPtr->StartTime;
+    }
+    TFTPs_SimClientNbr    = p_scenario->ClientNbr;
+    TFTPs_SimClientEndNbr = 0u;
+
+   *p_err = TFTPs_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SimIsDone()
+*
+* Description : Check whether the simulation run is done.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_YES, if the transfers of all the clients ended, or the run reached its maximum duration.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_Task().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPs_SimIsDone (void)
+{
+    if ((TFTPs_SimClientEndNbr >= TFTPs_SimClientNbr) ||
+        (TFTPs_SimNow          >= TFTPs_SimEndTS)) {
+        return (DEF_YES);
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimResultGet()
+*
+* Description : Get the results of the last simulation run.
+*
+* Argument(s) : p_result    Pointer to variable that will receive the results (see 'tftp-s_type.h
+*                           SIMULATION RESULT DATA TYPES').
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimRun().
+*
+* Note(s)     : (1) The time of a client whose transfer did NOT end runs up to the end of the run.
+*********************************************************************************************************
+*/
+
+void  TFTPs_SimResultGet (TFTPs_SIM_RESULT  *p_result)
+{
+    TFTPs_SIM_CLIENT_STATE   *p_client;
+    TFTPs_SIM_CLIENT_RESULT  *p_client_result;
+    CPU_INT32U                end_ts;
+    CPU_INT32U                time;
+    CPU_INT16U                ix;
+
+
+    p_result->DoneNbr       = 0u;
+    p_result->Time          = 0u;
+    p_result->Octets        = 0u;
+    p_result->Goodput       = 0u;
+    p_result->PktCtr        = TFTPs_SimPktCtr;
+    p_result->PktLostCtr    = TFTPs_SimPktLostCtr;
+    p_result->PktDupCtr     = TFTPs_SimPktDupCtr;
+    p_result->PktReorderCtr = TFTPs_SimPktReorderCtr;
+    p_result->PktDropCtr    = TFTPs_SimPktDropCtr;
+
+    for (ix = 0u; ix < TFTPs_SimClientNbr; ix++) {
+        p_client = &TFTPs_SimClientTbl[ix];
+
+        end_ts   = (p_client->State == TFTPs_SIM_CLIENT_STATE_END) ? p_client->EndTS : TFTPs_SimNow;
+        time     = 0u;
+        if (p_client->State != TFTPs_SIM_CLIENT_STATE_IDLE) {   /* See Note #1.                                         */
+            time = end_ts - p_client->ReqTS;
+        }
+
+        if (p_client->Status == TFTPs_SIM_STATUS_DONE) {
+            p_result->DoneNbr++;
+            if ((end_ts - TFTPs_SimStartTS) > p_result->Time) {
+                p_result->Time = end_ts - TFTPs_SimStartTS;
+            }
+        }
+        p_result->Octets += p_client->Octets;
+
+        if (p_result->ClientResultTblPtr != DEF_NULL) {
+            p_client_result            = &p_result->ClientResultTblPtr[ix];
+            p_client_result->Status    =  p_client->Status;
+            p_client_result->Octets    =  p_client->Octets;
+            p_client_result->Time      =  time;
+            p_client_result->Goodput   =  0u;
+            if (time > 0u) {
+                p_client_result->Goodput = (CPU_INT32U)(((CPU_INT64U)p_client->Octets * DEF_TIME_NBR_mS_PER_SEC) / time);
+            }
+            p_client_result->PktRxCtr  =  p_client->PktRxCtr;
+            p_client_result->PktDupCtr =  p_client->PktDupCtr;
+            p_client_result->RetxCtr   =  p_client->RetxCtr;
+        }
+    }
+
+    if (p_result->Time > 0u) {
+        p_result->Goodput = (CPU_INT32U)(((CPU_INT64U)p_result->Octets * DEF_TIME_NBR_mS_PER_SEC) / p_result->Time);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SimNowGet()
+*
+* Description : Get the time of the virtual clock.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Time of the virtual clock, in milliseconds.
+*
+* Caller(s)   : TFTPs_TmrNowGet().
+*
+* Note(s)     : (1) See 'tftp-s_sim.c  Note #1b'.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  TFTPs_SimNowGet (void)
+{
+    return (TFTPs_SimNow);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            TFTPs_SimRx()
+*
+* Description : Receive the next packet sent by the simulated clients.
+*
+* Argument(s) : timeout_ms  Time to wait for a packet (in milliseconds), or TFTPs_TMR_TIME_INFINITE.
+*
+*               rx_flags    Receive flags :
+*
+*                               NET_SOCK_FLAG_NONE          Wait for a packet.
+*                               NET_SOCK_FLAG_RX_NO_BLOCK   Do NOT wait.
+*
+*               p_addr      Pointer to variable that will receive the address of the client.
+*
+*               p_buf       Pointer to buffer that will receive the packet.
+*
+*               buf_len     Size of the buffer (in octets).
+*
+* Return(s)   : Length of the packet received, if NO error.
+*
+*               NET_SOCK_BSD_ERR_RX,        if NO packet was received in time.
+*
+* Caller(s)   : TFTPs_Rx().
+*
+* Note(s)     : (1) The events due are processed in turn : the timers of the clients, then the packets
+*                   delivered to the clients, which MAY send packets in return, up to the first packet
+*                   delivered to the server.
+*
+*               (2) When NO event is due, the virtual clock is advanced to the next event, or to the end of
+*                   the wait, whichever comes first (see 'tftp-s_sim.c  Note #1b').  A wait is cut short at
+*                   the end of the run.
+*
+*               (3) A packet larger than the buffer is truncated, as by a datagram socket.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  TFTPs_SimRx (CPU_INT32U      timeout_ms,
+                                CPU_INT16S      rx_flags,
+                                NET_SOCK_ADDR  *p_addr,
+                                CPU_INT08U     *p_buf,
+                                CPU_INT16U      buf_len)
+{
+    TFTPs_SIM_PKT       *p_pkt;
+    NET_SOCK_ADDR_IPv4  *p_addr_v4;
+    CPU_INT32U           ts_end;
+    CPU_INT32U           ts_next;
+    CPU_INT32U           ts_tmr;
+    CPU_INT16U           len;
+
+
+    ts_end = TFTPs_SimEndTS;
+    if ((timeout_ms                  != TFTPs_TMR_TIME_INFINITE) &&
+        ((TFTPs_SimEndTS - TFTPs_SimNow) > timeout_ms)) {
+        ts_end = TFTPs_SimNow + timeout_ms;
+    }
+
+    while (DEF_ON) {
+        TFTPs_SimClientTmrProcess();                            /* See Note #1.                                         */
+
+        while ((TFTPs_SimPktHeadPtr     != DEF_NULL) &&
+               (TFTPs_SimPktHeadPtr->TS <= TFTPs_SimNow)) {
+            p_pkt               = TFTPs_SimPktHeadPtr;
+            TFTPs_SimPktHeadPtr = p_pkt->NextPtr;
+
+            if (p_pkt->Dir == TFTPs_SIM_DIR_TO_CLIENT) {
+                TFTPs_SimClientRx(p_pkt->ClientIx, (CPU_INT08U *)(p_pkt + 1), p_pkt->Len);
+                TFTPs_SimPktFree(p_pkt);
+                continue;
+            }
+
+            len = DEF_MIN(p_pkt->Len, buf_len);                 /* See Note #3.                                         */
+            Mem_Copy(p_buf, (CPU_INT08U *)(p_pkt + 1), len);
+
+            Mem_Clr(p_addr, sizeof(NET_SOCK_ADDR));
+            p_addr_v4             = (NET_SOCK_ADDR_IPv4 *)p_addr;
+            p_addr_v4->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V4;
+            p_addr_v4->Port       =  NET_UTIL_HOST_TO_NET_16(TFTPs_SIM_PORT);
+            p_addr_v4->Addr       =  NET_UTIL_HOST_TO_NET_32(TFTPs_SIM_ADDR_BASE + p_pkt->ClientIx);
+
+            TFTPs_SimPktFree(p_pkt);
+            return ((NET_SOCK_RTN_CODE)len);
+        }
+
+        if ((rx_flags == NET_SOCK_FLAG_RX_NO_BLOCK) ||
+            (TFTPs_SimNow >= ts_end)) {
+            return (NET_SOCK_BSD_ERR_RX);
+        }
+                                                                /* Advance to next event (see Note #2).                 */
+        ts_next = ts_end;
+        if ((TFTPs_SimPktHeadPtr     != DEF_NULL) &&
+            (TFTPs_SimPktHeadPtr->TS  < ts_next)) {
+            ts_next = TFTPs_SimPktHeadPtr->TS;
+        }
+        ts_tmr = TFTPs_SimClientTmrNextGet();
+        if (ts_tmr < ts_next) {
+            ts_next = ts_tmr;
+        }
+        TFTPs_SimNow = ts_next;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            TFTPs_SimTx()
+*
+* Description : Send a packet of the server to a simulated client.
+*
+* Argument(s) : p_addr      Pointer to socket address of the client.
+*
+*               p_pkt       Pointer to packet to send.
+*
+*               len         Length of the packet (in octets).
+*
+* Return(s)   : Number of octets sent.
+*
+* Caller(s)   : TFTPs_TxPkt().
+*
+* Note(s)     : (1) A packet sent to an address of NO client is lost, as on a network.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  TFTPs_SimTx (       NET_SOCK_ADDR  *p_addr,
+                                const  CPU_INT08U     *p_pkt,
+                                       CPU_INT16U      len)
+{
+    NET_SOCK_ADDR_IPv4  *p_addr_v4;
+    CPU_INT32U           client_ix;
+
+
+    if (p_addr->AddrFamily != NET_SOCK_ADDR_FAMILY_IP_V4) {     /* See Note #1.                                         */
+        return ((NET_SOCK_RTN_CODE)len);
+    }
+
+    p_addr_v4 = (NET_SOCK_ADDR_IPv4 *)p_addr;
+    client_ix =  NET_UTIL_NET_TO_HOST_32(p_addr_v4->Addr) - TFTPs_SIM_ADDR_BASE;
+    if (client_ix >= TFTPs_SimClientNbr) {
+        return ((NET_SOCK_RTN_CODE)len);
+    }
+
+    TFTPs_SimLinkTx((CPU_INT16U)client_ix, TFTPs_SIM_DIR_TO_CLIENT, p_pkt, len);
+
+    return ((NET_SOCK_RTN_CODE)len);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           TFTPs_SimRand()
+*
+* Description : Get the next number of the pseudo-random generator.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Pseudo-random number.
+*
+* Caller(s)   : TFTPs_SimRandRate(),
+*               TFTPs_SimLinkTx().
+*
+* Note(s)     : (1) The generator is a 32-bit xorshift generator (see Marsaglia, "Xorshift RNGs"), whose
+*                   state MUST NOT be 0.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_SimRand (void)
+{
+    CPU_INT32U  x;
+
+
+    x                  = TFTPs_SimRandState;                    /* See Note #1.                                         */
+    x                 ^= x << 13;
+    x                 ^= x >> 17;
+    x                 ^= x <<  5;
+    TFTPs_SimRandState = x;
+
+    return (x);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SimRandRate()
+*
+* Description : Draw whether an event of a rate happens.
+*
+* Argument(s) : rate        Rate of the event, per TFTPs_SIM_RATE_SCALE.
+*
+* Return(s)   : DEF_YES, if the event happens.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_SimLinkTx().
+*
+* Note(s)     : (1) NO number is drawn for a null rate, so that the events of a link NOT enabled do NOT
+*                   change the draws of the other events.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimRandRate (CPU_INT16U  rate)
+{
+    if (rate == 0u) {                                           /* See Note #1.                                         */
+        return (DEF_NO);
+    }
+
+    if ((TFTPs_SimRand() % TFTPs_SIM_RATE_SCALE) < rate) {
+        return (DEF_YES);
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SimLinkTx()
+*
+* Description : Send a packet on the link of a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+*               dir         Direction of the packet (TFTPs_SIM_DIR_xx).
+*
+*               p_pkt       Pointer to packet to send.
+*
+*               len         Length of the packet (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimTx(),
+*               TFTPs_SimClientTmrProcess(),
+*               TFTPs_SimClientRx(),
+*               TFTPs_SimClientWinTx(),
+*               TFTPs_SimClientReqTx(),
+*               TFTPs_SimClientAckTx().
+*
+* Note(s)     : (1) See 'tftp-s_sim.c  Note #3'.  Each copy of a duplicated packet is delayed & MAY be
+*                   reordered independently.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimLinkTx (       CPU_INT16U   client_ix,
+                                      CPU_INT08U   dir,
+                               const  CPU_INT08U  *p_pkt,
+                                      CPU_INT16U   len)
+{
+    const  TFTPs_SIM_LINK  *p_link;
+           CPU_INT08U       copy_nbr;
+           CPU_INT08U       i;
+           CPU_INT32U       dly;
+
+
+    p_link = &TFTPs_SimClientTbl[client_ix].CfgPtr->Link;
+
+    TFTPs_SimPktCtr++;
+    if (TFTPs_SimRandRate(p_link->LossRate) == DEF_YES) {
+        TFTPs_SimPktLostCtr++;
+        return;
+    }
+
+    copy_nbr = 1u;
+    if (TFTPs_SimRandRate(p_link->DupRate) == DEF_YES) {
+        TFTPs_SimPktDupCtr++;
+        copy_nbr = 2u;
+    }
+
+    for (i = 0u; i < copy_nbr; i++) {                           /* See Note #1.                                         */
+        dly = p_link->Dly;
+        if (p_link->Jitter > 0u) {
+            dly += TFTPs_SimRand() % (p_link->Jitter + 1u);
+        }
+        if (TFTPs_SimRandRate(p_link->ReorderRate) == DEF_YES) {
+            TFTPs_SimPktReorderCtr++;
+            dly += p_link->ReorderDly;
+        }
+
+        TFTPs_SimPktQueue(client_ix, dir, TFTPs_SimNow + dly, p_pkt, len);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SimPktQueue()
+*
+* Description : Put a packet in flight.
+*
+* Argument(s) : client_ix   Index of the client of the link.
+*
+*               dir         Direction of the packet (TFTPs_SIM_DIR_xx).
+*
+*               ts          Delivery time of the packet (ms).
+*
+*               p_pkt       Pointer to packet.
+*
+*               len         Length of the packet (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimLinkTx().
+*
+* Note(s)     : (1) A packet is inserted after the packets of the same delivery time, so that packets sent
+*                   with the same delay are delivered in order.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimPktQueue (       CPU_INT16U   client_ix,
+                                        CPU_INT08U   dir,
+                                        CPU_INT32U   ts,
+                                 const  CPU_INT08U  *p_pkt,
+                                        CPU_INT16U   len)
+{
+    TFTPs_SIM_PKT   *p_pkt_new;
+    TFTPs_SIM_PKT  **pp_pkt;
+
+
+    p_pkt_new = TFTPs_SimPktFreePtr;
+    if ((p_pkt_new == DEF_NULL) ||                              /* Drop pkt if NO pkt free (see 'tftp-s_sim.c  Note #3')*/
+        (len        > TFTPs_SimPktLenMax)) {
+        TFTPs_SimPktDropCtr++;
+        return;
+    }
+    TFTPs_SimPktFreePtr = p_pkt_new->NextPtr;
+
+    p_pkt_new->TS       = ts;
+    p_pkt_new->ClientIx = client_ix;
+    p_pkt_new->Dir      = dir;
+    p_pkt_new->Len      = len;
+    Mem_Copy((CPU_INT08U *)(p_pkt_new + 1), p_pkt, len);
+
+    pp_pkt = &TFTPs_SimPktHeadPtr;                              /* See Note #1.                                         */
+    while ((*pp_pkt      != DEF_NULL) &&
+           ((*pp_pkt)->TS <= ts)) {
+        pp_pkt = &(*pp_pkt)->NextPtr;
+    }
+    p_pkt_new->NextPtr = *pp_pkt;
+   *pp_pkt             =  p_pkt_new;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SimPktFree()
+*
+* Description : Return a packet to the pool.
+*
+* Argument(s) : p_pkt       Pointer to packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimStart(),
+*               TFTPs_SimRx().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimPktFree (TFTPs_SIM_PKT  *p_pkt)
+{
+    p_pkt->NextPtr      = TFTPs_SimPktFreePtr;
+    TFTPs_SimPktFreePtr = p_pkt;
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_SimClientTmrProcess()
+*
+* Description : Service the expired timers of the clients.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimRx().
+*
+* Note(s)     : (1) A client whose request is due sends it; a client waiting for the server retransmits its
+*                   last packet, or its window when writing, or gives up after 'RetryMax' retransmissions in
+*                   a row (see 'tftp-s_type.h  SIMULATED CLIENT DATA TYPE  Note #3').
+*
+*               (2) After a retransmission, the blocks of the window are counted again from the block
+*                   acknowledged, & a missing block MAY be acknowledged again.
+*
+*               (3) A client receiving data acknowledges the last block received in order, rather than its
+*                   last ACK, so that a server sending fewer blocks than the window goes on from that block
+*                   (see RFC #7440, Section 4 'Traffic Flow and Error Handling').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientTmrProcess (void)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+    CPU_INT16U               ix;
+
+
+    for (ix = 0u; ix < TFTPs_SimClientNbr; ix++) {
+        p_client = &TFTPs_SimClientTbl[ix];
+        if (p_client->TmrTS > TFTPs_SimNow) {
+            continue;
+        }
+
+        switch (p_client->State) {                              /* See Note #1.                                         */
+            case TFTPs_SIM_CLIENT_STATE_IDLE:
+                 TFTPs_SimClientReqTx(ix);
+                 break;
+
+            case TFTPs_SIM_CLIENT_STATE_REQ:
+            case TFTPs_SIM_CLIENT_STATE_DATA:
+                 if (p_client->RetryNbr >= p_client->CfgPtr->RetryMax) {
+                     TFTPs_SimClientEnd(p_client, TFTPs_SIM_STATUS_TIMEOUT);
+                     break;
+                 }
+                 p_client->RetryNbr++;
+                 p_client->RetxCtr++;
+                 p_client->WinRxNbr = 0u;                       /* See Note #2.                                         */
+                 p_client->GapAcked = DEF_NO;
+                 p_client->TmrTS    = TFTPs_SimNow + p_client->CfgPtr->Timeout;
+                                                                /* See Note #3.                                         */
+                 if (p_client->State == TFTPs_SIM_CLIENT_STATE_DATA) {
+                     TFTPs_SimClientAckTx(ix, (CPU_INT16U)(p_client->BlkNext - 1u));
+                 } else {
+                     TFTPs_SimLinkTx(ix, TFTPs_SIM_DIR_TO_SERVER, &p_client->TxBuf[0], p_client->TxLen);
+                 }
+                 break;
+
+            case TFTPs_SIM_CLIENT_STATE_WR:
+                 if (p_client->RetryNbr >= p_client->CfgPtr->RetryMax) {
+                     TFTPs_SimClientEnd(p_client, TFTPs_SIM_STATUS_TIMEOUT);
+                     break;
+                 }
+                 p_client->RetryNbr++;
+                 p_client->RetxCtr++;
+                 p_client->GapAcked = DEF_NO;
+                 TFTPs_SimClientWinTx(ix);
+                 break;
+
+            default:
+                 p_client->TmrTS = TFTPs_SIM_TIME_NONE;
+                 break;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_SimClientTmrNextGet()
+*
+* Description : Get the time of the next client timer expiry.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Time of the next expiry (ms), or TFTPs_SIM_TIME_NONE.
+*
+* Caller(s)   : TFTPs_SimRx().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_SimClientTmrNextGet (void)
+{
+    CPU_INT32U  ts_next;
+    CPU_INT16U  ix;
+
+
+    ts_next = TFTPs_SIM_TIME_NONE;
+    for (ix = 0u; ix < TFTPs_SimClientNbr; ix++) {
+        if (TFTPs_SimClientTbl[ix].TmrTS < ts_next) {
+            ts_next = TFTPs_SimClientTbl[ix].TmrTS;
+        }
+    }
+
+    return (ts_next);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SimClientRx()
+*
+* Description : Process a packet delivered to a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+*               p_pkt       Pointer to packet.
+*
+*               len         Length of the packet (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimRx().
+*
+* Note(s)     : (1) A client that received the last block acknowledges it again when the server sends it
+*                   again, i.e. when its final ACK was lost.
+*
+*               (2) An OACK sent again, when the ACK of block 0 was lost, is acknowledged again.  An OACK
+*                   sent again to a client writing a file, when block 1 was lost, acknowledges block 0.
+*
+*               (3) See RFC #1350, Section 7 'Error Packets'.
+*
+*               (4) An ACK of block 0 answering the write request means that the server ignored the options
+*                   requested (see RFC #2347, 'Negotiation Protocol').
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientRx (       CPU_INT16U   client_ix,
+                                 const  CPU_INT08U  *p_pkt,
+                                        CPU_INT16U   len)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+    CPU_INT16U               opcode;
+    CPU_INT16U               blk_nbr;
+    CPU_BOOLEAN              ok;
+
+
+    p_client = &TFTPs_SimClientTbl[client_ix];
+    p_client->PktRxCtr++;
+    if (len < TFTPs_SIM_PKT_HDR_SIZE) {
+        return;
+    }
+
+    opcode  = (CPU_INT16U)(((CPU_INT16U)p_pkt[0] << 8) | p_pkt[1]);
+    blk_nbr = (CPU_INT16U)(((CPU_INT16U)p_pkt[2] << 8) | p_pkt[3]);
+
+    switch (p_client->State) {
+        case TFTPs_SIM_CLIENT_STATE_REQ:
+        case TFTPs_SIM_CLIENT_STATE_DATA:
+        case TFTPs_SIM_CLIENT_STATE_WR:
+             break;
+
+        case TFTPs_SIM_CLIENT_STATE_END:                        /* See Note #1.                                         */
+             if ((p_client->Status == TFTPs_SIM_STATUS_DONE)          &&
+                 (opcode           == TFTPs_SIM_OPCODE_DATA)          &&
+                 (blk_nbr          == (CPU_INT16U)(p_client->BlkNext - 1u))) {
+                 p_client->PktDupCtr++;
+                 TFTPs_SimLinkTx(client_ix, TFTPs_SIM_DIR_TO_SERVER, &p_client->TxBuf[0], p_client->TxLen);
+             }
+             return;
+
+        default:
+             return;
+    }
+
+    switch (opcode) {
+        case TFTPs_SIM_OPCODE_OACK:
+             if (p_client->State == TFTPs_SIM_CLIENT_STATE_REQ) {
+                 ok = TFTPs_SimClientOptParse(p_client, p_pkt, len);
+                 if (ok != DEF_OK) {
+                     TFTPs_SimClientEnd(p_client, TFTPs_SIM_STATUS_ERR_DATA);
+
+                 } else if (p_client->CfgPtr->Wr == DEF_YES) {
+                     p_client->State   = TFTPs_SIM_CLIENT_STATE_WR;
+                     p_client->BlkLast = (p_client->CfgPtr->FileSize / p_client->BlkSize) + 1u;
+                     TFTPs_SimClientWinTx(client_ix);
+
+                 } else {
+                     p_client->State   = TFTPs_SIM_CLIENT_STATE_DATA;
+                     p_client->BlkNext = 1u;
+                     TFTPs_SimClientAckTx(client_ix, 0u);
+                 }
+
+             } else if (p_client->State == TFTPs_SIM_CLIENT_STATE_WR) {
+                 if (p_client->BlkAcked == 0u) {                /* See Note #2.                                         */
+                     TFTPs_SimClientAckRx(client_ix, 0u);
+                 }
+
+             } else if (p_client->BlkNext == 1u) {              /* See Note #2.                                         */
+                 TFTPs_SimLinkTx(client_ix, TFTPs_SIM_DIR_TO_SERVER, &p_client->TxBuf[0], p_client->TxLen);
+             }
+             break;
+
+
+        case TFTPs_SIM_OPCODE_ACK:
+             if ((p_client->State      == TFTPs_SIM_CLIENT_STATE_REQ) &&
+                 (p_client->CfgPtr->Wr == DEF_YES)                    &&
+                 (blk_nbr              == 0u)) {                /* See Note #4.                                         */
+                 p_client->State   = TFTPs_SIM_CLIENT_STATE_WR;
+                 p_client->BlkSize = TFTPs_SIM_BLK_SIZE_DFLT;
+                 p_client->WinSize = 1u;
+                 p_client->BlkLast = (p_client->CfgPtr->FileSize / p_client->BlkSize) + 1u;
+                 TFTPs_SimClientWinTx(client_ix);
+
+             } else if (p_client->State == TFTPs_SIM_CLIENT_STATE_WR) {
+                 TFTPs_SimClientAckRx(client_ix, blk_nbr);
+             }
+             break;
+
+
+        case TFTPs_SIM_OPCODE_DATA:
+             if (p_client->CfgPtr->Wr == DEF_NO) {
+                 TFTPs_SimClientDataRx(client_ix, p_pkt, len);
+             }
+             break;
+
+
+        case TFTPs_SIM_OPCODE_ERR:                              /* See Note #3.                                         */
+             TFTPs_SimClientEnd(p_client, TFTPs_SIM_STATUS_ERR_PKT);
+             break;
+
+
+        default:
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimClientDataRx()
+*
+* Description : Process a DATA packet delivered to a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+*               p_pkt       Pointer to packet.
+*
+*               len         Length of the packet (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimClientRx().
+*
+* Note(s)     : (1) A DATA packet answering the read request means that the server ignored the options
+*                   requested (see RFC #2347, 'Negotiation Protocol').
+*
+*               (2) The blocks received are acknowledged as stated in RFC #7440, Section 4 'Traffic Flow
+*                   and Error Handling' : the last block of each window, & the last block received in order
+*                   when a block is missing.  A missing block is acknowledged once, until a block is
+*                   received in order again, so that the blocks of the window that follow it do NOT each
+*                   make the server go back.
+*
+*               (3) A block shorter than the block size ends the transfer (see RFC #1350, Section 6 'Normal
+*                   Termination').
+*
+*               (4) A block larger than the block size, or running past the end of the file, is an error.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientDataRx (       CPU_INT16U   client_ix,
+                                     const  CPU_INT08U  *p_pkt,
+                                            CPU_INT16U   len)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+    CPU_INT16U               blk_nbr;
+    CPU_INT16U               data_len;
+    CPU_INT16U               i;
+
+
+    p_client = &TFTPs_SimClientTbl[client_ix];
+    if (p_client->State == TFTPs_SIM_CLIENT_STATE_REQ) {        /* See Note #1.                                         */
+        p_client->State   = TFTPs_SIM_CLIENT_STATE_DATA;
+        p_client->BlkSize = TFTPs_SIM_BLK_SIZE_DFLT;
+        p_client->WinSize = 1u;
+        p_client->BlkNext = 1u;
+    }
+
+    blk_nbr  = (CPU_INT16U)(((CPU_INT16U)p_pkt[2] << 8) | p_pkt[3]);
+    data_len = len - TFTPs_SIM_PKT_HDR_SIZE;
+
+    if (blk_nbr != p_client->BlkNext) {
+        if ((CPU_INT16U)(blk_nbr - p_client->BlkNext) < 0x8000u) {
+            if (p_client->GapAcked == DEF_NO) {                 /* Blk missing (see Note #2).                           */
+                p_client->GapAcked = DEF_YES;
+                TFTPs_SimClientAckTx(client_ix, (CPU_INT16U)(p_client->BlkNext - 1u));
+            }
+        } else {
+            p_client->PktDupCtr++;                              /* Blk rx'd again.                                      */
+        }
+        return;
+    }
+
+    if ((data_len > p_client->BlkSize) ||                       /* See Note #4.                                         */
+        (data_len > p_client->CfgPtr->FileSize - p_client->Octets)) {
+        TFTPs_SimClientEnd(p_client, TFTPs_SIM_STATUS_ERR_DATA);
+        return;
+    }
+
+    for (i = 0u; i < data_len; i++) {                           /* Verify data (see 'tftp-s_sim.c  Note #4').           */
+        if (p_pkt[TFTPs_SIM_PKT_HDR_SIZE + i] != TFTPs_SimFileOctetGet(client_ix, p_client->Octets + i)) {
+            TFTPs_SimClientEnd(p_client, TFTPs_SIM_STATUS_ERR_DATA);
+            return;
+        }
+    }
+
+    p_client->Octets  += data_len;
+    p_client->BlkNext++;
+    p_client->WinRxNbr++;
+    p_client->GapAcked = DEF_NO;
+    p_client->RetryNbr = 0u;
+    p_client->TmrTS    = TFTPs_SimNow + p_client->CfgPtr->Timeout;
+
+    if (data_len < p_client->BlkSize) {                         /* Last blk (see Note #3).                              */
+        TFTPs_SimClientAckTx(client_ix, blk_nbr);
+        TFTPs_SimClientEnd(p_client, TFTPs_SIM_STATUS_DONE);
+
+    } else if (p_client->WinRxNbr >= p_client->WinSize) {       /* Last blk of window (see Note #2).                    */
+        TFTPs_SimClientAckTx(client_ix, blk_nbr);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimClientOptParse()
+*
+* Description : Get the options granted by the OACK delivered to a client.
+*
+* Argument(s) : p_client    Pointer to client.
+*
+*               p_pkt       Pointer to OACK packet.
+*
+*               len         Length of the packet (in octets).
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, if the transfer size granted for a file read is NOT the size of the file.
+*
+* Caller(s)   : TFTPs_SimClientRx().
+*
+* Note(s)     : (1) Options NOT granted keep their default value (see RFC #2347, 'Negotiation Protocol').
+*
+*               (2) An option string NOT terminated within the packet ends the parsing.
+*
+*               (3) The transfer size of a file read is the size of the file (see RFC #2349).
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimClientOptParse (       TFTPs_SIM_CLIENT_STATE  *p_client,
+                                              const  CPU_INT08U              *p_pkt,
+                                                     CPU_INT16U               len)
+{
+    const  CPU_CHAR    *p_name;
+    const  CPU_CHAR    *p_val;
+           CPU_INT16U   off;
+           CPU_INT16U   off_val;
+           CPU_INT32U   tsize;
+
+
+    p_client->BlkSize = TFTPs_SIM_BLK_SIZE_DFLT;                /* See Note #1.                                         */
+    p_client->WinSize = 1u;
+
+    off = 2u;
+    while (off < len) {
+        p_name  = (const CPU_CHAR *)&p_pkt[off];
+        off_val =  off + (CPU_INT16U)Str_Len_N(p_name, len - off) + 1u;
+        if (off_val >= len) {                                   /* See Note #2.                                         */
+            break;
+        }
+        p_val   = (const CPU_CHAR *)&p_pkt[off_val];
+        off     =  off_val + (CPU_INT16U)Str_Len_N(p_val, len - off_val) + 1u;
+        if (off > len) {
+            break;
+        }
+
+        if (Str_Cmp(p_name, TFTPs_SIM_OPT_NAME_BLK_SIZE) == 0) {
+            p_client->BlkSize = Str_ParseNbr_Int32U(p_val, DEF_NULL, DEF_NBR_BASE_DEC);
+
+        } else if (Str_Cmp(p_name, TFTPs_SIM_OPT_NAME_WIN_SIZE) == 0) {
+            p_client->WinSize = Str_ParseNbr_Int32U(p_val, DEF_NULL, DEF_NBR_BASE_DEC);
+
+        } else if (Str_Cmp(p_name, TFTPs_SIM_OPT_NAME_TSIZE) == 0) {
+            tsize = Str_ParseNbr_Int32U(p_val, DEF_NULL, DEF_NBR_BASE_DEC);
+            if ((p_client->CfgPtr->Wr       == DEF_NO) &&       /* See Note #3.                                         */
+                (p_client->CfgPtr->FileSize != tsize)) {
+                return (DEF_FAIL);
+            }
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimClientAckRx()
+*
+* Description : Process an ACK delivered to a client writing a file.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+*               blk_nbr     Number of the block acknowledged.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimClientRx().
+*
+* Note(s)     : (1) An ACK of a block NOT sent, or of a block before the last block acknowledged, is ignored.
+*
+*               (2) An ACK of the last block acknowledged means that the first block of the window is
+*                   missing (see 'tftp-s_sim.c  Note #6').  The window is sent again once, until a block is
+*                   acknowledged, so that an ACK received again does NOT make the client send the window
+*                   once more.
+*
+*               (3) The file written is verified once its last block is acknowledged, as the server closes
+*                   the file before acknowledging it.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientAckRx (CPU_INT16U  client_ix,
+                                    CPU_INT16U  blk_nbr)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+    CPU_INT16U               blk_delta;
+    CPU_BOOLEAN              ok;
+
+
+    p_client  = &TFTPs_SimClientTbl[client_ix];
+    blk_delta = (CPU_INT16U)(blk_nbr - (CPU_INT16U)p_client->BlkAcked);
+    if (blk_delta > (p_client->BlkSent - p_client->BlkAcked)) { /* See Note #1.                                         */
+        return;
+    }
+
+    if (blk_delta == 0u) {                                      /* See Note #2.                                         */
+        p_client->PktDupCtr++;
+        if (p_client->GapAcked == DEF_NO) {
+            p_client->GapAcked = DEF_YES;
+            TFTPs_SimClientWinTx(client_ix);
+        }
+        return;
+    }
+
+    p_client->BlkAcked += blk_delta;
+    p_client->GapAcked  = DEF_NO;
+    p_client->RetryNbr  = 0u;
+    p_client->Octets    = DEF_MIN(p_client->BlkAcked * p_client->BlkSize, p_client->CfgPtr->FileSize);
+
+    if (p_client->BlkAcked >= p_client->BlkLast) {              /* Last blk (see Note #3).                              */
+        ok = TFTPs_SimFileVerify(client_ix);
+        TFTPs_SimClientEnd(p_client, (ok == DEF_OK) ? TFTPs_SIM_STATUS_DONE : TFTPs_SIM_STATUS_ERR_DATA);
+        return;
+    }
+
+    TFTPs_SimClientWinTx(client_ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimClientWinTx()
+*
+* Description : Send the window of a client writing a file.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimClientTmrProcess(),
+*               TFTPs_SimClientRx(),
+*               TFTPs_SimClientAckRx().
+*
+* Note(s)     : (1) The window holds the blocks following the last block acknowledged, up to the window size
+*                   or to the last block of the file (see 'tftp-s_sim.c  Note #6').  The last block is
+*                   shorter than the block size, & is empty when the file size is a multiple of the block
+*                   size (see RFC #1350, Section 6 'Normal Termination').
+*
+*               (2) The blocks are built in turn in the DATA packet buffer, as each is copied in flight.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientWinTx (CPU_INT16U  client_ix)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+    CPU_INT08U              *p_buf;
+    CPU_INT32U               blk;
+    CPU_INT32U               blk_end;
+    CPU_INT32U               off;
+    CPU_INT32U               data_len;
+    CPU_INT32U               i;
+
+
+    p_client = &TFTPs_SimClientTbl[client_ix];
+    p_buf    =  TFTPs_SimDataBufPtr;
+    blk_end  =  DEF_MIN(p_client->BlkAcked + p_client->WinSize, p_client->BlkLast);
+
+                                                                /* See Note #1.                                         */
+    for (blk = p_client->BlkAcked + 1u; blk <= blk_end; blk++) {
+        off      = (blk - 1u) * p_client->BlkSize;
+        data_len =  DEF_MIN(p_client->BlkSize, p_client->CfgPtr->FileSize - off);
+
+        p_buf[0] =  0u;                                         /* See Note #2.                                         */
+        p_buf[1] =  TFTPs_SIM_OPCODE_DATA;
+        p_buf[2] = (CPU_INT08U)(blk >> 8);
+        p_buf[3] = (CPU_INT08U)(blk &  DEF_OCTET_MASK);
+        for (i = 0u; i < data_len; i++) {
+            p_buf[TFTPs_SIM_PKT_HDR_SIZE + i] = TFTPs_SimFileOctetGet(client_ix, off + i);
+        }
+
+        TFTPs_SimLinkTx(client_ix,
+                        TFTPs_SIM_DIR_TO_SERVER,
+                        p_buf,
+                       (CPU_INT16U)(TFTPs_SIM_PKT_HDR_SIZE + data_len));
+    }
+
+    p_client->BlkSent = blk_end;
+    p_client->TmrTS   = TFTPs_SimNow + p_client->CfgPtr->Timeout;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimClientReqTx()
+*
+* Description : Send the read or write request of a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimClientTmrProcess().
+*
+* Note(s)     : (1) The client reads or writes its file (see 'tftp-s_sim.c  Note #4') in octet mode, with
+*                   the options of its scenario entry (see 'tftp-s_type.h  SIMULATED CLIENT DATA TYPE
+*                   Note #2').
+*
+*               (2) A read request asks for the transfer size with a size of 0, & a write request gives the
+*                   size of the file (see RFC #2349).
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientReqTx (CPU_INT16U  client_ix)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+    CPU_CHAR                *p_str;
+    CPU_INT16U               len;
+
+
+    p_client = &TFTPs_SimClientTbl[client_ix];
+
+    p_client->TxBuf[0] = 0u;                                    /* See Note #1.                                         */
+    p_client->TxBuf[1] = (p_client->CfgPtr->Wr == DEF_YES) ? TFTPs_SIM_OPCODE_WR_REQ : TFTPs_SIM_OPCODE_RD_REQ;
+    len                = 2u;
+
+    p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+    TFTPs_SimFileNameGet(client_ix, p_str);
+    len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+
+    p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+    (void)Str_Copy(p_str, "octet");
+    len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+
+    if (p_client->CfgPtr->BlkSize != 0u) {
+        p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+        (void)Str_Copy(p_str, TFTPs_SIM_OPT_NAME_BLK_SIZE);
+        len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+
+        p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+        (void)Str_FmtNbr_Int32U(p_client->CfgPtr->BlkSize,
+                                TFTPs_SIM_OPT_VAL_LEN_MAX,
+                                DEF_NBR_BASE_DEC,
+                                ASCII_CHAR_NULL,
+                                DEF_NO,
+                                DEF_YES,
+                                p_str);
+        len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+    }
+
+    if (p_client->CfgPtr->WinSize != 0u) {
+        p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+        (void)Str_Copy(p_str, TFTPs_SIM_OPT_NAME_WIN_SIZE);
+        len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+
+        p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+        (void)Str_FmtNbr_Int32U(p_client->CfgPtr->WinSize,
+                                TFTPs_SIM_OPT_VAL_LEN_MAX,
+                                DEF_NBR_BASE_DEC,
+                                ASCII_CHAR_NULL,
+                                DEF_NO,
+                                DEF_YES,
+                                p_str);
+        len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+    }
+
+    if (p_client->CfgPtr->TSize == DEF_YES) {                   /* See Note #2.                                         */
+        p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+        (void)Str_Copy(p_str, TFTPs_SIM_OPT_NAME_TSIZE);
+        len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+
+        p_str = (CPU_CHAR *)&p_client->TxBuf[len];
+        (void)Str_FmtNbr_Int32U((p_client->CfgPtr->Wr == DEF_YES) ? p_client->CfgPtr->FileSize : 0u,
+                                TFTPs_SIM_OPT_TSIZE_LEN_MAX,
+                                DEF_NBR_BASE_DEC,
+                                ASCII_CHAR_NULL,
+                                DEF_NO,
+                                DEF_YES,
+                                p_str);
+        len  += (CPU_INT16U)Str_Len(p_str) + 1u;
+    }
+
+    p_client->TxLen = len;
+    p_client->State = TFTPs_SIM_CLIENT_STATE_REQ;
+    p_client->ReqTS = TFTPs_SimNow;
+    p_client->TmrTS = TFTPs_SimNow + p_client->CfgPtr->Timeout;
+
+    TFTPs_SimLinkTx(client_ix, TFTPs_SIM_DIR_TO_SERVER, &p_client->TxBuf[0], len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimClientAckTx()
+*
+* Description : Send an ACK of a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+*               blk_nbr     Number of the block acknowledged.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimClientRx(),
+*               TFTPs_SimClientDataRx(),
+*               TFTPs_SimClientTmrProcess().
+*
+* Note(s)     : (1) The blocks of the next window are counted from the block acknowledged.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientAckTx (CPU_INT16U  client_ix,
+                                    CPU_INT16U  blk_nbr)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+
+
+    p_client           = &TFTPs_SimClientTbl[client_ix];
+    p_client->TxBuf[0] =  0u;
+    p_client->TxBuf[1] =  TFTPs_SIM_OPCODE_ACK;
+    p_client->TxBuf[2] = (CPU_INT08U)(blk_nbr >> 8);
+    p_client->TxBuf[3] = (CPU_INT08U)(blk_nbr &  DEF_OCTET_MASK);
+    p_client->TxLen    =  TFTPs_SIM_PKT_HDR_SIZE;
+    p_client->WinRxNbr =  0u;                                   /* See Note #1.                                         */
+
+    TFTPs_SimLinkTx(client_ix, TFTPs_SIM_DIR_TO_SERVER, &p_client->TxBuf[0], p_client->TxLen);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimClientEnd()
+*
+* Description : End the transfer of a client.
+*
+* Argument(s) : p_client    Pointer to client.
+*
+*               status      Status of the transfer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimClientTmrProcess(),
+*               TFTPs_SimClientRx(),
+*               TFTPs_SimClientDataRx(),
+*               TFTPs_SimClientAckRx().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimClientEnd (TFTPs_SIM_CLIENT_STATE  *p_client,
+                                  TFTPs_SIM_STATUS         status)
+{
+    p_client->State  = TFTPs_SIM_CLIENT_STATE_END;
+    p_client->Status = status;
+    p_client->EndTS  = TFTPs_SimNow;
+    p_client->TmrTS  = TFTPs_SIM_TIME_NONE;
+
+    TFTPs_SimClientEndNbr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimFileOctetGet()
+*
+* Description : Get an octet of the simulated file of a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+*               off         Offset of the octet in the file.
+*
+* Return(s)   : Octet of the file.
+*
+* Caller(s)   : TFTPs_SimClientDataRx(),
+*               TFTPs_SimClientWinTx(),
+*               TFTPs_SimFileVerify(),
+*               TFTPs_SimFileRd().
+*
+* Note(s)     : (1) The octets of consecutive blocks differ, so that a block received out of place is
+*                   detected (see 'tftp-s_sim.c  Note #4').
+*
+*               (2) The data of a client of its own file data are those of its scenario entry (see
+*                   'tftp-s_type.h  SIMULATED CLIENT DATA TYPE  Note #4').
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  TFTPs_SimFileOctetGet (CPU_INT16U  client_ix,
+                                           CPU_INT32U  off)
+{
+    const  CPU_INT08U  *p_data;
+
+
+    p_data = TFTPs_SimClientTbl[client_ix].CfgPtr->FileDataPtr;
+    if (p_data != DEF_NULL) {                                   /* See Note #2.                                         */
+        return (p_data[off]);
+    }
+
+    return ((CPU_INT08U)(off ^ (off >> 8) ^ (off >> 16) ^ ((CPU_INT32U)client_ix * 37u)));
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimFileNameGet()
+*
+* Description : Get the name of the simulated file of a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+*               p_name      Pointer to buffer that will receive the file name, of at least
+*                           TFTPs_SIM_FILE_NAME_LEN_MAX + 1 characters.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimClientReqTx(),
+*               TFTPs_SimFileVerify().
+*
+* Note(s)     : (1) See 'tftp-s_sim.c  Note #4'.  The length of the name of a client's own file is checked
+*                   by TFTPs_SimStart().
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimFileNameGet (CPU_INT16U   client_ix,
+                                    CPU_CHAR    *p_name)
+{
+    const  CPU_CHAR  *p_name_cfg;
+
+
+    p_name_cfg = TFTPs_SimClientTbl[client_ix].CfgPtr->FileNamePtr;
+    if (p_name_cfg != DEF_NULL) {                               /* See Note #1.                                         */
+        (void)Str_Copy(p_name, p_name_cfg);
+        return;
+    }
+
+    (void)Str_Copy(p_name, TFTPs_SIM_FILE_PREFIX);
+    (void)Str_FmtNbr_Int32U(client_ix,
+                            TFTPs_SIM_FILE_IX_LEN_MAX,
+                            DEF_NBR_BASE_DEC,
+                            ASCII_CHAR_NULL,
+                            DEF_NO,
+                            DEF_YES,
+                            p_name + TFTPs_SIM_FILE_PREFIX_LEN);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimFileVerify()
+*
+* Description : Verify the file written by a client.
+*
+* Argument(s) : client_ix   Index of the client.
+*
+* Return(s)   : DEF_OK,   if the file holds the octets of the simulated file of the client, & only them.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_SimClientAckRx().
+*
+* Note(s)     : (1) The file is read back from the file system, the simulated files being only provided for
+*                   reading (see 'tftp-s_fs.c  Note #4').
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimFileVerify (CPU_INT16U  client_ix)
+{
+    CPU_CHAR     name[TFTPs_SIM_FILE_NAME_LEN_MAX + 1u];
+    CPU_INT08U   buf[TFTPs_SIM_FILE_VERIFY_LEN];
+    void        *p_file;
+    CPU_INT32U   file_size;
+    CPU_INT32U   size;
+    CPU_INT32U   off;
+    CPU_SIZE_T   size_rd;
+    CPU_SIZE_T   i;
+    CPU_BOOLEAN  ok;
+
+
+    TFTPs_SimFileNameGet(client_ix, &name[0]);                  /* See Note #1.                                         */
+    p_file = NetFS_FileOpen(&name[0],
+                             NET_FS_FILE_MODE_OPEN,
+                             NET_FS_FILE_ACCESS_RD);
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    ok = NetFS_FileSizeGet(p_file, &size);
+    if ((ok   != DEF_OK) ||
+        (size != TFTPs_SimClientTbl[client_ix].CfgPtr->FileSize)) {
+        NetFS_FileClose(p_file);
+        return (DEF_FAIL);
+    }
+
+    file_size = size;
+    off       = 0u;
+    while (off < file_size) {
+        ok = NetFS_FileRd(p_file, &buf[0], sizeof(buf), &size_rd);
+        if ((ok      != DEF_OK) ||
+            (size_rd == 0u)) {
+            break;
+        }
+        for (i = 0u; i < size_rd; i++) {
+            if (buf[i] != TFTPs_SimFileOctetGet(client_ix, off + (CPU_INT32U)i)) {
+                ok = DEF_FAIL;
+                break;
+            }
+        }
+        if (ok != DEF_OK) {
+            break;
+        }
+        off += (CPU_INT32U)size_rd;
+    }
+
+    NetFS_FileClose(p_file);
+
+    if ((ok  != DEF_OK) ||
+        (off != file_size)) {
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimFileMatch()
+*
+* Description : Check whether a file name is the name of a simulated file.
+*
+* Argument(s) : p_name      Pointer to file name.
+*
+* Return(s)   : DEF_YES, if the name starts with TFTPs_SIM_FILE_PREFIX.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPs_FS_Open(), via TFTPs_SimFileProvider.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimFileMatch (const  CPU_CHAR  *p_name)
+{
+    if (Str_Cmp_N(p_name, TFTPs_SIM_FILE_PREFIX, TFTPs_SIM_FILE_PREFIX_LEN) == 0) {
+        return (DEF_YES);
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SimFileOpen()
+*
+* Description : Open the simulated file of a client.
+*
+* Argument(s) : p_name      Pointer to file name.
+*
+* Return(s)   : Pointer to state of the client of the file, if NO error.
+*
+*               DEF_NULL, if the name is NOT the name of the file of a client of the run.
+*
+* Caller(s)   : TFTPs_FS_Open(), via TFTPs_SimFileProvider.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  *TFTPs_SimFileOpen (const  CPU_CHAR  *p_name)
+{
+    CPU_CHAR    *p_end;
+    CPU_INT32U   client_ix;
+
+
+    client_ix = Str_ParseNbr_Int32U(&p_name[TFTPs_SIM_FILE_PREFIX_LEN], &p_end, DEF_NBR_BASE_DEC);
+    if ((p_end     == &p_name[TFTPs_SIM_FILE_PREFIX_LEN]) ||
+        (*p_end    != ASCII_CHAR_NULL)                    ||
+        (client_ix >= TFTPs_SimClientNbr)) {
+        return (DEF_NULL);
+    }
+
+    return (&TFTPs_SimClientTbl[client_ix]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPs_SimFileRd()
+*
+* Description : Read from a simulated file.
+*
+* Argument(s) : p_handle    Pointer to state of the client of the file.
+*
+*               off         Offset in the file to read from.
+*
+*               p_dest      Pointer to buffer that will receive the data.
+*
+*               size        Number of octets to read.
+*
+*               p_size_rd   Pointer to variable that will receive the number of octets read.
+*
+* Return(s)   : DEF_OK.
+*
+* Caller(s)   : TFTPs_FS_Rd(), via TFTPs_SimFileProvider.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimFileRd (void        *p_handle,
+                                      CPU_INT32U   off,
+                                      void        *p_dest,
+                                      CPU_SIZE_T   size,
+                                      CPU_SIZE_T  *p_size_rd)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+    CPU_INT08U              *p_data;
+    CPU_INT16U               client_ix;
+    CPU_INT32U               file_size;
+    CPU_SIZE_T               i;
+
+
+    p_client  = (TFTPs_SIM_CLIENT_STATE *)p_handle;
+    client_ix = (CPU_INT16U)(p_client - &TFTPs_SimClientTbl[0]);
+    file_size =  p_client->CfgPtr->FileSize;
+
+   *p_size_rd = 0u;
+    if (off >= file_size) {
+        return (DEF_OK);
+    }
+    size   = DEF_MIN(size, file_size - off);
+    p_data = (CPU_INT08U *)p_dest;
+    for (i = 0u; i < size; i++) {
+        p_data[i] = TFTPs_SimFileOctetGet(client_ix, off + (CPU_INT32U)i);
+    }
+
+   *p_size_rd = size;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimFileSizeGet()
+*
+* Description : Get the size of a simulated file.
+*
+* Argument(s) : p_handle    Pointer to state of the client of the file.
+*
+*               p_size      Pointer to variable that will receive the size of the file.
+*
+* Return(s)   : DEF_OK.
+*
+* Caller(s)   : TFTPs_FS_SizeGet(), via TFTPs_SimFileProvider.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimFileSizeGet (void        *p_handle,
+                                           CPU_INT32U  *p_size)
+{
+    TFTPs_SIM_CLIENT_STATE  *p_client;
+
+
+    p_client = (TFTPs_SIM_CLIENT_STATE *)p_handle;
+   *p_size   =  p_client->CfgPtr->FileSize;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SimFileClose()
+*
+* Description : Close a simulated file.
+*
+* Argument(s) : p_handle    Pointer to state of the client of the file.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_FS_Close(), via TFTPs_SimFileProvider.
+*
+* Note(s)     : (1) Simulated files hold NO resource.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimFileClose (void  *p_handle)
+{
+    (void)p_handle;                                             /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of simulation module include.                    */
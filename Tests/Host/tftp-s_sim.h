@@ -0,0 +1,92 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP SERVER NETWORK SIMULATION
+*
+* Filename : tftp-s_sim.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*
+* Note(s) : (1) This header file is protected from multiple pre-processor inclusion through use of the
+*               TFTPs simulation present pre-processor macro definition.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPs_SIM_MODULE_PRESENT                               /* See Note #1.                                         */
+#define  TFTPs_SIM_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-s.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void               TFTPs_SimInit     (const  TFTPs_CFG           *p_cfg,
+                                             TFTPs_ERR           *p_err);
+
+void               TFTPs_SimStart    (const  TFTPs_SIM_SCENARIO  *p_scenario,
+                                             TFTPs_ERR           *p_err);
+
+CPU_BOOLEAN        TFTPs_SimIsDone   (void);
+
+void               TFTPs_SimResultGet(       TFTPs_SIM_RESULT    *p_result);
+
+CPU_INT32U         TFTPs_SimNowGet   (void);
+
+NET_SOCK_RTN_CODE  TFTPs_SimRx       (       CPU_INT32U           timeout_ms,
+                                             CPU_INT16S           rx_flags,
+                                             NET_SOCK_ADDR       *p_addr,
+                                             CPU_INT08U          *p_buf,
+                                             CPU_INT16U           buf_len);
+
+NET_SOCK_RTN_CODE  TFTPs_SimTx       (       NET_SOCK_ADDR       *p_addr,
+                                      const  CPU_INT08U          *p_pkt,
+                                             CPU_INT16U           len);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPs_SIM_MODULE_PRESENT  */
@@ -0,0 +1,1870 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPs
+*                               Trivial File Transfer Protocol (server)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  TFTP SERVER NETWORK SIMULATION TESTS
+*
+* Filename : tftp-s_sim_test.c
+*********************************************************************************************************
+* Note(s)  : (1) The tests run the server against the network simulation (see 'tftp-s_sim.c') with a fixed
+*                set of scenarios, each with its own seed, so that every run of the tests computes the same
+*                transfers.  The tests are built & run on a host by 'make test' (see 'Tests/Host/Makefile').
+*
+*            (2) A scenario passes when :
+*
+*                (a) Each of its clients ends with the status expected, having read or written its whole
+*                    file when done, & nothing when refused.  The data read is verified by the clients, &
+*                    the files written are read back once acknowledged (see 'tftp-s_sim.c  Note #4').  A
+*                    client is expected done unless its scenario lists the status of each client, or
+*                    unless it writes a file while writes are disabled (see 'tftp-s.c  Note #12').
+*
+*                (b) Its last client is done within the time expected.  The times expected leave room for
+*                    changes of the server that do NOT change its behaviour on the wire, but NOT for a
+*                    transfer stalling on retransmission timeouts.
+*
+*                (c) The links lost, duplicated & reordered packets whenever their rates are NOT null for a
+*                    client expected done, so that a scenario does test the recovery it is named after.
+*
+*                (d) The scenario run again gives the same results (see 'tftp-s_type.h  SIMULATION
+*                    SCENARIO DATA TYPE  Note #1').
+*
+*                (e) The checks of its own, if any, pass.
+*
+*            (3) The scenarios are grouped in suites, each run by a process of its own on a server
+*                initialized for the suite, e.g. to store the files read by its clients :
+*
+*                    tftp-s_sim_test [suite]             The suite "transfer" by default.
+*
+*            (4) The tests print one line per scenario, & exit with a non-zero status when a scenario
+*                fails.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+#include  <Source/tftp-s.h>
+#include  <FS/net_fs.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPs_SIM_TEST_CLIENT_NBR_MAX                     8u   /* Max nbr of clients of a scenario.                    */
+#define  TFTPs_SIM_TEST_TIME_MAX                      600000u   /* Max duration (ms) of a run.                          */
+
+#define  TFTPs_SIM_TEST_SUITE_DFLT                "transfer"    /* See 'tftp-s_sim_test.c  Note #3'.                    */
+
+#define  TFTPs_SIM_TEST_RAND_SEED                 0x2545F491u   /* Seed of the file data generated.                     */
+
+                                                                /* ------------- LZ4 FILES (see Note #5) -------------- */
+#define  TFTPs_SIM_TEST_LZ4_TEXT_NAME             "lz4/text"    /* Compressible file.                                   */
+#define  TFTPs_SIM_TEST_LZ4_TEXT_SIZE                 200000u
+#define  TFTPs_SIM_TEST_LZ4_RAND_NAME             "lz4/rand"    /* Incompressible file.                                 */
+#define  TFTPs_SIM_TEST_LZ4_RAND_SIZE                 150000u
+#define  TFTPs_SIM_TEST_LZ4_EXT                       ".lz4"    /* See 'tftp-s_fs.c  Note #2'.                          */
+
+                                                                /* ------------ SHARED FILE (see Note #6) ------------- */
+#define  TFTPs_SIM_TEST_SHARE_NAME              "share/img"
+#define  TFTPs_SIM_TEST_SHARE_SIZE                    200000u
+
+                                                                /* ---------- TRAFFIC CLASSES (see Note #8) ----------- */
+#define  TFTPs_SIM_TEST_CLASS_BULK_NAME          "bulk/img"     /* File of the bulk class.                              */
+#define  TFTPs_SIM_TEST_CLASS_BULK_SIZE               200000u
+#define  TFTPs_SIM_TEST_CLASS_BULK_PCT                    50u   /* Bandwidth share of the bulk class.                   */
+#define  TFTPs_SIM_TEST_CLASS_CRIT_NAME          "crit/img"     /* File of the critical class.                          */
+#define  TFTPs_SIM_TEST_CLASS_CRIT_SIZE               100000u
+#define  TFTPs_SIM_TEST_CLASS_SESS_NBR                     4u   /* Nbr of sessions, 1 reserved to the critical class.   */
+#define  TFTPs_SIM_TEST_CLASS_RATE                    200000u   /* Global rate (octets/s).                              */
+#define  TFTPs_SIM_TEST_CLASS_BURST                    16384u   /* Global burst size (octets).                          */
+
+#define  TFTPs_SIM_TEST_LZ4_MAGIC                 0x184D2204u   /* See 'tftp-s_lz4.c  Note #1'.                         */
+#define  TFTPs_SIM_TEST_LZ4_FLG                         0x68u   /* Version 01, indep blks & content size.               */
+#define  TFTPs_SIM_TEST_LZ4_BD                          0x40u   /* 64 KB blks.                                          */
+#define  TFTPs_SIM_TEST_LZ4_BLK_SIZE                   65536u
+#define  TFTPs_SIM_TEST_LZ4_BLK_RAW               0x80000000u   /* Blk stored uncompressed.                             */
+#define  TFTPs_SIM_TEST_LZ4_HDR_SIZE                      15u   /* Magic, FLG, BD, content size & HC.                   */
+#define  TFTPs_SIM_TEST_LZ4_DESC_SIZE                     10u   /* FLG, BD & content size, covered by HC.               */
+
+#define  TFTPs_SIM_TEST_XXH32_PRIME_1             0x9E3779B1u   /* See 'TFTPs_SimTestLZ4_HdrChkSum()  Note #1'.         */
+#define  TFTPs_SIM_TEST_XXH32_PRIME_2             0x85EBCA77u
+#define  TFTPs_SIM_TEST_XXH32_PRIME_3             0xC2B2AE3Du
+#define  TFTPs_SIM_TEST_XXH32_PRIME_4             0x27D4EB2Fu
+#define  TFTPs_SIM_TEST_XXH32_PRIME_5             0x165667B1u
+#define  TFTPs_SIM_TEST_LZ4_FRAME_SIZE_MAX  (TFTPs_SIM_TEST_LZ4_TEXT_SIZE + 64u)
+
+#define  TFTPs_SIM_TEST_LZ4_HASH_BITS                     12u   /* See 'TFTPs_SimTestLZ4_BlkEnc()  Note #1'.            */
+#define  TFTPs_SIM_TEST_LZ4_HASH_SIZE          (1u << TFTPs_SIM_TEST_LZ4_HASH_BITS)
+#define  TFTPs_SIM_TEST_LZ4_MATCH_LEN_MIN                  4u
+#define  TFTPs_SIM_TEST_LZ4_MATCH_OFF_MAX              65535u
+#define  TFTPs_SIM_TEST_LZ4_MATCH_END_MIN                 12u   /* Min octets from last match to blk end.               */
+#define  TFTPs_SIM_TEST_LZ4_LIT_LAST_MIN                   5u   /* Min nbr of literals ending a blk.                    */
+#define  TFTPs_SIM_TEST_LZ4_LEN_TOKEN_MAX                 15u   /* Max len held in a token.                             */
+
+#if (TFTPs_CFG_WR_WIN_EN == DEF_ENABLED)                        /* Max time (ms) of windowed wr (see 'LOCAL CONSTANTS   */
+#define  TFTPs_SIM_TEST_WR_WIN_TIME_EXP                8000u    /* Note #4').                                           */
+#else
+#define  TFTPs_SIM_TEST_WR_WIN_TIME_EXP               40000u
+#endif
+
+#define  TFTPs_SIM_TEST_SHAPE_TIME_PCT                   110u   /* Max time in % of the rate bound (see Note #7).       */
+#define  TFTPs_SIM_TEST_SHAPE_TIME_MARGIN                100u   /* Max time (ms) over it           (see Note #7).       */
+
+#define  TFTPs_SIM_TEST_ENTRY(name, tbl, seed, time_exp)  \
+                                { name, tbl, sizeof(tbl) / sizeof(TFTPs_SIM_CLIENT), seed, time_exp,  \
+                                  DEF_NULL, DEF_NULL, DEF_NULL }
+
+#define  TFTPs_SIM_TEST_ENTRY_EXT(name, tbl, seed, time_exp, status_tbl, check_fnct)  \
+                                { name, tbl, sizeof(tbl) / sizeof(TFTPs_SIM_CLIENT), seed, time_exp,  \
+                                  status_tbl, check_fnct, DEF_NULL }
+
+#define  TFTPs_SIM_TEST_ENTRY_SHAPE(name, tbl, seed, time_exp, shape)  \
+                                { name, tbl, sizeof(tbl) / sizeof(TFTPs_SIM_CLIENT), seed, time_exp,  \
+                                  DEF_NULL, TFTPs_SimTestShapeCheck, &shape }
+
+#define  TFTPs_SIM_TEST_SUITE(name, tbl, init_fnct)  \
+                                { name, tbl, sizeof(tbl) / sizeof(TFTPs_SIM_TEST), init_fnct }
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  tftps_sim_test  TFTPs_SIM_TEST;
+
+                                                                /* Shaping of a scenario (see Note #7).                 */
+typedef  struct  tftps_sim_test_shape {
+    CPU_INT32U                RateGlobal;                       /* Global rate (octets/s), or unlimited.                */
+    CPU_INT32U                BurstGlobal;                      /* Global burst size (octets).                          */
+    CPU_INT32U                RateClient;                       /* Client rate (octets/s), or unlimited.                */
+    CPU_INT32U                BurstClient;                      /* Client burst size (octets).                          */
+} TFTPs_SIM_TEST_SHAPE;
+
+                                                                /* Checks of a scenario's own (see Note #2e).           */
+typedef  CPU_BOOLEAN  (*TFTPs_SIM_TEST_CHECK_FNCT)(const  TFTPs_SIM_TEST    *p_test,
+                                                   const  TFTPs_SIM_RESULT  *p_result);
+
+struct  tftps_sim_test {
+    const  CPU_CHAR          *NamePtr;                          /* Name of scenario.                                    */
+    const  TFTPs_SIM_CLIENT  *ClientTblPtr;                     /* Clients of scenario.                                 */
+    CPU_INT16U                ClientNbr;                        /* Nbr of clients.                                      */
+    CPU_INT32U                Seed;                             /* Seed of link randomness.                             */
+    CPU_INT32U                TimeExp;                          /* Max time (ms) of last client done (see Note #2b).    */
+    const  TFTPs_SIM_STATUS  *StatusTblPtr;                     /* Status of each client, or NULL    (see Note #2a).    */
+    TFTPs_SIM_TEST_CHECK_FNCT CheckFnct;                        /* Checks of its own, or NULL        (see Note #2e).    */
+    const  TFTPs_SIM_TEST_SHAPE  *ShapePtr;                     /* Shaping of scenario, or NULL      (see Note #7).     */
+};
+
+                                                                /* Init of a suite's cfg & files (see Note #3).         */
+typedef  CPU_BOOLEAN  (*TFTPs_SIM_TEST_INIT_FNCT)(TFTPs_CFG  *p_cfg);
+
+typedef  struct  tftps_sim_test_suite {
+    const  CPU_CHAR          *NamePtr;                          /* Name of suite.                                       */
+    const  TFTPs_SIM_TEST    *TestTblPtr;                       /* Scenarios of suite.                                  */
+    CPU_INT16U                TestNbr;                          /* Nbr of scenarios.                                    */
+    TFTPs_SIM_TEST_INIT_FNCT  InitFnct;                         /* Init of suite, or NULL.                              */
+} TFTPs_SIM_TEST_SUITE;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  TFTPs_CFG   TFTPs_SimTestCfg;                           /* Cfg of the server (see 'main()  Note #1').           */
+                                                                /* See 'LOCAL CONSTANTS  Note #8'.                      */
+static  CPU_INT08U  TFTPs_SimTestClassBuf[TFTPs_SIM_TEST_CLASS_BULK_SIZE];
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)                     /* See 'LOCAL CONSTANTS  Note #6'.                      */
+static  CPU_INT08U  TFTPs_SimTestShareBuf[TFTPs_SIM_TEST_SHARE_SIZE];
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)                        /* See 'LOCAL CONSTANTS  Note #5'.                      */
+static  CPU_INT08U  TFTPs_SimTestLZ4_TextBuf[TFTPs_SIM_TEST_LZ4_TEXT_SIZE];
+static  CPU_INT08U  TFTPs_SimTestLZ4_RandBuf[TFTPs_SIM_TEST_LZ4_RAND_SIZE];
+static  CPU_INT08U  TFTPs_SimTestLZ4_FrameBuf[TFTPs_SIM_TEST_LZ4_FRAME_SIZE_MAX];
+static  CPU_INT32U  TFTPs_SimTestLZ4_HashTbl[TFTPs_SIM_TEST_LZ4_HASH_SIZE];
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN       TFTPs_SimTestRun      (const  TFTPs_SIM_TEST    *p_test);
+
+static  CPU_BOOLEAN       TFTPs_SimTestCheck    (const  TFTPs_SIM_TEST    *p_test,
+                                                 const  TFTPs_SIM_RESULT  *p_result);
+
+static  TFTPs_SIM_STATUS  TFTPs_SimTestStatusGet(const  TFTPs_SIM_TEST    *p_test,
+                                                        CPU_INT16U         client_ix);
+
+static  void              TFTPs_SimTestShapeSet (const  TFTPs_SIM_TEST    *p_test,
+                                                        TFTPs_ERR         *p_err);
+
+static  CPU_BOOLEAN       TFTPs_SimTestShapeCheck(const TFTPs_SIM_TEST    *p_test,
+                                                 const  TFTPs_SIM_RESULT  *p_result);
+
+static  CPU_INT32U        TFTPs_SimTestShapeTimeMin(    CPU_INT32U         octets,
+                                                        CPU_INT32U         rate,
+                                                        CPU_INT32U         burst);
+
+static  CPU_BOOLEAN       TFTPs_SimTestFileWr   (const  CPU_CHAR          *p_name,
+                                                 const  CPU_INT08U        *p_data,
+                                                        CPU_INT32U         size);
+
+static  void              TFTPs_SimTestRandGen  (       CPU_INT08U        *p_buf,
+                                                        CPU_INT32U         size,
+                                                        CPU_INT32U        *p_seed);
+
+static  CPU_BOOLEAN       TFTPs_SimTestClassInit(       TFTPs_CFG         *p_cfg);
+
+static  CPU_BOOLEAN       TFTPs_SimTestClassCheck(const TFTPs_SIM_TEST    *p_test,
+                                                 const  TFTPs_SIM_RESULT  *p_result);
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN       TFTPs_SimTestShareInit(       TFTPs_CFG         *p_cfg);
+
+static  CPU_BOOLEAN       TFTPs_SimTestShareCheck(const TFTPs_SIM_TEST    *p_test,
+                                                 const  TFTPs_SIM_RESULT  *p_result);
+
+static  CPU_BOOLEAN       TFTPs_SimTestShareStreamCheck(const TFTPs_SIM_TEST    *p_test,
+                                                        const TFTPs_SIM_RESULT  *p_result);
+#endif
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  CPU_BOOLEAN       TFTPs_SimTestLZ4_Init (       TFTPs_CFG         *p_cfg);
+
+static  void              TFTPs_SimTestLZ4_TextGen(     CPU_INT08U        *p_buf,
+                                                        CPU_INT32U         size,
+                                                        CPU_INT32U        *p_seed);
+
+static  CPU_BOOLEAN       TFTPs_SimTestLZ4_FileWr(const CPU_CHAR          *p_name,
+                                                 const  CPU_INT08U        *p_data,
+                                                        CPU_INT32U         size,
+                                                        CPU_INT32U        *p_frame_size);
+
+static  CPU_INT32U        TFTPs_SimTestLZ4_BlkEnc(const CPU_INT08U        *p_src,
+                                                        CPU_INT32U         src_len,
+                                                        CPU_INT08U        *p_dest);
+
+static  CPU_BOOLEAN       TFTPs_SimTestLZ4_SeqWr(       CPU_INT08U        *p_dest,
+                                                        CPU_INT32U        *p_dest_ix,
+                                                        CPU_INT32U         dest_len,
+                                                 const  CPU_INT08U        *p_lit,
+                                                        CPU_INT32U         lit_len,
+                                                        CPU_INT32U         match_off,
+                                                        CPU_INT32U         match_len);
+
+static  CPU_INT08U        TFTPs_SimTestLZ4_HdrChkSum(const CPU_INT08U     *p_desc,
+                                                        CPU_INT32U         desc_len);
+
+static  void              TFTPs_SimTestLE32_Wr  (       CPU_INT08U        *p_dest,
+                                                        CPU_INT32U         val);
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL CONSTANTS
+*
+* Note(s) : (1) Each client is listed as { file size, write, start time, block size, window size, timeout,
+*               retries, { latency, jitter, loss rate, duplicate rate, reorder rate, reorder delay },
+*               transfer size, file name, file data } (see 'tftp-s_type.h  SIMULATED CLIENT DATA TYPE').
+*
+*           (2) A file size multiple of the block size ends with an empty block.
+*
+*           (3) With the single packet buffer, the server serves a single session (see 'tftp-s_cfg.h
+*               TFTPs SINGLE PACKET BUFFER CONFIGURATION') : the clients requesting a transfer while another
+*               is in progress are refused, & concurrent transfers are replaced by a scenario checking so.
+*
+*           (4) The blocks of a write are NOT windowed when windowed writes are disabled (see 'tftp-s_cfg.h
+*               TFTPs_CFG_WR_WIN_EN') : the transfer takes a round-trip time per block.
+*
+*           (5) The suite "lz4" stores 2 files as LZ4 frames (see 'tftp-s_fs.c  Note #2'), one compressible
+*               & one NOT, & its clients read them back decoded, with their size (see TFTPs_SimTestLZ4_Init()).
+*
+*           (6) The clients of the suite "share" read the same stored file at a time, each verifying the
+*               data it receives.  The file MUST be opened once for all of them (see 'tftp-s_fs.c  Note #6').
+*               When streamed, the file read by clients at nearby positions MUST be read from storage once
+*               (see 'tftp-s_fs.c  Note #7'); clients delayed by losses read it at distant positions, &
+*               are only checked to share its handle (see TFTPs_SimTestShareCheck()).
+*
+*           (7) The scenarios of the suite "shape" set the rates & burst sizes of the egress shaper (see
+*               'tftp-s_shape.c  Note #1') before they run.  A client sends at most its burst size & its
+*               rate times its transfer time, so that each transfer lasts at least the time of its rate
+*               bound, & all the transfers together the time of the global rate bound.  The last client
+*               MUST also be done within TFTPs_SIM_TEST_SHAPE_TIME_PCT % of the longest bound, plus
+*               TFTPs_SIM_TEST_SHAPE_TIME_MARGIN ms for the round trips & packet headers (see
+*               TFTPs_SimTestShapeCheck()).
+*
+*           (8) The suite "class" serves 2 traffic classes (see 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION
+*               DATA TYPE') : the critical class, of the files named "crit/..", holds 1 reserved session,
+*               & the bulk class, of the files named "bulk/..", TFTPs_SIM_TEST_CLASS_BULK_PCT % of the
+*               global rate.  The clients of the bulk class MUST NOT take the reserved session, MUST NOT
+*               exceed their share, & MUST be done after the clients of the other classes started with
+*               them (see TFTPs_SimTestClassCheck()).
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_RdTbl[] = {      /* Lockstep rd, default blk size.                       */
+    { 100000u, DEF_NO,  0u,    0u, 0u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_RdWinTbl[] = {   /* Windowed rd.                                         */
+    { 524288u, DEF_NO,  0u, 1428u, 8u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_RdLossTbl[] = {  /* Windowed rd, 2 % loss.                               */
+    { 262144u, DEF_NO,  0u, 1024u, 8u,  500u, 8u, { 25u, 5u, 200u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+                                                                /* Windowed rd, 3 % reordered.                          */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_RdReorderTbl[] = {
+    { 262144u, DEF_NO,  0u, 1024u, 8u,  500u, 8u, { 25u, 0u,   0u,   0u, 300u, 15u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_RdDupTbl[] = {   /* Windowed rd, 3 % duplicated.                         */
+    { 262144u, DEF_NO,  0u, 1024u, 8u,  500u, 8u, { 25u, 5u,   0u, 300u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_WrTbl[] = {      /* Lockstep wr, default blk size.                       */
+    { 100000u, DEF_YES, 0u,    0u, 0u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_WrWinTbl[] = {   /* Windowed wr (see Note #2).                           */
+    { 524288u, DEF_YES, 0u, 1024u, 8u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_WrLossTbl[] = {  /* Windowed wr, 2 % loss.                               */
+    { 262144u, DEF_YES, 0u, 1024u, 8u,  500u, 8u, { 25u, 5u, 200u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+                                                                /* Windowed wr, 3 % reordered & dup'd.                  */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_WrReorderDupTbl[] = {
+    { 262144u, DEF_YES, 0u, 1024u, 8u,  500u, 8u, { 25u, 5u,   0u, 300u, 300u, 15u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+#if (TFTPs_CFG_BUF_SINGLE_EN != DEF_ENABLED)                    /* See Note #3.                                         */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_MixTbl[] = {     /* Concurrent rd & wr, 1 % loss.                        */
+    { 200000u, DEF_NO,  0u, 1428u, 4u,  500u, 8u, { 20u, 5u, 100u, 100u, 100u, 10u }, DEF_NO, DEF_NULL, DEF_NULL },
+    { 150000u, DEF_YES, 5u, 1024u, 4u,  500u, 8u, { 30u, 5u, 100u, 100u, 100u, 10u }, DEF_NO, DEF_NULL, DEF_NULL },
+    {  50000u, DEF_NO, 10u,    0u, 0u,  500u, 8u, { 10u, 0u, 100u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL },
+    {  60000u, DEF_YES, 15u,   0u, 0u,  500u, 8u, { 10u, 0u, 100u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+#endif
+
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+                                                                /* Rd, reqs during rd refused (see Note #3).            */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_BusyTbl[] = {
+    { 200000u, DEF_NO,     0u, 1428u, 4u,  500u, 8u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL },
+    {  60000u, DEF_YES,   50u,    0u, 0u,  500u, 8u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL },
+    {  50000u, DEF_NO,   100u,    0u, 0u,  500u, 8u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL },
+    {  50000u, DEF_NO,  3000u,    0u, 0u,  500u, 8u, { 10u, 0u, 100u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_STATUS  TFTPs_SimTest_BusyStatusTbl[] = {
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_ERR_PKT,
+    TFTPs_SIM_STATUS_ERR_PKT,
+    TFTPs_SIM_STATUS_DONE
+};
+#endif
+
+static  const  TFTPs_SIM_TEST  TFTPs_SimTest_TransferTbl[] = {
+    TFTPs_SIM_TEST_ENTRY("rrq",                TFTPs_SimTest_RdTbl,           0x1234u,  8000u),
+    TFTPs_SIM_TEST_ENTRY("rrq-window",         TFTPs_SimTest_RdWinTbl,        0x2345u,  8000u),
+    TFTPs_SIM_TEST_ENTRY("rrq-loss",           TFTPs_SimTest_RdLossTbl,       0x3456u, 30000u),
+    TFTPs_SIM_TEST_ENTRY("rrq-reorder",        TFTPs_SimTest_RdReorderTbl,    0x4567u, 15000u),
+    TFTPs_SIM_TEST_ENTRY("rrq-duplicate",      TFTPs_SimTest_RdDupTbl,        0x5678u, 15000u),
+    TFTPs_SIM_TEST_ENTRY("wrq",                TFTPs_SimTest_WrTbl,           0x6789u,  8000u),
+    TFTPs_SIM_TEST_ENTRY("wrq-window",         TFTPs_SimTest_WrWinTbl,        0x789Au, TFTPs_SIM_TEST_WR_WIN_TIME_EXP),
+    TFTPs_SIM_TEST_ENTRY("wrq-loss",           TFTPs_SimTest_WrLossTbl,       0x89ABu, 30000u),
+    TFTPs_SIM_TEST_ENTRY("wrq-reorder-dup",    TFTPs_SimTest_WrReorderDupTbl, 0x9ABCu, 15000u),
+#if (TFTPs_CFG_BUF_SINGLE_EN != DEF_ENABLED)
+    TFTPs_SIM_TEST_ENTRY("mixed",              TFTPs_SimTest_MixTbl,          0xABCDu, 30000u)
+#else
+    TFTPs_SIM_TEST_ENTRY_EXT("busy",           TFTPs_SimTest_BusyTbl,         0xABCDu, 10000u,
+                             TFTPs_SimTest_BusyStatusTbl, DEF_NULL)
+#endif
+};
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)                        /* Concurrent rd of LZ4 files (see Note #5).            */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_LZ4_RdTbl[] = {
+    { TFTPs_SIM_TEST_LZ4_TEXT_SIZE, DEF_NO, 0u, 1428u, 8u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u },
+      DEF_YES, TFTPs_SIM_TEST_LZ4_TEXT_NAME, &TFTPs_SimTestLZ4_TextBuf[0] },
+    { TFTPs_SIM_TEST_LZ4_RAND_SIZE, DEF_NO, 5u, 1024u, 4u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u },
+      DEF_YES, TFTPs_SIM_TEST_LZ4_RAND_NAME, &TFTPs_SimTestLZ4_RandBuf[0] }
+};
+                                                                /* Concurrent rd of LZ4 files, 2 % loss & reordered.    */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_LZ4_RdLossTbl[] = {
+    { TFTPs_SIM_TEST_LZ4_TEXT_SIZE, DEF_NO, 0u, 1428u, 8u,  500u, 8u, { 25u, 5u, 200u,   0u, 200u, 15u },
+      DEF_YES, TFTPs_SIM_TEST_LZ4_TEXT_NAME, &TFTPs_SimTestLZ4_TextBuf[0] },
+    { TFTPs_SIM_TEST_LZ4_RAND_SIZE, DEF_NO, 5u, 1024u, 4u,  500u, 8u, { 25u, 5u, 200u,   0u, 200u, 15u },
+      DEF_YES, TFTPs_SIM_TEST_LZ4_RAND_NAME, &TFTPs_SimTestLZ4_RandBuf[0] }
+};
+
+static  const  TFTPs_SIM_TEST  TFTPs_SimTest_LZ4_Tbl[] = {
+    TFTPs_SIM_TEST_ENTRY("lz4-rrq",            TFTPs_SimTest_LZ4_RdTbl,       0xBCDEu,  8000u),
+    TFTPs_SIM_TEST_ENTRY("lz4-rrq-loss",       TFTPs_SimTest_LZ4_RdLossTbl,   0xCDEFu, 30000u)
+};
+#endif
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)                     /* Concurrent rd of a file (see Note #6).               */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_ShareRdTbl[] = {
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 0u, 1428u, 8u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u },
+      DEF_NO,  TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] },
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 2u, 1428u, 8u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u },
+      DEF_NO,  TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] },
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 4u, 1428u, 8u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u },
+      DEF_NO,  TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] },
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 6u, 1428u, 8u, 1000u, 5u, { 25u, 0u,   0u,   0u,   0u,  0u },
+      DEF_YES, TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] }
+};
+                                                                /* Concurrent rd of a file, other opts, 1 % loss.       */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_ShareRdLossTbl[] = {
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 0u,    0u, 0u,  500u, 8u, { 10u, 5u, 100u,   0u,   0u,  0u },
+      DEF_NO,  TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] },
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 3u, 1024u, 4u,  500u, 8u, { 20u, 5u, 100u,   0u, 100u, 10u },
+      DEF_NO,  TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] },
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 6u, 1428u, 8u,  500u, 8u, { 25u, 5u, 100u, 100u,   0u,  0u },
+      DEF_YES, TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] },
+    { TFTPs_SIM_TEST_SHARE_SIZE, DEF_NO, 9u, 8192u, 2u,  500u, 8u, { 25u, 5u, 100u,   0u,   0u,  0u },
+      DEF_YES, TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0] }
+};
+
+static  const  TFTPs_SIM_TEST  TFTPs_SimTest_ShareTbl[] = {
+    TFTPs_SIM_TEST_ENTRY_EXT("share-rrq",      TFTPs_SimTest_ShareRdTbl,      0xDEF0u,  8000u,
+                             DEF_NULL, TFTPs_SimTestShareStreamCheck),
+    TFTPs_SIM_TEST_ENTRY_EXT("share-rrq-loss", TFTPs_SimTest_ShareRdLossTbl,  0xEF01u, 30000u,
+                             DEF_NULL, TFTPs_SimTestShareCheck)
+};
+#endif
+
+                                                                /* ---------- TRAFFIC CLASSES (see Note #8) ----------- */
+static  const  TFTPs_CLASS_CFG  TFTPs_SimTest_ClassCfgTbl[] = {
+    { "crit/", TFTPs_CLASS_FAMILY_ANY, { 0u }, 0u, 1u, 0u },
+    { "bulk/", TFTPs_CLASS_FAMILY_ANY, { 0u }, 0u, 0u, TFTPs_SIM_TEST_CLASS_BULK_PCT }
+};
+                                                                /* Bulk rd taking all sessions but the reserved one.    */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_ClassRsvdTbl[] = {
+    { TFTPs_SIM_TEST_CLASS_BULK_SIZE, DEF_NO,   0u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_BULK_NAME, &TFTPs_SimTestClassBuf[0] },
+    { TFTPs_SIM_TEST_CLASS_BULK_SIZE, DEF_NO,   0u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_BULK_NAME, &TFTPs_SimTestClassBuf[0] },
+    { TFTPs_SIM_TEST_CLASS_BULK_SIZE, DEF_NO,   0u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_BULK_NAME, &TFTPs_SimTestClassBuf[0] },
+    { TFTPs_SIM_TEST_CLASS_BULK_SIZE, DEF_NO,  50u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_BULK_NAME, &TFTPs_SimTestClassBuf[0] },
+    { TFTPs_SIM_TEST_CLASS_CRIT_SIZE, DEF_NO, 100u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_CRIT_NAME, &TFTPs_SimTestClassBuf[0] }
+};
+
+static  const  TFTPs_SIM_STATUS  TFTPs_SimTest_ClassRsvdStatusTbl[] = {
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_DONE,
+    TFTPs_SIM_STATUS_ERR_PKT,                                   /* Bulk req refused, session reserved.                  */
+    TFTPs_SIM_STATUS_DONE
+};
+                                                                /* Bulk, critical & default rd at a time.               */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_ClassShareTbl[] = {
+    { TFTPs_SIM_TEST_CLASS_BULK_SIZE, DEF_NO,   0u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_BULK_NAME, &TFTPs_SimTestClassBuf[0] },
+    { TFTPs_SIM_TEST_CLASS_BULK_SIZE, DEF_NO,   0u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_BULK_NAME, &TFTPs_SimTestClassBuf[0] },
+    { TFTPs_SIM_TEST_CLASS_CRIT_SIZE, DEF_NO,   0u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, TFTPs_SIM_TEST_CLASS_CRIT_NAME, &TFTPs_SimTestClassBuf[0] },
+    { TFTPs_SIM_TEST_CLASS_CRIT_SIZE, DEF_NO,   0u, 1428u, 8u, 1000u, 5u, { 10u, 0u, 0u, 0u, 0u, 0u },
+      DEF_NO, DEF_NULL,                       DEF_NULL                  }
+};
+
+static  const  TFTPs_SIM_TEST  TFTPs_SimTest_ClassTbl[] = {
+    TFTPs_SIM_TEST_ENTRY_EXT("class-reserve",      TFTPs_SimTest_ClassRsvdTbl,    0xA012u, 10000u,
+                             TFTPs_SimTest_ClassRsvdStatusTbl, TFTPs_SimTestClassCheck),
+    TFTPs_SIM_TEST_ENTRY_EXT("class-share",        TFTPs_SimTest_ClassShareTbl,   0xA123u, 10000u,
+                             DEF_NULL,                         TFTPs_SimTestClassCheck)
+};
+
+                                                                /* -------------- SHAPING (see Note #7) -------------- */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_ShapeRdTbl[] = { /* Windowed rd.                                         */
+    { 300000u, DEF_NO,  0u, 1428u, 8u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+                                                                /* Concurrent windowed rd.                              */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_ShapeRd2Tbl[] = {
+    { 100000u, DEF_NO,  0u, 1428u, 8u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL },
+    { 100000u, DEF_NO,  0u, 1428u, 8u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+                                                                /* Concurrent windowed rd.                              */
+static  const  TFTPs_SIM_CLIENT  TFTPs_SimTest_ShapeRd3Tbl[] = {
+    { 100000u, DEF_NO,  0u, 1428u, 8u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL },
+    { 100000u, DEF_NO,  0u, 1428u, 8u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL },
+    { 100000u, DEF_NO,  0u, 1428u, 8u, 1000u, 5u, { 10u, 0u,   0u,   0u,   0u,  0u }, DEF_NO, DEF_NULL, DEF_NULL }
+};
+
+static  const  TFTPs_SIM_TEST_SHAPE  TFTPs_SimTest_ShapeGlobal = {
+    100000u, 16384u, TFTPs_SHAPE_RATE_UNLIMITED, 0u
+};
+
+static  const  TFTPs_SIM_TEST_SHAPE  TFTPs_SimTest_ShapeClient = {
+    TFTPs_SHAPE_RATE_UNLIMITED, 0u, 50000u, 4096u
+};
+
+static  const  TFTPs_SIM_TEST_SHAPE  TFTPs_SimTest_ShapeBoth = {
+    120000u, 16384u, 50000u, 4096u
+};
+
+static  const  TFTPs_SIM_TEST  TFTPs_SimTest_ShapeTbl[] = {
+    TFTPs_SIM_TEST_ENTRY_SHAPE("shape-global",       TFTPs_SimTest_ShapeRdTbl,  0xF012u,  5000u,
+                               TFTPs_SimTest_ShapeGlobal),
+    TFTPs_SIM_TEST_ENTRY_SHAPE("shape-global-share", TFTPs_SimTest_ShapeRd3Tbl, 0xF123u,  5000u,
+                               TFTPs_SimTest_ShapeGlobal),
+    TFTPs_SIM_TEST_ENTRY_SHAPE("shape-client",       TFTPs_SimTest_ShapeRd2Tbl, 0xF234u,  5000u,
+                               TFTPs_SimTest_ShapeClient),
+    TFTPs_SIM_TEST_ENTRY_SHAPE("shape-both",         TFTPs_SimTest_ShapeRd3Tbl, 0xF345u,  5000u,
+                               TFTPs_SimTest_ShapeBoth)
+};
+
+static  const  TFTPs_SIM_TEST_SUITE  TFTPs_SimTestSuiteTbl[] = {
+    TFTPs_SIM_TEST_SUITE("transfer",           TFTPs_SimTest_TransferTbl,     DEF_NULL),
+    TFTPs_SIM_TEST_SUITE("shape",              TFTPs_SimTest_ShapeTbl,        DEF_NULL),
+    TFTPs_SIM_TEST_SUITE("class",              TFTPs_SimTest_ClassTbl,        TFTPs_SimTestClassInit),
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+    TFTPs_SIM_TEST_SUITE("lz4",                TFTPs_SimTest_LZ4_Tbl,         TFTPs_SimTestLZ4_Init),
+#endif
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+    TFTPs_SIM_TEST_SUITE("share",              TFTPs_SimTest_ShareTbl,        TFTPs_SimTestShareInit),
+#endif
+};
+
+
+/*
+*********************************************************************************************************
+*                                               main()
+*
+* Description : Run the scenarios of a suite of the tests.
+*
+* Argument(s) : argc        Nbr of arguments.
+*
+*               argv        Arguments : the name of the suite (see 'tftp-s_sim_test.c  Note #3').
+*
+* Return(s)   : EXIT_SUCCESS, if all the scenarios passed.
+*
+*               EXIT_FAILURE, otherwise.
+*
+* Caller(s)   : Host.
+*
+* Note(s)     : (1) The server is initialized with a copy of the template configuration (see 'tftp-s_cfg.h'),
+*                   as set by the suite.  With the single packet buffer, the copy serves a single session &
+*                   holds NO request, as the footprint profile states (see 'tftp-s_cfg.h  TFTPs MINIMAL
+*                   FOOTPRINT PROFILES').
+*********************************************************************************************************
+*/
+
+int  main (int    argc,
+           char  *argv[])
+{
+    const  TFTPs_SIM_TEST_SUITE  *p_suite;
+    const  CPU_CHAR              *p_name;
+           TFTPs_ERR              err;
+           CPU_INT16U             ix;
+           CPU_INT16U             fail_nbr;
+           CPU_BOOLEAN            ok;
+
+
+    p_name  = (argc > 1) ? argv[1] : TFTPs_SIM_TEST_SUITE_DFLT;
+    p_suite =  DEF_NULL;
+    for (ix = 0u; ix < sizeof(TFTPs_SimTestSuiteTbl) / sizeof(TFTPs_SIM_TEST_SUITE); ix++) {
+        if (strcmp(TFTPs_SimTestSuiteTbl[ix].NamePtr, p_name) == 0) {
+            p_suite = &TFTPs_SimTestSuiteTbl[ix];
+            break;
+        }
+    }
+    if (p_suite == DEF_NULL) {
+        printf("FAIL  suite \"%s\" NOT found\n", p_name);
+        return (EXIT_FAILURE);
+    }
+
+    TFTPs_SimTestCfg = TFTPs_Cfg;                               /* See Note #1.                                         */
+#if (TFTPs_CFG_BUF_SINGLE_EN == DEF_ENABLED)
+    TFTPs_SimTestCfg.SessNbrMax = 1u;
+    TFTPs_SimTestCfg.ReqQ_Size  = 0u;
+#endif
+    if (p_suite->InitFnct != DEF_NULL) {
+        ok = p_suite->InitFnct(&TFTPs_SimTestCfg);
+        if (ok != DEF_OK) {
+            printf("FAIL  suite \"%s\" NOT initialized\n", p_name);
+            return (EXIT_FAILURE);
+        }
+    }
+
+    (void)TFTPs_Init(&TFTPs_SimTestCfg, &TFTPs_TaskCfg, &err);
+    if (err != TFTPs_ERR_NONE) {
+        printf("FAIL  TFTPs_Init(), err %u\n", (unsigned)err);
+        return (EXIT_FAILURE);
+    }
+    TFTPs_En();
+
+    fail_nbr = 0u;
+    for (ix = 0u; ix < p_suite->TestNbr; ix++) {
+        ok = TFTPs_SimTestRun(&p_suite->TestTblPtr[ix]);
+        if (ok != DEF_OK) {
+            fail_nbr++;
+        }
+    }
+
+    printf("%u/%u scenarios passed\n",
+           (unsigned)(ix - fail_nbr),
+           (unsigned) ix);
+
+    return ((fail_nbr == 0u) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         TFTPs_SimTestRun()
+*
+* Description : Run a scenario twice & check its results.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+* Return(s)   : DEF_OK,   if the scenario passed (see 'tftp-s_sim_test.c  Note #2').
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimTestRun (const  TFTPs_SIM_TEST  *p_test)
+{
+    TFTPs_SIM_SCENARIO       scenario;
+    TFTPs_SIM_RESULT         result;
+    TFTPs_SIM_RESULT         result_again;
+    TFTPs_SIM_CLIENT_RESULT  client_result_tbl[TFTPs_SIM_TEST_CLIENT_NBR_MAX];
+    TFTPs_SIM_CLIENT_RESULT  client_result_again_tbl[TFTPs_SIM_TEST_CLIENT_NBR_MAX];
+    TFTPs_ERR                err;
+    CPU_BOOLEAN              ok;
+
+
+    scenario.ClientTblPtr = p_test->ClientTblPtr;
+    scenario.ClientNbr    = p_test->ClientNbr;
+    scenario.Seed         = p_test->Seed;
+    scenario.TimeMax      = TFTPs_SIM_TEST_TIME_MAX;
+
+    memset(&result,                  0, sizeof(result));
+    memset(&result_again,            0, sizeof(result_again));
+    memset(&client_result_tbl,       0, sizeof(client_result_tbl));
+    memset(&client_result_again_tbl, 0, sizeof(client_result_again_tbl));
+    result.ClientResultTblPtr       = &client_result_tbl[0];
+    result_again.ClientResultTblPtr = &client_result_again_tbl[0];
+
+    TFTPs_SimTestShapeSet(p_test, &err);
+    if (err != TFTPs_ERR_NONE) {
+        printf("FAIL  %-20s shaping NOT set, err %u\n", p_test->NamePtr, (unsigned)err);
+        return (DEF_FAIL);
+    }
+
+    HostFS_FileStatClr();                                       /* See TFTPs_SimTestShareCheck().                       */
+    TFTPs_SimRun(&scenario, &result, &err);
+    if (err != TFTPs_ERR_NONE) {
+        printf("FAIL  %-20s TFTPs_SimRun(), err %u\n", p_test->NamePtr, (unsigned)err);
+        return (DEF_FAIL);
+    }
+
+    ok = TFTPs_SimTestCheck(p_test, &result);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+                                                                /* See 'tftp-s_sim_test.c  Note #2d'.                   */
+    TFTPs_SimRun(&scenario, &result_again, &err);
+    if ((err                                    != TFTPs_ERR_NONE)                               ||
+        (result_again.Time                      != result.Time)                                  ||
+        (result_again.Octets                    != result.Octets)                                ||
+        (result_again.PktCtr                    != result.PktCtr)                                ||
+        (result_again.PktLostCtr                != result.PktLostCtr)                            ||
+        (memcmp(&client_result_again_tbl[0], &client_result_tbl[0], sizeof(client_result_tbl)) != 0)) {
+        printf("FAIL  %-20s run again gave other results\n", p_test->NamePtr);
+        return (DEF_FAIL);
+    }
+
+    printf("PASS  %-20s %6u ms, %7u octets, %5u pkts, %4u lost, %4u dup'd, %4u reordered\n",
+           p_test->NamePtr,
+           (unsigned)result.Time,
+           (unsigned)result.Octets,
+           (unsigned)result.PktCtr,
+           (unsigned)result.PktLostCtr,
+           (unsigned)result.PktDupCtr,
+           (unsigned)result.PktReorderCtr);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimTestCheck()
+*
+* Description : Check the results of a scenario against the outcome expected.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+*               p_result    Pointer to results of the scenario.
+*
+* Return(s)   : DEF_OK,   if the results are those expected (see 'tftp-s_sim_test.c  Note #2').
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_SimTestRun().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimTestCheck (const  TFTPs_SIM_TEST    *p_test,
+                                         const  TFTPs_SIM_RESULT  *p_result)
+{
+    const  TFTPs_SIM_CLIENT         *p_client;
+    const  TFTPs_SIM_CLIENT_RESULT  *p_client_result;
+           TFTPs_SIM_STATUS          status_exp;
+           CPU_INT32U                octets_exp;
+           CPU_INT32U                loss_rate;
+           CPU_INT32U                dup_rate;
+           CPU_INT32U                reorder_rate;
+           CPU_INT16U                ix;
+           CPU_BOOLEAN               ok;
+
+
+    loss_rate    = 0u;
+    dup_rate     = 0u;
+    reorder_rate = 0u;
+    for (ix = 0u; ix < p_test->ClientNbr; ix++) {               /* See 'tftp-s_sim_test.c  Note #2a'.                   */
+        p_client        = &p_test->ClientTblPtr[ix];
+        p_client_result = &p_result->ClientResultTblPtr[ix];
+        status_exp      =  TFTPs_SimTestStatusGet(p_test, ix);
+        octets_exp      = (status_exp == TFTPs_SIM_STATUS_DONE) ? p_client->FileSize : 0u;
+        if ((p_client_result->Status != status_exp) ||
+            (p_client_result->Octets != octets_exp)) {
+            printf("FAIL  %-20s client #%u : status %u, %u of %u octets, expected status %u, %u octets\n",
+                   p_test->NamePtr,
+                   (unsigned)ix,
+                   (unsigned)p_client_result->Status,
+                   (unsigned)p_client_result->Octets,
+                   (unsigned)p_client->FileSize,
+                   (unsigned)status_exp,
+                   (unsigned)octets_exp);
+            return (DEF_FAIL);
+        }
+        if (status_exp != TFTPs_SIM_STATUS_DONE) {
+            continue;
+        }
+        loss_rate    += p_client->Link.LossRate;
+        dup_rate     += p_client->Link.DupRate;
+        reorder_rate += p_client->Link.ReorderRate;
+    }
+
+    if (p_result->Time > p_test->TimeExp) {                     /* See 'tftp-s_sim_test.c  Note #2b'.                   */
+        printf("FAIL  %-20s done in %u ms, expected within %u ms\n",
+               p_test->NamePtr,
+               (unsigned)p_result->Time,
+               (unsigned)p_test->TimeExp);
+        return (DEF_FAIL);
+    }
+                                                                /* See 'tftp-s_sim_test.c  Note #2c'.                   */
+    if (((loss_rate    > 0u) && (p_result->PktLostCtr    == 0u)) ||
+        ((dup_rate     > 0u) && (p_result->PktDupCtr     == 0u)) ||
+        ((reorder_rate > 0u) && (p_result->PktReorderCtr == 0u))) {
+        printf("FAIL  %-20s link events NOT simulated\n", p_test->NamePtr);
+        return (DEF_FAIL);
+    }
+
+    if (p_test->CheckFnct != DEF_NULL) {                        /* See 'tftp-s_sim_test.c  Note #2e'.                   */
+        ok = p_test->CheckFnct(p_test, p_result);
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestStatusGet()
+*
+* Description : Get the status expected of a client of a scenario.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+*               client_ix   Index of the client in the scenario.
+*
+* Return(s)   : Status expected (see 'tftp-s_sim_test.c  Note #2a').
+*
+* Caller(s)   : TFTPs_SimTestCheck().
+*
+* Note(s)     : (1) A write request is refused when writes are disabled (see 'tftp-s.c  Note #12').
+*********************************************************************************************************
+*/
+
+static  TFTPs_SIM_STATUS  TFTPs_SimTestStatusGet (const  TFTPs_SIM_TEST  *p_test,
+                                                         CPU_INT16U       client_ix)
+{
+    if (p_test->StatusTblPtr != DEF_NULL) {
+        return (p_test->StatusTblPtr[client_ix]);
+    }
+
+#if (TFTPs_CFG_WR_EN != DEF_ENABLED)
+    if (p_test->ClientTblPtr[client_ix].Wr == DEF_YES) {        /* See Note #1.                                         */
+        return (TFTPs_SIM_STATUS_ERR_PKT);
+    }
+#endif
+
+    return (TFTPs_SIM_STATUS_DONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimTestShapeSet()
+*
+* Description : Set the shaping of a scenario.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPs_ERR_NONE
+*
+*                               ------- RETURNED BY TFTPs_ShapeGlobalSet() : -------
+*                               See TFTPs_ShapeGlobalSet() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimTestRun().
+*
+* Note(s)     : (1) A scenario without shaping of its own runs with the shaping of the configuration, so
+*                   that it does NOT depend on the scenarios run before it.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimTestShapeSet (const  TFTPs_SIM_TEST  *p_test,
+                                            TFTPs_ERR       *p_err)
+{
+    const  TFTPs_SIM_TEST_SHAPE  *p_shape;
+           TFTPs_SIM_TEST_SHAPE   shape_cfg;
+
+
+    p_shape = p_test->ShapePtr;
+    if (p_shape == DEF_NULL) {                                  /* See Note #1.                                         */
+        shape_cfg.RateGlobal  = TFTPs_SimTestCfg.ShapeRateGlobal;
+        shape_cfg.BurstGlobal = TFTPs_SimTestCfg.ShapeBurstGlobal;
+        shape_cfg.RateClient  = TFTPs_SimTestCfg.ShapeRateClient;
+        shape_cfg.BurstClient = TFTPs_SimTestCfg.ShapeBurstClient;
+        p_shape               = &shape_cfg;
+    }
+
+    TFTPs_ShapeGlobalSet(p_shape->RateGlobal, p_shape->BurstGlobal, p_err);
+    if (*p_err != TFTPs_ERR_NONE) {
+        return;
+    }
+
+    TFTPs_ShapeClientSet(p_shape->RateClient, p_shape->BurstClient, p_err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestShapeCheck()
+*
+* Description : Check the times of the transfers of a scenario against the rates of its shaping.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+*               p_result    Pointer to results of the scenario.
+*
+* Return(s)   : DEF_OK,   if the transfers lasted as long as the rates bound them to, but NOT much longer.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_SimTestCheck(), via the scenarios of the suite "shape".
+*
+* Note(s)     : (1) See 'tftp-s_sim_test.c  LOCAL CONSTANTS  Note #7'.
+*
+*               (2) The global bound applies to the time of the last client done, from the start of the run.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimTestShapeCheck (const  TFTPs_SIM_TEST    *p_test,
+                                              const  TFTPs_SIM_RESULT  *p_result)
+{
+    const  TFTPs_SIM_TEST_SHAPE     *p_shape;
+    const  TFTPs_SIM_CLIENT         *p_client;
+    const  TFTPs_SIM_CLIENT_RESULT  *p_client_result;
+           CPU_INT32U                octets;
+           CPU_INT32U                time_min;
+           CPU_INT32U                time_bound;
+           CPU_INT32U                time_max;
+           CPU_INT16U                ix;
+
+
+    p_shape    = p_test->ShapePtr;
+    octets     = 0u;
+    time_bound = 0u;
+    for (ix = 0u; ix < p_test->ClientNbr; ix++) {               /* Bound of each client (see Note #1).                  */
+        p_client        = &p_test->ClientTblPtr[ix];
+        p_client_result = &p_result->ClientResultTblPtr[ix];
+        octets         +=  p_client_result->Octets;
+        if (p_shape->RateClient == TFTPs_SHAPE_RATE_UNLIMITED) {
+            continue;
+        }
+
+        time_min = TFTPs_SimTestShapeTimeMin(p_client_result->Octets, p_shape->RateClient, p_shape->BurstClient);
+        if (p_client_result->Time < time_min) {
+            printf("FAIL  %-20s client #%u done in %u ms, within its rate bound of %u ms\n",
+                   p_test->NamePtr,
+                   (unsigned)ix,
+                   (unsigned)p_client_result->Time,
+                   (unsigned)time_min);
+            return (DEF_FAIL);
+        }
+        time_bound = DEF_MAX(time_bound, p_client->StartTime + time_min);
+    }
+
+    if (p_shape->RateGlobal != TFTPs_SHAPE_RATE_UNLIMITED) {    /* Bound of all clients (see Note #2).                  */
+        time_min = TFTPs_SimTestShapeTimeMin(octets, p_shape->RateGlobal, p_shape->BurstGlobal);
+        if (p_result->Time < time_min) {
+            printf("FAIL  %-20s done in %u ms, within the global rate bound of %u ms\n",
+                   p_test->NamePtr,
+                   (unsigned)p_result->Time,
+                   (unsigned)time_min);
+            return (DEF_FAIL);
+        }
+        time_bound = DEF_MAX(time_bound, time_min);
+    }
+
+    time_max = time_bound * TFTPs_SIM_TEST_SHAPE_TIME_PCT / 100u + TFTPs_SIM_TEST_SHAPE_TIME_MARGIN;
+    if (p_result->Time > time_max) {
+        printf("FAIL  %-20s done in %u ms, expected within %u ms for a rate bound of %u ms\n",
+               p_test->NamePtr,
+               (unsigned)p_result->Time,
+               (unsigned)time_max,
+               (unsigned)time_bound);
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_SimTestShapeTimeMin()
+*
+* Description : Get the least time a transfer through a token bucket can last.
+*
+* Argument(s) : octets      Number of octets transferred.
+*
+*               rate        Rate of the bucket, in octets per second.
+*
+*               burst       Burst size of the bucket, in octets.
+*
+* Return(s)   : Least time of the transfer, in ms.
+*
+* Caller(s)   : TFTPs_SimTestShapeCheck().
+*
+* Note(s)     : (1) A bucket starts full : a transfer sends its first 'burst' octets at once, & the others
+*                   at 'rate' octets per second at most.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TFTPs_SimTestShapeTimeMin (CPU_INT32U  octets,
+                                               CPU_INT32U  rate,
+                                               CPU_INT32U  burst)
+{
+    CPU_INT64U  octets_ms;
+
+
+    if (octets <= burst) {                                      /* See Note #1.                                         */
+        return (0u);
+    }
+
+    octets_ms = (CPU_INT64U)(octets - burst) * 1000u;
+
+    return ((CPU_INT32U)(octets_ms / rate));
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimTestFileWr()
+*
+* Description : Store a file in the file system, for the clients of a suite to read.
+*
+* Argument(s) : p_name      Pointer to the name of the file.
+*
+*               p_data      Pointer to the data of the file.
+*
+*               size        Size of the file, in octets.
+*
+* Return(s)   : DEF_OK,   if the file is stored.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Suite init functions.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimTestFileWr (const  CPU_CHAR    *p_name,
+                                          const  CPU_INT08U  *p_data,
+                                                 CPU_INT32U   size)
+{
+    void         *p_file;
+    CPU_SIZE_T    size_wr;
+    CPU_BOOLEAN   ok;
+
+
+    p_file = NetFS_FileOpen((CPU_CHAR *)p_name, NET_FS_FILE_MODE_CREATE, NET_FS_FILE_ACCESS_WR);
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    ok = NetFS_FileWr(p_file, (void *)p_data, size, &size_wr);
+    NetFS_FileClose(p_file);
+    if ((ok      != DEF_OK) ||
+        (size_wr != size)) {
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPs_SimTestRandGen()
+*
+* Description : Generate pseudo-random file data.
+*
+* Argument(s) : p_buf       Pointer to the buffer to fill.
+*
+*               size        Size of the buffer, in octets.
+*
+*               p_seed      Pointer to the state of the generator (xorshift32), NOT null.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Suite init functions.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPs_SimTestRandGen (CPU_INT08U  *p_buf,
+                                    CPU_INT32U   size,
+                                    CPU_INT32U  *p_seed)
+{
+    CPU_INT32U  rand;
+    CPU_INT32U  ix;
+
+
+    rand = *p_seed;
+    for (ix = 0u; ix < size; ix++) {
+        rand      ^= rand << 13;
+        rand      ^= rand >> 17;
+        rand      ^= rand <<  5;
+        p_buf[ix]  = (CPU_INT08U)(rand >> 24);
+    }
+   *p_seed = rand;
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestClassInit()
+*
+* Description : Initialize the suite "class" (see 'tftp-s_sim_test.c  LOCAL CONSTANTS  Note #8').
+*
+* Argument(s) : p_cfg       Pointer to the configuration of the server.
+*
+* Return(s)   : DEF_OK,   if the files are stored.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main(), via TFTPs_SimTestSuiteTbl.
+*
+* Note(s)     : (1) The bandwidth share of a class applies to the global rate, that MUST thus be limited
+*                   (see 'tftp-s_type.h  TRAFFIC CLASS CONFIGURATION DATA TYPE  Note #5').
+*
+*               (2) Each session gets a buffer of the block size it requests (see 'TFTPs_SimTestShareInit()
+*                   Note #1').
+*
+*               (3) The file of the critical class is the start of the file of the bulk class.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimTestClassInit (TFTPs_CFG  *p_cfg)
+{
+    CPU_INT32U   seed;
+    CPU_BOOLEAN  ok;
+
+
+    p_cfg->SessNbrMax       = TFTPs_SIM_TEST_CLASS_SESS_NBR;
+    p_cfg->Buf1428Nbr       = TFTPs_SIM_TEST_CLASS_SESS_NBR;    /* See Note #2.                                         */
+    p_cfg->ShapeRateGlobal  = TFTPs_SIM_TEST_CLASS_RATE;        /* See Note #1.                                         */
+    p_cfg->ShapeBurstGlobal = TFTPs_SIM_TEST_CLASS_BURST;
+    p_cfg->ClassTblPtr      = &TFTPs_SimTest_ClassCfgTbl[0];
+    p_cfg->ClassNbr         = (CPU_INT08U)(sizeof(TFTPs_SimTest_ClassCfgTbl) / sizeof(TFTPs_CLASS_CFG));
+
+    seed = TFTPs_SIM_TEST_RAND_SEED;
+    TFTPs_SimTestRandGen(&TFTPs_SimTestClassBuf[0], TFTPs_SIM_TEST_CLASS_BULK_SIZE, &seed);
+    ok = TFTPs_SimTestFileWr(TFTPs_SIM_TEST_CLASS_BULK_NAME,
+                            &TFTPs_SimTestClassBuf[0],
+                             TFTPs_SIM_TEST_CLASS_BULK_SIZE);
+    if (ok == DEF_OK) {                                         /* See Note #3.                                         */
+        ok = TFTPs_SimTestFileWr(TFTPs_SIM_TEST_CLASS_CRIT_NAME,
+                                &TFTPs_SimTestClassBuf[0],
+                                 TFTPs_SIM_TEST_CLASS_CRIT_SIZE);
+    }
+    if (ok != DEF_OK) {
+        printf("FAIL  class files NOT stored\n");
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestClassCheck()
+*
+* Description : Check the times of the transfers of a scenario against the traffic classes of the clients.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+*               p_result    Pointer to results of the scenario.
+*
+* Return(s)   : DEF_OK,   if the bulk class kept to its share, & was done last.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_SimTestCheck(), via the scenarios of the suite "class".
+*
+* Note(s)     : (1) The sessions of the bulk class share a class bucket, whose rate & burst size are the
+*                   share of the global ones (see 'tftp-s_shape.c  Note #3') : the clients of the class
+*                   are done no sooner than the bound of that bucket, & within the margins of the suite
+*                   "shape" (see 'tftp-s_sim_test.c  LOCAL CONSTANTS  Note #7') as long as the other
+*                   classes leave it its share.
+*
+*               (2) A client is done 'Time' ms after its request (see 'tftp-s_type.h  SIMULATION RESULT
+*                   DATA TYPES  Note #2').  Each client of the other classes MUST be done before the first
+*                   client of the bulk class.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPs_SimTestClassCheck (const  TFTPs_SIM_TEST    *p_test,
+                                              const  TFTPs_SIM_RESULT  *p_result)
+{
+    const  TFTPs_SIM_CLIENT         *p_client;
+    const  TFTPs_SIM_CLIENT_RESULT  *p_client_result;
+           CPU_INT32U                octets_bulk;
+           CPU_INT32U                time_done;
+           CPU_INT32U                time_bulk_first;
+           CPU_INT32U                time_bulk_last;
+           CPU_INT32U                time_other_last;
+           CPU_INT32U                time_min;
+           CPU_INT32U                time_max;
+           CPU_INT16U                ix;
+           CPU_BOOLEAN               bulk;
+
+
+    octets_bulk     = 0u;
+    time_bulk_first = DEF_INT_32U_MAX_VAL;
+    time_bulk_last  = 0u;
+    time_other_last = 0u;
+    for (ix = 0u; ix < p_test->ClientNbr; ix++) {
+        p_client        = &p_test->ClientTblPtr[ix];
+        p_client_result = &p_result->ClientResultTblPtr[ix];
+        if (p_client_result->Status != TFTPs_SIM_STATUS_DONE) {
+            continue;
+        }
+
+        time_done = p_client->StartTime + p_client_result->Time;/* See Note #2.                                         */
+        bulk      = DEF_NO;
+        if (p_client->FileNamePtr != DEF_NULL) {
+            bulk  = (strcmp(p_client->FileNamePtr, TFTPs_SIM_TEST_CLASS_BULK_NAME) == 0) ? DEF_YES : DEF_NO;
+        }
+
+        if (bulk == DEF_YES) {
+            octets_bulk    += p_client_result->Octets;
+            time_bulk_first = DEF_MIN(time_bulk_first, time_done);
+            time_bulk_last  = DEF_MAX(time_bulk_last,  time_done);
+        } else {
+            time_other_last = DEF_MAX(time_other_last, time_done);
+        }
+    }
+                                                                /* See Note #1.                                         */
+    time_min = TFTPs_SimTestShapeTimeMin(octets_bulk,
+                                         TFTPs_SIM_TEST_CLASS_RATE  * TFTPs_SIM_TEST_CLASS_BULK_PCT / 100u,
+                                         TFTPs_SIM_TEST_CLASS_BURST * TFTPs_SIM_TEST_CLASS_BULK_PCT / 100u);
+    time_max = time_min * TFTPs_SIM_TEST_SHAPE_TIME_PCT / 100u + TFTPs_SIM_TEST_SHAPE_TIME_MARGIN;
+    if ((time_bulk_last < time_min) ||
+        (time_bulk_last > time_max)) {
+        printf("FAIL  %-20s bulk class done in %u ms, expected within %u..%u ms\n",
+               p_test->NamePtr,
+               (unsigned)time_bulk_last,
+               (unsigned)time_min,
+               (unsigned)time_max);
+        return (DEF_FAIL);
+    }
+
+    if (time_other_last >= time_bulk_first) {                   /* See Note #2.                                         */
+        printf("FAIL  %-20s other classes done in %u ms, after bulk class client done in %u ms\n",
+               p_test->NamePtr,
+               (unsigned)time_other_last,
+               (unsigned)time_bulk_first);
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestShareInit()
+*
+* Description : Initialize the suite "share" (see 'tftp-s_sim_test.c  LOCAL CONSTANTS  Note #6').
+*
+* Argument(s) : p_cfg       Pointer to the configuration of the server.
+*
+* Return(s)   : DEF_OK,   if the file is stored.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main(), via TFTPs_SimTestSuiteTbl.
+*
+* Note(s)     : (1) Each session gets a buffer of the block size it requests, so that the clients requesting
+*                   the same options read the file at the same pace (see 'tftp-s_type.h  CONFIGURATION DATA
+*                   TYPE  Note #5').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_SimTestShareInit (TFTPs_CFG  *p_cfg)
+{
+    CPU_INT32U   seed;
+    CPU_BOOLEAN  ok;
+
+                                                                /* See Note #1.                                         */
+    p_cfg->Buf1428Nbr = DEF_MAX(p_cfg->Buf1428Nbr, p_cfg->SessNbrMax);
+
+    seed = TFTPs_SIM_TEST_RAND_SEED;
+    TFTPs_SimTestRandGen(&TFTPs_SimTestShareBuf[0], TFTPs_SIM_TEST_SHARE_SIZE, &seed);
+    ok = TFTPs_SimTestFileWr(TFTPs_SIM_TEST_SHARE_NAME, &TFTPs_SimTestShareBuf[0], TFTPs_SIM_TEST_SHARE_SIZE);
+    if (ok != DEF_OK) {
+        printf("FAIL  shared file NOT stored\n");
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestShareCheck()
+*
+* Description : Check that the file read by all the clients of a scenario was opened once.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+*               p_result    Pointer to results of the scenario.
+*
+* Return(s)   : DEF_OK,   if the file was opened once.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_SimTestCheck(), via the scenarios of the suite "share",
+*               TFTPs_SimTestShareStreamCheck().
+*
+* Note(s)     : (1) The clients read the file through a single handle (see 'tftp-s_fs.c  Note #6').
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_SimTestShareCheck (const  TFTPs_SIM_TEST    *p_test,
+                                              const  TFTPs_SIM_RESULT  *p_result)
+{
+    CPU_INT32U   open_ctr;
+    CPU_INT32U   rd_ctr;
+    CPU_BOOLEAN  ok;
+
+
+    (void)p_result;
+
+    ok = HostFS_FileStatGet(TFTPs_SIM_TEST_SHARE_NAME, &open_ctr, &rd_ctr);
+    if (ok != DEF_OK) {
+        printf("FAIL  %-20s shared file NOT found\n", p_test->NamePtr);
+        return (DEF_FAIL);
+    }
+
+    if (open_ctr != 1u) {                                       /* See Note #1.                                         */
+        printf("FAIL  %-20s shared file opened %u times\n", p_test->NamePtr, (unsigned)open_ctr);
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPs_SimTestShareStreamCheck()
+*
+* Description : Check that the file read by all the clients of a scenario was opened once, & read from
+*               storage once when streamed.
+*
+* Argument(s) : p_test      Pointer to scenario.
+*
+*               p_result    Pointer to results of the scenario.
+*
+* Return(s)   : DEF_OK,   if the file was accessed as expected.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_SimTestCheck(), via the scenarios of the suite "share".
+*
+* Note(s)     : (1) The clients request the same options at nearby times, & read the file at nearby
+*                   positions : each chunk of the stream is read from storage once, & copied to all of them
+*                   (see 'tftp-s_fs.c  Note #7').  Without a stream, each client reads the whole file.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_HANDLE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_SimTestShareStreamCheck (const  TFTPs_SIM_TEST    *p_test,
+                                                    const  TFTPs_SIM_RESULT  *p_result)
+{
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)
+    CPU_INT32U   open_ctr;
+    CPU_INT32U   rd_ctr;
+#endif
+    CPU_BOOLEAN  ok;
+
+
+    ok = TFTPs_SimTestShareCheck(p_test, p_result);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+
+#if (TFTPs_CFG_FS_STREAM_EN == DEF_ENABLED)                     /* See Note #1.                                         */
+    (void)HostFS_FileStatGet(TFTPs_SIM_TEST_SHARE_NAME, &open_ctr, &rd_ctr);
+    if (rd_ctr != TFTPs_SIM_TEST_SHARE_SIZE) {
+        printf("FAIL  %-20s shared file read %u octets\n", p_test->NamePtr, (unsigned)rd_ctr);
+        return (DEF_FAIL);
+    }
+#endif
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimTestLZ4_Init()
+*
+* Description : Initialize the suite "lz4" (see 'tftp-s_sim_test.c  LOCAL CONSTANTS  Note #5').
+*
+* Argument(s) : p_cfg       Pointer to the configuration of the server.
+*
+* Return(s)   : DEF_OK,   if the files are stored.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main(), via TFTPs_SimTestSuiteTbl.
+*
+* Note(s)     : (1) The compressible file MUST compress to less than half its size, & the other one NOT at
+*                   all, so that the clients read back both compressed & uncompressed blocks.
+*
+*               (2) The clients read both files at a time, each with a decoder of its own.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_SimTestLZ4_Init (TFTPs_CFG  *p_cfg)
+{
+    CPU_INT32U   seed;
+    CPU_INT32U   text_frame_size;
+    CPU_INT32U   rand_frame_size;
+    CPU_BOOLEAN  ok;
+
+
+    seed = TFTPs_SIM_TEST_RAND_SEED;
+    TFTPs_SimTestLZ4_TextGen(&TFTPs_SimTestLZ4_TextBuf[0], TFTPs_SIM_TEST_LZ4_TEXT_SIZE, &seed);
+    TFTPs_SimTestRandGen(&TFTPs_SimTestLZ4_RandBuf[0], TFTPs_SIM_TEST_LZ4_RAND_SIZE, &seed);
+
+    ok = TFTPs_SimTestLZ4_FileWr(TFTPs_SIM_TEST_LZ4_TEXT_NAME TFTPs_SIM_TEST_LZ4_EXT,
+                                &TFTPs_SimTestLZ4_TextBuf[0],
+                                 TFTPs_SIM_TEST_LZ4_TEXT_SIZE,
+                                &text_frame_size);
+    if (ok == DEF_OK) {
+        ok = TFTPs_SimTestLZ4_FileWr(TFTPs_SIM_TEST_LZ4_RAND_NAME TFTPs_SIM_TEST_LZ4_EXT,
+                                    &TFTPs_SimTestLZ4_RandBuf[0],
+                                     TFTPs_SIM_TEST_LZ4_RAND_SIZE,
+                                    &rand_frame_size);
+    }
+    if (ok != DEF_OK) {
+        printf("FAIL  LZ4 files NOT stored\n");
+        return (DEF_FAIL);
+    }
+                                                                /* See Note #1.                                         */
+    printf("      LZ4 files : %u octets framed in %u, %u octets framed in %u\n",
+           (unsigned)TFTPs_SIM_TEST_LZ4_TEXT_SIZE,
+           (unsigned)text_frame_size,
+           (unsigned)TFTPs_SIM_TEST_LZ4_RAND_SIZE,
+           (unsigned)rand_frame_size);
+    if ((text_frame_size >= TFTPs_SIM_TEST_LZ4_TEXT_SIZE / 2u) ||
+        (rand_frame_size <  TFTPs_SIM_TEST_LZ4_RAND_SIZE)) {
+        printf("FAIL  LZ4 files NOT compressed as expected\n");
+        return (DEF_FAIL);
+    }
+
+    p_cfg->LZ4_DecNbr = 2u;                                     /* See Note #2.                                         */
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPs_SimTestLZ4_TextGen()
+*
+* Description : Generate compressible file data, i.e. lines of words picked at random.
+*
+* Argument(s) : p_buf       Pointer to the buffer to fill.
+*
+*               size        Size of the buffer, in octets.
+*
+*               p_seed      Pointer to the state of the generator, NOT null.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimTestLZ4_Init().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  void  TFTPs_SimTestLZ4_TextGen (CPU_INT08U  *p_buf,
+                                        CPU_INT32U   size,
+                                        CPU_INT32U  *p_seed)
+{
+    static  const  CPU_CHAR  *word_tbl[] = {
+        "block ", "window ", "server ", "client ", "option ", "transfer ", "timeout ", "file\n"
+    };
+    const  CPU_CHAR    *p_word;
+           CPU_INT08U   rand;
+           CPU_INT32U   len;
+           CPU_INT32U   ix;
+
+
+    ix = 0u;
+    while (ix < size) {
+        TFTPs_SimTestRandGen(&rand, 1u, p_seed);
+        p_word = word_tbl[rand % (sizeof(word_tbl) / sizeof(word_tbl[0]))];
+        len    = DEF_MIN((CPU_INT32U)strlen(p_word), size - ix);
+        memcpy(&p_buf[ix], p_word, len);
+        ix    += len;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestLZ4_FileWr()
+*
+* Description : Store a file as an LZ4 frame.
+*
+* Argument(s) : p_name          Pointer to the name of the file.
+*
+*               p_data          Pointer to the data to compress.
+*
+*               size            Size of the data, in octets.
+*
+*               p_frame_size    Pointer to a variable that will receive the size of the frame, in octets.
+*
+* Return(s)   : DEF_OK,   if the file is stored.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPs_SimTestLZ4_Init().
+*
+* Note(s)     : (1) The frame is decoded by the server (see 'tftp-s_lz4.c  Note #1') : its blocks are
+*                   independent, & the content size is set.  The frame is a standard one, e.g. decoded
+*                   the same by the 'lz4' tool, although the server skips its header checksum.
+*
+*               (2) A block that does NOT compress is stored uncompressed.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_SimTestLZ4_FileWr (const  CPU_CHAR    *p_name,
+                                              const  CPU_INT08U  *p_data,
+                                                     CPU_INT32U   size,
+                                                     CPU_INT32U  *p_frame_size)
+{
+    CPU_INT08U  *p_frame;
+    CPU_INT32U   frame_len;
+    CPU_INT32U   blk_len;
+    CPU_INT32U   enc_len;
+    CPU_INT32U   off;
+
+
+    p_frame = &TFTPs_SimTestLZ4_FrameBuf[0];                    /* See Note #1.                                         */
+    TFTPs_SimTestLE32_Wr(&p_frame[0], TFTPs_SIM_TEST_LZ4_MAGIC);
+    p_frame[4] = TFTPs_SIM_TEST_LZ4_FLG;
+    p_frame[5] = TFTPs_SIM_TEST_LZ4_BD;
+    TFTPs_SimTestLE32_Wr(&p_frame[6],  size);
+    TFTPs_SimTestLE32_Wr(&p_frame[10], 0u);
+    p_frame[14] = TFTPs_SimTestLZ4_HdrChkSum(&p_frame[4], TFTPs_SIM_TEST_LZ4_DESC_SIZE);
+    frame_len   = TFTPs_SIM_TEST_LZ4_HDR_SIZE;
+
+    for (off = 0u; off < size; off += blk_len) {
+        blk_len = DEF_MIN(size - off, TFTPs_SIM_TEST_LZ4_BLK_SIZE);
+        if (frame_len + blk_len + 2u * sizeof(CPU_INT32U) > TFTPs_SIM_TEST_LZ4_FRAME_SIZE_MAX) {
+            return (DEF_FAIL);
+        }
+        enc_len = TFTPs_SimTestLZ4_BlkEnc(&p_data[off], blk_len, &p_frame[frame_len + sizeof(CPU_INT32U)]);
+        if (enc_len < blk_len) {
+            TFTPs_SimTestLE32_Wr(&p_frame[frame_len], enc_len);
+        } else {                                                /* See Note #2.                                         */
+            TFTPs_SimTestLE32_Wr(&p_frame[frame_len], blk_len | TFTPs_SIM_TEST_LZ4_BLK_RAW);
+            memcpy(&p_frame[frame_len + sizeof(CPU_INT32U)], &p_data[off], blk_len);
+            enc_len = blk_len;
+        }
+        frame_len += sizeof(CPU_INT32U) + enc_len;
+    }
+    TFTPs_SimTestLE32_Wr(&p_frame[frame_len], 0u);              /* EndMark.                                             */
+    frame_len += sizeof(CPU_INT32U);
+
+   *p_frame_size = frame_len;
+
+    return (TFTPs_SimTestFileWr(p_name, p_frame, frame_len));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestLZ4_BlkEnc()
+*
+* Description : Compress a block of an LZ4 frame.
+*
+* Argument(s) : p_src       Pointer to the data of the block.
+*
+*               src_len     Size of the data, in octets.
+*
+*               p_dest      Pointer to the buffer that will receive the compressed block, of 'src_len'
+*                           octets.
+*
+* Return(s)   : Size of the compressed block, in octets, or 'src_len' if the block does NOT compress.
+*
+* Caller(s)   : TFTPs_SimTestLZ4_FileWr().
+*
+* Note(s)     : (1) The compression is greedy : each position is looked up in a hash table of the last
+*                   position of its first 4 octets, & a match found is extended as far as it goes.
+*
+*               (2) As the LZ4 block format requires, the last match starts at least 12 octets before the
+*                   end of the block, & the block ends with at least 5 literals.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  CPU_INT32U  TFTPs_SimTestLZ4_BlkEnc (const  CPU_INT08U  *p_src,
+                                                    CPU_INT32U   src_len,
+                                                    CPU_INT08U  *p_dest)
+{
+    CPU_INT32U   src_ix;
+    CPU_INT32U   dest_ix;
+    CPU_INT32U   lit_ix;
+    CPU_INT32U   match_ix;
+    CPU_INT32U   match_len;
+    CPU_INT32U   seq;
+    CPU_INT32U   hash;
+    CPU_BOOLEAN  ok;
+
+
+    memset(&TFTPs_SimTestLZ4_HashTbl[0], 0, sizeof(TFTPs_SimTestLZ4_HashTbl));
+    src_ix  = 0u;
+    dest_ix = 0u;
+    lit_ix  = 0u;
+                                                                /* See Notes #1 & #2.                                   */
+    while (src_ix + TFTPs_SIM_TEST_LZ4_MATCH_END_MIN <= src_len) {
+        memcpy(&seq, &p_src[src_ix], sizeof(seq));
+        hash     = (seq * 2654435761u) >> (32u - TFTPs_SIM_TEST_LZ4_HASH_BITS);
+        match_ix =  TFTPs_SimTestLZ4_HashTbl[hash];             /* Pos + 1 of last seq of same hash, 0 if none.         */
+        TFTPs_SimTestLZ4_HashTbl[hash] = src_ix + 1u;
+
+        if ((match_ix                  ==  0u)                                 ||
+            (src_ix - (match_ix - 1u)  >   TFTPs_SIM_TEST_LZ4_MATCH_OFF_MAX)   ||
+            (memcmp(&p_src[match_ix - 1u], &p_src[src_ix], TFTPs_SIM_TEST_LZ4_MATCH_LEN_MIN) != 0)) {
+            src_ix++;
+            continue;
+        }
+        match_ix--;
+
+        match_len = TFTPs_SIM_TEST_LZ4_MATCH_LEN_MIN;
+        while ((src_ix + match_len           <  src_len - TFTPs_SIM_TEST_LZ4_LIT_LAST_MIN) &&
+               (p_src[match_ix + match_len] ==  p_src[src_ix + match_len])) {
+            match_len++;
+        }
+
+        ok = TFTPs_SimTestLZ4_SeqWr(p_dest, &dest_ix, src_len,
+                                   &p_src[lit_ix], src_ix - lit_ix,
+                                    src_ix - match_ix, match_len);
+        if (ok != DEF_OK) {
+            return (src_len);
+        }
+        src_ix += match_len;
+        lit_ix  = src_ix;
+    }
+                                                                /* Last literals.                                       */
+    ok = TFTPs_SimTestLZ4_SeqWr(p_dest, &dest_ix, src_len, &p_src[lit_ix], src_len - lit_ix, 0u, 0u);
+    if (ok != DEF_OK) {
+        return (src_len);
+    }
+
+    return (dest_ix);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPs_SimTestLZ4_SeqWr()
+*
+* Description : Write a sequence of an LZ4 block : a token, literals & a match.
+*
+* Argument(s) : p_dest      Pointer to the block.
+*
+*               p_dest_ix   Pointer to the index of the sequence in the block, advanced past it.
+*
+*               dest_len    Size of the block buffer, in octets.
+*
+*               p_lit       Pointer to the literals.
+*
+*               lit_len     Number of literals.
+*
+*               match_off   Offset of the match, back from its position.
+*
+*               match_len   Length of the match, or 0 for the last sequence of the block.
+*
+* Return(s)   : DEF_OK,   if the sequence is written.
+*
+*               DEF_FAIL, if the block buffer is too small.
+*
+* Caller(s)   : TFTPs_SimTestLZ4_BlkEnc().
+*
+* Note(s)     : (1) A literal or match length of 15 or more continues in octets after the token, each of
+*                   255 but the last.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPs_SimTestLZ4_SeqWr (       CPU_INT08U  *p_dest,
+                                                    CPU_INT32U  *p_dest_ix,
+                                                    CPU_INT32U   dest_len,
+                                             const  CPU_INT08U  *p_lit,
+                                                    CPU_INT32U   lit_len,
+                                                    CPU_INT32U   match_off,
+                                                    CPU_INT32U   match_len)
+{
+    CPU_INT32U  dest_ix;
+    CPU_INT32U  token_ix;
+    CPU_INT32U  len;
+    CPU_INT08U  token;
+
+                                                                /* Max size of sequence.                                */
+    len = 1u + lit_len / 255u + 1u + lit_len + 2u + match_len / 255u + 1u;
+    if (*p_dest_ix + len > dest_len) {
+        return (DEF_FAIL);
+    }
+
+    dest_ix  = *p_dest_ix;
+    token_ix =  dest_ix++;
+    token    = (CPU_INT08U)(DEF_MIN(lit_len, TFTPs_SIM_TEST_LZ4_LEN_TOKEN_MAX) << 4);
+    if (lit_len >= TFTPs_SIM_TEST_LZ4_LEN_TOKEN_MAX) {          /* See Note #1.                                         */
+        for (len = lit_len - TFTPs_SIM_TEST_LZ4_LEN_TOKEN_MAX; len >= 255u; len -= 255u) {
+            p_dest[dest_ix++] = 255u;
+        }
+        p_dest[dest_ix++] = (CPU_INT08U)len;
+    }
+    memcpy(&p_dest[dest_ix], p_lit, lit_len);
+    dest_ix += lit_len;
+
+    if (match_len > 0u) {
+        p_dest[dest_ix++] = (CPU_INT08U) match_off;
+        p_dest[dest_ix++] = (CPU_INT08U)(match_off >> 8);
+        len    = match_len - TFTPs_SIM_TEST_LZ4_MATCH_LEN_MIN;
+        token |= (CPU_INT08U)DEF_MIN(len, TFTPs_SIM_TEST_LZ4_LEN_TOKEN_MAX);
+        if (len >= TFTPs_SIM_TEST_LZ4_LEN_TOKEN_MAX) {          /* See Note #1.                                         */
+            for (len -= TFTPs_SIM_TEST_LZ4_LEN_TOKEN_MAX; len >= 255u; len -= 255u) {
+                p_dest[dest_ix++] = 255u;
+            }
+            p_dest[dest_ix++] = (CPU_INT08U)len;
+        }
+    }
+    p_dest[token_ix] = token;
+
+   *p_dest_ix = dest_ix;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPs_SimTestLZ4_HdrChkSum()
+*
+* Description : Compute the header checksum of an LZ4 frame.
+*
+* Argument(s) : p_desc      Pointer to the frame descriptor, from FLG to the content size.
+*
+*               desc_len    Size of the frame descriptor, in octets.
+*
+* Return(s)   : Header checksum.
+*
+* Caller(s)   : TFTPs_SimTestLZ4_FileWr().
+*
+* Note(s)     : (1) The checksum is the second octet of the xxHash32 of the descriptor, with a seed of 0.  As
+*                   the descriptor is shorter than 16 octets, only the tail rounds of xxHash32 apply.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  CPU_INT08U  TFTPs_SimTestLZ4_HdrChkSum (const  CPU_INT08U  *p_desc,
+                                                       CPU_INT32U   desc_len)
+{
+    CPU_INT32U  hash;
+    CPU_INT32U  val;
+    CPU_INT32U  ix;
+
+
+    hash = TFTPs_SIM_TEST_XXH32_PRIME_5 + desc_len;             /* See Note #1.                                         */
+    for (ix = 0u; ix + sizeof(CPU_INT32U) <= desc_len; ix += sizeof(CPU_INT32U)) {
+        val   = (CPU_INT32U)p_desc[ix]               |
+               ((CPU_INT32U)p_desc[ix + 1u] <<  8u)  |
+               ((CPU_INT32U)p_desc[ix + 2u] << 16u)  |
+               ((CPU_INT32U)p_desc[ix + 3u] << 24u);
+        hash += val * TFTPs_SIM_TEST_XXH32_PRIME_3;
+        hash  = ((hash << 17u) | (hash >> 15u)) * TFTPs_SIM_TEST_XXH32_PRIME_4;
+    }
+    for (; ix < desc_len; ix++) {
+        hash += p_desc[ix] * TFTPs_SIM_TEST_XXH32_PRIME_5;
+        hash  = ((hash << 11u) | (hash >> 21u)) * TFTPs_SIM_TEST_XXH32_PRIME_1;
+    }
+
+    hash ^= hash >> 15u;
+    hash *= TFTPs_SIM_TEST_XXH32_PRIME_2;
+    hash ^= hash >> 13u;
+    hash *= TFTPs_SIM_TEST_XXH32_PRIME_3;
+    hash ^= hash >> 16u;
+
+    return ((CPU_INT08U)(hash >> 8u));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPs_SimTestLE32_Wr()
+*
+* Description : Write a 32-bit value, least significant octet first.
+*
+* Argument(s) : p_dest      Pointer to the destination.
+*
+*               val         Value to write.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPs_SimTestLZ4_FileWr().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPs_CFG_FS_LZ4_EN == DEF_ENABLED)
+static  void  TFTPs_SimTestLE32_Wr (CPU_INT08U  *p_dest,
+                                    CPU_INT32U   val)
+{
+    p_dest[0] = (CPU_INT08U) val;
+    p_dest[1] = (CPU_INT08U)(val >>  8);
+    p_dest[2] = (CPU_INT08U)(val >> 16);
+    p_dest[3] = (CPU_INT08U)(val >> 24);
+}
+#endif